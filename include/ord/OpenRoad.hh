@@ -35,6 +35,7 @@
 
 #pragma once
 
+#include <functional>
 #include <set>
 #include <string>
 #include <vector>
@@ -207,12 +208,15 @@ class OpenRoad
                bool make_tech,
                bool make_library);
 
+  // parallel parses the COMPONENTS, NETS and SPECIALNETS sections with
+  // the thread count.
   void readDef(const char* filename,
                odb::dbTech* tech,
                bool continue_on_errors,
                bool floorplan_init,
                bool incremental,
-               bool child);
+               bool child,
+               bool parallel = false);
 
   void writeLef(const char* filename);
 
@@ -235,7 +239,9 @@ class OpenRoad
   void designCreated();
 
   void readDb(std::istream& stream);
-  void readDb(const char* filename);
+  // lazy memory maps the file and defers parsing wires and parasitics
+  // until they are used.
+  void readDb(const char* filename, bool lazy = false);
   void writeDb(std::ostream& stream);
   void writeDb(const char* filename);
 
@@ -262,6 +268,8 @@ class OpenRoad
  private:
   OpenRoad();
 
+  void readDb(const std::function<void()>& read);
+
   Tcl_Interp* tcl_interp_ = nullptr;
   utl::Logger* logger_ = nullptr;
   odb::dbDatabase* db_ = nullptr;
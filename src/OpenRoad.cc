@@ -293,7 +293,8 @@ void OpenRoad::readDef(const char* filename,
                        bool continue_on_errors,
                        bool floorplan_init,
                        bool incremental,
-                       bool child)
+                       bool child,
+                       bool parallel)
 {
   if (!floorplan_init && !incremental && !child && db_->getChip()
       && db_->getChip()->getBlock()) {
@@ -314,6 +315,9 @@ void OpenRoad::readDef(const char* filename,
   if (continue_on_errors) {
     def_reader.continueOnErrors();
   }
+  if (parallel) {
+    def_reader.setThreads(threads_);
+  }
   dbBlock* block = nullptr;
   if (child) {
     auto parent = db_->getChip()->getBlock();
@@ -362,6 +366,7 @@ void OpenRoad::writeDef(const char* filename, const string& version)
     if (block) {
       odb::defout def_writer(logger_);
       def_writer.setVersion(stringToDefVersion(version));
+      def_writer.setThreads(threads_);
       def_writer.writeBlock(block, filename);
     }
   }
@@ -437,28 +442,44 @@ void OpenRoad::writeCdl(const char* outFilename,
   }
 }
 
-void OpenRoad::readDb(const char* filename)
+void OpenRoad::readDb(const char* filename, bool lazy)
 {
-  std::ifstream stream;
-  stream.open(filename, std::ios::binary);
-  try {
-    readDb(stream);
-  } catch (const std::ios_base::failure& f) {
-    logger_->error(ORD, 54, "odb file {} is invalid: {}", filename, f.what());
-  }
+  readDb([this, filename, lazy]() {
+    // Besides stream failures, a damaged file is reported by odb as a
+    // runtime_error (eg. a section checksum mismatch).
+    try {
+      if (lazy) {
+        db_->readMapped(filename, threads_);
+      } else {
+        std::ifstream stream;
+        stream.open(filename, std::ios::binary);
+        stream.exceptions(std::ifstream::failbit | std::ifstream::badbit
+                          | std::ios::eofbit);
+        db_->read(stream, threads_);
+      }
+    } catch (const std::runtime_error& e) {
+      logger_->error(
+          ORD, 54, "odb file {} is invalid: {}", filename, e.what());
+    }
+  });
 }
 
 void OpenRoad::readDb(std::istream& stream)
+{
+  stream.exceptions(std::ifstream::failbit | std::ifstream::badbit
+                    | std::ios::eofbit);
+
+  readDb([this, &stream]() { db_->read(stream, threads_); });
+}
+
+void OpenRoad::readDb(const std::function<void()>& read)
 {
   if (db_->getChip() && db_->getChip()->getBlock()) {
     logger_->error(
         ORD, 47, "You can't load a new db file as the db is already populated");
   }
 
-  stream.exceptions(std::ifstream::failbit | std::ifstream::badbit
-                    | std::ios::eofbit);
-
-  db_->read(stream);
+  read();
 
   for (OpenRoadObserver* observer : observers_) {
     observer->postReadDb(db_);
@@ -468,14 +489,14 @@ void OpenRoad::readDb(std::istream& stream)
 void OpenRoad::writeDb(std::ostream& stream)
 {
   stream.exceptions(std::ofstream::failbit | std::ofstream::badbit);
-  db_->write(stream);
+  db_->write(stream, threads_);
 }
 
 void OpenRoad::writeDb(const char* filename)
 {
   utl::StreamHandler stream_handler(filename, true);
 
-  db_->write(stream_handler.getStream());
+  db_->write(stream_handler.getStream(), threads_);
 }
 
 void OpenRoad::diffDbs(const char* filename1,
@@ -344,7 +344,8 @@ read_def_cmd(const char *filename,
              bool continue_on_errors,
              bool floorplan_init,
              bool incremental,
-             bool child)
+             bool child,
+             bool parallel)
 {
   OpenRoad *ord = getOpenRoad();
   auto* db = ord->getDb();
@@ -359,7 +360,7 @@ read_def_cmd(const char *filename,
     logger->error(utl::ORD, 52, "Technology {} not found", tech_name);
   }
   ord->readDef(filename, tech, continue_on_errors,
-               floorplan_init, incremental, child);
+               floorplan_init, incremental, child, parallel);
 }
 
 void
@@ -397,10 +398,11 @@ write_cdl_cmd(const char *outFilename,
 }
 
 void
-read_db_cmd(const char *filename)
+read_db_cmd(const char *filename,
+            bool lazy)
 {
   OpenRoad *ord = getOpenRoad();
-  ord->readDb(filename);
+  ord->readDb(filename, lazy);
 }
 
 void
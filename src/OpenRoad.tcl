@@ -72,13 +72,14 @@ proc read_lef { args } {
 
 sta::define_cmd_args "read_def" {[-floorplan_initialize|-incremental|-child]\
                                    [-continue_on_errors]\
+                                   [-parallel]\
                                    [-tech name] \
                                    filename}
 
 proc read_def { args } {
   sta::parse_key_args "read_def" args keys {-tech} \
     flags {-floorplan_initialize -incremental \
-           -order_wires -continue_on_errors -child}
+           -order_wires -continue_on_errors -child -parallel}
   sta::check_argc_eq1 "read_def" $args
   set filename [file nativename [lindex $args 0]]
   if { ![file exists $filename] } {
@@ -105,7 +106,7 @@ proc read_def { args } {
       and -child are mutually exclusive."
   }
   ord::read_def_cmd $filename $tech_name $continue_on_errors $floorplan_init \
-    $incremental $child
+    $incremental $child [info exists flags(-parallel)]
 }
 
 sta::define_cmd_args "write_def" {[-version version] filename}
@@ -182,9 +183,10 @@ proc write_cdl { args } {
 }
 
 
-sta::define_cmd_args "read_db" {filename}
+sta::define_cmd_args "read_db" {[-lazy] filename}
 
 proc read_db { args } {
+  sta::parse_key_args "read_db" args keys {} flags {-lazy}
   sta::check_argc_eq1 "read_db" $args
   set filename [file nativename [lindex $args 0]]
   if { ![file exists $filename] } {
@@ -193,7 +195,7 @@ proc read_db { args } {
   if { ![file readable $filename] } {
     utl::error "ORD" 8 "$filename is not readable."
   }
-  ord::read_db_cmd $filename
+  ord::read_db_cmd $filename [info exists flags(-lazy)]
 }
 
 sta::define_cmd_args "write_db" {filename}
@@ -112,6 +112,10 @@ class CtsOptions
   int getCapSteps() const { return capSteps_; }
   void setSlewSteps(int steps) { slewSteps_ = steps; }
   int getSlewSteps() const { return slewSteps_; }
+  void setCharLutCacheDir(const std::string& dir) { charLutCacheDir_ = dir; }
+  const std::string& getCharLutCacheDir() const { return charLutCacheDir_; }
+  void setNumThreads(int threads) { numThreads_ = threads; }
+  int getNumThreads() const { return numThreads_; }
   void setClockTreeMaxDepth(unsigned depth) { clockTreeMaxDepth_ = depth; }
   unsigned getClockTreeMaxDepth() const { return clockTreeMaxDepth_; }
   void setEnableFakeLutEntries(bool enable) { enableFakeLutEntries_ = enable; }
@@ -276,6 +280,8 @@ class CtsOptions
   double sinkBufferInputCap_ = 0;
   int capSteps_ = 20;
   int slewSteps_ = 7;
+  std::string charLutCacheDir_;
+  int numThreads_ = 1;
   unsigned charWirelengthIterations_ = 4;
   unsigned clockTreeMaxDepth_ = 100;
   bool enableFakeLutEntries_ = true;
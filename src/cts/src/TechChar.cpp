@@ -36,13 +36,20 @@
 #include "TechChar.h"
 
 #include <algorithm>
+#include <exception>
+#include <filesystem>
 #include <fstream>
+#include <functional>
 #include <iomanip>
+#include <limits>
+#include <mutex>
 #include <ostream>
 #include <sstream>
+#include <thread>
 
 #include "db_sta/dbSta.hh"
 #include "rsz/Resizer.hh"
+#include "sta/DcalcAnalysisPt.hh"
 #include "sta/Graph.hh"
 #include "sta/Liberty.hh"
 #include "sta/PathAnalysisPt.hh"
@@ -67,7 +74,6 @@ TechChar::TechChar(CtsOptions* options,
       db_(db),
       resizer_(resizer),
       openSta_(sta),
-      openStaChar_(nullptr),
       db_network_(db_network),
       logger_(logger),
       resPerDBU_(0.0),
@@ -939,7 +945,10 @@ std::vector<float>::iterator TechChar::largestDiffIter(
 }
 
 std::vector<TechChar::SolutionData> TechChar::createPatterns(
-    unsigned setupWirelength)
+    odb::dbBlock* block,
+    unsigned setupWirelength,
+    unsigned firstTopology,
+    unsigned lastTopology)
 {
   // Sets the number of nodes (wirelength/characterization unit) that a buffer
   // can be placed and...
@@ -947,7 +956,7 @@ std::vector<TechChar::SolutionData> TechChar::createPatterns(
   // drive) that can exist.
   const unsigned numberOfNodes
       = setupWirelength / options_->getWireSegmentUnit();
-  const unsigned numberOfTopologies = 1 << numberOfNodes;
+  const unsigned numberOfTopologies = lastTopology - firstTopology;
   std::vector<SolutionData> topologiesVector;
   odb::dbNet* net = nullptr;
   // clang-format off
@@ -955,7 +964,8 @@ std::vector<TechChar::SolutionData> TechChar::createPatterns(
              "#topo:{}", setupWirelength, numberOfNodes, numberOfTopologies);
   // clang-format on
   // For each possible topology...
-  for (unsigned solutionCounterInt = 0; solutionCounterInt < numberOfTopologies;
+  for (unsigned solutionCounterInt = firstTopology;
+       solutionCounterInt < lastTopology;
        solutionCounterInt++) {
     // Creates a bitset that represents the buffer locations.
     const std::bitset<5> solutionCounter(solutionCounterInt);
@@ -965,7 +975,7 @@ std::vector<TechChar::SolutionData> TechChar::createPatterns(
     const std::string netName = "net_" + std::to_string(setupWirelength) + "_"
                                 + solutionCounter.to_string() + "_"
                                 + std::to_string(wireCounter);
-    net = odb::dbNet::create(charBlock_, netName.c_str());
+    net = odb::dbNet::create(block, netName.c_str());
     odb::dbWire::create(net);
     net->setSigType(odb::dbSigType::SIGNAL);
     // Creates the input port.
@@ -1000,7 +1010,7 @@ std::vector<TechChar::SolutionData> TechChar::createPatterns(
                    "topo:{}", bufName, nodeIndex, solutionCounterInt);
         // clang-format on
         odb::dbInst* bufInstance
-            = odb::dbInst::create(charBlock_, charBuf_, bufName.c_str());
+            = odb::dbInst::create(block, charBuf_, bufName.c_str());
         odb::dbITerm* bufInstanceInPin = bufInstance->getITerm(charBufIn_);
         odb::dbITerm* bufInstanceOutPin = bufInstance->getITerm(charBufOut_);
         bufInstanceInPin->connect(net);
@@ -1013,7 +1023,7 @@ std::vector<TechChar::SolutionData> TechChar::createPatterns(
         const std::string netName = "net_" + std::to_string(setupWirelength)
                                     + "_" + solutionCounter.to_string() + "_"
                                     + std::to_string(wireCounter);
-        net = odb::dbNet::create(charBlock_, netName.c_str());
+        net = odb::dbNet::create(block, netName.c_str());
         odb::dbWire::create(net);
         bufInstanceOutPin->connect(net);
         net->setSigType(odb::dbSigType::SIGNAL);
@@ -1058,26 +1068,24 @@ std::vector<TechChar::SolutionData> TechChar::createPatterns(
   return topologiesVector;
 }
 
-void TechChar::createStaInstance()
+void TechChar::createStaInstance(CharJob& job)
 {
   // Creates a new OpenSTA instance that is used only for the
-  // characterization. Creates the new instance based on the charcterization
-  // block.
-  openStaChar_ = openSta_->makeBlockSta(charBlock_);
+  // characterization. Creates the new instance based on the job's
+  // characterization block.
+  job.sta = openSta_->makeBlockSta(job.block);
   // Gets the corner and other analysis attributes from the new instance.
-  charCorner_ = openStaChar_->cmdCorner();
+  job.corner = job.sta->cmdCorner();
   sta::PathAPIndex path_ap_index
-      = charCorner_->findPathAnalysisPt(sta::MinMax::max())->index();
-  sta::Corners* corners = openStaChar_->search()->corners();
-  charPathAnalysis_ = corners->findPathAnalysisPt(path_ap_index);
+      = job.corner->findPathAnalysisPt(sta::MinMax::max())->index();
+  sta::Corners* corners = job.sta->search()->corners();
+  job.pathAnalysis = corners->findPathAnalysisPt(path_ap_index);
 }
 
-void TechChar::setParasitics(
-    const std::vector<TechChar::SolutionData>& topologiesVector,
-    unsigned setupWirelength)
+void TechChar::setParasitics(CharJob& job)
 {
   // For each topology...
-  for (const SolutionData& solution : topologiesVector) {
+  for (const SolutionData& solution : job.topologies) {
     // For each net in the topolgy -> set the parasitics.
     for (unsigned netIndex = 0; netIndex < solution.netVector.size();
          ++netIndex) {
@@ -1130,28 +1138,29 @@ void TechChar::setParasitics(
       const unsigned charUnit = options_->getWireSegmentUnit();
       const double wire_cap = nodesWithoutBuf * charUnit * capPerDBU_;
       const double wire_res = nodesWithoutBuf * charUnit * resPerDBU_;
-      openStaChar_->makePiElmore(firstPin,
-                                 sta::RiseFall::rise(),
-                                 sta::MinMaxAll::all(),
-                                 wire_cap / 2,
-                                 wire_res,
-                                 wire_cap / 2);
-      openStaChar_->setElmore(firstPin,
-                              lastPin,
-                              sta::RiseFall::rise(),
-                              sta::MinMaxAll::all(),
-                              wire_res * wire_cap);
+      job.sta->makePiElmore(firstPin,
+                            sta::RiseFall::rise(),
+                            sta::MinMaxAll::all(),
+                            wire_cap / 2,
+                            wire_res,
+                            wire_cap / 2);
+      job.sta->setElmore(firstPin,
+                         lastPin,
+                         sta::RiseFall::rise(),
+                         sta::MinMaxAll::all(),
+                         wire_res * wire_cap);
     }
   }
 }
 
 TechChar::ResultData TechChar::computeTopologyResults(
+    const CharJob& job,
     const TechChar::SolutionData& solution,
     sta::Vertex* outPinVert,
     float load,
-    float inSlew,
-    unsigned setupWirelength)
+    float inSlew)
 {
+  const unsigned setupWirelength = job.wirelength;
   ResultData results;
   results.wirelength = setupWirelength;
   results.topology = solution.topologyDescriptor;
@@ -1166,7 +1175,7 @@ TechChar::ResultData TechChar::computeTopologyResults(
     for (odb::dbInst* bufferInst : solution.instVector) {
       sta::Instance* bufferInstSta = db_network_->dbToSta(bufferInst);
       sta::PowerResult instResults
-          = openStaChar_->power(bufferInstSta, charCorner_);
+          = job.sta->power(bufferInstSta, job.corner);
       totalPower = totalPower + instResults.total();
     }
   }
@@ -1191,13 +1200,13 @@ TechChar::ResultData TechChar::computeTopologyResults(
       = std::round(incap / charCapStepSize_) * charCapStepSize_;
   results.totalcap = totalcap;
   // Computations for delay.
-  const float pinArrival = openStaChar_->vertexArrival(
-      outPinVert, sta::RiseFall::fall(), charPathAnalysis_);
+  const float pinArrival = job.sta->vertexArrival(
+      outPinVert, sta::RiseFall::fall(), job.pathAnalysis);
   results.pinArrival = pinArrival;
   // Computations for output slew.
-  const float pinRise = openStaChar_->vertexSlew(
+  const float pinRise = job.sta->vertexSlew(
       outPinVert, sta::RiseFall::rise(), sta::MinMax::max());
-  const float pinFall = openStaChar_->vertexSlew(
+  const float pinFall = job.sta->vertexSlew(
       outPinVert, sta::RiseFall::fall(), sta::MinMax::max());
   const float pinSlew = std::round((pinRise + pinFall) / 2 / charSlewStepSize_)
                         * charSlewStepSize_;
@@ -1541,146 +1550,376 @@ unsigned TechChar::normalizeCharResults(float value,
   return normVal;
 }
 
-void TechChar::create()
+void TechChar::characterizeJob(CharJob& job)
 {
-  // Setup of the attributes required to run the characterization.
-  initCharacterization();
-  long unsigned int topologiesCreated = 0;
+  // OpenSTA is not known to be safe with several block instances timed
+  // at once (they share the network, units and report), so the jobs
+  // take turns, one topology at a time, for all their STA and odb work.
+  sta::Graph* graph;
+  {
+    std::lock_guard<std::mutex> lock(staMutex_);
+    graph = job.sta->ensureGraph();
+  }
+  for (size_t topoIndex = 0; topoIndex < job.topologies.size(); ++topoIndex) {
+    std::lock_guard<std::mutex> lock(staMutex_);
+    SolutionData& solution = job.topologies[topoIndex];
+    // clang-format off
+    debugPrint(logger_, CTS, "tech char", 1, "create WL:{}, topo:{} of {}",
+               job.wirelength, topoIndex, job.topologies.size());
+    // clang-format on
+    // Gets the input and output port (as terms, pins and vertices).
+    odb::dbBTerm* inBTerm = solution.inPort->getBTerm();
+    odb::dbBTerm* outBTerm = solution.outPort->getBTerm();
+    odb::dbNet* lastNet = solution.netVector.back();
+    sta::Pin* inPin = db_network_->dbToSta(inBTerm);
+    sta::Pin* outPin = db_network_->dbToSta(outBTerm);
+    sta::Vertex* outPinVert = graph->pinLoadVertex(outPin);
+    sta::Vertex* inPinVert = graph->pinDrvrVertex(inPin);
+
+    // Gets the first pin of the last net. Needed to set a new parasitic
+    // (load) value.
+    sta::Pin* firstPinLastNet = nullptr;
+    if (lastNet->getBTerms().size() > 1) {
+      // Parasitics for purewire segment.
+      // First and last pin are already available.
+      firstPinLastNet = inPin;
+    } else {
+      // Parasitics for the end/start of a net. One Port and one
+      // instance pin.
+      odb::dbITerm* netITerm = lastNet->get1stITerm();
+      firstPinLastNet = db_network_->dbToSta(netITerm);
+    }
+
+    float c1, c2, r1;
+    bool piExists = false;
+    // Gets the parasitics that are currently used for the last net.
+    job.sta->findPiElmore(firstPinLastNet,
+                          sta::RiseFall::rise(),
+                          sta::MinMax::max(),
+                          c2,
+                          r1,
+                          c1,
+                          piExists);
+    // For each possible buffer combination (different sizes).
+    unsigned buffersUpdate = job.bufferCombos[topoIndex];
+    do {
+      // For each possible load.
+      for (float load : loadsToTest_) {
+        // Sets the new parasitic of the last net (load added to last pin).
+        job.sta->makePiElmore(firstPinLastNet,
+                              sta::RiseFall::rise(),
+                              sta::MinMaxAll::all(),
+                              c2,
+                              r1,
+                              c1 + load);
+        job.sta->setElmore(firstPinLastNet,
+                           outPin,
+                           sta::RiseFall::rise(),
+                           sta::MinMaxAll::all(),
+                           r1 * (c1 + c2 + load));
+        // For each possible input slew.
+        for (float inputslew : slewsToTest_) {
+          // Sets the slew on the input vertex.
+          // Here the new pattern is created (combination of load, buffers
+          // and slew values).
+          job.sta->setAnnotatedSlew(inPinVert,
+                                    job.corner,
+                                    sta::MinMaxAll::all(),
+                                    sta::RiseFallBoth::riseFall(),
+                                    inputslew);
+          // Updates timing for the new pattern.
+          job.sta->updateTiming(true);
+
+          // Gets the results (delay, slew, power...) for the pattern.
+          job.results.push_back(computeTopologyResults(
+              job, solution, outPinVert, load, inputslew));
+        }  // for each slew
+      }    // for each load
+      // If the solution is not a pure-wire, update the buffer topologies.
+      if (!solution.isPureWire) {
+        updateBufferTopologies(solution);
+      }
+      // For pure-wire solution buffersUpdate == 1, so it only runs once.
+      buffersUpdate--;
+    } while (buffersUpdate != 0);
+  }
+}
+
+void TechChar::characterize()
+{
+  const unsigned numThreads = std::max(options_->getNumThreads(), 1);
+  solutionMap_.clear();
+  // Splits the topologies of each wirelength into contiguous slices. Every
+  // slice gets its own block and STA, built here on the main thread, and
+  // is timed by its own thread under staMutex_.
+  struct Slice
+  {
+    unsigned wirelength;
+    unsigned first;
+    unsigned last;
+  };
+  std::vector<Slice> slices;
   for (unsigned setupWirelength : wirelengthsToTest_) {
-    // Creates the topologies for the current wirelength.
-    std::vector<SolutionData> topologiesVector
-        = createPatterns(setupWirelength);
-    // Creates an OpenSTA instance.
-    createStaInstance();
-    // Setup of the parasitics for each net.
-    setParasitics(topologiesVector, setupWirelength);
-    // For each topology...
-    sta::Graph* graph = openStaChar_->ensureGraph();
-    int topoIndex = 0;
-    for (SolutionData solution : topologiesVector) {
-      // clang-format off
-      debugPrint(logger_, CTS, "tech char", 1, "create WL:{} of {}, "
-                 "topo:{} of {}", setupWirelength, wirelengthsToTest_.size(),
-                 topoIndex, topologiesVector.size());
-      // clang-format on
-      topoIndex++;
-      // Gets the input and output port (as terms, pins and vertices).
-      odb::dbBTerm* inBTerm = solution.inPort->getBTerm();
-      odb::dbBTerm* outBTerm = solution.outPort->getBTerm();
-      odb::dbNet* lastNet = solution.netVector.back();
-      sta::Pin* inPin = db_network_->dbToSta(inBTerm);
-      sta::Pin* outPin = db_network_->dbToSta(outBTerm);
-      sta::Vertex* outPinVert = graph->pinLoadVertex(outPin);
-      sta::Vertex* inPinVert = graph->pinDrvrVertex(inPin);
-
-      // Gets the first pin of the last net. Needed to set a new parasitic
-      // (load) value.
-      sta::Pin* firstPinLastNet = nullptr;
-      if (lastNet->getBTerms().size() > 1) {
-        // Parasitics for purewire segment.
-        // First and last pin are already available.
-        firstPinLastNet = inPin;
-      } else {
-        // Parasitics for the end/start of a net. One Port and one
-        // instance pin.
-        odb::dbITerm* netITerm = lastNet->get1stITerm();
-        firstPinLastNet = db_network_->dbToSta(netITerm);
+    const unsigned numberOfNodes
+        = setupWirelength / options_->getWireSegmentUnit();
+    const unsigned numberOfTopologies = 1 << numberOfNodes;
+    const unsigned sliceSize
+        = (numberOfTopologies + numThreads - 1) / numThreads;
+    for (unsigned first = 0; first < numberOfTopologies; first += sliceSize) {
+      const unsigned last = std::min(first + sliceSize, numberOfTopologies);
+      slices.push_back({setupWirelength, first, last});
+    }
+  }
+
+  // At most numThreads slices hold a block and an STA at any time. Building
+  // and destroying them touches shared state and is serial. The results are
+  // merged in slice order so the map is identical to a serial run.
+  long unsigned int topologiesCreated = 0;
+  for (size_t begin = 0; begin < slices.size(); begin += numThreads) {
+    const size_t end = std::min<size_t>(begin + numThreads, slices.size());
+    std::vector<CharJob> jobs(end - begin);
+    for (size_t i = begin; i < end; ++i) {
+      const Slice& slice = slices[i];
+      CharJob& job = jobs[i - begin];
+      job.wirelength = slice.wirelength;
+      const std::string blockName
+          = "CharacterizationBlock_" + std::to_string(i);
+      job.block = odb::dbBlock::create(charBlock_, blockName.c_str());
+      job.topologies = createPatterns(
+          job.block, slice.wirelength, slice.first, slice.last);
+      createStaInstance(job);
+      setParasitics(job);
+      for (const SolutionData& solution : job.topologies) {
+        job.bufferCombos.push_back(getBufferingCombo(
+            masterNames_.size(), solution.instVector.size()));
       }
+    }
 
-      float c1, c2, r1;
-      bool piExists = false;
-      // Gets the parasitics that are currently used for the last net.
-      openStaChar_->findPiElmore(firstPinLastNet,
-                                 sta::RiseFall::rise(),
-                                 sta::MinMax::max(),
-                                 c2,
-                                 r1,
-                                 c1,
-                                 piExists);
-      // For each possible buffer combination (different sizes).
-      unsigned buffersUpdate
-          = getBufferingCombo(masterNames_.size(), solution.instVector.size());
-      // clang-format off
-      debugPrint(logger_, CTS, "tech char", 1, "create #bufs={} "
-                 "#soln.instVector.size={}, #bufUpdate={}, #topo={}",
-                 masterNames_.size(), solution.instVector.size(),
-                 buffersUpdate, topologiesCreated);
-      // clang-format on
-      do {
-        // For each possible load.
-        for (float load : loadsToTest_) {
-          // Sets the new parasitic of the last net (load added to last pin).
-          openStaChar_->makePiElmore(firstPinLastNet,
-                                     sta::RiseFall::rise(),
-                                     sta::MinMaxAll::all(),
-                                     c2,
-                                     r1,
-                                     c1 + load);
-          openStaChar_->setElmore(firstPinLastNet,
-                                  outPin,
-                                  sta::RiseFall::rise(),
-                                  sta::MinMaxAll::all(),
-                                  r1 * (c1 + c2 + load));
-          // For each possible input slew.
-          for (float inputslew : slewsToTest_) {
-            // Sets the slew on the input vertex.
-            // Here the new pattern is created (combination of load, buffers
-            // and slew values).
-            openStaChar_->setAnnotatedSlew(inPinVert,
-                                           charCorner_,
-                                           sta::MinMaxAll::all(),
-                                           sta::RiseFallBoth::riseFall(),
-                                           inputslew);
-            // Updates timing for the new pattern.
-            openStaChar_->updateTiming(true);
-
-            // Gets the results (delay, slew, power...) for the pattern.
-            ResultData results = computeTopologyResults(
-                solution, outPinVert, load, inputslew, setupWirelength);
-
-            // Appends the results to a map, grouping each result by
-            // wirelength, load, output slew and input cap.
-            CharKey solutionKey;
-            solutionKey.wirelength = results.wirelength;
-            solutionKey.pinSlew = results.pinSlew;
-            solutionKey.load = results.load;
-            solutionKey.totalcap = results.totalcap;
-            if (solutionMap_.find(solutionKey) != solutionMap_.end()) {
-              solutionMap_[solutionKey].push_back(results);
-            } else {
-              std::vector<ResultData> resultGroup;
-              resultGroup.push_back(results);
-              solutionMap_[solutionKey] = std::move(resultGroup);
-            }
-            topologiesCreated++;
-            if (logger_->debugCheck(utl::CTS, "tech char", 1)
-                && topologiesCreated % 50000 == 0) {
-              debugPrint(logger_,
-                         CTS,
-                         "tech char",
-                         1,
-                         "Number of created patterns = {}.",
-                         topologiesCreated);
-            }
-          }  // for each slew
-        }    // for each load
-        // If the solution is not a pure-wire, update the buffer topologies.
-        if (!solution.isPureWire) {
-          updateBufferTopologies(solution);
+    std::exception_ptr error;
+    std::mutex errorMutex;
+    auto worker = [&](CharJob& job) {
+      try {
+        characterizeJob(job);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        if (!error) {
+          error = std::current_exception();
         }
-        // For pure-wire solution buffersUpdate == 1, so it only runs once.
-        buffersUpdate--;
-      } while (buffersUpdate != 0);
+      }
+    };
+    std::vector<std::thread> threads;
+    threads.reserve(jobs.size() - 1);
+    for (size_t i = 1; i < jobs.size(); ++i) {
+      threads.emplace_back(worker, std::ref(jobs[i]));
+    }
+    worker(jobs[0]);
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+
+    // Appends the results to a map, grouping each result by wirelength,
+    // load, output slew and input cap.
+    for (CharJob& job : jobs) {
+      if (!error) {
+        for (ResultData& results : job.results) {
+          CharKey solutionKey;
+          solutionKey.wirelength = results.wirelength;
+          solutionKey.pinSlew = results.pinSlew;
+          solutionKey.load = results.load;
+          solutionKey.totalcap = results.totalcap;
+          solutionMap_[solutionKey].push_back(std::move(results));
+        }
+        topologiesCreated += job.results.size();
+      }
+      job.sta.reset(nullptr);
+      odb::dbBlock::destroy(job.block);
+    }
+    if (error) {
+      std::rethrow_exception(error);
     }
-    openStaChar_.reset(nullptr);
   }
   if (logger_->debugCheck(utl::CTS, "tech char", 1)) {
     logger_->info(
         CTS, 39, "Number of created patterns = {}.", topologiesCreated);
   }
-  // Post-processing of the results.
-  const std::vector<ResultData> convertedSolutions
-      = characterizationPostProcess();
+}
+
+template <typename T>
+static void hashCombine(std::size_t& seed, const T& value)
+{
+  seed ^= std::hash<T>{}(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+// The cache file name is a hash of everything the characterization depends
+// on: the STA corner and its liberty files and operating conditions, the
+// clock wire RC and the options.
+std::string TechChar::lutCacheFile() const
+{
+  const std::string& dir = options_->getCharLutCacheDir();
+  if (dir.empty()) {
+    return "";
+  }
+  std::size_t key = 0;
+  sta::Corner* corner = openSta_->cmdCorner();
+  hashCombine(key, std::string(corner->name()));
+  for (const sta::MinMax* minMax : sta::MinMax::range()) {
+    const sta::OperatingConditions* conditions
+        = corner->findDcalcAnalysisPt(minMax)->operatingConditions();
+    if (conditions != nullptr) {
+      hashCombine(key, conditions->process());
+      hashCombine(key, conditions->voltage());
+      hashCombine(key, conditions->temperature());
+    }
+  }
+  std::vector<std::string> masters = masterNames_;
+  masters.push_back(charBuf_->getName());
+  masters.push_back(options_->getSinkBuffer());
+  for (const std::string& name : masters) {
+    hashCombine(key, name);
+    sta::LibertyCell* libertyCell = db_network_->findLibertyCell(name.c_str());
+    if (libertyCell == nullptr) {
+      continue;
+    }
+    // The corner may time the cell with a library of its own
+    for (const sta::MinMax* minMax : sta::MinMax::range()) {
+      sta::LibertyCell* cornerCell = libertyCell->cornerCell(corner, minMax);
+      if (cornerCell == nullptr) {
+        cornerCell = libertyCell;
+      }
+      const std::string libFile = cornerCell->libertyLibrary()->filename();
+      hashCombine(key, libFile);
+      std::error_code ec;
+      const auto size = std::filesystem::file_size(libFile, ec);
+      hashCombine(key, ec ? 0 : size);
+      const auto mtime = std::filesystem::last_write_time(libFile, ec);
+      hashCombine(key, ec ? 0 : mtime.time_since_epoch().count());
+    }
+  }
+  hashCombine(key, resPerDBU_);
+  hashCombine(key, capPerDBU_);
+  hashCombine(key, db_->getChip()->getBlock()->getDbUnitsPerMicron());
+  hashCombine(key, options_->getWireSegmentUnit());
+  hashCombine(key, options_->getMaxCharSlew());
+  hashCombine(key, charSlewStepSize_);
+  hashCombine(key, charCapStepSize_);
+  for (unsigned wirelength : wirelengthsToTest_) {
+    hashCombine(key, wirelength);
+  }
+  for (float slew : slewsToTest_) {
+    hashCombine(key, slew);
+  }
+  for (float load : loadsToTest_) {
+    hashCombine(key, load);
+  }
+
+  std::stringstream fileName;
+  fileName << "cts_char_" << std::hex << std::setw(16) << std::setfill('0')
+           << key << ".lut";
+  return (std::filesystem::path(dir) / fileName.str()).string();
+}
+
+bool TechChar::readLutCache(const std::string& fileName,
+                            std::vector<ResultData>& solutions)
+{
+  std::ifstream file(fileName);
+  if (!file.is_open()) {
+    return false;
+  }
+  std::string header;
+  size_t count = 0;
+  unsigned minSlew, maxSlew, minCap, maxCap, minLength, maxLength;
+  file >> header >> minSlew >> maxSlew >> minCap >> maxCap >> minLength
+      >> maxLength >> count;
+  if (!file || header != "cts_char_lut_v1") {
+    return false;
+  }
+  std::vector<ResultData> cached(count);
+  for (ResultData& result : cached) {
+    size_t topologySize = 0;
+    file >> result.load >> result.inSlew >> result.wirelength
+        >> result.pinSlew >> result.pinArrival >> result.totalcap
+        >> result.totalPower >> result.isPureWire >> topologySize;
+    if (!file) {
+      return false;
+    }
+    result.topology.resize(topologySize);
+    for (std::string& node : result.topology) {
+      file >> node;
+    }
+  }
+  if (!file) {
+    return false;
+  }
+  minSlew_ = minSlew;
+  maxSlew_ = maxSlew;
+  minCapacitance_ = minCap;
+  maxCapacitance_ = maxCap;
+  minSegmentLength_ = minLength;
+  maxSegmentLength_ = maxLength;
+  solutions = std::move(cached);
+  return true;
+}
+
+void TechChar::writeLutCache(const std::string& fileName,
+                             const std::vector<ResultData>& solutions) const
+{
+  // Writes to a temporary file first so an interrupted run never leaves a
+  // truncated cache behind.
+  std::error_code ec;
+  std::filesystem::create_directories(
+      std::filesystem::path(fileName).parent_path(), ec);
+  const std::string tmpName = fileName + ".tmp";
+  {
+    std::ofstream file(tmpName);
+    if (!file.is_open()) {
+      logger_->warn(CTS, 38, "Could not write LUT cache {}.", fileName);
+      return;
+    }
+    file << std::setprecision(std::numeric_limits<double>::max_digits10);
+    file << "cts_char_lut_v1 " << minSlew_ << " " << maxSlew_ << " "
+         << minCapacitance_ << " " << maxCapacitance_ << " "
+         << minSegmentLength_ << " " << maxSegmentLength_ << " "
+         << solutions.size() << "\n";
+    for (const ResultData& result : solutions) {
+      file << result.load << " " << result.inSlew << " " << result.wirelength
+           << " " << result.pinSlew << " " << result.pinArrival << " "
+           << result.totalcap << " " << result.totalPower << " "
+           << result.isPureWire << " " << result.topology.size();
+      for (const std::string& node : result.topology) {
+        file << " " << node;
+      }
+      file << "\n";
+    }
+  }
+  std::filesystem::rename(tmpName, fileName, ec);
+  if (ec) {
+    logger_->warn(CTS,
+                  42,
+                  "Could not rename {} to {}: {}.",
+                  tmpName,
+                  fileName,
+                  ec.message());
+    return;
+  }
+  logger_->info(CTS, 37, "Saved characterization LUT to {}.", fileName);
+}
+
+void TechChar::create()
+{
+  // Setup of the attributes required to run the characterization.
+  initCharacterization();
+  const std::string cacheFile = lutCacheFile();
+  std::vector<ResultData> convertedSolutions;
+  if (!cacheFile.empty() && readLutCache(cacheFile, convertedSolutions)) {
+    logger_->info(CTS, 36, "Loaded characterization LUT from {}.", cacheFile);
+  } else {
+    characterize();
+    // Post-processing of the results.
+    convertedSolutions = characterizationPostProcess();
+    if (!cacheFile.empty()) {
+      writeLutCache(cacheFile, convertedSolutions);
+    }
+  }
   compileLut(convertedSolutions);
   if (logger_->debugCheck(CTS, "characterization", 3)) {
     printCharacterization();
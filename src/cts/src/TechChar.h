@@ -45,6 +45,8 @@
 #include <deque>
 #include <functional>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <unordered_map>
@@ -237,6 +239,21 @@ class TechChar
     }
   };
 
+  // A slice of the topologies of one wirelength. Each job is timed in its
+  // own block by its own STA.
+  struct CharJob
+  {
+    unsigned wirelength = 0;
+    odb::dbBlock* block = nullptr;
+    std::unique_ptr<sta::dbSta> sta;
+    sta::PathAnalysisPt* pathAnalysis = nullptr;
+    sta::Corner* corner = nullptr;
+    std::vector<SolutionData> topologies;
+    // Buffer combinations to try for each topology.
+    std::vector<unsigned> bufferCombos;
+    std::vector<ResultData> results;
+  };
+
   using Key = uint32_t;
 
   void printCharacterization() const;
@@ -282,15 +299,24 @@ class TechChar
   void reduceOrExpand(std::vector<float>& values, unsigned limit);
   std::vector<float>::iterator smallestDiffIter(std::vector<float>& values);
   std::vector<float>::iterator largestDiffIter(std::vector<float>& values);
-  std::vector<SolutionData> createPatterns(unsigned setupWirelength);
-  void createStaInstance();
-  void setParasitics(const std::vector<SolutionData>& topologiesVector,
-                     unsigned setupWirelength);
-  ResultData computeTopologyResults(const SolutionData& solution,
+  std::vector<SolutionData> createPatterns(odb::dbBlock* block,
+                                          unsigned setupWirelength,
+                                          unsigned firstTopology,
+                                          unsigned lastTopology);
+  void createStaInstance(CharJob& job);
+  void setParasitics(CharJob& job);
+  void characterize();
+  void characterizeJob(CharJob& job);
+  ResultData computeTopologyResults(const CharJob& job,
+                                    const SolutionData& solution,
                                     sta::Vertex* outPinVert,
                                     float load,
-                                    float inSlew,
-                                    unsigned setupWirelength);
+                                    float inSlew);
+  std::string lutCacheFile() const;
+  bool readLutCache(const std::string& fileName,
+                    std::vector<ResultData>& solutions);
+  void writeLutCache(const std::string& fileName,
+                     const std::vector<ResultData>& solutions) const;
   void updateBufferTopologies(SolutionData& solution);
   void updateBufferTopologiesOld(TechChar::SolutionData& solution);
   size_t cellNameToID(const std::string& masterName);
@@ -332,12 +358,12 @@ class TechChar
   odb::dbDatabase* db_;
   rsz::Resizer* resizer_;
   sta::dbSta* openSta_;
-  std::unique_ptr<sta::dbSta> openStaChar_;
   sta::dbNetwork* db_network_;
   Logger* logger_;
-  sta::PathAnalysisPt* charPathAnalysis_ = nullptr;
-  sta::Corner* charCorner_ = nullptr;
   odb::dbBlock* charBlock_ = nullptr;
+  // Serializes the STA queries and master swaps of the characterization
+  // threads
+  std::mutex staMutex_;
   odb::dbMaster* charBuf_ = nullptr;
   odb::dbMTerm* charBufIn_ = nullptr;
   odb::dbMTerm* charBufOut_ = nullptr;
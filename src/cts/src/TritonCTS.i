@@ -114,6 +114,12 @@ set_cap_steps(int steps)
   getTritonCts()->getParms()->setCapSteps(steps);
 }
 
+void
+set_char_lut_cache_dir(const char* dir)
+{
+  getTritonCts()->getParms()->setCharLutCacheDir(dir);
+}
+
 void
 set_metric_output(const char* file)
 {
@@ -257,6 +263,8 @@ set_delay_buffer_derate(float derate)
 void
 run_triton_cts()
 {
+  getTritonCts()->getParms()->setNumThreads(
+      ord::OpenRoad::openRoad()->getThreadCount());
   getTritonCts()->runTritonCts();
 }
 
@@ -0,0 +1,38 @@
+# threaded characterization gives the same LUT as a serial one
+source "helpers.tcl"
+read_lef Nangate45/Nangate45.lef
+read_liberty Nangate45/Nangate45_typ.lib
+read_def "16sinks.def"
+
+create_clock -period 5 clk
+
+set_wire_rc -clock -layer metal3
+
+proc run_cts { threads cache_dir } {
+  file delete -force $cache_dir
+  set_thread_count $threads
+  configure_cts_characterization -lut_cache_dir $cache_dir
+  # Only the characterization matters here, the later runs rebuild the
+  # tree of the first one.
+  catch {
+    clock_tree_synthesis -root_buf CLKBUF_X3 \
+      -buf_list "CLKBUF_X3 CLKBUF_X2 BUF_X4 CLKBUF_X1" \
+      -wire_unit 20
+  }
+  return [glob -nocomplain -directory $cache_dir cts_char_*.lut]
+}
+
+set serial_dir [make_result_file char_threads_serial]
+set threaded_dir [make_result_file char_threads_threaded]
+
+set serial_lut [run_cts 1 $serial_dir]
+set threaded_lut [run_cts 4 $threaded_dir]
+
+check "serial LUT written" { llength $serial_lut } 1
+check "threaded LUT written" { llength $threaded_lut } 1
+check "same cache key" {
+  string equal [file tail $serial_lut] [file tail $threaded_lut]
+} 1
+check "same LUT" { diff_files $serial_lut $threaded_lut } 0
+
+exit_summary
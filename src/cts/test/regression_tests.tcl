@@ -24,3 +24,6 @@ record_tests {
   #cts_readme_msgs_check
   #cts_man_tcl_check
 }
+record_pass_fail_tests {
+  char_threads
+}
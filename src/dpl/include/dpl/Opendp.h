@@ -50,6 +50,7 @@
 #include <set>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>  // pair
 #include <vector>
 
@@ -81,13 +82,14 @@ using odb::Rect;
 struct Cell;
 struct Group;
 struct Master;
-struct Pixel;
+struct PixelRow;
 
 class DplObserver;
 class Grid;
 class GridInfo;
 class Padding;
 class PixelPt;
+class PlacementCheckCache;
 
 template <typename T>
 struct TypedCoordinate;
@@ -134,10 +136,12 @@ class Opendp
   void init(dbDatabase* db, Logger* logger);
   // legalize/report
   // max_displacment is in sites. use zero for defaults.
+  // num_threads > 1 legalizes row bands of the core concurrently.
   void detailedPlacement(int max_displacement_x,
                          int max_displacement_y,
                          const std::string& report_file_name = std::string(""),
-                         bool disallow_one_site_gaps = false);
+                         bool disallow_one_site_gaps = false,
+                         int num_threads = 1);
   void reportLegalizationStats() const;
 
   void setPaddingGlobal(int left, int right);
@@ -152,9 +156,12 @@ class Opendp
   int padLeft(dbInst* inst) const;
   int padRight(dbInst* inst) const;
 
+  // incremental keeps the results between calls and only rechecks
+  // instances changed in the db since the previous incremental check.
   void checkPlacement(bool verbose,
                       bool disallow_one_site_gaps = false,
-                      const string& report_file_name = "");
+                      const string& report_file_name = "",
+                      bool incremental = false);
   void fillerPlacement(dbMasterSeq* filler_masters, const char* prefix);
   void removeFillers();
   void optimizeMirroring();
@@ -211,6 +218,12 @@ class Opendp
   static bool isInside(const Rect& cell, const Rect& box);
   bool isInside(const Cell* cell, const Rect& rect) const;
   PixelPt diamondSearch(const Cell* cell, GridX x, GridY y) const;
+  // Search only rows y_lo..y_hi of the cell's grid.
+  PixelPt diamondSearch(const Cell* cell,
+                        GridX x,
+                        GridY y,
+                        GridY y_lo,
+                        GridY y_hi) const;
   void diamondSearchSide(const Cell* cell,
                          GridX x,
                          GridY y,
@@ -255,6 +268,7 @@ class Opendp
   void prePlace();
   void prePlaceGroups();
   void place();
+  void placeRowBands(const vector<Cell*>& sorted_cells);
   void placeGroups2();
   void brickPlace1(const Group* group);
   void brickPlace2(const Group* group);
@@ -262,12 +276,32 @@ class Opendp
   int anneal(Group* group);
   int refine();
   void setFixedGridCells();
-  void setGridCell(Cell& cell, Pixel* pixel);
+  void setGridCell(Cell& cell, PixelRow& row, GridX x_begin, GridX x_end);
   void groupAssignCellRegions();
   void groupInitPixels();
   void groupInitPixels2();
 
   // checkPlacement
+  void reportPlacementCheck(bool verbose,
+                            bool disallow_one_site_gaps,
+                            const string& report_file_name,
+                            const vector<Cell*>& placed_failures,
+                            const vector<Cell*>& in_rows_failures,
+                            const vector<Cell*>& overlap_failures,
+                            const vector<Cell*>& one_site_gap_failures,
+                            const vector<Cell*>& site_align_failures,
+                            const vector<Cell*>& region_placement_failures);
+  void checkPlacementIncremental(bool verbose,
+                                 bool disallow_one_site_gaps,
+                                 const string& report_file_name);
+  vector<Cell*> updateCheckCache(const std::unordered_set<int>& row_coords);
+  void clearCheckPixels(const bgBox& box);
+  void updateCheckCell(Cell& cell);
+  bgBox checkBox(const Cell* cell) const;
+  bool isCheckAligned(const Cell& cell,
+                      const std::unordered_set<int>& row_coords) const;
+  void checkCachedCell(Cell& cell, const std::unordered_set<int>& row_coords);
+  int cellIndex(const Cell& cell) const;
   static bool isPlaced(const Cell* cell);
   bool checkInRows(const Cell& cell) const;
   const Cell* checkOverlap(Cell& cell) const;
@@ -360,6 +394,7 @@ class Opendp
   int max_displacement_x_ = 0;  // sites
   int max_displacement_y_ = 0;  // sites
   bool disallow_one_site_gaps_ = false;
+  int num_threads_ = 1;
   vector<Cell*> placement_failures_;
 
   // 3D pixel grid
@@ -384,6 +419,11 @@ class Opendp
   int64_t displacement_sum_ = 0;
   int64_t displacement_max_ = 0;
 
+  // Results of the last incremental check_placement.
+  std::unique_ptr<PlacementCheckCache> check_cache_;
+  // Bumped when cells_ or the grid are rebuilt, which the cache refers to.
+  int check_generation_ = 0;
+
   std::unique_ptr<DplObserver> debug_observer_;
   std::unique_ptr<Cell> dummy_cell_;
 
@@ -392,6 +432,9 @@ class Opendp
   static constexpr double group_refine_percent_ = .05;
   static constexpr double refine_percent_ = .02;
   static constexpr int rand_seed_ = 777;
+  // Row band legalization, in rows of the tallest grid.
+  static constexpr int band_row_count_ = 32;
+  static constexpr int band_halo_row_count_ = 2;
 };
 
 int divRound(int dividend, int divisor);
@@ -37,10 +37,14 @@
 #include <cmath>
 #include <fstream>
 #include <limits>
+#include <set>
+#include <tuple>
+#include <unordered_set>
 
 #include "Grid.h"
 #include "Objects.h"
 #include "Padding.h"
+#include "PlacementCheckCache.h"
 #include "dpl/Opendp.h"
 #include "utl/Logger.h"
 namespace dpl {
@@ -54,8 +58,14 @@ using utl::format_as;
 
 void Opendp::checkPlacement(const bool verbose,
                             const bool disallow_one_site_gaps,
-                            const string& report_file_name)
+                            const string& report_file_name,
+                            const bool incremental)
 {
+  if (incremental) {
+    checkPlacementIncremental(
+        verbose, disallow_one_site_gaps, report_file_name);
+    return;
+  }
   importDb();
 
   vector<Cell*> placed_failures;
@@ -106,6 +116,28 @@ void Opendp::checkPlacement(const bool verbose,
       }
     }
   }
+  reportPlacementCheck(verbose,
+                       disallow_one_site_gaps,
+                       report_file_name,
+                       placed_failures,
+                       in_rows_failures,
+                       overlap_failures,
+                       one_site_gap_failures,
+                       site_align_failures,
+                       region_placement_failures);
+}
+
+void Opendp::reportPlacementCheck(
+    const bool verbose,
+    const bool disallow_one_site_gaps,
+    const string& report_file_name,
+    const vector<Cell*>& placed_failures,
+    const vector<Cell*>& in_rows_failures,
+    const vector<Cell*>& overlap_failures,
+    const vector<Cell*>& one_site_gap_failures,
+    const vector<Cell*>& site_align_failures,
+    const vector<Cell*>& region_placement_failures)
+{
   if (!report_file_name.empty()) {
     writeJsonReport(report_file_name,
                     placed_failures,
@@ -139,6 +171,264 @@ void Opendp::checkPlacement(const bool verbose,
   }
 }
 
+// Check only the cells changed since the previous incremental check and
+// their neighbors.  The pixel grid painted by the first check is kept and
+// repainted around the changed cells, so the result and the report are
+// the same as the ones of a full check.
+void Opendp::checkPlacementIncremental(const bool verbose,
+                                       const bool disallow_one_site_gaps,
+                                       const string& report_file_name)
+{
+  const bool cached = check_cache_
+                      && check_cache_->isValid(db_->getChip()->getBlock(),
+                                               check_generation_);
+  if (!cached) {
+    importDb();
+    initGrid();
+    groupAssignCellRegions();
+  }
+  const auto row_coords = grid_->getRowCoordinates();
+  vector<Cell*> recheck_cells;
+  if (cached) {
+    recheck_cells = updateCheckCache(row_coords);
+  } else {
+    check_cache_ = std::make_unique<PlacementCheckCache>(
+        block_, cells_.size(), check_generation_);
+    vector<PlacementCheckCache::CellBox> cell_boxes;
+    cell_boxes.reserve(cells_.size());
+    for (Cell& cell : cells_) {
+      const bgBox box = checkBox(&cell);
+      check_cache_->boxes_[cellIndex(cell)] = box;
+      cell_boxes.emplace_back(box, &cell);
+      // Paint the grid in the same order as the full check.
+      if (isCheckAligned(cell, row_coords)) {
+        checkOverlap(cell);
+      }
+      recheck_cells.push_back(&cell);
+    }
+    // Bulk load packs the tree.
+    check_cache_->cells_ = PlacementCheckCache::RtreeCell(cell_boxes);
+  }
+
+  CheckFailures reported;
+  reported.set();
+  reported.set(kOneSiteGapFailure, disallow_one_site_gaps);
+  int new_failures = 0;
+  int resolved_failures = 0;
+  for (Cell* cell : recheck_cells) {
+    const CheckFailures before = check_cache_->failures_[cellIndex(*cell)];
+    checkCachedCell(*cell, row_coords);
+    const CheckFailures after = check_cache_->failures_[cellIndex(*cell)];
+    if ((after & ~before & reported).any()) {
+      new_failures++;
+    }
+    if ((before & ~after & reported).any()) {
+      resolved_failures++;
+    }
+  }
+  debugPrint(logger_,
+             DPL,
+             "check",
+             1,
+             "Rechecked {} instances, {} with new failures, {} with resolved "
+             "failures.",
+             recheck_cells.size(),
+             new_failures,
+             resolved_failures);
+
+  vector<Cell*> placed_failures;
+  vector<Cell*> in_rows_failures;
+  vector<Cell*> overlap_failures;
+  vector<Cell*> one_site_gap_failures;
+  vector<Cell*> site_align_failures;
+  vector<Cell*> region_placement_failures;
+  for (Cell& cell : cells_) {
+    const CheckFailures& failures = check_cache_->failures_[cellIndex(cell)];
+    if (failures[kPlacedFailure]) {
+      placed_failures.push_back(&cell);
+    }
+    if (failures[kInRowsFailure]) {
+      in_rows_failures.push_back(&cell);
+    }
+    if (failures[kOverlapFailure]) {
+      overlap_failures.push_back(&cell);
+    }
+    if (failures[kOneSiteGapFailure] && disallow_one_site_gaps) {
+      one_site_gap_failures.push_back(&cell);
+    }
+    if (failures[kSiteAlignFailure]) {
+      site_align_failures.push_back(&cell);
+    }
+    if (failures[kRegionFailure]) {
+      region_placement_failures.push_back(&cell);
+    }
+  }
+  reportPlacementCheck(verbose,
+                       disallow_one_site_gaps,
+                       report_file_name,
+                       placed_failures,
+                       in_rows_failures,
+                       overlap_failures,
+                       one_site_gap_failures,
+                       site_align_failures,
+                       region_placement_failures);
+}
+
+// Move the changed cells in the cache, clear the pixels around their old
+// and new boxes and repaint them with the cells covering them in cells_
+// order, which gives every pixel the owner the full check paints.  Returns
+// the cells whose checks can see a repainted pixel, in cells_ order.
+vector<Cell*> Opendp::updateCheckCache(
+    const std::unordered_set<int>& row_coords)
+{
+  namespace bgi = boost::geometry::index;
+  const int site_width = grid_->getSiteWidth().v;
+  int row_height = 0;
+  for (const auto& [grid_key, grid_info] : grid_->getInfoMap()) {
+    row_height = std::max(row_height, grid_info.getSitesTotalHeight().v);
+  }
+  auto bloat = [](const bgBox& box, const int dx, const int dy) {
+    return bgBox(
+        bgPoint(box.min_corner().x() - dx, box.min_corner().y() - dy),
+        bgPoint(box.max_corner().x() + dx, box.max_corner().y() + dy));
+  };
+
+  // The pixels of a cell are its box rounded out to the sites and rows of
+  // every grid, so one site and row of margin covers them.
+  vector<bgBox> regions;
+  for (dbInst* db_inst : check_cache_->dirty_insts_) {
+    auto cell_itr = db_inst_map_.find(db_inst);
+    if (cell_itr == db_inst_map_.end()) {
+      continue;
+    }
+    Cell* cell = cell_itr->second;
+    bgBox& box = check_cache_->boxes_[cellIndex(*cell)];
+    regions.push_back(bloat(box, site_width, row_height));
+    check_cache_->cells_.remove(PlacementCheckCache::CellBox(box, cell));
+    updateCheckCell(*cell);
+    box = checkBox(cell);
+    check_cache_->cells_.insert(PlacementCheckCache::CellBox(box, cell));
+    regions.push_back(bloat(box, site_width, row_height));
+  }
+  check_cache_->dirty_insts_.clear();
+
+  std::set<Cell*> repaint;
+  std::set<Cell*> recheck;
+  auto query = [&](const bgBox& box, std::set<Cell*>& cells) {
+    for (auto it = check_cache_->cells_.qbegin(bgi::intersects(box));
+         it != check_cache_->cells_.qend();
+         ++it) {
+      cells.insert(it->second);
+    }
+  };
+  for (const bgBox& region : regions) {
+    clearCheckPixels(region);
+    query(bloat(region, site_width, row_height), repaint);
+    // one site gaps look two sites away
+    query(bloat(region, 3 * site_width, row_height), recheck);
+  }
+  // Cell pointers into cells_ sort in cells_ order.
+  for (Cell* cell : repaint) {
+    if (isCheckAligned(*cell, row_coords)) {
+      checkOverlap(*cell);
+    }
+  }
+  return vector<Cell*>(recheck.begin(), recheck.end());
+}
+
+// Clear the cell of the pixels under box on every grid.
+void Opendp::clearCheckPixels(const bgBox& box)
+{
+  const int x_begin
+      = std::max(0, grid_->gridX(DbuX{box.min_corner().x()}).v);
+  const int x_end = grid_->gridEndX(DbuX{box.max_corner().x()}).v;
+  const DbuY y_min{box.min_corner().y()};
+  const DbuY y_max{box.max_corner().y()};
+  for (const auto& [grid_key, grid_info] : grid_->getInfoMap()) {
+    const int y_begin = std::max(0, grid_->gridY(y_min, grid_info).first.v);
+    const int y_end = std::min(grid_info.getRowCount().v,
+                               grid_->gridEndY(y_max, grid_info).first.v);
+    const int row_x_end = std::min(x_end, grid_info.getSiteCount().v);
+    for (int y = y_begin; y < y_end; y++) {
+      PixelRow* row = grid_->gridRow(grid_info.getGridIndex(), GridY{y});
+      if (row != nullptr) {
+        row->cell.set(x_begin, row_x_end, nullptr);
+      }
+    }
+  }
+}
+
+// Refresh a cell from its db instance after a move or master swap.
+void Opendp::updateCheckCell(Cell& cell)
+{
+  dbMaster* db_master = cell.db_inst_->getMaster();
+  if (db_master_map_.find(db_master) == db_master_map_.end()) {
+    makeMaster(&db_master_map_[db_master], db_master);
+  }
+  const Rect bbox = getBbox(cell.db_inst_);
+  cell.width_ = DbuX{bbox.dx()};
+  cell.height_ = DbuY{bbox.dy()};
+  cell.x_ = DbuX{bbox.xMin()};
+  cell.y_ = DbuY{bbox.yMin()};
+  cell.orient_ = cell.db_inst_->getOrient();
+  // same region as groupAssignCellRegions
+  if (cell.group_ != nullptr) {
+    cell.region_ = nullptr;
+    for (Rect& rect : cell.group_->region_boundaries) {
+      if (isInside(&cell, rect)) {
+        cell.region_ = &rect;
+      }
+    }
+    if (cell.region_ == nullptr) {
+      cell.region_ = cell.group_->region_boundaries.data();
+    }
+  }
+}
+
+// Box covering every shape overlap() can compare for the cell.
+Opendp::bgBox Opendp::checkBox(const Cell* cell) const
+{
+  const bool padded = padding_->havePadding() && isCrWtBlClass(cell);
+  const DbuPt ll = initialLocation(cell, padded);
+  const DbuX width = padded ? padding_->paddedWidth(cell) : cell->width_;
+  return bgBox(bgPoint(ll.x.v, ll.y.v),
+               bgPoint(ll.x.v + width.v, ll.y.v + cell->height_.v));
+}
+
+// The full check skips the other checks, and the painting, of standard
+// cells that are not on a site.
+bool Opendp::isCheckAligned(const Cell& cell,
+                            const std::unordered_set<int>& row_coords) const
+{
+  return !cell.isStdCell()
+         || (cell.x_ % grid_->getSiteWidth() == 0
+             && row_coords.find(cell.y_.v) != row_coords.end());
+}
+
+// Same checks as checkPlacement, against the painted grid.
+void Opendp::checkCachedCell(Cell& cell,
+                             const std::unordered_set<int>& row_coords)
+{
+  CheckFailures& failures = check_cache_->failures_[cellIndex(cell)];
+  failures.reset();
+  if (!isCheckAligned(cell, row_coords)) {
+    failures.set(kSiteAlignFailure);
+    return;
+  }
+  if (cell.isStdCell()) {
+    failures.set(kInRowsFailure, !checkInRows(cell));
+    failures.set(kRegionFailure, !checkRegionPlacement(&cell));
+  }
+  failures.set(kPlacedFailure, !isPlaced(&cell));
+  failures.set(kOverlapFailure, checkOverlap(cell) != nullptr);
+  failures.set(kOneSiteGapFailure, checkOneSiteGaps(cell) != nullptr);
+}
+
+int Opendp::cellIndex(const Cell& cell) const
+{
+  return &cell - cells_.data();
+}
+
 void Opendp::processViolationsPtree(boost::property_tree::ptree& entry,
                                     const std::vector<Cell*>& failures,
                                     const string& violation_type) const
@@ -342,17 +632,18 @@ bool Opendp::checkInRows(const Cell& cell) const
              y_ll,
              y_ur);
 
+  if (x_ll >= x_ur) {
+    return true;
+  }
   for (GridY y = y_ll; y < y_ur; y++) {
-    for (GridX x = x_ll; x < x_ur; x++) {
-      const Pixel* pixel
-          = grid_->gridPixel(grid_info.second.getGridIndex(), x, y);
-      if (pixel == nullptr  // outside core
-          || !pixel->is_valid) {
-        return false;
-      }
-      if (pixel->site != cell.getSite()) {
-        return false;
-      }
+    const PixelRow* row = grid_->gridRow(grid_info.second.getGridIndex(), y);
+    if (row == nullptr || x_ll < 0
+        || x_ur > grid_info.second.getSiteCount()  // outside core
+        || !row->is_valid.all(x_ll.v, x_ur.v, true)) {
+      return false;
+    }
+    if (row->site != cell.getSite()) {
+      return false;
     }
   }
   return true;
@@ -383,16 +674,26 @@ const Cell* Opendp::checkOverlap(Cell& cell) const
   debugPrint(
       logger_, DPL, "grid", 2, "checking overlap for cell {}", cell.name());
   const Cell* overlap_cell = nullptr;
-  grid_->visitCellPixels(cell, true, [&](Pixel* pixel) {
-    const Cell* pixel_cell = pixel->cell;
-    if (pixel_cell) {
-      if (pixel_cell != &cell && overlap(&cell, pixel_cell)) {
-        overlap_cell = pixel_cell;
-      }
-    } else {
-      pixel->cell = &cell;
-    }
-  });
+  // Report the overlapping pixel that is last in grid, x, y order.
+  std::tuple<int, int, int> overlap_pos{-1, -1, -1};
+  grid_->visitCellPixels(
+      cell,
+      true,
+      [&](const int grid_idx, const GridY y, GridX x_begin, GridX x_end) {
+        SiteRuns<Cell*>& row_cells = grid_->gridRow(grid_idx, y)->cell;
+        row_cells.visit(x_begin.v,
+                        x_end.v,
+                        [&](int, int run_end, Cell* const& pixel_cell) {
+                          const std::tuple<int, int, int> pos{
+                              grid_idx, run_end - 1, y.v};
+                          if (pixel_cell != &cell && pos > overlap_pos
+                              && overlap(&cell, pixel_cell)) {
+                            overlap_cell = pixel_cell;
+                            overlap_pos = pos;
+                          }
+                        });
+        row_cells.fill(x_begin.v, x_end.v, &cell);
+      });
   return overlap_cell;
 }
 
@@ -423,7 +724,7 @@ Cell* Opendp::checkOneSiteGaps(Cell& cell) const
   const auto row_info = grid_->getRowInfo(&cell);
   const int grid_index = row_info.second.getGridIndex();
   grid_->visitCellBoundaryPixels(
-      cell, true, [&](Pixel* pixel, const Direction2D& edge, GridX x, GridY y) {
+      cell, true, [&](const Direction2D& edge, GridX x, GridY y) {
         GridX abut_x{0};
 
         switch (static_cast<Direction2D::Value>(edge)) {
@@ -438,14 +739,13 @@ Cell* Opendp::checkOneSiteGaps(Cell& cell) const
             return;
         }
         // check the abutting pixel
-        const Pixel* abut_pixel = grid_->gridPixel(grid_index, x + abut_x, y);
-        const bool abuttment_exists = (abut_pixel && abut_pixel->cell);
+        const bool abuttment_exists
+            = grid_->gridCell(grid_index, x + abut_x, y) != nullptr;
         if (!abuttment_exists) {
           // check the 1 site gap pixel
-          const Pixel* gap_pixel
-              = grid_->gridPixel(grid_index, x + GridX{2 * abut_x.v}, y);
-          if (gap_pixel) {
-            gap_cell = gap_pixel->cell;
+          const GridX gap_x = x + GridX{2 * abut_x.v};
+          if (grid_->inGrid(grid_index, gap_x, y)) {
+            gap_cell = grid_->gridCell(grid_index, gap_x, y);
           }
         }
       });
@@ -281,16 +281,14 @@ void Opendp::findGapsInRow(GridY row,
   const DbuX site_width = grid_->getSiteWidth();
   GridX row_site_count{divFloor(grid_->getCore().dx(), site_width.v)};
   while (j < row_site_count) {
-    Pixel* pixel = grid_->gridPixel(grid_info.getGridIndex(), j, row);
-    const dbOrientType orient = pixel->orient_;
-    if (pixel->cell == nullptr && pixel->is_valid) {
-      GridX k = j;
-      while (k < row_site_count
-             && grid_->gridPixel(grid_info.getGridIndex(), k, row)->cell
-                    == nullptr
-             && grid_->gridPixel(grid_info.getGridIndex(), k, row)->is_valid) {
-        k++;
-      }
+    const PixelRow* pixels = grid_->gridRow(grid_info.getGridIndex(), row);
+    const dbOrientType orient = pixels->orient.get(j.v);
+    // Sites up to the next occupancy or validity change are alike.
+    const GridX span_end{
+        std::min(pixels->cell.spanEnd(j.v, row_site_count.v),
+                 pixels->is_valid.spanEnd(j.v, row_site_count.v))};
+    if (pixels->cell.get(j.v) == nullptr && pixels->is_valid.get(j.v)) {
+      GridX k = span_end;
       const Rect core = grid_->getCore();
       // Save gap information (pos in dbu)
       DbuX gap_x{core.xMin() + gridToDbu(j, site_width)};
@@ -301,7 +299,7 @@ void Opendp::findGapsInRow(GridY row,
 
       j += (k - j);
     } else {
-      j++;
+      j = span_end;
     }
   }
 }
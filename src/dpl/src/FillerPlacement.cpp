@@ -143,7 +143,11 @@ void Opendp::setGridCells()
 {
   for (Cell& cell : cells_) {
     grid_->visitCellPixels(
-        cell, false, [&](Pixel* pixel) { setGridCell(cell, pixel); });
+        cell,
+        false,
+        [&](int grid_idx, GridY y, GridX x_begin, GridX x_end) {
+          setGridCell(cell, *grid_->gridRow(grid_idx, y), x_begin, x_end);
+        });
   }
 }
 
@@ -158,27 +162,25 @@ void Opendp::placeRowFillers(GridY row,
   const DbuX site_width = grid_->getSiteWidth();
   GridX row_site_count{divFloor(grid_->getCore().dx(), site_width.v)};
   while (j < row_site_count) {
-    Pixel* pixel = grid_->gridPixel(grid_info.getGridIndex(), j, row);
-    const dbOrientType orient = pixel->orient_;
-    if (pixel->cell == nullptr && pixel->is_valid) {
-      GridX k = j;
-      while (k < row_site_count
-             && grid_->gridPixel(grid_info.getGridIndex(), k, row)->cell
-                    == nullptr
-             && grid_->gridPixel(grid_info.getGridIndex(), k, row)->is_valid) {
-        k++;
-      }
+    const PixelRow* pixels = grid_->gridRow(grid_info.getGridIndex(), row);
+    const dbOrientType orient = pixels->orient.get(j.v);
+    // Sites up to the next occupancy or validity change are alike.
+    const GridX span_end{
+        std::min(pixels->cell.spanEnd(j.v, row_site_count.v),
+                 pixels->is_valid.spanEnd(j.v, row_site_count.v))};
+    if (pixels->cell.get(j.v) == nullptr && pixels->is_valid.get(j.v)) {
+      GridX k = span_end;
 
       dbTechLayer* implant = nullptr;
       if (j > 0) {
-        auto pixel = grid_->gridPixel(grid_info.getGridIndex(), j - 1, row);
-        if (pixel->cell && pixel->cell->db_inst_) {
-          implant = getImplant(pixel->cell->db_inst_->getMaster());
+        const Cell* cell = pixels->cell.get((j - 1).v);
+        if (cell && cell->db_inst_) {
+          implant = getImplant(cell->db_inst_->getMaster());
         }
       } else if (k < row_site_count) {
-        auto pixel = grid_->gridPixel(grid_info.getGridIndex(), k, row);
-        if (pixel->cell && pixel->cell->db_inst_) {
-          implant = getImplant(pixel->cell->db_inst_->getMaster());
+        const Cell* cell = pixels->cell.get(k.v);
+        if (cell && cell->db_inst_) {
+          implant = getImplant(cell->db_inst_->getMaster());
         }
       } else {  // totally empty row - use anything
         implant = filler_masters_by_implant.begin()->first;
@@ -223,7 +225,7 @@ void Opendp::placeRowFillers(GridY row,
         j += gap;
       }
     } else {
-      j++;
+      j = span_end;
     }
   }
 }
@@ -239,7 +241,7 @@ const char* Opendp::gridInstName(GridY row,
     return "core_right";
   }
 
-  const Cell* cell = grid_->gridPixel(grid_info.getGridIndex(), col, row)->cell;
+  const Cell* cell = grid_->gridCell(grid_info.getGridIndex(), col, row);
   if (cell) {
     return cell->db_inst_->getConstName();
   }
@@ -61,8 +61,8 @@ using odb::dbRow;
 
 using utl::format_as;
 
-PixelPt::PixelPt(Pixel* pixel1, GridX grid_x, GridY grid_y)
-    : pixel(pixel1), x(grid_x), y(grid_y)
+PixelPt::PixelPt(dbSite* site1, GridX grid_x, GridY grid_y)
+    : found(true), site(site1), x(grid_x), y(grid_y)
 {
 }
 
@@ -336,27 +336,22 @@ void Grid::initGrid(dbDatabase* db,
 
   for (auto& [gmk, grid_info] : getInfoMap()) {
     const GridY layer_row_count = grid_info.getRowCount();
-    const GridX layer_row_site_count = grid_info.getSiteCount();
     const int index = grid_info.getGridIndex();
     resize(index, layer_row_count);
     for (GridY j{0}; j < layer_row_count; j++) {
-      resize(index, j, layer_row_site_count);
       const auto& grid_sites = grid_info.getSites();
       dbSite* row_site = nullptr;
       if (!grid_sites.empty()) {
         row_site = grid_sites[j.v % grid_sites.size()].site;
       }
 
-      for (GridX k{0}; k < layer_row_site_count; k++) {
-        Pixel& pixel = pixels_[index][j.v][k.v];
-        pixel.cell = nullptr;
-        pixel.group = nullptr;
-        pixel.util = 0.0;
-        pixel.is_valid = false;
-        pixel.is_hopeless = false;
-        pixel.site = nullptr;
-        pixel.site = row_site;
-      }
+      PixelRow& row = pixels_[index][j.v];
+      row.cell.clear();
+      row.group.clear();
+      row.is_valid.clear();
+      row.is_hopeless.clear();
+      row.orient.clear();
+      row.site = row_site;
     }
   }
 
@@ -386,13 +381,12 @@ void Grid::initGrid(dbDatabase* db,
     const GridX x_start{(orig.x() - core.xMin()) / site_width};
     const GridX x_end{x_start + current_row_site_count};
     const GridY y_row{gridY(DbuY{orig.y() - core.yMin()}, entry).first};
-    for (GridX x{x_start}; x < x_end; x++) {
-      Pixel* pixel = gridPixel(current_row_grid_index, x, y_row);
-      if (pixel == nullptr) {
-        continue;
-      }
-      pixel->is_valid = true;
-      pixel->orient_ = db_row->getOrient();
+    PixelRow* row = gridRow(current_row_grid_index, y_row);
+    if (row != nullptr) {
+      const int xl = max(0, x_start.v);
+      const int xh = min(entry.getSiteCount().v, x_end.v);
+      row->is_valid.set(xl, xh, true);
+      row->orient.set(xl, xh, db_row->getOrient());
     }
 
     // The safety margin is to avoid having only a very few sites
@@ -430,10 +424,8 @@ void Grid::initGrid(dbDatabase* db,
       yhi = min(grid_info.getRowCount(), yhi);
 
       for (GridY y = ylo; y < yhi; y++) {
-        for (GridX x = xlo; x < xhi; x++) {
-          Pixel& pixel1 = pixel(grid_info.getGridIndex(), y, x);
-          pixel1.is_valid = false;
-        }
+        pixels_[grid_info.getGridIndex()][y.v].is_valid.set(
+            xlo.v, xhi.v, false);
       }
     }
   }
@@ -445,32 +437,93 @@ void Grid::initGrid(dbDatabase* db,
     hopeless[h_index].get_rectangles(rects);
     for (const auto& rect : rects) {
       for (int y = gtl::yl(rect); y < gtl::yh(rect); y++) {
-        for (int x = gtl::xl(rect); x < gtl::xh(rect); x++) {
-          Pixel& pixel = pixels_[h_index][y][x];
-          pixel.is_hopeless = true;
-        }
+        pixels_[h_index][y].is_hopeless.set(
+            gtl::xl(rect), gtl::xh(rect), true);
       }
     }
   }
 }
 
-Pixel* Grid::gridPixel(int grid_idx, GridX grid_x, GridY grid_y) const
+PixelRow* Grid::gridRow(int grid_idx, GridY grid_y) const
 {
   if (grid_idx < 0 || grid_idx >= grid_info_vector_.size()) {
     return nullptr;
   }
   const GridInfo* grid_info = grid_info_vector_[grid_idx];
-  if (grid_x >= 0 && grid_x < grid_info->getSiteCount() && grid_y >= 0
-      && grid_y < grid_info->getRowCount()) {
-    return const_cast<Pixel*>(&pixels_[grid_idx][grid_y.v][grid_x.v]);
+  if (grid_y >= 0 && grid_y < grid_info->getRowCount()) {
+    return const_cast<PixelRow*>(&pixels_[grid_idx][grid_y.v]);
   }
   return nullptr;
 }
 
+bool Grid::inGrid(int grid_idx, GridX grid_x, GridY grid_y) const
+{
+  return gridRow(grid_idx, grid_y) != nullptr && grid_x >= 0
+         && grid_x < grid_info_vector_[grid_idx]->getSiteCount();
+}
+
+Cell* Grid::gridCell(int grid_idx, GridX grid_x, GridY grid_y) const
+{
+  if (!inGrid(grid_idx, grid_x, grid_y)) {
+    return nullptr;
+  }
+  return pixels_[grid_idx][grid_y.v].cell.get(grid_x.v);
+}
+
+Group* Grid::gridGroup(int grid_idx, GridX grid_x, GridY grid_y) const
+{
+  if (!inGrid(grid_idx, grid_x, grid_y)) {
+    return nullptr;
+  }
+  return pixels_[grid_idx][grid_y.v].group.get(grid_x.v);
+}
+
+bool Grid::isValid(int grid_idx, GridX grid_x, GridY grid_y) const
+{
+  return inGrid(grid_idx, grid_x, grid_y)
+         && pixels_[grid_idx][grid_y.v].is_valid.get(grid_x.v);
+}
+
+bool Grid::isHopeless(int grid_idx, GridX grid_x, GridY grid_y) const
+{
+  return inGrid(grid_idx, grid_x, grid_y)
+         && pixels_[grid_idx][grid_y.v].is_hopeless.get(grid_x.v);
+}
+
+dbOrientType Grid::gridOrient(int grid_idx, GridX grid_x, GridY grid_y) const
+{
+  if (!inGrid(grid_idx, grid_x, grid_y)) {
+    return dbOrientType();
+  }
+  return pixels_[grid_idx][grid_y.v].orient.get(grid_x.v);
+}
+
+dbSite* Grid::gridSite(int grid_idx, GridY grid_y) const
+{
+  const PixelRow* row = gridRow(grid_idx, grid_y);
+  return row ? row->site : nullptr;
+}
+
+void Grid::visitRowSpan(int grid_idx,
+                        GridY y,
+                        GridX x_begin,
+                        GridX x_end,
+                        const PixelSpanVisitor& visitor) const
+{
+  if (gridRow(grid_idx, y) == nullptr) {
+    return;
+  }
+  x_begin = max(GridX{0}, x_begin);
+  x_end = min(grid_info_vector_[grid_idx]->getSiteCount(), x_end);
+  if (x_begin < x_end) {
+    visitor(grid_idx, y, x_begin, x_end);
+  }
+}
+
 void Grid::visitCellPixels(
     Cell& cell,
     bool padded,
-    const std::function<void(Pixel* pixel)>& visitor) const
+    const PixelSpanVisitor& visitor) const
 {
   dbInst* inst = cell.db_inst_;
   auto obstructions = inst->getMaster()->getObstructions();
@@ -501,13 +554,8 @@ void Grid::visitCellPixels(
         if (layer_y_end == layer_y_start) {
           ++layer_y_end;
         }
-        for (GridX x = x_start; x < x_end; x++) {
-          for (GridY y{layer_y_start}; y < layer_y_end; y++) {
-            Pixel* pixel = gridPixel(grid_idx, x, y);
-            if (pixel) {
-              visitor(pixel);
-            }
-          }
+        for (GridY y{layer_y_start}; y < layer_y_end; y++) {
+          visitRowSpan(grid_idx, y, x_start, x_end, visitor);
         }
         grid_idx++;
       }
@@ -533,13 +581,12 @@ void Grid::visitCellPixels(
         ++layer_x_end;
       }
 
-      for (GridX x{layer_x_start}; x < layer_x_end; x++) {
-        for (GridY y{layer_y_start}; y < layer_y_end; y++) {
-          Pixel* pixel = gridPixel(layer_it.second.getGridIndex(), x, y);
-          if (pixel) {
-            visitor(pixel);
-          }
-        }
+      for (GridY y{layer_y_start}; y < layer_y_end; y++) {
+        visitRowSpan(layer_it.second.getGridIndex(),
+                     y,
+                     layer_x_start,
+                     layer_x_end,
+                     visitor);
       }
     }
   }
@@ -548,9 +595,8 @@ void Grid::visitCellPixels(
 void Grid::visitCellBoundaryPixels(
     Cell& cell,
     bool padded,
-    const std::function<
-        void(Pixel* pixel, odb::Direction2D edge, GridX x, GridY y)>& visitor)
-    const
+    const std::function<void(odb::Direction2D edge, GridX x, GridY y)>&
+        visitor) const
 {
   dbInst* inst = cell.db_inst_;
   const GridMapKey& gmk = getGridMapKey(&cell);
@@ -562,23 +608,19 @@ void Grid::visitCellBoundaryPixels(
                                                const GridY y_start,
                                                const GridY y_end) {
     for (GridX x = x_start; x < x_end; x++) {
-      Pixel* pixel = gridPixel(index_in_grid, x, y_start);
-      if (pixel) {
-        visitor(pixel, odb::Direction2D::North, x, y_start);
+      if (inGrid(index_in_grid, x, y_start)) {
+        visitor(odb::Direction2D::North, x, y_start);
       }
-      pixel = gridPixel(index_in_grid, x, y_end - 1);
-      if (pixel) {
-        visitor(pixel, odb::Direction2D::South, x, y_end - 1);
+      if (inGrid(index_in_grid, x, y_end - 1)) {
+        visitor(odb::Direction2D::South, x, y_end - 1);
       }
     }
     for (GridY y = y_start; y < y_end; y++) {
-      Pixel* pixel = gridPixel(index_in_grid, x_start, y);
-      if (pixel) {
-        visitor(pixel, odb::Direction2D::West, x_start, y);
+      if (inGrid(index_in_grid, x_start, y)) {
+        visitor(odb::Direction2D::West, x_start, y);
       }
-      pixel = gridPixel(index_in_grid, x_end - 1, y);
-      if (pixel) {
-        visitor(pixel, odb::Direction2D::East, x_end - 1, y);
+      if (inGrid(index_in_grid, x_end - 1, y)) {
+        visitor(odb::Direction2D::East, x_end - 1, y);
       }
     }
   };
@@ -654,15 +696,15 @@ void Grid::erasePixel(Cell* cell)
         ++layer_y_end;
       }
 
-      for (GridX x = gridPaddedX(cell); x < x_end; x++) {
-        for (GridY y = layer_y_start; y < layer_y_end; y++) {
-          Pixel* pixel = gridPixel(target_grid_info.getGridIndex(), x, y);
-          if (nullptr == pixel) {
-            continue;
-          }
-          pixel->cell = nullptr;
-          pixel->util = 0;
-        }
+      for (GridY y = layer_y_start; y < layer_y_end; y++) {
+        visitRowSpan(target_grid_info.getGridIndex(),
+                     y,
+                     gridPaddedX(cell),
+                     x_end,
+                     [this](int grid_idx, GridY row, GridX begin, GridX end) {
+                       pixels_[grid_idx][row.v].cell.set(
+                           begin.v, end.v, nullptr);
+                     });
       }
     }
     cell->is_placed_ = false;
@@ -730,17 +772,21 @@ void Grid::paintPixel(Cell* cell, GridX grid_x, GridY grid_y)
   const int index_in_grid = gmk.grid_index;
   setGridPaddedLoc(cell, grid_x, grid_y);
   cell->is_placed_ = true;
-  for (GridX x{grid_x}; x < x_end; x++) {
-    for (GridY y{grid_y}; y < y_end; y++) {
-      Pixel* pixel = gridPixel(index_in_grid, x, y);
-      if (pixel->cell) {
-        logger_->error(
-            DPL, 13, "Cannot paint grid because it is already occupied.");
-      } else {
-        pixel->cell = cell;
-        pixel->util = 1.0;
-      }
-    }
+  for (GridY y{grid_y}; y < y_end; y++) {
+    visitRowSpan(index_in_grid,
+                 y,
+                 grid_x,
+                 x_end,
+                 [&](int grid_idx, GridY row, GridX begin, GridX end) {
+                   SiteRuns<Cell*>& row_cells = pixels_[grid_idx][row.v].cell;
+                   if (row_cells.any(begin.v, end.v)) {
+                     logger_->error(
+                         DPL,
+                         13,
+                         "Cannot paint grid because it is already occupied.");
+                   }
+                   row_cells.set(begin.v, end.v, cell);
+                 });
   }
 
   for (const auto& layer : getInfoMap()) {
@@ -769,39 +815,42 @@ void Grid::paintPixel(Cell* cell, GridX grid_x, GridY grid_y)
       layer_y_end = GridY{layer.second.getRowCount()};
     }
 
-    for (GridX x = layer_x; x < layer_x_end; x++) {
-      for (GridY y = layer_y; y < layer_y_end; y++) {
-        Pixel* pixel = gridPixel(layer.second.getGridIndex(), x, y);
-        if (pixel && pixel->cell) {
-          // Checks that the row heights of the found cell match the row
-          // height of this layer. If they don't, it means that this pixel is
-          // partially filled by a single-height or shorter cell, which is
-          // allowed. However, if they do match, it means that we are trying
-          // to overwrite a double-height cell placement, which is an error.
-          auto candidate_grid_key = getGridMapKey(pixel->cell);
-          if (candidate_grid_key == layer.first) {
-            // Occupied by a multi-height cell this should not happen.
-            logger_->error(DPL,
-                           41,
-                           "Cannot paint grid with cell {} because another "
-                           "layer [{}] is already occupied by cell {}.",
-                           cell->name(),
-                           layer.first.grid_index,
-                           pixel->cell->name());
-          } else {
-            // We might not want to overwrite the cell that's already here.
-            continue;
-          }
-        }
-        if (pixel) {
-          pixel->cell = cell;
-          pixel->util = 1.0;
-        }
-      }
+    for (GridY y = layer_y; y < layer_y_end; y++) {
+      visitRowSpan(
+          layer.second.getGridIndex(),
+          y,
+          layer_x,
+          layer_x_end,
+          [&](int grid_idx, GridY row, GridX begin, GridX end) {
+            SiteRuns<Cell*>& row_cells = pixels_[grid_idx][row.v].cell;
+            row_cells.visit(
+                begin.v, end.v, [&](int, int, Cell* const& pixel_cell) {
+                  // Checks that the row heights of the found cell match the
+                  // row height of this layer. If they don't, it means that
+                  // this pixel is partially filled by a single-height or
+                  // shorter cell, which is allowed. However, if they do
+                  // match, it means that we are trying to overwrite a
+                  // double-height cell placement, which is an error.
+                  auto candidate_grid_key = getGridMapKey(pixel_cell);
+                  if (candidate_grid_key == layer.first) {
+                    // Occupied by a multi-height cell this should not happen.
+                    logger_->error(DPL,
+                                   41,
+                                   "Cannot paint grid with cell {} because "
+                                   "another layer [{}] is already occupied by "
+                                   "cell {}.",
+                                   cell->name(),
+                                   layer.first.grid_index,
+                                   pixel_cell->name());
+                  }
+                });
+            // We might not want to overwrite the cells that are already here.
+            row_cells.fill(begin.v, end.v, cell);
+          });
     }
   }
 
-  cell->orient_ = gridPixel(index_in_grid, grid_x, grid_y)->orient_;
+  cell->orient_ = gridOrient(index_in_grid, grid_x, grid_y);
 }
 
 void Grid::addSiteToGrid(dbSite* site, const GridMapKey& key)
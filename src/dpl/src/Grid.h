@@ -42,6 +42,7 @@
 #include <unordered_set>
 
 #include "Coordinates.h"
+#include "SiteRuns.h"
 #include "dpl/Opendp.h"
 
 namespace dpl {
@@ -61,15 +62,17 @@ struct DbuPoint
   DbuY y;
 };
 
-struct Pixel
+// Occupancy and legality of one grid row.  Everything but the row site is
+// run length encoded, so a row costs memory in proportion to the cells,
+// row fragments and blockages on it rather than to its site count.
+struct PixelRow
 {
-  Cell* cell = nullptr;
-  Group* group = nullptr;
-  double util = 0.0;
-  dbOrientType orient_;
-  bool is_valid = false;     // false for dummy cells
-  bool is_hopeless = false;  // too far from sites for diamond search
-  dbSite* site = nullptr;    // site that this pixel is
+  SiteRuns<Cell*> cell;
+  SiteRuns<Group*> group;
+  SiteRuns<bool> is_valid;     // false for dummy cells
+  SiteRuns<bool> is_hopeless;  // too far from sites for diamond search
+  SiteRuns<dbOrientType::Value> orient;
+  dbSite* site = nullptr;  // site of the row
 };
 
 // Return value for grid searches.
@@ -77,8 +80,9 @@ class PixelPt
 {
  public:
   PixelPt() = default;
-  PixelPt(Pixel* pixel, GridX grid_x, GridY grid_y);
-  Pixel* pixel = nullptr;
+  PixelPt(dbSite* site, GridX grid_x, GridY grid_y);
+  bool found = false;
+  dbSite* site = nullptr;
   GridX x{0};
   GridY y{0};
 };
@@ -111,6 +115,9 @@ class GridInfo
   const dbSite::RowPattern sites_;
 };
 
+using PixelSpanVisitor = std::function<
+    void(int grid_idx, GridY y, GridX x_begin, GridX x_end)>;
+
 struct GridMapKey
 {
   int grid_index{0};
@@ -127,7 +134,8 @@ struct GridMapKey
 // The "Grid" is now an array of 2D grids. The new dimension is to support
 // multi-height cells. Each unique row height creates a new grid that is used in
 // legalization. The first index is the grid index (corresponding to row
-// height), second index is the row index, and third index is the site index.
+// height) and the second index is the row index. Each row holds run length
+// encoded pixels indexed by site.
 class Grid
 {
  public:
@@ -163,15 +171,16 @@ class Grid
 
   void paintPixel(Cell* cell, GridX grid_x, GridY grid_y);
   void erasePixel(Cell* cell);
+  // Visit the pixels under cell as spans [x_begin, x_end) of grid rows.
+  // Spans are clipped to the grid.
   void visitCellPixels(Cell& cell,
                        bool padded,
-                       const std::function<void(Pixel* pixel)>& visitor) const;
+                       const PixelSpanVisitor& visitor) const;
   void visitCellBoundaryPixels(
       Cell& cell,
       bool padded,
-      const std::function<
-          void(Pixel* pixel, odb::Direction2D edge, GridX x, GridY y)>& visitor)
-      const;
+      const std::function<void(odb::Direction2D edge, GridX x, GridY y)>&
+          visitor) const;
 
   GridY getRowCount() const { return row_count_; }
   GridX getRowSiteCount() const { return row_site_count_; }
@@ -183,16 +192,19 @@ class Grid
                          const GridMapKey& target_grid_key,
                          bool start) const;
 
-  Pixel* gridPixel(int grid_idx, GridX x, GridY y) const;
-  Pixel& pixel(int g, GridY y, GridX x) { return pixels_[g][y.v][x.v]; }
-  const Pixel& pixel(int g, GridY y, GridX x) const
-  {
-    return pixels_[g][y.v][x.v];
-  }
+  // nullptr outside the grid.
+  PixelRow* gridRow(int grid_idx, GridY y) const;
+  bool inGrid(int grid_idx, GridX x, GridY y) const;
+  // Pixel queries return nullptr/false outside the grid.
+  Cell* gridCell(int grid_idx, GridX x, GridY y) const;
+  Group* gridGroup(int grid_idx, GridX x, GridY y) const;
+  bool isValid(int grid_idx, GridX x, GridY y) const;
+  bool isHopeless(int grid_idx, GridX x, GridY y) const;
+  dbOrientType gridOrient(int grid_idx, GridX x, GridY y) const;
+  dbSite* gridSite(int grid_idx, GridY y) const;
 
   void resize(int size) { pixels_.resize(size); }
   void resize(int g, GridY size) { pixels_[g].resize(size.v); }
-  void resize(int g, GridY y, GridX size) { pixels_[g][y.v].resize(size.v); }
   void clear() { pixels_.clear(); }
 
   GridInfo& infoMap(const GridMapKey& key) { return grid_info_map_.at(key); }
@@ -225,11 +237,17 @@ class Grid
   void addInfoMap(const GridMapKey& key, const GridInfo& info);
   void visitDbRows(dbBlock* block,
                    const std::function<void(odb::dbRow*)>& func) const;
+  void visitRowSpan(int grid_idx,
+                    GridY y,
+                    GridX x_begin,
+                    GridX x_end,
+                    const PixelSpanVisitor& visitor) const;
 
   Logger* logger_ = nullptr;
   dbBlock* block_ = nullptr;
   std::shared_ptr<Padding> padding_;
-  std::vector<std::vector<std::vector<Pixel>>> pixels_;
+  // grid index -> row -> pixels
+  std::vector<std::vector<PixelRow>> pixels_;
   std::vector<const GridInfo*> grid_info_vector_;
   map<GridMapKey, GridInfo> grid_info_map_;
   std::unordered_map<dbSite*, dbSite*> hybrid_parent_;  // child -> parent
@@ -41,6 +41,7 @@
 
 #include <boost/property_tree/json_parser.hpp>
 #include <boost/property_tree/ptree.hpp>
+#include <algorithm>
 #include <cfloat>
 #include <cmath>
 #include <iostream>
@@ -51,6 +52,7 @@
 #include "Grid.h"
 #include "Objects.h"
 #include "Padding.h"
+#include "PlacementCheckCache.h"
 #include "dpl/OptMirror.h"
 #include "odb/util.h"
 #include "utl/Logger.h"
@@ -96,16 +98,19 @@ void Opendp::init(dbDatabase* db, Logger* logger)
 void Opendp::setPaddingGlobal(const int left, const int right)
 {
   padding_->setPaddingGlobal(GridX{left}, GridX{right});
+  check_cache_.reset();
 }
 
 void Opendp::setPadding(dbInst* inst, const int left, const int right)
 {
   padding_->setPadding(inst, GridX{left}, GridX{right});
+  check_cache_.reset();
 }
 
 void Opendp::setPadding(dbMaster* master, const int left, const int right)
 {
   padding_->setPadding(master, GridX{left}, GridX{right});
+  check_cache_.reset();
 }
 
 void Opendp::setDebug(std::unique_ptr<DplObserver>& observer)
@@ -116,7 +121,8 @@ void Opendp::setDebug(std::unique_ptr<DplObserver>& observer)
 void Opendp::detailedPlacement(const int max_displacement_x,
                                const int max_displacement_y,
                                const std::string& report_file_name,
-                               const bool disallow_one_site_gaps)
+                               const bool disallow_one_site_gaps,
+                               const int num_threads)
 {
   importDb();
 
@@ -133,6 +139,7 @@ void Opendp::detailedPlacement(const int max_displacement_x,
     max_displacement_y_ = max_displacement_y;
   }
   disallow_one_site_gaps_ = disallow_one_site_gaps;
+  num_threads_ = std::max(1, num_threads);
   if (!have_one_site_cells_) {
     // If 1-site fill cell is not detected && no disallow_one_site_gaps flag:
     // warn the user then continue as normal
@@ -276,12 +283,14 @@ int Opendp::padRight(dbInst* inst) const
 
 void Opendp::initGrid()
 {
+  check_generation_++;
   grid_->initGrid(
       db_, block_, padding_, max_displacement_x_, max_displacement_y_);
 }
 
 void Opendp::deleteGrid()
 {
+  check_generation_++;
   grid_->clear();
 }
 
@@ -298,18 +307,24 @@ void Opendp::setFixedGridCells()
   for (Cell& cell : cells_) {
     if (cell.isFixed()) {
       grid_->visitCellPixels(
-          cell, true, [&](Pixel* pixel) { setGridCell(cell, pixel); });
+          cell,
+          true,
+          [&](int grid_idx, GridY y, GridX x_begin, GridX x_end) {
+            setGridCell(cell, *grid_->gridRow(grid_idx, y), x_begin, x_end);
+          });
     }
   }
 }
 
-void Opendp::setGridCell(Cell& cell, Pixel* pixel)
+void Opendp::setGridCell(Cell& cell,
+                         PixelRow& row,
+                         const GridX x_begin,
+                         const GridX x_end)
 {
-  pixel->cell = &cell;
-  pixel->util = 1.0;
+  row.cell.set(x_begin.v, x_end.v, &cell);
   if ((&cell)->isBlock()) {
     // Try the is_hopeless strategy to get off of a block
-    pixel->is_hopeless = true;
+    row.is_hopeless.set(x_begin.v, x_end.v, true);
   }
 }
 
@@ -329,13 +344,22 @@ void Opendp::groupAssignCellRegions()
       const auto gmk = grid_->getGridMapKey(group_cell);
       const auto& grid_info = grid_->getInfoMap().at(gmk);
 
-      for (GridX x{0}; x < max_row_site_count; x++) {
-        for (GridY y{0}; y < row_count; y++) {
-          const Pixel* pixel = grid_->gridPixel(grid_info.getGridIndex(), x, y);
-          if (pixel->is_valid && pixel->group == &group) {
-            total_site_area += site_area;
-          }
+      for (GridY y{0}; y < row_count; y++) {
+        const PixelRow* row = grid_->gridRow(grid_info.getGridIndex(), y);
+        if (row == nullptr) {
+          continue;
         }
+        row->group.visit(
+            0,
+            max_row_site_count.v,
+            [&](int x_begin, int x_end, Group* const& pixel_group) {
+              if (pixel_group != &group) {
+                return;
+              }
+              row->is_valid.visit(x_begin, x_end, [&](int b, int e, bool) {
+                total_site_area += (e - b) * site_area;
+              });
+            });
       }
     }
 
@@ -360,28 +384,39 @@ void Opendp::groupAssignCellRegions()
 
 void Opendp::groupInitPixels2()
 {
+  const DbuX site_width = grid_->getSiteWidth();
   for (auto& layer : grid_->getInfoMap()) {
     const GridInfo& grid_info = layer.second;
     const GridY row_count = layer.second.getRowCount();
     const GridX row_site_count = layer.second.getSiteCount();
     const auto& grid_sites = layer.second.getSites();
-    for (GridX x{0}; x < row_site_count; x++) {
-      for (GridY y{0}; y < row_count; y++) {
-        const int row_height
-            = grid_sites[y.v % grid_sites.size()].site->getHeight();
-        const DbuX site_width = grid_->getSiteWidth();
-        const Rect sub(x.v * site_width.v,
-                       y.v * row_height,
-                       (x + 1).v * site_width.v,
-                       (y + 1).v * row_height);
-        Pixel* pixel = grid_->gridPixel(grid_info.getGridIndex(), x, y);
-        for (Group& group : groups_) {
-          for (Rect& rect : group.region_boundaries) {
-            if (!isInside(sub, rect) && checkOverlap(sub, rect)) {
-              pixel->util = 0.0;
-              pixel->cell = dummy_cell_.get();
-              pixel->is_valid = false;
-            }
+    for (GridY y{0}; y < row_count; y++) {
+      const int row_height
+          = grid_sites[y.v % grid_sites.size()].site->getHeight();
+      const int row_yl = y.v * row_height;
+      const int row_yh = (y + 1).v * row_height;
+      PixelRow* row = grid_->gridRow(grid_info.getGridIndex(), y);
+      auto mark_dummy = [&](const int x_begin, const int x_end) {
+        row->cell.set(x_begin, x_end, dummy_cell_.get());
+        row->is_valid.set(x_begin, x_end, false);
+      };
+      for (Group& group : groups_) {
+        for (Rect& rect : group.region_boundaries) {
+          if (rect.yMin() >= row_yh || rect.yMax() <= row_yl) {
+            continue;
+          }
+          // Sites overlapping the region.
+          const int x_lo = std::max(0, divFloor(rect.xMin(), site_width.v));
+          const int x_hi
+              = std::min(row_site_count.v, divCeil(rect.xMax(), site_width.v));
+          if (rect.yMin() <= row_yl && rect.yMax() >= row_yh) {
+            // Only the sites at the ends can be partially covered.
+            const int in_lo = divCeil(rect.xMin(), site_width.v);
+            const int in_hi = divFloor(rect.xMax(), site_width.v);
+            mark_dummy(x_lo, std::min(in_lo, x_hi));
+            mark_dummy(std::max(in_hi, x_lo), x_hi);
+          } else {
+            mark_dummy(x_lo, x_hi);
           }
         }
       }
@@ -404,15 +439,17 @@ bool Opendp::checkOverlap(const Rect& cell, const Rect& box)
 
 void Opendp::groupInitPixels()
 {
-  for (const auto& layer : grid_->getInfoMap()) {
-    const GridInfo& grid_info = layer.second;
-    for (GridX x{0}; x < grid_info.getSiteCount(); x++) {
-      for (GridY y{0}; y < grid_info.getRowCount(); y++) {
-        Pixel* pixel = grid_->gridPixel(grid_info.getGridIndex(), x, y);
-        pixel->util = 0.0;
-      }
-    }
-  }
+  // Columns [col_start, col_end) of a group region in one row.  The
+  // fractions of the end sites outside the region are subtracted from the
+  // utilization of col_start and col_end - 1.
+  struct RegionSpan
+  {
+    int col_start;
+    int col_end;
+    double start_adjust;
+    double end_adjust;
+  };
+
   for (Group& group : groups_) {
     if (group.cells_.empty()) {
       logger_->warn(DPL, 42, "No cells found in group {}. ", group.name);
@@ -423,6 +460,7 @@ void Opendp::groupInitPixels()
     const GridInfo& grid_info = grid_->getInfoMap().at(gmk);
     const int grid_index = grid_info.getGridIndex();
     const DbuX site_width = grid_->getSiteWidth();
+    map<int, vector<RegionSpan>> row_spans;
     for (const DbuRect rect : group.region_boundaries) {
       debugPrint(logger_,
                  DPL,
@@ -436,47 +474,69 @@ void Opendp::groupInitPixels()
                  rect.yh);
       const GridY row_start{dbuToGridCeil(rect.yl, row_height)};
       const GridY row_end{dbuToGridFloor(rect.yh, row_height)};
-
+      const GridX col_start{dbuToGridCeil(rect.xl, site_width)};
+      const GridX col_end{dbuToGridFloor(rect.xh, site_width)};
+      RegionSpan span{col_start.v, col_end.v, 0.0, 0.0};
+      if (rect.xl % site_width != 0) {
+        span.start_adjust
+            = (rect.xl % site_width).v / static_cast<double>(site_width.v);
+      }
+      if (rect.xh % site_width != 0) {
+        span.end_adjust = ((site_width - rect.xh) % site_width).v
+                          / static_cast<double>(site_width.v);
+      }
       for (GridY k{row_start}; k < row_end; k++) {
-        const GridX col_start{dbuToGridCeil(rect.xl, site_width)};
-        const GridX col_end{dbuToGridFloor(rect.xh, site_width)};
+        row_spans[k.v].push_back(span);
+      }
+    }
 
-        for (GridX l{col_start}; l < col_end; l++) {
-          Pixel* pixel = grid_->gridPixel(grid_index, l, k);
-          pixel->util += 1.0;
+    for (const auto& [k, spans] : row_spans) {
+      PixelRow* row = grid_->gridRow(grid_index, GridY{k});
+      if (row == nullptr) {
+        continue;
+      }
+      // The utilization is constant between these breakpoints.
+      vector<int> breaks;
+      for (const RegionSpan& span : spans) {
+        breaks.insert(breaks.end(),
+                      {span.col_start,
+                       span.col_start + 1,
+                       span.col_end - 1,
+                       span.col_end});
+      }
+      std::sort(breaks.begin(), breaks.end());
+      breaks.erase(std::unique(breaks.begin(), breaks.end()), breaks.end());
+
+      for (size_t i = 0; i + 1 < breaks.size(); i++) {
+        const int x_begin = std::max(0, breaks[i]);
+        const int x_end = std::min(grid_info.getSiteCount().v, breaks[i + 1]);
+        if (x_begin >= x_end) {
+          continue;
         }
-        if (rect.xl % site_width != 0) {
-          Pixel* pixel = grid_->gridPixel(grid_index, col_start, k);
-          pixel->util
-              -= (rect.xl % site_width).v / static_cast<double>(site_width.v);
+        double util = 0.0;
+        bool in_region = false;
+        for (const RegionSpan& span : spans) {
+          if (x_begin >= span.col_start && x_begin < span.col_end) {
+            util += 1.0;
+            in_region = true;
+          }
+          if (x_begin == span.col_start) {
+            util -= span.start_adjust;
+          }
+          if (x_begin == span.col_end - 1) {
+            util -= span.end_adjust;
+          }
         }
-        if (rect.xh % site_width != 0) {
-          Pixel* pixel = grid_->gridPixel(grid_index, col_end - 1, k);
-          pixel->util -= ((site_width - rect.xh) % site_width).v
-                         / static_cast<double>(site_width.v);
+        if (!in_region) {
+          continue;
         }
-      }
-    }
-    for (const DbuRect rect : group.region_boundaries) {
-      const GridY row_start{dbuToGridCeil(rect.yl, row_height)};
-      const GridY row_end{dbuToGridFloor(rect.yh, row_height)};
-
-      for (GridY k{row_start}; k < row_end; k++) {
-        const GridX col_start = dbuToGridCeil(rect.xl, site_width);
-        const GridX col_end = dbuToGridFloor(rect.xh, site_width);
-
         // Assign group to each pixel.
-        for (GridX l{col_start}; l < col_end; l++) {
-          Pixel* pixel = grid_->gridPixel(grid_index, l, k);
-          if (pixel->util == 1.0) {
-            pixel->group = &group;
-            pixel->is_valid = true;
-            pixel->util = 1.0;
-          } else if (pixel->util > 0.0 && pixel->util < 1.0) {
-            pixel->cell = dummy_cell_.get();
-            pixel->util = 0.0;
-            pixel->is_valid = false;
-          }
+        if (util == 1.0) {
+          row->group.set(x_begin, x_end, &group);
+          row->is_valid.set(x_begin, x_end, true);
+        } else if (util > 0.0 && util < 1.0) {
+          row->cell.set(x_begin, x_end, dummy_cell_.get());
+          row->is_valid.set(x_begin, x_end, false);
         }
       }
     }
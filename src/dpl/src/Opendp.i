@@ -98,9 +98,12 @@ void
 detailed_placement_cmd(int max_displacment_x,
                        int max_displacment_y,
                        bool disallow_one_site_gaps,
-                       const char* report_file_name){
-  dpl::Opendp *opendp = ord::OpenRoad::openRoad()->getOpendp();
-  opendp->detailedPlacement(max_displacment_x, max_displacment_y, std::string(report_file_name), disallow_one_site_gaps);
+                       const char* report_file_name,
+                       bool parallel){
+  ord::OpenRoad *openroad = ord::OpenRoad::openRoad();
+  dpl::Opendp *opendp = openroad->getOpendp();
+  const int num_threads = parallel ? openroad->getThreadCount() : 1;
+  opendp->detailedPlacement(max_displacment_x, max_displacment_y, std::string(report_file_name), disallow_one_site_gaps, num_threads);
 }
 
 void
@@ -111,10 +114,10 @@ report_legalization_stats()
 }
 
 void
-check_placement_cmd(bool verbose, bool disallow_one_site_gaps, const char* report_file_name)
+check_placement_cmd(bool verbose, bool disallow_one_site_gaps, const char* report_file_name, bool incremental)
 {
   dpl::Opendp *opendp = ord::OpenRoad::openRoad()->getOpendp();
-  opendp->checkPlacement(verbose, disallow_one_site_gaps, std::string(report_file_name));
+  opendp->checkPlacement(verbose, disallow_one_site_gaps, std::string(report_file_name), incremental);
 }
 
 
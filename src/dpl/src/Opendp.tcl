@@ -35,13 +35,16 @@
 sta::define_cmd_args "detailed_placement" { \
                            [-max_displacement disp|{disp_x disp_y}] \
                            [-disallow_one_site_gaps] \
+                           [-parallel] \
                            [-report_file_name file_name]}
 
 proc detailed_placement { args } {
   sta::parse_key_args "detailed_placement" args \
-    keys {-max_displacement -report_file_name} flags {-disallow_one_site_gaps}
+    keys {-max_displacement -report_file_name} \
+    flags {-disallow_one_site_gaps -parallel}
 
   set disallow_one_site_gaps [info exists flags(-disallow_one_site_gaps)]
+  set parallel [info exists flags(-parallel)]
   if { [info exists keys(-max_displacement)] } {
     set max_displacement $keys(-max_displacement)
     if { [llength $max_displacement] == 1 } {
@@ -74,7 +77,7 @@ proc detailed_placement { args } {
     set max_displacement_y [expr [ord::microns_to_dbu $max_displacement_y] \
                               / [$site getHeight]]
     dpl::detailed_placement_cmd $max_displacement_x $max_displacement_y \
-      $disallow_one_site_gaps $file_name
+      $disallow_one_site_gaps $file_name $parallel
     dpl::report_legalization_stats
   } else {
     utl::error "DPL" 27 "no rows defined in design. Use initialize_floorplan to add rows."
@@ -149,6 +152,7 @@ proc remove_fillers { args } {
 
 sta::define_cmd_args "check_placement" {[-verbose] \
                                         [-disallow_one_site_gaps] \
+                                        [-incremental] \
                                         [-report_file_name file_name]}
 
 proc check_placement { args } {
@@ -158,15 +162,18 @@ proc check_placement { args } {
   }
 
   sta::parse_key_args "check_placement" args \
-    keys {-report_file_name} flags {-verbose -disallow_one_site_gaps}
+    keys {-report_file_name} \
+    flags {-verbose -disallow_one_site_gaps -incremental}
   set verbose [info exists flags(-verbose)]
   set disallow_one_site_gaps [info exists flags(-disallow_one_site_gaps)]
+  set incremental [info exists flags(-incremental)]
   sta::check_argc_eq0 "check_placement" $args
   set file_name ""
   if { [info exists keys(-report_file_name) ] } {
     set file_name $keys(-report_file_name)
   }
-  dpl::check_placement_cmd $verbose $disallow_one_site_gaps $file_name
+  dpl::check_placement_cmd $verbose $disallow_one_site_gaps $file_name \
+    $incremental
 }
 
 sta::define_cmd_args "optimize_mirroring" {}
@@ -49,6 +49,7 @@
 #include "Padding.h"
 #include "dpl/Opendp.h"
 #include "utl/Logger.h"
+#include "utl/exception.h"
 
 // #define ODP_DEBUG
 
@@ -343,8 +344,13 @@ void Opendp::place()
       }
     }
   }
+  // The observer is not thread safe and hybrid rows do not map between
+  // grids by height, so both stay on the serial path.
+  if (num_threads_ > 1 && !debug_observer_ && !grid_->hasHybridRows()) {
+    placeRowBands(sorted_cells);
+  }
   for (Cell* cell : sorted_cells) {
-    if (!isMultiRow(cell)) {
+    if (!isMultiRow(cell) && !cell->is_placed_) {
       if (!mapMove(cell)) {
         shiftMove(cell);
       }
@@ -352,6 +358,88 @@ void Opendp::place()
   }
 }
 
+// Legalize single-row cells in horizontal bands of the core. Bands with the
+// same parity are a whole band apart, so they share no rows on any grid and
+// can be searched and painted concurrently. Each band places its cells in
+// sorted order, so the result does not depend on the thread count. Cells
+// within the halo of a band edge, and cells with no site inside their band,
+// are left for the serial mapMove/shiftMove pass in place().
+void Opendp::placeRowBands(const vector<Cell*>& sorted_cells)
+{
+  DbuY max_row_height{0};
+  for (const auto& [grid_key, grid_info] : grid_->getInfoMap()) {
+    max_row_height = max(max_row_height, grid_info.getSitesTotalHeight());
+  }
+  const int band_height = band_row_count_ * max_row_height.v;
+  const int band_halo = band_halo_row_count_ * max_row_height.v;
+  const int band_count = divCeil(grid_->getCore().dy(), band_height);
+  if (band_count < 2) {
+    return;
+  }
+
+  struct BandCell
+  {
+    Cell* cell;
+    GridPt grid_pt;
+  };
+  vector<vector<BandCell>> bands(band_count);
+  int band_cell_count = 0;
+  for (Cell* cell : sorted_cells) {
+    if (isMultiRow(cell)) {
+      continue;
+    }
+    const GridPt grid_pt = legalGridPt(cell, true);
+    const DbuY row_height = grid_->getRowHeight(cell);
+    const int y_begin = gridToDbu(grid_pt.y, row_height).v;
+    const int y_end
+        = y_begin + gridToDbu(grid_->gridHeight(cell), row_height).v;
+    const int band = min(max(0, y_begin / band_height), band_count - 1);
+    if (y_begin >= band * band_height + band_halo
+        && y_end <= (band + 1) * band_height - band_halo) {
+      bands[band].push_back({cell, grid_pt});
+      band_cell_count++;
+    }
+  }
+  debugPrint(logger_,
+             DPL,
+             "place",
+             1,
+             "Placing {} cells in {} row bands of {} dbu",
+             band_cell_count,
+             band_count,
+             band_height);
+
+  auto place_band = [&](const int band) {
+    const int band_begin = band * band_height;
+    const int band_end = band_begin + band_height;
+    for (const BandCell& band_cell : bands[band]) {
+      Cell* cell = band_cell.cell;
+      const int row_height = grid_->getRowHeight(cell).v;
+      const GridY y_lo{divCeil(band_begin, row_height)};
+      const GridY y_hi{band_end / row_height - grid_->gridHeight(cell).v};
+      const PixelPt pixel_pt = diamondSearch(
+          cell, band_cell.grid_pt.x, band_cell.grid_pt.y, y_lo, y_hi);
+      if (pixel_pt.found) {
+        grid_->paintPixel(cell, pixel_pt.x, pixel_pt.y);
+      }
+    }
+  };
+
+  const int thread_count = min(num_threads_, (band_count + 1) / 2);
+  for (int parity = 0; parity < 2; parity++) {
+    utl::ThreadException exception;
+#pragma omp parallel for num_threads(thread_count) schedule(dynamic)
+    for (int band = parity; band < band_count; band += 2) {
+      try {
+        place_band(band);
+      } catch (...) {
+        exception.capture();
+      }
+    }
+    exception.rethrow();
+  }
+}
+
 void Opendp::placeGroups2()
 {
   for (Group& group : groups_) {
@@ -587,8 +675,8 @@ bool Opendp::mapMove(Cell* cell, const GridPt& grid_pt)
              cell->y_,
              pixel_pt.x,
              pixel_pt.y,
-             pixel_pt.pixel->site->getName());
-  if (pixel_pt.pixel) {
+             pixel_pt.found ? pixel_pt.site->getName() : "none");
+  if (pixel_pt.found) {
     grid_->paintPixel(cell, pixel_pt.x, pixel_pt.y);
     if (debug_observer_) {
       debug_observer_->placeInstance(cell->db_inst_);
@@ -611,12 +699,9 @@ void Opendp::shiftMove(Cell* cell)
   for (GridX x = grid_pt.x - margin_width; x < grid_pt.x + margin_width; x++) {
     for (GridY y = grid_pt.y - boundary_margin; y < grid_pt.y + boundary_margin;
          y++) {
-      Pixel* pixel = grid_->gridPixel(grid_index, x, y);
-      if (pixel) {
-        Cell* cell = pixel->cell;
-        if (cell && !cell->isFixed()) {
-          region_cells.insert(cell);
-        }
+      Cell* cell = grid_->gridCell(grid_index, x, y);
+      if (cell && !cell->isFixed()) {
+        region_cells.insert(cell);
       }
     }
   }
@@ -670,7 +755,7 @@ bool Opendp::refineMove(Cell* cell)
   const GridPt grid_pt = legalGridPt(cell, true);
   const PixelPt pixel_pt = diamondSearch(cell, grid_pt.x, grid_pt.y);
 
-  if (pixel_pt.pixel) {
+  if (pixel_pt.found) {
     const GridY scaled_max_displacement_y_
         = grid_->map_ycoordinates(GridY{max_displacement_y_},
                                   grid_->getSmallestNonHybridGridKey(),
@@ -709,6 +794,16 @@ int Opendp::distChange(const Cell* cell, const DbuX x, const DbuY y) const
 PixelPt Opendp::diamondSearch(const Cell* cell,
                               const GridX x,
                               const GridY y) const
+{
+  return diamondSearch(
+      cell, x, y, GridY{0}, GridY{numeric_limits<int>::max()});
+}
+
+PixelPt Opendp::diamondSearch(const Cell* cell,
+                              const GridX x,
+                              const GridY y,
+                              const GridY y_lo,
+                              const GridY y_hi) const
 {
   // Diamond search limits.
   GridX x_min = x - max_displacement_x_;
@@ -750,6 +845,8 @@ PixelPt Opendp::diamondSearch(const Cell* cell,
   y_min = max(GridY{0}, y_min);
   x_max = min(grid_info.getSiteCount(), x_max);
   y_max = min(grid_info.getRowCount(), y_max);
+  y_min = max(y_lo, y_min);
+  y_max = min(y_hi, y_max);
   debugPrint(logger_,
              DPL,
              "place",
@@ -765,7 +862,7 @@ PixelPt Opendp::diamondSearch(const Cell* cell,
 
   // Check the bin at the initial position first.
   const PixelPt avail_pt = binSearch(x, cell, x, y);
-  if (avail_pt.pixel) {
+  if (avail_pt.found) {
     return avail_pt;
   }
 
@@ -818,7 +915,7 @@ PixelPt Opendp::diamondSearch(const Cell* cell,
                           best_dist);
       }
     }
-    if (best_pt.pixel) {
+    if (best_pt.found) {
       return best_pt;
     }
   }
@@ -841,7 +938,7 @@ void Opendp::diamondSearchSide(const Cell* cell,
   const GridX bin_x = min(x_max, max(x_min, x + x_offset * bin_search_width_));
   const GridY bin_y = min(y_max, max(y_min, y + y_offset));
   PixelPt avail_pt = binSearch(x, cell, bin_x, bin_y);
-  if (avail_pt.pixel) {
+  if (avail_pt.found) {
     DbuY y_dist{0};
     if (cell->isHybrid() && !cell->isHybridParent()) {
       const auto gmk = grid_->getGridMapKey(cell);
@@ -853,7 +950,7 @@ void Opendp::diamondSearchSide(const Cell* cell,
     }
     const int avail_dist
         = sumXY(gridToDbu(abs(x - avail_pt.x), grid_->getSiteWidth()), y_dist);
-    if (best_pt.pixel == nullptr || avail_dist < best_dist) {
+    if (!best_pt.found || avail_dist < best_dist) {
       best_pt = avail_pt;
       best_dist = avail_dist;
     }
@@ -903,9 +1000,9 @@ PixelPt Opendp::binSearch(GridX x,
       // the else case where a cell has no region will be checked using the
       // rtree in checkPixels
       if (checkPixels(cell, bin_x + i, bin_y, x_end + i, y_end)) {
-        Pixel* valid_grid_pixel
-            = grid_->gridPixel(grid_info.getGridIndex(), bin_x + i, bin_y);
-        return PixelPt(valid_grid_pixel, bin_x + i, bin_y);
+        return PixelPt(grid_->gridSite(grid_info.getGridIndex(), bin_y),
+                       bin_x + i,
+                       bin_y);
       }
     }
   } else {
@@ -918,9 +1015,9 @@ PixelPt Opendp::binSearch(GridX x,
         }
       }
       if (checkPixels(cell, bin_x + i, bin_y, x_end + i, y_end)) {
-        Pixel* valid_grid_pixel
-            = grid_->gridPixel(grid_info.getGridIndex(), bin_x + i, bin_y);
-        return PixelPt(valid_grid_pixel, bin_x + i, bin_y);
+        return PixelPt(grid_->gridSite(grid_info.getGridIndex(), bin_y),
+                       bin_x + i,
+                       bin_y);
       }
     }
   }
@@ -998,17 +1095,16 @@ bool Opendp::checkPixels(const Cell* cell,
   const auto cell_site = cell->getSite();
   const int layer = row_info.second.getGridIndex();
   for (GridY y1 = y; y1 < y_end; y1++) {
-    for (GridX x1 = x; x1 < x_end; x1++) {
-      const Pixel* pixel = grid_->gridPixel(layer, x1, y1);
-      if (pixel == nullptr || pixel->cell || !pixel->is_valid
-          || (cell->inGroup() && pixel->group != cell->group_)
-          || (!cell->inGroup() && pixel->group)
-          || (pixel->site != nullptr && pixel->site != cell_site)) {
-        return false;
-      }
-      if (pixel->site == nullptr) {
-        logger_->error(DPL, 1599, "Pixel site is null");
-      }
+    const PixelRow* row = grid_->gridRow(layer, y1);
+    // Every site must be empty, valid and in the cell's group (or none).
+    if (row == nullptr || x < 0 || row->cell.any(x.v, x_end.v)
+        || !row->is_valid.all(x.v, x_end.v, true)
+        || !row->group.all(x.v, x_end.v, cell->group_)
+        || (row->site != nullptr && row->site != cell_site)) {
+      return false;
+    }
+    if (row->site == nullptr) {
+      logger_->error(DPL, 1599, "Pixel site is null");
     }
     if (disallow_one_site_gaps_) {
       // here we need to check for abutting first, if there is an abutting cell
@@ -1022,13 +1118,11 @@ bool Opendp::checkPixels(const Cell* cell,
       const GridY y_finish = min(y_end, row_info.second.getRowCount() - 1);
 
       auto isAbutted = [this](const int layer, const GridX x, const GridY y) {
-        const Pixel* pixel = grid_->gridPixel(layer, x, y);
-        return (pixel == nullptr || pixel->cell);
+        return (!grid_->inGrid(layer, x, y) || grid_->gridCell(layer, x, y));
       };
 
       auto cellAtSite = [this](const int layer, const GridX x, const GridY y) {
-        const Pixel* pixel = grid_->gridPixel(layer, x, y);
-        return (pixel != nullptr && pixel->cell);
+        return grid_->gridCell(layer, x, y) != nullptr;
       };
       // upper left corner
       if (!isAbutted(layer, x_begin, y_begin)
@@ -1185,27 +1279,36 @@ bool Opendp::moveHopeless(const Cell* cell, GridX& grid_x, GridY& grid_y) const
   // since the site doesn't have to be empty, we don't need to check all
   // layers. They will be checked in the checkPixels in the diamondSearch
   // method after this initialization
-  for (GridX x = grid_x - 1; x >= 0; --x) {  // left
-    if (grid_->pixel(grid_index, grid_y, x).is_valid) {
-      best_dist = gridToDbu(grid_x - x - 1, site_width).v;
-      best_x = x;
+  const PixelRow* row = grid_->gridRow(grid_index, grid_y);
+  if (row != nullptr) {
+    // The nearest valid sites are at the ends of the valid runs around grid_x.
+    GridX left{-1};
+    GridX right{-1};
+    row->is_valid.visit(
+        0, grid_x.v, [&](int, int end, bool) { left = GridX{end - 1}; });
+    row->is_valid.visit(
+        grid_x.v + 1, layer_site_count.v, [&](int begin, int, bool) {
+          if (right < 0) {
+            right = GridX{begin};
+          }
+        });
+    if (left >= 0) {
+      best_dist = gridToDbu(grid_x - left - 1, site_width).v;
+      best_x = left;
       best_y = grid_y;
-      break;
     }
-  }
-  for (GridX x = grid_x + 1; x < layer_site_count; ++x) {  // right
-    if (grid_->pixel(grid_index, grid_y, x).is_valid) {
-      const int dist = gridToDbu(x - grid_x, site_width).v - cell->width_.v;
+    if (right >= 0) {
+      const int dist
+          = gridToDbu(right - grid_x, site_width).v - cell->width_.v;
       if (dist < best_dist) {
         best_dist = dist;
-        best_x = x;
+        best_x = right;
         best_y = grid_y;
       }
-      break;
     }
   }
   for (GridY y = grid_y - 1; y >= 0; --y) {  // below
-    if (grid_->pixel(grid_index, y, grid_x).is_valid) {
+    if (grid_->isValid(grid_index, grid_x, y)) {
       // FIXME(mina1460): this is wrong for hybrid sites
       const int dist = gridToDbu(grid_y - y - 1, row_height).v;
       if (dist < best_dist) {
@@ -1217,7 +1320,7 @@ bool Opendp::moveHopeless(const Cell* cell, GridX& grid_x, GridY& grid_y) const
     }
   }
   for (GridY y = grid_y + 1; y < layer_row_count; ++y) {  // above
-    if (grid_->pixel(grid_index, y, grid_x).is_valid) {
+    if (grid_->isValid(grid_index, grid_x, y)) {
       const int dist = gridToDbu(y - grid_y, row_height).v - cell->height_.v;
       if (dist < best_dist) {
         best_dist = dist;
@@ -1259,31 +1362,31 @@ DbuPt Opendp::pointOffMacro(const Cell& cell)
   const DbuPt init = initialLocation(&cell, false);
 
   const auto grid_info = grid_->getGridInfo(&cell);
-  Pixel* pixel1 = grid_->gridPixel(grid_info.getGridIndex(),
-                                   grid_->gridX(init.x),
-                                   grid_->gridY(init.y, &cell));
-  Pixel* pixel2 = grid_->gridPixel(grid_info.getGridIndex(),
-                                   grid_->gridX(init.x + cell.width_),
-                                   grid_->gridY(init.y, &cell));
-  Pixel* pixel3 = grid_->gridPixel(grid_info.getGridIndex(),
-                                   grid_->gridX(init.x),
-                                   grid_->gridY(init.y + cell.height_, &cell));
-  Pixel* pixel4 = grid_->gridPixel(grid_info.getGridIndex(),
-                                   grid_->gridX(init.x + cell.width_),
-                                   grid_->gridY(init.y + cell.height_, &cell));
+  Cell* cell1 = grid_->gridCell(grid_info.getGridIndex(),
+                                grid_->gridX(init.x),
+                                grid_->gridY(init.y, &cell));
+  Cell* cell2 = grid_->gridCell(grid_info.getGridIndex(),
+                                grid_->gridX(init.x + cell.width_),
+                                grid_->gridY(init.y, &cell));
+  Cell* cell3 = grid_->gridCell(grid_info.getGridIndex(),
+                                grid_->gridX(init.x),
+                                grid_->gridY(init.y + cell.height_, &cell));
+  Cell* cell4 = grid_->gridCell(grid_info.getGridIndex(),
+                                grid_->gridX(init.x + cell.width_),
+                                grid_->gridY(init.y + cell.height_, &cell));
 
   Cell* block = nullptr;
-  if (pixel1 && pixel1->cell && pixel1->cell->isBlock()) {
-    block = pixel1->cell;
+  if (cell1 && cell1->isBlock()) {
+    block = cell1;
   }
-  if (pixel2 && pixel2->cell && pixel2->cell->isBlock()) {
-    block = pixel2->cell;
+  if (cell2 && cell2->isBlock()) {
+    block = cell2;
   }
-  if (pixel3 && pixel3->cell && pixel3->cell->isBlock()) {
-    block = pixel3->cell;
+  if (cell3 && cell3->isBlock()) {
+    block = cell3;
   }
-  if (pixel4 && pixel4->cell && pixel4->cell->isBlock()) {
-    block = pixel4->cell;
+  if (cell4 && cell4->isBlock()) {
+    block = cell4;
   }
 
   if (block && block->isBlock()) {
@@ -1353,16 +1456,16 @@ DbuPt Opendp::legalPt(const Cell* cell, const bool padded) const
   GridX grid_x = grid_->gridX(legal_pt.x);
   const DbuY y = legal_pt.y + grid_info.getOffset();
   auto [grid_y, height] = grid_->gridY(y, grid_info);
-  Pixel* pixel = grid_->gridPixel(grid_info.getGridIndex(), grid_x, grid_y);
-  if (pixel) {
+  if (grid_->inGrid(grid_info.getGridIndex(), grid_x, grid_y)) {
     // Move std cells off of macros.  First try the is_hopeless strategy
-    if (pixel->is_hopeless && moveHopeless(cell, grid_x, grid_y)) {
+    if (grid_->isHopeless(grid_info.getGridIndex(), grid_x, grid_y)
+        && moveHopeless(cell, grid_x, grid_y)) {
       legal_pt = DbuPt(gridToDbu(grid_x, grid_->getSiteWidth()),
                        gridToDbu(grid_y, row_height));
-      pixel = grid_->gridPixel(grid_info.getGridIndex(), grid_x, grid_y);
     }
 
-    const Cell* block = pixel->cell;
+    const Cell* block
+        = grid_->gridCell(grid_info.getGridIndex(), grid_x, grid_y);
 
     // If that didn't do the job fall back on the old move to nearest
     // edge strategy.  This doesn't consider site availability at the
@@ -0,0 +1,150 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2024, Precision Innovations Inc.
+// All rights reserved.
+//
+// BSD 3-Clause License
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <bitset>
+#include <boost/geometry.hpp>
+#include <boost/geometry/index/rtree.hpp>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "odb/db.h"
+#include "odb/dbBlockCallBackObj.h"
+
+namespace dpl {
+
+struct Cell;
+
+// check_placement failure kinds.
+enum CheckFailure
+{
+  kPlacedFailure,
+  kInRowsFailure,
+  kOverlapFailure,
+  kSiteAlignFailure,
+  kOneSiteGapFailure,
+  kRegionFailure,
+  kCheckFailureCount
+};
+
+using CheckFailures = std::bitset<kCheckFailureCount>;
+
+// State kept between incremental check_placement calls.  The first check
+// records the box and failures of every cell and keeps the painted pixel
+// grid; odb callbacks then collect the instances that move, flip, change
+// master or placement status so the next check only repaints and revisits
+// the pixels around those instances.  Changes to the instance set, rows,
+// regions or blockages invalidate the cache.
+class PlacementCheckCache : public odb::dbBlockCallBackObj
+{
+ public:
+  using bgPoint
+      = boost::geometry::model::d2::point_xy<int,
+                                             boost::geometry::cs::cartesian>;
+  using bgBox = boost::geometry::model::box<bgPoint>;
+  using CellBox = std::pair<bgBox, Cell*>;
+  using RtreeCell
+      = boost::geometry::index::rtree<CellBox,
+                                      boost::geometry::index::quadratic<16>>;
+
+  PlacementCheckCache(odb::dbBlock* block, int cell_count, int generation)
+      : block_(block),
+        generation_(generation),
+        boxes_(cell_count),
+        failures_(cell_count)
+  {
+    addOwner(block);
+  }
+
+  // A destroyed block drops its callbacks, so a new block at the same
+  // address is not mistaken for the cached one.
+  bool isValid(const odb::dbBlock* block, int generation) const
+  {
+    return valid_ && hasOwner() && block == block_
+           && generation == generation_;
+  }
+
+  // dbBlockCallBackObj
+  void inDbInstCreate(odb::dbInst*) override { valid_ = false; }
+  void inDbInstCreate(odb::dbInst*, odb::dbRegion*) override
+  {
+    valid_ = false;
+  }
+  void inDbInstDestroy(odb::dbInst*) override { valid_ = false; }
+  void inDbInstPlacementStatusBefore(odb::dbInst* inst,
+                                     const odb::dbPlacementStatus&) override
+  {
+    dirty_insts_.insert(inst);
+  }
+  void inDbInstSwapMasterAfter(odb::dbInst* inst) override
+  {
+    dirty_insts_.insert(inst);
+  }
+  void inDbPostMoveInst(odb::dbInst* inst) override
+  {
+    dirty_insts_.insert(inst);
+  }
+  void inDbBlockageCreate(odb::dbBlockage*) override { valid_ = false; }
+  void inDbObstructionCreate(odb::dbObstruction*) override { valid_ = false; }
+  void inDbObstructionDestroy(odb::dbObstruction*) override
+  {
+    valid_ = false;
+  }
+  void inDbRegionCreate(odb::dbRegion*) override { valid_ = false; }
+  void inDbRegionAddBox(odb::dbRegion*, odb::dbBox*) override
+  {
+    valid_ = false;
+  }
+  void inDbRegionDestroy(odb::dbRegion*) override { valid_ = false; }
+  void inDbRowCreate(odb::dbRow*) override { valid_ = false; }
+  void inDbRowDestroy(odb::dbRow*) override { valid_ = false; }
+  void inDbBlockSetDieArea(odb::dbBlock*) override { valid_ = false; }
+
+ private:
+  odb::dbBlock* block_;
+  // Opendp::check_generation_ of the cells_ and grid the cache refers to
+  int generation_;
+  bool valid_ = true;
+  std::set<odb::dbInst*> dirty_insts_;
+  // Padded cell boxes in core coordinates.
+  RtreeCell cells_;
+  // By index in Opendp::cells_.
+  std::vector<bgBox> boxes_;
+  std::vector<CheckFailures> failures_;
+
+  friend class Opendp;
+};
+
+}  // namespace dpl
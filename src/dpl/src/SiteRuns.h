@@ -0,0 +1,216 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2024, Precision Innovations Inc.
+// All rights reserved.
+//
+// BSD 3-Clause License
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace dpl {
+
+// Run length encoded values along one grid row.  Sites that are not
+// covered by a run have the default value T(), so memory is proportional
+// to the number of runs (placed cells, row fragments, blockages) rather
+// than to the number of sites.  Adjacent runs with equal values are
+// merged.  Ranges are half open [begin, end) in sites.  The runs are kept
+// in a sorted vector as lookups dominate and rows hold few runs.
+template <typename T>
+class SiteRuns
+{
+ public:
+  T get(int x) const
+  {
+    auto it = after(x);
+    if (it == runs_.begin()) {
+      return T();
+    }
+    --it;
+    return x < it->end ? it->value : T();
+  }
+
+  void set(int begin, int end, const T& value)
+  {
+    if (begin >= end) {
+      return;
+    }
+    auto it = erase(begin, end);
+    if (value == T()) {
+      return;
+    }
+    const bool merge_prev = it != runs_.begin() && std::prev(it)->end == begin
+                            && std::prev(it)->value == value;
+    const bool merge_next
+        = it != runs_.end() && it->begin == end && it->value == value;
+    if (merge_prev && merge_next) {
+      std::prev(it)->end = it->end;
+      runs_.erase(it);
+    } else if (merge_prev) {
+      std::prev(it)->end = end;
+    } else if (merge_next) {
+      it->begin = begin;
+    } else {
+      runs_.insert(it, Run{begin, end, value});
+    }
+  }
+
+  // Set value on the sites in [begin, end) that have the default value.
+  void fill(int begin, int end, const T& value)
+  {
+    int gap_begin = begin;
+    std::vector<std::pair<int, int>> gaps;
+    visit(begin, end, [&](int run_begin, int run_end, const T&) {
+      if (gap_begin < run_begin) {
+        gaps.emplace_back(gap_begin, run_begin);
+      }
+      gap_begin = run_end;
+    });
+    if (gap_begin < end) {
+      gaps.emplace_back(gap_begin, end);
+    }
+    for (const auto& [x_begin, x_end] : gaps) {
+      set(x_begin, x_end, value);
+    }
+  }
+
+  // Call func(run_begin, run_end, value) for each non-default run
+  // overlapping [begin, end), clipped to the range, in increasing x.
+  template <typename Func>
+  void visit(int begin, int end, Func func) const
+  {
+    if (begin >= end) {
+      return;
+    }
+    auto it = after(begin);
+    if (it != runs_.begin() && std::prev(it)->end > begin) {
+      --it;
+    }
+    for (; it != runs_.end() && it->begin < end; ++it) {
+      func(std::max(it->begin, begin), std::min(it->end, end), it->value);
+    }
+  }
+
+  // End of the span of sites with the same value as x, capped at limit.
+  int spanEnd(int x, int limit) const
+  {
+    auto it = after(x);
+    if (it != runs_.begin() && x < std::prev(it)->end) {
+      return std::min(std::prev(it)->end, limit);
+    }
+    return it == runs_.end() ? limit : std::min(it->begin, limit);
+  }
+
+  // True if any site in [begin, end) has a non-default value.
+  bool any(int begin, int end) const
+  {
+    bool found = false;
+    visit(begin, end, [&](int, int, const T&) { found = true; });
+    return found;
+  }
+
+  // True if every site in [begin, end) has value.
+  bool all(int begin, int end, const T& value) const
+  {
+    if (value == T()) {
+      return !any(begin, end);
+    }
+    int covered = begin;
+    bool equal = true;
+    visit(begin, end, [&](int run_begin, int run_end, const T& run_value) {
+      equal = equal && run_begin == covered && run_value == value;
+      covered = run_end;
+    });
+    return equal && covered >= end;
+  }
+
+  void clear() { runs_.clear(); }
+  size_t runCount() const { return runs_.size(); }
+
+ private:
+  struct Run
+  {
+    int begin;
+    int end;
+    T value;
+  };
+  using Iterator = typename std::vector<Run>::iterator;
+  using ConstIterator = typename std::vector<Run>::const_iterator;
+
+  // First run starting after x.
+  ConstIterator after(int x) const
+  {
+    return std::upper_bound(
+        runs_.begin(), runs_.end(), x, [](int pos, const Run& run) {
+          return pos < run.begin;
+        });
+  }
+
+  // Remove [begin, end) from the runs, splitting the ones that straddle
+  // either end.  Returns the position of the first run after the range.
+  Iterator erase(int begin, int end)
+  {
+    auto first = runs_.begin() + (after(begin) - runs_.cbegin());
+    if (first != runs_.begin() && std::prev(first)->end > begin) {
+      --first;
+    }
+    auto last = first;
+    while (last != runs_.end() && last->begin < end) {
+      ++last;
+    }
+    if (first == last) {
+      return first;
+    }
+    const Run head = *first;
+    const Run tail = *std::prev(last);
+    // reuse the slots of the removed runs for the pieces that remain
+    if (head.begin < begin) {
+      first->end = begin;
+      ++first;
+    }
+    if (tail.end > end) {
+      if (first == last) {
+        first = runs_.insert(last, Run{end, tail.end, tail.value});
+        return first;
+      }
+      *first = Run{end, tail.end, tail.value};
+      return runs_.erase(first + 1, last) - 1;
+    }
+    return runs_.erase(first, last);
+  }
+
+  // sorted by begin, disjoint
+  std::vector<Run> runs_;
+};
+
+}  // namespace dpl
@@ -40,6 +40,7 @@
 
 #include "Grid.h"
 #include "Objects.h"
+#include "PlacementCheckCache.h"
 #include "dpl/Opendp.h"
 #include "utl/Logger.h"
 
@@ -77,6 +78,8 @@ void Opendp::importClear()
   cells_.clear();
   groups_.clear();
   db_inst_map_.clear();
+  // The cache points into cells_.
+  check_cache_.reset();
   deleteGrid();
   have_multi_row_cells_ = false;
 }
@@ -0,0 +1,49 @@
+# check_placement -incremental reports the same failures as a full check
+source "helpers.tcl"
+read_lef Nangate45/Nangate45.lef
+read_def aes_cipher_top_replace.def
+detailed_placement
+
+set block [ord::get_db_block]
+set insts [$block getInsts]
+set site_width [[lindex [$block getRows] 0] getSpacing]
+
+# The full check rebuilds the cache, so each step starts with an
+# incremental check that fills it.
+proc compare_checks { name } {
+  set incremental_file [make_result_file ${name}_incremental.json]
+  set full_file [make_result_file ${name}_full.json]
+  catch { check_placement -verbose -incremental \
+            -report_file_name $incremental_file }
+  catch { check_placement -verbose -report_file_name $full_file }
+  check "$name incremental report" { diff_files $full_file $incremental_file } 0
+}
+
+proc move_inst { inst dx dy } {
+  set bbox [$inst getBBox]
+  $inst setLocation [expr [$bbox xMin] + $dx] [expr [$bbox yMin] + $dy]
+}
+
+# overlap neighbors
+check_placement -incremental
+for { set i 100 } { $i < 2000 } { incr i 100 } {
+  move_inst [lindex $insts $i] [expr 2 * $site_width] 0
+}
+compare_checks moves
+
+# flip, leave a site and unplace
+catch { check_placement -incremental }
+[lindex $insts 150] setOrient MX
+move_inst [lindex $insts 250] 1 0
+[lindex $insts 350] setPlacementStatus NONE
+compare_checks edits
+
+# stack instances on the first one
+catch { check_placement -incremental }
+set target [[lindex $insts 0] getBBox]
+foreach i { 500 600 700 } {
+  [lindex $insts $i] setLocation [$target xMin] [$target yMin]
+}
+compare_checks stack
+
+exit_summary
@@ -1,7 +1,10 @@
 #include <unistd.h>
 
 #include <memory>
+#include <random>
+#include <vector>
 
+#include "SiteRuns.h"
 #include "dpl/Opendp.h"
 #include "gtest/gtest.h"
 #include "odb/db.h"
@@ -43,4 +46,78 @@ class OpendpTest : public ::testing::Test
   OdbUniquePtr<odb::dbBlock> block_{nullptr, &odb::dbBlock::destroy};
 };
 
+TEST(SiteRunsTest, SetSplitsAndMerges)
+{
+  SiteRuns<int> runs;
+  runs.set(0, 10, 1);
+  runs.set(3, 5, 2);
+  EXPECT_EQ(runs.get(2), 1);
+  EXPECT_EQ(runs.get(3), 2);
+  EXPECT_EQ(runs.get(5), 1);
+  EXPECT_EQ(runs.get(10), 0);
+  EXPECT_EQ(runs.runCount(), 3);
+
+  runs.set(3, 5, 1);
+  EXPECT_EQ(runs.runCount(), 1);
+  runs.set(0, 10, 0);
+  EXPECT_EQ(runs.runCount(), 0);
+}
+
+TEST(SiteRunsTest, RangeQueries)
+{
+  SiteRuns<int> runs;
+  runs.set(2, 4, 1);
+  runs.set(6, 8, 1);
+  EXPECT_FALSE(runs.any(0, 2));
+  EXPECT_TRUE(runs.any(3, 7));
+  EXPECT_TRUE(runs.all(2, 4, 1));
+  EXPECT_FALSE(runs.all(2, 7, 1));
+  EXPECT_TRUE(runs.all(4, 6, 0));
+  EXPECT_EQ(runs.spanEnd(0, 100), 2);
+  EXPECT_EQ(runs.spanEnd(2, 100), 4);
+  EXPECT_EQ(runs.spanEnd(8, 100), 100);
+
+  runs.fill(0, 10, 2);
+  EXPECT_EQ(runs.get(0), 2);
+  EXPECT_EQ(runs.get(2), 1);
+  EXPECT_EQ(runs.get(5), 2);
+  EXPECT_EQ(runs.get(9), 2);
+  EXPECT_EQ(runs.runCount(), 5);
+}
+
+TEST(SiteRunsTest, MatchesDenseRow)
+{
+  constexpr int sites = 200;
+  SiteRuns<int> runs;
+  std::vector<int> dense(sites, 0);
+  std::mt19937 rng(1);
+  std::uniform_int_distribution<int> site(0, sites);
+  std::uniform_int_distribution<int> value(0, 3);
+  for (int i = 0; i < 2000; i++) {
+    int begin = site(rng);
+    int end = site(rng);
+    if (begin > end) {
+      std::swap(begin, end);
+    }
+    const int v = value(rng);
+    if (i % 3 == 0) {
+      runs.fill(begin, end, v);
+      for (int x = begin; x < end; x++) {
+        dense[x] = dense[x] == 0 ? v : dense[x];
+      }
+    } else {
+      runs.set(begin, end, v);
+      std::fill(dense.begin() + begin, dense.begin() + end, v);
+    }
+    size_t dense_runs = 0;
+    for (int x = 0; x < sites; x++) {
+      ASSERT_EQ(runs.get(x), dense[x]);
+      if (dense[x] != 0 && (x == 0 || dense[x - 1] != dense[x])) {
+        dense_runs++;
+      }
+    }
+    ASSERT_EQ(runs.runCount(), dense_runs);
+  }
+}
+
 }  // namespace dpl
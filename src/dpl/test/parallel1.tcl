@@ -0,0 +1,43 @@
+# detailed_placement -parallel is legal and independent of the thread count
+source "helpers.tcl"
+read_lef Nangate45/Nangate45.lef
+read_def aes_cipher_top_replace.def
+
+set block [ord::get_db_block]
+
+proc get_placement { block } {
+  set placement {}
+  foreach inst [$block getInsts] {
+    set bbox [$inst getBBox]
+    lappend placement $inst [$inst getOrient] [$bbox xMin] [$bbox yMin]
+  }
+  return $placement
+}
+
+proc set_placement { placement } {
+  foreach {inst orient x y} $placement {
+    $inst setOrient $orient
+    $inst setLocation $x $y
+  }
+}
+
+set global_placement [get_placement $block]
+
+detailed_placement
+check "serial placement is legal" { catch { check_placement } } 0
+
+set_placement $global_placement
+set_thread_count 2
+detailed_placement -parallel
+check "parallel placement is legal" { catch { check_placement } } 0
+set placement2 [get_placement $block]
+
+set_placement $global_placement
+set_thread_count 4
+detailed_placement -parallel
+check "parallel placement is legal" { catch { check_placement } } 0
+check "same placement with 2 and 4 threads" {
+  expr { [get_placement $block] == $placement2 }
+} 1
+
+exit_summary
@@ -65,3 +65,7 @@ record_tests {
   #dpl_man_tcl_check
   #dpl_readme_msgs_check
 }
+record_pass_fail_tests {
+  check_incremental1
+  parallel1
+}
@@ -99,6 +99,9 @@ struct ParamStruct
   int minAccessPoints = -1;
   bool saveGuideUpdates = false;
   std::string repairPDNLayerName;
+  bool dependencyScheduling = false;
+  bool deterministic = true;
+  bool adaptiveClips = false;
 };
 
 class TritonRoute
@@ -169,10 +172,14 @@ class TritonRoute
   void updateGlobals(const char* file_name);
   void resetDb(const char* file_name);
   void clearDesign();
+  // Whether odb changes are recorded for the next incremental update of
+  // the design.  Disabled while the router writes its own results to odb.
+  void setDesignSyncEnabled(bool enabled);
   void updateDesign(const std::vector<std::string>& updates);
   void updateDesign(const std::string& path);
   void addWorkerResults(
       const std::vector<std::pair<int, std::string>>& results);
+  void addWorkerResults(std::vector<std::pair<int, std::string>>&& results);
   bool getWorkerResults(std::vector<std::pair<int, std::string>>& results);
   int getWorkerResultsSize();
   void sendDesignDist();
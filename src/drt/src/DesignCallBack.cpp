@@ -28,6 +28,10 @@
 
 #include "DesignCallBack.h"
 
+#include <boost/functional/hash.hpp>
+#include <string_view>
+#include <vector>
+
 #include "frDesign.h"
 #include "triton_route/TritonRoute.h"
 
@@ -39,6 +43,89 @@ static inline int defdist(odb::dbBlock* block, int x)
          / (double) block->getDbUnitsPerMicron();
 }
 
+void DesignCallBack::track(odb::dbBlock* block)
+{
+  addOwner(block);
+  block_ = block;
+  clearChanges();
+  saveSignature();
+}
+
+size_t DesignCallBack::untrackedSignature(odb::dbBlock* block)
+{
+  size_t hash = 0;
+  for (odb::dbNet* net : block->getNets()) {
+    boost::hash_combine(hash, std::string_view(net->getConstName()));
+    boost::hash_combine(hash, net->getSigType().getValue());
+    boost::hash_combine(hash, net->isSpecial());
+    odb::dbTechNonDefaultRule* ndr = net->getNonDefaultRule();
+    boost::hash_combine(hash, ndr != nullptr ? ndr->getId() + 1 : 0);
+  }
+  for (odb::dbInst* inst : block->getInsts()) {
+    boost::hash_combine(hash, std::string_view(inst->getConstName()));
+    boost::hash_combine(hash, inst->getPlacementStatus().getValue());
+  }
+  for (odb::dbBTerm* bterm : block->getBTerms()) {
+    boost::hash_combine(hash, std::string_view(bterm->getConstName()));
+  }
+  boost::hash_combine(hash, block->getNonDefaultRules().size());
+  if (odb::dbGCellGrid* grid = block->getGCellGrid()) {
+    std::vector<int> lines;
+    grid->getGridX(lines);
+    boost::hash_combine(hash, lines);
+    grid->getGridY(lines);
+    boost::hash_combine(hash, lines);
+  }
+  return hash;
+}
+
+void DesignCallBack::saveSignature()
+{
+  signature_ = untrackedSignature(block_);
+}
+
+bool DesignCallBack::hasUntrackedChanges() const
+{
+  return untrackedSignature(block_) != signature_;
+}
+
+void DesignCallBack::clearChanges()
+{
+  requires_reload_ = false;
+  modified_nets_.clear();
+  created_insts_.clear();
+}
+
+bool DesignCallBack::isActive() const
+{
+  auto design = router_->getDesign();
+  return enabled_ && !requires_reload_ && design != nullptr
+         && design->getTopBlock() != nullptr;
+}
+
+void DesignCallBack::modifyNet(odb::dbNet* net)
+{
+  if (net != nullptr && isActive()) {
+    modified_nets_.insert(net->getName());
+  }
+}
+
+void DesignCallBack::modifyWire(odb::dbWire* wire)
+{
+  if (wire != nullptr && !wire->isGlobalWire()) {
+    modifyNet(wire->getNet());
+  }
+}
+
+void DesignCallBack::requireReload()
+{
+  if (isActive()) {
+    requires_reload_ = true;
+    modified_nets_.clear();
+    created_insts_.clear();
+  }
+}
+
 void DesignCallBack::inDbPostMoveInst(odb::dbInst* db_inst)
 {
   auto design = router_->getDesign();
@@ -78,4 +165,166 @@ void DesignCallBack::inDbInstDestroy(odb::dbInst* db_inst)
   }
 }
 
+void DesignCallBack::inDbInstCreate(odb::dbInst* inst)
+{
+  if (isActive()) {
+    created_insts_.insert(inst->getName());
+  }
+}
+
+void DesignCallBack::inDbInstCreate(odb::dbInst* inst,
+                                    odb::dbRegion* /* region */)
+{
+  inDbInstCreate(inst);
+}
+
+void DesignCallBack::inDbInstSwapMasterAfter(odb::dbInst* inst)
+{
+  if (!isActive()) {
+    return;
+  }
+  // The frInstTerms belong to the old master; rebuild the instance and
+  // reconnect its nets.
+  inDbInstDestroy(inst);
+  created_insts_.insert(inst->getName());
+  for (auto iterm : inst->getITerms()) {
+    modifyNet(iterm->getNet());
+  }
+}
+
+void DesignCallBack::inDbNetCreate(odb::dbNet* net)
+{
+  modifyNet(net);
+}
+
+void DesignCallBack::inDbNetDestroy(odb::dbNet* /* net */)
+{
+  requireReload();
+}
+
+void DesignCallBack::inDbITermPostConnect(odb::dbITerm* iterm)
+{
+  modifyNet(iterm->getNet());
+}
+
+void DesignCallBack::inDbITermPostDisconnect(odb::dbITerm* /* iterm */,
+                                             odb::dbNet* net)
+{
+  modifyNet(net);
+}
+
+void DesignCallBack::inDbBTermCreate(odb::dbBTerm* /* bterm */)
+{
+  requireReload();
+}
+
+void DesignCallBack::inDbBTermDestroy(odb::dbBTerm* /* bterm */)
+{
+  requireReload();
+}
+
+void DesignCallBack::inDbBTermPostConnect(odb::dbBTerm* bterm)
+{
+  modifyNet(bterm->getNet());
+}
+
+void DesignCallBack::inDbBTermPostDisConnect(odb::dbBTerm* /* bterm */,
+                                             odb::dbNet* net)
+{
+  modifyNet(net);
+}
+
+void DesignCallBack::inDbBPinCreate(odb::dbBPin* /* pin */)
+{
+  requireReload();
+}
+
+void DesignCallBack::inDbBPinDestroy(odb::dbBPin* /* pin */)
+{
+  requireReload();
+}
+
+void DesignCallBack::inDbBlockageCreate(odb::dbBlockage* /* blockage */)
+{
+  requireReload();
+}
+
+void DesignCallBack::inDbObstructionCreate(odb::dbObstruction* /* obs */)
+{
+  requireReload();
+}
+
+void DesignCallBack::inDbObstructionDestroy(odb::dbObstruction* /* obs */)
+{
+  requireReload();
+}
+
+void DesignCallBack::inDbWireCreate(odb::dbWire* wire)
+{
+  modifyWire(wire);
+}
+
+void DesignCallBack::inDbWireDestroy(odb::dbWire* wire)
+{
+  modifyWire(wire);
+}
+
+void DesignCallBack::inDbWirePostModify(odb::dbWire* wire)
+{
+  modifyWire(wire);
+}
+
+void DesignCallBack::inDbWirePostAttach(odb::dbWire* wire)
+{
+  modifyWire(wire);
+}
+
+void DesignCallBack::inDbWirePostDetach(odb::dbWire* wire, odb::dbNet* net)
+{
+  if (!wire->isGlobalWire()) {
+    modifyNet(net);
+  }
+}
+
+void DesignCallBack::inDbWirePostAppend(odb::dbWire* /* src */,
+                                        odb::dbWire* dst)
+{
+  modifyWire(dst);
+}
+
+void DesignCallBack::inDbWirePostCopy(odb::dbWire* /* src */, odb::dbWire* dst)
+{
+  modifyWire(dst);
+}
+
+void DesignCallBack::inDbSWireCreate(odb::dbSWire* /* wire */)
+{
+  requireReload();
+}
+
+void DesignCallBack::inDbSWireDestroy(odb::dbSWire* /* wire */)
+{
+  requireReload();
+}
+
+void DesignCallBack::inDbSWireAddSBox(odb::dbSBox* /* box */)
+{
+  requireReload();
+}
+
+void DesignCallBack::inDbSWireRemoveSBox(odb::dbSBox* /* box */)
+{
+  requireReload();
+}
+
+void DesignCallBack::inDbSWirePostDestroySBoxes(odb::dbSWire* /* wire */)
+{
+  requireReload();
+}
+
+void DesignCallBack::inDbBlockSetDieArea(odb::dbBlock* /* block */)
+{
+  requireReload();
+}
+
 }  // namespace drt
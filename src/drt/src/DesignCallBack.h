@@ -26,20 +26,96 @@
  * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#pragma once
+
+#include <set>
+#include <string>
+
 #include "odb/db.h"
 #include "odb/dbBlockCallBackObj.h"
 namespace drt {
 class TritonRoute;
 }
 namespace drt {
+// Keeps the router's frDesign in sync with odb between commands.
+// Instance moves and deletions are applied directly; other netlist and
+// routing changes are recorded by name and applied by the next
+// TritonRoute::initDesign.  Changes that cannot be applied incrementally
+// request a full re-import.
+//
+// Some of what the router reads changes without a callback (renames,
+// signal types, special flags, non default rules, placement status and
+// the gcell grid).  A signature of that state is kept from the last
+// import and a mismatch also requires a full re-import.
 class DesignCallBack : public odb::dbBlockCallBackObj
 {
  public:
   DesignCallBack(TritonRoute* router) : router_(router) {}
+
+  void track(odb::dbBlock* block);
+  bool isTracking(odb::dbBlock* block) const { return block_ == block; }
+  // Changes made by the router itself are already in the frDesign.
+  void setEnabled(bool enabled) { enabled_ = enabled; }
+
+  bool requiresReload() const { return requires_reload_; }
+  // Records the signature of the state that has no callbacks
+  void saveSignature();
+  bool hasUntrackedChanges() const;
+  const std::set<std::string>& getModifiedNets() const
+  {
+    return modified_nets_;
+  }
+  const std::set<std::string>& getCreatedInsts() const
+  {
+    return created_insts_;
+  }
+  void clearChanges();
+
   void inDbPostMoveInst(odb::dbInst* inst) override;
   void inDbInstDestroy(odb::dbInst* inst) override;
+  void inDbInstCreate(odb::dbInst* inst) override;
+  void inDbInstCreate(odb::dbInst* inst, odb::dbRegion* region) override;
+  void inDbInstSwapMasterAfter(odb::dbInst* inst) override;
+  void inDbNetCreate(odb::dbNet* net) override;
+  void inDbNetDestroy(odb::dbNet* net) override;
+  void inDbITermPostConnect(odb::dbITerm* iterm) override;
+  void inDbITermPostDisconnect(odb::dbITerm* iterm, odb::dbNet* net) override;
+  void inDbBTermCreate(odb::dbBTerm* bterm) override;
+  void inDbBTermDestroy(odb::dbBTerm* bterm) override;
+  void inDbBTermPostConnect(odb::dbBTerm* bterm) override;
+  void inDbBTermPostDisConnect(odb::dbBTerm* bterm, odb::dbNet* net) override;
+  void inDbBPinCreate(odb::dbBPin* pin) override;
+  void inDbBPinDestroy(odb::dbBPin* pin) override;
+  void inDbBlockageCreate(odb::dbBlockage* blockage) override;
+  void inDbObstructionCreate(odb::dbObstruction* obs) override;
+  void inDbObstructionDestroy(odb::dbObstruction* obs) override;
+  void inDbWireCreate(odb::dbWire* wire) override;
+  void inDbWireDestroy(odb::dbWire* wire) override;
+  void inDbWirePostModify(odb::dbWire* wire) override;
+  void inDbWirePostAttach(odb::dbWire* wire) override;
+  void inDbWirePostDetach(odb::dbWire* wire, odb::dbNet* net) override;
+  void inDbWirePostAppend(odb::dbWire* src, odb::dbWire* dst) override;
+  void inDbWirePostCopy(odb::dbWire* src, odb::dbWire* dst) override;
+  void inDbSWireCreate(odb::dbSWire* wire) override;
+  void inDbSWireDestroy(odb::dbSWire* wire) override;
+  void inDbSWireAddSBox(odb::dbSBox* box) override;
+  void inDbSWireRemoveSBox(odb::dbSBox* box) override;
+  void inDbSWirePostDestroySBoxes(odb::dbSWire* wire) override;
+  void inDbBlockSetDieArea(odb::dbBlock* block) override;
 
  private:
+  bool isActive() const;
+  void modifyNet(odb::dbNet* net);
+  void modifyWire(odb::dbWire* wire);
+  void requireReload();
+  static size_t untrackedSignature(odb::dbBlock* block);
+
   TritonRoute* router_;
+  odb::dbBlock* block_{nullptr};
+  bool enabled_{true};
+  bool requires_reload_{false};
+  size_t signature_{0};
+  std::set<std::string> modified_nets_;
+  std::set<std::string> created_insts_;
 };
 }  // namespace drt
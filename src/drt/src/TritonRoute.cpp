@@ -324,6 +324,11 @@ void TritonRoute::clearDesign()
   design_ = std::make_unique<frDesign>(logger_);
 }
 
+void TritonRoute::setDesignSyncEnabled(bool enabled)
+{
+  db_callback_->setEnabled(enabled);
+}
+
 static void deserializeUpdate(frDesign* design,
                               const std::string& updateStr,
                               std::vector<drUpdate>& updates)
@@ -556,11 +561,26 @@ void TritonRoute::initDesign()
       || db_->getChip()->getBlock() == nullptr) {
     logger_->error(utl::DRT, 151, "Database, chip or block not initialized.");
   }
-  io::Parser parser(db_, getDesign(), logger_);
+  odb::dbBlock* block = db_->getChip()->getBlock();
   if (getDesign()->getTopBlock() != nullptr) {
-    parser.updateDesign();
-    return;
+    // Keep the design from the previous command and apply the odb changes
+    // recorded since then rather than importing the whole chip again.
+    if (db_callback_->isTracking(block) && !db_callback_->requiresReload()
+        && !db_callback_->hasUntrackedChanges()) {
+      io::Parser parser(db_, getDesign(), logger_);
+      const bool updated
+          = parser.updateDesign(db_callback_->getModifiedNets(),
+                                db_callback_->getCreatedInsts());
+      db_callback_->clearChanges();
+      if (updated) {
+        db_callback_->saveSignature();
+        return;
+      }
+    }
+    debugPrint(logger_, DRT, "init", 1, "Reloading design from odb.");
+    clearDesign();
   }
+  io::Parser parser(db_, getDesign(), logger_);
   parser.readTechAndLibs(db_);
   processBTermsAboveTopLayer();
   parser.readDesign(db_);
@@ -600,7 +620,7 @@ void TritonRoute::initDesign()
     }
   }
   parser.postProcess();
-  db_callback_->addOwner(db_->getChip()->getBlock());
+  db_callback_->track(block);
 }
 
 void TritonRoute::prep()
@@ -1122,14 +1142,21 @@ void TritonRoute::checkDRC(const char* filename, int x1, int y1, int x2, int y2)
   GC_IGNORE_PDN_LAYER_NUM = -1;
   REPAIR_PDN_LAYER_NUM = -1;
   initDesign();
-  auto gcellGrid = db_->getChip()->getBlock()->getGCellGrid();
-  if (gcellGrid != nullptr && gcellGrid->getNumGridPatternsX() == 1
-      && gcellGrid->getNumGridPatternsY() == 1) {
-    io::GuideProcessor guide_processor(getDesign(), db_, logger_);
-    guide_processor.readGuides();
-    guide_processor.buildGCellPatterns();
-  } else if (!initGuide()) {
-    logger_->error(DRT, 1, "GCELLGRID is undefined");
+  // The gcell patterns are kept from an earlier command along with the
+  // design, so the guides are only processed when there are none.  They
+  // only set the checking tiles, and the markers found do not depend on
+  // the guides.  A change to the gcell grid reloads the design, which
+  // clears the patterns (see DesignCallBack::untrackedSignature).
+  if (design_->getTopBlock()->getGCellPatterns().empty()) {
+    auto gcellGrid = db_->getChip()->getBlock()->getGCellGrid();
+    if (gcellGrid != nullptr && gcellGrid->getNumGridPatternsX() == 1
+        && gcellGrid->getNumGridPatternsY() == 1) {
+      io::GuideProcessor guide_processor(getDesign(), db_, logger_);
+      guide_processor.readGuides();
+      guide_processor.buildGCellPatterns();
+    } else if (!initGuide()) {
+      logger_->error(DRT, 1, "GCELLGRID is undefined");
+    }
   }
   Rect requiredDrcBox(x1, y1, x2, y2);
   if (requiredDrcBox.area() == 0) {
@@ -1356,6 +1383,9 @@ void TritonRoute::setParams(const ParamStruct& params)
   }
   SAVE_GUIDE_UPDATES = params.saveGuideUpdates;
   REPAIR_PDN_LAYER_NAME = params.repairPDNLayerName;
+  DEPENDENCY_SCHEDULING = params.dependencyScheduling;
+  DETERMINISTIC_DR = params.deterministic;
+  ADAPTIVE_CLIPS = params.adaptiveClips;
 }
 
 void TritonRoute::addWorkerResults(
@@ -1367,6 +1397,16 @@ void TritonRoute::addWorkerResults(
   results_sz_ = workers_results_.size();
 }
 
+void TritonRoute::addWorkerResults(
+    std::vector<std::pair<int, std::string>>&& results)
+{
+  std::unique_lock<std::mutex> lock(results_mutex_);
+  workers_results_.insert(workers_results_.end(),
+                          std::make_move_iterator(results.begin()),
+                          std::make_move_iterator(results.end()));
+  results_sz_ = workers_results_.size();
+}
+
 bool TritonRoute::getWorkerResults(
     std::vector<std::pair<int, std::string>>& results)
 {
@@ -1374,7 +1414,7 @@ bool TritonRoute::getWorkerResults(
   if (workers_results_.empty()) {
     return false;
   }
-  results = workers_results_;
+  results = std::move(workers_results_);
   workers_results_.clear();
   results_sz_ = 0;
   return true;
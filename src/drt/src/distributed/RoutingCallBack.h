@@ -81,7 +81,7 @@ class RoutingCallBack : public dst::JobCallBack
       init_ = false;
       omp_set_num_threads(ord::OpenRoad::openRoad()->getThreadCount());
     }
-    auto workers = desc->getWorkers();
+    const auto& workers = desc->getWorkers();
     int size = workers.size();
     std::vector<std::pair<int, std::string>> results;
     asio::thread_pool reply_pool(1);
@@ -94,7 +94,7 @@ class RoutingCallBack : public dst::JobCallBack
              router_->runDRWorker(workers.at(i).second, &via_data_)};
 #pragma omp critical
       {
-        results.push_back(result);
+        results.push_back(std::move(result));
         ++cnt;
         if (cnt * 1.0 / size >= prev_perc / 100.0 + 0.1 && prev_perc < 90) {
           prev_perc += 10;
@@ -29,6 +29,8 @@
 #pragma once
 #include <boost/serialization/base_object.hpp>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "dst/JobMessage.h"
 namespace boost::serialization {
@@ -47,6 +49,10 @@ class RoutingJobDescription : public dst::JobDescription
   {
     workers_ = workers;
   }
+  void setWorkers(std::vector<std::pair<int, std::string>>&& workers)
+  {
+    workers_ = std::move(workers);
+  }
   void setUpdates(const std::vector<std::string>& updates)
   {
     updates_ = updates;
@@ -62,6 +68,11 @@ class RoutingJobDescription : public dst::JobDescription
   {
     return workers_;
   }
+  // Moves the serialized workers out so large payloads are not copied.
+  std::vector<std::pair<int, std::string>> releaseWorkers()
+  {
+    return std::move(workers_);
+  }
   const std::vector<std::string>& getUpdates() { return updates_; }
   bool isDesignUpdate() const { return design_update_; }
   int getSendEvery() const { return send_every_; }
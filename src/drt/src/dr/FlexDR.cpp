@@ -31,13 +31,15 @@
 #include <dst/JobMessage.h>
 #include <omp.h>
 
-#include <boost/archive/text_iarchive.hpp>
-#include <boost/archive/text_oarchive.hpp>
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
 #include <boost/io/ios_state.hpp>
+#include <atomic>
 #include <chrono>
 #include <cstdio>
 #include <fstream>
 #include <iomanip>
+#include <mutex>
 #include <numeric>
 #include <sstream>
 
@@ -47,7 +49,7 @@
 #include "distributed/frArchive.h"
 #include "dr/FlexDR_conn.h"
 #include "dr/FlexDR_graphics.h"
-#include "dst/BalancerJobDescription.h"
+#include "dr/FlexDR_scheduler.h"
 #include "dst/Distributed.h"
 #include "frProfileTask.h"
 #include "gc/FlexGC.h"
@@ -204,8 +206,15 @@ void FlexDRWorker::writeUpdates(const std::string& file_name)
 int FlexDRWorker::main(frDesign* design)
 {
   ProfileTask profile("DRW:main");
+  mainInit(design);
+  mainRoute();
+  return 0;
+}
+
+void FlexDRWorker::mainInit(frDesign* design)
+{
   using std::chrono::high_resolution_clock;
-  high_resolution_clock::time_point t0 = high_resolution_clock::now();
+  mainStart_ = high_resolution_clock::now();
   auto micronPerDBU = 1.0 / getTech()->getDBUPerUU();
   if (VERBOSE > 1) {
     logger_->report("start DR worker (BOX) ( {} {} ) ( {} {} )",
@@ -268,7 +277,15 @@ int FlexDRWorker::main(frDesign* design)
   if (!skipRouting_) {
     init(design);
   }
-  high_resolution_clock::time_point t1 = high_resolution_clock::now();
+  initEnd_ = high_resolution_clock::now();
+}
+
+void FlexDRWorker::mainRoute()
+{
+  using std::chrono::high_resolution_clock;
+  const high_resolution_clock::time_point t0 = mainStart_;
+  const high_resolution_clock::time_point t1 = initEnd_;
+  auto micronPerDBU = 1.0 / getTech()->getDBUPerUU();
   if (!skipRouting_) {
     route_queue();
   }
@@ -303,8 +320,6 @@ int FlexDRWorker::main(frDesign* design)
              duration_cast<duration<double>>(t3 - t0).count(),
              getInitNumMarkers(),
              num_markers);
-
-  return 0;
 }
 
 void FlexDRWorker::distributedMain(frDesign* design)
@@ -559,18 +574,208 @@ void FlexDR::getBatchInfo(int& batchStepX, int& batchStepY)
   batchStepY = 2;
 }
 
+Rect FlexDR::getClipRouteBox(const Point& clip, const int size) const
+{
+  auto& gCellPatterns = getDesign()->getTopBlock()->getGCellPatterns();
+  auto& xgp = gCellPatterns.at(0);
+  auto& ygp = gCellPatterns.at(1);
+  const int max_i = std::min((int) xgp.getCount() - 1, clip.x() + size - 1);
+  const int max_j = std::min((int) ygp.getCount(), clip.y() + size - 1);
+  Rect routeBox1 = getDesign()->getTopBlock()->getGCellBox(clip);
+  Rect routeBox2 = getDesign()->getTopBlock()->getGCellBox(Point(max_i, max_j));
+  return Rect(routeBox1.xMin(),
+              routeBox1.yMin(),
+              routeBox2.xMax(),
+              routeBox2.yMax());
+}
+
+bool FlexDR::isCleanClip(const Rect& routeBox) const
+{
+  Rect drcBox;
+  routeBox.bloat(DRCSAFEDIST, drcBox);
+  std::vector<frMarker*> result;
+  getRegionQuery()->queryMarker(drcBox, result);
+  return result.empty();
+}
+
+std::unique_ptr<FlexDRWorker> FlexDR::makeWorker(const SearchRepairArgs& args,
+                                                 const int iter,
+                                                 const Point& clip)
+{
+  const int size = args.size;
+  const int i = clip.x();
+  const int j = clip.y();
+  auto gCellPatterns = getDesign()->getTopBlock()->getGCellPatterns();
+  auto& xgp = gCellPatterns.at(0);
+  auto& ygp = gCellPatterns.at(1);
+  auto worker = std::make_unique<FlexDRWorker>(&via_data_, design_, logger_);
+  const int max_i = std::min((int) xgp.getCount() - 1, i + size - 1);
+  const int max_j = std::min((int) ygp.getCount(), j + size - 1);
+  const Rect routeBox = getClipRouteBox(clip, size);
+  Rect extBox;
+  Rect drcBox;
+  routeBox.bloat(MTSAFEDIST, extBox);
+  routeBox.bloat(DRCSAFEDIST, drcBox);
+  worker->setRouteBox(routeBox);
+  worker->setExtBox(extBox);
+  worker->setDrcBox(drcBox);
+  worker->setGCellBox(Rect(i, j, max_i, max_j));
+  worker->setMazeEndIter(args.mazeEndIter);
+  worker->setDRIter(iter);
+  worker->setDebugSettings(router_->getDebugSettings());
+  if (dist_on_) {
+    worker->setDistributed(dist_, dist_ip_, dist_port_, dist_dir_);
+  }
+  if (!iter) {
+    // set boundary pin
+    auto bp = initDR_mergeBoundaryPin(i, j, size, routeBox);
+    worker->setDRIter(0, bp);
+  }
+  worker->setRipupMode(args.ripupMode);
+  worker->setFollowGuide(args.followGuide);
+  // TODO: only pass to relevant workers
+  worker->setGraphics(graphics_.get());
+  worker->setCost(args.workerDRCCost,
+                  args.workerMarkerCost,
+                  args.workerFixedShapeCost,
+                  args.workerMarkerDecay);
+  return worker;
+}
+
+void FlexDR::runWorkerGraph(
+    const std::vector<std::vector<std::vector<Point>>>& batches,
+    const int offset,
+    const int size,
+    const std::function<std::unique_ptr<FlexDRWorker>(const Point&)>&
+        createWorker,
+    const std::function<void(const FlexDRWorker*, double)>& workerDone)
+{
+  ProfileTask profile("DR:worker_graph");
+  // Flatten the checkerboard batches.  Clips keep the batch order so the
+  // clips of a lower color come first.
+  std::vector<Point> clips;
+  for (auto& clipBatch : batches) {
+    for (auto& clipsInBatch : clipBatch) {
+      clips.insert(clips.end(), clipsInBatch.begin(), clipsInBatch.end());
+    }
+  }
+
+  // Workers whose clips touch (including diagonally) have overlapping
+  // extension boxes.  Such a worker has to wait for the neighbors of a lower
+  // color to write their results back.  Workers further apart are
+  // independent, as in the checkerboard batches.
+  std::map<std::pair<int, int>, int> grid2worker;
+  for (int i = 0; i < (int) clips.size(); i++) {
+    grid2worker[{(clips[i].x() - offset) / size,
+                 (clips[i].y() - offset) / size}]
+        = i;
+  }
+  std::vector<std::vector<int>> dependencies(clips.size());
+  for (const auto& [idx, i] : grid2worker) {
+    for (int dx = -1; dx <= 1; dx++) {
+      for (int dy = -1; dy <= 1; dy++) {
+        auto it = grid2worker.find({idx.first + dx, idx.second + dy});
+        if (it != grid2worker.end() && it->second < i) {
+          dependencies[i].push_back(it->second);
+        }
+      }
+    }
+  }
+
+  std::vector<std::unique_ptr<FlexDRWorker>> workers(clips.size());
+  std::vector<std::chrono::steady_clock::time_point> starts(clips.size());
+  FlexDRScheduler scheduler(std::move(dependencies), DETERMINISTIC_DR);
+  scheduler.run(
+      MAX_THREADS,
+      [&](int i) {
+        starts[i] = std::chrono::steady_clock::now();
+        workers[i] = createWorker(clips[i]);
+        if (workers[i]) {
+          workers[i]->mainInit(getDesign());
+        }
+      },
+      [&](int i) {
+        if (!workers[i]) {
+          workerDone(nullptr, 0);
+          return;
+        }
+        workers[i]->mainRoute();
+        const std::chrono::duration<double> worker_time
+            = std::chrono::steady_clock::now() - starts[i];
+        workerDone(workers[i].get(), worker_time.count());
+      },
+      [&](int i) {
+        if (!workers[i]) {
+          return;
+        }
+        if (workers[i]->end(getDesign())) {
+          numWorkUnits_ += 1;
+        }
+        if (workers[i]->isCongested()) {
+          increaseClipsize_ = true;
+        }
+        workers[i].reset();
+      });
+}
+
+void FlexDR::reportWorkerRuntime(const int iter,
+                                 const std::vector<WorkerRuntime>& runtimes,
+                                 const double wallTime)
+{
+  if (runtimes.empty() || !logger_->debugCheck(DRT, "workers", 1)) {
+    return;
+  }
+  auto slowest = std::max_element(
+      runtimes.begin(),
+      runtimes.end(),
+      [](const WorkerRuntime& a, const WorkerRuntime& b) {
+        return a.seconds < b.seconds;
+      });
+  double total = 0;
+  for (const WorkerRuntime& runtime : runtimes) {
+    total += runtime.seconds;
+  }
+  const double dbu = getTech()->getDBUPerUU();
+  // busy time over the time the threads were available
+  const double utilization
+      = wallTime > 0 ? total / (wallTime * MAX_THREADS) : 0;
+  debugPrint(logger_,
+             DRT,
+             "workers",
+             1,
+             "Iter {} worker runtime: {} workers, avg {:.3f}s, max {:.3f}s at "
+             "({:.3f} {:.3f}) ({:.3f} {:.3f}), wall {:.3f}s, thread "
+             "utilization {:.1f}%.",
+             iter,
+             runtimes.size(),
+             total / runtimes.size(),
+             slowest->seconds,
+             slowest->routeBox.xMin() / dbu,
+             slowest->routeBox.yMin() / dbu,
+             slowest->routeBox.xMax() / dbu,
+             slowest->routeBox.yMax() / dbu,
+             wallTime,
+             100 * utilization);
+  for (const WorkerRuntime& runtime : runtimes) {
+    debugPrint(logger_,
+               DRT,
+               "workers",
+               2,
+               "  worker ({:.3f} {:.3f}) ({:.3f} {:.3f}) {:.3f}s",
+               runtime.routeBox.xMin() / dbu,
+               runtime.routeBox.yMin() / dbu,
+               runtime.routeBox.xMax() / dbu,
+               runtime.routeBox.yMax() / dbu,
+               runtime.seconds);
+  }
+}
+
 void FlexDR::searchRepair(const SearchRepairArgs& args)
 {
   const int iter = iter_++;
   const int size = args.size;
   const int offset = args.offset;
-  const int mazeEndIter = args.mazeEndIter;
-  const frUInt4 workerDRCCost = args.workerDRCCost;
-  const frUInt4 workerMarkerCost = args.workerMarkerCost;
-  const frUInt4 workerFixedShapeCost = args.workerFixedShapeCost;
-  const float workerMarkerDecay = args.workerMarkerDecay;
   const RipUpMode ripupMode = args.ripupMode;
-  const bool followGuide = args.followGuide;
 
   std::string profile_name("DR:searchRepair");
   profile_name += std::to_string(iter);
@@ -611,67 +816,25 @@ void FlexDR::searchRepair(const SearchRepairArgs& args)
   int prev_perc = 0;
   bool isExceed = false;
 
-  std::vector<std::unique_ptr<FlexDRWorker>> uworkers;
   int batchStepX, batchStepY;
 
   getBatchInfo(batchStepX, batchStepY);
 
-  std::vector<std::vector<std::vector<std::unique_ptr<FlexDRWorker>>>> workers(
-      batchStepX * batchStepY);
+  // Workers are only created once their batch runs.  From the third
+  // iteration on a worker without markers in its drc box skips routing (see
+  // FlexDRWorker::main), so such clips are dropped before a worker is built.
+  // The check has to wait for the batch as earlier batches add markers.
+  std::vector<std::vector<std::vector<Point>>> clips(batchStepX * batchStepY);
 
   int xIdx = 0, yIdx = 0;
   for (int i = offset; i < (int) xgp.getCount(); i += size) {
     for (int j = offset; j < (int) ygp.getCount(); j += size) {
-      auto worker
-          = std::make_unique<FlexDRWorker>(&via_data_, design_, logger_);
-      Rect routeBox1 = getDesign()->getTopBlock()->getGCellBox(Point(i, j));
-      const int max_i = std::min((int) xgp.getCount() - 1, i + size - 1);
-      const int max_j = std::min((int) ygp.getCount(), j + size - 1);
-      Rect routeBox2
-          = getDesign()->getTopBlock()->getGCellBox(Point(max_i, max_j));
-      Rect routeBox(routeBox1.xMin(),
-                    routeBox1.yMin(),
-                    routeBox2.xMax(),
-                    routeBox2.yMax());
-      Rect extBox;
-      Rect drcBox;
-      routeBox.bloat(MTSAFEDIST, extBox);
-      routeBox.bloat(DRCSAFEDIST, drcBox);
-      worker->setRouteBox(routeBox);
-      worker->setExtBox(extBox);
-      worker->setDrcBox(drcBox);
-      worker->setGCellBox(Rect(i, j, max_i, max_j));
-      worker->setMazeEndIter(mazeEndIter);
-      worker->setDRIter(iter);
-      worker->setDebugSettings(router_->getDebugSettings());
-      if (dist_on_) {
-        worker->setDistributed(dist_, dist_ip_, dist_port_, dist_dir_);
-      }
-      if (!iter) {
-        // if (routeBox.xMin() == 441000 && routeBox.yMin() == 816100) {
-        //   std::cout << "@@@ debug: " << i << " " << j << std::endl;
-        // }
-        // set boundary pin
-        auto bp = initDR_mergeBoundaryPin(i, j, size, routeBox);
-        worker->setDRIter(0, bp);
-      }
-      worker->setRipupMode(ripupMode);
-      worker->setFollowGuide(followGuide);
-      // TODO: only pass to relevant workers
-      worker->setGraphics(graphics_.get());
-      worker->setCost(workerDRCCost,
-                      workerMarkerCost,
-                      workerFixedShapeCost,
-                      workerMarkerDecay);
-
       int batchIdx = (xIdx % batchStepX) * batchStepY + yIdx % batchStepY;
-      if (workers[batchIdx].empty()
-          || (!dist_on_
-              && (int) workers[batchIdx].back().size() >= BATCHSIZE)) {
-        workers[batchIdx].push_back(
-            std::vector<std::unique_ptr<FlexDRWorker>>());
+      if (clips[batchIdx].empty()
+          || (!dist_on_ && (int) clips[batchIdx].back().size() >= BATCHSIZE)) {
+        clips[batchIdx].push_back(std::vector<Point>());
       }
-      workers[batchIdx].back().push_back(std::move(worker));
+      clips[batchIdx].back().emplace_back(i, j);
 
       yIdx++;
     }
@@ -679,17 +842,71 @@ void FlexDR::searchRepair(const SearchRepairArgs& args)
     xIdx++;
   }
 
+  const bool skipClean = iter > 1;
+  // Workers are created and finished on the routing threads; the mutex
+  // guards the statistics and the progress report below.
+  std::mutex progress_mutex;
+  std::atomic<int> numSkipped{0};
+  int numCreated = 0;
+  double createTime = 0;
+  auto createWorker
+      = [&](const Point& clip) -> std::unique_ptr<FlexDRWorker> {
+    if (skipClean && isCleanClip(getClipRouteBox(clip, size))) {
+      numSkipped++;
+      return nullptr;
+    }
+    const auto create_start = std::chrono::steady_clock::now();
+    auto worker = makeWorker(args, iter, clip);
+    const std::chrono::duration<double> create_time
+        = std::chrono::steady_clock::now() - create_start;
+    std::lock_guard<std::mutex> lock(progress_mutex);
+    numCreated++;
+    createTime += create_time.count();
+    return worker;
+  };
+
+  std::vector<WorkerRuntime> runtimes;
+  // worker is null for a skipped clip
+  auto workerDone = [&](const FlexDRWorker* worker, const double seconds) {
+    std::lock_guard<std::mutex> lock(progress_mutex);
+    if (worker) {
+      runtimes.push_back({worker->getRouteBox(), seconds});
+    }
+    cnt++;
+    if (VERBOSE > 0) {
+      if (cnt * 1.0 / tot >= prev_perc / 100.0 + 0.1 && prev_perc < 90) {
+        if (prev_perc == 0 && t.isExceed(0)) {
+          isExceed = true;
+        }
+        prev_perc += 10;
+        if (isExceed) {
+          logger_->report("    Completing {}% with {} violations.",
+                          prev_perc,
+                          getDesign()->getTopBlock()->getNumMarkers());
+          logger_->report("    {}.", t);
+        }
+      }
+    }
+  };
+
   omp_set_num_threads(MAX_THREADS);
   int version = 0;
   increaseClipsize_ = false;
   numWorkUnits_ = 0;
+  const auto start = std::chrono::steady_clock::now();
+  if (DEPENDENCY_SCHEDULING && !dist_on_) {
+    runWorkerGraph(clips, offset, size, createWorker, workerDone);
+    clips.clear();
+  }
   // parallel execution
-  for (auto& workerBatch : workers) {
+  for (auto& clipBatch : clips) {
     ProfileTask profile("DR:checkerboard");
-    for (auto& workersInBatch : workerBatch) {
+    for (auto& clipsInBatch : clipBatch) {
+      std::vector<std::unique_ptr<FlexDRWorker>> workersInBatch(
+          clipsInBatch.size());
       {
         const std::string batch_name = std::string("DR:batch<")
-                                       + std::to_string(workersInBatch.size())
+                                       + std::to_string(clipsInBatch.size())
                                        + ">";
         ProfileTask profile(batch_name.c_str());
         if (dist_on_) {
@@ -709,31 +926,20 @@ void FlexDR::searchRepair(const SearchRepairArgs& args)
 #pragma omp parallel for schedule(dynamic)
           for (int i = 0; i < (int) workersInBatch.size(); i++) {  // NOLINT
             try {
+              const auto worker_start = std::chrono::steady_clock::now();
+              workersInBatch[i] = createWorker(clipsInBatch[i]);
+              if (!workersInBatch[i]) {
+                workerDone(nullptr, 0);
+                continue;
+              }
               if (dist_on_) {
                 workersInBatch[i]->distributedMain(getDesign());
               } else {
                 workersInBatch[i]->main(getDesign());
               }
-#pragma omp critical
-              {
-                cnt++;
-                if (VERBOSE > 0) {
-                  if (cnt * 1.0 / tot >= prev_perc / 100.0 + 0.1
-                      && prev_perc < 90) {
-                    if (prev_perc == 0 && t.isExceed(0)) {
-                      isExceed = true;
-                    }
-                    prev_perc += 10;
-                    if (isExceed) {
-                      logger_->report(
-                          "    Completing {}% with {} violations.",
-                          prev_perc,
-                          getDesign()->getTopBlock()->getNumMarkers());
-                      logger_->report("    {}.", t);
-                    }
-                  }
-                }
-              }
+              const std::chrono::duration<double> worker_time
+                  = std::chrono::steady_clock::now() - worker_start;
+              workerDone(workersInBatch[i].get(), worker_time.count());
             } catch (...) {
               exception.capture();
             }
@@ -745,20 +951,39 @@ void FlexDR::searchRepair(const SearchRepairArgs& args)
                 distWorkerBatches(router_->getCloudSize());
             for (int i = 0; i < workersInBatch.size(); i++) {
               auto worker = workersInBatch.at(i).get();
-              if (!worker->isSkipRouting()) {
+              if (worker && !worker->isSkipRouting()) {
                 distWorkerBatches[j].push_back({i, worker});
                 j = (j + 1) % router_->getCloudSize();
               }
             }
+            // Each stage is timed around its parallel region, so the times
+            // are elapsed time rather than time summed over the threads.
+            const auto serialize_start = std::chrono::steady_clock::now();
+            std::vector<std::vector<std::pair<int, std::string>>>
+                serializedBatches(distWorkerBatches.size());
+            {
+              ProfileTask task("DIST: SERIALIZE_BATCH");
+#pragma omp parallel for schedule(dynamic)
+              for (int i = 0; i < distWorkerBatches.size(); i++) {  // NOLINT
+                for (auto& [idx, worker] : distWorkerBatches.at(i)) {
+                  std::string workerStr;
+                  serializeWorker(worker, workerStr);
+                  serializedBatches[i].emplace_back(idx, std::move(workerStr));
+                }
+              }
+            }
+            const auto transfer_start = std::chrono::steady_clock::now();
             {
-              ProfileTask task("DIST: SERIALIZE+SEND");
+              ProfileTask task("DIST: SEND");
 #pragma omp parallel for schedule(dynamic)
-              for (int i = 0; i < distWorkerBatches.size(); i++)  // NOLINT
-                sendWorkers(distWorkerBatches.at(i), workersInBatch);
+              for (int i = 0; i < serializedBatches.size(); i++)  // NOLINT
+                sendWorkers(std::move(serializedBatches[i]));
             }
             logger_->report("    Received Batches:{}.", t);
             std::vector<std::pair<int, std::string>> workers;
+            const auto collect_start = std::chrono::steady_clock::now();
             router_->getWorkerResults(workers);
+            const auto deserialize_start = std::chrono::steady_clock::now();
             {
               ProfileTask task("DIST: DESERIALIZING_BATCH");
 #pragma omp parallel for schedule(dynamic)
@@ -768,7 +993,23 @@ void FlexDR::searchRepair(const SearchRepairArgs& args)
                                   workers.at(i).second);
               }
             }
+            const auto deserialize_end = std::chrono::steady_clock::now();
             logger_->report("    Deserialized Batches:{}.", t);
+            const std::chrono::duration<double> serialize_time
+                = transfer_start - serialize_start;
+            const std::chrono::duration<double> transfer_time
+                = collect_start - transfer_start;
+            const std::chrono::duration<double> collect_time
+                = deserialize_start - collect_start;
+            const std::chrono::duration<double> deserialize_time
+                = deserialize_end - deserialize_start;
+            logger_->report(
+                "      Serialize {:.2f}s, transfer {:.2f}s, collect {:.2f}s, "
+                "deserialize {:.2f}s.",
+                serialize_time.count(),
+                transfer_time.count(),
+                collect_time.count(),
+                deserialize_time.count());
           }
         }
       }
@@ -776,6 +1017,9 @@ void FlexDR::searchRepair(const SearchRepairArgs& args)
         ProfileTask profile("DR:end_batch");
         // single thread
         for (auto& worker : workersInBatch) {
+          if (!worker) {
+            continue;
+          }
           if (worker->end(getDesign())) {
             numWorkUnits_ += 1;
           }
@@ -783,11 +1027,27 @@ void FlexDR::searchRepair(const SearchRepairArgs& args)
             increaseClipsize_ = true;
           }
         }
-        workersInBatch.clear();
       }
     }
   }
 
+  const std::chrono::duration<double> wall_time
+      = std::chrono::steady_clock::now() - start;
+  reportWorkerRuntime(iter, runtimes, wall_time.count());
+  if (VERBOSE > 0 && numSkipped > 0) {
+    // a skipped worker would have been built, checked for markers and torn
+    // down, which is dominated by building it
+    const double saved
+        = numCreated > 0 ? numSkipped * createTime / numCreated : 0;
+    logger_->info(DRT,
+                  196,
+                  "  Skipped {} of {} clean workers, saving about {:.2f}s of "
+                  "worker setup.",
+                  numSkipped.load(),
+                  numSkipped + numCreated,
+                  saved / MAX_THREADS);
+  }
+
   if (!iter) {
     removeGCell2BoundaryPin();
   }
@@ -1391,6 +1651,98 @@ std::vector<frVia*> FlexDR::getLonelyVias(frLayer* layer,
   return lonely_vias;
 }
 
+// Picks the clip size and offset of a repair iteration from the marker
+// density.  Like the strategy, the offset is not positive so that the
+// clips cover the whole die.  A placement costs the area of the clips that
+// have markers, as that is what the workers have to initialize and route,
+// plus the area of one clip for every marker it leaves on an interior clip
+// edge, as those markers are unlikely to be fixed in this iteration.
+void FlexDR::planClips(SearchRepairArgs& args)
+{
+  const auto& markers = getDesign()->getTopBlock()->getMarkers();
+  if (markers.empty()) {
+    return;
+  }
+  auto& gCellPatterns = getDesign()->getTopBlock()->getGCellPatterns();
+  const int xSize = gCellPatterns.at(0).getCount();
+  const int ySize = gCellPatterns.at(1).getCount();
+
+  // number of markers per gcell as 2D prefix sums
+  std::vector<std::vector<int>> density(xSize + 1,
+                                        std::vector<int>(ySize + 1, 0));
+  std::vector<Point> markerGCells;
+  markerGCells.reserve(markers.size());
+  for (const auto& marker : markers) {
+    const Point idx
+        = getDesign()->getTopBlock()->getGCellIdx(marker->getBBox().center());
+    density[idx.x() + 1][idx.y() + 1]++;
+    markerGCells.push_back(idx);
+  }
+  for (int x = 1; x <= xSize; x++) {
+    for (int y = 1; y <= ySize; y++) {
+      density[x][y] += density[x - 1][y] + density[x][y - 1]
+                       - density[x - 1][y - 1];
+    }
+  }
+  auto hasMarkers = [&](int xLo, int yLo, int xHi, int yHi) {
+    xLo = std::max(xLo, 0);
+    yLo = std::max(yLo, 0);
+    xHi = std::min(xHi, xSize - 1);
+    yHi = std::min(yHi, ySize - 1);
+    return density[xHi + 1][yHi + 1] - density[xLo][yHi + 1]
+               - density[xHi + 1][yLo] + density[xLo][yLo]
+           > 0;
+  };
+  auto isEdge = [](int idx, int offset, int size, int count) {
+    const int pos = (idx - offset) % size;
+    return (pos == 0 && idx > 0) || (pos == size - 1 && idx < count - 1);
+  };
+  auto cost = [&](int size, int offset) {
+    const int64_t area = (int64_t) size * size;
+    int64_t total = 0;
+    for (int x = offset; x < xSize; x += size) {
+      for (int y = offset; y < ySize; y += size) {
+        // the drc box reaches a bit into the neighboring gcells
+        if (hasMarkers(x - 1, y - 1, x + size, y + size)) {
+          total += area;
+        }
+      }
+    }
+    for (const Point& idx : markerGCells) {
+      if (isEdge(idx.x(), offset, size, xSize)
+          || isEdge(idx.y(), offset, size, ySize)) {
+        total += area;
+      }
+    }
+    return total;
+  };
+
+  const int64_t defaultCost = cost(args.size, args.offset);
+  int64_t bestCost = defaultCost;
+  for (const int size : {args.size, args.size - 2}) {
+    if (size < 3) {
+      continue;
+    }
+    for (int offset = 0; offset > -size; offset--) {
+      const int64_t currCost = cost(size, offset);
+      if (currCost < bestCost) {
+        bestCost = currCost;
+        args.size = size;
+        args.offset = offset;
+      }
+    }
+  }
+  debugPrint(logger_,
+             DRT,
+             "workers",
+             1,
+             "Clip size {} offset {}, cost {} (default placement {}).",
+             args.size,
+             args.offset,
+             bestCost,
+             defaultCost);
+}
+
 int FlexDR::main()
 {
   ProfileTask profile("DR:main");
@@ -1421,6 +1773,11 @@ int FlexDR::main()
         args.ripupMode = RipUpMode::INCR;
       }
     }
+    if (ADAPTIVE_CLIPS && iter_ > 1
+        && (args.ripupMode == RipUpMode::DRC
+            || args.ripupMode == RipUpMode::NEARDRC)) {
+      planClips(args);
+    }
     searchRepair(args);
     if (getDesign()->getTopBlock()->getNumMarkers() == 0) {
       break;
@@ -1451,38 +1808,13 @@ int FlexDR::main()
   return 0;
 }
 
-void FlexDR::sendWorkers(
-    const std::vector<std::pair<int, FlexDRWorker*>>& remote_batch,
-    std::vector<std::unique_ptr<FlexDRWorker>>& batch)
+void FlexDR::sendWorkers(std::vector<std::pair<int, std::string>> workers)
 {
-  if (remote_batch.empty()) {
+  if (workers.empty()) {
     return;
   }
-  std::vector<std::pair<int, std::string>> workers;
-  {
-    ProfileTask task("DIST: SERIALIZE_BATCH");
-    for (auto& [idx, worker] : remote_batch) {
-      std::string workerStr;
-      serializeWorker(worker, workerStr);
-      workers.emplace_back(idx, workerStr);
-    }
-  }
-  std::string remote_ip = dist_ip_;
-  uint16_t remote_port = dist_port_;
-  if (router_->getCloudSize() > 1) {
-    dst::JobMessage msg(dst::JobMessage::BALANCER),
-        result(dst::JobMessage::NONE);
-    bool ok = dist_->sendJob(msg, dist_ip_.c_str(), dist_port_, result);
-    if (!ok) {
-      logger_->error(utl::DRT, 7461, "Balancer failed");
-    } else {
-      dst::BalancerJobDescription* desc
-          = static_cast<dst::BalancerJobDescription*>(
-              result.getJobDescription());
-      remote_ip = desc->getWorkerIP();
-      remote_port = desc->getWorkerPort();
-    }
-  }
+  // The job goes through the balancer, which picks the worker, tracks its
+  // throughput and streams the partial results back as they complete.
   {
     dst::JobMessage msg(dst::JobMessage::ROUTING),
         result(dst::JobMessage::NONE);
@@ -1490,20 +1822,20 @@ void FlexDR::sendWorkers(
         = std::make_unique<RoutingJobDescription>();
     RoutingJobDescription* rjd
         = static_cast<RoutingJobDescription*>(desc.get());
-    rjd->setWorkers(workers);
+    rjd->setWorkers(std::move(workers));
     rjd->setSharedDir(dist_dir_);
     rjd->setSendEvery(20);
     msg.setJobDescription(std::move(desc));
     ProfileTask task("DIST: SENDJOB");
     bool ok = dist_->sendJobMultiResult(
-        msg, remote_ip.c_str(), remote_port, result);
+        msg, dist_ip_.c_str(), dist_port_, result);
     if (!ok) {
       logger_->error(utl::DRT, 500, "Sending worker {} failed");
     }
     for (const auto& one_desc : result.getAllJobDescriptions()) {
       RoutingJobDescription* result_desc
           = static_cast<RoutingJobDescription*>(one_desc.get());
-      router_->addWorkerResults(result_desc->getWorkers());
+      router_->addWorkerResults(result_desc->releaseWorkers());
     }
   }
 }
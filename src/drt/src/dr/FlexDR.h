@@ -32,7 +32,9 @@
 
 #include <boost/polygon/polygon.hpp>
 #include <boost/serialization/export.hpp>
+#include <chrono>
 #include <deque>
+#include <functional>
 #include <memory>
 
 #include "db/drObj/drMarker.h"
@@ -125,9 +127,7 @@ class FlexDR
     dist_port_ = remote_port;
     dist_dir_ = dir;
   }
-  void sendWorkers(
-      const std::vector<std::pair<int, FlexDRWorker*>>& remote_batch,
-      std::vector<std::unique_ptr<FlexDRWorker>>& batch);
+  void sendWorkers(std::vector<std::pair<int, std::string>> workers);
 
   void reportGuideCoverage();
   void setIter(int iterNum) { iter_ = iterNum; }
@@ -161,10 +161,32 @@ class FlexDR
   float clipSizeInc_;
   int iter_;
 
+  struct WorkerRuntime
+  {
+    Rect routeBox;
+    double seconds;
+  };
+
   // others
   void initFromTA();
   void initGCell2BoundaryPin();
   void getBatchInfo(int& batchStepX, int& batchStepY);
+  void planClips(SearchRepairArgs& args);
+  Rect getClipRouteBox(const Point& clip, int size) const;
+  bool isCleanClip(const Rect& routeBox) const;
+  std::unique_ptr<FlexDRWorker> makeWorker(const SearchRepairArgs& args,
+                                           int iter,
+                                           const Point& clip);
+  void runWorkerGraph(
+      const std::vector<std::vector<std::vector<Point>>>& batches,
+      int offset,
+      int size,
+      const std::function<std::unique_ptr<FlexDRWorker>(const Point&)>&
+          createWorker,
+      const std::function<void(const FlexDRWorker*, double)>& workerDone);
+  void reportWorkerRuntime(int iter,
+                           const std::vector<WorkerRuntime>& runtimes,
+                           double wallTime);
 
   void init_halfViaEncArea();
 
@@ -391,6 +413,10 @@ class FlexDRWorker
   const FlexGridGraph& getGridGraph() const { return gridGraph_; }
   // others
   int main(frDesign* design);
+  // main() split at the point where the worker stops reading the design:
+  // mainInit() reads the design, mainRoute() only touches worker data.
+  void mainInit(frDesign* design);
+  void mainRoute();
   void distributedMain(frDesign* design);
   void writeUpdates(const std::string& file_name);
   void updateDesign(frDesign* design);
@@ -475,6 +501,8 @@ class FlexDRWorker
   bool followGuide_ = false;
   bool needRecheck_ = false;
   bool skipRouting_ = false;
+  std::chrono::high_resolution_clock::time_point mainStart_;
+  std::chrono::high_resolution_clock::time_point initEnd_;
   RipUpMode ripupMode_ = RipUpMode::DRC;
   // drNetOrderingEnum netOrderingMode;
   frUInt4 workerDRCCost_ = 0;
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2024, The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the University nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE REGENTS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dr/FlexDR_scheduler.h"
+
+#include <omp.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "utl/exception.h"
+
+namespace drt {
+
+FlexDRScheduler::FlexDRScheduler(std::vector<std::vector<int>> dependencies,
+                                 bool deterministic)
+    : dependencies_(std::move(dependencies)),
+      deterministic_(deterministic),
+      num_tasks_(dependencies_.size()),
+      dependents_(num_tasks_),
+      pending_deps_(num_tasks_, 0),
+      threshold_(num_tasks_, 0),
+      by_threshold_(num_tasks_),
+      pending_inits_(num_tasks_, 0),
+      routed_(num_tasks_, false)
+{
+  for (int task = 0; task < num_tasks_; task++) {
+    for (const int dep : dependencies_[task]) {
+      dependents_[dep].push_back(task);
+      threshold_[task] = std::max(threshold_[task], dep + 1);
+    }
+    pending_deps_[task] = dependencies_[task].size();
+    by_threshold_[threshold_[task]].push_back(task);
+    pending_inits_[threshold_[task]]++;
+    if (pending_deps_[task] == 0) {
+      ready_.push(task);
+    }
+  }
+}
+
+void FlexDRScheduler::run(int num_threads,
+                          const Phase& init,
+                          const Phase& route,
+                          const Phase& commit)
+{
+  utl::ThreadException exception;
+#pragma omp parallel num_threads(num_threads)
+  {
+    try {
+      execute(init, route, commit);
+    } catch (...) {
+      exception.capture();
+      std::lock_guard<std::mutex> lock(mutex_);
+      failed_ = true;
+      ready_cv_.notify_all();
+    }
+  }
+  exception.rethrow();
+}
+
+void FlexDRScheduler::execute(const Phase& init,
+                              const Phase& route,
+                              const Phase& commit)
+{
+  while (true) {
+    int task;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      ready_cv_.wait(lock, [this] {
+        return !ready_.empty() || num_committed_ == num_tasks_ || failed_;
+      });
+      if (ready_.empty() || failed_) {
+        return;
+      }
+      task = ready_.top();
+      ready_.pop();
+    }
+    {
+      std::shared_lock<std::shared_mutex> design_lock(design_mutex_);
+      init(task);
+    }
+    if (deterministic_) {
+      initDone(task);
+      commitInOrder(commit);
+    }
+    route(task);
+    routeDone(task, commit);
+  }
+}
+
+void FlexDRScheduler::initDone(int task)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  pending_inits_[threshold_[task]]--;
+}
+
+void FlexDRScheduler::routeDone(int task, const Phase& commit)
+{
+  if (deterministic_) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      routed_[task] = true;
+    }
+    commitInOrder(commit);
+    return;
+  }
+  {
+    std::unique_lock<std::shared_mutex> design_lock(design_mutex_);
+    commit(task);
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  num_committed_++;
+  release(task);
+  ready_cv_.notify_all();
+}
+
+// Commits are applied by whichever thread finds the next one eligible; a
+// thread that sees another one committing leaves it to that thread, which
+// re-checks the state after every commit.
+void FlexDRScheduler::commitInOrder(const Phase& commit)
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!committing_ && !failed_ && next_commit_ < num_tasks_
+         && routed_[next_commit_] && pending_inits_[next_commit_] == 0) {
+    committing_ = true;
+    const int task = next_commit_;
+    lock.unlock();
+    {
+      std::unique_lock<std::shared_mutex> design_lock(design_mutex_);
+      commit(task);
+    }
+    lock.lock();
+    committing_ = false;
+    next_commit_++;
+    num_committed_++;
+    if (next_commit_ < num_tasks_) {
+      for (const int released : by_threshold_[next_commit_]) {
+        ready_.push(released);
+      }
+    }
+    ready_cv_.notify_all();
+  }
+}
+
+void FlexDRScheduler::release(int task)
+{
+  for (const int dependent : dependents_[task]) {
+    if (--pending_deps_[dependent] == 0) {
+      ready_.push(dependent);
+    }
+  }
+}
+
+}  // namespace drt
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2024, The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the University nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE REGENTS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <shared_mutex>
+#include <vector>
+
+namespace drt {
+
+// Runs detailed routing workers as a task graph instead of in checkerboard
+// batches separated by barriers.  Each task has three phases:
+//   init   - reads the design (run under a shared lock)
+//   route  - works on worker private data only
+//   commit - writes the results back to the design (run under an exclusive
+//            lock)
+// A task may start once all of its dependencies have committed.
+// Dependencies must point to tasks with a smaller index.
+//
+// In deterministic mode commits happen in task index order and every task
+// observes exactly the commits of tasks [0, 1 + max(dependency)) when it
+// initializes, independent of thread timing.  Otherwise tasks commit as soon
+// as they finish routing.
+class FlexDRScheduler
+{
+ public:
+  using Phase = std::function<void(int)>;
+
+  FlexDRScheduler(std::vector<std::vector<int>> dependencies,
+                  bool deterministic);
+
+  void run(int num_threads,
+           const Phase& init,
+           const Phase& route,
+           const Phase& commit);
+
+ private:
+  void execute(const Phase& init, const Phase& route, const Phase& commit);
+  void initDone(int task);
+  void routeDone(int task, const Phase& commit);
+  void commitInOrder(const Phase& commit);
+  void release(int task);
+
+  const std::vector<std::vector<int>> dependencies_;
+  const bool deterministic_;
+  const int num_tasks_;
+
+  std::vector<std::vector<int>> dependents_;
+  std::vector<int> pending_deps_;
+  // deterministic mode: the number of commits a task must observe, the
+  // tasks released by each commit count and the inits each commit waits on
+  std::vector<int> threshold_;
+  std::vector<std::vector<int>> by_threshold_;
+  std::vector<int> pending_inits_;
+  std::vector<bool> routed_;
+  int next_commit_ = 0;
+  bool committing_ = false;
+
+  std::priority_queue<int, std::vector<int>, std::greater<int>> ready_;
+  int num_committed_ = 0;
+  bool failed_ = false;
+
+  std::mutex mutex_;
+  std::condition_variable ready_cv_;
+  std::shared_mutex design_mutex_;
+};
+
+}  // namespace drt
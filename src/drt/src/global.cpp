@@ -70,6 +70,9 @@ bool CLEAN_PATCHES = false;
 bool DO_PA = true;
 bool SINGLE_STEP_DR = false;
 bool SAVE_GUIDE_UPDATES = false;
+bool DEPENDENCY_SCHEDULING = false;
+bool DETERMINISTIC_DR = true;
+bool ADAPTIVE_CLIPS = false;
 
 std::string VIAINPIN_BOTTOMLAYER_NAME;
 std::string VIAINPIN_TOPLAYER_NAME;
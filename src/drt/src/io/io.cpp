@@ -960,34 +960,39 @@ void io::Parser::updateNetRouting(frNet* netIn, odb::dbNet* net)
 void io::Parser::setNets(odb::dbBlock* block)
 {
   for (auto net : block->getNets()) {
-    bool is_special = net->isSpecial();
-    if (!is_special && net->getSigType().isSupply()) {
-      logger_->error(DRT,
-                     305,
-                     "Net {} of signal type {} is not routable by TritonRoute. "
-                     "Move to special nets.",
-                     net->getName(),
-                     net->getSigType().getString());
-    }
-    std::unique_ptr<frNet> uNetIn = std::make_unique<frNet>(net->getName());
-    auto netIn = uNetIn.get();
-    if (net->getNonDefaultRule()) {
-      uNetIn->updateNondefaultRule(design_->getTech()->getNondefaultRule(
-          net->getNonDefaultRule()->getName()));
-    }
-    if (net->getSigType() == dbSigType::CLOCK) {
-      uNetIn->updateIsClock(true);
-    }
-    if (is_special) {
-      uNetIn->setIsSpecial(true);
-    }
-    updateNetRouting(netIn, net);
-    netIn->setType(net->getSigType());
-    if (is_special) {
-      getBlock()->addSNet(std::move(uNetIn));
-    } else {
-      getBlock()->addNet(std::move(uNetIn));
-    }
+    setNet(net);
+  }
+}
+
+void io::Parser::setNet(odb::dbNet* net)
+{
+  bool is_special = net->isSpecial();
+  if (!is_special && net->getSigType().isSupply()) {
+    logger_->error(DRT,
+                   305,
+                   "Net {} of signal type {} is not routable by TritonRoute. "
+                   "Move to special nets.",
+                   net->getName(),
+                   net->getSigType().getString());
+  }
+  std::unique_ptr<frNet> uNetIn = std::make_unique<frNet>(net->getName());
+  auto netIn = uNetIn.get();
+  if (net->getNonDefaultRule()) {
+    uNetIn->updateNondefaultRule(design_->getTech()->getNondefaultRule(
+        net->getNonDefaultRule()->getName()));
+  }
+  if (net->getSigType() == dbSigType::CLOCK) {
+    uNetIn->updateIsClock(true);
+  }
+  if (is_special) {
+    uNetIn->setIsSpecial(true);
+  }
+  updateNetRouting(netIn, net);
+  netIn->setType(net->getSigType());
+  if (is_special) {
+    getBlock()->addSNet(std::move(uNetIn));
+  } else {
+    getBlock()->addNet(std::move(uNetIn));
   }
 }
 
@@ -3020,26 +3025,84 @@ void io::Parser::readTechAndLibs(odb::dbDatabase* db)
   }
 }
 
-void io::Parser::updateDesign()
+bool io::Parser::updateDesign(const std::set<std::string>& modified_nets,
+                              const std::set<std::string>& created_insts)
 {
   auto block = db_->getChip()->getBlock();
+  auto region_query = design_->getRegionQuery();
   getBlock()->removeDeletedInsts();
-  for (auto db_inst : block->getInsts()) {
-    auto inst = getBlock()->findInst(db_inst->getName());
-    if (inst == nullptr) {
-      setInst(db_inst);
+  for (const auto& name : created_insts) {
+    auto db_inst = block->findInst(name.c_str());
+    if (db_inst == nullptr || getBlock()->findInst(name) != nullptr) {
+      continue;
+    }
+    if (design_->name2master_.find(db_inst->getMaster()->getName())
+        == design_->name2master_.end()) {
+      return false;
     }
+    setInst(db_inst);
+    region_query->addBlockObj(getBlock()->findInst(name));
   }
-  for (auto db_net : block->getNets()) {
-    auto netIn = getBlock()->findNet(db_net->getName());
-    netIn->clearConns();
-    netIn->clearRPins();
-    netIn->clearGuides();
-    netIn->clearOrigGuides();
-    updateNetRouting(netIn, db_net);
+  for (const auto& name : modified_nets) {
+    auto db_net = block->findNet(name.c_str());
+    if (db_net == nullptr) {
+      continue;
+    }
+    auto netIn = getBlock()->findNet(name);
+    if (netIn == nullptr) {
+      if (db_net->isSpecial()) {
+        return false;
+      }
+      setNet(db_net);
+      netIn = getBlock()->findNet(name);
+    } else {
+      if (netIn->isSpecial() != db_net->isSpecial()) {
+        return false;
+      }
+      for (auto instTerm : netIn->getInstTerms()) {
+        instTerm->addToNet(nullptr);
+      }
+      for (auto term : netIn->getBTerms()) {
+        term->addToNet(nullptr);
+      }
+      netIn->clearConns();
+      // Special net shapes are read with the swires and are not changed
+      // here; regular net routing is re-read from the odb wire.
+      if (!netIn->isSpecial()) {
+        for (auto& shape : netIn->getShapes()) {
+          region_query->removeDRObj(shape.get());
+        }
+        for (auto& via : netIn->getVias()) {
+          region_query->removeDRObj(via.get());
+        }
+        for (auto& pwire : netIn->getPatchWires()) {
+          region_query->removeDRObj(pwire.get());
+        }
+        netIn->clearRoutes();
+      }
+      updateNetRouting(netIn, db_net);
+    }
+    if (netIn->isSpecial()) {
+      continue;
+    }
+    for (auto& shape : netIn->getShapes()) {
+      region_query->addDRObj(shape.get());
+    }
+    for (auto& via : netIn->getVias()) {
+      region_query->addDRObj(via.get());
+    }
+    for (auto& pwire : netIn->getPatchWires()) {
+      region_query->addDRObj(pwire.get());
+    }
   }
-  design_->getRegionQuery()->init();
-  design_->getRegionQuery()->initDRObj();
+  // Guides and rpins are rebuilt from scratch by the next guide processing.
+  region_query->clearGuides();
+  for (auto& net : getBlock()->getNets()) {
+    net->clearRPins();
+    net->clearGuides();
+    net->clearOrigGuides();
+  }
+  return true;
 }
 
 frTechObject* io::Writer::getTech() const
@@ -3733,6 +3796,25 @@ void io::Writer::updateDbAccessPoints(odb::dbBlock* block, odb::dbTech* db_tech)
   }
 }
 
+namespace {
+// Keeps the router's own odb writes out of the changes recorded for the
+// next incremental update, until the scope is left in any way.
+class DesignSyncPause
+{
+ public:
+  explicit DesignSyncPause(TritonRoute* router) : router_(router)
+  {
+    router_->setDesignSyncEnabled(false);
+  }
+  ~DesignSyncPause() { router_->setDesignSyncEnabled(true); }
+  DesignSyncPause(const DesignSyncPause&) = delete;
+  DesignSyncPause& operator=(const DesignSyncPause&) = delete;
+
+ private:
+  TritonRoute* router_;
+};
+}  // namespace
+
 void io::Writer::updateDb(odb::dbDatabase* db,
                           bool pin_access_only,
                           bool snapshot)
@@ -3746,6 +3828,7 @@ void io::Writer::updateDb(odb::dbDatabase* db,
   if (block == nullptr || db_tech == nullptr) {
     logger_->error(DRT, 4, "Load design first.");
   }
+  DesignSyncPause sync_pause(router_);
   updateDbAccessPoints(block, db_tech);
   if (!pin_access_only) {
     for (auto net : block->getNets()) {
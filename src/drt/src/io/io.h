@@ -31,6 +31,8 @@
 #include <boost/icl/interval_set.hpp>
 #include <list>
 #include <memory>
+#include <set>
+#include <string>
 
 #include "frDesign.h"
 
@@ -87,7 +89,11 @@ class Parser
   {
     return prefTrackPatterns_;
   }
-  void updateDesign();
+  // Applies the odb changes recorded since the design was read. Returns
+  // false if they can't be applied incrementally and the design must be
+  // read again.
+  bool updateDesign(const std::set<std::string>& modified_nets,
+                    const std::set<std::string>& created_insts);
 
  private:
   frBlock* getBlock() const { return design_->getTopBlock(); }
@@ -108,6 +114,7 @@ class Parser
   void setVias(odb::dbBlock*);
   void updateNetRouting(frNet*, odb::dbNet*);
   void setNets(odb::dbBlock*);
+  void setNet(odb::dbNet*);
   void setAccessPoints(odb::dbDatabase*);
   void getSBoxCoords(odb::dbSBox*,
                      frCoord&,
@@ -0,0 +1,72 @@
+# check_drc after an ECO matches a check_drc of the same design read fresh
+source "helpers.tcl"
+read_lef Nangate45/Nangate45_tech.lef
+read_lef Nangate45/Nangate45_stdcell.lef
+read_def drc_test.def
+
+# The violations as a sorted list, with the sources of each one sorted,
+# as the report order depends on the order of the nets in the design
+proc read_violations { drc_file } {
+  set stream [open $drc_file r]
+  set violations {}
+  set violation {}
+  foreach line [split [read $stream] "\n"] {
+    set line [string trim $line]
+    if { [string match "violation type:*" $line] } {
+      if { $violation != {} } {
+        lappend violations $violation
+      }
+      set violation [list $line]
+    } elseif { [string match "srcs:*" $line] } {
+      lappend violation [lsort [lrange $line 1 end]]
+    } elseif { $line != "" } {
+      lappend violation $line
+    }
+  }
+  if { $violation != {} } {
+    lappend violations $violation
+  }
+  close $stream
+  return [lsort $violations]
+}
+
+# Runs check_drc on the current design and in a new process on the
+# design written to DEF, and returns whether they find the same
+proc check_against_fresh { name } {
+  set eco_drc [make_result_file drc_eco_$name.drc]
+  drt::check_drc -output_file $eco_drc
+
+  set eco_def [make_result_file drc_eco_$name.def]
+  write_def $eco_def
+
+  set fresh_drc [make_result_file drc_eco_${name}_fresh.drc]
+  set fresh_script [make_result_file drc_eco_${name}_fresh.tcl]
+  set stream [open $fresh_script w]
+  puts $stream "read_lef Nangate45/Nangate45_tech.lef"
+  puts $stream "read_lef Nangate45/Nangate45_stdcell.lef"
+  puts $stream "read_def $eco_def"
+  puts $stream "drt::check_drc -output_file $fresh_drc"
+  close $stream
+  exec [info nameofexecutable] -no_init -no_splash -exit $fresh_script
+
+  return [expr { [read_violations $eco_drc] == [read_violations $fresh_drc] }]
+}
+
+drt::check_drc -output_file [make_result_file drc_eco_before.drc]
+
+set block [ord::get_db_block]
+# changes applied incrementally: move an instance and remove the routing
+# of a net
+set inst [$block findInst _504_]
+lassign [$inst getLocation] x y
+$inst setLocation [expr $x + 380] $y
+odb::dbWire_destroy [[$block findNet _001_] getWire]
+check "same violations after an ECO" { check_against_fresh eco } 1
+
+# changes without odb callbacks
+set net [$block findNet _002_]
+$net rename eco_net
+$net setSigType CLOCK
+check "same violations after a rename" { check_against_fresh rename } 1
+
+exit_summary
@@ -0,0 +1,19 @@
+# detailed_route -non_deterministic must finish with a clean route
+source "helpers.tcl"
+read_lef "sky130hd/sky130hd.tlef"
+read_lef "sky130hd/sky130hd_std_cell.lef"
+read_def "gcd_sky130hd.def"
+read_guides "gcd_sky130hd.guide"
+
+set drc_file [make_result_file non_deterministic.drc]
+
+set_thread_count 4
+detailed_route -bottom_routing_layer met1 -top_routing_layer met5 \
+  -output_drc $drc_file -non_deterministic -verbose 0
+
+set stream [open $drc_file r]
+set violations [regexp -all "violation type" [read $stream]]
+close $stream
+
+check "no violations" { set violations } 0
+exit_summary
@@ -14,5 +14,10 @@ record_tests {
   #drt_readme_msgs_check
 }
 record_pass_fail_tests {
+  adaptive_clips
+  dependency_scheduling
+  drc_eco
   gc_test
+  non_deterministic
+  route_eco
 }
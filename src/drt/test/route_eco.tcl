@@ -0,0 +1,55 @@
+# detailed_route after an ECO on a routed design reuses the design kept
+# from the first detailed_route and must match a design read fresh
+source "helpers.tcl"
+read_lef "sky130hd/sky130hd.tlef"
+read_lef "sky130hd/sky130hd_std_cell.lef"
+read_def "gcd_sky130hd.def"
+read_guides "gcd_sky130hd.guide"
+
+proc count_violations { drc_file } {
+  set stream [open $drc_file r]
+  set violations [regexp -all "violation type" [read $stream]]
+  close $stream
+  return $violations
+}
+
+detailed_route -bottom_routing_layer met1 -top_routing_layer met5 \
+  -verbose 0
+
+# ECO: remove the routing of a net and route it again
+set block [ord::get_db_block]
+set net [$block findNet clknet_2_0__leaf_clk]
+odb::dbWire_destroy [$net getWire]
+
+# check_drc keeps the gcell patterns of the first detailed_route rather
+# than processing the guides again
+set open_drc [make_result_file route_eco_open.drc]
+drt::check_drc -output_file $open_drc
+check "no violations with the net unrouted" { count_violations $open_drc } 0
+
+set drc_file [make_result_file route_eco.drc]
+detailed_route -bottom_routing_layer met1 -top_routing_layer met5 \
+  -output_drc $drc_file -verbose 0
+check "net routed again" { expr { [$net getWire] != "NULL" } } 1
+check "no violations after the ECO route" { count_violations $drc_file } 0
+
+set eco_drc [make_result_file route_eco_kept.drc]
+drt::check_drc -output_file $eco_drc
+check "no violations with the kept design" { count_violations $eco_drc } 0
+
+# check_drc in a new process on the design written to DEF
+set eco_def [make_result_file route_eco.def]
+write_def $eco_def
+set fresh_drc [make_result_file route_eco_fresh.drc]
+set fresh_script [make_result_file route_eco_fresh.tcl]
+set stream [open $fresh_script w]
+puts $stream "read_lef sky130hd/sky130hd.tlef"
+puts $stream "read_lef sky130hd/sky130hd_std_cell.lef"
+puts $stream "read_def $eco_def"
+puts $stream "read_guides gcd_sky130hd.guide"
+puts $stream "drt::check_drc -output_file $fresh_drc"
+close $stream
+exec [info nameofexecutable] -no_init -no_splash -exit $fresh_script
+check "no violations with a fresh design" { count_violations $fresh_drc } 0
+
+exit_summary
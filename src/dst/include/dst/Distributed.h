@@ -81,6 +81,7 @@ class Distributed
     {
     }
   };
+  bool readMultiMsg(socket& sock, JobMessage& result, std::string& errorMsg);
   utl::Logger* logger_;
   std::vector<EndPoint> end_points_;
   std::vector<JobCallBack*> callbacks_;
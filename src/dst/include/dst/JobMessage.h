@@ -28,6 +28,7 @@
 
 #pragma once
 #include <memory>
+#include <streambuf>
 #include <string>
 #include <vector>
 
@@ -117,6 +118,9 @@ class JobMessage
   static bool serializeMsg(SerializeType type,
                            JobMessage& msg,
                            std::string& str);
+  // Decodes one message straight from a socket buffer without copying it
+  // into a string first. The EOP trailer is left in the buffer.
+  static bool deserializeMsg(JobMessage& msg, std::streambuf& buf);
   friend class dst::Distributed;
   friend class dst::WorkerConnection;
   friend class dst::BalancerConnection;
@@ -30,14 +30,19 @@
 
 #include <dst/JobMessage.h>
 
-#include <boost/archive/text_iarchive.hpp>
-#include <boost/archive/text_oarchive.hpp>
+#include <algorithm>
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
 #include <boost/asio/post.hpp>
 #include <boost/bind/bind.hpp>
 #include <boost/serialization/export.hpp>
 #include <boost/thread/thread.hpp>
+#include <chrono>
+#include <functional>
+#include <memory>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 #include "LoadBalancer.h"
 #include "dst/BalancerJobDescription.h"
@@ -50,6 +55,213 @@ using namespace dst;
 BOOST_CLASS_EXPORT(dst::BalancerJobDescription)
 BOOST_CLASS_EXPORT(dst::BroadcastJobDescription)
 
+namespace {
+// Size of the chunks in which worker replies are forwarded to the leader.
+constexpr std::size_t relay_chunk_size = 64 * 1024;
+// A job that has not produced any reply after straggler_factor times its
+// expected runtime is duplicated on an idle worker.
+constexpr double straggler_factor = 2.0;
+constexpr double min_straggler_seconds = 5.0;
+
+struct RelayAttempt
+{
+  RelayAttempt(asio::io_service& service,
+               const ip::address& ip_in,
+               unsigned short port_in)
+      : socket(service),
+        ip(ip_in),
+        port(port_in),
+        start(std::chrono::steady_clock::now()),
+        buffer(relay_chunk_size)
+  {
+  }
+  tcp::socket socket;
+  ip::address ip;
+  unsigned short port;
+  std::chrono::steady_clock::time_point start;
+  std::vector<char> buffer;
+  bool live = true;
+};
+}  // namespace
+
+// Sends a unicast job to a worker and streams the worker's replies back to
+// the leader as they arrive. A job whose worker stays silent for too long is
+// re-issued on an idle worker and the first one to answer is kept. Returns
+// false if the job failed before anything was forwarded. A worker failing
+// after that resets the leader connection instead.
+bool BalancerConnection::relayJob(const std::string& data,
+                                  ip::address worker_address,
+                                  unsigned short worker_port)
+{
+  asio::io_service service;
+  asio::steady_timer straggler_timer(service);
+  std::vector<std::unique_ptr<RelayAttempt>> attempts;
+  RelayAttempt* winner = nullptr;
+  bool forwarded = false;
+  int failed_workers_trials = 0;
+  const uint64_t job_bytes = data.size();
+  boost::system::error_code client_error;
+
+  auto is_live = [&attempts]() {
+    return std::any_of(attempts.begin(), attempts.end(), [](const auto& a) {
+      return a->live;
+    });
+  };
+  auto finish = [&](RelayAttempt* attempt, bool success) {
+    attempt->live = false;
+    attempt->socket.close();
+    if (success) {
+      const std::chrono::duration<double> seconds
+          = std::chrono::steady_clock::now() - attempt->start;
+      owner_->jobFinished(
+          attempt->ip, attempt->port, job_bytes, seconds.count());
+    } else {
+      owner_->punishWorker(attempt->ip, attempt->port);
+    }
+  };
+  auto pick_winner = [&](RelayAttempt* attempt) {
+    winner = attempt;
+    straggler_timer.cancel();
+    for (auto& other : attempts) {
+      if (other.get() != attempt && other->live) {
+        other->live = false;
+        other->socket.close();
+        owner_->updateWorker(other->ip, other->port);
+      }
+    }
+  };
+
+  std::function<void(RelayAttempt*)> read_next;
+  auto connect = [&](const ip::address& address, unsigned short port) {
+    auto attempt = std::make_unique<RelayAttempt>(service, address, port);
+    try {
+      attempt->socket.connect(tcp::endpoint(address, port));
+      asio::write(attempt->socket, asio::buffer(data));
+    } catch (std::exception const& ex) {
+      logger_->warn(utl::DST,
+                    204,
+                    "Exception thrown: {}. worker with ip \"{}\" and "
+                    "port \"{}\" will be pushed back the queue.",
+                    ex.what(),
+                    address,
+                    port);
+      owner_->punishWorker(address, port);
+      return false;
+    }
+    read_next(attempt.get());
+    attempts.push_back(std::move(attempt));
+    return true;
+  };
+  // Tries workers until one accepts the job or too many have failed.
+  auto launch = [&](ip::address address, unsigned short port) {
+    while (!address.is_unspecified()) {
+      if (connect(address, port)) {
+        return true;
+      }
+      if (++failed_workers_trials == MAX_FAILED_WORKERS_TRIALS) {
+        logger_->warn(utl::DST,
+                      205,
+                      "Maximum of {} failing workers reached, "
+                      "relaying error to leader.",
+                      failed_workers_trials);
+        return false;
+      }
+      address = ip::address();
+      owner_->getNextWorker(address, port, job_bytes);
+    }
+    return false;
+  };
+
+  read_next = [&](RelayAttempt* attempt) {
+    attempt->socket.async_read_some(
+        asio::buffer(attempt->buffer),
+        [&, attempt](const boost::system::error_code& ec, std::size_t bytes) {
+          if (!attempt->live) {
+            return;
+          }
+          if (winner == nullptr && (bytes > 0 || ec == asio::error::eof)) {
+            pick_winner(attempt);
+          }
+          if (winner == attempt) {
+            if (bytes > 0) {
+              asio::write(sock_,
+                          asio::buffer(attempt->buffer.data(), bytes),
+                          client_error);
+              forwarded = true;
+            }
+            if (!ec && !client_error) {
+              read_next(attempt);
+              return;
+            }
+            const bool success = ec == asio::error::eof && !client_error;
+            if (!success && forwarded && !client_error) {
+              // Part of the reply is already with the leader. Reset its
+              // connection so it sees an error, not a short reply.
+              logger_->warn(utl::DST,
+                            206,
+                            "Worker with ip \"{}\" and port \"{}\" failed "
+                            "mid-reply, aborting the job.",
+                            attempt->ip,
+                            attempt->port);
+              boost::system::error_code ignored;
+              sock_.set_option(tcp::socket::linger(true, 0), ignored);
+              sock_.close(ignored);
+            }
+            finish(attempt, success);
+            return;
+          }
+          // This worker failed before sending anything.
+          finish(attempt, false);
+          if (winner == nullptr && !is_live()
+              && ++failed_workers_trials < MAX_FAILED_WORKERS_TRIALS) {
+            ip::address address;
+            unsigned short port = 0;
+            owner_->getNextWorker(address, port, job_bytes);
+            launch(address, port);
+          }
+          if (!is_live()) {
+            straggler_timer.cancel();
+          }
+        });
+  };
+
+  if (!launch(worker_address, worker_port)) {
+    return false;
+  }
+  const RelayAttempt* primary = attempts.back().get();
+  const double expected
+      = owner_->estimateJobSeconds(primary->ip, primary->port, job_bytes);
+  if (expected > 0) {
+    const std::chrono::duration<double> timeout(
+        std::max(min_straggler_seconds, straggler_factor * expected));
+    straggler_timer.expires_after(
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            timeout));
+    straggler_timer.async_wait([&](const boost::system::error_code& ec) {
+      if (ec || winner != nullptr || !is_live()) {
+        return;
+      }
+      ip::address address;
+      unsigned short port = 0;
+      if (owner_->getSpeculativeWorker(
+              primary->ip, primary->port, job_bytes, address, port)) {
+        debugPrint(logger_,
+                   utl::DST,
+                   "load_balancer",
+                   1,
+                   "Re-issuing straggling job from {}/{} on {}/{}.",
+                   primary->ip,
+                   primary->port,
+                   address,
+                   port);
+        connect(address, port);
+      }
+    });
+  }
+  service.run();
+  return winner != nullptr || forwarded;
+}
+
 BalancerConnection::BalancerConnection(asio::io_service& io_service,
                                        LoadBalancer* owner,
                                        utl::Logger* logger)
@@ -86,8 +298,8 @@ void BalancerConnection::handle_read(boost::system::error_code const& err,
     if (!JobMessage::serializeMsg(JobMessage::READ, msg, data)) {
       logger_->warn(utl::DST,
                     42,
-                    "Received malformed msg {} from port {}",
-                    data,
+                    "Received malformed msg of {} bytes from port {}",
+                    data.size(),
                     sock_.remote_endpoint().port());
       asio::write(sock_, asio::buffer("0"), error);
       sock_.close();
@@ -97,7 +309,8 @@ void BalancerConnection::handle_read(boost::system::error_code const& err,
       case JobMessage::UNICAST: {
         ip::address workerAddress;
         unsigned short port;
-        owner_->getNextWorker(workerAddress, port);
+        const bool relayed = msg.getJobType() != JobMessage::BALANCER;
+        owner_->getNextWorker(workerAddress, port, relayed ? data.size() : 0);
         if (workerAddress.is_unspecified()) {
           logger_->warn(utl::DST, 6, "No workers available");
           sock_.close();
@@ -112,55 +325,11 @@ void BalancerConnection::handle_read(boost::system::error_code const& err,
             owner_->dist_->sendResult(reply, sock_);
             sock_.close();
           } else {
-            asio::io_service io_service;
-            tcp::socket socket(io_service);
-            int failed_workers_trials = 0;
-            asio::streambuf receive_buffer;
-            bool failure = true;
-            while (failure) {
-              try {
-                socket.connect(tcp::endpoint(workerAddress, port));
-                asio::write(socket, in_packet_);
-                asio::read(socket, receive_buffer, asio::transfer_all());
-                failure = false;
-              } catch (std::exception const& ex) {
-                if (socket.is_open()) {
-                  socket.close();
-                }
-                if (std::string(ex.what()).find("read: End of file")
-                    != std::string::npos) {
-                  // Since asio::transfer_all() used with a stream buffer it
-                  // always reach an eof file exception!
-                  failure = false;
-                  break;
-                }
-                logger_->warn(utl::DST,
-                              204,
-                              "Exception thrown: {}. worker with ip \"{}\" and "
-                              "port \"{}\" will be pushed back the queue.",
-                              ex.what(),
-                              workerAddress,
-                              port);
-                owner_->punishWorker(workerAddress, port);
-                failed_workers_trials++;
-                if (failed_workers_trials == MAX_FAILED_WORKERS_TRIALS) {
-                  logger_->warn(utl::DST,
-                                205,
-                                "Maximum of {} failing workers reached, "
-                                "relaying error to leader.",
-                                failed_workers_trials);
-                  break;
-                }
-                owner_->getNextWorker(workerAddress, port);
-              }
-            }
-            if (failure) {
+            if (!relayJob(data, workerAddress, port)) {
               JobMessage result(JobMessage::ERROR);
               std::string msgStr;
               JobMessage::serializeMsg(JobMessage::WRITE, result, msgStr);
               asio::write(sock_, asio::buffer(msgStr), error);
-            } else {
-              asio::write(sock_, receive_buffer, error);
             }
             sock_.close();
           }
@@ -171,12 +340,9 @@ void BalancerConnection::handle_read(boost::system::error_code const& err,
         std::lock_guard<std::mutex> lock(owner_->workers_mutex_);
         owner_->broadcastData.push_back(data);
         asio::thread_pool pool(owner_->workers_.size());
-        auto workers_copy = owner_->workers_;
         std::mutex broadcast_failure_mutex;
         std::vector<std::pair<ip::address, unsigned short>> failed_workers;
-        while (!workers_copy.empty()) {
-          auto worker = workers_copy.top();
-          workers_copy.pop();
+        for (const auto& worker : owner_->workers_) {
           asio::post(
               pool,
               [worker, data, &failed_workers, &broadcast_failure_mutex]() {
@@ -30,6 +30,7 @@
 #include <boost/asio.hpp>
 #include <boost/enable_shared_from_this.hpp>
 #include <boost/make_shared.hpp>
+#include <string>
 
 namespace asio = boost::asio;
 namespace ip = asio::ip;
@@ -62,6 +63,10 @@ class BalancerConnection
   LoadBalancer* getOwner() const { return owner_; }
 
  private:
+  bool relayJob(const std::string& data,
+                ip::address worker_address,
+                unsigned short worker_port);
+
   tcp::socket sock_;
   asio::streambuf in_packet_;
   utl::Logger* logger_;
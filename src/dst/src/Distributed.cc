@@ -32,6 +32,8 @@
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/system/system_error.hpp>
 #include <boost/thread/thread.hpp>
+#include <memory>
+#include <vector>
 
 #include "LoadBalancer.h"
 #include "Worker.h"
@@ -203,17 +205,49 @@ bool Distributed::sendJob(JobMessage& msg,
   return false;
 }
 
-inline bool getNextMsg(std::string& haystack,
-                       const std::string& needle,
-                       std::string& result)
+// Reads the stream of replies to a multi-result job. Each reply is decoded
+// from the socket buffer as soon as its EOP arrives, while the remote side
+// is still sending the rest.
+bool Distributed::readMultiMsg(dst::socket& sock,
+                               JobMessage& result,
+                               std::string& errorMsg)
 {
-  std::size_t found = haystack.find(needle);
-  if (found != std::string::npos) {
-    result = haystack.substr(0, found + needle.size());
-    haystack.erase(0, found + needle.size());
-    return true;
+  asio::streambuf receive_buffer;
+  const std::string eop = JobMessage::EOP;
+  // Kept aside until the whole reply is read so that a failed try adds
+  // nothing to the result.
+  std::vector<std::unique_ptr<JobDescription>> received;
+  sock.wait(asio::ip::tcp::socket::wait_read);
+  while (true) {
+    boost::system::error_code error;
+    const std::size_t bytes
+        = asio::read_until(sock, receive_buffer, eop, error);
+    if (error == asio::error::eof) {
+      break;
+    }
+    if (error) {
+      errorMsg = error.message();
+      return false;
+    }
+    const std::size_t before = receive_buffer.size();
+    JobMessage tmp;
+    if (!JobMessage::deserializeMsg(tmp, receive_buffer)) {
+      logger_->error(
+          utl::DST, 9999, "Problem in deserialize of {} bytes", bytes);
+    }
+    const std::size_t consumed = before - receive_buffer.size();
+    if (consumed < bytes) {
+      receive_buffer.consume(bytes - consumed);
+    }
+    received.push_back(std::move(tmp.getJobDescriptionRef()));
   }
-  return false;
+  if (received.empty()) {
+    return false;
+  }
+  for (auto& desc : received) {
+    result.addJobDescription(std::move(desc));
+  }
+  return true;
 }
 bool Distributed::sendJobMultiResult(JobMessage& msg,
                                      const char* ip,
@@ -245,19 +279,10 @@ bool Distributed::sendJobMultiResult(JobMessage& msg,
     if (!ok) {
       continue;
     }
-    ok = readMsg(sock, resultStr);
+    ok = readMultiMsg(sock, result, resultStr);
     if (!ok) {
       continue;
     }
-    std::string split;
-    while (getNextMsg(resultStr, JobMessage::EOP, split)) {
-      JobMessage tmp;
-      if (!JobMessage::serializeMsg(JobMessage::READ, tmp, split)) {
-        logger_->error(utl::DST, 9999, "Problem in deserialize {}", split);
-      } else {
-        result.addJobDescription(std::move(tmp.getJobDescriptionRef()));
-      }
-    }
     result.setJobType(JobMessage::SUCCESS);
     if (sock.is_open()) {
       sock.close();
@@ -28,11 +28,12 @@
 
 #include "dst/JobMessage.h"
 
-#include <boost/archive/text_iarchive.hpp>
-#include <boost/archive/text_oarchive.hpp>
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
 #include <boost/serialization/access.hpp>
 #include <boost/serialization/unique_ptr.hpp>
 #include <sstream>
+#include <streambuf>
 
 #include "dst/BalancerJobDescription.h"
 
@@ -62,8 +63,8 @@ bool JobMessage::serializeMsg(SerializeType type,
 {
   if (type == WRITE) {
     try {
-      std::ostringstream oarchive_stream;
-      boost::archive::text_oarchive archive(oarchive_stream);
+      std::ostringstream oarchive_stream(std::ios_base::binary);
+      boost::archive::binary_oarchive archive(oarchive_stream);
       archive << msg;
       str = oarchive_stream.str();
     } catch (const boost::archive::archive_exception& e) {
@@ -71,12 +72,23 @@ bool JobMessage::serializeMsg(SerializeType type,
     }
   } else {
     try {
-      std::istringstream iarchive_stream(str);
-      boost::archive::text_iarchive archive(iarchive_stream);
+      std::istringstream iarchive_stream(str, std::ios_base::binary);
+      boost::archive::binary_iarchive archive(iarchive_stream);
       archive >> msg;
     } catch (const boost::archive::archive_exception& e) {
       return false;
     }
   }
   return true;
+}
+
+bool JobMessage::deserializeMsg(JobMessage& msg, std::streambuf& buf)
+{
+  try {
+    boost::archive::binary_iarchive archive(buf);
+    archive >> msg;
+  } catch (const boost::archive::archive_exception& e) {
+    return false;
+  }
+  return true;
 }
\ No newline at end of file
@@ -28,8 +28,10 @@
 
 #include "LoadBalancer.h"
 
+#include <algorithm>
 #include <boost/bind/bind.hpp>
 #include <boost/thread/thread.hpp>
+#include <limits>
 
 #include "utl/Logger.h"
 
@@ -41,14 +43,13 @@ void LoadBalancer::start_accept()
 {
   if (jobs_ != 0 && jobs_ % 100 == 0) {
     logger_->info(utl::DST, 7, "Processed {} jobs", jobs_);
-    auto copy = workers_;
-    while (!copy.empty()) {
-      auto worker = copy.top();
-      logger_->report("Worker {}/{} handled {} jobs",
+    std::lock_guard<std::mutex> lock(workers_mutex_);
+    for (const auto& worker : workers_) {
+      logger_->report("Worker {}/{} handled {} jobs, {} in flight",
                       worker.ip,
                       worker.port,
-                      worker.priority);
-      copy.pop();
+                      worker.completed,
+                      worker.in_flight);
     }
   }
   jobs_++;
@@ -114,52 +115,168 @@ bool LoadBalancer::addWorker(const std::string& ip, unsigned short port)
     }
   }
   if (validWorkerState) {
-    workers_.push(worker(ip::address::from_string(ip), port, 0));
+    workers_.emplace_back(ip::address::from_string(ip), port);
   }
   return validWorkerState;
 }
+
+LoadBalancer::worker* LoadBalancer::findWorker(const ip::address& ip,
+                                               unsigned short port)
+{
+  for (auto& w : workers_) {
+    if (w.ip == ip && w.port == port) {
+      return &w;
+    }
+  }
+  return nullptr;
+}
+
+uint64_t LoadBalancer::jobSize(uint64_t job_bytes) const
+{
+  if (job_bytes != 0) {
+    return job_bytes;
+  }
+  return std::max<uint64_t>(avg_job_bytes_, 1);
+}
+
+double LoadBalancer::secondsPerByte(const worker& w) const
+{
+  if (w.seconds_per_byte > 0) {
+    return w.seconds_per_byte;
+  }
+  if (avg_seconds_per_byte_ > 0) {
+    return avg_seconds_per_byte_;
+  }
+  return 1.0;
+}
+
+// Time until the worker would be done with its queue plus the new job.
+double LoadBalancer::estimateFinish(const worker& w, uint64_t job_bytes) const
+{
+  const double bytes = w.in_flight_bytes + jobSize(job_bytes);
+  return bytes * secondsPerByte(w) * (1 + w.penalty);
+}
+
+void LoadBalancer::releaseJob(worker& w, uint64_t job_bytes)
+{
+  if (w.in_flight == 0) {
+    return;
+  }
+  const uint64_t bytes = job_bytes != 0 ? job_bytes
+                                        : w.in_flight_bytes / w.in_flight;
+  w.in_flight_bytes -= std::min(bytes, w.in_flight_bytes);
+  if (--w.in_flight == 0) {
+    w.in_flight_bytes = 0;
+  }
+}
+
 void LoadBalancer::updateWorker(const ip::address& ip, unsigned short port)
 {
   std::lock_guard<std::mutex> lock(workers_mutex_);
-  std::priority_queue<worker, std::vector<worker>, CompareWorker> newQueue;
-  while (!workers_.empty()) {
-    auto worker = workers_.top();
-    workers_.pop();
-    if (worker.ip == ip && worker.port == port) {
-      worker.priority--;
+  if (worker* w = findWorker(ip, port)) {
+    releaseJob(*w, 0);
+  }
+}
+
+void LoadBalancer::getNextWorker(ip::address& ip,
+                                 unsigned short& port,
+                                 uint64_t job_bytes)
+{
+  std::lock_guard<std::mutex> lock(workers_mutex_);
+  worker* best = nullptr;
+  double best_finish = std::numeric_limits<double>::max();
+  for (auto& w : workers_) {
+    const double finish = estimateFinish(w, job_bytes);
+    if (finish < best_finish) {
+      best = &w;
+      best_finish = finish;
     }
-    newQueue.push(worker);
   }
-  workers_.swap(newQueue);
+  if (best != nullptr) {
+    ip = best->ip;
+    port = best->port;
+    best->in_flight++;
+    best->in_flight_bytes += jobSize(job_bytes);
+  }
 }
-void LoadBalancer::getNextWorker(ip::address& ip, unsigned short& port)
+
+bool LoadBalancer::getSpeculativeWorker(const ip::address& busy_ip,
+                                        unsigned short busy_port,
+                                        uint64_t job_bytes,
+                                        ip::address& ip,
+                                        unsigned short& port)
 {
   std::lock_guard<std::mutex> lock(workers_mutex_);
-  if (!workers_.empty()) {
-    worker w = workers_.top();
-    workers_.pop();
-    ip = w.ip;
-    port = w.port;
-    if (w.priority != std::numeric_limits<unsigned short>::max()) {
-      w.priority++;
+  worker* best = nullptr;
+  double best_finish = std::numeric_limits<double>::max();
+  for (auto& w : workers_) {
+    if (w.in_flight != 0 || (w.ip == busy_ip && w.port == busy_port)) {
+      continue;
+    }
+    const double finish = estimateFinish(w, job_bytes);
+    if (finish < best_finish) {
+      best = &w;
+      best_finish = finish;
     }
-    workers_.push(w);
   }
+  if (best == nullptr) {
+    return false;
+  }
+  ip = best->ip;
+  port = best->port;
+  best->in_flight++;
+  best->in_flight_bytes += jobSize(job_bytes);
+  return true;
+}
+
+void LoadBalancer::jobFinished(const ip::address& ip,
+                               unsigned short port,
+                               uint64_t job_bytes,
+                               double seconds)
+{
+  std::lock_guard<std::mutex> lock(workers_mutex_);
+  worker* w = findWorker(ip, port);
+  if (w == nullptr) {
+    return;
+  }
+  releaseJob(*w, job_bytes);
+  w->completed++;
+  w->penalty /= 2;
+  if (job_bytes == 0 || seconds <= 0) {
+    return;
+  }
+  auto blend = [](double avg, double sample) {
+    return avg == 0 ? sample
+                    : (1 - kHistoryWeight) * avg + kHistoryWeight * sample;
+  };
+  const double sample = seconds / job_bytes;
+  w->seconds_per_byte = blend(w->seconds_per_byte, sample);
+  avg_seconds_per_byte_ = blend(avg_seconds_per_byte_, sample);
+  avg_job_bytes_ = blend(avg_job_bytes_, job_bytes);
+}
+
+double LoadBalancer::estimateJobSeconds(const ip::address& ip,
+                                        unsigned short port,
+                                        uint64_t job_bytes)
+{
+  std::lock_guard<std::mutex> lock(workers_mutex_);
+  worker* w = findWorker(ip, port);
+  if (w == nullptr) {
+    return 0;
+  }
+  const double seconds_per_byte = w->seconds_per_byte > 0
+                                      ? w->seconds_per_byte
+                                      : avg_seconds_per_byte_;
+  return jobSize(job_bytes) * seconds_per_byte;
 }
 
 void LoadBalancer::punishWorker(const ip::address& ip, unsigned short port)
 {
   std::lock_guard<std::mutex> lock(workers_mutex_);
-  std::priority_queue<worker, std::vector<worker>, CompareWorker> newQueue;
-  while (!workers_.empty()) {
-    auto worker = workers_.top();
-    workers_.pop();
-    if (worker.ip == ip && worker.port == port) {
-      worker.priority = worker.priority == 0 ? 2 : worker.priority * 2;
-    }
-    newQueue.push(worker);
+  if (worker* w = findWorker(ip, port)) {
+    releaseJob(*w, 0);
+    w->penalty = w->penalty == 0 ? 1 : std::min(w->penalty * 2, 1024u);
   }
-  workers_.swap(newQueue);
 }
 
 void LoadBalancer::removeWorker(const ip::address& ip,
@@ -169,16 +286,12 @@ void LoadBalancer::removeWorker(const ip::address& ip,
   if (lock) {
     workers_mutex_.lock();
   }
-  std::priority_queue<worker, std::vector<worker>, CompareWorker> newQueue;
-  while (!workers_.empty()) {
-    auto worker = workers_.top();
-    workers_.pop();
-    if (worker.ip == ip && worker.port == port) {
-      continue;
-    }
-    newQueue.push(worker);
-  }
-  workers_.swap(newQueue);
+  workers_.erase(std::remove_if(workers_.begin(),
+                                workers_.end(),
+                                [&](const worker& w) {
+                                  return w.ip == ip && w.port == port;
+                                }),
+                 workers_.end());
   if (lock) {
     workers_mutex_.unlock();
   }
@@ -206,7 +319,7 @@ void LoadBalancer::lookUpWorkers(const char* domain, unsigned short port)
     int new_workers_count = 0;
     udp::resolver::iterator it_end;
     for (; it != it_end; ++it) {
-      auto discovered_worker = worker(it->endpoint().address(), port, 0);
+      auto discovered_worker = worker(it->endpoint().address(), port);
       if (std::find(workers_set.begin(), workers_set.end(), discovered_worker)
           == workers_set.end()) {
         workers_set.push_back(discovered_worker);
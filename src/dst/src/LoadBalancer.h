@@ -33,7 +33,6 @@
 #include <boost/thread/thread.hpp>
 #include <cstdint>
 #include <mutex>
-#include <queue>
 #include <vector>
 
 #include "BalancerConnection.h"
@@ -58,8 +57,30 @@ class LoadBalancer
                unsigned short port = 1234);
   ~LoadBalancer();
   bool addWorker(const std::string& ip, unsigned short port);
+  // Releases one in-flight job of the worker without recording its runtime.
   void updateWorker(const ip::address& ip, unsigned short port);
-  void getNextWorker(ip::address& ip, unsigned short& port);
+  // Picks the worker with the earliest estimated finish time for a job of
+  // job_bytes bytes (0 if the size is unknown) and counts the job against it.
+  void getNextWorker(ip::address& ip,
+                     unsigned short& port,
+                     uint64_t job_bytes = 0);
+  // Like getNextWorker but only considers idle workers other than the given
+  // one. Returns false if there is none.
+  bool getSpeculativeWorker(const ip::address& busy_ip,
+                            unsigned short busy_port,
+                            uint64_t job_bytes,
+                            ip::address& ip,
+                            unsigned short& port);
+  // Releases one in-flight job of the worker and folds its runtime into the
+  // worker's throughput estimate.
+  void jobFinished(const ip::address& ip,
+                   unsigned short port,
+                   uint64_t job_bytes,
+                   double seconds);
+  // Expected runtime of a job on the worker, 0 while nothing is known.
+  double estimateJobSeconds(const ip::address& ip,
+                            unsigned short port,
+                            uint64_t job_bytes);
   void removeWorker(const ip::address& ip,
                     unsigned short port,
                     bool lock = true);
@@ -70,30 +91,42 @@ class LoadBalancer
   {
     ip::address ip;
     unsigned short port;
-    unsigned short priority;
-    worker(ip::address ipIn, unsigned short portIn, unsigned short priorityIn)
-        : ip(ipIn), port(portIn), priority(priorityIn)
+    // Jobs handed out and not reported back yet, and their total size.
+    unsigned int in_flight = 0;
+    uint64_t in_flight_bytes = 0;
+    // Multiplies the estimated cost; doubled on failure, halved on success.
+    unsigned int penalty = 0;
+    unsigned int completed = 0;
+    // Moving average of the observed runtime per payload byte (0 = unknown).
+    double seconds_per_byte = 0;
+    worker(ip::address ipIn, unsigned short portIn) : ip(ipIn), port(portIn)
     {
     }
     bool operator==(const worker& rhs) const
     {
-      return (ip == rhs.ip && port == rhs.port && priority == rhs.priority);
-    }
-  };
-  struct CompareWorker
-  {
-    bool operator()(worker const& w1, worker const& w2)
-    {
-      return w1.priority > w2.priority;
+      return (ip == rhs.ip && port == rhs.port);
     }
   };
 
+  worker* findWorker(const ip::address& ip, unsigned short port);
+  void releaseJob(worker& w, uint64_t job_bytes);
+  uint64_t jobSize(uint64_t job_bytes) const;
+  double secondsPerByte(const worker& w) const;
+  double estimateFinish(const worker& w, uint64_t job_bytes) const;
+
+  // Weight of the newest sample in the moving averages.
+  static constexpr double kHistoryWeight = 0.3;
+
   Distributed* dist_;
   tcp::acceptor acceptor_;
   asio::io_service* service;
   utl::Logger* logger_;
-  std::priority_queue<worker, std::vector<worker>, CompareWorker> workers_;
+  std::vector<worker> workers_;
   std::mutex workers_mutex_;
+  // Moving averages over all workers, used for workers without history and
+  // for jobs of unknown size.
+  double avg_seconds_per_byte_ = 0;
+  double avg_job_bytes_ = 0;
   std::unique_ptr<asio::thread_pool> pool_;
   std::mutex pool_mutex_;
   uint32_t jobs_;
@@ -3,7 +3,9 @@
 #include <boost/asio.hpp>
 #include <boost/test/included/unit_test.hpp>
 #include <boost/thread/thread.hpp>
+#include <chrono>
 #include <string>
+#include <thread>
 
 #include "HelperCallBack.h"
 #include "LoadBalancer.h"
@@ -107,4 +109,145 @@ BOOST_AUTO_TEST_CASE(test_default)
   // history i.e have invalid state.
   BOOST_TEST(balancer->addWorker(local_ip, worker_port_2) == false);
 }
+
+BOOST_AUTO_TEST_CASE(test_load_aware)
+{
+  utl::Logger* logger = new utl::Logger();
+  Distributed* dist = new Distributed(logger);
+  std::string local_ip = "127.0.0.1";
+  auto local_address = asio::ip::address::from_string(local_ip);
+  unsigned short slow_port = 5571;
+  unsigned short fast_port = 5572;
+  asio::io_service io_service;
+  LoadBalancer* balancer
+      = new LoadBalancer(dist, io_service, logger, local_ip.c_str(), "", 5570);
+  balancer->addWorker(local_ip, slow_port);
+  balancer->addWorker(local_ip, fast_port);
+  asio::ip::address address;
+  unsigned short port;
+
+  // Without history the workers are used in turn.
+  balancer->getNextWorker(address, port, 1000);
+  BOOST_TEST(port == slow_port);
+  balancer->getNextWorker(address, port, 1000);
+  BOOST_TEST(port == fast_port);
+  BOOST_TEST(balancer->estimateJobSeconds(local_address, slow_port, 1000)
+             == 0);
+
+  // The fast worker finishes the same job ten times quicker and should get
+  // every job until its queue is as long as the slow worker's.
+  balancer->jobFinished(local_address, slow_port, 1000, 10.0);
+  balancer->jobFinished(local_address, fast_port, 1000, 1.0);
+  BOOST_TEST(balancer->estimateJobSeconds(local_address, slow_port, 1000)
+             == 10.0);
+  for (int i = 0; i < 5; i++) {
+    balancer->getNextWorker(address, port, 1000);
+    BOOST_TEST(port == fast_port);
+  }
+
+  // Only idle workers other than the busy one are used for speculation.
+  BOOST_TEST(balancer->getSpeculativeWorker(
+      local_address, fast_port, 1000, address, port));
+  BOOST_TEST(port == slow_port);
+  BOOST_TEST(!balancer->getSpeculativeWorker(
+      local_address, fast_port, 1000, address, port));
+}
+
+// Replies with several messages, as routing workers do with partial results.
+class StreamingCallBack : public HelperCallBack
+{
+ public:
+  StreamingCallBack(dst::Distributed* dist) : HelperCallBack(dist), dist_(dist)
+  {
+  }
+  void onRoutingJobReceived(dst::JobMessage& msg, dst::socket& sock) override
+  {
+    for (int i = 0; i < 3; i++) {
+      JobMessage reply(i == 2 ? JobMessage::SUCCESS : JobMessage::NONE);
+      dist_->sendResult(reply, sock);
+    }
+    sock.close();
+  }
+
+ private:
+  dst::Distributed* dist_;
+};
+
+BOOST_AUTO_TEST_CASE(test_relay_stream)
+{
+  utl::Logger* logger = new utl::Logger();
+  Distributed* dist = new Distributed(logger);
+  std::string local_ip = "127.0.0.1";
+  unsigned short balancer_port = 5580;
+  unsigned short worker_port = 5581;
+  asio::io_service io_service;
+  LoadBalancer* balancer = new LoadBalancer(
+      dist, io_service, logger, local_ip.c_str(), "", balancer_port);
+  dist->addCallBack(new StreamingCallBack(dist));
+  dist->runWorker(local_ip.c_str(), worker_port, true);
+  balancer->addWorker(local_ip, worker_port);
+  boost::thread t(boost::bind(&asio::io_service::run, &io_service));
+
+  // All partial results must make it through the balancer, and the
+  // balancer learns the worker's speed from the relayed job.
+  JobMessage msg(JobMessage::JobType::ROUTING);
+  JobMessage result;
+  BOOST_TEST(
+      dist->sendJobMultiResult(msg, local_ip.c_str(), balancer_port, result));
+  BOOST_TEST(result.getAllJobDescriptions().size() == 3);
+  BOOST_TEST(balancer->estimateJobSeconds(
+                 asio::ip::address::from_string(local_ip), worker_port, 0)
+             > 0);
+}
+
+// Dies after the first message of its first reply, then behaves.
+class DyingCallBack : public HelperCallBack
+{
+ public:
+  DyingCallBack(dst::Distributed* dist) : HelperCallBack(dist), dist_(dist) {}
+  void onRoutingJobReceived(dst::JobMessage& msg, dst::socket& sock) override
+  {
+    const bool die = jobs_++ == 0;
+    for (int i = 0; i < 3; i++) {
+      JobMessage reply(i == 2 ? JobMessage::SUCCESS : JobMessage::NONE);
+      dist_->sendResult(reply, sock);
+      if (die) {
+        // Let the balancer forward the first chunk before the reset.
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        sock.set_option(asio::ip::tcp::socket::linger(true, 0));
+        sock.close();
+        return;
+      }
+    }
+    sock.close();
+  }
+
+ private:
+  dst::Distributed* dist_;
+  int jobs_ = 0;
+};
+
+BOOST_AUTO_TEST_CASE(test_relay_worker_dies)
+{
+  utl::Logger* logger = new utl::Logger();
+  Distributed* dist = new Distributed(logger);
+  std::string local_ip = "127.0.0.1";
+  unsigned short balancer_port = 5590;
+  unsigned short worker_port = 5591;
+  asio::io_service io_service;
+  LoadBalancer* balancer = new LoadBalancer(
+      dist, io_service, logger, local_ip.c_str(), "", balancer_port);
+  dist->addCallBack(new DyingCallBack(dist));
+  dist->runWorker(local_ip.c_str(), worker_port, true);
+  balancer->addWorker(local_ip, worker_port);
+  boost::thread t(boost::bind(&asio::io_service::run, &io_service));
+
+  // The leader must not take the truncated reply of the first try. It
+  // retries and gets only the complete second reply.
+  JobMessage msg(JobMessage::JobType::ROUTING);
+  JobMessage result;
+  BOOST_TEST(
+      dist->sendJobMultiResult(msg, local_ip.c_str(), balancer_port, result));
+  BOOST_TEST(result.getAllJobDescriptions().size() == 3);
+}
 BOOST_AUTO_TEST_SUITE_END()
@@ -5,10 +5,13 @@
 #include <boost/system/system_error.hpp>
 #include <boost/test/included/unit_test.hpp>
 #include <boost/thread/thread.hpp>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "HelperCallBack.h"
 #include "Worker.h"
+#include "dst/BalancerJobDescription.h"
 #include "dst/Distributed.h"
 #include "dst/JobMessage.h"
 #include "utl/Logger.h"
@@ -35,4 +38,68 @@ BOOST_AUTO_TEST_CASE(test_default)
   BOOST_TEST(result.getJobType() == JobMessage::JobType::SUCCESS);
 }
 
+// Binary payloads with the bytes a text protocol would trip on.
+std::vector<std::string> binaryPayloads()
+{
+  std::string all_bytes;
+  for (int c = 0; c < 256; c++) {
+    all_bytes.push_back(static_cast<char>(c));
+  }
+  std::string large(1 << 20, '\0');
+  for (size_t i = 0; i < large.size(); i++) {
+    large[i] = static_cast<char>(i * 7);
+  }
+  return {all_bytes, std::string("\r\n\0\r\n", 5), large};
+}
+
+// Replies with one message per payload, as routing workers do with partial
+// results.
+class PayloadCallBack : public HelperCallBack
+{
+ public:
+  PayloadCallBack(dst::Distributed* dist) : HelperCallBack(dist), dist_(dist)
+  {
+  }
+  void onRoutingJobReceived(dst::JobMessage& msg, dst::socket& sock) override
+  {
+    const auto payloads = binaryPayloads();
+    for (int i = 0; i < payloads.size(); i++) {
+      auto desc = std::make_unique<BalancerJobDescription>();
+      desc->setWorkerIP(payloads[i]);
+      desc->setWorkerPort(i);
+      JobMessage reply(JobMessage::SUCCESS);
+      reply.setJobDescription(std::move(desc));
+      dist_->sendResult(reply, sock);
+    }
+    sock.close();
+  }
+
+ private:
+  dst::Distributed* dist_;
+};
+
+BOOST_AUTO_TEST_CASE(test_binary_results)
+{
+  utl::Logger* logger = new utl::Logger();
+  Distributed* dist = new Distributed(logger);
+  std::string local_ip = "127.0.0.1";
+  unsigned short port = 1240;
+  dist->addCallBack(new PayloadCallBack(dist));
+  dist->runWorker(local_ip.c_str(), port, true);
+
+  // Each reply is decoded as it arrives and must come through intact and
+  // in order.
+  JobMessage msg(JobMessage::JobType::ROUTING);
+  JobMessage result;
+  BOOST_TEST(dist->sendJobMultiResult(msg, local_ip.c_str(), port, result));
+  const auto payloads = binaryPayloads();
+  auto& descs = result.getAllJobDescriptions();
+  BOOST_TEST(descs.size() == payloads.size());
+  for (int i = 0; i < descs.size() && i < payloads.size(); i++) {
+    auto desc = static_cast<BalancerJobDescription*>(descs[i].get());
+    BOOST_TEST(desc->getWorkerPort() == i);
+    BOOST_TEST(desc->getWorkerIP() == payloads[i]);
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
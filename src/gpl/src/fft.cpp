@@ -33,6 +33,9 @@
 
 #include "fft.h"
 
+#include <omp.h>
+
+#include <algorithm>
 #include <cfloat>
 #include <cmath>
 #include <cstdlib>
@@ -42,38 +45,209 @@
 
 namespace gpl {
 
-FFT::FFT(int binCntX, int binCntY, int binSizeX, int binSizeY)
-    : binCntX_(binCntX),
-      binCntY_(binCntY),
-      binSizeX_(binSizeX),
-      binSizeY_(binSizeY)
+// from fftsg.cpp
+void makewt(int nw, int* ip, float* w);
+void makect(int nc, int* ip, float* c);
+
+namespace {
+
+// work area for bit reversal (prev: ip)
+// length: round(sqrt( max(binCntX_, binCntY_) )) + 2
+int workAreaSize(int cntX, int cntY)
 {
-  binDensity_ = new float*[binCntX_];
-  electroPhi_ = new float*[binCntX_];
-  electroForceX_ = new float*[binCntX_];
-  electroForceY_ = new float*[binCntX_];
+  return std::round(std::sqrt(std::max(cntX, cntY))) + 2;
+}
 
-  for (int i = 0; i < binCntX_; i++) {
-    binDensity_[i] = new float[binCntY_];
-    electroPhi_[i] = new float[binCntY_];
-    electroForceX_[i] = new float[binCntY_];
-    electroForceY_[i] = new float[binCntY_];
+// cos/sin table (prev: w_2d)
+// length:  max(binCntX, binCntY) * 3 / 2
+int csTableSize(int cntX, int cntY)
+{
+  return std::max(cntX, cntY) * 3 / 2;
+}
 
-    for (int j = 0; j < binCntY_; j++) {
-      binDensity_[i][j] = electroPhi_[i][j] = electroForceX_[i][j]
-          = electroForceY_[i][j] = 0.0f;
+class OouraFFTBackend : public FFTBackend
+{
+ public:
+  OouraFFTBackend(int cntX, int cntY)
+      : cntX_(cntX),
+        cntY_(cntY),
+        rows_(cntX),
+        workArea_(workAreaSize(cntX, cntY), 0),
+        csTable_(csTableSize(cntX, cntY), 0),
+        buffer_(4 * cntX, 0)
+  {
+  }
+
+  void transform(float* data, Kind kindX, Kind kindY, int isgn) override
+  {
+    for (int i = 0; i < cntX_; i++) {
+      rows_[i] = data + i * cntY_;
+    }
+    float** a = rows_.data();
+    float* t = buffer_.data();
+    int* ip = workArea_.data();
+    float* w = csTable_.data();
+    // the 2D routines transform the rows (y) first and then the columns (x)
+    if (kindX == Kind::Cos && kindY == Kind::Cos) {
+      ddct2d(cntX_, cntY_, isgn, a, t, ip, w);
+    } else if (kindX == Kind::Sin && kindY == Kind::Sin) {
+      ddst2d(cntX_, cntY_, isgn, a, t, ip, w);
+    } else if (kindX == Kind::Sin) {
+      ddsct2d(cntX_, cntY_, isgn, a, t, ip, w);
+    } else {
+      ddcst2d(cntX_, cntY_, isgn, a, t, ip, w);
     }
   }
 
-  csTable_.resize(std::max(binCntX_, binCntY_) * 3 / 2, 0);
+ private:
+  const int cntX_;
+  const int cntY_;
+  std::vector<float*> rows_;
+  std::vector<int> workArea_;
+  std::vector<float> csTable_;
+  // column buffer of the 2D routines
+  std::vector<float> buffer_;
+};
 
+// The 2D transform is separable: a 1D transform of every row followed by a
+// 1D transform of every column.  Each row and column is independent, so
+// they are spread over the threads.  The cos/sin table is built once for
+// the grid and is read only afterwards; columns are gathered in blocks
+// into a per thread buffer.
+class ThreadedFFTBackend : public FFTBackend
+{
+ public:
+  ThreadedFFTBackend(int cntX, int cntY, int numThreads)
+      : cntX_(cntX),
+        cntY_(cntY),
+        numThreads_(std::max(numThreads, 1)),
+        workArea_(workAreaSize(cntX, cntY), 0),
+        csTable_(csTableSize(cntX, cntY), 0),
+        buffers_(numThreads_)
+  {
+    // same table setup as the Ooura 2D routines
+    const int n = std::max(cntX_, cntY_);
+    int nw = workArea_[0];
+    if (n > (nw << 2)) {
+      nw = n >> 2;
+      makewt(nw, workArea_.data(), csTable_.data());
+    }
+    const int nc = workArea_[1];
+    if (n > nc) {
+      makect(n, workArea_.data(), csTable_.data() + nw);
+    }
+    for (auto& buffer : buffers_) {
+      buffer.resize(column_block * cntX_);
+    }
+  }
+
+  void transform(float* data, Kind kindX, Kind kindY, int isgn) override
+  {
+#pragma omp parallel for num_threads(numThreads_) schedule(static)
+    for (int x = 0; x < cntX_; x++) {
+      transform1d(kindY, cntY_, isgn, data + x * cntY_);
+    }
+
+    // The Ooura 2D routines leave single column grids alone.
+    if (cntY_ < 2) {
+      return;
+    }
+
+    const int numBlocks = (cntY_ + column_block - 1) / column_block;
+#pragma omp parallel for num_threads(numThreads_) schedule(static)
+    for (int block = 0; block < numBlocks; block++) {
+      float* t = buffers_[omp_get_thread_num()].data();
+      const int first = block * column_block;
+      const int cols = std::min(column_block, cntY_ - first);
+      for (int x = 0; x < cntX_; x++) {
+        const float* row = data + x * cntY_ + first;
+        for (int c = 0; c < cols; c++) {
+          t[c * cntX_ + x] = row[c];
+        }
+      }
+      for (int c = 0; c < cols; c++) {
+        transform1d(kindX, cntX_, isgn, t + c * cntX_);
+      }
+      for (int x = 0; x < cntX_; x++) {
+        float* row = data + x * cntY_ + first;
+        for (int c = 0; c < cols; c++) {
+          row[c] = t[c * cntX_ + x];
+        }
+      }
+    }
+  }
+
+ private:
+  void transform1d(Kind kind, int n, int isgn, float* a)
+  {
+    // ddct/ddst only read the tables once they are built.
+    if (kind == Kind::Cos) {
+      ddct(n, isgn, a, workArea_.data(), csTable_.data());
+    } else {
+      ddst(n, isgn, a, workArea_.data(), csTable_.data());
+    }
+  }
+
+  // columns transformed per gather/scatter
+  static constexpr int column_block = 16;
+
+  const int cntX_;
+  const int cntY_;
+  const int numThreads_;
+  std::vector<int> workArea_;
+  AlignedVector<float> csTable_;
+  std::vector<AlignedVector<float>> buffers_;
+};
+
+}  // namespace
+
+std::unique_ptr<FFTBackend> FFTBackend::create(Type type,
+                                               int cntX,
+                                               int cntY,
+                                               int numThreads)
+{
+  switch (type) {
+    case Type::Ooura:
+      return std::make_unique<OouraFFTBackend>(cntX, cntY);
+    case Type::Threaded:
+      return std::make_unique<ThreadedFFTBackend>(cntX, cntY, numThreads);
+  }
+  return nullptr;
+}
+
+const char* FFTBackend::typeName(Type type)
+{
+  switch (type) {
+    case Type::Ooura:
+      return "ooura";
+    case Type::Threaded:
+      return "threaded";
+  }
+  return "unknown";
+}
+
+FFT::FFT(int binCntX,
+         int binCntY,
+         int binSizeX,
+         int binSizeY,
+         int numThreads,
+         FFTBackend::Type backend)
+    : backend_(FFTBackend::create(backend, binCntX, binCntY, numThreads)),
+      binDensity_(binCntX * binCntY, 0.0f),
+      electroPhi_(binCntX * binCntY, 0.0f),
+      electroForceX_(binCntX * binCntY, 0.0f),
+      electroForceY_(binCntX * binCntY, 0.0f),
+      binCntX_(binCntX),
+      binCntY_(binCntY),
+      binSizeX_(binSizeX),
+      binSizeY_(binSizeY),
+      numThreads_(std::max(numThreads, 1))
+{
   wx_.resize(binCntX_, 0);
   wxSquare_.resize(binCntX_, 0);
   wy_.resize(binCntY_, 0);
   wySquare_.resize(binCntY_, 0);
 
-  workArea_.resize(round(sqrt(std::max(binCntX_, binCntY_))) + 2, 0);
-
   for (int i = 0; i < binCntX_; i++) {
     wx_[i]
         = REPLACE_FFT_PI * static_cast<float>(i) / static_cast<float>(binCntX_);
@@ -88,68 +262,31 @@ FFT::FFT(int binCntX, int binCntY, int binSizeX, int binSizeY)
   }
 }
 
-FFT::~FFT()
-{
-  using std::vector;
-  for (int i = 0; i < binCntX_; i++) {
-    delete[] binDensity_[i];
-    delete[] electroPhi_[i];
-    delete[] electroForceX_[i];
-    delete[] electroForceY_[i];
-  }
-  delete[] binDensity_;
-  delete[] electroPhi_;
-  delete[] electroForceX_;
-  delete[] electroForceY_;
-
-  csTable_.clear();
-  wx_.clear();
-  wxSquare_.clear();
-  wy_.clear();
-  wySquare_.clear();
-
-  workArea_.clear();
-}
-
-void FFT::updateDensity(int x, int y, float density)
-{
-  binDensity_[x][y] = density;
-}
-
-std::pair<float, float> FFT::getElectroForce(int x, int y) const
-{
-  return std::make_pair(electroForceX_[x][y], electroForceY_[x][y]);
-}
-
-float FFT::getElectroPhi(int x, int y) const
-{
-  return electroPhi_[x][y];
-}
+FFT::~FFT() = default;
 
 void FFT::doFFT()
 {
-  ddct2d(binCntX_,
-         binCntY_,
-         -1,
-         binDensity_,
-         nullptr,
-         (int*) &workArea_[0],
-         (float*) &csTable_[0]);
+  backend_->transform(binDensity_.data(),
+                      FFTBackend::Kind::Cos,
+                      FFTBackend::Kind::Cos,
+                      -1);
 
   for (int i = 0; i < binCntX_; i++) {
-    binDensity_[i][0] *= 0.5;
+    binDensity_[index(i, 0)] *= 0.5;
   }
 
   for (int i = 0; i < binCntY_; i++) {
-    binDensity_[0][i] *= 0.5;
+    binDensity_[index(0, i)] *= 0.5;
   }
 
+#pragma omp parallel for num_threads(numThreads_)
   for (int i = 0; i < binCntX_; i++) {
     for (int j = 0; j < binCntY_; j++) {
-      binDensity_[i][j] *= 4.0 / binCntX_ / binCntY_;
+      binDensity_[index(i, j)] *= 4.0 / binCntX_ / binCntY_;
     }
   }
 
+#pragma omp parallel for num_threads(numThreads_)
   for (int i = 0; i < binCntX_; i++) {
     float wx = wx_[i];
     float wx2 = wxSquare_[i];
@@ -158,7 +295,7 @@ void FFT::doFFT()
       float wy = wy_[j];
       float wy2 = wySquare_[j];
 
-      float density = binDensity_[i][j];
+      float density = binDensity_[index(i, j)];
       float phi = 0;
       float electroX = 0, electroY = 0;
 
@@ -180,33 +317,24 @@ void FFT::doFFT()
         electroX = phi * wx;
         electroY = phi * wy;
       }
-      electroPhi_[i][j] = phi;
-      electroForceX_[i][j] = electroX;
-      electroForceY_[i][j] = electroY;
+      electroPhi_[index(i, j)] = phi;
+      electroForceX_[index(i, j)] = electroX;
+      electroForceY_[index(i, j)] = electroY;
     }
   }
   // Inverse DCT
-  ddct2d(binCntX_,
-         binCntY_,
-         1,
-         electroPhi_,
-         nullptr,
-         (int*) &workArea_[0],
-         (float*) &csTable_[0]);
-  ddsct2d(binCntX_,
-          binCntY_,
-          1,
-          electroForceX_,
-          nullptr,
-          (int*) &workArea_[0],
-          (float*) &csTable_[0]);
-  ddcst2d(binCntX_,
-          binCntY_,
-          1,
-          electroForceY_,
-          nullptr,
-          (int*) &workArea_[0],
-          (float*) &csTable_[0]);
+  backend_->transform(electroPhi_.data(),
+                      FFTBackend::Kind::Cos,
+                      FFTBackend::Kind::Cos,
+                      1);
+  backend_->transform(electroForceX_.data(),
+                      FFTBackend::Kind::Sin,
+                      FFTBackend::Kind::Cos,
+                      1);
+  backend_->transform(electroForceY_.data(),
+                      FFTBackend::Kind::Cos,
+                      FFTBackend::Kind::Sin,
+                      1);
 }
 
 }  // namespace gpl
@@ -33,37 +33,84 @@
 
 #pragma once
 
+#include <memory>
+#include <utility>
 #include <vector>
 
+#include "alignedAllocator.h"
+
 namespace gpl {
 
+// In place 2D cosine/sine transforms of a cntX x cntY grid stored row by
+// row: bin (x, y) is data[x * cntY + y].  isgn follows the Ooura
+// convention: -1 is the forward and 1 the (unscaled) inverse transform.
+// Implementations may cache plans for their grid size between calls.
+class FFTBackend
+{
+ public:
+  enum class Kind
+  {
+    Cos,
+    Sin
+  };
+
+  enum class Type
+  {
+    // the Ooura 2D routines, single threaded
+    Ooura,
+    // the Ooura 1D routines over rows and columns with OpenMP; gives the
+    // same result as Ooura
+    Threaded
+  };
+
+  static std::unique_ptr<FFTBackend> create(Type type,
+                                            int cntX,
+                                            int cntY,
+                                            int numThreads);
+  static const char* typeName(Type type);
+
+  virtual ~FFTBackend() = default;
+
+  virtual void transform(float* data, Kind kindX, Kind kindY, int isgn) = 0;
+};
+
 class FFT
 {
  public:
-  FFT(int binCntX, int binCntY, int binSizeX, int binSizeY);
+  FFT(int binCntX,
+      int binCntY,
+      int binSizeX,
+      int binSizeY,
+      int numThreads = 1,
+      FFTBackend::Type backend = FFTBackend::Type::Threaded);
   ~FFT();
 
   // input func
-  void updateDensity(int x, int y, float density);
+  void updateDensity(int x, int y, float density)
+  {
+    binDensity_[index(x, y)] = density;
+  }
 
   // do FFT
   void doFFT();
 
   // returning func
-  std::pair<float, float> getElectroForce(int x, int y) const;
-  float getElectroPhi(int x, int y) const;
+  std::pair<float, float> getElectroForce(int x, int y) const
+  {
+    return {electroForceX_[index(x, y)], electroForceY_[index(x, y)]};
+  }
+  float getElectroPhi(int x, int y) const { return electroPhi_[index(x, y)]; }
 
  private:
-  // 2D array; width: binCntX_, height: binCntY_;
-  // No hope to use Vector at this moment...
-  float** binDensity_ = nullptr;
-  float** electroPhi_ = nullptr;
-  float** electroForceX_ = nullptr;
-  float** electroForceY_ = nullptr;
+  int index(int x, int y) const { return x * binCntY_ + y; }
+
+  std::unique_ptr<FFTBackend> backend_;
 
-  // cos/sin table (prev: w_2d)
-  // length:  max(binCntX, binCntY) * 3 / 2
-  std::vector<float> csTable_;
+  // 2D arrays; width: binCntX_, height: binCntY_
+  AlignedVector<float> binDensity_;
+  AlignedVector<float> electroPhi_;
+  AlignedVector<float> electroForceX_;
+  AlignedVector<float> electroForceY_;
 
   // wx. length:  binCntX_
   std::vector<float> wx_;
@@ -73,14 +120,11 @@ class FFT
   std::vector<float> wy_;
   std::vector<float> wySquare_;
 
-  // work area for bit reversal (prev: ip)
-  // length: round(sqrt( max(binCntX_, binCntY_) )) + 2
-  std::vector<int> workArea_;
-
   int binCntX_ = 0;
   int binCntY_ = 0;
   int binSizeX_ = 0;
   int binSizeY_ = 0;
+  int numThreads_ = 1;
 };
 
 //
@@ -76,8 +76,6 @@ static float getSecondNorm(const std::vector<FloatPoint>& a);
 // Choose to use "float" only in the following functions
 static float getOverlapDensityArea(const Bin& bin, const GCell* cell);
 
-static float fastExp(float exp);
-
 ////////////////////////////////////////////////
 // GCell
 
@@ -294,6 +292,14 @@ void GNet::updateBox()
   }
 }
 
+void GNet::setBox(int lx, int ly, int ux, int uy)
+{
+  lx_ = lx;
+  ly_ = ly;
+  ux_ = ux;
+  uy_ = uy;
+}
+
 int64_t GNet::hpwl() const
 {
   if (ux_ < lx_) {  // dangling net
@@ -306,21 +312,6 @@ int64_t GNet::hpwl() const
   return (ux - lx) + (uy - ly);
 }
 
-void GNet::clearWaVars()
-{
-  waExpMinSumX_ = 0;
-  waXExpMinSumX_ = 0;
-
-  waExpMaxSumX_ = 0;
-  waXExpMaxSumX_ = 0;
-
-  waExpMinSumY_ = 0;
-  waYExpMinSumY_ = 0;
-
-  waExpMaxSumY_ = 0;
-  waYExpMaxSumY_ = 0;
-}
-
 void GNet::setDontCare()
 {
   isDontCare_ = true;
@@ -369,41 +360,6 @@ void GPin::setCenterLocation(int cx, int cy)
   cy_ = cy;
 }
 
-void GPin::clearWaVars()
-{
-  hasMaxExpSumX_ = false;
-  hasMaxExpSumY_ = false;
-  hasMinExpSumX_ = false;
-  hasMinExpSumY_ = false;
-
-  maxExpSumX_ = maxExpSumY_ = 0;
-  minExpSumX_ = minExpSumY_ = 0;
-}
-
-void GPin::setMaxExpSumX(float maxExpSumX)
-{
-  hasMaxExpSumX_ = true;
-  maxExpSumX_ = maxExpSumX;
-}
-
-void GPin::setMaxExpSumY(float maxExpSumY)
-{
-  hasMaxExpSumY_ = true;
-  maxExpSumY_ = maxExpSumY;
-}
-
-void GPin::setMinExpSumX(float minExpSumX)
-{
-  hasMinExpSumX_ = true;
-  minExpSumX_ = minExpSumX;
-}
-
-void GPin::setMinExpSumY(float minExpSumY)
-{
-  hasMinExpSumY_ = true;
-  minExpSumY_ = minExpSumY;
-}
-
 void GPin::updateLocation(const GCell* gCell)
 {
   cx_ = gCell->cx() + offsetCx_;
@@ -973,6 +929,23 @@ NesterovBaseCommon::NesterovBaseCommon(NesterovBaseVars nbVars,
       gNet.addGPin(pbToNb(pin));
     }
   }
+
+  // WA slots: the pins of each net are contiguous
+  std::vector<int> netSizes;
+  netSizes.reserve(gNetStor_.size());
+  for (auto& gNet : gNetStor_) {
+    netSizes.push_back(gNet.gPins().size());
+  }
+  waGradient_.init(netSizes);
+  waKernel_ = WaGradient::bestKernel();
+
+  gPinSlot_.assign(gPinStor_.size(), -1);
+  for (int i = 0; i < waGradient_.numNets(); i++) {
+    int slot = waGradient_.netStart(i);
+    for (GPin* gPin : gNetStor_[i].gPins()) {
+      gPinSlot_[gPin - gPinStor_.data()] = slot++;
+    }
+  }
 }
 
 GCell* NesterovBaseCommon::pbToNb(Instance* inst) const
@@ -1025,96 +998,60 @@ GNet* NesterovBaseCommon::dbToNb(odb::dbNet* net) const
 void NesterovBaseCommon::updateWireLengthForceWA(float wlCoeffX, float wlCoeffY)
 {
   assert(omp_get_thread_num() == 0);
-  // clear all WA variables.
+  // The WA terms are shift invariant:
+  //
+  //   Sum(x_i * exp(x_i))    Sum(x_i * exp(x_i - C))
+  //   -----------------    = -----------------
+  //   Sum(exp(x_i))          Sum(exp(x_i - C))
+  //
+  // So we shift by the net box to keep the exponential from overflowing.
+  // The exponentials, sums and pin gradients are computed by waGradient_
+  // on a copy of the pin locations.
 #pragma omp parallel for num_threads(num_threads_)
-  for (auto gPin = gPinStor_.begin(); gPin < gPinStor_.end(); ++gPin) {
-    // old-style loop for old OpenMP
-    gPin->clearWaVars();
+  for (size_t i = 0; i < gPinSlot_.size(); i++) {
+    const int slot = gPinSlot_[i];
+    if (slot >= 0) {
+      waGradient_.setPinLocation(slot, gPinStor_[i].cx(), gPinStor_[i].cy());
+    }
   }
 
-#pragma omp parallel for num_threads(num_threads_)
-  for (auto gNet = gNetStor_.begin(); gNet < gNetStor_.end(); ++gNet) {
-    // old-style loop for old OpenMP
-
-    gNet->clearWaVars();
-    gNet->updateBox();
-
-    for (auto& gPin : gNet->gPins()) {
-      // The WA terms are shift invariant:
-      //
-      //   Sum(x_i * exp(x_i))    Sum(x_i * exp(x_i - C))
-      //   -----------------    = -----------------
-      //   Sum(exp(x_i))          Sum(exp(x_i - C))
-      //
-      // So we shift to keep the exponential from overflowing
-      float expMinX = (gNet->lx() - gPin->cx()) * wlCoeffX;
-      float expMaxX = (gPin->cx() - gNet->ux()) * wlCoeffX;
-      float expMinY = (gNet->ly() - gPin->cy()) * wlCoeffY;
-      float expMaxY = (gPin->cy() - gNet->uy()) * wlCoeffY;
-
-      // min x
-      if (expMinX > nbVars_.minWireLengthForceBar) {
-        gPin->setMinExpSumX(fastExp(expMinX));
-        gNet->addWaExpMinSumX(gPin->minExpSumX());
-        gNet->addWaXExpMinSumX(gPin->cx() * gPin->minExpSumX());
-        if (gPin->gCell() && gPin->gCell()->isInstance()) {
-          debugPrint(log_,
-                     GPL,
-                     "wlUpdateWA",
-                     1,
-                     "MinX updated: {} {:g}",
-                     gPin->gCell()->instance()->dbInst()->getConstName(),
-                     gPin->minExpSumX());
-        }
-      }
-
-      // max x
-      if (expMaxX > nbVars_.minWireLengthForceBar) {
-        gPin->setMaxExpSumX(fastExp(expMaxX));
-        gNet->addWaExpMaxSumX(gPin->maxExpSumX());
-        gNet->addWaXExpMaxSumX(gPin->cx() * gPin->maxExpSumX());
-        if (gPin->gCell() && gPin->gCell()->isInstance()) {
-          debugPrint(log_,
-                     GPL,
-                     "wlUpdateWA",
-                     1,
-                     "MaxX updated: {} {:g}",
-                     gPin->gCell()->instance()->dbInst()->getConstName(),
-                     gPin->maxExpSumX());
-        }
-      }
-
-      // min y
-      if (expMinY > nbVars_.minWireLengthForceBar) {
-        gPin->setMinExpSumY(fastExp(expMinY));
-        gNet->addWaExpMinSumY(gPin->minExpSumY());
-        gNet->addWaYExpMinSumY(gPin->cy() * gPin->minExpSumY());
-        if (gPin->gCell() && gPin->gCell()->isInstance()) {
-          debugPrint(log_,
-                     GPL,
-                     "wlUpdateWA",
-                     1,
-                     "MinY updated: {} {:g}",
-                     gPin->gCell()->instance()->dbInst()->getConstName(),
-                     gPin->minExpSumY());
-        }
-      }
+  debugPrint(log_,
+             GPL,
+             "wlUpdateWA",
+             1,
+             "WA kernel: {}",
+             WaGradient::kernelName(waKernel_));
+  waGradient_.compute(wlCoeffX,
+                      wlCoeffY,
+                      nbVars_.minWireLengthForceBar,
+                      num_threads_,
+                      waKernel_);
 
-      // max y
-      if (expMaxY > nbVars_.minWireLengthForceBar) {
-        gPin->setMaxExpSumY(fastExp(expMaxY));
-        gNet->addWaExpMaxSumY(gPin->maxExpSumY());
-        gNet->addWaYExpMaxSumY(gPin->cy() * gPin->maxExpSumY());
-        if (gPin->gCell() && gPin->gCell()->isInstance()) {
-          debugPrint(log_,
-                     GPL,
-                     "wlUpdateWA",
-                     1,
-                     "MaxY updated: {} {:g}",
-                     gPin->gCell()->instance()->dbInst()->getConstName(),
-                     gPin->maxExpSumY());
-        }
+#pragma omp parallel for num_threads(num_threads_)
+  for (int i = 0; i < waGradient_.numNets(); i++) {
+    gNetStor_[i].setBox(waGradient_.netLx(i),
+                        waGradient_.netLy(i),
+                        waGradient_.netUx(i),
+                        waGradient_.netUy(i));
+  }
+
+  if (log_->debugCheck(GPL, "wlUpdateWA", 1)) {
+    for (size_t i = 0; i < gPinSlot_.size(); i++) {
+      const GPin& gPin = gPinStor_[i];
+      const int slot = gPinSlot_[i];
+      if (slot < 0 || !gPin.gCell() || !gPin.gCell()->isInstance()) {
+        continue;
       }
+      debugPrint(log_,
+                 GPL,
+                 "wlUpdateWA",
+                 1,
+                 "exp updated: {} MinX {:g} MaxX {:g} MinY {:g} MaxY {:g}",
+                 gPin.gCell()->instance()->dbInst()->getConstName(),
+                 waGradient_.expMinX(slot),
+                 waGradient_.expMaxX(slot),
+                 waGradient_.expMinY(slot),
+                 waGradient_.expMaxY(slot));
     }
   }
 }
@@ -1163,71 +1100,28 @@ FloatPoint NesterovBaseCommon::getWireLengthGradientWA(const GCell* gCell,
 // Please check the JingWei's Ph.D. thesis full paper,
 // Equation (4.13)
 //
-// You can't understand the following function
-// unless you read the (4.13) formula
+// The gradient itself is computed in updateWireLengthForceWA,
+// see WaGradient.
 FloatPoint NesterovBaseCommon::getWireLengthGradientPinWA(const GPin* gPin,
                                                           float wlCoeffX,
                                                           float wlCoeffY) const
 {
-  float gradientMinX = 0, gradientMinY = 0;
-  float gradientMaxX = 0, gradientMaxY = 0;
-
-  // min x
-  if (gPin->hasMinExpSumX()) {
-    // from Net.
-    float waExpMinSumX = gPin->gNet()->waExpMinSumX();
-    float waXExpMinSumX = gPin->gNet()->waXExpMinSumX();
-
-    gradientMinX
-        = (waExpMinSumX * (gPin->minExpSumX() * (1.0 - wlCoeffX * gPin->cx()))
-           + wlCoeffX * gPin->minExpSumX() * waXExpMinSumX)
-          / (waExpMinSumX * waExpMinSumX);
-  }
-
-  // max x
-  if (gPin->hasMaxExpSumX()) {
-    float waExpMaxSumX = gPin->gNet()->waExpMaxSumX();
-    float waXExpMaxSumX = gPin->gNet()->waXExpMaxSumX();
-
-    gradientMaxX
-        = (waExpMaxSumX * (gPin->maxExpSumX() * (1.0 + wlCoeffX * gPin->cx()))
-           - wlCoeffX * gPin->maxExpSumX() * waXExpMaxSumX)
-          / (waExpMaxSumX * waExpMaxSumX);
-  }
-
-  // min y
-  if (gPin->hasMinExpSumY()) {
-    float waExpMinSumY = gPin->gNet()->waExpMinSumY();
-    float waYExpMinSumY = gPin->gNet()->waYExpMinSumY();
-
-    gradientMinY
-        = (waExpMinSumY * (gPin->minExpSumY() * (1.0 - wlCoeffY * gPin->cy()))
-           + wlCoeffY * gPin->minExpSumY() * waYExpMinSumY)
-          / (waExpMinSumY * waExpMinSumY);
-  }
-
-  // max y
-  if (gPin->hasMaxExpSumY()) {
-    float waExpMaxSumY = gPin->gNet()->waExpMaxSumY();
-    float waYExpMaxSumY = gPin->gNet()->waYExpMaxSumY();
-
-    gradientMaxY
-        = (waExpMaxSumY * (gPin->maxExpSumY() * (1.0 + wlCoeffY * gPin->cy()))
-           - wlCoeffY * gPin->maxExpSumY() * waYExpMaxSumY)
-          / (waExpMaxSumY * waExpMaxSumY);
+  const int slot = gPinSlot_[gPin - gPinStor_.data()];
+  if (slot < 0) {
+    return FloatPoint(0, 0);
   }
 
+  const FloatPoint gradient(waGradient_.gradientX(slot),
+                            waGradient_.gradientY(slot));
   debugPrint(log_,
              GPL,
              "getGradientWAPin",
              1,
-             "gradient:  X[{:g} {:g}]  Y[{:g} {:g}]",
-             gradientMinX,
-             gradientMaxX,
-             gradientMinY,
-             gradientMaxY);
+             "gradient:  X {:g}  Y {:g}",
+             gradient.x,
+             gradient.y);
 
-  return FloatPoint(gradientMinX - gradientMaxX, gradientMinY - gradientMaxY);
+  return gradient;
 }
 
 FloatPoint NesterovBaseCommon::getWireLengthPreconditioner(
@@ -1342,8 +1236,11 @@ NesterovBase::NesterovBase(NesterovBaseVars nbVars,
   bg_.initBins();
 
   // initialize fft structrue based on bins
-  std::unique_ptr<FFT> fft(
-      new FFT(bg_.binCntX(), bg_.binCntY(), bg_.binSizeX(), bg_.binSizeY()));
+  std::unique_ptr<FFT> fft(new FFT(bg_.binCntX(),
+                                   bg_.binCntY(),
+                                   bg_.binSizeX(),
+                                   bg_.binSizeY(),
+                                   nbc_->getNumThreads()));
 
   fft_ = std::move(fft);
 
@@ -2481,23 +2378,6 @@ static float calculateBiVariateNormalCDF(biNormalParameters i)
          * (std::erf(x1) * std::erf(y1) + std::erf(x2) * std::erf(y2)
             - std::erf(x1) * std::erf(y2) - std::erf(x2) * std::erf(y1));
 }
-//
-// https://codingforspeed.com/using-faster-exponential-approximation/
-static float fastExp(float exp)
-{
-  exp = 1.0f + exp / 1024.0f;
-  exp *= exp;
-  exp *= exp;
-  exp *= exp;
-  exp *= exp;
-  exp *= exp;
-  exp *= exp;
-  exp *= exp;
-  exp *= exp;
-  exp *= exp;
-  exp *= exp;
-  return exp;
-}
 
 static float getDistance(const std::vector<FloatPoint>& a,
                          const std::vector<FloatPoint>& b)
@@ -39,6 +39,7 @@
 #include <vector>
 
 #include "point.h"
+#include "waGradient.h"
 
 namespace odb {
 class dbInst;
@@ -248,38 +249,12 @@ class GNet
 
   void addGPin(GPin* gPin);
   void updateBox();
+  void setBox(int lx, int ly, int ux, int uy);
   int64_t hpwl() const;
 
   void setDontCare();
   bool isDontCare() const;
 
-  // clear WA(Weighted Average) variables.
-  void clearWaVars();
-
-  void addWaExpMinSumX(float waExpMinSumX);
-  void addWaXExpMinSumX(float waXExpMinSumX);
-
-  void addWaExpMinSumY(float waExpMinSumY);
-  void addWaYExpMinSumY(float waYExpMinSumY);
-
-  void addWaExpMaxSumX(float waExpMaxSumX);
-  void addWaXExpMaxSumX(float waXExpMaxSumX);
-
-  void addWaExpMaxSumY(float waExpMaxSumY);
-  void addWaYExpMaxSumY(float waYExpMaxSumY);
-
-  float waExpMinSumX() const;
-  float waXExpMinSumX() const;
-
-  float waExpMinSumY() const;
-  float waYExpMinSumY() const;
-
-  float waExpMaxSumX() const;
-  float waXExpMaxSumX() const;
-
-  float waExpMaxSumY() const;
-  float waYExpMaxSumY() const;
-
  private:
   std::vector<GPin*> gPins_;
   std::vector<Net*> nets_;
@@ -291,43 +266,6 @@ class GNet
   float timingWeight_ = 1;
   float customWeight_ = 1;
 
-  //
-  // weighted average WL model stor for better indexing
-  // Please check the equation (4) in the ePlace-MS paper.
-  //
-  // WA: weighted Average
-  // saving four variable will be helpful for
-  // calculating the WA gradients/wirelengths.
-  //
-  // gamma: modeling accuracy.
-  //
-  // X forces.
-  //
-  // waExpMinSumX_: store sigma {exp(x_i/gamma)}
-  // waXExpMinSumX_: store signa {x_i*exp(e_i/gamma)}
-  // waExpMaxSumX_ : store sigma {exp(-x_i/gamma)}
-  // waXExpMaxSumX_: store sigma {x_i*exp(-x_i/gamma)}
-  //
-  float waExpMinSumX_ = 0;
-  float waXExpMinSumX_ = 0;
-
-  float waExpMaxSumX_ = 0;
-  float waXExpMaxSumX_ = 0;
-
-  //
-  // Y forces.
-  //
-  // waExpMinSumY_: store sigma {exp(y_i/gamma)}
-  // waYExpMinSumY_: store signa {y_i*exp(e_i/gamma)}
-  // waExpMaxSumY_ : store sigma {exp(-y_i/gamma)}
-  // waYExpMaxSumY_: store sigma {y_i*exp(-y_i/gamma)}
-  //
-  float waExpMinSumY_ = 0;
-  float waYExpMinSumY_ = 0;
-
-  float waExpMaxSumY_ = 0;
-  float waYExpMaxSumY_ = 0;
-
   bool isDontCare_ = false;
 };
 
@@ -351,87 +289,6 @@ inline int GNet::uy() const
   return uy_;
 }
 
-// eight add functions
-inline void GNet::addWaExpMinSumX(float waExpMinSumX)
-{
-  waExpMinSumX_ += waExpMinSumX;
-}
-
-inline void GNet::addWaXExpMinSumX(float waXExpMinSumX)
-{
-  waXExpMinSumX_ += waXExpMinSumX;
-}
-
-inline void GNet::addWaExpMinSumY(float waExpMinSumY)
-{
-  waExpMinSumY_ += waExpMinSumY;
-}
-
-inline void GNet::addWaYExpMinSumY(float waYExpMinSumY)
-{
-  waYExpMinSumY_ += waYExpMinSumY;
-}
-
-inline void GNet::addWaExpMaxSumX(float waExpMaxSumX)
-{
-  waExpMaxSumX_ += waExpMaxSumX;
-}
-
-inline void GNet::addWaXExpMaxSumX(float waXExpMaxSumX)
-{
-  waXExpMaxSumX_ += waXExpMaxSumX;
-}
-
-inline void GNet::addWaExpMaxSumY(float waExpMaxSumY)
-{
-  waExpMaxSumY_ += waExpMaxSumY;
-}
-
-inline void GNet::addWaYExpMaxSumY(float waYExpMaxSumY)
-{
-  waYExpMaxSumY_ += waYExpMaxSumY;
-}
-
-inline float GNet::waExpMinSumX() const
-{
-  return waExpMinSumX_;
-}
-
-inline float GNet::waXExpMinSumX() const
-{
-  return waXExpMinSumX_;
-}
-
-inline float GNet::waExpMinSumY() const
-{
-  return waExpMinSumY_;
-}
-
-inline float GNet::waYExpMinSumY() const
-{
-  return waYExpMinSumY_;
-}
-
-inline float GNet::waExpMaxSumX() const
-{
-  return waExpMaxSumX_;
-}
-
-inline float GNet::waXExpMaxSumX() const
-{
-  return waXExpMaxSumX_;
-}
-
-inline float GNet::waExpMaxSumY() const
-{
-  return waExpMaxSumY_;
-}
-
-inline float GNet::waYExpMaxSumY() const
-{
-  return waYExpMaxSumY_;
-}
-
 class GPin
 {
  public:
@@ -450,24 +307,6 @@ class GPin
   int cx() const { return cx_; }
   int cy() const { return cy_; }
 
-  // clear WA(Weighted Average) variables.
-  void clearWaVars();
-
-  void setMaxExpSumX(float maxExpSumX);
-  void setMaxExpSumY(float maxExpSumY);
-  void setMinExpSumX(float minExpSumX);
-  void setMinExpSumY(float minExpSumY);
-
-  float maxExpSumX() const { return maxExpSumX_; }
-  float maxExpSumY() const { return maxExpSumY_; }
-  float minExpSumX() const { return minExpSumX_; }
-  float minExpSumY() const { return minExpSumY_; }
-
-  bool hasMaxExpSumX() const { return hasMaxExpSumX_; }
-  bool hasMaxExpSumY() const { return hasMaxExpSumY_; }
-  bool hasMinExpSumX() const { return hasMinExpSumX_; }
-  bool hasMinExpSumY() const { return hasMinExpSumY_; }
-
   void setCenterLocation(int cx, int cy);
   void updateLocation(const GCell* gCell);
   void updateDensityLocation(const GCell* gCell);
@@ -481,29 +320,6 @@ class GPin
   int offsetCy_ = 0;
   int cx_ = 0;
   int cy_ = 0;
-
-  // weighted average WL vals stor for better indexing
-  // Please check the equation (4) in the ePlace-MS paper.
-  //
-  // maxExpSum_: holds exp(x_i/gamma)
-  // minExpSum_: holds exp(-x_i/gamma)
-  // the x_i is equal to cx_ variable.
-  //
-  float maxExpSumX_ = 0;
-  float maxExpSumY_ = 0;
-
-  float minExpSumX_ = 0;
-  float minExpSumY_ = 0;
-
-  // flag variables
-  //
-  // check whether
-  // this pin is considered in a WA models.
-  bool hasMaxExpSumX_ = false;
-  bool hasMaxExpSumY_ = false;
-
-  bool hasMinExpSumX_ = false;
-  bool hasMinExpSumY_ = false;
 };
 
 class Bin
@@ -846,6 +662,13 @@ class NesterovBaseCommon
   std::unordered_map<Pin*, GPin*> gPinMap_;
   std::unordered_map<Net*, GNet*> gNetMap_;
 
+  // WA gradient data in structure of arrays layout.
+  // gPinSlot_[i] is the WaGradient slot of gPinStor_[i] or -1 if the pin
+  // is not connected to a net.
+  WaGradient waGradient_;
+  std::vector<int> gPinSlot_;
+  WaGradient::Kernel waKernel_;
+
   int num_threads_;
 };
 
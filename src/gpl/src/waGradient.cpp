@@ -0,0 +1,647 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///////////////////////////////////////////////////////////////////////////////
+
+#include "waGradient.h"
+
+#include <omp.h>
+
+#include <algorithm>
+#include <climits>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define GPL_WA_X86 1
+#include <immintrin.h>
+#endif
+
+// The passes below reproduce the floating point operation order of the
+// original per object code, including its float/double promotions.  This file
+// is compiled with -ffp-contract=off so the compiler does not fuse them.
+
+namespace gpl {
+
+namespace {
+
+struct ExpArgs
+{
+  const int* pinNet;
+  const int* pinX;
+  const int* pinY;
+  const int* lx;
+  const int* ly;
+  const int* ux;
+  const int* uy;
+  float* expMinX;
+  float* expMaxX;
+  float* expMinY;
+  float* expMaxY;
+  float coeffX;
+  float coeffY;
+  float bar;
+};
+
+struct GradArgs
+{
+  const int* pinNet;
+  const int* pinX;
+  const int* pinY;
+  const float* expMinX;
+  const float* expMaxX;
+  const float* expMinY;
+  const float* expMaxY;
+  const float* expMinSumX;
+  const float* xExpMinSumX;
+  const float* expMaxSumX;
+  const float* xExpMaxSumX;
+  const float* expMinSumY;
+  const float* yExpMinSumY;
+  const float* expMaxSumY;
+  const float* yExpMaxSumY;
+  float* gradX;
+  float* gradY;
+  float coeffX;
+  float coeffY;
+};
+
+// (1 + x / 1024)^1024, the same approximation as in nesterovBase.cpp
+inline float fastExp(float exp)
+{
+  exp = 1.0f + exp / 1024.0f;
+  for (int i = 0; i < 10; i++) {
+    exp *= exp;
+  }
+  return exp;
+}
+
+inline float expTerm(float exp, float bar)
+{
+  return exp > bar ? fastExp(exp) : 0;
+}
+
+void expScalar(const ExpArgs& a, int begin, int end)
+{
+  for (int i = begin; i < end; i++) {
+    const int net = a.pinNet[i];
+    a.expMinX[i] = expTerm((a.lx[net] - a.pinX[i]) * a.coeffX, a.bar);
+    a.expMaxX[i] = expTerm((a.pinX[i] - a.ux[net]) * a.coeffX, a.bar);
+    a.expMinY[i] = expTerm((a.ly[net] - a.pinY[i]) * a.coeffY, a.bar);
+    a.expMaxY[i] = expTerm((a.pinY[i] - a.uy[net]) * a.coeffY, a.bar);
+  }
+}
+
+// Equation (4.13) of JingWei's Ph.D. thesis, see
+// NesterovBaseCommon::getWireLengthGradientPinWA
+inline float minGradient(float exp, int x, float expSum, float xExpSum, float c)
+{
+  if (exp == 0) {
+    return 0;
+  }
+  return (expSum * (exp * (1.0 - c * x)) + c * exp * xExpSum)
+         / (expSum * expSum);
+}
+
+inline float maxGradient(float exp, int x, float expSum, float xExpSum, float c)
+{
+  if (exp == 0) {
+    return 0;
+  }
+  return (expSum * (exp * (1.0 + c * x)) - c * exp * xExpSum)
+         / (expSum * expSum);
+}
+
+void gradScalar(const GradArgs& a, int begin, int end)
+{
+  for (int i = begin; i < end; i++) {
+    const int net = a.pinNet[i];
+    const float minX = minGradient(a.expMinX[i],
+                                   a.pinX[i],
+                                   a.expMinSumX[net],
+                                   a.xExpMinSumX[net],
+                                   a.coeffX);
+    const float maxX = maxGradient(a.expMaxX[i],
+                                   a.pinX[i],
+                                   a.expMaxSumX[net],
+                                   a.xExpMaxSumX[net],
+                                   a.coeffX);
+    const float minY = minGradient(a.expMinY[i],
+                                   a.pinY[i],
+                                   a.expMinSumY[net],
+                                   a.yExpMinSumY[net],
+                                   a.coeffY);
+    const float maxY = maxGradient(a.expMaxY[i],
+                                   a.pinY[i],
+                                   a.expMaxSumY[net],
+                                   a.yExpMaxSumY[net],
+                                   a.coeffY);
+    a.gradX[i] = minX - maxX;
+    a.gradY[i] = minY - maxY;
+  }
+}
+
+#ifdef GPL_WA_X86
+
+////////////////////////////////////////////////
+// AVX2: 8 floats or 4 doubles per vector
+
+__attribute__((target("avx2"))) inline __m256 fastExpAvx2(__m256 exp)
+{
+  exp = _mm256_add_ps(_mm256_set1_ps(1.0f),
+                      _mm256_div_ps(exp, _mm256_set1_ps(1024.0f)));
+  for (int i = 0; i < 10; i++) {
+    exp = _mm256_mul_ps(exp, exp);
+  }
+  return exp;
+}
+
+__attribute__((target("avx2"))) inline __m256 expTermAvx2(__m256i diff,
+                                                          __m256 coeff,
+                                                          __m256 bar)
+{
+  const __m256 exp = _mm256_mul_ps(_mm256_cvtepi32_ps(diff), coeff);
+  const __m256 mask = _mm256_cmp_ps(exp, bar, _CMP_GT_OQ);
+  return _mm256_and_ps(mask, fastExpAvx2(exp));
+}
+
+__attribute__((target("avx2"))) void expAvx2(const ExpArgs& a,
+                                             int begin,
+                                             int end)
+{
+  const __m256 coeffX = _mm256_set1_ps(a.coeffX);
+  const __m256 coeffY = _mm256_set1_ps(a.coeffY);
+  const __m256 bar = _mm256_set1_ps(a.bar);
+  int i = begin;
+  for (; i + 8 <= end; i += 8) {
+    const __m256i net = _mm256_loadu_si256((const __m256i*) (a.pinNet + i));
+    const __m256i x = _mm256_loadu_si256((const __m256i*) (a.pinX + i));
+    const __m256i y = _mm256_loadu_si256((const __m256i*) (a.pinY + i));
+    const __m256i lx = _mm256_i32gather_epi32(a.lx, net, 4);
+    const __m256i ux = _mm256_i32gather_epi32(a.ux, net, 4);
+    const __m256i ly = _mm256_i32gather_epi32(a.ly, net, 4);
+    const __m256i uy = _mm256_i32gather_epi32(a.uy, net, 4);
+    _mm256_storeu_ps(a.expMinX + i,
+                     expTermAvx2(_mm256_sub_epi32(lx, x), coeffX, bar));
+    _mm256_storeu_ps(a.expMaxX + i,
+                     expTermAvx2(_mm256_sub_epi32(x, ux), coeffX, bar));
+    _mm256_storeu_ps(a.expMinY + i,
+                     expTermAvx2(_mm256_sub_epi32(ly, y), coeffY, bar));
+    _mm256_storeu_ps(a.expMaxY + i,
+                     expTermAvx2(_mm256_sub_epi32(y, uy), coeffY, bar));
+  }
+  expScalar(a, i, end);
+}
+
+// sign is +1 for the min terms and -1 for the max terms
+__attribute__((target("avx2"))) inline __m128 gradientAvx2(__m128 exp,
+                                                          __m128i pos,
+                                                          __m128 expSum,
+                                                          __m128 posExpSum,
+                                                          __m128 coeff,
+                                                          bool isMin)
+{
+  const __m256d one = _mm256_set1_pd(1.0);
+  const __m256d cPos
+      = _mm256_cvtps_pd(_mm_mul_ps(coeff, _mm_cvtepi32_ps(pos)));
+  const __m256d factor
+      = isMin ? _mm256_sub_pd(one, cPos) : _mm256_add_pd(one, cPos);
+  const __m256d lhs = _mm256_mul_pd(
+      _mm256_cvtps_pd(expSum), _mm256_mul_pd(_mm256_cvtps_pd(exp), factor));
+  const __m256d rhs
+      = _mm256_cvtps_pd(_mm_mul_ps(_mm_mul_ps(coeff, exp), posExpSum));
+  const __m256d num
+      = isMin ? _mm256_add_pd(lhs, rhs) : _mm256_sub_pd(lhs, rhs);
+  const __m256d den = _mm256_cvtps_pd(_mm_mul_ps(expSum, expSum));
+  const __m128 grad = _mm256_cvtpd_ps(_mm256_div_pd(num, den));
+  const __m128 mask = _mm_cmp_ps(exp, _mm_setzero_ps(), _CMP_NEQ_UQ);
+  return _mm_and_ps(mask, grad);
+}
+
+__attribute__((target("avx2"))) void gradAvx2(const GradArgs& a,
+                                              int begin,
+                                              int end)
+{
+  const __m128 coeffX = _mm_set1_ps(a.coeffX);
+  const __m128 coeffY = _mm_set1_ps(a.coeffY);
+  int i = begin;
+  for (; i + 4 <= end; i += 4) {
+    const __m128i net = _mm_loadu_si128((const __m128i*) (a.pinNet + i));
+    const __m128i x = _mm_loadu_si128((const __m128i*) (a.pinX + i));
+    const __m128i y = _mm_loadu_si128((const __m128i*) (a.pinY + i));
+    const __m128 minX = gradientAvx2(_mm_loadu_ps(a.expMinX + i),
+                                     x,
+                                     _mm_i32gather_ps(a.expMinSumX, net, 4),
+                                     _mm_i32gather_ps(a.xExpMinSumX, net, 4),
+                                     coeffX,
+                                     true);
+    const __m128 maxX = gradientAvx2(_mm_loadu_ps(a.expMaxX + i),
+                                     x,
+                                     _mm_i32gather_ps(a.expMaxSumX, net, 4),
+                                     _mm_i32gather_ps(a.xExpMaxSumX, net, 4),
+                                     coeffX,
+                                     false);
+    const __m128 minY = gradientAvx2(_mm_loadu_ps(a.expMinY + i),
+                                     y,
+                                     _mm_i32gather_ps(a.expMinSumY, net, 4),
+                                     _mm_i32gather_ps(a.yExpMinSumY, net, 4),
+                                     coeffY,
+                                     true);
+    const __m128 maxY = gradientAvx2(_mm_loadu_ps(a.expMaxY + i),
+                                     y,
+                                     _mm_i32gather_ps(a.expMaxSumY, net, 4),
+                                     _mm_i32gather_ps(a.yExpMaxSumY, net, 4),
+                                     coeffY,
+                                     false);
+    _mm_storeu_ps(a.gradX + i, _mm_sub_ps(minX, maxX));
+    _mm_storeu_ps(a.gradY + i, _mm_sub_ps(minY, maxY));
+  }
+  gradScalar(a, i, end);
+}
+
+////////////////////////////////////////////////
+// AVX-512: 16 floats or 8 doubles per vector
+//
+// GCC 12 builds the unmasked AVX-512 conversions and gathers on top of an
+// undefined vector and then reports -Wmaybe-uninitialized at -O2.  The
+// zero-masked forms with a full mask compile to the same instructions.
+
+constexpr __mmask8 all8 = 0xff;
+constexpr __mmask16 all16 = 0xffff;
+
+__attribute__((target("avx512f"))) inline __m512 fastExpAvx512(__m512 exp)
+{
+  exp = _mm512_add_ps(_mm512_set1_ps(1.0f),
+                      _mm512_div_ps(exp, _mm512_set1_ps(1024.0f)));
+  for (int i = 0; i < 10; i++) {
+    exp = _mm512_mul_ps(exp, exp);
+  }
+  return exp;
+}
+
+__attribute__((target("avx512f"))) inline __m512 expTermAvx512(__m512i diff,
+                                                              __m512 coeff,
+                                                              __m512 bar)
+{
+  const __m512 exp
+      = _mm512_mul_ps(_mm512_maskz_cvtepi32_ps(all16, diff), coeff);
+  const __mmask16 mask = _mm512_cmp_ps_mask(exp, bar, _CMP_GT_OQ);
+  return _mm512_maskz_mov_ps(mask, fastExpAvx512(exp));
+}
+
+__attribute__((target("avx512f"))) void expAvx512(const ExpArgs& a,
+                                                 int begin,
+                                                 int end)
+{
+  const __m512 coeffX = _mm512_set1_ps(a.coeffX);
+  const __m512 coeffY = _mm512_set1_ps(a.coeffY);
+  const __m512 bar = _mm512_set1_ps(a.bar);
+  int i = begin;
+  for (; i + 16 <= end; i += 16) {
+    const __m512i net = _mm512_loadu_si512(a.pinNet + i);
+    const __m512i x = _mm512_loadu_si512(a.pinX + i);
+    const __m512i y = _mm512_loadu_si512(a.pinY + i);
+    const __m512i lx = _mm512_mask_i32gather_epi32(
+        _mm512_setzero_si512(), all16, net, a.lx, 4);
+    const __m512i ux = _mm512_mask_i32gather_epi32(
+        _mm512_setzero_si512(), all16, net, a.ux, 4);
+    const __m512i ly = _mm512_mask_i32gather_epi32(
+        _mm512_setzero_si512(), all16, net, a.ly, 4);
+    const __m512i uy = _mm512_mask_i32gather_epi32(
+        _mm512_setzero_si512(), all16, net, a.uy, 4);
+    _mm512_storeu_ps(a.expMinX + i,
+                     expTermAvx512(_mm512_sub_epi32(lx, x), coeffX, bar));
+    _mm512_storeu_ps(a.expMaxX + i,
+                     expTermAvx512(_mm512_sub_epi32(x, ux), coeffX, bar));
+    _mm512_storeu_ps(a.expMinY + i,
+                     expTermAvx512(_mm512_sub_epi32(ly, y), coeffY, bar));
+    _mm512_storeu_ps(a.expMaxY + i,
+                     expTermAvx512(_mm512_sub_epi32(y, uy), coeffY, bar));
+  }
+  expScalar(a, i, end);
+}
+
+__attribute__((target("avx512f"))) inline __m256 gradientAvx512(
+    __m256 exp,
+    __m256i pos,
+    __m256 expSum,
+    __m256 posExpSum,
+    __m256 coeff,
+    bool isMin)
+{
+  const __m512d one = _mm512_set1_pd(1.0);
+  const __m512d cPos = _mm512_maskz_cvtps_pd(
+      all8, _mm256_mul_ps(coeff, _mm256_cvtepi32_ps(pos)));
+  const __m512d factor
+      = isMin ? _mm512_sub_pd(one, cPos) : _mm512_add_pd(one, cPos);
+  const __m512d lhs
+      = _mm512_mul_pd(_mm512_maskz_cvtps_pd(all8, expSum),
+                      _mm512_mul_pd(_mm512_maskz_cvtps_pd(all8, exp), factor));
+  const __m512d rhs = _mm512_maskz_cvtps_pd(
+      all8, _mm256_mul_ps(_mm256_mul_ps(coeff, exp), posExpSum));
+  const __m512d num
+      = isMin ? _mm512_add_pd(lhs, rhs) : _mm512_sub_pd(lhs, rhs);
+  const __m512d den
+      = _mm512_maskz_cvtps_pd(all8, _mm256_mul_ps(expSum, expSum));
+  const __m256 grad = _mm512_maskz_cvtpd_ps(all8, _mm512_div_pd(num, den));
+  const __m256 mask = _mm256_cmp_ps(exp, _mm256_setzero_ps(), _CMP_NEQ_UQ);
+  return _mm256_and_ps(mask, grad);
+}
+
+__attribute__((target("avx512f"))) void gradAvx512(const GradArgs& a,
+                                                  int begin,
+                                                  int end)
+{
+  const __m256 coeffX = _mm256_set1_ps(a.coeffX);
+  const __m256 coeffY = _mm256_set1_ps(a.coeffY);
+  int i = begin;
+  for (; i + 8 <= end; i += 8) {
+    const __m256i net = _mm256_loadu_si256((const __m256i*) (a.pinNet + i));
+    const __m256i x = _mm256_loadu_si256((const __m256i*) (a.pinX + i));
+    const __m256i y = _mm256_loadu_si256((const __m256i*) (a.pinY + i));
+    const __m256 minX
+        = gradientAvx512(_mm256_loadu_ps(a.expMinX + i),
+                         x,
+                         _mm256_i32gather_ps(a.expMinSumX, net, 4),
+                         _mm256_i32gather_ps(a.xExpMinSumX, net, 4),
+                         coeffX,
+                         true);
+    const __m256 maxX
+        = gradientAvx512(_mm256_loadu_ps(a.expMaxX + i),
+                         x,
+                         _mm256_i32gather_ps(a.expMaxSumX, net, 4),
+                         _mm256_i32gather_ps(a.xExpMaxSumX, net, 4),
+                         coeffX,
+                         false);
+    const __m256 minY
+        = gradientAvx512(_mm256_loadu_ps(a.expMinY + i),
+                         y,
+                         _mm256_i32gather_ps(a.expMinSumY, net, 4),
+                         _mm256_i32gather_ps(a.yExpMinSumY, net, 4),
+                         coeffY,
+                         true);
+    const __m256 maxY
+        = gradientAvx512(_mm256_loadu_ps(a.expMaxY + i),
+                         y,
+                         _mm256_i32gather_ps(a.expMaxSumY, net, 4),
+                         _mm256_i32gather_ps(a.yExpMaxSumY, net, 4),
+                         coeffY,
+                         false);
+    _mm256_storeu_ps(a.gradX + i, _mm256_sub_ps(minX, maxX));
+    _mm256_storeu_ps(a.gradY + i, _mm256_sub_ps(minY, maxY));
+  }
+  gradScalar(a, i, end);
+}
+
+#endif  // GPL_WA_X86
+
+// pins per parallel chunk of the vectorized passes
+constexpr int chunk_size = 4096;
+
+}  // namespace
+
+bool WaGradient::isSupported(Kernel kernel)
+{
+  switch (kernel) {
+    case Kernel::Scalar:
+      return true;
+#ifdef GPL_WA_X86
+    case Kernel::Avx2:
+      return __builtin_cpu_supports("avx2");
+    case Kernel::Avx512:
+      return __builtin_cpu_supports("avx512f");
+#else
+    case Kernel::Avx2:
+    case Kernel::Avx512:
+      return false;
+#endif
+  }
+  return false;
+}
+
+WaGradient::Kernel WaGradient::bestKernel()
+{
+  if (isSupported(Kernel::Avx512)) {
+    return Kernel::Avx512;
+  }
+  if (isSupported(Kernel::Avx2)) {
+    return Kernel::Avx2;
+  }
+  return Kernel::Scalar;
+}
+
+const char* WaGradient::kernelName(Kernel kernel)
+{
+  switch (kernel) {
+    case Kernel::Scalar:
+      return "scalar";
+    case Kernel::Avx2:
+      return "avx2";
+    case Kernel::Avx512:
+      return "avx512";
+  }
+  return "unknown";
+}
+
+void WaGradient::init(const std::vector<int>& netSizes)
+{
+  netStart_.assign(1, 0);
+  netStart_.reserve(netSizes.size() + 1);
+  for (const int size : netSizes) {
+    netStart_.push_back(netStart_.back() + size);
+  }
+  const int numNets = netSizes.size();
+  const int numPins = netStart_.back();
+
+  pinNet_.resize(numPins);
+  for (int net = 0; net < numNets; net++) {
+    std::fill(pinNet_.begin() + netStart_[net],
+              pinNet_.begin() + netStart_[net + 1],
+              net);
+  }
+  for (auto* pinArray : {&pinX_, &pinY_}) {
+    pinArray->assign(numPins, 0);
+  }
+  for (auto* pinArray :
+       {&expMinX_, &expMaxX_, &expMinY_, &expMaxY_, &gradX_, &gradY_}) {
+    pinArray->assign(numPins, 0);
+  }
+  for (auto* netArray : {&netLx_, &netLy_, &netUx_, &netUy_}) {
+    netArray->assign(numNets, 0);
+  }
+  for (auto* netArray : {&expMinSumX_,
+                         &xExpMinSumX_,
+                         &expMaxSumX_,
+                         &xExpMaxSumX_,
+                         &expMinSumY_,
+                         &yExpMinSumY_,
+                         &expMaxSumY_,
+                         &yExpMaxSumY_}) {
+    netArray->assign(numNets, 0);
+  }
+}
+
+void WaGradient::updateBoxes(int firstNet, int lastNet)
+{
+  for (int net = firstNet; net < lastNet; net++) {
+    int lx = INT_MAX;
+    int ly = INT_MAX;
+    int ux = INT_MIN;
+    int uy = INT_MIN;
+    for (int i = netStart_[net]; i < netStart_[net + 1]; i++) {
+      lx = std::min(pinX_[i], lx);
+      ly = std::min(pinY_[i], ly);
+      ux = std::max(pinX_[i], ux);
+      uy = std::max(pinY_[i], uy);
+    }
+    netLx_[net] = lx;
+    netLy_[net] = ly;
+    netUx_[net] = ux;
+    netUy_[net] = uy;
+  }
+}
+
+// Sums in pin order; a pin that is not part of a sum adds zero.
+void WaGradient::updateSums(int firstNet, int lastNet)
+{
+  for (int net = firstNet; net < lastNet; net++) {
+    float expMinSumX = 0;
+    float xExpMinSumX = 0;
+    float expMaxSumX = 0;
+    float xExpMaxSumX = 0;
+    float expMinSumY = 0;
+    float yExpMinSumY = 0;
+    float expMaxSumY = 0;
+    float yExpMaxSumY = 0;
+    for (int i = netStart_[net]; i < netStart_[net + 1]; i++) {
+      expMinSumX += expMinX_[i];
+      xExpMinSumX += pinX_[i] * expMinX_[i];
+      expMaxSumX += expMaxX_[i];
+      xExpMaxSumX += pinX_[i] * expMaxX_[i];
+      expMinSumY += expMinY_[i];
+      yExpMinSumY += pinY_[i] * expMinY_[i];
+      expMaxSumY += expMaxY_[i];
+      yExpMaxSumY += pinY_[i] * expMaxY_[i];
+    }
+    expMinSumX_[net] = expMinSumX;
+    xExpMinSumX_[net] = xExpMinSumX;
+    expMaxSumX_[net] = expMaxSumX;
+    xExpMaxSumX_[net] = xExpMaxSumX;
+    expMinSumY_[net] = expMinSumY;
+    yExpMinSumY_[net] = yExpMinSumY;
+    expMaxSumY_[net] = expMaxSumY;
+    yExpMaxSumY_[net] = yExpMaxSumY;
+  }
+}
+
+void WaGradient::compute(float wlCoeffX,
+                         float wlCoeffY,
+                         float minForceBar,
+                         int numThreads,
+                         Kernel kernel)
+{
+  const int numNets = this->numNets();
+  const int numPins = this->numPins();
+  const int numChunks = (numPins + chunk_size - 1) / chunk_size;
+  const int netsPerChunk = std::max(
+      1, (int) ((int64_t) numNets * chunk_size / std::max(numPins, 1)));
+  const int numNetChunks = (numNets + netsPerChunk - 1) / netsPerChunk;
+
+  const ExpArgs expArgs{pinNet_.data(),
+                        pinX_.data(),
+                        pinY_.data(),
+                        netLx_.data(),
+                        netLy_.data(),
+                        netUx_.data(),
+                        netUy_.data(),
+                        expMinX_.data(),
+                        expMaxX_.data(),
+                        expMinY_.data(),
+                        expMaxY_.data(),
+                        wlCoeffX,
+                        wlCoeffY,
+                        minForceBar};
+  const GradArgs gradArgs{pinNet_.data(),
+                          pinX_.data(),
+                          pinY_.data(),
+                          expMinX_.data(),
+                          expMaxX_.data(),
+                          expMinY_.data(),
+                          expMaxY_.data(),
+                          expMinSumX_.data(),
+                          xExpMinSumX_.data(),
+                          expMaxSumX_.data(),
+                          xExpMaxSumX_.data(),
+                          expMinSumY_.data(),
+                          yExpMinSumY_.data(),
+                          expMaxSumY_.data(),
+                          yExpMaxSumY_.data(),
+                          gradX_.data(),
+                          gradY_.data(),
+                          wlCoeffX,
+                          wlCoeffY};
+
+  auto expPass = expScalar;
+  auto gradPass = gradScalar;
+#ifdef GPL_WA_X86
+  if (kernel == Kernel::Avx2) {
+    expPass = expAvx2;
+    gradPass = gradAvx2;
+  } else if (kernel == Kernel::Avx512) {
+    expPass = expAvx512;
+    gradPass = gradAvx512;
+  }
+#endif
+
+#pragma omp parallel num_threads(numThreads)
+  {
+#pragma omp for schedule(static)
+    for (int chunk = 0; chunk < numNetChunks; chunk++) {
+      const int first = chunk * netsPerChunk;
+      updateBoxes(first, std::min(first + netsPerChunk, numNets));
+    }
+#pragma omp for schedule(static)
+    for (int chunk = 0; chunk < numChunks; chunk++) {
+      const int first = chunk * chunk_size;
+      expPass(expArgs, first, std::min(first + chunk_size, numPins));
+    }
+#pragma omp for schedule(static)
+    for (int chunk = 0; chunk < numNetChunks; chunk++) {
+      const int first = chunk * netsPerChunk;
+      updateSums(first, std::min(first + netsPerChunk, numNets));
+    }
+#pragma omp for schedule(static)
+    for (int chunk = 0; chunk < numChunks; chunk++) {
+      const int first = chunk * chunk_size;
+      gradPass(gradArgs, first, std::min(first + chunk_size, numPins));
+    }
+  }
+}
+
+}  // namespace gpl
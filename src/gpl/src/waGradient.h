@@ -0,0 +1,137 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <vector>
+
+#include "alignedAllocator.h"
+
+namespace gpl {
+
+// Structure of arrays mirror of the pin locations and net boxes used by the
+// weighted average (WA) wirelength model.  Pins are stored net by net: the
+// pins of net n are the slots [netStart(n), netStart(n + 1)).
+//
+// compute() runs four passes:
+//   net boxes         - per net over its contiguous pins
+//   exponentials      - vectorized over all pins
+//   exponential sums  - per net over its contiguous pins
+//   pin gradients     - vectorized over all pins
+// The results match the per-object GPin/GNet computation bit for bit, so
+// the kernels may be switched freely.
+class WaGradient
+{
+ public:
+  enum class Kernel
+  {
+    Scalar,
+    Avx2,
+    Avx512
+  };
+
+  // The widest kernel supported by the CPU.
+  static Kernel bestKernel();
+  static bool isSupported(Kernel kernel);
+  static const char* kernelName(Kernel kernel);
+
+  // netSizes[n] is the number of pins of net n
+  void init(const std::vector<int>& netSizes);
+
+  int numNets() const { return (int) netStart_.size() - 1; }
+  int numPins() const { return netStart_.back(); }
+  int netStart(int net) const { return netStart_[net]; }
+
+  void setPinLocation(int slot, int x, int y)
+  {
+    pinX_[slot] = x;
+    pinY_[slot] = y;
+  }
+
+  // Updates the net boxes and the WA gradient of every pin.
+  // minForceBar: exponents at or below it are treated as zero.
+  void compute(float wlCoeffX,
+               float wlCoeffY,
+               float minForceBar,
+               int numThreads,
+               Kernel kernel);
+
+  int netLx(int net) const { return netLx_[net]; }
+  int netLy(int net) const { return netLy_[net]; }
+  int netUx(int net) const { return netUx_[net]; }
+  int netUy(int net) const { return netUy_[net]; }
+
+  // exp terms of the pin in slot, zero if the pin is not part of the sum
+  float expMinX(int slot) const { return expMinX_[slot]; }
+  float expMaxX(int slot) const { return expMaxX_[slot]; }
+  float expMinY(int slot) const { return expMinY_[slot]; }
+  float expMaxY(int slot) const { return expMaxY_[slot]; }
+
+  // Unweighted WA gradient of the pin in slot
+  float gradientX(int slot) const { return gradX_[slot]; }
+  float gradientY(int slot) const { return gradY_[slot]; }
+
+ private:
+  void updateBoxes(int firstNet, int lastNet);
+  void updateSums(int firstNet, int lastNet);
+
+  std::vector<int> netStart_{0};
+
+  // per pin
+  AlignedVector<int> pinNet_;
+  AlignedVector<int> pinX_;
+  AlignedVector<int> pinY_;
+  AlignedVector<float> expMinX_;
+  AlignedVector<float> expMaxX_;
+  AlignedVector<float> expMinY_;
+  AlignedVector<float> expMaxY_;
+  AlignedVector<float> gradX_;
+  AlignedVector<float> gradY_;
+
+  // per net
+  AlignedVector<int> netLx_;
+  AlignedVector<int> netLy_;
+  AlignedVector<int> netUx_;
+  AlignedVector<int> netUy_;
+  // sum(exp) and sum(x * exp) for the min/max terms of both directions
+  AlignedVector<float> expMinSumX_;
+  AlignedVector<float> xExpMinSumX_;
+  AlignedVector<float> expMaxSumX_;
+  AlignedVector<float> xExpMaxSumX_;
+  AlignedVector<float> expMinSumY_;
+  AlignedVector<float> yExpMinSumY_;
+  AlignedVector<float> expMaxSumY_;
+  AlignedVector<float> yExpMaxSumY_;
+};
+
+}  // namespace gpl
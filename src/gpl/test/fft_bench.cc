@@ -0,0 +1,48 @@
+// Times FFT::doFFT for the available FFT backends on square bin grids from
+// 256x256 to 4096x4096.
+//
+// usage: fft_bench [threads] [iterations]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+#include "src/gpl/src/fft.h"
+
+int main(int argc, char* argv[])
+{
+  const int numThreads = argc > 1 ? std::atoi(argv[1]) : 8;
+  const int iterations = argc > 2 ? std::atoi(argv[2]) : 3;
+
+  std::printf("threads %d\n", numThreads);
+  std::printf("%10s %10s %12s\n", "grid", "backend", "ms/doFFT");
+  for (int cnt = 256; cnt <= 4096; cnt *= 2) {
+    for (auto type :
+         {gpl::FFTBackend::Type::Ooura, gpl::FFTBackend::Type::Threaded}) {
+      gpl::FFT fft(cnt, cnt, 1000, 1000, numThreads, type);
+
+      std::mt19937 rng(1);
+      std::uniform_real_distribution<float> density(0.0f, 2.0f);
+      for (int x = 0; x < cnt; x++) {
+        for (int y = 0; y < cnt; y++) {
+          fft.updateDensity(x, y, density(rng));
+        }
+      }
+      fft.doFFT();  // warm up
+
+      const auto start = std::chrono::steady_clock::now();
+      for (int i = 0; i < iterations; i++) {
+        fft.doFFT();
+      }
+      const std::chrono::duration<double, std::milli> elapsed
+          = std::chrono::steady_clock::now() - start;
+      std::printf("%5dx%-4d %10s %12.2f\n",
+                  cnt,
+                  cnt,
+                  gpl::FFTBackend::typeName(type),
+                  elapsed.count() / iterations);
+    }
+  }
+  return 0;
+}
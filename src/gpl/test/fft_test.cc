@@ -2,6 +2,7 @@
 
 #include <iostream>
 #include <memory>
+#include <random>
 #include <sstream>
 
 #include "gtest/gtest.h"
@@ -120,9 +121,24 @@ void print_tables(std::unique_ptr<gpl::FFT>& fft)
   std::cout << out_el_phi.str();
 }
 
+void check_tables(std::unique_ptr<gpl::FFT>& fft)
+{
+  for (int y = 0; y < Y_MAX; y++) {
+    for (int x = 0; x < X_MAX; x++) {
+      auto eForce = fft->getElectroForce(x, y);
+      auto electroPhi = fft->getElectroPhi(x, y);
+
+      EXPECT_EQ(eForce.first, output_data_eForce_first[x + y * Y_MAX]);
+      EXPECT_EQ(eForce.second, output_data_eForce_second[x + y * Y_MAX]);
+      EXPECT_EQ(electroPhi, output_data_electroPhi[x + y * Y_MAX]);
+    }
+  }
+}
+
 TEST(FloatFFTTest, Basic)
 {
-  std::unique_ptr<gpl::FFT> fft(new gpl::FFT(X_MAX, Y_MAX, X_MAX, Y_MAX));
+  std::unique_ptr<gpl::FFT> fft(new gpl::FFT(
+      X_MAX, Y_MAX, X_MAX, Y_MAX, 1, gpl::FFTBackend::Type::Ooura));
 
   for (int y = 0; y < Y_MAX; y++) {
     for (int x = 0; x < X_MAX; x++) {
@@ -134,14 +150,53 @@ TEST(FloatFFTTest, Basic)
 
   print_tables(fft);
 
+  check_tables(fft);
+}
+
+TEST(FloatFFTTest, Threaded)
+{
+  std::unique_ptr<gpl::FFT> fft(new gpl::FFT(
+      X_MAX, Y_MAX, X_MAX, Y_MAX, 4, gpl::FFTBackend::Type::Threaded));
+
   for (int y = 0; y < Y_MAX; y++) {
     for (int x = 0; x < X_MAX; x++) {
-      auto eForce = fft->getElectroForce(x, y);
-      auto electroPhi = fft->getElectroPhi(x, y);
+      fft->updateDensity(x, y, input_data[x + y * Y_MAX]);
+    }
+  }
 
-      EXPECT_EQ(eForce.first, output_data_eForce_first[x + y * Y_MAX]);
-      EXPECT_EQ(eForce.second, output_data_eForce_second[x + y * Y_MAX]);
-      EXPECT_EQ(electroPhi, output_data_electroPhi[x + y * Y_MAX]);
+  fft->doFFT();
+
+  check_tables(fft);
+}
+
+// The threaded backend must match the Ooura 2D routines exactly, also on
+// non square grids and across repeated transforms.
+TEST(FloatFFTTest, ThreadedMatchesOoura)
+{
+  const int cnt_x = 256;
+  const int cnt_y = 64;
+  gpl::FFT ooura(cnt_x, cnt_y, 10, 20, 1, gpl::FFTBackend::Type::Ooura);
+  gpl::FFT threaded(cnt_x, cnt_y, 10, 20, 8, gpl::FFTBackend::Type::Threaded);
+
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<float> density(0.0f, 2.0f);
+  for (int iter = 0; iter < 3; iter++) {
+    for (int x = 0; x < cnt_x; x++) {
+      for (int y = 0; y < cnt_y; y++) {
+        const float d = density(rng);
+        ooura.updateDensity(x, y, d);
+        threaded.updateDensity(x, y, d);
+      }
+    }
+    ooura.doFFT();
+    threaded.doFFT();
+
+    for (int x = 0; x < cnt_x; x++) {
+      for (int y = 0; y < cnt_y; y++) {
+        ASSERT_EQ(threaded.getElectroPhi(x, y), ooura.getElectroPhi(x, y));
+        ASSERT_EQ(threaded.getElectroForce(x, y),
+                  ooura.getElectroForce(x, y));
+      }
     }
   }
 }
@@ -0,0 +1,99 @@
+// Compares the weighted average (WA) wirelength gradient kernels against the
+// per object GNet/GPin computation.
+//
+// usage: wa_gradient_bench [num_nets] [max_degree] [iterations] [threads]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <vector>
+
+#include "src/gpl/src/waGradient.h"
+#include "wa_reference.h"
+
+namespace {
+
+using gpl::WaGradient;
+namespace ref = gpl::wa_reference;
+
+double timeIt(int iterations, const std::function<void()>& func)
+{
+  func();  // warm up
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; i++) {
+    func();
+  }
+  const std::chrono::duration<double, std::milli> elapsed
+      = std::chrono::steady_clock::now() - start;
+  return elapsed.count() / iterations;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+  const int numNets = argc > 1 ? std::atoi(argv[1]) : 500000;
+  const int maxDegree = argc > 2 ? std::atoi(argv[2]) : 8;
+  const int iterations = argc > 3 ? std::atoi(argv[3]) : 20;
+  const int numThreads = argc > 4 ? std::atoi(argv[4]) : 1;
+  const float wlCoeff = 1e-3f;
+  const float minForceBar = -300;
+
+  ref::Design design = ref::makeDesign(numNets, maxDegree, 1000000, 1);
+  std::printf("nets %d pins %zu threads %d\n",
+              numNets,
+              design.pins.size(),
+              numThreads);
+
+  // The reference updates the nets and then visits the pins through their
+  // cells, i.e. in allocation order.
+  float sink = 0;
+  const double refTime = timeIt(iterations, [&]() {
+    ref::updateWireLengthForceWA(design, wlCoeff, wlCoeff, minForceBar);
+    for (const auto& pin : design.pins) {
+      const auto [x, y]
+          = ref::getWireLengthGradientPinWA(pin.get(), wlCoeff, wlCoeff);
+      sink += x + y;
+    }
+  });
+  std::printf("%-10s %10.3f ms\n", "reference", refTime);
+
+  std::vector<int> netSizes;
+  for (const ref::Net& net : design.nets) {
+    netSizes.push_back(net.pins.size());
+  }
+  WaGradient wa;
+  wa.init(netSizes);
+  std::vector<const ref::Pin*> slotPins;
+  for (const ref::Net& net : design.nets) {
+    for (const ref::Pin* pin : net.pins) {
+      slotPins.push_back(pin);
+    }
+  }
+
+  for (auto kernel : {WaGradient::Kernel::Scalar,
+                      WaGradient::Kernel::Avx2,
+                      WaGradient::Kernel::Avx512}) {
+    if (!WaGradient::isSupported(kernel)) {
+      std::printf("%-10s not supported\n", WaGradient::kernelName(kernel));
+      continue;
+    }
+    // includes copying the pin locations in, as the placer does
+    const double time = timeIt(iterations, [&]() {
+      for (size_t slot = 0; slot < slotPins.size(); slot++) {
+        wa.setPinLocation(slot, slotPins[slot]->cx, slotPins[slot]->cy);
+      }
+      wa.compute(wlCoeff, wlCoeff, minForceBar, numThreads, kernel);
+      for (size_t slot = 0; slot < slotPins.size(); slot++) {
+        sink += wa.gradientX(slot) + wa.gradientY(slot);
+      }
+    });
+    std::printf("%-10s %10.3f ms  %5.2fx\n",
+                WaGradient::kernelName(kernel),
+                time,
+                refTime / time);
+  }
+
+  return sink == 0.5f;  // keep the results alive
+}
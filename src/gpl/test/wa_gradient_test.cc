@@ -0,0 +1,96 @@
+#include "src/gpl/src/waGradient.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "wa_reference.h"
+
+namespace {
+
+using gpl::WaGradient;
+namespace ref = gpl::wa_reference;
+
+void load(WaGradient& wa, const ref::Design& design)
+{
+  std::vector<int> netSizes;
+  for (const ref::Net& net : design.nets) {
+    netSizes.push_back(net.pins.size());
+  }
+  wa.init(netSizes);
+  for (size_t i = 0; i < design.nets.size(); i++) {
+    int slot = wa.netStart(i);
+    for (const ref::Pin* pin : design.nets[i].pins) {
+      wa.setPinLocation(slot++, pin->cx, pin->cy);
+    }
+  }
+}
+
+// The kernels must reproduce the per object computation exactly.
+void check(ref::Design& design,
+           float wlCoeffX,
+           float wlCoeffY,
+           float minForceBar,
+           int numThreads)
+{
+  ref::updateWireLengthForceWA(design, wlCoeffX, wlCoeffY, minForceBar);
+
+  WaGradient wa;
+  load(wa, design);
+  for (auto kernel : {WaGradient::Kernel::Scalar,
+                      WaGradient::Kernel::Avx2,
+                      WaGradient::Kernel::Avx512}) {
+    if (!WaGradient::isSupported(kernel)) {
+      continue;
+    }
+    SCOPED_TRACE(WaGradient::kernelName(kernel));
+    wa.compute(wlCoeffX, wlCoeffY, minForceBar, numThreads, kernel);
+    for (size_t i = 0; i < design.nets.size(); i++) {
+      const ref::Net& net = design.nets[i];
+      EXPECT_EQ(wa.netLx(i), net.lx);
+      EXPECT_EQ(wa.netLy(i), net.ly);
+      EXPECT_EQ(wa.netUx(i), net.ux);
+      EXPECT_EQ(wa.netUy(i), net.uy);
+      int slot = wa.netStart(i);
+      for (const ref::Pin* pin : net.pins) {
+        const auto [x, y]
+            = ref::getWireLengthGradientPinWA(pin, wlCoeffX, wlCoeffY);
+        ASSERT_EQ(wa.gradientX(slot), x) << "net " << i << " slot " << slot;
+        ASSERT_EQ(wa.gradientY(slot), y) << "net " << i << " slot " << slot;
+        slot++;
+      }
+    }
+  }
+}
+
+TEST(WaGradientTest, MatchesReference)
+{
+  ref::Design design = ref::makeDesign(20000, 12, 1000000, 1);
+  for (float coeff : {1e-5f, 1e-3f, 0.02f}) {
+    SCOPED_TRACE(coeff);
+    check(design, coeff, coeff * 1.5f, -300, 1);
+  }
+}
+
+TEST(WaGradientTest, MatchesReferenceMultiThreaded)
+{
+  ref::Design design = ref::makeDesign(50000, 30, 1000000, 2);
+  check(design, 1e-3f, 2e-3f, -300, 4);
+}
+
+TEST(WaGradientTest, ForceBar)
+{
+  // a high bar drops most of the exponentials
+  ref::Design design = ref::makeDesign(1000, 8, 100000, 3);
+  check(design, 0.01f, 0.01f, -1, 2);
+}
+
+TEST(WaGradientTest, Empty)
+{
+  WaGradient wa;
+  wa.init({});
+  EXPECT_EQ(wa.numNets(), 0);
+  EXPECT_EQ(wa.numPins(), 0);
+  wa.compute(1e-3f, 1e-3f, -300, 2, WaGradient::bestKernel());
+}
+
+}  // namespace
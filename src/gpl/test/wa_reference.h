@@ -0,0 +1,200 @@
+// Per object replica of the weighted average (WA) wirelength gradient as
+// computed by GNet/GPin before the structure of arrays version.  Used as the
+// reference by wa_gradient_test and wa_gradient_bench.
+
+#pragma once
+
+#include <algorithm>
+#include <climits>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace gpl::wa_reference {
+
+struct Net;
+
+struct Pin
+{
+  int cx = 0;
+  int cy = 0;
+  Net* net = nullptr;
+
+  float minExpSumX = 0;
+  float maxExpSumX = 0;
+  float minExpSumY = 0;
+  float maxExpSumY = 0;
+  bool hasMinExpSumX = false;
+  bool hasMaxExpSumX = false;
+  bool hasMinExpSumY = false;
+  bool hasMaxExpSumY = false;
+};
+
+struct Net
+{
+  std::vector<Pin*> pins;
+  int lx = 0;
+  int ly = 0;
+  int ux = 0;
+  int uy = 0;
+
+  float waExpMinSumX = 0;
+  float waXExpMinSumX = 0;
+  float waExpMaxSumX = 0;
+  float waXExpMaxSumX = 0;
+  float waExpMinSumY = 0;
+  float waYExpMinSumY = 0;
+  float waExpMaxSumY = 0;
+  float waYExpMaxSumY = 0;
+};
+
+// Pins are allocated individually and in random order, as the pins of a
+// net are scattered in memory in the placer.
+struct Design
+{
+  std::vector<std::unique_ptr<Pin>> pins;
+  std::vector<Net> nets;
+};
+
+inline Design makeDesign(int numNets, int maxDegree, int dieSize, int seed)
+{
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<int> degree(1, maxDegree);
+  std::uniform_int_distribution<int> coord(0, dieSize);
+  std::uniform_int_distribution<int> spread(0, dieSize / 50);
+
+  Design design;
+  design.nets.resize(numNets);
+  std::vector<Net*> pinNets;
+  for (Net& net : design.nets) {
+    const int n = degree(rng);
+    for (int i = 0; i < n; i++) {
+      pinNets.push_back(&net);
+    }
+  }
+  std::shuffle(pinNets.begin(), pinNets.end(), rng);
+
+  for (Net* net : pinNets) {
+    auto pin = std::make_unique<Pin>();
+    pin->net = net;
+    net->pins.push_back(pin.get());
+    design.pins.push_back(std::move(pin));
+  }
+  for (Net& net : design.nets) {
+    const int x = coord(rng);
+    const int y = coord(rng);
+    for (Pin* pin : net.pins) {
+      pin->cx = x + spread(rng);
+      pin->cy = y + spread(rng);
+    }
+  }
+  return design;
+}
+
+inline float fastExp(float exp)
+{
+  exp = 1.0f + exp / 1024.0f;
+  for (int i = 0; i < 10; i++) {
+    exp *= exp;
+  }
+  return exp;
+}
+
+inline void updateWireLengthForceWA(Design& design,
+                                    float wlCoeffX,
+                                    float wlCoeffY,
+                                    float minForceBar)
+{
+  for (auto& pin : design.pins) {
+    pin->hasMinExpSumX = pin->hasMaxExpSumX = false;
+    pin->hasMinExpSumY = pin->hasMaxExpSumY = false;
+    pin->minExpSumX = pin->maxExpSumX = 0;
+    pin->minExpSumY = pin->maxExpSumY = 0;
+  }
+
+  for (Net& net : design.nets) {
+    net.waExpMinSumX = net.waXExpMinSumX = 0;
+    net.waExpMaxSumX = net.waXExpMaxSumX = 0;
+    net.waExpMinSumY = net.waYExpMinSumY = 0;
+    net.waExpMaxSumY = net.waYExpMaxSumY = 0;
+
+    net.lx = net.ly = INT_MAX;
+    net.ux = net.uy = INT_MIN;
+    for (Pin* pin : net.pins) {
+      net.lx = std::min(pin->cx, net.lx);
+      net.ly = std::min(pin->cy, net.ly);
+      net.ux = std::max(pin->cx, net.ux);
+      net.uy = std::max(pin->cy, net.uy);
+    }
+
+    for (Pin* pin : net.pins) {
+      const float expMinX = (net.lx - pin->cx) * wlCoeffX;
+      const float expMaxX = (pin->cx - net.ux) * wlCoeffX;
+      const float expMinY = (net.ly - pin->cy) * wlCoeffY;
+      const float expMaxY = (pin->cy - net.uy) * wlCoeffY;
+
+      if (expMinX > minForceBar) {
+        pin->hasMinExpSumX = true;
+        pin->minExpSumX = fastExp(expMinX);
+        net.waExpMinSumX += pin->minExpSumX;
+        net.waXExpMinSumX += pin->cx * pin->minExpSumX;
+      }
+      if (expMaxX > minForceBar) {
+        pin->hasMaxExpSumX = true;
+        pin->maxExpSumX = fastExp(expMaxX);
+        net.waExpMaxSumX += pin->maxExpSumX;
+        net.waXExpMaxSumX += pin->cx * pin->maxExpSumX;
+      }
+      if (expMinY > minForceBar) {
+        pin->hasMinExpSumY = true;
+        pin->minExpSumY = fastExp(expMinY);
+        net.waExpMinSumY += pin->minExpSumY;
+        net.waYExpMinSumY += pin->cy * pin->minExpSumY;
+      }
+      if (expMaxY > minForceBar) {
+        pin->hasMaxExpSumY = true;
+        pin->maxExpSumY = fastExp(expMaxY);
+        net.waExpMaxSumY += pin->maxExpSumY;
+        net.waYExpMaxSumY += pin->cy * pin->maxExpSumY;
+      }
+    }
+  }
+}
+
+// Returns the x and y gradient of the pin.
+inline std::pair<float, float> getWireLengthGradientPinWA(const Pin* pin,
+                                                         float wlCoeffX,
+                                                         float wlCoeffY)
+{
+  const Net* net = pin->net;
+  float gradientMinX = 0, gradientMinY = 0;
+  float gradientMaxX = 0, gradientMaxY = 0;
+
+  if (pin->hasMinExpSumX) {
+    gradientMinX
+        = (net->waExpMinSumX * (pin->minExpSumX * (1.0 - wlCoeffX * pin->cx))
+           + wlCoeffX * pin->minExpSumX * net->waXExpMinSumX)
+          / (net->waExpMinSumX * net->waExpMinSumX);
+  }
+  if (pin->hasMaxExpSumX) {
+    gradientMaxX
+        = (net->waExpMaxSumX * (pin->maxExpSumX * (1.0 + wlCoeffX * pin->cx))
+           - wlCoeffX * pin->maxExpSumX * net->waXExpMaxSumX)
+          / (net->waExpMaxSumX * net->waExpMaxSumX);
+  }
+  if (pin->hasMinExpSumY) {
+    gradientMinY
+        = (net->waExpMinSumY * (pin->minExpSumY * (1.0 - wlCoeffY * pin->cy))
+           + wlCoeffY * pin->minExpSumY * net->waYExpMinSumY)
+          / (net->waExpMinSumY * net->waExpMinSumY);
+  }
+  if (pin->hasMaxExpSumY) {
+    gradientMaxY
+        = (net->waExpMaxSumY * (pin->maxExpSumY * (1.0 + wlCoeffY * pin->cy))
+           - wlCoeffY * pin->maxExpSumY * net->waYExpMaxSumY)
+          / (net->waExpMaxSumY * net->waExpMaxSumY);
+  }
+  return {gradientMinX - gradientMaxX, gradientMinY - gradientMaxY};
+}
+
+}  // namespace gpl::wa_reference
@@ -182,6 +182,8 @@ class GlobalRouter : public ant::GlobalRouteSource
   void setCongestionReportFile(const char* file_name);
   void setGridOrigin(int x, int y);
   void setAllowCongestion(bool allow_congestion);
+  void setParallelMaze(bool parallel_maze);
+  void setNumThreads(int num_threads);
   void setMacroExtension(int macro_extension);
 
   // flow functions
@@ -478,6 +480,8 @@ class GlobalRouter : public ant::GlobalRouteSource
   int overflow_iterations_;
   int congestion_report_iter_step_;
   bool allow_congestion_;
+  bool parallel_maze_;
+  int num_threads_;
   std::vector<int> vertical_capacities_;
   std::vector<int> horizontal_capacities_;
   int macro_extension_;
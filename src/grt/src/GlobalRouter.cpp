@@ -97,6 +97,8 @@ GlobalRouter::GlobalRouter()
       overflow_iterations_(50),
       congestion_report_iter_step_(0),
       allow_congestion_(false),
+      parallel_maze_(false),
+      num_threads_(1),
       macro_extension_(0),
       initialized_(false),
       total_diodes_count_(0),
@@ -1758,6 +1760,16 @@ void GlobalRouter::setAllowCongestion(bool allow_congestion)
   allow_congestion_ = allow_congestion;
 }
 
+void GlobalRouter::setParallelMaze(bool parallel_maze)
+{
+  parallel_maze_ = parallel_maze;
+}
+
+void GlobalRouter::setNumThreads(int num_threads)
+{
+  num_threads_ = num_threads;
+}
+
 void GlobalRouter::setMacroExtension(int macro_extension)
 {
   macro_extension_ = macro_extension;
@@ -1849,6 +1861,8 @@ void GlobalRouter::ensureLayerForGuideDimension(int max_routing_layer)
 void GlobalRouter::configFastRoute()
 {
   fastroute_->setVerbose(verbose_);
+  fastroute_->setParallelMaze(parallel_maze_);
+  fastroute_->setNumThreads(num_threads_);
   fastroute_->setOverflowIterations(overflow_iterations_);
   fastroute_->setCongestionReportIterStep(congestion_report_iter_step_);
 
@@ -4665,7 +4679,6 @@ std::vector<Net*> GlobalRouter::updateDirtyRoutes(bool save_guides)
         = findRouting(dirty_nets, min_routing_layer_, max_routing_layer_);
     mergeResults(new_route);
 
-    bool reroutingOverflow = true;
     if (fastroute_->has2Doverflow() && !allow_congestion_) {
       // The maximum number of times that the nets traversing the congestion
       // area will be added
@@ -4676,10 +4689,16 @@ std::vector<Net*> GlobalRouter::updateDirtyRoutes(bool save_guides)
       for (auto& it : dirty_nets) {
         congestion_nets.insert(it->getDbNet());
       }
-      while (fastroute_->has2Doverflow() && reroutingOverflow && add_max >= 0) {
+      while (fastroute_->has2Doverflow() && add_max >= 0) {
         // The nets that cross the congestion area are obtained and added to
         // the set
+        const int old_size = congestion_nets.size();
         fastroute_->getCongestionNets(congestion_nets);
+        // Rerouting the same nets again does not remove the overflow, so
+        // skip to the last attempt instead of repeating it
+        if (congestion_nets.size() == old_size) {
+          add_max = 0;
+        }
         // When every attempt to increase the congestion region failed, try
         // legalizing the buffers inserted
         if (add_max == 0) {
@@ -148,6 +148,12 @@ set_allow_congestion(bool allowCongestion)
   getGlobalRouter()->setAllowCongestion(allowCongestion);
 }
 
+void
+set_parallel_maze(bool parallel_maze)
+{
+  getGlobalRouter()->setParallelMaze(parallel_maze);
+}
+
 void
 set_clock_layer_range(int minLayer, int maxLayer)
 {
@@ -188,6 +194,7 @@ set_perturbation_amount(int perturbation)
 void
 global_route(bool start_incremental, bool end_incremental)
 {
+  getGlobalRouter()->setNumThreads(ord::OpenRoad::openRoad()->getThreadCount());
   getGlobalRouter()->globalRoute(true, start_incremental, end_incremental);
 }
 
@@ -198,6 +198,7 @@ sta::define_cmd_args "global_route" {[-guide_file out_file] \
                                   [-allow_congestion] \
                                   [-allow_overflow] \
                                   [-overflow_iterations iterations] \
+                                  [-parallel_maze] \
                                   [-verbose] \
                                   [-start_incremental] \
                                   [-end_incremental]
@@ -208,7 +209,7 @@ proc global_route { args } {
     keys {-guide_file -congestion_iterations -congestion_report_file \
           -overflow_iterations -grid_origin -critical_nets_percentage -congestion_report_iter_step
          } \
-    flags {-allow_congestion -allow_overflow -verbose -start_incremental -end_incremental}
+    flags {-allow_congestion -allow_overflow -parallel_maze -verbose -start_incremental -end_incremental}
 
   sta::check_argc_eq0 "global_route" $args
 
@@ -275,6 +276,8 @@ proc global_route { args } {
     || [info exists flags(-allow_overflow)]]
   grt::set_allow_congestion $allow_congestion
 
+  grt::set_parallel_maze [info exists flags(-parallel_maze)]
+
   set start_incremental [info exists flags(-start_incremental)]
   set end_incremental [info exists flags(-end_incremental)]
 
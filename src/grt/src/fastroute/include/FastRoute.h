@@ -69,6 +69,7 @@ class Gui;
 }
 
 using boost::multi_array;
+using boost::multi_array_ref;
 using boost::icl::interval;
 using boost::icl::interval_set;
 
@@ -99,6 +100,23 @@ struct parent3D
   int x, y;
 };
 
+// Per-thread state used by the 2D maze router to reroute a single net.
+struct MazeNetScratch
+{
+  std::vector<double*> src_heap;
+  std::vector<double*> dest_heap;
+  std::vector<OrderNetEdge> net_eo;
+  // Storage of the distance arrays, sized to the largest region searched
+  // so far rather than to the grid.
+  std::vector<double> d1;
+  std::vector<double> d2;
+  std::vector<char> pop_heap2;
+  // GCell edges that received usage while routing, merged into
+  // h_used_ggrid_/v_used_ggrid_ by commitUsedGGrids.
+  std::vector<std::pair<int, int>> h_used_ggrid;
+  std::vector<std::pair<int, int>> v_used_ggrid;
+};
+
 class FastRouteCore
 {
  public:
@@ -201,6 +219,8 @@ class FastRouteCore
   void incrementEdge3DUsage(int x1, int y1, int x2, int y2, int layer);
   void setMaxNetDegree(int);
   void setVerbose(bool v);
+  void setParallelMaze(bool parallel_maze);
+  void setNumThreads(int num_threads);
   void setCriticalNetsPercentage(float u);
   float getCriticalNetsPercentage() { return critical_nets_percentage_; };
   void setMakeWireParasiticsBuilder(AbstractMakeWireParasitics* builder);
@@ -268,16 +288,35 @@ class FastRouteCore
                      const int slope,
                      const int L,
                      float& slack_th);
+  bool mazeRouteMSMDNet(const int netID,
+                        const int iter,
+                        const int expand,
+                        const float cost_height,
+                        const int ripup_threshold,
+                        const int maze_edge_threshold,
+                        const int cost_type,
+                        const float logis_cof,
+                        const int via,
+                        const int slope,
+                        const int L,
+                        const float slack_th,
+                        const odb::Rect& window,
+                        MazeNetScratch& scratch);
+  odb::Rect mazeNetWindow(const int netID, const int iter, const int expand);
+  std::vector<std::vector<int>> mazeNetBatches(const std::vector<int>& nets,
+                                               const int iter,
+                                               const int expand,
+                                               std::vector<odb::Rect>& windows);
+  void commitUsedGGrids(MazeNetScratch& scratch);
   void convertToMazeroute();
   void updateCongestionHistory(const int upType, bool stopDEC, int& max_adj);
   int getOverflow2D(int* maxOverflow);
   int getOverflow2Dmaze(int* maxOverflow, int* tUsage);
   int getOverflow3D();
   void setCongestionNets(std::set<odb::dbNet*>& congestion_nets,
-                         int& posX,
-                         int& posY,
-                         int dir,
-                         int& radius);
+                         const std::vector<std::pair<int, int>>& h_congested,
+                         const std::vector<std::pair<int, int>>& v_congested,
+                         int radius);
   void str_accu(const int rnd);
   void InitLastUsage(const int upType);
   void InitEstUsage();
@@ -306,8 +345,8 @@ class FastRouteCore
                  const int edgeID,
                  std::vector<double*>& src_heap,
                  std::vector<double*>& dest_heap,
-                 multi_array<double, 2>& d1,
-                 multi_array<double, 2>& d2,
+                 multi_array_ref<double, 2>& d1,
+                 multi_array_ref<double, 2>& d2,
                  const int regionX1,
                  const int regionX2,
                  const int regionY1,
@@ -350,17 +389,17 @@ class FastRouteCore
                          int n1,
                          int n2,
                          std::vector<int*>& points_heap_3D,
-                         multi_array<int, 3>& dist_3D,
-                         multi_array<Direction, 3>& directions_3D,
-                         multi_array<int, 3>& corr_edge_3D);
+                         multi_array_ref<int, 3>& dist_3D,
+                         multi_array_ref<Direction, 3>& directions_3D,
+                         multi_array_ref<int, 3>& corr_edge_3D);
   void setupHeap3D(int netID,
                    int edgeID,
                    std::vector<int*>& src_heap_3D,
                    std::vector<int*>& dest_heap_3D,
-                   multi_array<Direction, 3>& directions_3D,
-                   multi_array<int, 3>& corr_edge_3D,
-                   multi_array<int, 3>& d1_3D,
-                   multi_array<int, 3>& d2_3D,
+                   multi_array_ref<Direction, 3>& directions_3D,
+                   multi_array_ref<int, 3>& corr_edge_3D,
+                   multi_array_ref<int, 3>& d1_3D,
+                   multi_array_ref<int, 3>& d2_3D,
                    int regionX1,
                    int regionX2,
                    int regionY1,
@@ -445,8 +484,8 @@ class FastRouteCore
   void spiralRoute(int netID, int edgeID);
   void routeMonotonic(int netID,
                       int edgeID,
-                      multi_array<double, 2>& d1,
-                      multi_array<double, 2>& d2,
+                      std::vector<double>& d1_pool,
+                      std::vector<double>& d2_pool,
                       int threshold,
                       int enlarge);
 
@@ -515,7 +554,7 @@ class FastRouteCore
   float CalculatePartialSlack();
   bool checkRoute2DTree(int netID);
   void removeLoops();
-  void netedgeOrderDec(int netID);
+  void netedgeOrderDec(int netID, std::vector<OrderNetEdge>& net_eo);
   void printTree2D(int netID);
   void printEdge2D(int netID, int edgeID);
   void printEdge3D(int netID, int edgeID);
@@ -565,15 +604,15 @@ class FastRouteCore
   int x_corner_;
   int y_corner_;
   int tile_size_;
-  int enlarge_;
   int costheight_;
   int ahth_;
   std::vector<int> route_net_ids_;  // IDs of nets to route
   int num_layers_;
   int total_overflow_;  // total # overflow
   bool has_2D_overflow_;
-  int grid_hv_;
   bool verbose_;
+  bool parallel_maze_;
+  int num_threads_;
   float critical_nets_percentage_;
   int via_cost_;
   int mazeedge_threshold_;
@@ -603,7 +642,6 @@ class FastRouteCore
 
   std::vector<FrNet*> nets_;
   std::unordered_map<odb::dbNet*, int> db_net_id_map_;  // db net -> net id
-  std::vector<OrderNetEdge> net_eo_;
   std::vector<std::vector<int>>
       gxs_;  // the copy of xs for nets, used for second FLUTE
   std::vector<std::vector<int>>
@@ -626,7 +664,10 @@ class FastRouteCore
   multi_array<bool, 2> hv_;
   multi_array<bool, 2> hyper_v_;
   multi_array<bool, 2> hyper_h_;
-  multi_array<bool, 2> in_region_;
+  multi_array<bool, 2> in_region_;  // all false outside of setupHeap*
+  // One per maze thread, kept between passes so that the heaps are not
+  // reallocated for every incremental update.
+  std::vector<MazeNetScratch> maze_scratch_;
 
   std::vector<StTree> sttrees_;  // the Steiner trees
   std::vector<StTree> sttrees_bk_;
@@ -646,15 +687,17 @@ class FastRouteCore
   std::set<std::pair<int, int>> v_used_ggrid_;
   std::vector<int> net_ids_;
 
-  // Maze 3D variables
-  multi_array<Direction, 3> directions_3D_;
-  multi_array<int, 3> corr_edge_3D_;
-  multi_array<parent3D, 3> pr_3D_;
+  // Maze 3D variables. The pools back (Layer, Y, X) views of the enlarged
+  // region of the edge being routed and only grow, so rerouting a few nets
+  // does not pay for grid sized allocations.
+  std::vector<Direction> directions_3D_pool_;
+  std::vector<int> corr_edge_3D_pool_;
+  std::vector<parent3D> pr_3D_pool_;
   std::vector<bool> pop_heap2_3D_;
   std::vector<int*> src_heap_3D_;
   std::vector<int*> dest_heap_3D_;
-  multi_array<int, 3> d1_3D_;
-  multi_array<int, 3> d2_3D_;
+  std::vector<int> d1_3D_pool_;
+  std::vector<int> d2_3D_pool_;
 };
 
 }  // namespace grt
@@ -68,14 +68,14 @@ FastRouteCore::FastRouteCore(odb::dbDatabase* db,
       x_corner_(0),
       y_corner_(0),
       tile_size_(0),
-      enlarge_(0),
       costheight_(0),
       ahth_(0),
       num_layers_(0),
       total_overflow_(0),
       has_2D_overflow_(false),
-      grid_hv_(0),
       verbose_(false),
+      parallel_maze_(false),
+      num_threads_(1),
       critical_nets_percentage_(10),
       via_cost_(0),
       mazeedge_threshold_(0),
@@ -124,7 +124,14 @@ void FastRouteCore::clear()
   parent_x3_.resize(boost::extents[0][0]);
   parent_y3_.resize(boost::extents[0][0]);
 
-  net_eo_.clear();
+  maze_scratch_.clear();
+
+  directions_3D_pool_.clear();
+  corr_edge_3D_pool_.clear();
+  pr_3D_pool_.clear();
+  d1_3D_pool_.clear();
+  d2_3D_pool_.clear();
+  pop_heap2_3D_.clear();
 
   xcor_.clear();
   ycor_.clear();
@@ -697,28 +704,15 @@ void FastRouteCore::initAuxVar()
 {
   tree_order_cong_.clear();
 
-  grid_hv_ = x_range_ * y_range_;
-
-  parent_x1_.resize(boost::extents[y_grid_][x_grid_]);
-  parent_y1_.resize(boost::extents[y_grid_][x_grid_]);
-  parent_x3_.resize(boost::extents[y_grid_][x_grid_]);
-  parent_y3_.resize(boost::extents[y_grid_][x_grid_]);
-
-  // maze3D variables
-  directions_3D_.resize(boost::extents[num_layers_][y_grid_][x_grid_]);
-  corr_edge_3D_.resize(boost::extents[num_layers_][y_grid_][x_grid_]);
-  pr_3D_.resize(boost::extents[num_layers_][y_grid_][x_grid_]);
-
-  int64 total_size = static_cast<int64>(num_layers_) * y_range_ * x_range_;
-  pop_heap2_3D_.resize(total_size, false);
-
-  // allocate memory for priority queue
-  total_size = static_cast<int64>(y_grid_) * x_grid_ * num_layers_;
-  src_heap_3D_.resize(total_size);
-  dest_heap_3D_.resize(total_size);
-
-  d1_3D_.resize(boost::extents[num_layers_][y_range_][x_range_]);
-  d2_3D_.resize(boost::extents[num_layers_][y_range_][x_range_]);
+  // The scratch arrays below are overwritten before they are read, so they
+  // are only reallocated when the grid changes. Incremental routing calls
+  // this for every update and must not pay for grid sized allocations.
+  if (parent_x1_.shape()[0] != y_grid_ || parent_x1_.shape()[1] != x_grid_) {
+    parent_x1_.resize(boost::extents[y_grid_][x_grid_]);
+    parent_y1_.resize(boost::extents[y_grid_][x_grid_]);
+    parent_x3_.resize(boost::extents[y_grid_][x_grid_]);
+    parent_y3_.resize(boost::extents[y_grid_][x_grid_]);
+  }
 }
 
 NetRouteMap FastRouteCore::getRoutes()
@@ -1014,7 +1008,6 @@ NetRouteMap FastRouteCore::run()
   xcor_.resize(max_degree2);
   ycor_.resize(max_degree2);
   dcor_.resize(max_degree2);
-  net_eo_.reserve(max_degree2);
 
   int THRESH_M = 20;
   const int ENLARGE = 15;  // 5
@@ -1433,7 +1426,6 @@ NetRouteMap FastRouteCore::run()
   }
 
   NetRouteMap routes = getRoutes();
-  net_eo_.clear();
   net_ids_.clear();
   return routes;
 }
@@ -1443,6 +1435,16 @@ void FastRouteCore::setVerbose(bool v)
   verbose_ = v;
 }
 
+void FastRouteCore::setParallelMaze(bool parallel_maze)
+{
+  parallel_maze_ = parallel_maze;
+}
+
+void FastRouteCore::setNumThreads(int num_threads)
+{
+  num_threads_ = std::max(num_threads, 1);
+}
+
 void FastRouteCore::setCriticalNetsPercentage(float u)
 {
   critical_nets_percentage_ = u;
@@ -31,6 +31,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <algorithm>
+#include <array>
 
 #include "DataType.h"
 #include "FastRoute.h"
@@ -107,13 +108,14 @@ static void removeMin3D(std::vector<int*>& array)
   array.pop_back();
 }
 
-void FastRouteCore::addNeighborPoints(const int netID,
-                                      const int n1,
-                                      const int n2,
-                                      std::vector<int*>& points_heap_3D,
-                                      multi_array<int, 3>& dist_3D,
-                                      multi_array<Direction, 3>& directions_3D,
-                                      multi_array<int, 3>& corr_edge_3D)
+void FastRouteCore::addNeighborPoints(
+    const int netID,
+    const int n1,
+    const int n2,
+    std::vector<int*>& points_heap_3D,
+    multi_array_ref<int, 3>& dist_3D,
+    multi_array_ref<Direction, 3>& directions_3D,
+    multi_array_ref<int, 3>& corr_edge_3D)
 {
   const auto& treeedges = sttrees_[netID].edges;
   const auto& treenodes = sttrees_[netID].nodes;
@@ -208,10 +210,10 @@ void FastRouteCore::setupHeap3D(int netID,
                                 int edgeID,
                                 std::vector<int*>& src_heap_3D,
                                 std::vector<int*>& dest_heap_3D,
-                                multi_array<Direction, 3>& directions_3D,
-                                multi_array<int, 3>& corr_edge_3D,
-                                multi_array<int, 3>& d1_3D,
-                                multi_array<int, 3>& d2_3D,
+                                multi_array_ref<Direction, 3>& directions_3D,
+                                multi_array_ref<int, 3>& corr_edge_3D,
+                                multi_array_ref<int, 3>& d1_3D,
+                                multi_array_ref<int, 3>& d2_3D,
                                 int regionX1,
                                 int regionX2,
                                 int regionY1,
@@ -780,12 +782,6 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
                                          int ripupTHlb,
                                          int ripupTHub)
 {
-  for (int i = 0; i < y_grid_; i++) {
-    for (int j = 0; j < x_grid_; j++) {
-      in_region_[i][j] = false;
-    }
-  }
-
   const int endIND = tree_order_pv_.size() * 0.9;
 
   for (int orderIndex = 0; orderIndex < endIND; orderIndex++) {
@@ -834,17 +830,38 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
       int n1a = treeedge->n1a;
       int n2a = treeedge->n2a;
 
-      // initialize pop_src_heap_3D_[] and pop_heap2_3D[] as false (for
-      // detecting the shortest path is found or not)
-
-      for (int k = 0; k < num_layers_; k++) {
-        for (int i = regionY1; i <= regionY2; i++) {
-          for (int j = regionX1; j <= regionX2; j++) {
-            d1_3D_[k][i][j] = BIG_INT;
-            d2_3D_[k][i][j] = BIG_INT;
-          }
-        }
+      // the search arrays only cover the enlarged region of the edge, so
+      // their setup cost does not depend on the grid size
+      const int window_w = regionX2 - regionX1 + 1;
+      const int window_h = regionY2 - regionY1 + 1;
+      const int window_hv = window_w * window_h;
+      const size_t window_size = static_cast<size_t>(num_layers_) * window_hv;
+      if (d1_3D_pool_.size() < window_size) {
+        directions_3D_pool_.resize(window_size);
+        corr_edge_3D_pool_.resize(window_size);
+        pr_3D_pool_.resize(window_size);
+        d1_3D_pool_.resize(window_size);
+        d2_3D_pool_.resize(window_size);
+        pop_heap2_3D_.resize(window_size, false);
       }
+      const auto window = boost::extents[num_layers_][window_h][window_w];
+      const std::array<int, 3> window_base = {0, regionY1, regionX1};
+      multi_array_ref<Direction, 3> directions_3D(directions_3D_pool_.data(),
+                                                  window);
+      multi_array_ref<int, 3> corr_edge_3D(corr_edge_3D_pool_.data(), window);
+      multi_array_ref<parent3D, 3> pr_3D(pr_3D_pool_.data(), window);
+      multi_array_ref<int, 3> d1_3D(d1_3D_pool_.data(), window);
+      multi_array_ref<int, 3> d2_3D(d2_3D_pool_.data(), window);
+      directions_3D.reindex(window_base);
+      corr_edge_3D.reindex(window_base);
+      pr_3D.reindex(window_base);
+      d1_3D.reindex(window_base);
+      d2_3D.reindex(window_base);
+
+      // initialize d1_3D[] and d2_3D[] as BIG_INT (for detecting the
+      // shortest path is found or not)
+      std::fill_n(d1_3D.data(), window_size, BIG_INT);
+      std::fill_n(d2_3D.data(), window_size, BIG_INT);
 
       // setup src_heap_3D, dest_heap_3D and initialize d1_3D[][] and
       // d2_3D[][] for all the grids on the two subtrees
@@ -852,20 +869,20 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
                   edgeID,
                   src_heap_3D_,
                   dest_heap_3D_,
-                  directions_3D_,
-                  corr_edge_3D_,
-                  d1_3D_,
-                  d2_3D_,
+                  directions_3D,
+                  corr_edge_3D,
+                  d1_3D,
+                  d2_3D,
                   regionX1,
                   regionX2,
                   regionY1,
                   regionY2);
 
       // while loop to find shortest path
-      int ind1 = (src_heap_3D_[0] - &d1_3D_[0][0][0]);
+      int ind1 = (src_heap_3D_[0] - d1_3D.data());
 
       for (int i = 0; i < dest_heap_3D_.size(); i++)
-        pop_heap2_3D_[dest_heap_3D_[i] - &d2_3D_[0][0][0]] = true;
+        pop_heap2_3D_[dest_heap_3D_[i] - d2_3D.data()] = true;
 
       while (pop_heap2_3D_[ind1]
              == false)  // stop until the grid position been popped out from
@@ -873,10 +890,10 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
       {
         // relax all the adjacent grids within the enlarged region for
         // source subtree
-        const int curL = ind1 / (grid_hv_);
-        const int remd = ind1 % (grid_hv_);
-        const int curX = remd % x_range_;
-        const int curY = remd / x_range_;
+        const int curL = ind1 / window_hv;
+        const int remd = ind1 % window_hv;
+        const int curX = regionX1 + remd % window_w;
+        const int curY = regionY1 + remd / window_w;
         removeMin3D(src_heap_3D_);
 
         const bool Horizontal
@@ -885,34 +902,34 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
         if (Horizontal) {
           // left
           if (curX > regionX1
-              && directions_3D_[curL][curY][curX] != Direction::East) {
-            const float tmp = d1_3D_[curL][curY][curX] + 1;
+              && directions_3D[curL][curY][curX] != Direction::East) {
+            const float tmp = d1_3D[curL][curY][curX] + 1;
             if (h_edges_3D_[curL][curY][curX - 1].usage
                     < h_edges_3D_[curL][curY][curX - 1].cap
                 && net->getMinLayer() <= curL && curL <= net->getMaxLayer()) {
               const int tmpX = curX - 1;  // the left neighbor
 
-              if (d1_3D_[curL][curY][tmpX]
+              if (d1_3D[curL][curY][tmpX]
                   >= BIG_INT)  // left neighbor not been
                                // put into src_heap_3D
               {
-                d1_3D_[curL][curY][tmpX] = tmp;
-                pr_3D_[curL][curY][tmpX].l = curL;
-                pr_3D_[curL][curY][tmpX].x = curX;
-                pr_3D_[curL][curY][tmpX].y = curY;
-                directions_3D_[curL][curY][tmpX] = Direction::West;
-                src_heap_3D_.push_back(&d1_3D_[curL][curY][tmpX]);
+                d1_3D[curL][curY][tmpX] = tmp;
+                pr_3D[curL][curY][tmpX].l = curL;
+                pr_3D[curL][curY][tmpX].x = curX;
+                pr_3D[curL][curY][tmpX].y = curY;
+                directions_3D[curL][curY][tmpX] = Direction::West;
+                src_heap_3D_.push_back(&d1_3D[curL][curY][tmpX]);
                 updateHeap3D(src_heap_3D_, src_heap_3D_.size() - 1);
-              } else if (d1_3D_[curL][curY][tmpX]
+              } else if (d1_3D[curL][curY][tmpX]
                          > tmp)  // left neighbor been put into src_heap_3D
                                  // but needs update
               {
-                d1_3D_[curL][curY][tmpX] = tmp;
-                pr_3D_[curL][curY][tmpX].l = curL;
-                pr_3D_[curL][curY][tmpX].x = curX;
-                pr_3D_[curL][curY][tmpX].y = curY;
-                directions_3D_[curL][curY][tmpX] = Direction::West;
-                const int* dtmp = &d1_3D_[curL][curY][tmpX];
+                d1_3D[curL][curY][tmpX] = tmp;
+                pr_3D[curL][curY][tmpX].l = curL;
+                pr_3D[curL][curY][tmpX].x = curX;
+                pr_3D[curL][curY][tmpX].y = curY;
+                directions_3D[curL][curY][tmpX] = Direction::West;
+                const int* dtmp = &d1_3D[curL][curY][tmpX];
                 int ind = 0;
                 while (src_heap_3D_[ind] != dtmp)
                   ind++;
@@ -922,34 +939,34 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
           }
           // right
           if (Horizontal && curX < regionX2
-              && directions_3D_[curL][curY][curX] != Direction::West) {
-            const float tmp = d1_3D_[curL][curY][curX] + 1;
+              && directions_3D[curL][curY][curX] != Direction::West) {
+            const float tmp = d1_3D[curL][curY][curX] + 1;
             const int tmpX = curX + 1;  // the right neighbor
 
             if (h_edges_3D_[curL][curY][curX].usage
                     < h_edges_3D_[curL][curY][curX].cap
                 && net->getMinLayer() <= curL && curL <= net->getMaxLayer()) {
-              if (d1_3D_[curL][curY][tmpX]
+              if (d1_3D[curL][curY][tmpX]
                   >= BIG_INT)  // right neighbor not been put into
                                // src_heap_3D
               {
-                d1_3D_[curL][curY][tmpX] = tmp;
-                pr_3D_[curL][curY][tmpX].l = curL;
-                pr_3D_[curL][curY][tmpX].x = curX;
-                pr_3D_[curL][curY][tmpX].y = curY;
-                directions_3D_[curL][curY][tmpX] = Direction::East;
-                src_heap_3D_.push_back(&d1_3D_[curL][curY][tmpX]);
+                d1_3D[curL][curY][tmpX] = tmp;
+                pr_3D[curL][curY][tmpX].l = curL;
+                pr_3D[curL][curY][tmpX].x = curX;
+                pr_3D[curL][curY][tmpX].y = curY;
+                directions_3D[curL][curY][tmpX] = Direction::East;
+                src_heap_3D_.push_back(&d1_3D[curL][curY][tmpX]);
                 updateHeap3D(src_heap_3D_, src_heap_3D_.size() - 1);
-              } else if (d1_3D_[curL][curY][tmpX]
+              } else if (d1_3D[curL][curY][tmpX]
                          > tmp)  // right neighbor been put into src_heap_3D
                                  // but needs update
               {
-                d1_3D_[curL][curY][tmpX] = tmp;
-                pr_3D_[curL][curY][tmpX].l = curL;
-                pr_3D_[curL][curY][tmpX].x = curX;
-                pr_3D_[curL][curY][tmpX].y = curY;
-                directions_3D_[curL][curY][tmpX] = Direction::East;
-                const int* dtmp = &d1_3D_[curL][curY][tmpX];
+                d1_3D[curL][curY][tmpX] = tmp;
+                pr_3D[curL][curY][tmpX].l = curL;
+                pr_3D[curL][curY][tmpX].x = curX;
+                pr_3D[curL][curY][tmpX].y = curY;
+                directions_3D[curL][curY][tmpX] = Direction::East;
+                const int* dtmp = &d1_3D[curL][curY][tmpX];
                 int ind = 0;
                 while (src_heap_3D_[ind] != dtmp)
                   ind++;
@@ -960,33 +977,33 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
         } else {
           // bottom
           if (!Horizontal && curY > regionY1
-              && directions_3D_[curL][curY][curX] != Direction::South) {
-            const float tmp = d1_3D_[curL][curY][curX] + 1;
+              && directions_3D[curL][curY][curX] != Direction::South) {
+            const float tmp = d1_3D[curL][curY][curX] + 1;
             const int tmpY = curY - 1;  // the bottom neighbor
             if (v_edges_3D_[curL][curY - 1][curX].usage
                     < v_edges_3D_[curL][curY - 1][curX].cap
                 && net->getMinLayer() <= curL && curL <= net->getMaxLayer()) {
-              if (d1_3D_[curL][tmpY][curX]
+              if (d1_3D[curL][tmpY][curX]
                   >= BIG_INT)  // bottom neighbor not been put into
                                // src_heap_3D
               {
-                d1_3D_[curL][tmpY][curX] = tmp;
-                pr_3D_[curL][tmpY][curX].l = curL;
-                pr_3D_[curL][tmpY][curX].x = curX;
-                pr_3D_[curL][tmpY][curX].y = curY;
-                directions_3D_[curL][tmpY][curX] = Direction::North;
-                src_heap_3D_.push_back(&d1_3D_[curL][tmpY][curX]);
+                d1_3D[curL][tmpY][curX] = tmp;
+                pr_3D[curL][tmpY][curX].l = curL;
+                pr_3D[curL][tmpY][curX].x = curX;
+                pr_3D[curL][tmpY][curX].y = curY;
+                directions_3D[curL][tmpY][curX] = Direction::North;
+                src_heap_3D_.push_back(&d1_3D[curL][tmpY][curX]);
                 updateHeap3D(src_heap_3D_, src_heap_3D_.size() - 1);
-              } else if (d1_3D_[curL][tmpY][curX]
+              } else if (d1_3D[curL][tmpY][curX]
                          > tmp)  // bottom neighbor been put into
                                  // src_heap_3D but needs update
               {
-                d1_3D_[curL][tmpY][curX] = tmp;
-                pr_3D_[curL][tmpY][curX].l = curL;
-                pr_3D_[curL][tmpY][curX].x = curX;
-                pr_3D_[curL][tmpY][curX].y = curY;
-                directions_3D_[curL][tmpY][curX] = Direction::North;
-                const int* dtmp = &d1_3D_[curL][tmpY][curX];
+                d1_3D[curL][tmpY][curX] = tmp;
+                pr_3D[curL][tmpY][curX].l = curL;
+                pr_3D[curL][tmpY][curX].x = curX;
+                pr_3D[curL][tmpY][curX].y = curY;
+                directions_3D[curL][tmpY][curX] = Direction::North;
+                const int* dtmp = &d1_3D[curL][tmpY][curX];
                 int ind = 0;
                 while (src_heap_3D_[ind] != dtmp)
                   ind++;
@@ -996,32 +1013,32 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
           }
           // top
           if (!Horizontal && curY < regionY2
-              && directions_3D_[curL][curY][curX] != Direction::North) {
-            const float tmp = d1_3D_[curL][curY][curX] + 1;
+              && directions_3D[curL][curY][curX] != Direction::North) {
+            const float tmp = d1_3D[curL][curY][curX] + 1;
             const int tmpY = curY + 1;  // the top neighbor
             if (v_edges_3D_[curL][curY][curX].usage
                     < v_edges_3D_[curL][curY][curX].cap
                 && net->getMinLayer() <= curL && curL <= net->getMaxLayer()) {
-              if (d1_3D_[curL][tmpY][curX]
+              if (d1_3D[curL][tmpY][curX]
                   >= BIG_INT)  // top neighbor not been put into src_heap_3D
               {
-                d1_3D_[curL][tmpY][curX] = tmp;
-                pr_3D_[curL][tmpY][curX].l = curL;
-                pr_3D_[curL][tmpY][curX].x = curX;
-                pr_3D_[curL][tmpY][curX].y = curY;
-                directions_3D_[curL][tmpY][curX] = Direction::South;
-                src_heap_3D_.push_back(&d1_3D_[curL][tmpY][curX]);
+                d1_3D[curL][tmpY][curX] = tmp;
+                pr_3D[curL][tmpY][curX].l = curL;
+                pr_3D[curL][tmpY][curX].x = curX;
+                pr_3D[curL][tmpY][curX].y = curY;
+                directions_3D[curL][tmpY][curX] = Direction::South;
+                src_heap_3D_.push_back(&d1_3D[curL][tmpY][curX]);
                 updateHeap3D(src_heap_3D_, src_heap_3D_.size() - 1);
-              } else if (d1_3D_[curL][tmpY][curX]
+              } else if (d1_3D[curL][tmpY][curX]
                          > tmp)  // top neighbor been put into src_heap_3D
                                  // but needs update
               {
-                d1_3D_[curL][tmpY][curX] = tmp;
-                pr_3D_[curL][tmpY][curX].l = curL;
-                pr_3D_[curL][tmpY][curX].x = curX;
-                pr_3D_[curL][tmpY][curX].y = curY;
-                directions_3D_[curL][tmpY][curX] = Direction::South;
-                const int* dtmp = &d1_3D_[curL][tmpY][curX];
+                d1_3D[curL][tmpY][curX] = tmp;
+                pr_3D[curL][tmpY][curX].l = curL;
+                pr_3D[curL][tmpY][curX].x = curX;
+                pr_3D[curL][tmpY][curX].y = curY;
+                directions_3D[curL][tmpY][curX] = Direction::South;
+                const int* dtmp = &d1_3D[curL][tmpY][curX];
                 int ind = 0;
                 while (src_heap_3D_[ind] != dtmp)
                   ind++;
@@ -1032,30 +1049,30 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
         }
 
         // down
-        if (curL > 0 && directions_3D_[curL][curY][curX] != Direction::Up) {
-          const float tmp = d1_3D_[curL][curY][curX] + via_cost_;
+        if (curL > 0 && directions_3D[curL][curY][curX] != Direction::Up) {
+          const float tmp = d1_3D[curL][curY][curX] + via_cost_;
           const int tmpL = curL - 1;  // the bottom neighbor
 
-          if (d1_3D_[tmpL][curY][curX]
+          if (d1_3D[tmpL][curY][curX]
               >= BIG_INT)  // bottom neighbor not been put into src_heap_3D
           {
-            d1_3D_[tmpL][curY][curX] = tmp;
-            pr_3D_[tmpL][curY][curX].l = curL;
-            pr_3D_[tmpL][curY][curX].x = curX;
-            pr_3D_[tmpL][curY][curX].y = curY;
-            directions_3D_[tmpL][curY][curX] = Direction::Down;
-            src_heap_3D_.push_back(&d1_3D_[tmpL][curY][curX]);
+            d1_3D[tmpL][curY][curX] = tmp;
+            pr_3D[tmpL][curY][curX].l = curL;
+            pr_3D[tmpL][curY][curX].x = curX;
+            pr_3D[tmpL][curY][curX].y = curY;
+            directions_3D[tmpL][curY][curX] = Direction::Down;
+            src_heap_3D_.push_back(&d1_3D[tmpL][curY][curX]);
             updateHeap3D(src_heap_3D_, src_heap_3D_.size() - 1);
-          } else if (d1_3D_[tmpL][curY][curX]
+          } else if (d1_3D[tmpL][curY][curX]
                      > tmp)  // bottom neighbor been put into src_heap_3D
                              // but needs update
           {
-            d1_3D_[tmpL][curY][curX] = tmp;
-            pr_3D_[tmpL][curY][curX].l = curL;
-            pr_3D_[tmpL][curY][curX].x = curX;
-            pr_3D_[tmpL][curY][curX].y = curY;
-            directions_3D_[tmpL][curY][curX] = Direction::Down;
-            const int* dtmp = &d1_3D_[tmpL][curY][curX];
+            d1_3D[tmpL][curY][curX] = tmp;
+            pr_3D[tmpL][curY][curX].l = curL;
+            pr_3D[tmpL][curY][curX].x = curX;
+            pr_3D[tmpL][curY][curX].y = curY;
+            directions_3D[tmpL][curY][curX] = Direction::Down;
+            const int* dtmp = &d1_3D[tmpL][curY][curX];
             int ind = 0;
             while (src_heap_3D_[ind] != dtmp)
               ind++;
@@ -1065,29 +1082,29 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
 
         // up
         if (curL < num_layers_ - 1
-            && directions_3D_[curL][curY][curX] != Direction::Down) {
-          const float tmp = d1_3D_[curL][curY][curX] + via_cost_;
+            && directions_3D[curL][curY][curX] != Direction::Down) {
+          const float tmp = d1_3D[curL][curY][curX] + via_cost_;
           const int tmpL = curL + 1;  // the bottom neighbor
-          if (d1_3D_[tmpL][curY][curX]
+          if (d1_3D[tmpL][curY][curX]
               >= BIG_INT)  // bottom neighbor not been put into src_heap_3D
           {
-            d1_3D_[tmpL][curY][curX] = tmp;
-            pr_3D_[tmpL][curY][curX].l = curL;
-            pr_3D_[tmpL][curY][curX].x = curX;
-            pr_3D_[tmpL][curY][curX].y = curY;
-            directions_3D_[tmpL][curY][curX] = Direction::Up;
-            src_heap_3D_.push_back(&d1_3D_[tmpL][curY][curX]);
+            d1_3D[tmpL][curY][curX] = tmp;
+            pr_3D[tmpL][curY][curX].l = curL;
+            pr_3D[tmpL][curY][curX].x = curX;
+            pr_3D[tmpL][curY][curX].y = curY;
+            directions_3D[tmpL][curY][curX] = Direction::Up;
+            src_heap_3D_.push_back(&d1_3D[tmpL][curY][curX]);
             updateHeap3D(src_heap_3D_, src_heap_3D_.size() - 1);
-          } else if (d1_3D_[tmpL][curY][curX]
+          } else if (d1_3D[tmpL][curY][curX]
                      > tmp)  // bottom neighbor been put into src_heap_3D
                              // but needs update
           {
-            d1_3D_[tmpL][curY][curX] = tmp;
-            pr_3D_[tmpL][curY][curX].l = curL;
-            pr_3D_[tmpL][curY][curX].x = curX;
-            pr_3D_[tmpL][curY][curX].y = curY;
-            directions_3D_[tmpL][curY][curX] = Direction::Up;
-            const int* dtmp = &d1_3D_[tmpL][curY][curX];
+            d1_3D[tmpL][curY][curX] = tmp;
+            pr_3D[tmpL][curY][curX].l = curL;
+            pr_3D[tmpL][curY][curX].x = curX;
+            pr_3D[tmpL][curY][curX].y = curY;
+            directions_3D[tmpL][curY][curX] = Direction::Up;
+            const int* dtmp = &d1_3D[tmpL][curY][curX];
             int ind = 0;
             while (src_heap_3D_[ind] != dtmp)
               ind++;
@@ -1102,36 +1119,36 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
                          nets_[netID]->getName());
         }
         // update ind1 for next loop
-        ind1 = (src_heap_3D_[0] - &d1_3D_[0][0][0]);
+        ind1 = (src_heap_3D_[0] - d1_3D.data());
       }  // while loop
 
       for (int i = 0; i < dest_heap_3D_.size(); i++)
-        pop_heap2_3D_[dest_heap_3D_[i] - &d2_3D_[0][0][0]] = false;
+        pop_heap2_3D_[dest_heap_3D_[i] - d2_3D.data()] = false;
 
       // get the new route for the edge and store it in gridsX[] and
       // gridsY[] temporarily
 
-      const int crossL = ind1 / (grid_hv_);
-      const int crossX = (ind1 % (grid_hv_)) % x_range_;
-      const int crossY = (ind1 % (grid_hv_)) / x_range_;
+      const int crossL = ind1 / window_hv;
+      const int crossX = regionX1 + (ind1 % window_hv) % window_w;
+      const int crossY = regionY1 + (ind1 % window_hv) / window_w;
 
       int cnt = 0;
       int curX = crossX;
       int curY = crossY;
       int curL = crossL;
 
-      if (d1_3D_[curL][curY][curX] == 0) {
+      if (d1_3D[curL][curY][curX] == 0) {
         recoverEdge(netID, edgeID);
         break;
       }
 
       std::vector<int> tmp_gridsX, tmp_gridsY, tmp_gridsL;
 
-      while (d1_3D_[curL][curY][curX] != 0)  // loop until reach subtree1
+      while (d1_3D[curL][curY][curX] != 0)  // loop until reach subtree1
       {
-        const int tmpL = pr_3D_[curL][curY][curX].l;
-        const int tmpX = pr_3D_[curL][curY][curX].x;
-        const int tmpY = pr_3D_[curL][curY][curX].y;
+        const int tmpL = pr_3D[curL][curY][curX].l;
+        const int tmpX = pr_3D[curL][curY][curX].x;
+        const int tmpY = pr_3D[curL][curY][curX].y;
         curX = tmpX;
         curY = tmpY;
         curL = tmpL;
@@ -1192,7 +1209,7 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
       // otherwise, no change to subtree1
       {
         n1Shift = true;
-        const int corE1 = corr_edge_3D_[origL][E1y][E1x];
+        const int corE1 = corr_edge_3D[origL][E1y][E1x];
 
         const int endpt1 = treeedges[corE1].n1;
         const int endpt2 = treeedges[corE1].n2;
@@ -1247,7 +1264,7 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
         {
           const int C1 = endpt1;
           const int C2 = endpt2;
-          const int edge_C1C2 = corr_edge_3D_[origL][E1y][E1x];
+          const int edge_C1C2 = corr_edge_3D[origL][E1y][E1x];
 
           // update route for edge (n1, C1), (n1, C2) and (A1, A2)
           updateRouteType23D(netID,
@@ -1351,7 +1368,7 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
         // find the endpoints of the edge E1 is on
 
         n2Shift = true;
-        const int corE2 = corr_edge_3D_[origL][E2y][E2x];
+        const int corE2 = corr_edge_3D[origL][E2y][E2x];
         const int endpt1 = treeedges[corE2].n1;
         const int endpt2 = treeedges[corE2].n2;
 
@@ -1403,7 +1420,7 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
         {
           const int D1 = endpt1;
           const int D2 = endpt2;
-          const int edge_D1D2 = corr_edge_3D_[origL][E2y][E2x];
+          const int edge_D1D2 = corr_edge_3D[origL][E2y][E2x];
 
           // update route for edge (n2, d1_3D), (n2, d2_3D) and (B1, B2)
           updateRouteType23D(netID,
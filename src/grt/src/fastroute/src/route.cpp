@@ -31,6 +31,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <algorithm>
+#include <array>
 #include <queue>
 
 #include "DataType.h"
@@ -1157,8 +1158,8 @@ void FastRouteCore::spiralRouteAll()
 
 void FastRouteCore::routeMonotonic(int netID,
                                    int edgeID,
-                                   multi_array<double, 2>& d1,
-                                   multi_array<double, 2>& d2,
+                                   std::vector<double>& d1_pool,
+                                   std::vector<double>& d2_pool,
                                    int threshold,
                                    int enlarge)
 {
@@ -1216,6 +1217,21 @@ void FastRouteCore::routeMonotonic(int netID,
     }
   }
 
+  // the cost arrays only cover the region of the edge
+  const int region_w = xmax - xmin + 1;
+  const int region_h = ymax - ymin + 1;
+  const size_t region_size = static_cast<size_t>(region_w) * region_h;
+  if (d1_pool.size() < region_size) {
+    d1_pool.resize(region_size);
+    d2_pool.resize(region_size);
+  }
+  const auto region = boost::extents[region_h][region_w];
+  const std::array<int, 2> region_base = {ymin, xmin};
+  multi_array_ref<double, 2> d1(d1_pool.data(), region);
+  multi_array_ref<double, 2> d2(d2_pool.data(), region);
+  d1.reindex(region_base);
+  d2.reindex(region_base);
+
   for (int j = ymin; j <= ymax; j++) {
     d1[j][xmin] = 0;
   }
@@ -1477,16 +1493,15 @@ void FastRouteCore::routeMonotonicAll(int threshold,
         = costheight_ / (exp((double) (h_capacity_ - i) * logis_cof) + 1) + 1;
   }
 
-  multi_array<double, 2> d1(boost::extents[y_range_][x_range_]);
-  multi_array<double, 2> d2(boost::extents[y_range_][x_range_]);
-
+  std::vector<double> d1_pool;
+  std::vector<double> d2_pool;
   for (const int& netID : net_ids_) {
     const int numEdges = sttrees_[netID].num_edges();
     for (int edgeID = 0; edgeID < numEdges; edgeID++) {
       routeMonotonic(netID,
                      edgeID,
-                     d1,
-                     d2,
+                     d1_pool,
+                     d2_pool,
                      threshold,
                      expand);  // ripup previous route and do Monotonic routing
     }
@@ -0,0 +1,62 @@
+# check that the guides of the nets rerouted by incremental global routing
+# still cover their pins after moving instances
+source "helpers.tcl"
+read_lef "Nangate45/Nangate45.lef"
+read_def "gcd.def"
+
+global_route
+
+set block [ord::get_db_block]
+
+global_route -start_incremental
+set moved_nets {}
+set count 0
+foreach inst [$block getInsts] {
+  if { [$inst isFixed] || [incr count] % 10 != 0 } {
+    continue
+  }
+  lassign [$inst getLocation] x y
+  $inst setLocation [expr $x + 760] $y
+  foreach iterm [$inst getITerms] {
+    set net [$iterm getNet]
+    if { $net != "NULL" && ![$net isSpecial] } {
+      lappend moved_nets $net
+    }
+  }
+}
+global_route -end_incremental
+
+proc overlaps { box1 box2 } {
+  return [expr [$box1 xMin] <= [$box2 xMax] && [$box2 xMin] <= [$box1 xMax] \
+            && [$box1 yMin] <= [$box2 yMax] && [$box2 yMin] <= [$box1 yMax]]
+}
+
+set failed 0
+foreach net [lsort -unique $moved_nets] {
+  set guides [$net getGuides]
+  if { [llength $guides] == 0 } {
+    puts "[$net getName] has no guides"
+    incr failed
+    continue
+  }
+  foreach iterm [$net getITerms] {
+    set covered 0
+    foreach guide $guides {
+      if { [overlaps [$iterm getBBox] [$guide getBox]] } {
+        set covered 1
+        break
+      }
+    }
+    if { !$covered } {
+      puts "[$iterm getName] is not covered by the guides of [$net getName]"
+      incr failed
+    }
+  }
+}
+
+if { $failed } {
+  exit 1
+}
+
+puts "pass"
+exit
@@ -77,3 +77,7 @@ record_tests {
   #grt_man_tcl_check
   #grt_readme_msgs_check
 }
+record_pass_fail_tests {
+  incremental1
+  parallel_maze1
+}
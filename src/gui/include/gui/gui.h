@@ -616,6 +616,9 @@ class Gui
                  double dbu_per_pixel = 0,
                  const std::map<std::string, bool>& display_settings = {});
 
+  // Time a scripted sequence of pans and zooms of the layout
+  void benchmarkRender(int frames);
+
   // Save clock tree view
   void saveClockTreeImage(const std::string& clock_name,
                           const std::string& filename,
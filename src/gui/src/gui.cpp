@@ -645,6 +645,11 @@ void Gui::zoomTo(const odb::Rect& rect_dbu)
   main_window->zoomTo(rect_dbu);
 }
 
+void Gui::benchmarkRender(int frames)
+{
+  main_window->getLayoutViewer()->benchmarkRender(frames);
+}
+
 void Gui::zoomIn()
 {
   main_window->getLayoutViewer()->zoomIn();
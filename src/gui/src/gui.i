@@ -279,6 +279,15 @@ void save_image(const char* filename, double xlo, double ylo, double xhi, double
   gui->saveImage(filename, make_rect(xlo, ylo, xhi, yhi), width_px, dbu_per_pixel, display_settings);
 }
 
+void benchmark_render(int frames = 100)
+{
+  if (!check_gui("benchmark_render")) {
+    return;
+  }
+  auto gui = gui::Gui::get();
+  gui->benchmarkRender(frames);
+}
+
 void save_clocktree_image(const char* filename, const char* clock_name, const char* corner = "", int width_px = 0, int height_px = 0)
 {
   if (!check_gui("save_clocktree_image")) {
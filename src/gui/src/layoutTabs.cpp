@@ -199,6 +199,13 @@ void LayoutTabs::fullRepaint()
   }
 }
 
+void LayoutTabs::updateView()
+{
+  for (auto viewer : viewers_) {
+    viewer->updateView();
+  }
+}
+
 void LayoutTabs::startRulerBuild()
 {
   if (current_viewer_) {
@@ -113,6 +113,7 @@ class LayoutTabs : public QTabWidget
   void blockLoaded(odb::dbBlock* block);
   void fit();
   void fullRepaint();
+  void updateView();
   void startRulerBuild();
   void cancelRulerBuild();
   void selection(const Selected& selection);
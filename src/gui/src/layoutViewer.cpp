@@ -51,6 +51,7 @@
 #include <QToolButton>
 #include <QToolTip>
 #include <QTranslator>
+#include <algorithm>
 #include <boost/geometry.hpp>
 #include <deque>
 #include <limits>
@@ -168,7 +169,12 @@ LayoutViewer::LayoutViewer(
           this,
           &LayoutViewer::handleLoadingIndication);
 
-  connect(&search_, &Search::modified, this, &LayoutViewer::fullRepaint);
+  // The tile cache invalidates the changed regions itself
+  connect(&search_, &Search::modified, this, &LayoutViewer::updateView);
+  connect(&tile_cache_,
+          &TileCache::invalidated,
+          this,
+          &LayoutViewer::updateView);
 
   connect(&search_, &Search::newBlock, this, &LayoutViewer::setBlock);
 }
@@ -192,6 +198,7 @@ void LayoutViewer::setLoadingState()
 void LayoutViewer::setBlock(odb::dbBlock* block)
 {
   block_ = block;
+  tile_cache_.setBlock(block);
 
   if (block && cut_maximum_size_.empty()) {
     generateCutLayerMaximumSizes();
@@ -1319,7 +1326,7 @@ void LayoutViewer::updateScaleAndCentering(const QSize& new_size)
                  ((new_area.height() + bounds.dy() * pixels_per_dbu_) / 2
                   + bounds.yMin() * pixels_per_dbu_));
 
-    fullRepaint();
+    updateView();
   }
 }
 
@@ -1410,6 +1417,7 @@ void LayoutViewer::boxesByLayer(dbMaster* master, LayerBoxes& boxes)
 const LayoutViewer::Boxes* LayoutViewer::boxesByLayer(dbMaster* master,
                                                       dbTechLayer* layer)
 {
+  std::lock_guard<std::mutex> lock(cell_boxes_mutex_);
   auto it = cell_boxes_.find(master);
   if (it == cell_boxes_.end()) {
     LayerBoxes& boxes = cell_boxes_[master];
@@ -1888,23 +1896,34 @@ void LayoutViewer::paintEvent(QPaintEvent* event)
 }
 
 void LayoutViewer::fullRepaint()
+{
+  tile_cache_.clear();
+  updateView();
+}
+
+void LayoutViewer::updateView()
 {
   if (command_executing_ && !paused_) {
     QTimer::singleShot(
-        5 /*ms*/, this, &LayoutViewer::fullRepaint);  // retry later
+        5 /*ms*/, this, &LayoutViewer::updateView);  // retry later
     return;
   }
 
   update();
   if (hasDesign()) {
-    QRect rect = scroller_->viewport()->geometry();
-    rect.translate(scroller_->horizontalScrollBar()->value(),
-                   scroller_->verticalScrollBar()->value());
     setLoadingState();
-    viewer_thread_.render(rect, selected_, highlighted_, rulers_);
+    viewer_thread_.render(viewportRect(), selected_, highlighted_, rulers_);
   }
 }
 
+QRect LayoutViewer::viewportRect() const
+{
+  QRect rect = scroller_->viewport()->geometry();
+  rect.translate(scroller_->horizontalScrollBar()->value(),
+                 scroller_->verticalScrollBar()->value());
+  return rect;
+}
+
 void LayoutViewer::fit()
 {
   if (!hasDesign()) {
@@ -2010,7 +2029,7 @@ void LayoutViewer::setScroller(LayoutScroll* scroller)
   connect(scroller_,
           &LayoutScroll::centerChanged,
           this,
-          &LayoutViewer::fullRepaint);
+          &LayoutViewer::updateView);
 }
 
 void LayoutViewer::viewportUpdated()
@@ -2031,7 +2050,7 @@ void LayoutViewer::viewportUpdated()
   if (!zoomed_in) {
     resize(scroller_->maximumViewportSize());
   }
-  fullRepaint();
+  updateView();
 }
 
 void LayoutViewer::saveImage(const QString& filepath,
@@ -2131,6 +2150,96 @@ void LayoutViewer::saveImage(const QString& filepath,
   }
 }
 
+void LayoutViewer::benchmarkRender(int frames)
+{
+  if (!hasDesign() || frames <= 0) {
+    return;
+  }
+
+  const Rect initial_view = getVisibleBounds();
+
+  // Pan by a quarter of the view, zooming in and back out every few
+  // frames, and return to the start so that views are revisited.
+  auto step = [this](int frame) {
+    if (frame % 8 == 3) {
+      zoomIn();
+    } else if (frame % 8 == 7) {
+      zoomOut();
+    } else {
+      const Rect visible = getVisibleBounds();
+      const int direction = frame % 16 < 8 ? 1 : -1;
+      const odb::Point center = getVisibleCenter();
+      centerAt(odb::Point(center.x() + direction * visible.dx() / 4,
+                          center.y()));
+    }
+  };
+
+  auto run = [&](bool tiled) {
+    // Start zoomed in so there is room to pan
+    zoomTo(initial_view);
+    zoomIn();
+    zoomIn();
+    tile_cache_.clear();
+    tile_cache_.resetStatistics();
+
+    std::vector<double> times;
+    for (int frame = 0; frame < frames; frame++) {
+      step(frame);
+
+      const QRect rect = viewportRect();
+      QImage image(rect.size(), QImage::Format_ARGB32_Premultiplied);
+      const auto start = std::chrono::steady_clock::now();
+      if (tiled) {
+        OptionsSnapshot options(options_, block_);
+        viewer_thread_.drawTiled(
+            image, rect, selected_, highlighted_, rulers_, &options);
+      } else {
+        viewer_thread_.draw(image,
+                            rect,
+                            selected_,
+                            highlighted_,
+                            rulers_,
+                            1.0,
+                            Qt::transparent);
+      }
+      const std::chrono::duration<double, std::milli> elapsed
+          = std::chrono::steady_clock::now() - start;
+      times.push_back(elapsed.count());
+    }
+    return times;
+  };
+
+  auto report = [this](const char* name, std::vector<double>& times) {
+    std::sort(times.begin(), times.end());
+    double total = 0;
+    for (const double time : times) {
+      total += time;
+    }
+    logger_->report("{:<6} average {:8.2f} ms  95% {:8.2f} ms  max {:8.2f} ms",
+                    name,
+                    total / times.size(),
+                    times[(times.size() - 1) * 95 / 100],
+                    times.back());
+  };
+
+  const QRect viewport = viewportRect();
+  logger_->report("Rendering {} frames of {} x {} pixels",
+                  frames,
+                  viewport.width(),
+                  viewport.height());
+
+  std::vector<double> direct = run(false);
+  report("Direct", direct);
+
+  std::vector<double> tiled = run(true);
+  report("Tiled", tiled);
+  logger_->report("Tile cache hits {} misses {}",
+                  tile_cache_.hits(),
+                  tile_cache_.misses());
+
+  zoomTo(initial_view);
+}
+
 void LayoutViewer::addMenuAndActions()
 {
   // Create Top Level Menu for the context Menu
@@ -2457,7 +2566,10 @@ void LayoutViewer::executionPaused()
 
 void LayoutViewer::resetCache()
 {
-  cell_boxes_.clear();
+  {
+    std::lock_guard<std::mutex> lock(cell_boxes_mutex_);
+    cell_boxes_.clear();
+  }
   fullRepaint();
 }
 
@@ -49,12 +49,14 @@
 #include <chrono>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #include "gui/gui.h"
 #include "options.h"
 #include "renderThread.h"
 #include "search.h"
+#include "tileCache.h"
 
 namespace utl {
 class Logger;
@@ -172,6 +174,10 @@ class LayoutViewer : public QWidget
                  int width_px = 0,
                  double dbu_per_pixel = 0);
 
+  // Render a scripted sequence of pans and zooms and report the frame
+  // times with and without the tile cache
+  void benchmarkRender(int frames);
+
   // From QWidget
   virtual void paintEvent(QPaintEvent* event) override;
   virtual void resizeEvent(QResizeEvent* event) override;
@@ -246,6 +252,10 @@ class LayoutViewer : public QWidget
   // signals that the cache should be flushed and a full repaint should occur.
   void fullRepaint();
 
+  // repaint the visible region reusing the cached tiles, used when only
+  // the viewport or the selection, highlight and rulers have changed.
+  void updateView();
+
   odb::Point getVisibleCenter();
 
   void selectHighlightConnectedInst(bool select_flag);
@@ -361,6 +371,8 @@ class LayoutViewer : public QWidget
   QRect computeIndicatorBackground(QPainter* painter,
                                    const QRect& bounds) const;
   void setLoadingState();
+  // The visible part of the layout in widget coordinates
+  QRect viewportRect() const;
 
   void populateModuleColors();
 
@@ -386,7 +398,10 @@ class LayoutViewer : public QWidget
   int min_depth_;
   int max_depth_;
   Search search_;
+  TileCache tile_cache_;
   CellBoxes cell_boxes_;
+  // cell_boxes_ is populated on demand while tiles are rendered in parallel
+  std::mutex cell_boxes_mutex_;
   QRect rubber_band_;  // screen coordinates
   QPoint mouse_press_pos_;
   QPoint mouse_move_pos_;
@@ -192,11 +192,12 @@ MainWindow::MainWindow(QWidget* parent)
         addRuler(x0, y0, x1, y1, "", "", default_ruler_style_->isChecked());
       });
 
+  // These are drawn over the layout so the cached tiles are still valid
   connect(
-      this, &MainWindow::selectionChanged, viewers_, &LayoutTabs::fullRepaint);
+      this, &MainWindow::selectionChanged, viewers_, &LayoutTabs::updateView);
   connect(
-      this, &MainWindow::highlightChanged, viewers_, &LayoutTabs::fullRepaint);
-  connect(this, &MainWindow::rulersChanged, viewers_, &LayoutTabs::fullRepaint);
+      this, &MainWindow::highlightChanged, viewers_, &LayoutTabs::updateView);
+  connect(this, &MainWindow::rulersChanged, viewers_, &LayoutTabs::updateView);
 
   connect(controls_, &DisplayControls::selected, [=](const Selected& selected) {
     setSelected(selected);
@@ -222,7 +223,7 @@ MainWindow::MainWindow(QWidget* parent)
   connect(inspector_,
           &Inspector::selectedItemChanged,
           viewers_,
-          &LayoutTabs::fullRepaint);
+          &LayoutTabs::updateView);
   connect(inspector_,
           &Inspector::selectedItemChanged,
           this,
@@ -0,0 +1,222 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "optionsSnapshot.h"
+
+namespace gui {
+
+OptionsSnapshot::OptionsSnapshot(Options* source, odb::dbBlock* block)
+    : source_(source),
+      placement_blockage_color_(source->placementBlockageColor()),
+      placement_blockage_pattern_(source->placementBlockagePattern()),
+      region_color_(source->regionColor()),
+      region_pattern_(source->regionPattern()),
+      instance_name_color_(source->instanceNameColor()),
+      instance_name_font_(source->instanceNameFont()),
+      iterm_label_color_(source->itermLabelColor()),
+      iterm_label_font_(source->itermLabelFont()),
+      instance_names_visible_(source->areInstanceNamesVisible()),
+      instance_pins_visible_(source->areInstancePinsVisible()),
+      instance_pins_selectable_(source->areInstancePinsSelectable()),
+      instance_pin_names_visible_(source->areInstancePinNamesVisible()),
+      instance_blockages_visible_(source->areInstanceBlockagesVisible()),
+      blockages_visible_(source->areBlockagesVisible()),
+      blockages_selectable_(source->areBlockagesSelectable()),
+      obstructions_visible_(source->areObstructionsVisible()),
+      obstructions_selectable_(source->areObstructionsSelectable()),
+      sites_visible_(source->areSitesVisible()),
+      sites_selectable_(source->areSitesSelectable()),
+      pref_tracks_visible_(source->arePrefTracksVisible()),
+      non_pref_tracks_visible_(source->areNonPrefTracksVisible()),
+      io_pins_visible_(source->areIOPinsVisible()),
+      routing_segments_visible_(source->areRoutingSegmentsVisible()),
+      routing_vias_visible_(source->areRoutingViasVisible()),
+      special_routing_segments_visible_(
+          source->areSpecialRoutingSegmentsVisible()),
+      special_routing_vias_visible_(source->areSpecialRoutingViasVisible()),
+      fills_visible_(source->areFillsVisible()),
+      pin_markers_font_(source->pinMarkersFont()),
+      ruler_color_(source->rulerColor()),
+      ruler_font_(source->rulerFont()),
+      rulers_visible_(source->areRulersVisible()),
+      rulers_selectable_(source->areRulersSelectable()),
+      detailed_visibility_(source->isDetailedVisibility()),
+      selected_visible_(source->areSelectedVisible()),
+      scale_bar_visible_(source->isScaleBarVisible()),
+      access_points_visible_(source->areAccessPointsVisible()),
+      regions_visible_(source->areRegionsVisible()),
+      regions_selectable_(source->areRegionsSelectable()),
+      manufacturing_grid_visible_(source->isManufacturingGridVisible()),
+      module_view_(source->isModuleView()),
+      gcell_grid_visible_(source->isGCellGridVisible())
+{
+  if (block == nullptr) {
+    return;
+  }
+  odb::dbDatabase* db = block->getDb();
+  for (odb::dbTech* tech : db->getTechs()) {
+    for (odb::dbTechLayer* layer : tech->getLayers()) {
+      layers_[layer] = sourceLayerOptions(layer);
+    }
+  }
+  for (odb::dbLib* lib : db->getLibs()) {
+    for (odb::dbSite* site : lib->getSites()) {
+      sites_[site] = sourceSiteOptions(site);
+    }
+  }
+}
+
+OptionsSnapshot::LayerOptions OptionsSnapshot::sourceLayerOptions(
+    const odb::dbTechLayer* layer)
+{
+  return {source_->color(layer),
+          source_->pattern(layer),
+          source_->isVisible(layer),
+          source_->isSelectable(layer)};
+}
+
+OptionsSnapshot::SiteOptions OptionsSnapshot::sourceSiteOptions(
+    odb::dbSite* site)
+{
+  return {source_->siteColor(site),
+          source_->isSiteVisible(site),
+          source_->isSiteSelectable(site)};
+}
+
+// The layers and sites are all copied up front and the maps are not
+// changed after, so they are read without the lock.  One created since
+// is asked of the source.
+OptionsSnapshot::LayerOptions OptionsSnapshot::layerOptions(
+    const odb::dbTechLayer* layer)
+{
+  auto itr = layers_.find(layer);
+  if (itr != layers_.end()) {
+    return itr->second;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  return sourceLayerOptions(layer);
+}
+
+OptionsSnapshot::SiteOptions OptionsSnapshot::siteOptions(odb::dbSite* site)
+{
+  auto itr = sites_.find(site);
+  if (itr != sites_.end()) {
+    return itr->second;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  return sourceSiteOptions(site);
+}
+
+OptionsSnapshot::ObjectOptions OptionsSnapshot::netOptions(odb::dbNet* net)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto itr = nets_.find(net);
+  if (itr == nets_.end()) {
+    itr = nets_
+              .emplace(net,
+                       ObjectOptions{source_->isNetVisible(net),
+                                     source_->isNetSelectable(net)})
+              .first;
+  }
+  return itr->second;
+}
+
+OptionsSnapshot::ObjectOptions OptionsSnapshot::instOptions(odb::dbInst* inst)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto itr = insts_.find(inst);
+  if (itr == insts_.end()) {
+    itr = insts_
+              .emplace(inst,
+                       ObjectOptions{source_->isInstanceVisible(inst),
+                                     source_->isInstanceSelectable(inst)})
+              .first;
+  }
+  return itr->second;
+}
+
+QColor OptionsSnapshot::color(const odb::dbTechLayer* layer)
+{
+  return layerOptions(layer).color;
+}
+
+Qt::BrushStyle OptionsSnapshot::pattern(const odb::dbTechLayer* layer)
+{
+  return layerOptions(layer).pattern;
+}
+
+bool OptionsSnapshot::isVisible(const odb::dbTechLayer* layer)
+{
+  return layerOptions(layer).visible;
+}
+
+bool OptionsSnapshot::isSelectable(const odb::dbTechLayer* layer)
+{
+  return layerOptions(layer).selectable;
+}
+
+QColor OptionsSnapshot::siteColor(odb::dbSite* site)
+{
+  return siteOptions(site).color;
+}
+
+bool OptionsSnapshot::isSiteVisible(odb::dbSite* site)
+{
+  return siteOptions(site).visible;
+}
+
+bool OptionsSnapshot::isSiteSelectable(odb::dbSite* site)
+{
+  return siteOptions(site).selectable;
+}
+
+bool OptionsSnapshot::isNetVisible(odb::dbNet* net)
+{
+  return netOptions(net).visible;
+}
+
+bool OptionsSnapshot::isNetSelectable(odb::dbNet* net)
+{
+  return netOptions(net).selectable;
+}
+
+bool OptionsSnapshot::isInstanceVisible(odb::dbInst* inst)
+{
+  return instOptions(inst).visible;
+}
+
+bool OptionsSnapshot::isInstanceSelectable(odb::dbInst* inst)
+{
+  return instOptions(inst).selectable;
+}
+
+}  // namespace gui
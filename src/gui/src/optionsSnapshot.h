@@ -0,0 +1,225 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <map>
+#include <mutex>
+
+#include "odb/db.h"
+#include "options.h"
+
+namespace gui {
+
+// A copy of the display options taken before a frame is rendered, so
+// that the tile rendering threads never call into the display controls.
+//
+// The global, per layer and per site options are copied when the
+// snapshot is made.  The per net and per instance options are asked of
+// the source once per object, under a lock, and remembered.
+class OptionsSnapshot : public Options
+{
+ public:
+  // Must be called on the thread that owns the source options
+  OptionsSnapshot(Options* source, odb::dbBlock* block);
+
+  QColor color(const odb::dbTechLayer* layer) override;
+  Qt::BrushStyle pattern(const odb::dbTechLayer* layer) override;
+  QColor placementBlockageColor() override { return placement_blockage_color_; }
+  Qt::BrushStyle placementBlockagePattern() override
+  {
+    return placement_blockage_pattern_;
+  }
+  QColor regionColor() override { return region_color_; }
+  Qt::BrushStyle regionPattern() override { return region_pattern_; }
+  QColor instanceNameColor() override { return instance_name_color_; }
+  QFont instanceNameFont() override { return instance_name_font_; }
+  QColor itermLabelColor() override { return iterm_label_color_; }
+  QFont itermLabelFont() override { return iterm_label_font_; }
+  QColor siteColor(odb::dbSite* site) override;
+  bool isVisible(const odb::dbTechLayer* layer) override;
+  bool isSelectable(const odb::dbTechLayer* layer) override;
+  bool isNetVisible(odb::dbNet* net) override;
+  bool isNetSelectable(odb::dbNet* net) override;
+  bool isInstanceVisible(odb::dbInst* inst) override;
+  bool isInstanceSelectable(odb::dbInst* inst) override;
+  bool areInstanceNamesVisible() override { return instance_names_visible_; }
+  bool areInstancePinsVisible() override { return instance_pins_visible_; }
+  bool areInstancePinsSelectable() override
+  {
+    return instance_pins_selectable_;
+  }
+  bool areInstancePinNamesVisible() override
+  {
+    return instance_pin_names_visible_;
+  }
+  bool areInstanceBlockagesVisible() override
+  {
+    return instance_blockages_visible_;
+  }
+  bool areBlockagesVisible() override { return blockages_visible_; }
+  bool areBlockagesSelectable() override { return blockages_selectable_; }
+  bool areObstructionsVisible() override { return obstructions_visible_; }
+  bool areObstructionsSelectable() override
+  {
+    return obstructions_selectable_;
+  }
+  bool areSitesVisible() override { return sites_visible_; }
+  bool areSitesSelectable() override { return sites_selectable_; }
+  bool isSiteSelectable(odb::dbSite* site) override;
+  bool isSiteVisible(odb::dbSite* site) override;
+  bool arePrefTracksVisible() override { return pref_tracks_visible_; }
+  bool areNonPrefTracksVisible() override { return non_pref_tracks_visible_; }
+
+  bool areIOPinsVisible() const override { return io_pins_visible_; }
+  bool areRoutingSegmentsVisible() const override
+  {
+    return routing_segments_visible_;
+  }
+  bool areRoutingViasVisible() const override { return routing_vias_visible_; }
+  bool areSpecialRoutingSegmentsVisible() const override
+  {
+    return special_routing_segments_visible_;
+  }
+  bool areSpecialRoutingViasVisible() const override
+  {
+    return special_routing_vias_visible_;
+  }
+  bool areFillsVisible() const override { return fills_visible_; }
+  QFont pinMarkersFont() const override { return pin_markers_font_; }
+
+  QColor rulerColor() override { return ruler_color_; }
+  QFont rulerFont() override { return ruler_font_; }
+  bool areRulersVisible() override { return rulers_visible_; }
+  bool areRulersSelectable() override { return rulers_selectable_; }
+
+  bool isDetailedVisibility() override { return detailed_visibility_; }
+
+  bool areSelectedVisible() override { return selected_visible_; }
+
+  bool isScaleBarVisible() const override { return scale_bar_visible_; }
+  bool areAccessPointsVisible() const override
+  {
+    return access_points_visible_;
+  }
+  bool areRegionsVisible() const override { return regions_visible_; }
+  bool areRegionsSelectable() const override { return regions_selectable_; }
+  bool isManufacturingGridVisible() const override
+  {
+    return manufacturing_grid_visible_;
+  }
+
+  bool isModuleView() const override { return module_view_; }
+
+  bool isGCellGridVisible() const override { return gcell_grid_visible_; }
+
+ private:
+  struct LayerOptions
+  {
+    QColor color;
+    Qt::BrushStyle pattern;
+    bool visible;
+    bool selectable;
+  };
+  struct SiteOptions
+  {
+    QColor color;
+    bool visible;
+    bool selectable;
+  };
+  struct ObjectOptions
+  {
+    bool visible;
+    bool selectable;
+  };
+
+  LayerOptions sourceLayerOptions(const odb::dbTechLayer* layer);
+  SiteOptions sourceSiteOptions(odb::dbSite* site);
+  LayerOptions layerOptions(const odb::dbTechLayer* layer);
+  SiteOptions siteOptions(odb::dbSite* site);
+  ObjectOptions netOptions(odb::dbNet* net);
+  ObjectOptions instOptions(odb::dbInst* inst);
+
+  Options* source_;
+
+  std::map<const odb::dbTechLayer*, LayerOptions> layers_;
+  std::map<odb::dbSite*, SiteOptions> sites_;
+
+  // Guards the source for the per object options, and the caches
+  std::mutex mutex_;
+  std::map<odb::dbNet*, ObjectOptions> nets_;
+  std::map<odb::dbInst*, ObjectOptions> insts_;
+
+  QColor placement_blockage_color_;
+  Qt::BrushStyle placement_blockage_pattern_;
+  QColor region_color_;
+  Qt::BrushStyle region_pattern_;
+  QColor instance_name_color_;
+  QFont instance_name_font_;
+  QColor iterm_label_color_;
+  QFont iterm_label_font_;
+  bool instance_names_visible_;
+  bool instance_pins_visible_;
+  bool instance_pins_selectable_;
+  bool instance_pin_names_visible_;
+  bool instance_blockages_visible_;
+  bool blockages_visible_;
+  bool blockages_selectable_;
+  bool obstructions_visible_;
+  bool obstructions_selectable_;
+  bool sites_visible_;
+  bool sites_selectable_;
+  bool pref_tracks_visible_;
+  bool non_pref_tracks_visible_;
+  bool io_pins_visible_;
+  bool routing_segments_visible_;
+  bool routing_vias_visible_;
+  bool special_routing_segments_visible_;
+  bool special_routing_vias_visible_;
+  bool fills_visible_;
+  QFont pin_markers_font_;
+  QColor ruler_color_;
+  QFont ruler_font_;
+  bool rulers_visible_;
+  bool rulers_selectable_;
+  bool detailed_visibility_;
+  bool selected_visible_;
+  bool scale_bar_visible_;
+  bool access_points_visible_;
+  bool regions_visible_;
+  bool regions_selectable_;
+  bool manufacturing_grid_visible_;
+  bool module_view_;
+  bool gcell_grid_visible_;
+};
+
+}  // namespace gui
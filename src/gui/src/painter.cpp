@@ -90,6 +90,7 @@ void GuiPainter::drawString(int x,
                             const std::string& s,
                             bool rotate_90)
 {
+  draw_count_++;
   const QString text = QString::fromStdString(s);
   const qreal scale_adjust = 1.0 / getPixelsPerDBU();
 
@@ -139,6 +139,7 @@ class GuiPainter : public Painter
   }
   void drawRect(const odb::Rect& rect, int roundX = 0, int roundY = 0) override
   {
+    draw_count_++;
     if (roundX > 0 || roundY > 0) {
       painter_->drawRoundedRect(
           QRect(rect.xMin(), rect.yMin(), rect.dx(), rect.dy()),
@@ -155,6 +156,7 @@ class GuiPainter : public Painter
   }
   void drawPolygon(const std::vector<odb::Point>& points) override
   {
+    draw_count_++;
     QPolygon poly;
     for (const auto& pt : points) {
       poly.append(QPoint(pt.x(), pt.y()));
@@ -163,17 +165,20 @@ class GuiPainter : public Painter
   }
   void drawLine(const odb::Point& p1, const odb::Point& p2) override
   {
+    draw_count_++;
     painter_->drawLine(p1.x(), p1.y(), p2.x(), p2.y());
   }
   using Painter::drawLine;
 
   void drawCircle(int x, int y, int r) override
   {
+    draw_count_++;
     painter_->drawEllipse(QPoint(x, y), r, r);
   }
 
   void drawX(int x, int y, int size) override
   {
+    draw_count_++;
     const int o = size / 2;
     painter_->drawLine(x - o, y - o, x + o, y + o);
     painter_->drawLine(x - o, y + o, x + o, y - o);
@@ -237,9 +242,14 @@ class GuiPainter : public Painter
 
   QPainter* getPainter() { return painter_; }
 
+  // Number of shapes and strings drawn so far, used to find the layers
+  // a renderer draws on.
+  int drawCount() const { return draw_count_; }
+
  private:
   QPainter* painter_;
   int dbu_per_micron_;
+  int draw_count_ = 0;
 
   void drawRuler(int x0, int y0, int x1, int y1, const std::string& label);
 };
@@ -33,6 +33,13 @@
 #include "renderThread.h"
 
 #include <QPainterPath>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <QRunnable>
+#include <exception>
+#include <functional>
+#include <set>
 
 #include "layoutViewer.h"
 #include "odb/dbShape.h"
@@ -57,8 +64,26 @@ using odb::Rect;
 
 using utl::GUI;
 
+namespace {
+
+// Runs one tile rendering loop on the tile pool
+class TileRunnable : public QRunnable
+{
+ public:
+  explicit TileRunnable(std::function<void()> run) : run_(std::move(run)) {}
+  void run() override { run_(); }
+
+ private:
+  std::function<void()> run_;
+};
+
+}  // namespace
+
 RenderThread::RenderThread(LayoutViewer* viewer) : viewer_(viewer)
 {
+  // The render thread itself renders tiles too
+  tile_pool_.setMaxThreadCount(
+      std::max(1, QThreadPool::globalInstance()->maxThreadCount() - 1));
 }
 
 void RenderThread::exit()
@@ -97,6 +122,8 @@ void RenderThread::render(const QRect& draw_rect,
   for (const auto& ruler : rulers) {
     rulers_.emplace_back(new Ruler(*ruler));
   }
+  options_snapshot_ = std::make_unique<OptionsSnapshot>(viewer_->options_,
+                                                        viewer_->block_);
 
   if (!isRunning()) {
     start(LowPriority);
@@ -113,24 +140,26 @@ void RenderThread::run()
     SelectionSet selected;
     HighlightSet highlighted;
     Rulers rulers;
+    std::unique_ptr<OptionsSnapshot> options;
     mutex_.lock();
     const QRect draw_bounds = draw_rect_;
     selected.swap(selected_);
     highlighted.swap(highlighted_);
     rulers.swap(rulers_);
+    options.swap(options_snapshot_);
     mutex_.unlock();
+    if (options == nullptr) {
+      // render() always leaves one, this is only a safeguard
+      options = std::make_unique<OptionsSnapshot>(viewer_->options_,
+                                                  viewer_->block_);
+    }
     QImage image(draw_bounds.width(),
                  draw_bounds.height(),
                  QImage::Format_ARGB32_Premultiplied);
     // drawing can be interrupted by setting restart_
     try {
-      draw(image,
-           draw_bounds,
-           selected,
-           highlighted,
-           rulers,
-           1.0,
-           Qt::transparent);
+      drawTiled(
+          image, draw_bounds, selected, highlighted, rulers, options.get());
     } catch (const std::exception& e) {
       logger_->warn(
           GUI, 102, "An exception occurred during rendering: {}", e.what());
@@ -192,6 +221,7 @@ void RenderThread::draw(QImage& image,
   // Prevent a paintEvent and a save_image call from interfering
   // (eg search RTree construction)
   std::lock_guard<std::mutex> lock(drawing_mutex_);
+  options_ = viewer_->options_;
   QPainter painter(&image);
   painter.setRenderHints(QPainter::Antialiasing);
 
@@ -207,7 +237,7 @@ void RenderThread::draw(QImage& image,
   const Rect dbu_bounds = viewer_->screenToDBU(draw_bounds);
 
   GuiPainter gui_painter(&painter,
-                         viewer_->options_,
+                         options_,
                          viewer_->screenToDBU(draw_bounds),
                          viewer_->pixels_per_dbu_,
                          viewer_->block_->getDbUnitsPerMicron());
@@ -230,14 +260,398 @@ void RenderThread::draw(QImage& image,
   drawRulers(gui_painter, rulers);
 }
 
+void RenderThread::drawTiled(QImage& image,
+                             const QRect& draw_bounds,
+                             const SelectionSet& selected,
+                             const HighlightSet& highlighted,
+                             const Rulers& rulers,
+                             OptionsSnapshot* options)
+{
+  if (image.isNull()) {
+    return;
+  }
+  // Prevent a paintEvent and a save_image call from interfering
+  // (eg search RTree construction)
+  std::lock_guard<std::mutex> lock(drawing_mutex_);
+  options_ = options;
+  QPainter painter(&image);
+  painter.setRenderHints(QPainter::Antialiasing);
+
+  image.fill(Qt::transparent);
+
+  // Setup the transform to map coordinates from dbu to pixels
+  painter.translate(-draw_bounds.topLeft());
+  painter.translate(viewer_->centering_shift_);
+  painter.scale(viewer_->pixels_per_dbu_, -viewer_->pixels_per_dbu_);
+
+  const Rect dbu_bounds = viewer_->screenToDBU(draw_bounds);
+
+  GuiPainter gui_painter(&painter,
+                         options_,
+                         dbu_bounds,
+                         viewer_->pixels_per_dbu_,
+                         viewer_->block_->getDbUnitsPerMicron());
+
+  if (!is_first_render_done_ && !restart_) {
+    drawDesignLoadingMessage(gui_painter, dbu_bounds);
+    emit done(image, draw_bounds);
+
+    // Erase the first render indication so it does not remain on the screen
+    // when the design is drawn for the first time
+    image.fill(Qt::transparent);
+  }
+
+  // The layers with overlays split the tiles into bands so that the
+  // overlays keep their place between the layers
+  const std::vector<LayerOverlay> overlays
+      = drawLayerOverlays(viewer_->block_, draw_bounds, dbu_bounds);
+  TileCache::View view{viewer_->pixels_per_dbu_, viewer_->centering_shift_};
+  for (const auto& [layer, overlay] : overlays) {
+    view.band_layers.push_back(layer);
+  }
+
+  // Tiles are composed in pixel coordinates
+  painter.save();
+  painter.resetTransform();
+  drawTiles(&painter, draw_bounds, view, overlays);
+  painter.restore();
+
+  utl::Timer renderers;
+  for (auto* renderer : Gui::get()->renderers()) {
+    if (restart_) {
+      break;
+    }
+    gui_painter.saveState();
+    renderer->drawObjects(gui_painter);
+    gui_painter.restoreState();
+  }
+  debugPrint(logger_, GUI, "draw", 1, "renderers {}", renderers);
+
+  // draw selected and over top level and fast painting events
+  drawSelected(gui_painter, selected);
+  // Always last so on top
+  drawHighlighted(gui_painter, highlighted);
+  drawRulers(gui_painter, rulers);
+}
+
+void RenderThread::drawTiles(QPainter* painter,
+                             const QRect& draw_bounds,
+                             const TileCache::View& view,
+                             const std::vector<LayerOverlay>& overlays)
+{
+  utl::Timer timer;
+
+  TileCache& cache = viewer_->tile_cache_;
+  // Anything invalidated after this point makes the new tiles suspect
+  const uint64_t generation = cache.startDrawing();
+
+  const int tile_size = TileCache::tile_size;
+  auto tile_index = [tile_size](int pixel) -> int {
+    return std::floor(pixel / static_cast<double>(tile_size));
+  };
+
+  std::vector<std::pair<QPoint, TileCache::Tile>> tiles;
+  for (int y = tile_index(draw_bounds.top());
+       y <= tile_index(draw_bounds.bottom());
+       y++) {
+    for (int x = tile_index(draw_bounds.left());
+         x <= tile_index(draw_bounds.right());
+         x++) {
+      const QPoint index(x, y);
+      tiles.emplace_back(index, cache.find(view, index));
+    }
+  }
+
+  std::vector<int> missing;
+  for (int i = 0; i < tiles.size(); i++) {
+    if (tiles[i].second.empty()) {
+      missing.push_back(i);
+    }
+  }
+
+  const int margin = tileMargin();
+
+  // Each tile has its own images and painters, the search structures
+  // can be queried concurrently and the options are a snapshot, so the
+  // missing tiles are rendered in parallel.
+  std::atomic<int> next_tile{0};
+  std::exception_ptr exception;
+  std::mutex exception_mutex;
+  auto render_tiles = [&]() {
+    try {
+      for (int i = next_tile++; i < missing.size() && !restart_;
+           i = next_tile++) {
+        auto& [index, tile] = tiles[missing[i]];
+        tile = renderTile(view, index, margin);
+      }
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(exception_mutex);
+      if (!exception) {
+        exception = std::current_exception();
+      }
+    }
+  };
+
+  const int num_helpers = std::min(tile_pool_.maxThreadCount(),
+                                   static_cast<int>(missing.size()) - 1);
+  for (int i = 0; i < num_helpers; i++) {
+    tile_pool_.start(new TileRunnable(render_tiles));
+  }
+  render_tiles();
+  tile_pool_.waitForDone();
+  if (exception) {
+    std::rethrow_exception(exception);
+  }
+
+  // Don't keep tiles drawn while the view was changing
+  const bool keep_tiles = !restart_
+                          && view.pixels_per_dbu == viewer_->pixels_per_dbu_
+                          && view.centering_shift == viewer_->centering_shift_;
+  if (keep_tiles) {
+    for (const int i : missing) {
+      const auto& [index, tile] = tiles[i];
+      cache.insert(view, index, tile, generation);
+    }
+  }
+
+  // Each band of tiles is followed by the overlay of its last layer
+  for (int band = 0; band <= overlays.size(); band++) {
+    for (const auto& [index, tile] : tiles) {
+      if (tile.empty()) {
+        continue;  // interrupted
+      }
+      const QPoint tile_origin(index.x() * tile_size, index.y() * tile_size);
+      painter->drawImage(tile_origin - draw_bounds.topLeft(), tile[band]);
+    }
+    if (band < overlays.size()) {
+      painter->drawImage(QPoint(0, 0), overlays[band].second);
+    }
+  }
+
+  debugPrint(logger_,
+             GUI,
+             "draw",
+             1,
+             "tiles {} rendered of {} in {}",
+             missing.size(),
+             tiles.size(),
+             timer);
+}
+
+TileCache::Tile RenderThread::renderTile(const TileCache::View& view,
+                                         const QPoint& index,
+                                         const int margin)
+{
+  const int tile_size = TileCache::tile_size;
+  const QRect tile_rect(
+      index.x() * tile_size, index.y() * tile_size, tile_size, tile_size);
+
+  // Include the shapes just outside of the tile that reach into it.
+  const Rect bounds = viewer_->screenToDBU(
+      tile_rect.adjusted(-margin, -margin, margin, margin));
+
+  const std::vector<dbTechLayer*> layers = layersInDrawOrder(viewer_->block_);
+
+  TileCache::Tile tile;
+  int first_layer = 0;
+  for (int i = 0; i <= view.band_layers.size(); i++) {
+    int last_layer = layers.size();
+    if (i < view.band_layers.size()) {
+      auto band_layer = std::find(layers.begin() + first_layer,
+                                  layers.end(),
+                                  view.band_layers[i]);
+      last_layer = std::distance(layers.begin(), band_layer) + 1;
+    }
+    const TileBand band{first_layer,
+                        last_layer,
+                        i == 0,
+                        i == view.band_layers.size()};
+
+    QImage image(tile_size, tile_size, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+
+    QPainter painter(&image);
+    painter.setRenderHints(QPainter::Antialiasing);
+    painter.translate(-tile_rect.topLeft());
+    painter.translate(view.centering_shift);
+    painter.scale(view.pixels_per_dbu, -view.pixels_per_dbu);
+
+    drawBlock(&painter, viewer_->block_, bounds, 0, &band);
+    painter.end();
+
+    if (restart_) {
+      return TileCache::Tile();  // incomplete
+    }
+    tile.push_back(std::move(image));
+    first_layer = last_layer;
+  }
+  return tile;
+}
+
+// Shapes drawn just outside of a tile can reach into it: their antialiased
+// edges by a pixel, the outlined labels by the outline and the overhang of
+// their glyphs.
+int RenderThread::tileMargin() const
+{
+  const int antialias_margin = 2;  // pixels
+  const int label_outline = 2;     // pixels
+  const QFontMetrics instance_names(options_->instanceNameFont());
+  const QFontMetrics iterm_labels(options_->itermLabelFont());
+  const int label_margin
+      = std::max(instance_names.height(), iterm_labels.height())
+        + label_outline;
+  return std::max(antialias_margin, label_margin);
+}
+
+// Draws the IO pins and the renderer output of each layer into an image
+// of its own.  Only the layers where something was drawn are returned, in
+// draw order.
+std::vector<RenderThread::LayerOverlay> RenderThread::drawLayerOverlays(
+    dbBlock* block,
+    const QRect& draw_bounds,
+    const Rect& bounds)
+{
+  utl::Timer timer;
+  setupIOPins(block, bounds);
+
+  std::vector<LayerOverlay> overlays;
+  QImage image;
+  const int shape_limit = viewer_->shapeSizeLimit();
+  for (dbTechLayer* layer : layersInDrawOrder(block)) {
+    if (restart_) {
+      break;
+    }
+    if (!options_->isVisible(layer)) {
+      continue;
+    }
+
+    if (image.isNull()) {
+      image = QImage(draw_bounds.width(),
+                     draw_bounds.height(),
+                     QImage::Format_ARGB32_Premultiplied);
+      image.fill(Qt::transparent);
+    }
+    QPainter painter(&image);
+    painter.setRenderHints(QPainter::Antialiasing);
+    painter.translate(-draw_bounds.topLeft());
+    painter.translate(viewer_->centering_shift_);
+    painter.scale(viewer_->pixels_per_dbu_, -viewer_->pixels_per_dbu_);
+    GuiPainter gui_painter(&painter,
+                           options_,
+                           bounds,
+                           viewer_->pixels_per_dbu_,
+                           block->getDbUnitsPerMicron());
+
+    bool drawn = false;
+    const bool draw_shapes = !(layer->getType() == dbTechLayerType::CUT
+                               && cutMaximumSize(layer) < shape_limit);
+    if (draw_shapes && options_->areIOPinsVisible()) {
+      auto pins = pins_.find(layer);
+      if (pins != pins_.end() && !pins->second.empty()) {
+        drawIOPins(gui_painter, block, bounds, layer);
+        drawn = true;
+      }
+    }
+
+    for (auto* renderer : Gui::get()->renderers()) {
+      if (restart_) {
+        break;
+      }
+      gui_painter.saveState();
+      renderer->drawLayer(layer, gui_painter);
+      gui_painter.restoreState();
+    }
+    painter.end();
+
+    if (drawn || gui_painter.drawCount() > 0) {
+      overlays.emplace_back(layer, std::move(image));
+      image = QImage();
+    }
+  }
+  debugPrint(logger_, GUI, "draw", 1, "layer overlays {}", timer);
+
+  return overlays;
+}
+
+// When the standard cells are too small to be drawn, show where they are
+// from the precomputed density summary instead of leaving the core empty.
+void RenderThread::drawInstanceDensity(QPainter* painter, const Rect& bounds)
+{
+  const int instance_limit = viewer_->instanceSizeLimit();
+  if (instance_limit == 0) {
+    return;
+  }
+
+  auto grid = viewer_->tile_cache_.instanceDensity();
+  if (grid == nullptr || grid->density.empty()
+      || grid->max_cell_height >= instance_limit) {
+    return;
+  }
+
+  if (!bounds.intersects(grid->area)) {
+    return;
+  }
+  const Rect area = bounds.intersect(grid->area);
+
+  const int x_lo = (area.xMin() - grid->area.xMin()) / grid->bin_size;
+  const int y_lo = (area.yMin() - grid->area.yMin()) / grid->bin_size;
+  const int x_hi = std::min(grid->bins_x - 1,
+                            (area.xMax() - grid->area.xMin()) / grid->bin_size);
+  const int y_hi = std::min(grid->bins_y - 1,
+                            (area.yMax() - grid->area.yMin()) / grid->bin_size);
+
+  painter->setPen(Qt::NoPen);
+  for (int y = y_lo; y <= y_hi; y++) {
+    for (int x = x_lo; x <= x_hi; x++) {
+      const float density = grid->density[y * grid->bins_x + x];
+      if (density == 0) {
+        continue;
+      }
+      QColor color(Qt::gray);
+      color.setAlphaF(0.6 * density);
+      painter->setBrush(color);
+      painter->drawRect(grid->area.xMin() + x * grid->bin_size,
+                        grid->area.yMin() + y * grid->bin_size,
+                        grid->bin_size,
+                        grid->bin_size);
+    }
+  }
+  painter->setBrush(QBrush());
+}
+
+// Layers of the child block technologies are drawn first
+std::vector<dbTechLayer*> RenderThread::layersInDrawOrder(dbBlock* block)
+{
+  dbTech* tech = block->getTech();
+  std::set<dbTech*> child_techs;
+  for (auto child : block->getChildren()) {
+    dbTech* child_tech = child->getTech();
+    if (child_tech != tech) {
+      child_techs.insert(child_tech);
+    }
+  }
+
+  std::vector<dbTechLayer*> layers;
+  for (dbTech* child_tech : child_techs) {
+    for (dbTechLayer* layer : child_tech->getLayers()) {
+      layers.push_back(layer);
+    }
+  }
+  for (dbTechLayer* layer : tech->getLayers()) {
+    layers.push_back(layer);
+  }
+
+  return layers;
+}
+
 QColor RenderThread::getColor(dbTechLayer* layer)
 {
-  return viewer_->options_->color(layer);
+  return options_->color(layer);
 }
 
 Qt::BrushStyle RenderThread::getPattern(dbTechLayer* layer)
 {
-  return viewer_->options_->pattern(layer);
+  return options_->pattern(layer);
 }
 
 void RenderThread::addInstTransform(QTransform& xfm,
@@ -276,6 +690,15 @@ void RenderThread::addInstTransform(QTransform& xfm,
   }
 }
 
+bool RenderThread::isNetVisible(odb::dbNet* net)
+{
+  const auto& focus_nets = viewer_->focus_nets_;
+  if (!focus_nets.empty() && focus_nets.find(net) == focus_nets.end()) {
+    return false;
+  }
+  return options_->isNetVisible(net);
+}
+
 bool RenderThread::instanceBelowMinSize(dbInst* inst)
 {
   dbMaster* master = inst->getMaster();
@@ -293,12 +716,23 @@ bool RenderThread::instanceBelowMinSize(dbInst* inst)
   return false;
 }
 
+// The maximum sizes are computed for every cut layer when the block is
+// set.  Avoid operator[] here as tiles are drawn from several threads.
+int RenderThread::cutMaximumSize(dbTechLayer* layer) const
+{
+  auto itr = viewer_->cut_maximum_size_.find(layer);
+  if (itr == viewer_->cut_maximum_size_.end()) {
+    return 0;
+  }
+  return itr->second;
+}
+
 void RenderThread::drawTracks(dbTechLayer* layer,
                               QPainter* painter,
                               const Rect& bounds)
 {
-  if (!viewer_->options_->arePrefTracksVisible()
-      && !viewer_->options_->areNonPrefTracksVisible()) {
+  if (!options_->arePrefTracksVisible()
+      && !options_->areNonPrefTracksVisible()) {
     return;
   }
 
@@ -316,8 +750,8 @@ void RenderThread::drawTracks(dbTechLayer* layer,
 
   bool is_horizontal = layer->getDirection() == dbTechLayerDir::HORIZONTAL;
   std::vector<int> grids;
-  if ((!is_horizontal && viewer_->options_->arePrefTracksVisible())
-      || (is_horizontal && viewer_->options_->areNonPrefTracksVisible())) {
+  if ((!is_horizontal && options_->arePrefTracksVisible())
+      || (is_horizontal && options_->areNonPrefTracksVisible())) {
     bool show_grid = true;
     for (int i = 0; i < grid->getNumGridPatternsX(); i++) {
       int origin, line_count, step;
@@ -342,8 +776,8 @@ void RenderThread::drawTracks(dbTechLayer* layer,
     }
   }
 
-  if ((is_horizontal && viewer_->options_->arePrefTracksVisible())
-      || (!is_horizontal && viewer_->options_->areNonPrefTracksVisible())) {
+  if ((is_horizontal && options_->arePrefTracksVisible())
+      || (!is_horizontal && options_->areNonPrefTracksVisible())) {
     bool show_grid = true;
     for (int i = 0; i < grid->getNumGridPatternsY(); i++) {
       int origin, line_count, step;
@@ -373,7 +807,7 @@ void RenderThread::drawRows(QPainter* painter,
                             odb::dbBlock* block,
                             const Rect& bounds)
 {
-  if (!viewer_->options_->areSitesVisible()) {
+  if (!options_->areSitesVisible()) {
     return;
   }
 
@@ -387,8 +821,8 @@ void RenderThread::drawRows(QPainter* painter,
     } else {
       site = static_cast<odb::dbRow*>(row)->getSite();
     }
-    if (viewer_->options_->isSiteVisible(site)) {
-      QPen pen(viewer_->options_->siteColor(site));
+    if (options_->isSiteVisible(site)) {
+      QPen pen(options_->siteColor(site));
       pen.setCosmetic(true);
       painter->setPen(pen);
       painter->setBrush(Qt::NoBrush);
@@ -400,7 +834,7 @@ void RenderThread::drawRows(QPainter* painter,
 
 void RenderThread::drawSelected(Painter& painter, const SelectionSet& selected)
 {
-  if (!viewer_->options_->areSelectedVisible()) {
+  if (!options_->areSelectedVisible()) {
     return;
   }
 
@@ -434,7 +868,7 @@ void RenderThread::drawHighlighted(Painter& painter,
 
 void RenderThread::drawRulers(Painter& painter, const Rulers& rulers)
 {
-  if (!viewer_->options_->areRulersVisible()) {
+  if (!options_->areRulersVisible()) {
     return;
   }
 
@@ -505,10 +939,11 @@ void RenderThread::drawInstanceShapes(dbTechLayer* layer,
                                       QPainter* painter,
                                       const std::vector<odb::dbInst*>& insts,
                                       const Rect& bounds,
-                                      GuiPainter& gui_painter)
+                                      GuiPainter& gui_painter,
+                                      bool tile)
 {
-  const bool show_blockages = viewer_->options_->areInstanceBlockagesVisible();
-  const bool show_pins = viewer_->options_->areInstancePinsVisible();
+  const bool show_blockages = options_->areInstanceBlockagesVisible();
+  const bool show_pins = options_->areInstancePinsVisible();
   if (!show_blockages && !show_pins) {
     return;
   }
@@ -549,12 +984,12 @@ void RenderThread::drawInstanceShapes(dbTechLayer* layer,
       child_insts.clear();
       child_insts.reserve(10000);
       for (auto* inst : inst_range) {
-        if (viewer_->options_->isInstanceVisible(inst)) {
+        if (options_->isInstanceVisible(inst)) {
           child_insts.push_back(inst);
         }
       }
 
-      drawLayer(painter, child, layer, child_insts, bbox, gui_painter);
+      drawLayer(painter, child, layer, child_insts, bbox, gui_painter, tile);
       continue;
     }
 
@@ -599,13 +1034,13 @@ void RenderThread::drawInstanceShapes(dbTechLayer* layer,
 void RenderThread::drawInstanceNames(QPainter* painter,
                                      const std::vector<odb::dbInst*>& insts)
 {
-  if (!viewer_->options_->areInstanceNamesVisible()) {
+  if (!options_->areInstanceNamesVisible()) {
     return;
   }
 
-  const QColor text_color = viewer_->options_->instanceNameColor();
+  const QColor text_color = options_->instanceNameColor();
   const QFont initial_font = painter->font();
-  const QFont text_font = viewer_->options_->instanceNameFont();
+  const QFont text_font = options_->instanceNameFont();
 
   painter->setFont(text_font);
   for (auto inst : insts) {
@@ -631,13 +1066,13 @@ void RenderThread::drawInstanceNames(QPainter* painter,
 void RenderThread::drawITermLabels(QPainter* painter,
                                    const std::vector<odb::dbInst*>& insts)
 {
-  if (!viewer_->options_->areInstancePinsVisible()
-      || !viewer_->options_->areInstancePinNamesVisible()) {
+  if (!options_->areInstancePinsVisible()
+      || !options_->areInstancePinNamesVisible()) {
     return;
   }
 
-  const QColor text_color = viewer_->options_->itermLabelColor();
-  const QFont text_font = viewer_->options_->itermLabelFont();
+  const QColor text_color = options_->itermLabelColor();
+  const QFont text_font = options_->itermLabelFont();
   const QFont initial_font = painter->font();
 
   painter->setFont(text_font);
@@ -659,7 +1094,7 @@ void RenderThread::drawITermLabels(QPainter* painter,
           if (layer == nullptr) {
             continue;
           }
-          if (viewer_->options_->isVisible(layer)) {
+          if (options_->isVisible(layer)) {
             Rect pin_rect = geom->getBox();
             xform.apply(pin_rect);
             const QString name = inst_iterm->getMTerm()->getConstName();
@@ -784,12 +1219,12 @@ void RenderThread::drawBlockages(QPainter* painter,
                                  odb::dbBlock* block,
                                  const Rect& bounds)
 {
-  if (!viewer_->options_->areBlockagesVisible()) {
+  if (!options_->areBlockagesVisible()) {
     return;
   }
   painter->setPen(Qt::NoPen);
-  painter->setBrush(QBrush(viewer_->options_->placementBlockageColor(),
-                           viewer_->options_->placementBlockagePattern()));
+  painter->setBrush(QBrush(options_->placementBlockageColor(),
+                           options_->placementBlockagePattern()));
 
   auto blockage_range
       = viewer_->search_.searchBlockages(block,
@@ -813,8 +1248,8 @@ void RenderThread::drawObstructions(odb::dbBlock* block,
                                     QPainter* painter,
                                     const Rect& bounds)
 {
-  if (!viewer_->options_->areObstructionsVisible()
-      || !viewer_->options_->isVisible(layer)) {
+  if (!options_->areObstructionsVisible()
+      || !options_->isVisible(layer)) {
     return;
   }
 
@@ -861,7 +1296,7 @@ void RenderThread::drawViaShapes(QPainter* painter,
     if (restart_) {
       break;
     }
-    if (!viewer_->isNetVisible(net)) {
+    if (!isNetVisible(net)) {
       continue;
     }
 
@@ -882,9 +1317,10 @@ void RenderThread::drawLayer(QPainter* painter,
                              dbTechLayer* layer,
                              const std::vector<dbInst*>& insts,
                              const Rect& bounds,
-                             GuiPainter& gui_painter)
+                             GuiPainter& gui_painter,
+                             bool tile)
 {
-  if (!viewer_->options_->isVisible(layer)) {
+  if (!options_->isVisible(layer)) {
     return;
   }
   utl::Timer layer_timer;
@@ -894,20 +1330,20 @@ void RenderThread::drawLayer(QPainter* painter,
   // Skip the cut layer if the cuts will be too small to see
   const bool draw_shapes
       = !(layer->getType() == dbTechLayerType::CUT
-          && viewer_->cut_maximum_size_[layer] < shape_limit);
+          && cutMaximumSize(layer) < shape_limit);
   const bool layer_is_routing = layer->getType() == dbTechLayerType::CUT
                                 || layer->getType() == dbTechLayerType::ROUTING;
 
   if (draw_shapes) {
-    drawInstanceShapes(layer, painter, insts, bounds, gui_painter);
+    drawInstanceShapes(layer, painter, insts, bounds, gui_painter, tile);
   }
 
   drawObstructions(block, layer, painter, bounds);
 
   const bool draw_routing
-      = viewer_->options_->areRoutingSegmentsVisible() && layer_is_routing;
+      = options_->areRoutingSegmentsVisible() && layer_is_routing;
   const bool draw_vias
-      = viewer_->options_->areRoutingViasVisible() && layer_is_routing;
+      = options_->areRoutingViasVisible() && layer_is_routing;
   // Now draw the shapes
   QColor color = getColor(layer);
   Qt::BrushStyle brush_pattern = getPattern(layer);
@@ -935,7 +1371,7 @@ void RenderThread::drawLayer(QPainter* painter,
           // Don't draw since it's a via
           continue;
         }
-        if (!viewer_->isNetVisible(net)) {
+        if (!isNetVisible(net)) {
           continue;
         }
         const auto& ll = box.ll();
@@ -943,7 +1379,7 @@ void RenderThread::drawLayer(QPainter* painter,
       }
     }
 
-    if (viewer_->options_->areSpecialRoutingViasVisible() && layer_is_routing) {
+    if (options_->areSpecialRoutingViasVisible() && layer_is_routing) {
       if (layer->getType() == dbTechLayerType::CUT) {
         drawViaShapes(painter, block, layer, layer, bounds, shape_limit);
       } else {
@@ -952,19 +1388,19 @@ void RenderThread::drawLayer(QPainter* painter,
         // will be too small based on the cut size (enclosure shapes
         // are generally only slightly larger).
         if (auto upper = layer->getUpperLayer()) {
-          if (viewer_->cut_maximum_size_[upper] >= shape_limit) {
+          if (cutMaximumSize(upper) >= shape_limit) {
             drawViaShapes(painter, block, upper, layer, bounds, shape_limit);
           }
         }
         if (auto lower = layer->getLowerLayer()) {
-          if (viewer_->cut_maximum_size_[lower] >= shape_limit) {
+          if (cutMaximumSize(lower) >= shape_limit) {
             drawViaShapes(painter, block, lower, layer, bounds, shape_limit);
           }
         }
       }
     }
 
-    if (viewer_->options_->areSpecialRoutingSegmentsVisible()
+    if (options_->areSpecialRoutingSegmentsVisible()
         && layer_is_routing) {
       auto polygon_iter = viewer_->search_.searchSNetShapes(block,
                                                             layer,
@@ -978,7 +1414,7 @@ void RenderThread::drawLayer(QPainter* painter,
         if (restart_) {
           break;
         }
-        if (!viewer_->isNetVisible(net)) {
+        if (!isNetVisible(net)) {
           continue;
         }
         const auto& points = poly.getPoints();
@@ -992,7 +1428,7 @@ void RenderThread::drawLayer(QPainter* painter,
     }
 
     // Now draw the fills
-    if (viewer_->options_->areFillsVisible()) {
+    if (options_->areFillsVisible()) {
       QColor color = getColor(layer).lighter(50);
       Qt::BrushStyle brush_pattern = getPattern(layer);
       painter->setBrush(QBrush(color, brush_pattern));
@@ -1018,7 +1454,7 @@ void RenderThread::drawLayer(QPainter* painter,
   }
 
   if (draw_shapes) {
-    if (viewer_->options_->areIOPinsVisible()) {
+    if (!tile && options_->areIOPinsVisible()) {
       utl::Timer io_pins;
       drawIOPins(gui_painter, block, bounds, layer);
       debugPrint(logger_,
@@ -1035,13 +1471,15 @@ void RenderThread::drawLayer(QPainter* painter,
     drawNetTracks(gui_painter, layer);
   }
 
-  for (auto* renderer : Gui::get()->renderers()) {
-    if (restart_) {
-      break;
+  if (!tile) {
+    for (auto* renderer : Gui::get()->renderers()) {
+      if (restart_) {
+        break;
+      }
+      gui_painter.saveState();
+      renderer->drawLayer(layer, gui_painter);
+      gui_painter.restoreState();
     }
-    gui_painter.saveState();
-    renderer->drawLayer(layer, gui_painter);
-    gui_painter.restoreState();
   }
   debugPrint(logger_,
              GUI,
@@ -1057,34 +1495,41 @@ void RenderThread::drawLayer(QPainter* painter,
 void RenderThread::drawBlock(QPainter* painter,
                              dbBlock* block,
                              const Rect& bounds,
-                             int depth)
+                             int depth,
+                             const TileBand* band)
 {
   utl::Timer timer;
 
+  const bool tile = band != nullptr;
+  const bool draw_before = !tile || band->first;
+  const bool draw_after = !tile || band->last;
+
   utl::Timer manufacturing_grid_timer;
   const int instance_limit = viewer_->instanceSizeLimit();
 
   GuiPainter gui_painter(painter,
-                         viewer_->options_,
+                         options_,
                          bounds,
                          viewer_->pixels_per_dbu_,
                          block->getDbUnitsPerMicron());
 
-  // Draw die area, if set
-  painter->setPen(QPen(Qt::gray, 0));
-  painter->setBrush(QBrush());
-  Rect bbox = block->getDieArea();
-  if (bbox.area() > 0) {
-    painter->drawRect(bbox.xMin(), bbox.yMin(), bbox.dx(), bbox.dy());
-  }
+  if (draw_before) {
+    // Draw die area, if set
+    painter->setPen(QPen(Qt::gray, 0));
+    painter->setBrush(QBrush());
+    Rect bbox = block->getDieArea();
+    if (bbox.area() > 0) {
+      painter->drawRect(bbox.xMin(), bbox.yMin(), bbox.dx(), bbox.dy());
+    }
 
-  drawManufacturingGrid(painter, bounds);
-  debugPrint(logger_,
-             GUI,
-             "draw",
-             1,
-             "manufacturing grid {}",
-             manufacturing_grid_timer);
+    drawManufacturingGrid(painter, bounds);
+    debugPrint(logger_,
+               GUI,
+               "draw",
+               1,
+               "manufacturing grid {}",
+               manufacturing_grid_timer);
+  }
 
   utl::Timer inst_timer;
   auto inst_range = viewer_->search_.searchInsts(block,
@@ -1102,48 +1547,47 @@ void RenderThread::drawBlock(QPainter* painter,
     if (restart_) {
       break;
     }
-    if (viewer_->options_->isInstanceVisible(inst)) {
+    if (options_->isInstanceVisible(inst)) {
       insts.push_back(inst);
     }
   }
   debugPrint(logger_, GUI, "draw", 1, "inst search {}", inst_timer);
 
-  utl::Timer io_pins_setup;
-  setupIOPins(block, bounds);
-  debugPrint(logger_, GUI, "draw", 1, "io pins setup {}", io_pins_setup);
-
-  utl::Timer insts_outline;
-  drawInstanceOutlines(painter, insts);
-  debugPrint(logger_, GUI, "draw", 1, "inst outline render {}", insts_outline);
-
-  // draw blockages
-  utl::Timer inst_blockages;
-  drawBlockages(painter, block, bounds);
-  debugPrint(logger_, GUI, "draw", 1, "blockages {}", inst_blockages);
-
-  dbTech* tech = block->getTech();
-  std::set<dbTech*> child_techs;
-  for (auto child : block->getChildren()) {
-    dbTech* child_tech = child->getTech();
-    if (child_tech != tech) {
-      child_techs.insert(child_tech);
-    }
+  if (!tile) {
+    utl::Timer io_pins_setup;
+    setupIOPins(block, bounds);
+    debugPrint(logger_, GUI, "draw", 1, "io pins setup {}", io_pins_setup);
+  } else if (depth == 0 && band->first) {
+    utl::Timer inst_density;
+    drawInstanceDensity(painter, bounds);
+    debugPrint(logger_, GUI, "draw", 1, "inst density {}", inst_density);
   }
 
-  for (dbTech* child_tech : child_techs) {
-    for (dbTechLayer* layer : child_tech->getLayers()) {
-      if (restart_) {
-        break;
-      }
-      drawLayer(painter, block, layer, insts, bounds, gui_painter);
-    }
+  if (draw_before) {
+    utl::Timer insts_outline;
+    drawInstanceOutlines(painter, insts);
+    debugPrint(
+        logger_, GUI, "draw", 1, "inst outline render {}", insts_outline);
+
+    // draw blockages
+    utl::Timer inst_blockages;
+    drawBlockages(painter, block, bounds);
+    debugPrint(logger_, GUI, "draw", 1, "blockages {}", inst_blockages);
   }
 
-  for (dbTechLayer* layer : tech->getLayers()) {
+  const std::vector<dbTechLayer*> layers = layersInDrawOrder(block);
+  const int first_layer = tile ? band->first_layer : 0;
+  const int last_layer = tile ? band->last_layer : layers.size();
+  for (int i = first_layer; i < last_layer; i++) {
     if (restart_) {
       break;
     }
-    drawLayer(painter, block, layer, insts, bounds, gui_painter);
+    drawLayer(painter, block, layers[i], insts, bounds, gui_painter, tile);
+  }
+
+  if (!draw_after) {
+    debugPrint(logger_, GUI, "draw", 1, "total render {}", timer);
+    return;
   }
 
   utl::Timer inst_names;
@@ -1159,7 +1603,7 @@ void RenderThread::drawBlock(QPainter* painter,
   debugPrint(logger_, GUI, "draw", 1, "rows {}", inst_rows);
 
   utl::Timer inst_access_points;
-  if (viewer_->options_->areAccessPointsVisible()) {
+  if (options_->areAccessPointsVisible()) {
     drawAccessPoints(gui_painter, insts);
   }
   debugPrint(logger_, GUI, "draw", 1, "access points {}", inst_access_points);
@@ -1176,23 +1620,25 @@ void RenderThread::drawBlock(QPainter* painter,
   drawGCellGrid(painter, bounds);
   debugPrint(logger_, GUI, "draw", 1, "save cell grid {}", inst_cell_grid);
 
-  utl::Timer inst_save_restore;
-  for (auto* renderer : Gui::get()->renderers()) {
-    if (restart_) {
-      break;
+  if (!tile) {
+    utl::Timer inst_save_restore;
+    for (auto* renderer : Gui::get()->renderers()) {
+      if (restart_) {
+        break;
+      }
+      gui_painter.saveState();
+      renderer->drawObjects(gui_painter);
+      gui_painter.restoreState();
     }
-    gui_painter.saveState();
-    renderer->drawObjects(gui_painter);
-    gui_painter.restoreState();
+    debugPrint(logger_, GUI, "draw", 1, "renderers {}", inst_save_restore);
   }
-  debugPrint(logger_, GUI, "draw", 1, "renderers {}", inst_save_restore);
 
   debugPrint(logger_, GUI, "draw", 1, "total render {}", timer);
 }
 
 void RenderThread::drawGCellGrid(QPainter* painter, const odb::Rect& bounds)
 {
-  if (!viewer_->options_->isGCellGridVisible()) {
+  if (!options_->isGCellGridVisible()) {
     return;
   }
 
@@ -1242,7 +1688,7 @@ void RenderThread::drawGCellGrid(QPainter* painter, const odb::Rect& bounds)
 void RenderThread::drawManufacturingGrid(QPainter* painter,
                                          const odb::Rect& bounds)
 {
-  if (!viewer_->options_->isManufacturingGridVisible()) {
+  if (!options_->isManufacturingGridVisible()) {
     return;
   }
 
@@ -1282,13 +1728,13 @@ void RenderThread::drawManufacturingGrid(QPainter* painter,
 
 void RenderThread::drawRegions(QPainter* painter, odb::dbBlock* block)
 {
-  if (!viewer_->options_->areRegionsVisible()) {
+  if (!options_->areRegionsVisible()) {
     return;
   }
 
   painter->setPen(QPen(Qt::gray, 0));
-  painter->setBrush(QBrush(viewer_->options_->regionColor(),
-                           viewer_->options_->regionPattern()));
+  painter->setBrush(QBrush(options_->regionColor(),
+                           options_->regionPattern()));
 
   for (auto* region : block->getRegions()) {
     for (auto* box : region->getBoundaries()) {
@@ -1359,7 +1805,7 @@ void RenderThread::drawAccessPoints(Painter& painter,
     if (ap == nullptr) {
       return;
     }
-    if (!viewer_->options_->isVisible(ap->getLayer())) {
+    if (!options_->isVisible(ap->getLayer())) {
       return;
     }
 
@@ -1371,7 +1817,7 @@ void RenderThread::drawAccessPoints(Painter& painter,
     painter.drawX(pt.x(), pt.y(), shape_size);
   };
 
-  if (viewer_->options_->areInstancePinsVisible()) {
+  if (options_->areInstancePinsVisible()) {
     for (auto* inst : insts) {
       if (restart_) {
         break;
@@ -1402,7 +1848,7 @@ void RenderThread::drawAccessPoints(Painter& painter,
 void RenderThread::drawModuleView(QPainter* painter,
                                   const std::vector<odb::dbInst*>& insts)
 {
-  if (!viewer_->options_->isModuleView()) {
+  if (!options_->isModuleView()) {
     return;
   }
 
@@ -1438,7 +1884,7 @@ void RenderThread::drawModuleView(QPainter* painter,
 void RenderThread::setupIOPins(odb::dbBlock* block, const odb::Rect& bounds)
 {
   pins_.clear();
-  if (!viewer_->options_->areIOPinsVisible()) {
+  if (!options_->areIOPinsVisible()) {
     return;
   }
 
@@ -1453,7 +1899,7 @@ void RenderThread::setupIOPins(odb::dbBlock* block, const odb::Rect& bounds)
   const double abs_min_dim = 8.0;  // prevent markers from falling apart
   pin_max_size_ = std::max(scale_factor * die_max_dim, abs_min_dim);
 
-  pin_font_ = viewer_->options_->pinMarkersFont();
+  pin_font_ = options_->pinMarkersFont();
   const QFontMetrics font_metrics(pin_font_);
 
   QString largest_text;
@@ -1503,7 +1949,7 @@ void RenderThread::setupIOPins(odb::dbBlock* block, const odb::Rect& bounds)
     if (restart_) {
       break;
     }
-    if (!viewer_->isNetVisible(term->getNet())) {
+    if (!isNetVisible(term->getNet())) {
       continue;
     }
     for (odb::dbBPin* pin : term->getBPins()) {
@@ -35,12 +35,18 @@
 #include <QMutex>
 #include <QPainter>
 #include <QThread>
+#include <QThreadPool>
 #include <QWaitCondition>
+#include <memory>
 #include <mutex>
+#include <utility>
+#include <vector>
 
 #include "gui/gui.h"
 #include "odb/db.h"
+#include "optionsSnapshot.h"
 #include "ruler.h"
+#include "tileCache.h"
 #include "utl/Logger.h"
 
 namespace gui {
@@ -73,6 +79,17 @@ class RenderThread : public QThread
             qreal render_ratio,
             const QColor& background);
 
+  // Draws the view from the tile cache, rendering any missing tiles in
+  // parallel.  Used by the render thread and the render benchmark.  The
+  // options are a snapshot taken on the GUI thread as the tile threads
+  // may not call into the display controls.
+  void drawTiled(QImage& image,
+                 const QRect& draw_bounds,
+                 const SelectionSet& selected,
+                 const HighlightSet& highlighted,
+                 const Rulers& rulers,
+                 OptionsSnapshot* options);
+
   bool isFirstRenderDone() { return is_first_render_done_; };
   bool isRendering() { return is_rendering_; };
 
@@ -84,16 +101,46 @@ class RenderThread : public QThread
 
   void setupIOPins(odb::dbBlock* block, const odb::Rect& bounds);
 
+  // One band of a tile: the layers [first_layer, last_layer) of
+  // layersInDrawOrder().  The first band also holds what is drawn before
+  // the layers and the last band what is drawn after them.
+  struct TileBand
+  {
+    int first_layer;
+    int last_layer;
+    bool first;
+    bool last;
+  };
+  // An image of the IO pins and renderer output of one layer
+  using LayerOverlay = std::pair<odb::dbTechLayer*, QImage>;
+
+  // When band is set only the content that can be cached in that band of
+  // a tile is drawn; drawLayerOverlays() draws the rest.
   void drawBlock(QPainter* painter,
                  odb::dbBlock* block,
                  const odb::Rect& bounds,
-                 int depth);
+                 int depth,
+                 const TileBand* band = nullptr);
   void drawLayer(QPainter* painter,
                  odb::dbBlock* block,
                  odb::dbTechLayer* layer,
                  const std::vector<odb::dbInst*>& insts,
                  const odb::Rect& bounds,
-                 GuiPainter& gui_painter);
+                 GuiPainter& gui_painter,
+                 bool tile);
+  void drawTiles(QPainter* painter,
+                 const QRect& draw_bounds,
+                 const TileCache::View& view,
+                 const std::vector<LayerOverlay>& overlays);
+  TileCache::Tile renderTile(const TileCache::View& view,
+                             const QPoint& index,
+                             int margin);
+  int tileMargin() const;
+  std::vector<LayerOverlay> drawLayerOverlays(odb::dbBlock* block,
+                                              const QRect& draw_bounds,
+                                              const odb::Rect& bounds);
+  void drawInstanceDensity(QPainter* painter, const odb::Rect& bounds);
+  std::vector<odb::dbTechLayer*> layersInDrawOrder(odb::dbBlock* block);
   void drawRegions(QPainter* painter, odb::dbBlock* block);
   void drawTracks(odb::dbTechLayer* layer,
                   QPainter* painter,
@@ -105,7 +152,8 @@ class RenderThread : public QThread
                           QPainter* painter,
                           const std::vector<odb::dbInst*>& insts,
                           const odb::Rect& bounds,
-                          GuiPainter& gui_painter);
+                          GuiPainter& gui_painter,
+                          bool tile);
   void drawInstanceNames(QPainter* painter,
                          const std::vector<odb::dbInst*>& insts);
   void drawITermLabels(QPainter* painter,
@@ -150,6 +198,8 @@ class RenderThread : public QThread
   void drawRulers(Painter& painter, const Rulers& rulers);
 
   bool instanceBelowMinSize(odb::dbInst* inst);
+  bool isNetVisible(odb::dbNet* net);
+  int cutMaximumSize(odb::dbTechLayer* layer) const;
 
   void addInstTransform(QTransform& xfm, const odb::dbTransform& inst_xfm);
   QColor getColor(odb::dbTechLayer* layer);
@@ -160,6 +210,10 @@ class RenderThread : public QThread
   utl::Logger* logger_ = nullptr;
   LayoutViewer* viewer_;
   std::mutex drawing_mutex_;
+  // The display options of the current draw
+  Options* options_ = nullptr;
+  // Renders the missing tiles; kept between frames
+  QThreadPool tile_pool_;
 
   // These variables are cached copies of what's passed to render().
   // The draw method will the make a local copy of them to avoid any
@@ -169,6 +223,7 @@ class RenderThread : public QThread
   SelectionSet selected_;
   HighlightSet highlighted_;
   Rulers rulers_;
+  std::unique_ptr<OptionsSnapshot> options_snapshot_;
 
   QMutex mutex_;
   QWaitCondition condition_;
@@ -32,6 +32,12 @@
 
 #include "search.h"
 
+#include <QThread>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <iterator>
+#include <thread>
 #include <tuple>
 #include <utility>
 
@@ -39,6 +45,96 @@
 
 namespace gui {
 
+// Adds values to the tree of a layer, or to its pending shapes if the
+// tree has not been packed yet.
+template <typename Tree, typename Value>
+static void insertShapes(const bool packed,
+                         Tree& tree,
+                         std::vector<Value>& pending,
+                         const std::vector<Value>& values)
+{
+  if (packed) {
+    tree.insert(values.begin(), values.end());
+  } else {
+    pending.insert(pending.end(), values.begin(), values.end());
+  }
+}
+
+// Removes the values within area that satisfy predicate from the tree of
+// a layer, or from its pending shapes if the tree has not been packed yet.
+template <typename Tree, typename Value, typename Predicate>
+static void removeShapes(const bool packed,
+                         Tree& tree,
+                         std::vector<Value>& pending,
+                         const odb::Rect& area,
+                         const Predicate& predicate)
+{
+  if (packed) {
+    std::vector<Value> found;
+    tree.query(bgi::intersects(area) && bgi::satisfies(predicate),
+               std::back_inserter(found));
+    tree.remove(found.begin(), found.end());
+  } else {
+    pending.erase(std::remove_if(pending.begin(), pending.end(), predicate),
+                  pending.end());
+  }
+}
+
+namespace {
+// The searches the thread holds shared, once for each of its read locks
+thread_local std::vector<const Search*> read_searches;
+}  // namespace
+
+Search::ReadLock::ReadLock(Search* search) : search_(search)
+{
+  if (std::find(read_searches.begin(), read_searches.end(), search)
+      == read_searches.end()) {
+    search->tree_mutex_.lock_shared();
+  }
+  read_searches.push_back(search);
+}
+
+Search::ReadLock::ReadLock(ReadLock&& other) noexcept
+    : search_(std::exchange(other.search_, nullptr))
+{
+}
+
+Search::ReadLock& Search::ReadLock::operator=(ReadLock&& other) noexcept
+{
+  if (this != &other) {
+    release();
+    search_ = std::exchange(other.search_, nullptr);
+  }
+  return *this;
+}
+
+Search::ReadLock::~ReadLock()
+{
+  release();
+}
+
+void Search::ReadLock::release()
+{
+  if (search_ == nullptr) {
+    return;
+  }
+  read_searches.erase(
+      std::find(read_searches.begin(), read_searches.end(), search_));
+  if (std::find(read_searches.begin(), read_searches.end(), search_)
+      == read_searches.end()) {
+    search_->tree_mutex_.unlock_shared();
+  }
+  search_ = nullptr;
+}
+
+// Pins are drawn unless they are unplaced, unlike instances a suggested
+// location is shown.
+static bool isDrawn(const odb::dbPlacementStatus& status)
+{
+  return status != odb::dbPlacementStatus::NONE
+         && status != odb::dbPlacementStatus::UNPLACED;
+}
+
 Search::~Search()
 {
   if (top_block_ != nullptr) {
@@ -46,98 +142,268 @@ Search::~Search()
   }
 }
 
+template <typename Func>
+void Search::modifyIfBuilt(std::atomic_bool& flag, const Func& update)
+{
+  {
+    std::unique_lock<std::shared_mutex> lock(tree_mutex_);
+    if (!flag) {
+      return;  // built from the current database on the next search
+    }
+    update();
+  }
+  emit modified();
+}
+
 void Search::inDbNetDestroy(odb::dbNet* net)
 {
-  clearShapes();
+  modifyIfBuilt(top_block_data_.shapes_init_,
+                [this, net] { removeNetShapes(net, true); });
+}
+
+void Search::inDbInstCreate(odb::dbInst* inst)
+{
+  if (inst->isPlaced()) {
+    modifyIfBuilt(top_block_data_.insts_init_,
+                  [this, inst] { insertInst(inst); });
+  }
+}
+
+void Search::inDbInstCreate(odb::dbInst* inst, odb::dbRegion* region)
+{
+  inDbInstCreate(inst);
 }
 
 void Search::inDbInstDestroy(odb::dbInst* inst)
 {
   if (inst->isPlaced()) {
-    clearInsts();
+    modifyIfBuilt(top_block_data_.insts_init_,
+                  [this, inst] { removeInst(inst); });
+  }
+}
+
+void Search::inDbInstSwapMasterBefore(odb::dbInst* inst, odb::dbMaster* master)
+{
+  if (inst->isPlaced()) {
+    modifyIfBuilt(top_block_data_.insts_init_,
+                  [this, inst] { removeInst(inst); });
   }
 }
 
 void Search::inDbInstSwapMasterAfter(odb::dbInst* inst)
 {
   if (inst->isPlaced()) {
-    clearInsts();
+    modifyIfBuilt(top_block_data_.insts_init_,
+                  [this, inst] { insertInst(inst); });
   }
 }
 
 void Search::inDbInstPlacementStatusBefore(odb::dbInst* inst,
                                            const odb::dbPlacementStatus& status)
 {
-  if (inst->getPlacementStatus().isPlaced() != status.isPlaced()) {
-    clearInsts();
+  const bool was_placed = inst->getPlacementStatus().isPlaced();
+  if (was_placed == status.isPlaced()) {
+    return;
+  }
+  // The bounding box does not depend on the status so the instance can
+  // be inserted before the status changes.
+  modifyIfBuilt(top_block_data_.insts_init_, [this, inst, was_placed] {
+    if (was_placed) {
+      removeInst(inst);
+    } else {
+      insertInst(inst);
+    }
+  });
+}
+
+void Search::inDbPreMoveInst(odb::dbInst* inst)
+{
+  if (inst->isPlaced()) {
+    modifyIfBuilt(top_block_data_.insts_init_,
+                  [this, inst] { removeInst(inst); });
   }
 }
 
 void Search::inDbPostMoveInst(odb::dbInst* inst)
 {
   if (inst->isPlaced()) {
-    clearInsts();
+    modifyIfBuilt(top_block_data_.insts_init_,
+                  [this, inst] { insertInst(inst); });
   }
 }
 
-void Search::inDbBPinCreate(odb::dbBPin* pin)
+void Search::inDbBPinAddBox(odb::dbBox* box)
 {
-  clearShapes();
+  odb::dbBPin* pin = (odb::dbBPin*) box->getBoxOwner();
+  if (!isDrawn(pin->getPlacementStatus())) {
+    return;
+  }
+  modifyIfBuilt(top_block_data_.shapes_init_, [this, pin, box] {
+    odb::dbNet* net = pin->getBTerm()->getNet();
+    LayerShapes& shapes
+        = getOrCreateLayerShapes(top_block_data_, box->getTechLayer());
+    insertShapes(shapes.packed,
+                 shapes.box_shapes,
+                 shapes.pending_box_shapes,
+                 {{box->getBox(), false, net}});
+    mergeBounds(top_block_data_.net_bounds_, net, box->getBox());
+  });
+}
+
+void Search::inDbBPinPlacementStatusBefore(odb::dbBPin* pin,
+                                           const odb::dbPlacementStatus& status)
+{
+  const bool was_drawn = isDrawn(pin->getPlacementStatus());
+  if (was_drawn == isDrawn(status)) {
+    return;
+  }
+  modifyIfBuilt(top_block_data_.shapes_init_, [this, pin, was_drawn] {
+    if (was_drawn) {
+      removePinBoxes(pin);
+    } else {
+      insertPinBoxes(pin);
+    }
+  });
 }
 
 void Search::inDbBPinDestroy(odb::dbBPin* pin)
 {
-  clearShapes();
+  if (isDrawn(pin->getPlacementStatus())) {
+    modifyIfBuilt(top_block_data_.shapes_init_,
+                  [this, pin] { removePinBoxes(pin); });
+  }
 }
 
 void Search::inDbFillCreate(odb::dbFill* fill)
 {
-  clearFills();
+  modifyIfBuilt(top_block_data_.fills_init_, [this, fill] {
+    top_block_data_.fills_[fill->getTechLayer()].insert(fill);
+  });
 }
 
 void Search::inDbWireCreate(odb::dbWire* wire)
 {
-  clearShapes();
+  // Nothing to do as the wire is empty; the shapes are added by
+  // inDbWirePostModify once the wire is encoded.
 }
 
 void Search::inDbWireDestroy(odb::dbWire* wire)
 {
-  clearShapes();
+  odb::dbNet* net = wire->getNet();
+  if (net == nullptr || net->getWire() != wire) {
+    return;  // global wires are not displayed
+  }
+  modifyIfBuilt(top_block_data_.shapes_init_, [this, net] {
+    removeNetShapes(net, false);
+    insertNetShapes(net, false);  // restore the pins
+  });
+}
+
+void Search::inDbWirePostModify(odb::dbWire* wire)
+{
+  odb::dbNet* net = wire->getNet();
+  if (net == nullptr || net->getWire() != wire) {
+    return;  // global wires are not displayed
+  }
+  updateNetWire(net);
+}
+
+void Search::updateNetWire(odb::dbNet* net)
+{
+  modifyIfBuilt(top_block_data_.shapes_init_, [this, net] {
+    removeNetShapes(net, false);
+    insertNetShapes(net, true);
+  });
+}
+
+void Search::inDbWirePostAttach(odb::dbWire* wire)
+{
+  odb::dbNet* net = wire->getNet();
+  if (net != nullptr && net->getWire() == wire) {
+    updateNetWire(net);
+  }
+}
+
+void Search::inDbWirePreDetach(odb::dbWire* wire)
+{
+  odb::dbNet* net = wire->getNet();
+  if (net == nullptr || net->getWire() != wire) {
+    return;  // global wires are not displayed
+  }
+  modifyIfBuilt(top_block_data_.shapes_init_, [this, net] {
+    removeNetShapes(net, false);
+    insertNetShapes(net, false);  // restore the pins
+  });
+}
+
+void Search::inDbWirePostAppend(odb::dbWire* src, odb::dbWire* dst)
+{
+  odb::dbNet* net = dst->getNet();
+  if (net != nullptr && net->getWire() == dst) {
+    updateNetWire(net);
+  }
+}
+
+void Search::inDbWirePostCopy(odb::dbWire* src, odb::dbWire* dst)
+{
+  odb::dbNet* net = dst->getNet();
+  if (net != nullptr && net->getWire() == dst) {
+    updateNetWire(net);
+  }
 }
 
 void Search::inDbSWireCreate(odb::dbSWire* wire)
 {
-  clearShapes();
+  // Nothing to do as the boxes are added by inDbSWireAddSBox
 }
 
 void Search::inDbSWireDestroy(odb::dbSWire* wire)
 {
-  clearShapes();
+  // Nothing to do as the boxes are removed by inDbSWirePreDestroySBoxes
 }
 
 void Search::inDbSWireAddSBox(odb::dbSBox* box)
 {
-  clearShapes();
+  modifyIfBuilt(top_block_data_.shapes_init_,
+                [this, box] { insertSBox(box); });
 }
 
 void Search::inDbSWireRemoveSBox(odb::dbSBox* box)
 {
-  clearShapes();
+  modifyIfBuilt(top_block_data_.shapes_init_,
+                [this, box] { removeSBox(box); });
+}
+
+void Search::inDbSWirePreDestroySBoxes(odb::dbSWire* wire)
+{
+  modifyIfBuilt(top_block_data_.shapes_init_, [this, wire] {
+    for (odb::dbSBox* box : wire->getWires()) {
+      removeSBox(box);
+    }
+  });
 }
 
 void Search::inDbBlockageCreate(odb::dbBlockage* blockage)
 {
-  clearBlockages();
+  modifyIfBuilt(top_block_data_.blockages_init_, [this, blockage] {
+    top_block_data_.blockages_.insert(blockage);
+  });
 }
 
 void Search::inDbObstructionCreate(odb::dbObstruction* obs)
 {
-  clearObstructions();
+  modifyIfBuilt(top_block_data_.obstructions_init_, [this, obs] {
+    odb::dbTechLayer* layer = obs->getBBox()->getTechLayer();
+    top_block_data_.obstructions_[layer].insert(obs);
+  });
 }
 
 void Search::inDbObstructionDestroy(odb::dbObstruction* obs)
 {
-  clearObstructions();
+  modifyIfBuilt(top_block_data_.obstructions_init_, [this, obs] {
+    odb::dbTechLayer* layer = obs->getBBox()->getTechLayer();
+    top_block_data_.obstructions_[layer].remove(obs);
+  });
 }
 
 void Search::inDbBlockSetDieArea(odb::dbBlock* block)
@@ -157,17 +423,16 @@ void Search::inDbRegionDestroy(odb::dbRegion* region)
 
 void Search::inDbRowCreate(odb::dbRow* row)
 {
-  clearRows();
+  modifyIfBuilt(top_block_data_.rows_init_, [this, row] {
+    top_block_data_.rows_.insert({row->getBBox(), row});
+  });
 }
 
 void Search::inDbRowDestroy(odb::dbRow* row)
 {
-  clearRows();
-}
-
-void Search::inDbWirePostModify(odb::dbWire* wire)
-{
-  clearShapes();
+  modifyIfBuilt(top_block_data_.rows_init_, [this, row] {
+    top_block_data_.rows_.remove({row->getBBox(), row});
+  });
 }
 
 void Search::setTopBlock(odb::dbBlock* block)
@@ -184,6 +449,7 @@ void Search::setTopBlock(odb::dbBlock* block)
     // Pre-populate children so we don't have to lock access to
     // child_block_data_ later
     if (block) {
+      std::unique_lock<std::shared_mutex> lock(tree_mutex_);
       for (auto child : block->getChildren()) {
         child_block_data_[child];
       }
@@ -206,42 +472,49 @@ void Search::announceModified(std::atomic_bool& flag)
 
 void Search::clear()
 {
+  std::unique_lock<std::shared_mutex> lock(tree_mutex_);
   child_block_data_.clear();
-  clearShapes();
-  clearFills();
-  clearInsts();
-  clearBlockages();
-  clearObstructions();
-  clearRows();
+  announceModified(top_block_data_.shapes_init_);
+  announceModified(top_block_data_.fills_init_);
+  announceModified(top_block_data_.insts_init_);
+  announceModified(top_block_data_.blockages_init_);
+  announceModified(top_block_data_.obstructions_init_);
+  announceModified(top_block_data_.rows_init_);
 }
 
 void Search::clearShapes()
 {
+  std::unique_lock<std::shared_mutex> lock(tree_mutex_);
   announceModified(top_block_data_.shapes_init_);
 }
 
 void Search::clearFills()
 {
+  std::unique_lock<std::shared_mutex> lock(tree_mutex_);
   announceModified(top_block_data_.fills_init_);
 }
 
 void Search::clearInsts()
 {
+  std::unique_lock<std::shared_mutex> lock(tree_mutex_);
   announceModified(top_block_data_.insts_init_);
 }
 
 void Search::clearBlockages()
 {
+  std::unique_lock<std::shared_mutex> lock(tree_mutex_);
   announceModified(top_block_data_.blockages_init_);
 }
 
 void Search::clearObstructions()
 {
+  std::unique_lock<std::shared_mutex> lock(tree_mutex_);
   announceModified(top_block_data_.obstructions_init_);
 }
 
 void Search::clearRows()
 {
+  std::unique_lock<std::shared_mutex> lock(tree_mutex_);
   announceModified(top_block_data_.rows_init_);
 }
 
@@ -250,58 +523,349 @@ Search::BlockData& Search::getData(odb::dbBlock* block)
   return block == top_block_ ? top_block_data_ : child_block_data_[block];
 }
 
-void Search::updateShapes(odb::dbBlock* block)
+void Search::LayerShapes::pack()
 {
-  BlockData& data = getData(block);
-  std::lock_guard<std::mutex> lock(data.shapes_init_mutex_);
-  if (data.shapes_init_) {
+  std::lock_guard<std::mutex> lock(pack_mutex);
+  if (packed) {
     return;  // already done by another thread
   }
 
-  data.box_shapes_.clear();
-  data.snet_via_shapes_.clear();
-  data.snet_shapes_.clear();
+  box_shapes = RtreeRoutingShapes<odb::dbNet*>(pending_box_shapes.begin(),
+                                               pending_box_shapes.end());
+  snet_via_shapes = RtreeSNetDBoxShapes<odb::dbNet*>(
+      pending_snet_via_shapes.begin(), pending_snet_via_shapes.end());
+  snet_shapes = RtreeSNetShapes<odb::dbNet*>(pending_snet_shapes.begin(),
+                                             pending_snet_shapes.end());
 
-  LayerMap<std::vector<SNetValue<odb::dbNet*>>> snet_shapes;
-  LayerMap<std::vector<SNetDBoxValue<odb::dbNet*>>> snet_net_via_shapes;
-  for (odb::dbNet* net : block->getNets()) {
-    addSNet(net, snet_shapes, snet_net_via_shapes);
+  // Release the memory
+  pending_box_shapes = {};
+  pending_snet_via_shapes = {};
+  pending_snet_shapes = {};
+
+  packed = true;
+}
+
+Search::LayerShapes* Search::getLayerShapes(odb::dbBlock* block,
+                                            odb::dbTechLayer* layer)
+{
+  BlockData& data = getData(block);
+  if (!data.shapes_init_) {
+    updateShapes(block);
+  }
+
+  auto it = data.layer_shapes_.find(layer);
+  if (it == data.layer_shapes_.end()) {
+    return nullptr;
+  }
+
+  LayerShapes* shapes = it->second.get();
+  if (!shapes->packed) {
+    shapes->pack();
   }
-  for (const auto& [layer, layer_shapes] : snet_shapes) {
-    data.snet_shapes_[layer] = RtreeSNetShapes<odb::dbNet*>(
-        layer_shapes.begin(), layer_shapes.end());
+  return shapes;
+}
+
+Search::LayerShapes& Search::getOrCreateLayerShapes(BlockData& data,
+                                                    odb::dbTechLayer* layer)
+{
+  auto& shapes = data.layer_shapes_[layer];
+  if (shapes == nullptr) {
+    shapes = std::make_unique<LayerShapes>();
   }
-  snet_shapes.clear();
-  for (const auto& [layer, layer_shapes] : snet_net_via_shapes) {
-    data.snet_via_shapes_[layer] = RtreeSNetDBoxShapes<odb::dbNet*>(
-        layer_shapes.begin(), layer_shapes.end());
+  return *shapes;
+}
+
+void Search::mergeBounds(std::vector<odb::Rect>& net_bounds,
+                         odb::dbNet* net,
+                         const odb::Rect& bounds)
+{
+  if (net == nullptr || bounds.isInverted()) {
+    return;
+  }
+  const uint id = net->getId();
+  if (id >= net_bounds.size()) {
+    odb::Rect empty;
+    empty.mergeInit();
+    net_bounds.resize(id + 1, empty);
+  }
+  net_bounds[id].merge(bounds);
+}
+
+void Search::insertInst(odb::dbInst* inst)
+{
+  top_block_data_.insts_.insert(inst);
+}
+
+void Search::removeInst(odb::dbInst* inst)
+{
+  top_block_data_.insts_.remove(inst);
+}
+
+void Search::insertSBox(odb::dbSBox* box)
+{
+  odb::dbNet* net = box->getSWire()->getNet();
+  LayerMap<std::vector<SNetValue<odb::dbNet*>>> net_shapes;
+  LayerMap<std::vector<SNetDBoxValue<odb::dbNet*>>> via_shapes;
+  odb::Rect bounds;
+  bounds.mergeInit();
+  addSBox(box, net, net_shapes, via_shapes, bounds);
+
+  for (const auto& [layer, values] : net_shapes) {
+    LayerShapes& shapes = getOrCreateLayerShapes(top_block_data_, layer);
+    insertShapes(
+        shapes.packed, shapes.snet_shapes, shapes.pending_snet_shapes, values);
+  }
+  for (const auto& [layer, values] : via_shapes) {
+    LayerShapes& shapes = getOrCreateLayerShapes(top_block_data_, layer);
+    insertShapes(shapes.packed,
+                 shapes.snet_via_shapes,
+                 shapes.pending_snet_via_shapes,
+                 values);
+  }
+  mergeBounds(top_block_data_.snet_bounds_, net, bounds);
+}
+
+void Search::removeSBox(odb::dbSBox* box)
+{
+  // Find the layer the box was stored on the same way it was added
+  LayerMap<std::vector<SNetValue<odb::dbNet*>>> net_shapes;
+  LayerMap<std::vector<SNetDBoxValue<odb::dbNet*>>> via_shapes;
+  odb::Rect bounds;
+  bounds.mergeInit();
+  addSBox(box, nullptr, net_shapes, via_shapes, bounds);
+
+  const odb::Rect area = box->getBox();
+  auto is_box = [box](const auto& value) { return std::get<0>(value) == box; };
+  for (const auto& [layer, values] : net_shapes) {
+    LayerShapes& shapes = getOrCreateLayerShapes(top_block_data_, layer);
+    removeShapes(shapes.packed,
+                 shapes.snet_shapes,
+                 shapes.pending_snet_shapes,
+                 area,
+                 is_box);
+  }
+  for (const auto& [layer, values] : via_shapes) {
+    LayerShapes& shapes = getOrCreateLayerShapes(top_block_data_, layer);
+    removeShapes(shapes.packed,
+                 shapes.snet_via_shapes,
+                 shapes.pending_snet_via_shapes,
+                 area,
+                 is_box);
   }
-  snet_net_via_shapes.clear();
+}
 
+void Search::insertNetShapes(odb::dbNet* net, const bool with_wire)
+{
   LayerMap<std::vector<RouteBoxValue<odb::dbNet*>>> net_shapes;
-  for (odb::dbNet* net : block->getNets()) {
-    addNet(net, net_shapes);
+  odb::Rect bounds;
+  bounds.mergeInit();
+  if (with_wire) {
+    addNet(net, net_shapes, bounds);
+  }
+  for (odb::dbBTerm* term : net->getBTerms()) {
+    addBTerm(term, net_shapes, bounds);
   }
 
-  for (odb::dbBTerm* term : block->getBTerms()) {
-    for (odb::dbBPin* pin : term->getBPins()) {
-      odb::dbPlacementStatus status = pin->getPlacementStatus();
-      if (status == odb::dbPlacementStatus::NONE
-          || status == odb::dbPlacementStatus::UNPLACED) {
-        continue;
+  for (const auto& [layer, values] : net_shapes) {
+    LayerShapes& shapes = getOrCreateLayerShapes(top_block_data_, layer);
+    insertShapes(
+        shapes.packed, shapes.box_shapes, shapes.pending_box_shapes, values);
+  }
+  mergeBounds(top_block_data_.net_bounds_, net, bounds);
+}
+
+void Search::removeNetShapes(odb::dbNet* net, const bool with_special)
+{
+  BlockData& data = top_block_data_;
+  const uint id = net->getId();
+  auto take_bounds = [id](std::vector<odb::Rect>& net_bounds) {
+    odb::Rect bounds;
+    bounds.mergeInit();
+    if (id < net_bounds.size()) {
+      std::swap(bounds, net_bounds[id]);
+    }
+    return bounds;
+  };
+
+  const odb::Rect bounds = take_bounds(data.net_bounds_);
+  if (!bounds.isInverted()) {
+    for (auto& [layer, shapes] : data.layer_shapes_) {
+      removeShapes(shapes->packed,
+                   shapes->box_shapes,
+                   shapes->pending_box_shapes,
+                   bounds,
+                   [net](const RouteBoxValue<odb::dbNet*>& value) {
+                     return std::get<2>(value) == net;
+                   });
+    }
+  }
+
+  if (!with_special) {
+    return;
+  }
+  const odb::Rect special_bounds = take_bounds(data.snet_bounds_);
+  if (special_bounds.isInverted()) {
+    return;  // nothing was added for this net
+  }
+  for (auto& [layer, shapes] : data.layer_shapes_) {
+    removeShapes(shapes->packed,
+                 shapes->snet_shapes,
+                 shapes->pending_snet_shapes,
+                 special_bounds,
+                 [net](const SNetValue<odb::dbNet*>& value) {
+                   return std::get<2>(value) == net;
+                 });
+    removeShapes(shapes->packed,
+                 shapes->snet_via_shapes,
+                 shapes->pending_snet_via_shapes,
+                 special_bounds,
+                 [net](const SNetDBoxValue<odb::dbNet*>& value) {
+                   return value.second == net;
+                 });
+  }
+}
+
+void Search::insertPinBoxes(odb::dbBPin* pin)
+{
+  odb::dbNet* net = pin->getBTerm()->getNet();
+  odb::Rect bounds;
+  bounds.mergeInit();
+  for (odb::dbBox* box : pin->getBoxes()) {
+    LayerShapes& shapes
+        = getOrCreateLayerShapes(top_block_data_, box->getTechLayer());
+    insertShapes(shapes.packed,
+                 shapes.box_shapes,
+                 shapes.pending_box_shapes,
+                 {{box->getBox(), false, net}});
+    bounds.merge(box->getBox());
+  }
+  mergeBounds(top_block_data_.net_bounds_, net, bounds);
+}
+
+void Search::removePinBoxes(odb::dbBPin* pin)
+{
+  // The boxes are removed one value at a time as the net's other pins
+  // may have boxes at the same place.
+  odb::dbNet* net = pin->getBTerm()->getNet();
+  for (odb::dbBox* box : pin->getBoxes()) {
+    LayerShapes& shapes
+        = getOrCreateLayerShapes(top_block_data_, box->getTechLayer());
+    const RouteBoxValue<odb::dbNet*> value(box->getBox(), false, net);
+    if (shapes.packed) {
+      shapes.box_shapes.remove(value);
+    } else {
+      auto& pending = shapes.pending_box_shapes;
+      auto it = std::find(pending.begin(), pending.end(), value);
+      if (it != pending.end()) {
+        pending.erase(it);
       }
-      for (odb::dbBox* box : pin->getBoxes()) {
-        if (!box) {
-          continue;
+    }
+  }
+}
+
+void Search::updateShapes(odb::dbBlock* block)
+{
+  BlockData& data = getData(block);
+  std::lock_guard<std::mutex> lock(data.shapes_init_mutex_);
+  if (data.shapes_init_) {
+    return;  // already done by another thread
+  }
+
+  data.layer_shapes_.clear();
+
+  std::vector<odb::dbNet*> nets;
+  uint max_net_id = 0;
+  for (odb::dbNet* net : block->getNets()) {
+    nets.push_back(net);
+    max_net_id = std::max(max_net_id, net->getId());
+  }
+  odb::Rect empty;
+  empty.mergeInit();
+  data.net_bounds_.assign(max_net_id + 1, empty);
+  data.snet_bounds_.assign(max_net_id + 1, empty);
+
+  // Decoding the wires dominates the build so the nets are shared out
+  // between threads, each collecting its own shapes.
+  struct CollectedShapes
+  {
+    LayerMap<std::vector<RouteBoxValue<odb::dbNet*>>> box_shapes;
+    LayerMap<std::vector<SNetValue<odb::dbNet*>>> snet_shapes;
+    LayerMap<std::vector<SNetDBoxValue<odb::dbNet*>>> snet_via_shapes;
+  };
+  constexpr size_t nets_per_chunk = 256;
+  const size_t chunks = (nets.size() + nets_per_chunk - 1) / nets_per_chunk;
+  const int thread_count = std::max<int>(
+      1, std::min<size_t>(QThread::idealThreadCount(), chunks));
+  std::vector<CollectedShapes> collected(thread_count);
+  std::atomic<size_t> next_chunk{0};
+  std::exception_ptr exception;
+  std::mutex exception_mutex;
+
+  auto collect = [&](CollectedShapes& shapes) {
+    try {
+      for (size_t chunk = next_chunk++; chunk < chunks; chunk = next_chunk++) {
+        const size_t end
+            = std::min(nets.size(), (chunk + 1) * nets_per_chunk);
+        for (size_t i = chunk * nets_per_chunk; i < end; ++i) {
+          odb::dbNet* net = nets[i];
+          // Each net is only visited by one thread so its bounds can be
+          // written without locking.
+          const uint id = net->getId();
+          addSNet(net,
+                  shapes.snet_shapes,
+                  shapes.snet_via_shapes,
+                  data.snet_bounds_[id]);
+          addNet(net, shapes.box_shapes, data.net_bounds_[id]);
         }
-        odb::dbTechLayer* layer = box->getTechLayer();
-        net_shapes[layer].emplace_back(box->getBox(), false, term->getNet());
+      }
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(exception_mutex);
+      if (!exception) {
+        exception = std::current_exception();
       }
     }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(thread_count - 1);
+  for (int i = 1; i < thread_count; ++i) {
+    threads.emplace_back(collect, std::ref(collected[i]));
+  }
+  collect(collected[0]);
+  for (auto& thread : threads) {
+    thread.join();
   }
-  for (const auto& [layer, layer_shapes] : net_shapes) {
-    data.box_shapes_[layer] = RtreeRoutingShapes<odb::dbNet*>(
-        layer_shapes.begin(), layer_shapes.end());
+  if (exception) {
+    std::rethrow_exception(exception);
+  }
+
+  for (odb::dbBTerm* term : block->getBTerms()) {
+    odb::Rect bounds;
+    bounds.mergeInit();
+    addBTerm(term, collected[0].box_shapes, bounds);
+    mergeBounds(data.net_bounds_, term->getNet(), bounds);
+  }
+
+  // Move the shapes to their layers; the trees are packed when the
+  // layer is first searched.
+  auto append = [](auto& to, auto& from) {
+    if (to.empty()) {
+      to = std::move(from);
+    } else {
+      to.insert(to.end(), from.begin(), from.end());
+    }
+  };
+  for (CollectedShapes& shapes : collected) {
+    for (auto& [layer, values] : shapes.box_shapes) {
+      append(getOrCreateLayerShapes(data, layer).pending_box_shapes, values);
+    }
+    for (auto& [layer, values] : shapes.snet_shapes) {
+      append(getOrCreateLayerShapes(data, layer).pending_snet_shapes, values);
+    }
+    for (auto& [layer, values] : shapes.snet_via_shapes) {
+      append(getOrCreateLayerShapes(data, layer).pending_snet_via_shapes,
+             values);
+    }
   }
 
   data.shapes_init_ = true;
@@ -416,7 +980,8 @@ void Search::addVia(
     odb::dbShape* shape,
     int x,
     int y,
-    LayerMap<std::vector<RouteBoxValue<odb::dbNet*>>>& tree_shapes)
+    LayerMap<std::vector<RouteBoxValue<odb::dbNet*>>>& tree_shapes,
+    odb::Rect& bounds)
 {
   if (shape->getType() == odb::dbShape::TECH_VIA) {
     odb::dbTechVia* via = shape->getTechVia();
@@ -424,6 +989,7 @@ void Search::addVia(
       odb::Rect bbox = box->getBox();
       bbox.moveDelta(x, y);
       tree_shapes[box->getTechLayer()].emplace_back(bbox, true, net);
+      bounds.merge(bbox);
     }
   } else {
     odb::dbVia* via = shape->getVia();
@@ -431,40 +997,54 @@ void Search::addVia(
       odb::Rect bbox = box->getBox();
       bbox.moveDelta(x, y);
       tree_shapes[box->getTechLayer()].emplace_back(bbox, true, net);
+      bounds.merge(bbox);
+    }
+  }
+}
+
+void Search::addSBox(
+    odb::dbSBox* box,
+    odb::dbNet* net,
+    LayerMap<std::vector<SNetValue<odb::dbNet*>>>& net_shapes,
+    LayerMap<std::vector<SNetDBoxValue<odb::dbNet*>>>& via_shapes,
+    odb::Rect& bounds)
+{
+  if (box->isVia()) {
+    odb::dbTechLayer* layer;
+    if (auto via = box->getTechVia()) {
+      layer = via->getBottomLayer()->getUpperLayer();
+    } else {
+      auto block_via = box->getBlockVia();
+      layer = block_via->getBottomLayer()->getUpperLayer();
+    }
+    via_shapes[layer].emplace_back(box, net);
+  } else {
+    if (box->getDirection() == odb::dbSBox::OCTILINEAR) {
+      net_shapes[box->getTechLayer()].emplace_back(box, box->getOct(), net);
+    } else {
+      net_shapes[box->getTechLayer()].emplace_back(box, box->getBox(), net);
     }
   }
+  bounds.merge(box->getBox());
 }
 
 void Search::addSNet(
     odb::dbNet* net,
     LayerMap<std::vector<SNetValue<odb::dbNet*>>>& net_shapes,
-    LayerMap<std::vector<SNetDBoxValue<odb::dbNet*>>>& via_shapes)
+    LayerMap<std::vector<SNetDBoxValue<odb::dbNet*>>>& via_shapes,
+    odb::Rect& bounds)
 {
   for (odb::dbSWire* swire : net->getSWires()) {
     for (odb::dbSBox* box : swire->getWires()) {
-      if (box->isVia()) {
-        odb::dbTechLayer* layer;
-        if (auto via = box->getTechVia()) {
-          layer = via->getBottomLayer()->getUpperLayer();
-        } else {
-          auto block_via = box->getBlockVia();
-          layer = block_via->getBottomLayer()->getUpperLayer();
-        }
-        via_shapes[layer].emplace_back(box, net);
-      } else {
-        if (box->getDirection() == odb::dbSBox::OCTILINEAR) {
-          net_shapes[box->getTechLayer()].emplace_back(box, box->getOct(), net);
-        } else {
-          net_shapes[box->getTechLayer()].emplace_back(box, box->getBox(), net);
-        }
-      }
+      addSBox(box, net, net_shapes, via_shapes, bounds);
     }
   }
 }
 
 void Search::addNet(
     odb::dbNet* net,
-    LayerMap<std::vector<RouteBoxValue<odb::dbNet*>>>& tree_shapes)
+    LayerMap<std::vector<RouteBoxValue<odb::dbNet*>>>& tree_shapes,
+    odb::Rect& bounds)
 {
   odb::dbWire* wire = net->getWire();
 
@@ -477,9 +1057,30 @@ void Search::addNet(
 
   for (itr.begin(wire); itr.next(s);) {
     if (s.isVia()) {
-      addVia(net, &s, itr._prev_x, itr._prev_y, tree_shapes);
+      addVia(net, &s, itr._prev_x, itr._prev_y, tree_shapes, bounds);
     } else {
       tree_shapes[s.getTechLayer()].emplace_back(s.getBox(), false, net);
+      bounds.merge(s.getBox());
+    }
+  }
+}
+
+void Search::addBTerm(
+    odb::dbBTerm* term,
+    LayerMap<std::vector<RouteBoxValue<odb::dbNet*>>>& tree_shapes,
+    odb::Rect& bounds)
+{
+  for (odb::dbBPin* pin : term->getBPins()) {
+    if (!isDrawn(pin->getPlacementStatus())) {
+      continue;
+    }
+    for (odb::dbBox* box : pin->getBoxes()) {
+      if (!box) {
+        continue;
+      }
+      odb::dbTechLayer* layer = box->getTechLayer();
+      tree_shapes[layer].emplace_back(box->getBox(), false, term->getNet());
+      bounds.merge(box->getBox());
     }
   }
 }
@@ -594,28 +1195,27 @@ Search::RoutingRange Search::searchBoxShapes(odb::dbBlock* block,
                                              int y_hi,
                                              int min_size)
 {
-  BlockData& data = getData(block);
-  if (!data.shapes_init_) {
-    updateShapes(block);
-  }
-
-  auto it = data.box_shapes_.find(layer);
-  if (it == data.box_shapes_.end()) {
+  ReadLock lock(this);
+  LayerShapes* shapes = getLayerShapes(block, layer);
+  if (shapes == nullptr) {
     return RoutingRange();
   }
 
-  auto& rtree = it->second;
+  auto& rtree = shapes->box_shapes;
 
   const odb::Rect query(x_lo, y_lo, x_hi, y_hi);
   if (min_size > 0) {
     return RoutingRange(
+        std::move(lock),
         rtree.qbegin(
             bgi::intersects(query)
             && bgi::satisfies(MinSizePredicate<odb::dbNet*>(min_size))),
         rtree.qend());
   }
 
-  return RoutingRange(rtree.qbegin(bgi::intersects(query)), rtree.qend());
+  return RoutingRange(std::move(lock),
+                      rtree.qbegin(bgi::intersects(query)),
+                      rtree.qend());
 }
 
 Search::SNetSBoxRange Search::searchSNetViaShapes(odb::dbBlock* block,
@@ -626,28 +1226,27 @@ Search::SNetSBoxRange Search::searchSNetViaShapes(odb::dbBlock* block,
                                                   int y_hi,
                                                   int min_size)
 {
-  BlockData& data = getData(block);
-  if (!data.shapes_init_) {
-    updateShapes(block);
-  }
-
-  auto it = data.snet_via_shapes_.find(layer);
-  if (it == data.snet_via_shapes_.end()) {
+  ReadLock lock(this);
+  LayerShapes* shapes = getLayerShapes(block, layer);
+  if (shapes == nullptr) {
     return SNetSBoxRange();
   }
 
-  auto& rtree = it->second;
+  auto& rtree = shapes->snet_via_shapes;
 
   const odb::Rect query(x_lo, y_lo, x_hi, y_hi);
   if (min_size > 0) {
     return SNetSBoxRange(
+        std::move(lock),
         rtree.qbegin(
             bgi::intersects(query)
             && bgi::satisfies(MinSizePredicate<odb::dbNet*>(min_size))),
         rtree.qend());
   }
 
-  return SNetSBoxRange(rtree.qbegin(bgi::intersects(query)), rtree.qend());
+  return SNetSBoxRange(std::move(lock),
+                       rtree.qbegin(bgi::intersects(query)),
+                       rtree.qend());
 }
 
 Search::SNetShapeRange Search::searchSNetShapes(odb::dbBlock* block,
@@ -658,21 +1257,18 @@ Search::SNetShapeRange Search::searchSNetShapes(odb::dbBlock* block,
                                                 int y_hi,
                                                 int min_size)
 {
-  BlockData& data = getData(block);
-  if (!data.shapes_init_) {
-    updateShapes(block);
-  }
-
-  auto it = data.snet_shapes_.find(layer);
-  if (it == data.snet_shapes_.end()) {
+  ReadLock lock(this);
+  LayerShapes* shapes = getLayerShapes(block, layer);
+  if (shapes == nullptr) {
     return SNetShapeRange();
   }
 
-  auto& rtree = it->second;
+  auto& rtree = shapes->snet_shapes;
 
   const odb::Rect query(x_lo, y_lo, x_hi, y_hi);
   if (min_size > 0) {
     return SNetShapeRange(
+        std::move(lock),
         rtree.qbegin(
             bgi::intersects(query)
             && bgi::satisfies(MinSizePredicate<odb::dbNet*>(min_size))
@@ -681,6 +1277,7 @@ Search::SNetShapeRange Search::searchSNetShapes(odb::dbBlock* block,
   }
 
   return SNetShapeRange(
+      std::move(lock),
       rtree.qbegin(
           bgi::intersects(query)
           && bgi::satisfies(PolygonIntersectPredicate<odb::dbNet*>(query))),
@@ -695,6 +1292,7 @@ Search::FillRange Search::searchFills(odb::dbBlock* block,
                                       int y_hi,
                                       int min_size)
 {
+  ReadLock lock(this);
   BlockData& data = getData(block);
   if (!data.fills_init_) {
     updateFills(block);
@@ -709,13 +1307,16 @@ Search::FillRange Search::searchFills(odb::dbBlock* block,
   const odb::Rect query(x_lo, y_lo, x_hi, y_hi);
   if (min_size > 0) {
     return FillRange(
+        std::move(lock),
         rtree.qbegin(
             bgi::intersects(query)
             && bgi::satisfies(MinSizePredicate<odb::dbFill*>(min_size))),
         rtree.qend());
   }
 
-  return FillRange(rtree.qbegin(bgi::intersects(query)), rtree.qend());
+  return FillRange(std::move(lock),
+                   rtree.qbegin(bgi::intersects(query)),
+                   rtree.qend());
 }
 
 Search::InstRange Search::searchInsts(odb::dbBlock* block,
@@ -725,6 +1326,7 @@ Search::InstRange Search::searchInsts(odb::dbBlock* block,
                                       int y_hi,
                                       int min_height)
 {
+  ReadLock lock(this);
   BlockData& data = getData(block);
   if (!data.insts_init_) {
     updateInsts(block);
@@ -733,13 +1335,15 @@ Search::InstRange Search::searchInsts(odb::dbBlock* block,
   const odb::Rect query(x_lo, y_lo, x_hi, y_hi);
   if (min_height > 0) {
     return InstRange(
+        std::move(lock),
         data.insts_.qbegin(
             bgi::intersects(query)
             && bgi::satisfies(MinHeightPredicate<odb::dbInst*>(min_height))),
         data.insts_.qend());
   }
 
-  return InstRange(data.insts_.qbegin(bgi::intersects(query)),
+  return InstRange(std::move(lock),
+                   data.insts_.qbegin(bgi::intersects(query)),
                    data.insts_.qend());
 }
 
@@ -750,6 +1354,7 @@ Search::BlockageRange Search::searchBlockages(odb::dbBlock* block,
                                               int y_hi,
                                               int min_height)
 {
+  ReadLock lock(this);
   BlockData& data = getData(block);
   if (!data.blockages_init_) {
     updateBlockages(block);
@@ -758,6 +1363,7 @@ Search::BlockageRange Search::searchBlockages(odb::dbBlock* block,
   const odb::Rect query(x_lo, y_lo, x_hi, y_hi);
   if (min_height > 0) {
     return BlockageRange(
+        std::move(lock),
         data.blockages_.qbegin(
             bgi::intersects(query)
             && bgi::satisfies(
@@ -765,7 +1371,8 @@ Search::BlockageRange Search::searchBlockages(odb::dbBlock* block,
         data.blockages_.qend());
   }
 
-  return BlockageRange(data.blockages_.qbegin(bgi::intersects(query)),
+  return BlockageRange(std::move(lock),
+                       data.blockages_.qbegin(bgi::intersects(query)),
                        data.blockages_.qend());
 }
 
@@ -777,6 +1384,7 @@ Search::ObstructionRange Search::searchObstructions(odb::dbBlock* block,
                                                     int y_hi,
                                                     int min_size)
 {
+  ReadLock lock(this);
   BlockData& data = getData(block);
   if (!data.obstructions_init_) {
     updateObstructions(block);
@@ -791,13 +1399,16 @@ Search::ObstructionRange Search::searchObstructions(odb::dbBlock* block,
   const odb::Rect query(x_lo, y_lo, x_hi, y_hi);
   if (min_size > 0) {
     return ObstructionRange(
+        std::move(lock),
         rtree.qbegin(
             bgi::intersects(query)
             && bgi::satisfies(MinSizePredicate<odb::dbObstruction*>(min_size))),
         rtree.qend());
   }
 
-  return ObstructionRange(rtree.qbegin(bgi::intersects(query)), rtree.qend());
+  return ObstructionRange(std::move(lock),
+                          rtree.qbegin(bgi::intersects(query)),
+                          rtree.qend());
 }
 
 Search::RowRange Search::searchRows(odb::dbBlock* block,
@@ -807,6 +1418,7 @@ Search::RowRange Search::searchRows(odb::dbBlock* block,
                                     int y_hi,
                                     int min_height)
 {
+  ReadLock lock(this);
   BlockData& data = getData(block);
   if (!data.rows_init_) {
     updateRows(block);
@@ -815,13 +1427,16 @@ Search::RowRange Search::searchRows(odb::dbBlock* block,
   const odb::Rect query(x_lo, y_lo, x_hi, y_hi);
   if (min_height > 0) {
     return RowRange(
+        std::move(lock),
         data.rows_.qbegin(
             bgi::intersects(query)
             && bgi::satisfies(MinHeightPredicate<odb::dbRow*>(min_height))),
         data.rows_.qend());
   }
 
-  return RowRange(data.rows_.qbegin(bgi::intersects(query)), data.rows_.qend());
+  return RowRange(std::move(lock),
+                  data.rows_.qbegin(bgi::intersects(query)),
+                  data.rows_.qend());
 }
 
 }  // namespace gui
@@ -35,7 +35,10 @@
 #include <QObject>
 #include <boost/geometry.hpp>
 #include <boost/geometry/index/rtree.hpp>
+#include <memory>
 #include <mutex>
+#include <shared_mutex>
+#include <vector>
 
 #include "odb/db.h"
 #include "odb/dbBlockCallBackObj.h"
@@ -51,8 +54,15 @@ namespace bgi = boost::geometry::index;
 // rtree.  OpenDB also has some code for this purpose but I
 // find it confusing so just made a simpler solution for now.
 //
-// Currently this class is static once built and doesn't follow
-// db changes.  TODO: this should be into an observer of OpenDB.
+// The trees are built lazily on the first search and then kept up to
+// date by the OpenDB callbacks, which insert and remove the individual
+// objects that changed.  The routing shapes are collected in parallel
+// and packed into a tree per layer when that layer is first searched.
+//
+// The returned ranges iterate over the trees directly and hold them
+// shared until they are destroyed, so a callback waits only for the
+// ranges in use, not for a whole frame of the render thread.  A thread
+// must not change the database while it holds a range.
 class Search : public QObject, public odb::dbBlockCallBackObj
 {
   Q_OBJECT
@@ -121,7 +131,26 @@ class Search : public QObject, public odb::dbBlockCallBackObj
   using RtreeFill
       = bgi::rtree<odb::dbFill*, bgi::quadratic<16>, FillIndexableGetter>;
 
-  // This is an iterator range for return values
+  // Holds the trees shared.  A thread that already holds them, eg. for
+  // an outer range, does not lock again as a shared_mutex must not be
+  // locked twice by one thread.
+  class ReadLock
+  {
+   public:
+    ReadLock() = default;
+    explicit ReadLock(Search* search);
+    ReadLock(ReadLock&& other) noexcept;
+    ReadLock& operator=(ReadLock&& other) noexcept;
+    ~ReadLock();
+
+   private:
+    void release();
+
+    Search* search_ = nullptr;
+  };
+
+  // This is an iterator range for return values.  It keeps the tree from
+  // changing while it is alive.
   template <typename Tree>
   class Range
   {
@@ -129,14 +158,17 @@ class Search : public QObject, public odb::dbBlockCallBackObj
     using Iterator = typename Tree::const_query_iterator;
 
     Range() = default;
-    Range(const Iterator& begin, const Iterator& end) : begin_(begin), end_(end)
+    Range(ReadLock lock, const Iterator& begin, const Iterator& end)
+        : lock_(std::move(lock)), begin_(begin), end_(end)
     {
     }
 
-    Iterator begin() { return begin_; }
-    Iterator end() { return end_; }
+    Iterator begin() const { return begin_; }
+    Iterator end() const { return end_; }
+    bool empty() const { return begin_ == end_; }
 
    private:
+    ReadLock lock_;
     Iterator begin_;
     Iterator end_;
   };
@@ -237,13 +269,21 @@ class Search : public QObject, public odb::dbBlockCallBackObj
 
   // From dbBlockCallBackObj
   void inDbNetDestroy(odb::dbNet* net) override;
+  void inDbInstCreate(odb::dbInst* inst) override;
+  void inDbInstCreate(odb::dbInst* inst, odb::dbRegion* region) override;
   void inDbInstDestroy(odb::dbInst* inst) override;
+  void inDbInstSwapMasterBefore(odb::dbInst* inst,
+                                odb::dbMaster* master) override;
   void inDbInstSwapMasterAfter(odb::dbInst* inst) override;
   void inDbInstPlacementStatusBefore(
       odb::dbInst* inst,
       const odb::dbPlacementStatus& status) override;
+  void inDbPreMoveInst(odb::dbInst* inst) override;
   void inDbPostMoveInst(odb::dbInst* inst) override;
-  void inDbBPinCreate(odb::dbBPin* pin) override;
+  void inDbBPinAddBox(odb::dbBox* box) override;
+  void inDbBPinPlacementStatusBefore(
+      odb::dbBPin* pin,
+      const odb::dbPlacementStatus& status) override;
   void inDbBPinDestroy(odb::dbBPin* pin) override;
   void inDbFillCreate(odb::dbFill* fill) override;
   void inDbWireCreate(odb::dbWire* wire) override;
@@ -252,6 +292,7 @@ class Search : public QObject, public odb::dbBlockCallBackObj
   void inDbSWireDestroy(odb::dbSWire* wire) override;
   void inDbSWireAddSBox(odb::dbSBox* box) override;
   void inDbSWireRemoveSBox(odb::dbSBox* box) override;
+  void inDbSWirePreDestroySBoxes(odb::dbSWire* wire) override;
   void inDbBlockSetDieArea(odb::dbBlock* block) override;
   void inDbBlockageCreate(odb::dbBlockage* blockage) override;
   void inDbObstructionCreate(odb::dbObstruction* obs) override;
@@ -261,6 +302,10 @@ class Search : public QObject, public odb::dbBlockCallBackObj
   void inDbRowCreate(odb::dbRow* row) override;
   void inDbRowDestroy(odb::dbRow* row) override;
   void inDbWirePostModify(odb::dbWire* wire) override;
+  void inDbWirePostAttach(odb::dbWire* wire) override;
+  void inDbWirePreDetach(odb::dbWire* wire) override;
+  void inDbWirePostAppend(odb::dbWire* src, odb::dbWire* dst) override;
+  void inDbWirePostCopy(odb::dbWire* src, odb::dbWire* dst) override;
 
  signals:
   void modified();
@@ -268,17 +313,31 @@ class Search : public QObject, public odb::dbBlockCallBackObj
 
  private:
   struct BlockData;
+  struct LayerShapes;
 
+  // The add functions collect the shapes of an object and merge their
+  // extent into bounds.
+  void addSBox(odb::dbSBox* box,
+               odb::dbNet* net,
+               LayerMap<std::vector<SNetValue<odb::dbNet*>>>& net_shapes,
+               LayerMap<std::vector<SNetDBoxValue<odb::dbNet*>>>& via_shapes,
+               odb::Rect& bounds);
   void addSNet(odb::dbNet* net,
                LayerMap<std::vector<SNetValue<odb::dbNet*>>>& net_shapes,
-               LayerMap<std::vector<SNetDBoxValue<odb::dbNet*>>>& via_shapes);
+               LayerMap<std::vector<SNetDBoxValue<odb::dbNet*>>>& via_shapes,
+               odb::Rect& bounds);
   void addNet(odb::dbNet* net,
-              LayerMap<std::vector<RouteBoxValue<odb::dbNet*>>>& tree_shapes);
+              LayerMap<std::vector<RouteBoxValue<odb::dbNet*>>>& tree_shapes,
+              odb::Rect& bounds);
+  void addBTerm(odb::dbBTerm* term,
+                LayerMap<std::vector<RouteBoxValue<odb::dbNet*>>>& tree_shapes,
+                odb::Rect& bounds);
   void addVia(odb::dbNet* net,
               odb::dbShape* shape,
               int x,
               int y,
-              LayerMap<std::vector<RouteBoxValue<odb::dbNet*>>>& tree_shapes);
+              LayerMap<std::vector<RouteBoxValue<odb::dbNet*>>>& tree_shapes,
+              odb::Rect& bounds);
 
   void updateShapes(odb::dbBlock* block);
   void updateFills(odb::dbBlock* block);
@@ -287,6 +346,31 @@ class Search : public QObject, public odb::dbBlockCallBackObj
   void updateObstructions(odb::dbBlock* block);
   void updateRows(odb::dbBlock* block);
 
+  LayerShapes* getLayerShapes(odb::dbBlock* block, odb::dbTechLayer* layer);
+  LayerShapes& getOrCreateLayerShapes(BlockData& data,
+                                      odb::dbTechLayer* layer);
+  static void mergeBounds(std::vector<odb::Rect>& net_bounds,
+                          odb::dbNet* net,
+                          const odb::Rect& bounds);
+
+  // Runs update with tree_mutex_ held exclusively if the trees behind
+  // flag are built and announces the change.
+  template <typename Func>
+  void modifyIfBuilt(std::atomic_bool& flag, const Func& update);
+  // Replaces the shapes of the net's wire with its current ones
+  void updateNetWire(odb::dbNet* net);
+
+  // Incremental updates of the top block trees from the callbacks.
+  // These must be called with tree_mutex_ held exclusively.
+  void insertInst(odb::dbInst* inst);
+  void removeInst(odb::dbInst* inst);
+  void insertSBox(odb::dbSBox* box);
+  void removeSBox(odb::dbSBox* box);
+  void insertNetShapes(odb::dbNet* net, bool with_wire);
+  void removeNetShapes(odb::dbNet* net, bool with_special);
+  void insertPinBoxes(odb::dbBPin* pin);
+  void removePinBoxes(odb::dbBPin* pin);
+
   void clear();
 
   void announceModified(std::atomic_bool& flag);
@@ -294,15 +378,39 @@ class Search : public QObject, public odb::dbBlockCallBackObj
 
   odb::dbBlock* top_block_{nullptr};
 
-  struct BlockData
+  // Held shared by the readers and exclusively by the callbacks
+  std::shared_mutex tree_mutex_;
+
+  // The routing shapes on one layer.  The shapes are collected for all
+  // layers at once but only packed into the trees when the layer is
+  // first searched; until then they are kept in the vectors.
+  struct LayerShapes
   {
+    void pack();
+
     // The net is used for filter shapes by net type
-    LayerMap<RtreeRoutingShapes<odb::dbNet*>> box_shapes_;
+    RtreeRoutingShapes<odb::dbNet*> box_shapes;
     // Special net vias may be large multi-cut vias.  It is more efficient
     // to store the dbSBox (ie the via) than all the cuts.  This is
     // particularly true when you have parallel straps like m1 & m2 in asap7.
-    LayerMap<RtreeSNetDBoxShapes<odb::dbNet*>> snet_via_shapes_;
-    LayerMap<RtreeSNetShapes<odb::dbNet*>> snet_shapes_;
+    RtreeSNetDBoxShapes<odb::dbNet*> snet_via_shapes;
+    RtreeSNetShapes<odb::dbNet*> snet_shapes;
+
+    std::vector<RouteBoxValue<odb::dbNet*>> pending_box_shapes;
+    std::vector<SNetDBoxValue<odb::dbNet*>> pending_snet_via_shapes;
+    std::vector<SNetValue<odb::dbNet*>> pending_snet_shapes;
+    std::atomic_bool packed{false};
+    std::mutex pack_mutex;
+  };
+
+  struct BlockData
+  {
+    LayerMap<std::unique_ptr<LayerShapes>> layer_shapes_;
+    // Bounds of the wire and pin shapes and of the special shapes of
+    // each net, indexed by net id, used to find them again when the net
+    // changes.
+    std::vector<odb::Rect> net_bounds_;
+    std::vector<odb::Rect> snet_bounds_;
     std::atomic_bool shapes_init_{false};
     std::mutex shapes_init_mutex_;
     LayerMap<RtreeFill> fills_;
@@ -0,0 +1,556 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2023, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "tileCache.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <tuple>
+
+namespace gui {
+
+bool TileCache::View::operator==(const View& other) const
+{
+  return pixels_per_dbu == other.pixels_per_dbu
+         && centering_shift == other.centering_shift
+         && band_layers == other.band_layers;
+}
+
+bool TileCache::View::operator<(const View& other) const
+{
+  return std::make_tuple(pixels_per_dbu,
+                         centering_shift.x(),
+                         centering_shift.y(),
+                         std::cref(band_layers))
+         < std::make_tuple(other.pixels_per_dbu,
+                           other.centering_shift.x(),
+                           other.centering_shift.y(),
+                           std::cref(other.band_layers));
+}
+
+TileCache::TileCache() = default;
+
+TileCache::~TileCache()
+{
+  if (block_ != nullptr) {
+    removeOwner();  // unregister as a callback object
+  }
+}
+
+void TileCache::setBlock(odb::dbBlock* block)
+{
+  if (block_ != block) {
+    if (block_ != nullptr) {
+      removeOwner();
+    }
+    if (block != nullptr) {
+      addOwner(block);  // register as a callback object
+    }
+    block_ = block;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(wire_mutex_);
+    wire_bboxes_.clear();
+    wire_bboxes_built_ = false;
+  }
+  clear();
+}
+
+TileCache::Tile TileCache::find(const View& view, const QPoint& index)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto view_itr = views_.find(view);
+  if (view_itr == views_.end()) {
+    misses_++;
+    return Tile();
+  }
+
+  ViewTiles& view_tiles = view_itr->second;
+  view_tiles.last_used = ++use_count_;
+
+  auto tile_itr = view_tiles.tiles.find({index.x(), index.y()});
+  if (tile_itr == view_tiles.tiles.end()) {
+    misses_++;
+    return Tile();
+  }
+
+  hits_++;
+  return tile_itr->second;
+}
+
+void TileCache::insert(const View& view,
+                       const QPoint& index,
+                       const Tile& tile,
+                       uint64_t generation)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (generation != generation_) {
+    return;
+  }
+
+  ViewTiles& view_tiles = views_[view];
+  view_tiles.last_used = ++use_count_;
+  if (view_tiles.tiles.size() >= max_tiles_per_view_) {
+    // Larger than a few screens worth so start over for this view
+    view_tiles.tiles.clear();
+  }
+  view_tiles.tiles[{index.x(), index.y()}] = tile;
+
+  evictViews();
+}
+
+void TileCache::evictViews()
+{
+  while (views_.size() > max_views_) {
+    auto oldest = std::min_element(
+        views_.begin(), views_.end(), [](const auto& lhs, const auto& rhs) {
+          return lhs.second.last_used < rhs.second.last_used;
+        });
+    views_.erase(oldest);
+  }
+}
+
+void TileCache::clear()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    views_.clear();
+    generation_++;
+  }
+
+  std::lock_guard<std::mutex> lock(density_mutex_);
+  instance_density_ = nullptr;
+}
+
+void TileCache::invalidate(const odb::Rect& area)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  generation_++;
+
+  for (auto& [view, view_tiles] : views_) {
+    auto& tiles = view_tiles.tiles;
+    if (tiles.empty()) {
+      continue;
+    }
+
+    const qreal scale = view.pixels_per_dbu;
+    const QPoint& shift = view.centering_shift;
+    const qreal x_lo
+        = area.xMin() * scale + shift.x() - invalidation_margin_;
+    const qreal x_hi
+        = area.xMax() * scale + shift.x() + invalidation_margin_;
+    const qreal y_lo
+        = -area.yMax() * scale + shift.y() - invalidation_margin_;
+    const qreal y_hi
+        = -area.yMin() * scale + shift.y() + invalidation_margin_;
+
+    // Only visit the affected columns that have tiles as this is called
+    // for every change to the database
+    const int first_x = std::max(static_cast<int>(std::floor(x_lo / tile_size)),
+                                 tiles.begin()->first.first);
+    const int last_x = std::min(static_cast<int>(std::floor(x_hi / tile_size)),
+                                tiles.rbegin()->first.first);
+    const int first_y = std::floor(y_lo / tile_size);
+    const int last_y = std::floor(y_hi / tile_size);
+
+    for (int x = first_x; x <= last_x; x++) {
+      tiles.erase(tiles.lower_bound({x, first_y}),
+                  tiles.upper_bound({x, last_y}));
+    }
+  }
+}
+
+uint64_t TileCache::startDrawing()
+{
+  buildWireBBoxes();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  announced_ = false;
+  return generation_;
+}
+
+void TileCache::announceInvalidated()
+{
+  // One announcement is enough until the next draw picks up the change
+  if (!announced_.exchange(true)) {
+    emit invalidated();
+  }
+}
+
+void TileCache::invalidateAll()
+{
+  clear();
+  announceInvalidated();
+}
+
+void TileCache::buildWireBBoxes()
+{
+  std::lock_guard<std::mutex> lock(wire_mutex_);
+  if (wire_bboxes_built_ || block_ == nullptr) {
+    return;
+  }
+  for (odb::dbNet* net : block_->getNets()) {
+    odb::dbWire* wire = net->getWire();
+    if (wire == nullptr) {
+      continue;
+    }
+    if (auto bbox = wire->getBBox()) {
+      wire_bboxes_[wire] = *bbox;
+    }
+  }
+  wire_bboxes_built_ = true;
+}
+
+void TileCache::invalidateWire(odb::dbWire* wire)
+{
+  {
+    std::lock_guard<std::mutex> lock(wire_mutex_);
+    if (!wire_bboxes_built_) {
+      return;  // nothing drawn yet
+    }
+    // Both where the wire was and where it is now
+    auto itr = wire_bboxes_.find(wire);
+    if (itr != wire_bboxes_.end()) {
+      invalidate(itr->second);
+      wire_bboxes_.erase(itr);
+    }
+    if (auto bbox = wire->getBBox()) {
+      invalidate(*bbox);
+      wire_bboxes_[wire] = *bbox;
+    }
+  }
+  announceInvalidated();
+}
+
+void TileCache::invalidateInst(odb::dbInst* inst)
+{
+  if (!inst->isPlaced()) {
+    return;
+  }
+
+  invalidate(inst->getBBox()->getBox());
+  {
+    std::lock_guard<std::mutex> lock(density_mutex_);
+    instance_density_ = nullptr;
+  }
+  announceInvalidated();
+}
+
+void TileCache::resetStatistics()
+{
+  hits_ = 0;
+  misses_ = 0;
+}
+
+std::shared_ptr<const TileCache::DensityGrid> TileCache::instanceDensity()
+{
+  std::lock_guard<std::mutex> lock(density_mutex_);
+  if (instance_density_ == nullptr && block_ != nullptr) {
+    instance_density_ = buildInstanceDensity();
+  }
+  return instance_density_;
+}
+
+std::unique_ptr<TileCache::DensityGrid> TileCache::buildInstanceDensity() const
+{
+  auto grid = std::make_unique<DensityGrid>();
+
+  grid->area = block_->getDieArea();
+  if (grid->area.area() == 0) {
+    grid->area = block_->getBBox()->getBox();
+  }
+  if (grid->area.area() == 0) {
+    return grid;
+  }
+
+  grid->bin_size = std::max(
+      1, static_cast<int>(
+          std::ceil(grid->area.maxDXDY() / (double) density_bins_)));
+  grid->bins_x = std::ceil(grid->area.dx() / (double) grid->bin_size);
+  grid->bins_y = std::ceil(grid->area.dy() / (double) grid->bin_size);
+  grid->density.resize(grid->bins_x * grid->bins_y, 0.0);
+
+  const double bin_area = static_cast<double>(grid->bin_size) * grid->bin_size;
+  for (odb::dbInst* inst : block_->getInsts()) {
+    if (!inst->isPlaced()) {
+      continue;
+    }
+    odb::dbMaster* master = inst->getMaster();
+    if (!master->isCore()) {
+      continue;
+    }
+    grid->max_cell_height = std::max(grid->max_cell_height,
+                                     static_cast<int>(master->getHeight()));
+
+    odb::Rect bbox = inst->getBBox()->getBox();
+    if (!grid->area.intersects(bbox)) {
+      continue;
+    }
+    bbox = bbox.intersect(grid->area);
+
+    const int x_lo = (bbox.xMin() - grid->area.xMin()) / grid->bin_size;
+    const int y_lo = (bbox.yMin() - grid->area.yMin()) / grid->bin_size;
+    const int x_hi = std::min(
+        grid->bins_x - 1, (bbox.xMax() - grid->area.xMin()) / grid->bin_size);
+    const int y_hi = std::min(
+        grid->bins_y - 1, (bbox.yMax() - grid->area.yMin()) / grid->bin_size);
+    for (int y = y_lo; y <= y_hi; y++) {
+      for (int x = x_lo; x <= x_hi; x++) {
+        const int bin_x = grid->area.xMin() + x * grid->bin_size;
+        const int bin_y = grid->area.yMin() + y * grid->bin_size;
+        const odb::Rect bin(
+            bin_x, bin_y, bin_x + grid->bin_size, bin_y + grid->bin_size);
+        const double overlap = bin.intersect(bbox).area();
+        grid->density[y * grid->bins_x + x] += overlap / bin_area;
+      }
+    }
+  }
+
+  for (float& density : grid->density) {
+    density = std::min(density, 1.0f);
+  }
+
+  return grid;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TileCache::inDbInstCreate(odb::dbInst* inst)
+{
+  invalidateInst(inst);
+}
+
+void TileCache::inDbInstCreate(odb::dbInst* inst, odb::dbRegion* region)
+{
+  invalidateInst(inst);
+}
+
+void TileCache::inDbInstDestroy(odb::dbInst* inst)
+{
+  invalidateInst(inst);
+}
+
+void TileCache::inDbInstSwapMasterBefore(odb::dbInst* inst,
+                                         odb::dbMaster* master)
+{
+  invalidateInst(inst);
+}
+
+void TileCache::inDbInstSwapMasterAfter(odb::dbInst* inst)
+{
+  invalidateInst(inst);
+}
+
+void TileCache::inDbInstPlacementStatusBefore(
+    odb::dbInst* inst,
+    const odb::dbPlacementStatus& status)
+{
+  if (inst->isPlaced() != status.isPlaced()) {
+    invalidate(inst->getBBox()->getBox());
+    {
+      std::lock_guard<std::mutex> lock(density_mutex_);
+      instance_density_ = nullptr;
+    }
+    announceInvalidated();
+  }
+}
+
+void TileCache::inDbPreMoveInst(odb::dbInst* inst)
+{
+  invalidateInst(inst);
+}
+
+void TileCache::inDbPostMoveInst(odb::dbInst* inst)
+{
+  invalidateInst(inst);
+}
+
+void TileCache::inDbNetDestroy(odb::dbNet* net)
+{
+  // The wires, special wires and pins of the net are destroyed before
+  // and have invalidated their own tiles.
+  announceInvalidated();
+}
+
+void TileCache::inDbBPinCreate(odb::dbBPin* pin)
+{
+  // Pin markers are drawn over the tiles and the pin has no shapes yet
+  announceInvalidated();
+}
+
+void TileCache::inDbBPinAddBox(odb::dbBox* box)
+{
+  invalidate(box->getBox());
+  announceInvalidated();
+}
+
+void TileCache::inDbBPinPlacementStatusBefore(
+    odb::dbBPin* pin,
+    const odb::dbPlacementStatus& status)
+{
+  invalidate(pin->getBBox());
+  announceInvalidated();
+}
+
+void TileCache::inDbBPinDestroy(odb::dbBPin* pin)
+{
+  invalidate(pin->getBBox());
+  announceInvalidated();
+}
+
+void TileCache::inDbFillCreate(odb::dbFill* fill)
+{
+  odb::Rect rect;
+  fill->getRect(rect);
+  invalidate(rect);
+  announceInvalidated();
+}
+
+void TileCache::inDbWireCreate(odb::dbWire* wire)
+{
+  // A new wire has no shapes until it is modified
+}
+
+void TileCache::inDbWireDestroy(odb::dbWire* wire)
+{
+  if (auto bbox = wire->getBBox()) {
+    invalidate(*bbox);
+  }
+  {
+    std::lock_guard<std::mutex> lock(wire_mutex_);
+    wire_bboxes_.erase(wire);
+  }
+  announceInvalidated();
+}
+
+void TileCache::inDbWirePostModify(odb::dbWire* wire)
+{
+  invalidateWire(wire);
+}
+
+void TileCache::inDbWirePostAttach(odb::dbWire* wire)
+{
+  invalidateWire(wire);
+}
+
+void TileCache::inDbWirePreDetach(odb::dbWire* wire)
+{
+  invalidateWire(wire);
+}
+
+void TileCache::inDbWirePostAppend(odb::dbWire* src, odb::dbWire* dst)
+{
+  invalidateWire(dst);
+}
+
+void TileCache::inDbWirePostCopy(odb::dbWire* src, odb::dbWire* dst)
+{
+  invalidateWire(dst);
+}
+
+void TileCache::inDbSWireCreate(odb::dbSWire* wire)
+{
+  // Shapes are reported individually through inDbSWireAddSBox
+}
+
+void TileCache::inDbSWireDestroy(odb::dbSWire* wire)
+{
+  for (odb::dbSBox* box : wire->getWires()) {
+    invalidate(box->getBox());
+  }
+  announceInvalidated();
+}
+
+void TileCache::inDbSWireAddSBox(odb::dbSBox* box)
+{
+  invalidate(box->getBox());
+  announceInvalidated();
+}
+
+void TileCache::inDbSWireRemoveSBox(odb::dbSBox* box)
+{
+  invalidate(box->getBox());
+  announceInvalidated();
+}
+
+void TileCache::inDbBlockSetDieArea(odb::dbBlock* block)
+{
+  invalidateAll();
+}
+
+void TileCache::inDbBlockageCreate(odb::dbBlockage* blockage)
+{
+  invalidate(blockage->getBBox()->getBox());
+  announceInvalidated();
+}
+
+void TileCache::inDbObstructionCreate(odb::dbObstruction* obs)
+{
+  invalidate(obs->getBBox()->getBox());
+  announceInvalidated();
+}
+
+void TileCache::inDbObstructionDestroy(odb::dbObstruction* obs)
+{
+  invalidate(obs->getBBox()->getBox());
+  announceInvalidated();
+}
+
+void TileCache::inDbRegionAddBox(odb::dbRegion* region, odb::dbBox* box)
+{
+  invalidate(box->getBox());
+  announceInvalidated();
+}
+
+void TileCache::inDbRegionDestroy(odb::dbRegion* region)
+{
+  for (odb::dbBox* box : region->getBoundaries()) {
+    invalidate(box->getBox());
+  }
+  announceInvalidated();
+}
+
+void TileCache::inDbRowCreate(odb::dbRow* row)
+{
+  invalidate(row->getBBox());
+  announceInvalidated();
+}
+
+void TileCache::inDbRowDestroy(odb::dbRow* row)
+{
+  invalidate(row->getBBox());
+  announceInvalidated();
+}
+
+}  // namespace gui
@@ -0,0 +1,222 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2023, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <QImage>
+#include <QObject>
+#include <QPoint>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "odb/db.h"
+#include "odb/dbBlockCallBackObj.h"
+
+namespace gui {
+
+// Caches the rendered layout as fixed size image tiles so that panning
+// and redrawing after a small database change only renders the tiles
+// that are not already available.
+//
+// Tiles are keyed by the view (the zoom level, the centering of the
+// layout in the widget and the band layers) and by their index in widget
+// pixel coordinates. They only hold the database content; anything that
+// depends on the whole view (selection, highlights, rulers, IO pin
+// markers and renderer output) is drawn over the composed tiles.
+//
+// IO pin markers and the per layer renderer output belong between the
+// layers, so each tile is a stack of bands. A band holds the layers up to
+// and including one of the band layers and the overlays of that layer go
+// between it and the next band.
+//
+// Tiles are invalidated by region from the odb callbacks and entirely by
+// clear() when the display options change.  The bounding box of every
+// wire is kept so that a modified wire only drops the tiles its old and
+// new shapes overlap.
+class TileCache : public QObject, public odb::dbBlockCallBackObj
+{
+  Q_OBJECT
+
+ public:
+  static constexpr int tile_size = 256;  // pixels
+
+  struct View
+  {
+    qreal pixels_per_dbu;
+    QPoint centering_shift;
+    // Layers with overlays, in draw order
+    std::vector<odb::dbTechLayer*> band_layers;
+
+    bool operator==(const View& other) const;
+    bool operator<(const View& other) const;
+  };
+
+  // Coarse summary of the standard cell area, used in place of the
+  // cells themselves when they are too small to be drawn.
+  struct DensityGrid
+  {
+    odb::Rect area;
+    int bin_size = 0;
+    int bins_x = 0;
+    int bins_y = 0;
+    // Tallest core master that contributed to the grid
+    int max_cell_height = 0;
+    // Fraction of each bin covered by core instances, row major
+    std::vector<float> density;
+  };
+
+  // One image per band, bottom band first
+  using Tile = std::vector<QImage>;
+
+  TileCache();
+  ~TileCache();
+
+  void setBlock(odb::dbBlock* block);
+
+  // Called at the start of drawing a view; returns the current
+  // generation to pass to insert().
+  uint64_t startDrawing();
+  // Returns the tile or an empty one if it is not cached.
+  Tile find(const View& view, const QPoint& index);
+  // Stores a tile rendered when startDrawing() returned the given value.
+  // The tile is dropped if anything was invalidated since then, as it
+  // may have been drawn from stale data.
+  void insert(const View& view,
+              const QPoint& index,
+              const Tile& tile,
+              uint64_t generation);
+
+  // Drop all tiles, eg. when the display options change.
+  void clear();
+  // Drop the tiles that overlap the given dbu area in any view.
+  void invalidate(const odb::Rect& area);
+
+  std::shared_ptr<const DensityGrid> instanceDensity();
+
+  int hits() const { return hits_; }
+  int misses() const { return misses_; }
+  void resetStatistics();
+
+  // From dbBlockCallBackObj
+  void inDbInstCreate(odb::dbInst* inst) override;
+  void inDbInstCreate(odb::dbInst* inst, odb::dbRegion* region) override;
+  void inDbInstDestroy(odb::dbInst* inst) override;
+  void inDbInstSwapMasterBefore(odb::dbInst* inst,
+                                odb::dbMaster* master) override;
+  void inDbInstSwapMasterAfter(odb::dbInst* inst) override;
+  void inDbInstPlacementStatusBefore(
+      odb::dbInst* inst,
+      const odb::dbPlacementStatus& status) override;
+  void inDbPreMoveInst(odb::dbInst* inst) override;
+  void inDbPostMoveInst(odb::dbInst* inst) override;
+  void inDbNetDestroy(odb::dbNet* net) override;
+  void inDbBPinCreate(odb::dbBPin* pin) override;
+  void inDbBPinAddBox(odb::dbBox* box) override;
+  void inDbBPinPlacementStatusBefore(
+      odb::dbBPin* pin,
+      const odb::dbPlacementStatus& status) override;
+  void inDbBPinDestroy(odb::dbBPin* pin) override;
+  void inDbFillCreate(odb::dbFill* fill) override;
+  void inDbWireCreate(odb::dbWire* wire) override;
+  void inDbWireDestroy(odb::dbWire* wire) override;
+  void inDbWirePostModify(odb::dbWire* wire) override;
+  void inDbWirePostAttach(odb::dbWire* wire) override;
+  void inDbWirePreDetach(odb::dbWire* wire) override;
+  void inDbWirePostAppend(odb::dbWire* src, odb::dbWire* dst) override;
+  void inDbWirePostCopy(odb::dbWire* src, odb::dbWire* dst) override;
+  void inDbSWireCreate(odb::dbSWire* wire) override;
+  void inDbSWireDestroy(odb::dbSWire* wire) override;
+  void inDbSWireAddSBox(odb::dbSBox* box) override;
+  void inDbSWireRemoveSBox(odb::dbSBox* box) override;
+  void inDbBlockSetDieArea(odb::dbBlock* block) override;
+  void inDbBlockageCreate(odb::dbBlockage* blockage) override;
+  void inDbObstructionCreate(odb::dbObstruction* obs) override;
+  void inDbObstructionDestroy(odb::dbObstruction* obs) override;
+  void inDbRegionAddBox(odb::dbRegion* region, odb::dbBox* box) override;
+  void inDbRegionDestroy(odb::dbRegion* region) override;
+  void inDbRowCreate(odb::dbRow* row) override;
+  void inDbRowDestroy(odb::dbRow* row) override;
+
+ signals:
+  void invalidated();
+
+ private:
+  using TileIndex = std::pair<int, int>;
+
+  struct ViewTiles
+  {
+    std::map<TileIndex, Tile> tiles;
+    uint64_t last_used = 0;
+  };
+
+  void invalidateInst(odb::dbInst* inst);
+  void invalidateWire(odb::dbWire* wire);
+  void buildWireBBoxes();
+  void announceInvalidated();
+  void invalidateAll();
+  void evictViews();
+  std::unique_ptr<DensityGrid> buildInstanceDensity() const;
+
+  // Number of zoom levels kept and number of tiles kept per zoom level
+  static constexpr int max_views_ = 4;
+  static constexpr int max_tiles_per_view_ = 512;
+  // Tiles are invalidated this many pixels beyond the changed area to
+  // cover antialiasing and cosmetic pens at the edges of shapes.
+  static constexpr int invalidation_margin_ = 2;
+  static constexpr int density_bins_ = 256;
+
+  odb::dbBlock* block_ = nullptr;
+
+  std::mutex mutex_;
+  std::map<View, ViewTiles> views_;
+  uint64_t generation_ = 0;
+  std::atomic_bool announced_{false};
+  uint64_t use_count_ = 0;
+  std::atomic<int> hits_{0};
+  std::atomic<int> misses_{0};
+
+  // Last known bounding box of each wire with shapes, built at the first
+  // draw as nothing is cached before it
+  std::mutex wire_mutex_;
+  bool wire_bboxes_built_ = false;
+  std::map<odb::dbWire*, odb::Rect> wire_bboxes_;
+
+  std::mutex density_mutex_;
+  std::shared_ptr<const DensityGrid> instance_density_;
+};
+
+}  // namespace gui
@@ -0,0 +1,226 @@
+#include <atomic>
+#include <chrono>
+#include <iterator>
+#include <set>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "odb/db.h"
+#include "odb/dbWireCodec.h"
+#include "search.h"
+#include "utl/Logger.h"
+
+namespace gui {
+
+class SearchTest : public ::testing::Test
+{
+ protected:
+  void SetUp() override
+  {
+    db_ = odb::dbDatabase::create();
+    db_->setLogger(&logger_);
+
+    odb::dbTech* tech = odb::dbTech::create(db_, "tech");
+    odb::dbTechLayer::create(tech, "L1", odb::dbTechLayerType::MASTERSLICE);
+    metal_ = odb::dbTechLayer::create(
+        tech, "M1", odb::dbTechLayerType::ROUTING);
+    metal_->setWidth(100);
+    odb::dbLib* lib = odb::dbLib::create(db_, "lib", tech, ',');
+
+    master_ = odb::dbMaster::create(lib, "cell");
+    master_->setWidth(1000);
+    master_->setHeight(1000);
+    master_->setType(odb::dbMasterType::CORE);
+    master_->setFrozen();
+
+    odb::dbChip* chip = odb::dbChip::create(db_);
+    block_ = odb::dbBlock::create(chip, "top");
+    block_->setDieArea(odb::Rect(0, 0, 100000, 100000));
+  }
+
+  void TearDown() override
+  {
+    search_.setTopBlock(nullptr);
+    odb::dbDatabase::destroy(db_);
+  }
+
+  odb::dbInst* place(const char* name, int x, int y)
+  {
+    odb::dbInst* inst = odb::dbInst::create(block_, master_, name);
+    inst->setLocation(x, y);
+    inst->setPlacementStatus(odb::dbPlacementStatus::PLACED);
+    return inst;
+  }
+
+  std::set<odb::dbInst*> search(const odb::Rect& rect)
+  {
+    std::set<odb::dbInst*> found;
+    for (odb::dbInst* inst : search_.searchInsts(
+             block_, rect.xMin(), rect.yMin(), rect.xMax(), rect.yMax())) {
+      found.insert(inst);
+    }
+    return found;
+  }
+
+  // The nets of the routing shapes on metal_ over rect
+  std::multiset<odb::dbNet*> searchNets(const odb::Rect& rect)
+  {
+    std::multiset<odb::dbNet*> nets;
+    for (const auto& shape : search_.searchBoxShapes(block_,
+                                                     metal_,
+                                                     rect.xMin(),
+                                                     rect.yMin(),
+                                                     rect.xMax(),
+                                                     rect.yMax())) {
+      nets.insert(std::get<2>(shape));
+    }
+    return nets;
+  }
+
+  // What a search over rect should find, straight from the database
+  std::set<odb::dbInst*> expected(const odb::Rect& rect)
+  {
+    std::set<odb::dbInst*> insts;
+    for (odb::dbInst* inst : block_->getInsts()) {
+      if (inst->isPlaced() && inst->getBBox()->getBox().intersects(rect)) {
+        insts.insert(inst);
+      }
+    }
+    return insts;
+  }
+
+  utl::Logger logger_;
+  odb::dbDatabase* db_ = nullptr;
+  odb::dbMaster* master_ = nullptr;
+  odb::dbTechLayer* metal_ = nullptr;
+  odb::dbBlock* block_ = nullptr;
+  Search search_;
+};
+
+TEST_F(SearchTest, FollowsInstanceEdits)
+{
+  place("a", 1000, 1000);
+  odb::dbInst* b = place("b", 20000, 20000);
+  odb::dbInst* c = place("c", 40000, 40000);
+  search_.setTopBlock(block_);
+
+  const odb::Rect die = block_->getDieArea();
+  const odb::Rect left(0, 0, 30000, 30000);
+  EXPECT_EQ(search(die).size(), 3);
+  EXPECT_EQ(search(left), expected(left));
+
+  // The trees are built now so these go through the callbacks
+  odb::dbInst* d = place("d", 5000, 5000);
+  EXPECT_EQ(search(left), expected(left));
+  EXPECT_EQ(search(left).count(d), 1);
+
+  c->setLocation(10000, 10000);
+  EXPECT_EQ(search(left), expected(left));
+  EXPECT_EQ(search(left).count(c), 1);
+
+  b->setLocation(80000, 80000);
+  EXPECT_EQ(search(left), expected(left));
+  EXPECT_EQ(search(left).count(b), 0);
+
+  d->setPlacementStatus(odb::dbPlacementStatus::NONE);
+  EXPECT_EQ(search(left).count(d), 0);
+
+  odb::dbInst::destroy(c);
+  EXPECT_EQ(search(left), expected(left));
+  EXPECT_EQ(search(die), expected(die));
+  EXPECT_EQ(search(die).size(), 2);
+}
+
+TEST_F(SearchTest, RangesHoldOffEdits)
+{
+  odb::dbInst* a = place("a", 1000, 1000);
+  place("b", 2000, 2000);
+  search_.setTopBlock(block_);
+
+  const odb::Rect die = block_->getDieArea();
+  std::atomic_bool moved = false;
+  std::thread editor;
+  {
+    const Search::InstRange range = search_.searchInsts(
+        block_, die.xMin(), die.yMin(), die.xMax(), die.yMax());
+    editor = std::thread([a, &moved] {
+      a->setLocation(50000, 50000);
+      moved = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_FALSE(moved);
+
+    // The thread searches again while the editor waits for the trees
+    EXPECT_EQ(search(die).size(), 2);
+    EXPECT_EQ(std::distance(range.begin(), range.end()), 2);
+    EXPECT_FALSE(moved);
+  }
+  editor.join();
+  EXPECT_TRUE(moved);
+  EXPECT_EQ(search(odb::Rect(0, 0, 10000, 10000)).count(a), 0);
+  EXPECT_EQ(search(die), expected(die));
+}
+
+TEST_F(SearchTest, FollowsPinEdits)
+{
+  odb::dbNet* net = odb::dbNet::create(block_, "n");
+  odb::dbBTerm* term = odb::dbBTerm::create(net, "p");
+  odb::dbBPin* pin = odb::dbBPin::create(term);
+  pin->setPlacementStatus(odb::dbPlacementStatus::PLACED);
+  odb::dbBox::create(pin, metal_, 0, 0, 100, 100);
+  search_.setTopBlock(block_);
+
+  const odb::Rect die = block_->getDieArea();
+  EXPECT_EQ(searchNets(die).count(net), 1);
+
+  // The trees are built now so these go through the callbacks
+  odb::dbBox::create(pin, metal_, 0, 500, 100, 600);
+  EXPECT_EQ(searchNets(die).count(net), 2);
+
+  odb::dbBPin* other = odb::dbBPin::create(term);
+  odb::dbBox::create(other, metal_, 0, 0, 100, 100);
+  EXPECT_EQ(searchNets(die).count(net), 2);  // not placed
+  other->setPlacementStatus(odb::dbPlacementStatus::FIRM);
+  EXPECT_EQ(searchNets(die).count(net), 3);
+
+  pin->setPlacementStatus(odb::dbPlacementStatus::UNPLACED);
+  EXPECT_EQ(searchNets(die).count(net), 1);
+  pin->setPlacementStatus(odb::dbPlacementStatus::PLACED);
+  EXPECT_EQ(searchNets(die).count(net), 3);
+
+  // Only one of the two boxes at the same place goes
+  odb::dbBPin::destroy(other);
+  EXPECT_EQ(searchNets(die).count(net), 2);
+  EXPECT_EQ(searchNets(odb::Rect(0, 0, 100, 100)).count(net), 1);
+}
+
+TEST_F(SearchTest, FollowsWireAttach)
+{
+  odb::dbNet* a = odb::dbNet::create(block_, "a");
+  odb::dbNet* b = odb::dbNet::create(block_, "b");
+  odb::dbWire* wire = odb::dbWire::create(block_);
+  odb::dbWireEncoder encoder;
+  encoder.begin(wire);
+  encoder.newPath(metal_, odb::dbWireType::ROUTED);
+  encoder.addPoint(1000, 1000);
+  encoder.addPoint(5000, 1000);
+  encoder.end();
+  search_.setTopBlock(block_);
+
+  const odb::Rect die = block_->getDieArea();
+  EXPECT_TRUE(searchNets(die).empty());
+
+  wire->attach(a);
+  EXPECT_EQ(searchNets(die), std::multiset<odb::dbNet*>{a});
+
+  // Moves the wire from a to b
+  wire->attach(b);
+  EXPECT_EQ(searchNets(die), std::multiset<odb::dbNet*>{b});
+
+  wire->detach();
+  EXPECT_TRUE(searchNets(die).empty());
+}
+
+}  // namespace gui
@@ -33,8 +33,10 @@
 
 #include "SimulatedAnnealingCore.h"
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
+#include <numeric>
 
 #include "Mpl2Observer.h"
 #include "object.h"
@@ -122,6 +124,7 @@ template <class T>
 void SimulatedAnnealingCore<T>::setNets(const std::vector<BundledNet>& nets)
 {
   nets_ = nets;
+  macro_nets_.clear();  // rebuilt by the next calWirelength()
 }
 
 template <class T>
@@ -257,30 +260,50 @@ void SimulatedAnnealingCore<T>::calWirelength()
 {
   // Initialization
   wirelength_ = 0.0;
+  pin_location_undo_.clear();
+  net_length_undo_.clear();
   if (wirelength_weight_ <= 0.0) {
     return;
   }
 
-  // calculate the total net weight
-  float tot_net_weight = 0.0;
-  for (const auto& net : nets_) {
-    tot_net_weight += net.weight;
+  if (macro_nets_.size() != macros_.size()) {
+    initWirelength();
+  } else {
+    // Find the nets of the macros whose pin moved
+    ++evaluation_;
+    std::vector<int> changed_nets;
+    for (int id = 0; id < macros_.size(); id++) {
+      const std::pair<float, float> pin(macros_[id].getPinX(),
+                                        macros_[id].getPinY());
+      if (pin == pin_locations_[id]) {
+        continue;
+      }
+      pin_location_undo_.emplace_back(id, pin_locations_[id]);
+      pin_locations_[id] = pin;
+      for (const int net_id : macro_nets_[id]) {
+        if (net_evaluation_[net_id] != evaluation_) {
+          net_evaluation_[net_id] = evaluation_;
+          changed_nets.push_back(net_id);
+        }
+      }
+    }
+
+    for (const int net_id : changed_nets) {
+      net_length_undo_.emplace_back(net_id, net_lengths_[net_id]);
+      net_lengths_[net_id] = calNetLength(nets_[net_id]);
+    }
   }
 
-  if (tot_net_weight <= 0.0) {
+  if (total_net_weight_ <= 0.0) {
     return;
   }
 
-  for (const auto& net : nets_) {
-    const float x1 = macros_[net.terminals.first].getPinX();
-    const float y1 = macros_[net.terminals.first].getPinY();
-    const float x2 = macros_[net.terminals.second].getPinX();
-    const float y2 = macros_[net.terminals.second].getPinY();
-    wirelength_ += net.weight * (std::abs(x2 - x1) + std::abs(y2 - y1));
+  for (const float length : net_lengths_) {
+    wirelength_ += length;
   }
 
   // normalization
-  wirelength_ = wirelength_ / tot_net_weight
+  wirelength_ = wirelength_ / total_net_weight_
                 / (outline_.getHeight() + outline_.getWidth());
 
   if (graphics_) {
@@ -288,6 +311,56 @@ void SimulatedAnnealingCore<T>::calWirelength()
   }
 }
 
+template <class T>
+void SimulatedAnnealingCore<T>::restoreWirelength()
+{
+  for (const auto& [id, pin] : pin_location_undo_) {
+    pin_locations_[id] = pin;
+  }
+  for (const auto& [net_id, length] : net_length_undo_) {
+    net_lengths_[net_id] = length;
+  }
+
+  pin_location_undo_.clear();
+  net_length_undo_.clear();
+}
+
+// Measure all the nets from scratch and record the pin locations
+// they were measured from.
+template <class T>
+void SimulatedAnnealingCore<T>::initWirelength()
+{
+  macro_nets_.assign(macros_.size(), {});
+  pin_locations_.resize(macros_.size());
+  net_lengths_.resize(nets_.size());
+  net_evaluation_.assign(nets_.size(), evaluation_);
+  total_net_weight_ = 0.0;
+
+  for (int id = 0; id < macros_.size(); id++) {
+    pin_locations_[id] = {macros_[id].getPinX(), macros_[id].getPinY()};
+  }
+
+  for (int net_id = 0; net_id < nets_.size(); net_id++) {
+    const BundledNet& net = nets_[net_id];
+    macro_nets_[net.terminals.first].push_back(net_id);
+    if (net.terminals.second != net.terminals.first) {
+      macro_nets_[net.terminals.second].push_back(net_id);
+    }
+    net_lengths_[net_id] = calNetLength(net);
+    total_net_weight_ += net.weight;
+  }
+}
+
+template <class T>
+float SimulatedAnnealingCore<T>::calNetLength(const BundledNet& net) const
+{
+  const float x1 = macros_[net.terminals.first].getPinX();
+  const float y1 = macros_[net.terminals.first].getPinY();
+  const float x2 = macros_[net.terminals.second].getPinX();
+  const float y2 = macros_[net.terminals.second].getPinY();
+  return net.weight * (std::abs(x2 - x1) + std::abs(y2 - y1));
+}
+
 template <class T>
 void SimulatedAnnealingCore<T>::calFencePenalty()
 {
@@ -374,91 +447,69 @@ void SimulatedAnnealingCore<T>::packFloorplan()
     macros_[macro_id].setY(0.0);
   }
 
-  // Each index corresponds to a macro id whose pair is:
-  // <Position in Positive Sequence , Position in Negative Sequence>
-  std::vector<std::pair<int, int>> sequence_pair_pos(pos_seq_.size());
-
-  // calculate X position
-  for (int i = 0; i < pos_seq_.size(); i++) {
-    sequence_pair_pos[pos_seq_[i]].first = i;
-    sequence_pair_pos[neg_seq_[i]].second = i;
+  neg_seq_index_.resize(macros_.size());
+  for (int i = 0; i < neg_seq_.size(); i++) {
+    neg_seq_index_[neg_seq_[i]] = i;
   }
 
-  std::vector<float> accumulated_length(pos_seq_.size(), 0.0);
-  for (int i = 0; i < pos_seq_.size(); i++) {
-    const int macro_id = pos_seq_[i];
+  width_ = packSequencePair(true);
+  height_ = packSequencePair(false);
 
-    // There may exist pin access macros with zero area in our sequence pair
-    // when bus planning is on. This check is a temporary approach.
-    if (macros_[macro_id].getWidth() <= 0
-        || macros_[macro_id].getHeight() <= 0) {
-      continue;
-    }
-
-    const int neg_seq_pos = sequence_pair_pos[macro_id].second;
-
-    macros_[macro_id].setX(accumulated_length[neg_seq_pos]);
-
-    const float current_length
-        = macros_[macro_id].getX() + macros_[macro_id].getWidth();
-
-    for (int j = neg_seq_pos; j < neg_seq_.size(); j++) {
-      if (current_length > accumulated_length[j]) {
-        accumulated_length[j] = current_length;
-      } else {
-        break;
-      }
-    }
-  }
-
-  width_ = accumulated_length[pos_seq_.size() - 1];
-
-  // calulate Y position
-  std::vector<int> reversed_pos_seq(pos_seq_.size());
-  for (int i = 0; i < reversed_pos_seq.size(); i++) {
-    reversed_pos_seq[i] = pos_seq_[reversed_pos_seq.size() - 1 - i];
+  if (graphics_) {
+    graphics_->saStep(macros_);
   }
+}
 
-  for (int i = 0; i < pos_seq_.size(); i++) {
-    sequence_pair_pos[reversed_pos_seq[i]].first = i;
-    sequence_pair_pos[neg_seq_[i]].second = i;
-
-    // This is actually the accumulated height, but we use the same vector
-    // to avoid more allocation.
-    accumulated_length[i] = 0.0;
-  }
+// Computes the X (horizontal) or Y positions as the longest paths of the
+// sequence pair in O(n log n) (Tang and Wong, "FAST-SP").
+//
+// A macro is right of every macro that precedes it in both sequences, so
+// visiting the macros in positive sequence order, its X is the largest
+// right edge among the visited macros with a smaller negative sequence
+// position.  That prefix maximum is kept in a Fenwick tree indexed by
+// negative sequence position.  Y is found the same way visiting the
+// positive sequence in reverse.  Returns the width or height of the
+// packing.
+template <class T>
+float SimulatedAnnealingCore<T>::packSequencePair(const bool horizontal)
+{
+  const int size = pos_seq_.size();
+  packing_tree_.assign(size + 1, 0.0);
 
-  for (int i = 0; i < pos_seq_.size(); i++) {
-    const int macro_id = reversed_pos_seq[i];
+  float length = 0.0;
+  for (int i = 0; i < size; i++) {
+    const int macro_id = horizontal ? pos_seq_[i] : pos_seq_[size - 1 - i];
+    T& macro = macros_[macro_id];
 
     // There may exist pin access macros with zero area in our sequence pair
     // when bus planning is on. This check is a temporary approach.
-    if (macros_[macro_id].getWidth() <= 0
-        || macros_[macro_id].getHeight() <= 0) {
+    if (macro.getWidth() <= 0 || macro.getHeight() <= 0) {
       continue;
     }
 
-    const int neg_seq_pos = sequence_pair_pos[macro_id].second;
+    const int neg_seq_pos = neg_seq_index_[macro_id];
 
-    macros_[macro_id].setY(accumulated_length[neg_seq_pos]);
+    float start = 0.0;
+    for (int j = neg_seq_pos + 1; j > 0; j -= j & -j) {
+      start = std::max(start, packing_tree_[j]);
+    }
 
-    const float current_height
-        = macros_[macro_id].getY() + macros_[macro_id].getHeight();
+    float end;
+    if (horizontal) {
+      macro.setX(start);
+      end = macro.getX() + macro.getWidth();
+    } else {
+      macro.setY(start);
+      end = macro.getY() + macro.getHeight();
+    }
 
-    for (int j = neg_seq_pos; j < neg_seq_.size(); j++) {
-      if (current_height > accumulated_length[j]) {
-        accumulated_length[j] = current_height;
-      } else {
-        break;
-      }
+    for (int j = neg_seq_pos + 1; j <= size; j += j & -j) {
+      packing_tree_[j] = std::max(packing_tree_[j], end);
     }
+    length = std::max(length, end);
   }
 
-  height_ = accumulated_length[pos_seq_.size() - 1];
-
-  if (graphics_) {
-    graphics_->saStep(macros_);
-  }
+  return length;
 }
 
 // SingleSeqSwap
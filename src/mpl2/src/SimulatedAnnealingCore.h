@@ -35,6 +35,7 @@
 
 #include <map>
 #include <random>
+#include <utility>
 #include <vector>
 
 #include "Mpl2Observer.h"
@@ -137,11 +138,14 @@ class SimulatedAnnealingCore
   virtual void calPenalty() = 0;
   void calOutlinePenalty();
   void calWirelength();
+  // Undo the changes of the last calWirelength() when a move is rejected
+  void restoreWirelength();
   void calGuidancePenalty();
   void calFencePenalty();
 
   // operations
   void packFloorplan();
+  float packSequencePair(bool horizontal);
   virtual void perturb() = 0;
   virtual void restore() = 0;
   // actions used
@@ -150,6 +154,9 @@ class SimulatedAnnealingCore
   void exchangeMacros();
   void generateRandomIndices(int& index1, int& index2);
 
+  void initWirelength();
+  float calNetLength(const BundledNet& net) const;
+
   virtual void shrink() = 0;  // Shrink the size of macros
 
   // utilities
@@ -205,6 +212,24 @@ class SimulatedAnnealingCore
   int macro_id_ = -1;          // the macro changed in the perturb
   int action_id_ = -1;         // the action_id of current step
 
+  // scratch space for packFloorplan
+  std::vector<int> neg_seq_index_;  // macro id -> position in neg_seq_
+  std::vector<float> packing_tree_;
+
+  // The wirelength is updated incrementally: only the nets of the
+  // macros whose pin moved since the last evaluation are measured again.
+  // The lengths are summed in net order in float, as the wirelength was
+  // before, so that the anneal takes the same decisions.
+  std::vector<std::vector<int>> macro_nets_;  // macro id -> net indices
+  std::vector<std::pair<float, float>> pin_locations_;  // last evaluated
+  std::vector<float> net_lengths_;                      // weighted
+  std::vector<int> net_evaluation_;  // last evaluation touching each net
+  int evaluation_ = 0;
+  float total_net_weight_ = 0.0;
+  // previous values of what the last evaluation changed
+  std::vector<std::pair<int, std::pair<float, float>>> pin_location_undo_;
+  std::vector<std::pair<int, float>> net_length_undo_;
+
   // metrics
   float width_ = 0.0;
   float height_ = 0.0;
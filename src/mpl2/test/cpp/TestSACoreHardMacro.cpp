@@ -0,0 +1,246 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../../src/SACoreHardMacro.h"
+#include "../../src/object.h"
+#include "gtest/gtest.h"
+#include "utl/Logger.h"
+
+namespace mpl2 {
+
+// The wirelength from measuring every net of the packed macros, summed in
+// float in net order like the annealer always did
+static float fullWirelength(const std::vector<HardMacro>& macros,
+                            const std::vector<BundledNet>& nets,
+                            const Rect& outline)
+{
+  float length = 0.0;
+  float weight = 0.0;
+  for (const BundledNet& net : nets) {
+    const HardMacro& src = macros[net.terminals.first];
+    const HardMacro& target = macros[net.terminals.second];
+    length += net.weight
+              * (std::abs(target.getPinX() - src.getPinX())
+                 + std::abs(target.getPinY() - src.getPinY()));
+    weight += net.weight;
+  }
+  return length / weight / (outline.getHeight() + outline.getWidth());
+}
+
+// Exposes the packing of a given sequence pair
+class PackingSACore : public SACoreHardMacro
+{
+ public:
+  PackingSACore(const Rect& outline,
+                const std::vector<HardMacro>& macros,
+                utl::Logger* logger)
+      : SACoreHardMacro(outline,
+                        macros,
+                        1.0,   // area
+                        1.0,   // outline
+                        1.0,   // wirelength
+                        0.0,   // guidance
+                        0.0,   // fence
+                        0.2,   // pos swap
+                        0.2,   // neg swap
+                        0.2,   // double swap
+                        0.2,   // exchange
+                        0.2,   // flip
+                        0.95,  // init prob
+                        1,     // steps
+                        1,     // perturbs per step
+                        1,     // seed
+                        nullptr,
+                        logger)
+  {
+  }
+
+  void pack(const std::vector<int>& pos_seq, const std::vector<int>& neg_seq)
+  {
+    pos_seq_ = pos_seq;
+    neg_seq_ = neg_seq;
+    packFloorplan();
+  }
+};
+
+// The quadratic packing: a macro is right of (above) every macro that
+// precedes it in both sequences (precedes it in the negative sequence and
+// follows it in the positive one).  Macros without area are not packed.
+static void naivePack(std::vector<HardMacro>& macros,
+                      const std::vector<int>& pos_seq,
+                      const std::vector<int>& neg_seq,
+                      float& width,
+                      float& height)
+{
+  const int size = pos_seq.size();
+  std::vector<int> pos_index(size);
+  std::vector<int> neg_index(size);
+  for (int i = 0; i < size; i++) {
+    pos_index[pos_seq[i]] = i;
+    neg_index[neg_seq[i]] = i;
+  }
+
+  width = 0.0;
+  height = 0.0;
+  for (HardMacro& macro : macros) {
+    macro.setX(0.0);
+    macro.setY(0.0);
+  }
+  for (int i = 0; i < size; i++) {
+    HardMacro& macro = macros[pos_seq[i]];
+    if (macro.getWidth() <= 0 || macro.getHeight() <= 0) {
+      continue;
+    }
+    float x = 0.0;
+    for (int j = 0; j < i; j++) {
+      const HardMacro& left = macros[pos_seq[j]];
+      if (left.getWidth() > 0 && left.getHeight() > 0
+          && neg_index[pos_seq[j]] < neg_index[pos_seq[i]]) {
+        x = std::max(x, left.getX() + left.getWidth());
+      }
+    }
+    macro.setX(x);
+    width = std::max(width, x + macro.getWidth());
+  }
+  for (int i = size - 1; i >= 0; i--) {
+    HardMacro& macro = macros[pos_seq[i]];
+    if (macro.getWidth() <= 0 || macro.getHeight() <= 0) {
+      continue;
+    }
+    float y = 0.0;
+    for (int j = size - 1; j > i; j--) {
+      const HardMacro& below = macros[pos_seq[j]];
+      if (below.getWidth() > 0 && below.getHeight() > 0
+          && neg_index[pos_seq[j]] < neg_index[pos_seq[i]]) {
+        y = std::max(y, below.getY() + below.getHeight());
+      }
+    }
+    macro.setY(y);
+    height = std::max(height, y + macro.getHeight());
+  }
+}
+
+TEST(Mpl2SACoreHardMacro, PackingMatchesQuadraticPacking)
+{
+  utl::Logger logger;
+  const Rect outline(0, 0, 1000, 1000);
+  std::mt19937 rng(11);
+
+  for (int size : {1, 2, 5, 17, 60}) {
+    std::vector<HardMacro> macros;
+    for (int i = 0; i < size; i++) {
+      // one in seven macros has no area, like the pin access macros
+      const bool empty = i % 7 == 3;
+      macros.emplace_back(empty ? 0.0f : 1.0f + rng() % 40,
+                          empty ? 0.0f : 1.0f + rng() % 40,
+                          "m" + std::to_string(i));
+    }
+    PackingSACore sa(outline, macros, &logger);
+
+    for (int trial = 0; trial < 20; trial++) {
+      std::vector<int> pos_seq(size);
+      std::iota(pos_seq.begin(), pos_seq.end(), 0);
+      std::vector<int> neg_seq = pos_seq;
+      std::shuffle(pos_seq.begin(), pos_seq.end(), rng);
+      std::shuffle(neg_seq.begin(), neg_seq.end(), rng);
+
+      sa.pack(pos_seq, neg_seq);
+      std::vector<HardMacro> packed;
+      sa.getMacros(packed);
+
+      std::vector<HardMacro> expected = macros;
+      float width;
+      float height;
+      naivePack(expected, pos_seq, neg_seq, width, height);
+
+      EXPECT_EQ(sa.getWidth(), width);
+      EXPECT_EQ(sa.getHeight(), height);
+      for (int i = 0; i < size; i++) {
+        EXPECT_EQ(packed[i].getX(), expected[i].getX()) << "macro " << i;
+        EXPECT_EQ(packed[i].getY(), expected[i].getY()) << "macro " << i;
+      }
+    }
+  }
+}
+
+TEST(Mpl2SACoreHardMacro, IncrementalWirelengthMatchesFullRecompute)
+{
+  utl::Logger logger;
+  const Rect outline(0, 0, 400, 400);
+
+  std::vector<HardMacro> macros;
+  for (int i = 0; i < 24; i++) {
+    macros.emplace_back(
+        10.0f + 7 * (i % 5), 12.0f + 5 * (i % 7), "m" + std::to_string(i));
+  }
+  std::vector<BundledNet> nets;
+  for (int i = 0; i < macros.size(); i++) {
+    nets.emplace_back(i, (i * 7 + 3) % macros.size(), 1.0f + i % 3);
+    nets.emplace_back(i, (i + 1) % macros.size(), 0.5f);
+  }
+
+  SACoreHardMacro sa(outline,
+                     macros,
+                     1.0,   // area
+                     1.0,   // outline
+                     1.0,   // wirelength
+                     0.0,   // guidance
+                     0.0,   // fence
+                     0.2,   // pos swap
+                     0.2,   // neg swap
+                     0.2,   // double swap
+                     0.2,   // exchange
+                     0.2,   // flip
+                     0.95,  // init prob
+                     500,   // steps
+                     50,    // perturbs per step
+                     7,     // seed
+                     nullptr,
+                     &logger);
+  sa.setNets(nets);
+  sa.initialize();
+  sa.fastSA();
+
+  std::vector<HardMacro> result;
+  sa.getMacros(result);
+  const float expected = fullWirelength(result, nets, outline);
+  EXPECT_EQ(sa.getWirelength(), expected);
+}
+
+}  // namespace mpl2
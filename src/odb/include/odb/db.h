@@ -397,17 +397,28 @@ class dbDatabase : public dbObject
   uint getNumberOfMasters();
 
   ///
-  /// Read a database from this stream.
+  /// Read a database from this stream.  The checksum of each table section
+  /// is verified and the sections are parsed on up to num_threads threads.
   /// WARNING: This function destroys the data currently in the database.
   /// Throws ZIOError..
   ///
-  void read(std::istream& f);
+  void read(std::istream& f, int num_threads = 1);
 
   ///
-  /// Write a database to this stream.
+  /// Read a database from this file by memory mapping it.  The wires,
+  /// special wires, routing guides and parasitics of the block are only
+  /// parsed (and their checksums verified) when they are first accessed.
+  /// The file must not be modified while the database is in use.
+  /// WARNING: This function destroys the data currently in the database.
+  ///
+  void readMapped(const char* filename, int num_threads = 1);
+
+  ///
+  /// Write a database to this stream.  The large tables are written as
+  /// compressed, checksummed sections built on up to num_threads threads.
   /// Throws ZIOError..
   ///
-  void write(std::ostream& file);
+  void write(std::ostream& file, int num_threads = 1);
 
   ///
   /// ECO - The following methods implement a simple ECO mechanism for capturing
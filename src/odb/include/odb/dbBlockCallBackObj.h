@@ -109,6 +109,10 @@ class dbBlockCallBackObj
 
   // dbBPin Start
   virtual void inDbBPinCreate(dbBPin*) {}
+  virtual void inDbBPinAddBox(dbBox*) {}
+  virtual void inDbBPinPlacementStatusBefore(dbBPin*, const dbPlacementStatus&)
+  {
+  }
   virtual void inDbBPinDestroy(dbBPin*) {}
   // dbBPin End
 
@@ -35,7 +35,9 @@
 #include <array>
 #include <cstdint>
 #include <cstring>
+#include <functional>
 #include <istream>
+#include <memory>
 #include <ostream>
 #include <string>
 #include <unordered_map>
@@ -54,6 +56,36 @@ class _dbDatabase;
 
 inline constexpr size_t kTemplateRecursionLimit = 16;
 
+// The unparsed bytes of a section written by dbOStream::writeSection.
+// owner keeps the storage alive (a copy of the bytes or a memory mapped
+// file that data points into).  Sections may be zlib compressed and carry
+// a crc32 of the stored bytes.
+struct dbStreamSection
+{
+  std::shared_ptr<const void> owner;
+  const char* data = nullptr;
+  uint64_t size = 0;
+  uint64_t raw_size = 0;
+  uint32_t checksum = 0;
+  bool compressed = false;
+  bool has_checksum = false;
+
+  // Checks the crc and uncompresses the section if needed.  Returns the
+  // raw bytes, which may live in buffer.  Throws ZException if the
+  // section is corrupt.
+  std::pair<const char*, uint64_t> decode(std::string& buffer) const;
+};
+
+// Runs the jobs on up to num_threads threads.  The first exception thrown
+// by a job is rethrown once all the jobs are done.
+void dbRunJobs(const std::vector<std::function<void()>>& jobs,
+               int num_threads);
+
+// Compresses size bytes of data into a complete gzip member.  A file made
+// of several members is still a valid gzip file, which lets independent
+// parts of a large output be compressed in parallel.
+std::string dbGzipCompress(const char* data, size_t size);
+
 class dbOStream
 {
   using Position = std::ostream::pos_type;
@@ -68,6 +100,8 @@ class dbOStream
   double _lef_area_factor;
   double _lef_dist_factor;
   std::vector<Scope> _scopes;
+  int _threads = 1;
+  std::map<const void*, dbStreamSection> _prepared;
 
   // By default values are written as their string ("255" vs 0xFF)
   // representations when using the << stream method. In dbOstream we are
@@ -270,6 +304,23 @@ class dbOStream
 
   Position pos() const { return _f.tellp(); }
 
+  void writeBytes(const char* data, uint64_t size) { _f.write(data, size); }
+
+  // Writes whatever write_section streams as a compressed, checksummed
+  // section so that a reader may validate it and skip or defer parsing it.
+  // If a section for key was prepared it is written instead.
+  void writeSection(const void* key,
+                    const std::function<void(dbOStream&)>& write_section);
+  void writeSection(const dbStreamSection& section);
+
+  // Builds sections ahead of the sequential write using the stream's
+  // threads.  Each key is written later by writeSection(key, ...).
+  using SectionJob = std::pair<const void*, std::function<void(dbOStream&)>>;
+  void prepareSections(const std::vector<SectionJob>& jobs);
+
+  void setThreads(int threads) { _threads = threads; }
+  int getThreads() const { return _threads; }
+
   void pushScope(const std::string& name);
   void popScope();
 };
@@ -490,7 +541,30 @@ class dbIStream
 
   double lefdist(int value) { return ((double) value * _lef_dist_factor); }
 
+  // Sets the memory backing the stream (eg a mapped file) so that
+  // readSection can reference sections in place instead of copying them.
+  void setStorage(std::shared_ptr<const void> owner,
+                  const char* data,
+                  uint64_t size);
+  bool hasStorage() const { return _storage_data != nullptr; }
+
+  // Sections can be parsed after the read completes only if the stream is
+  // mapped and was written with the current schema, as the database
+  // revision is updated once it is read.
+  bool canDeferSections() const;
+
+  // Reads a section written by dbOStream::writeSection without parsing it.
+  dbStreamSection readSection();
+
+  void setThreads(int threads) { _threads = threads; }
+  int getThreads() const { return _threads; }
+
  private:
+  int _threads = 1;
+  std::shared_ptr<const void> _storage_owner;
+  const char* _storage_data = nullptr;
+  uint64_t _storage_size = 0;
+
   template <uint32_t I = 0, typename... Ts>
   dbIStream& variantHelper(uint32_t index, std::variant<Ts...>& v)
   {
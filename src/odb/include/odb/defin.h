@@ -73,6 +73,9 @@ class defin
   void namesAreDBIDs();
   void setAssemblyMode();
   void useBlockName(const char* name);
+  // Parse COMPONENTS, NETS and SPECIALNETS with this many threads (DEFAULT
+  // mode only).  The default of one thread reads the file serially.
+  void setThreads(int threads);
 
   /// Create a new chip
   dbChip* createChip(std::vector<dbLib*>& search_libs,
@@ -65,6 +65,8 @@ class defout
   void setUseMasterIds(bool value);
   void selectNet(dbNet* net);
   void setVersion(Version v);  // default is 5.8
+  // Format COMPONENTS, NETS and SPECIALNETS on multiple threads
+  void setThreads(int threads);
 
   bool writeBlock(dbBlock* block, const char* def_file);
 };
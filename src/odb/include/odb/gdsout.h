@@ -35,6 +35,7 @@
 #include <cstdint>
 #include <fstream>
 #include <iostream>
+#include <string>
 #include <vector>
 
 #include "gdsin.h"
@@ -70,12 +71,19 @@ class GDSWriter
   /**
    * Writes a dbGDSLib object to a GDS file
    *
+   * Structures are formatted into memory buffers on up to num_threads
+   * threads and written in order.  A filename ending in ".gz" is gzip
+   * compressed, each buffer by the thread that formatted it.
+   *
    * @param filename The path to the output file
    * @param lib The dbGDSLib object to write
+   * @param num_threads The number of threads used to format structures
    * @throws std::runtime_error if the file cannot be opened, or if the GDS is
    * corrupted
    */
-  void write_gds(dbGDSLib* lib, const std::string& filename);
+  void write_gds(dbGDSLib* lib,
+                 const std::string& filename,
+                 int num_threads = 1);
 
  private:
   /**
@@ -86,26 +94,26 @@ class GDSWriter
   void calcRecSize(record_t& r);
 
   /**
-   * Writes a record to the output file stream
+   * Appends a record to the output buffer
    *
    * @param r The record to write
    */
   void writeRecord(record_t& r);
 
   /**
-   * Writes a real8 to _file
+   * Writes a real8 to _buffer
    *
    * NOTE: real8 is not the same as double. This conversion is not lossless.
    */
   void writeReal8(double real);
 
-  /** Writes an int32 to _file */
+  /** Writes an int32 to _buffer */
   void writeInt32(int32_t i);
 
-  /** Writes an int16 to _file */
+  /** Writes an int16 to _buffer */
   void writeInt16(int16_t i);
 
-  /** Writes an int8 to _file */
+  /** Writes an int8 to _buffer */
   void writeInt8(int8_t i);
 
   /** Helper function to write layer record of a dbGDSElement to _file */
@@ -121,7 +129,16 @@ class GDSWriter
   void writePropAttr(dbGDSElement* el);
 
   /** Writes _lib to the _file */
-  void writeLib();
+  void writeLib(int num_threads);
+
+  /** Writes the structures of _lib to _file */
+  void writeStructs(int num_threads);
+
+  /** Writes _buffer to _file, compressing it if needed, and clears it */
+  void flushBuffer();
+
+  /** Writes the BGNLIB / BGNSTR timestamp record */
+  void writeTimestamp(RecordType type);
 
   /** Writes a dbGDSStructure to _file */
   void writeStruct(dbGDSStructure* str);
@@ -145,6 +162,12 @@ class GDSWriter
 
   /** Output filestream */
   std::ofstream _file;
+  /** Records not yet written to _file */
+  std::string _buffer;
+  /** Whether _file is gzip compressed */
+  bool _gzip;
+  /** Modification and access time of the library, taken once per write */
+  std::vector<int16_t> _timestamp;
   /** Current dbGDSLib object */
   dbGDSLib* _lib;
 };
@@ -36,9 +36,11 @@
 #include <unistd.h>
 
 #include <fstream>
+#include <functional>
 #include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "dbAccessPoint.h"
 #include "dbArrayTable.h"
@@ -240,7 +242,7 @@ _dbBlock::_dbBlock(_dbDatabase* db)
   global_connect_tbl_ = new dbTable<_dbGlobalConnect>(
       db, this, (GetObjTbl_t) &_dbBlock::getObjectTable, dbGlobalConnectObj);
 
-  _guide_tbl = new dbTable<_dbGuide>(
+  _guide_tbl = new dbDeferredTable<_dbGuide>(
       db, this, (GetObjTbl_t) &_dbBlock::getObjectTable, dbGuideObj);
 
   _net_tracks_tbl = new dbTable<_dbNetTrack>(
@@ -264,13 +266,13 @@ _dbBlock::_dbBlock(_dbDatabase* db)
   _blockage_tbl = new dbTable<_dbBlockage>(
       db, this, (GetObjTbl_t) &_dbBlock::getObjectTable, dbBlockageObj);
 
-  _wire_tbl = new dbTable<_dbWire>(
+  _wire_tbl = new dbDeferredTable<_dbWire>(
       db, this, (GetObjTbl_t) &_dbBlock::getObjectTable, dbWireObj);
 
-  _swire_tbl = new dbTable<_dbSWire>(
+  _swire_tbl = new dbDeferredTable<_dbSWire>(
       db, this, (GetObjTbl_t) &_dbBlock::getObjectTable, dbSWireObj);
 
-  _sbox_tbl = new dbTable<_dbSBox>(
+  _sbox_tbl = new dbDeferredTable<_dbSBox>(
       db, this, (GetObjTbl_t) &_dbBlock::getObjectTable, dbSBoxObj);
 
   _row_tbl = new dbTable<_dbRow>(
@@ -320,21 +322,21 @@ _dbBlock::_dbBlock(_dbDatabase* db)
   _cc_val_tbl->push_back(0.0);
 
   _cap_node_tbl
-      = new dbTable<_dbCapNode>(db,
-                                this,
-                                (GetObjTbl_t) &_dbBlock::getObjectTable,
-                                dbCapNodeObj,
-                                4096,
-                                12);
+      = new dbDeferredTable<_dbCapNode>(db,
+                                        this,
+                                        (GetObjTbl_t) &_dbBlock::getObjectTable,
+                                        dbCapNodeObj,
+                                        4096,
+                                        12);
 
   // We need to allocate the first cap-node (id == 1) to resolve a problem with
   // the extraction code (Hopefully this is temporary)
   _cap_node_tbl->create();
 
-  _r_seg_tbl = new dbTable<_dbRSeg>(
+  _r_seg_tbl = new dbDeferredTable<_dbRSeg>(
       db, this, (GetObjTbl_t) &_dbBlock::getObjectTable, dbRSegObj, 4096, 12);
 
-  _cc_seg_tbl = new dbTable<_dbCCSeg>(
+  _cc_seg_tbl = new dbDeferredTable<_dbCCSeg>(
       db, this, (GetObjTbl_t) &_dbBlock::getObjectTable, dbCCSegObj, 4096, 12);
 
   _extControl = new dbExtControl();
@@ -504,7 +506,7 @@ _dbBlock::_dbBlock(_dbDatabase* db, const _dbBlock& block)
   global_connect_tbl_
       = new dbTable<_dbGlobalConnect>(db, this, *block.global_connect_tbl_);
 
-  _guide_tbl = new dbTable<_dbGuide>(db, this, *block._guide_tbl);
+  _guide_tbl = new dbDeferredTable<_dbGuide>(db, this, *block._guide_tbl);
 
   _net_tracks_tbl = new dbTable<_dbNetTrack>(db, this, *block._net_tracks_tbl);
 
@@ -521,11 +523,11 @@ _dbBlock::_dbBlock(_dbDatabase* db, const _dbBlock& block)
 
   _blockage_tbl = new dbTable<_dbBlockage>(db, this, *block._blockage_tbl);
 
-  _wire_tbl = new dbTable<_dbWire>(db, this, *block._wire_tbl);
+  _wire_tbl = new dbDeferredTable<_dbWire>(db, this, *block._wire_tbl);
 
-  _swire_tbl = new dbTable<_dbSWire>(db, this, *block._swire_tbl);
+  _swire_tbl = new dbDeferredTable<_dbSWire>(db, this, *block._swire_tbl);
 
-  _sbox_tbl = new dbTable<_dbSBox>(db, this, *block._sbox_tbl);
+  _sbox_tbl = new dbDeferredTable<_dbSBox>(db, this, *block._sbox_tbl);
 
   _row_tbl = new dbTable<_dbRow>(db, this, *block._row_tbl);
 
@@ -553,11 +555,12 @@ _dbBlock::_dbBlock(_dbDatabase* db, const _dbBlock& block)
 
   _cc_val_tbl = new dbPagedVector<float, 4096, 12>(*block._cc_val_tbl);
 
-  _cap_node_tbl = new dbTable<_dbCapNode>(db, this, *block._cap_node_tbl);
+  _cap_node_tbl
+      = new dbDeferredTable<_dbCapNode>(db, this, *block._cap_node_tbl);
 
-  _r_seg_tbl = new dbTable<_dbRSeg>(db, this, *block._r_seg_tbl);
+  _r_seg_tbl = new dbDeferredTable<_dbRSeg>(db, this, *block._r_seg_tbl);
 
-  _cc_seg_tbl = new dbTable<_dbCCSeg>(db, this, *block._cc_seg_tbl);
+  _cc_seg_tbl = new dbDeferredTable<_dbCCSeg>(db, this, *block._cc_seg_tbl);
 
   _extControl = new dbExtControl();
 
@@ -944,6 +947,28 @@ dbOStream& operator<<(dbOStream& stream, const _dbBlock& block)
   }
   _dbDatabase* db = block.getImpl()->getDatabase();
   dbOStreamScope scope(stream, "dbBlock");
+
+  // Build the large table sections in parallel ahead of the sequential write
+  std::vector<dbOStream::SectionJob> jobs;
+  block._bterm_tbl->addSectionJob(jobs);
+  block._iterm_tbl->addSectionJob(jobs);
+  block._net_tbl->addSectionJob(jobs);
+  block._inst_hdr_tbl->addSectionJob(jobs);
+  block._inst_tbl->addSectionJob(jobs);
+  block._module_tbl->addSectionJob(jobs);
+  block._modinst_tbl->addSectionJob(jobs);
+  block._modbterm_tbl->addSectionJob(jobs);
+  block._moditerm_tbl->addSectionJob(jobs);
+  block._modnet_tbl->addSectionJob(jobs);
+  block._guide_tbl->addSectionJob(jobs);
+  block._wire_tbl->addSectionJob(jobs);
+  block._swire_tbl->addSectionJob(jobs);
+  block._sbox_tbl->addSectionJob(jobs);
+  block._cap_node_tbl->addSectionJob(jobs);
+  block._r_seg_tbl->addSectionJob(jobs);
+  block._cc_seg_tbl->addSectionJob(jobs);
+  stream.prepareSections(jobs);
+
   stream << block._def_units;
   stream << block._dbu_per_micron;
   stream << block._hier_delimeter;
@@ -991,17 +1016,17 @@ dbOStream& operator<<(dbOStream& stream, const _dbBlock& block)
   stream << block._component_mask_shift;
   stream << block._currentCcAdjOrder;
 
-  stream << *block._bterm_tbl;
-  stream << *block._iterm_tbl;
-  stream << *block._net_tbl;
-  stream << *block._inst_hdr_tbl;
-  stream << *block._inst_tbl;
-  stream << *block._module_tbl;
-  stream << *block._modinst_tbl;
+  stream << TableSection("bterm_tbl", block._bterm_tbl);
+  stream << TableSection("iterm_tbl", block._iterm_tbl);
+  stream << TableSection("net_tbl", block._net_tbl);
+  stream << TableSection("inst_hdr_tbl", block._inst_hdr_tbl);
+  stream << TableSection("inst_tbl", block._inst_tbl);
+  stream << TableSection("module_tbl", block._module_tbl);
+  stream << TableSection("modinst_tbl", block._modinst_tbl);
   if (db->isSchema(db_schema_update_hierarchy)) {
-    stream << *block._modbterm_tbl;
-    stream << *block._moditerm_tbl;
-    stream << *block._modnet_tbl;
+    stream << TableSection("modbterm_tbl", block._modbterm_tbl);
+    stream << TableSection("moditerm_tbl", block._moditerm_tbl);
+    stream << TableSection("modnet_tbl", block._modnet_tbl);
   }
   stream << *block._powerdomain_tbl;
   stream << *block._logicport_tbl;
@@ -1011,7 +1036,7 @@ dbOStream& operator<<(dbOStream& stream, const _dbBlock& block)
   stream << *block._group_tbl;
   stream << *block.ap_tbl_;
   stream << *block.global_connect_tbl_;
-  stream << *block._guide_tbl;
+  stream << TableSection("guide_tbl", block._guide_tbl);
   stream << *block._net_tracks_tbl;
   stream << *block._box_tbl;
   stream << *block._via_tbl;
@@ -1019,9 +1044,9 @@ dbOStream& operator<<(dbOStream& stream, const _dbBlock& block)
   stream << *block._track_grid_tbl;
   stream << *block._obstruction_tbl;
   stream << *block._blockage_tbl;
-  stream << *block._wire_tbl;
-  stream << *block._swire_tbl;
-  stream << *block._sbox_tbl;
+  stream << TableSection("wire_tbl", block._wire_tbl);
+  stream << TableSection("swire_tbl", block._swire_tbl);
+  stream << TableSection("sbox_tbl", block._sbox_tbl);
   stream << *block._row_tbl;
   stream << *block._fill_tbl;
   stream << *block._region_tbl;
@@ -1035,9 +1060,9 @@ dbOStream& operator<<(dbOStream& stream, const _dbBlock& block)
   stream << *block._r_val_tbl;
   stream << *block._c_val_tbl;
   stream << *block._cc_val_tbl;
-  stream << NamedTable("cap_node_tbl", block._cap_node_tbl);
-  stream << NamedTable("r_seg_tbl", block._r_seg_tbl);
-  stream << NamedTable("cc_seg_tbl", block._cc_seg_tbl);
+  stream << TableSection("cap_node_tbl", block._cap_node_tbl);
+  stream << TableSection("r_seg_tbl", block._r_seg_tbl);
+  stream << TableSection("cc_seg_tbl", block._cc_seg_tbl);
   stream << *block._extControl;
   stream << block._dft;
   stream << *block._dft_tbl;
@@ -1123,17 +1148,30 @@ dbIStream& operator>>(dbIStream& stream, _dbBlock& block)
     stream >> block._component_mask_shift;
   }
   stream >> block._currentCcAdjOrder;
-  stream >> *block._bterm_tbl;
-  stream >> *block._iterm_tbl;
-  stream >> *block._net_tbl;
-  stream >> *block._inst_hdr_tbl;
-  stream >> *block._inst_tbl;
-  stream >> *block._module_tbl;
-  stream >> *block._modinst_tbl;
-  if (db->isSchema(db_schema_update_hierarchy)) {
-    stream >> *block._modbterm_tbl;
-    stream >> *block._moditerm_tbl;
-    stream >> *block._modnet_tbl;
+  if (db->isSchema(db_schema_section_checksums)) {
+    stream >> TableSection("bterm_tbl", block._bterm_tbl);
+    stream >> TableSection("iterm_tbl", block._iterm_tbl);
+    stream >> TableSection("net_tbl", block._net_tbl);
+    stream >> TableSection("inst_hdr_tbl", block._inst_hdr_tbl);
+    stream >> TableSection("inst_tbl", block._inst_tbl);
+    stream >> TableSection("module_tbl", block._module_tbl);
+    stream >> TableSection("modinst_tbl", block._modinst_tbl);
+    stream >> TableSection("modbterm_tbl", block._modbterm_tbl);
+    stream >> TableSection("moditerm_tbl", block._moditerm_tbl);
+    stream >> TableSection("modnet_tbl", block._modnet_tbl);
+  } else {
+    stream >> *block._bterm_tbl;
+    stream >> *block._iterm_tbl;
+    stream >> *block._net_tbl;
+    stream >> *block._inst_hdr_tbl;
+    stream >> *block._inst_tbl;
+    stream >> *block._module_tbl;
+    stream >> *block._modinst_tbl;
+    if (db->isSchema(db_schema_update_hierarchy)) {
+      stream >> *block._modbterm_tbl;
+      stream >> *block._moditerm_tbl;
+      stream >> *block._modnet_tbl;
+    }
   }
   stream >> *block._powerdomain_tbl;
   stream >> *block._logicport_tbl;
@@ -1147,7 +1185,11 @@ dbIStream& operator>>(dbIStream& stream, _dbBlock& block)
   if (db->isSchema(db_schema_add_global_connect)) {
     stream >> *block.global_connect_tbl_;
   }
-  stream >> *block._guide_tbl;
+  if (db->isSchema(db_schema_deferred_tables)) {
+    stream >> TableSection("guide_tbl", block._guide_tbl);
+  } else {
+    stream >> *block._guide_tbl;
+  }
   if (db->isSchema(db_schema_net_tracks)) {
     stream >> *block._net_tracks_tbl;
   }
@@ -1157,9 +1199,15 @@ dbIStream& operator>>(dbIStream& stream, _dbBlock& block)
   stream >> *block._track_grid_tbl;
   stream >> *block._obstruction_tbl;
   stream >> *block._blockage_tbl;
-  stream >> *block._wire_tbl;
-  stream >> *block._swire_tbl;
-  stream >> *block._sbox_tbl;
+  if (db->isSchema(db_schema_deferred_tables)) {
+    stream >> TableSection("wire_tbl", block._wire_tbl);
+    stream >> TableSection("swire_tbl", block._swire_tbl);
+    stream >> TableSection("sbox_tbl", block._sbox_tbl);
+  } else {
+    stream >> *block._wire_tbl;
+    stream >> *block._swire_tbl;
+    stream >> *block._sbox_tbl;
+  }
   stream >> *block._row_tbl;
   stream >> *block._fill_tbl;
   stream >> *block._region_tbl;
@@ -1172,15 +1220,46 @@ dbIStream& operator>>(dbIStream& stream, _dbBlock& block)
   stream >> *block._r_val_tbl;
   stream >> *block._c_val_tbl;
   stream >> *block._cc_val_tbl;
-  stream >> *block._cap_node_tbl;  // DKF
-  stream >> *block._r_seg_tbl;     // DKF
-  stream >> *block._cc_seg_tbl;
+  if (db->isSchema(db_schema_deferred_tables)) {
+    stream >> TableSection("cap_node_tbl", block._cap_node_tbl);
+    stream >> TableSection("r_seg_tbl", block._r_seg_tbl);
+    stream >> TableSection("cc_seg_tbl", block._cc_seg_tbl);
+  } else {
+    stream >> *block._cap_node_tbl;  // DKF
+    stream >> *block._r_seg_tbl;     // DKF
+    stream >> *block._cc_seg_tbl;
+  }
   stream >> *block._extControl;
   if (db->isSchema(db_schema_add_scan)) {
     stream >> block._dft;
     stream >> *block._dft_tbl;
   }
 
+  // Parse the table sections in parallel.  The routing and parasitic
+  // tables of a mapped file are left until they are first used (see
+  // dbDeferredTable).
+  std::vector<std::function<void()>> loads{
+      [&]() { block._bterm_tbl->loadSection(); },
+      [&]() { block._iterm_tbl->loadSection(); },
+      [&]() { block._net_tbl->loadSection(); },
+      [&]() { block._inst_hdr_tbl->loadSection(); },
+      [&]() { block._inst_tbl->loadSection(); },
+      [&]() { block._module_tbl->loadSection(); },
+      [&]() { block._modinst_tbl->loadSection(); },
+      [&]() { block._modbterm_tbl->loadSection(); },
+      [&]() { block._moditerm_tbl->loadSection(); },
+      [&]() { block._modnet_tbl->loadSection(); }};
+  if (!stream.canDeferSections()) {
+    loads.emplace_back([&]() { block._guide_tbl->ensureLoaded(); });
+    loads.emplace_back([&]() { block._wire_tbl->ensureLoaded(); });
+    loads.emplace_back([&]() { block._swire_tbl->ensureLoaded(); });
+    loads.emplace_back([&]() { block._sbox_tbl->ensureLoaded(); });
+    loads.emplace_back([&]() { block._cap_node_tbl->ensureLoaded(); });
+    loads.emplace_back([&]() { block._r_seg_tbl->ensureLoaded(); });
+    loads.emplace_back([&]() { block._cc_seg_tbl->ensureLoaded(); });
+  }
+  dbRunJobs(loads, stream.getThreads());
+
   //---------------------------------------------------------- stream in
   // properties
   // TOM
@@ -1226,8 +1305,22 @@ void _dbBlock::remove_rect(const Rect& rect)
   }
 }
 
+void _dbBlock::loadDeferredTables() const
+{
+  _guide_tbl->ensureLoaded();
+  _wire_tbl->ensureLoaded();
+  _swire_tbl->ensureLoaded();
+  _sbox_tbl->ensureLoaded();
+  _cap_node_tbl->ensureLoaded();
+  _r_seg_tbl->ensureLoaded();
+  _cc_seg_tbl->ensureLoaded();
+}
+
 bool _dbBlock::operator==(const _dbBlock& rhs) const
 {
+  loadDeferredTables();
+  rhs.loadDeferredTables();
+
   if (_flags._valid_bbox != rhs._flags._valid_bbox) {
     return false;
   }
@@ -1564,6 +1657,9 @@ void _dbBlock::differences(dbDiff& diff,
                            const char* field,
                            const _dbBlock& rhs) const
 {
+  loadDeferredTables();
+  rhs.loadDeferredTables();
+
   DIFF_BEGIN
   DIFF_FIELD(_flags._valid_bbox);
   DIFF_FIELD(_def_units);
@@ -1665,6 +1761,8 @@ void _dbBlock::differences(dbDiff& diff,
 
 void _dbBlock::out(dbDiff& diff, char side, const char* field) const
 {
+  loadDeferredTables();
+
   DIFF_OUT_BEGIN
   DIFF_OUT_FIELD(_flags._valid_bbox);
   DIFF_OUT_FIELD(_def_units);
@@ -2753,13 +2851,13 @@ void dbBlock::initParasiticsValueTables()
     block->_cap_node_tbl->clear();
   } else {
     delete block->_cap_node_tbl;
-    block->_cap_node_tbl
-        = new dbTable<_dbCapNode>(db,
-                                  block,
-                                  (GetObjTbl_t) &_dbBlock::getObjectTable,
-                                  dbCapNodeObj,
-                                  4096,
-                                  12);
+    block->_cap_node_tbl = new dbDeferredTable<_dbCapNode>(
+        db,
+        block,
+        (GetObjTbl_t) &_dbBlock::getObjectTable,
+        dbCapNodeObj,
+        4096,
+        12);
   }
   block->_maxCapNodeId = 0;
 
@@ -2768,12 +2866,12 @@ void dbBlock::initParasiticsValueTables()
   } else {
     delete block->_r_seg_tbl;
     block->_r_seg_tbl
-        = new dbTable<_dbRSeg>(db,
-                               block,
-                               (GetObjTbl_t) &_dbBlock::getObjectTable,
-                               dbRSegObj,
-                               4096,
-                               12);
+        = new dbDeferredTable<_dbRSeg>(db,
+                                       block,
+                                       (GetObjTbl_t) &_dbBlock::getObjectTable,
+                                       dbRSegObj,
+                                       4096,
+                                       12);
   }
   block->_maxRSegId = 0;
 
@@ -2781,13 +2879,13 @@ void dbBlock::initParasiticsValueTables()
     block->_cc_seg_tbl->clear();
   } else {
     delete block->_cc_seg_tbl;
-    block->_cc_seg_tbl
-        = new dbTable<_dbCCSeg>(db,
-                                block,
-                                (GetObjTbl_t) &_dbBlock::getObjectTable,
-                                dbCCSegObj,
-                                4096,
-                                12);
+    block->_cc_seg_tbl = new dbDeferredTable<_dbCCSeg>(
+        db,
+        block,
+        (GetObjTbl_t) &_dbBlock::getObjectTable,
+        dbCCSegObj,
+        4096,
+        12);
   }
   block->_maxCCSegId = 0;
 
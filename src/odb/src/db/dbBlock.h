@@ -50,6 +50,8 @@ namespace odb {
 template <class T>
 class dbTable;
 template <class T>
+class dbDeferredTable;
+template <class T>
 class dbArrayTable;
 class _dbProperty;
 class dbPropertyItr;
@@ -213,9 +215,9 @@ class _dbBlock : public _dbObject
   dbTable<_dbTrackGrid>* _track_grid_tbl;
   dbTable<_dbObstruction>* _obstruction_tbl;
   dbTable<_dbBlockage>* _blockage_tbl;
-  dbTable<_dbWire>* _wire_tbl;
-  dbTable<_dbSWire>* _swire_tbl;
-  dbTable<_dbSBox>* _sbox_tbl;
+  dbDeferredTable<_dbWire>* _wire_tbl;
+  dbDeferredTable<_dbSWire>* _swire_tbl;
+  dbDeferredTable<_dbSBox>* _sbox_tbl;
   dbTable<_dbRow>* _row_tbl;
   dbTable<_dbFill>* _fill_tbl;
   dbTable<_dbRegion>* _region_tbl;
@@ -234,7 +236,7 @@ class _dbBlock : public _dbObject
   dbTable<_dbGroup>* _group_tbl;
   dbTable<_dbAccessPoint>* ap_tbl_;
   dbTable<_dbGlobalConnect>* global_connect_tbl_;
-  dbTable<_dbGuide>* _guide_tbl;
+  dbDeferredTable<_dbGuide>* _guide_tbl;
   dbTable<_dbNetTrack>* _net_tracks_tbl;
   _dbNameCache* _name_cache;
   dbTable<_dbDft>* _dft_tbl;
@@ -248,9 +250,9 @@ class _dbBlock : public _dbObject
   dbTable<_dbModNet>* _modnet_tbl;
   dbTable<_dbBusPort>* _busport_tbl;
 
-  dbTable<_dbCapNode>* _cap_node_tbl;
-  dbTable<_dbRSeg>* _r_seg_tbl;
-  dbTable<_dbCCSeg>* _cc_seg_tbl;
+  dbDeferredTable<_dbCapNode>* _cap_node_tbl;
+  dbDeferredTable<_dbRSeg>* _r_seg_tbl;
+  dbDeferredTable<_dbCCSeg>* _cc_seg_tbl;
   dbExtControl* _extControl;
 
   // NON-PERSISTANT-NON-STREAMED-MEMBERS
@@ -313,6 +315,9 @@ class _dbBlock : public _dbObject
   void differences(dbDiff& diff, const char* field, const _dbBlock& rhs) const;
   void out(dbDiff& diff, char side, const char* field) const;
 
+  // Parse the tables a mapped file left unparsed (see dbDeferredTable).
+  void loadDeferredTables() const;
+
   int globalConnect(const std::vector<dbGlobalConnect*>& connects);
   _dbTech* getTech();
 
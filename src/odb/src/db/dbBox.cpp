@@ -850,6 +850,9 @@ dbBox* dbBox::create(dbBPin* bpin_,
   bpin->_boxes = box->getOID();
 
   block->add_rect(box->_shape._rect);
+  for (auto callback : block->_callbacks) {
+    callback->inDbBPinAddBox(dbbox);
+  }
   return (dbBox*) box;
 }
 
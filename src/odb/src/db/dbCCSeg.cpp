@@ -45,6 +45,7 @@
 namespace odb {
 
 template class dbTable<_dbCCSeg>;
+template class dbDeferredTable<_dbCCSeg>;
 
 bool _dbCCSeg::operator==(const _dbCCSeg& rhs) const
 {
@@ -39,14 +39,14 @@ namespace odb {
 
 class _dbCCSeg;
 template <class T>
-class dbTable;
+class dbDeferredTable;
 
 class dbCCSegItr : public dbIterator
 {
-  dbTable<_dbCCSeg>* _seg_tbl;
+  dbDeferredTable<_dbCCSeg>* _seg_tbl;
 
  public:
-  dbCCSegItr(dbTable<_dbCCSeg>* seg_tbl) { _seg_tbl = seg_tbl; }
+  dbCCSegItr(dbDeferredTable<_dbCCSeg>* seg_tbl) { _seg_tbl = seg_tbl; }
 
   bool reversible();
   bool orderReversed();
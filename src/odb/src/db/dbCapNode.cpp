@@ -49,6 +49,7 @@ namespace odb {
 double getExtCCmult(dbNet* aggressor);
 
 template class dbTable<_dbCapNode>;
+template class dbDeferredTable<_dbCapNode>;
 
 bool _dbCapNode::operator==(const _dbCapNode& rhs) const
 {
@@ -39,14 +39,14 @@ namespace odb {
 
 class _dbCapNode;
 template <class T>
-class dbTable;
+class dbDeferredTable;
 
 class dbCapNodeItr : public dbIterator
 {
-  dbTable<_dbCapNode>* _seg_tbl;
+  dbDeferredTable<_dbCapNode>* _seg_tbl;
 
  public:
-  dbCapNodeItr(dbTable<_dbCapNode>* seg_tbl) { _seg_tbl = seg_tbl; }
+  dbCapNodeItr(dbDeferredTable<_dbCapNode>* seg_tbl) { _seg_tbl = seg_tbl; }
 
   bool reversible();
   bool orderReversed();
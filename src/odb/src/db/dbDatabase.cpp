@@ -35,6 +35,7 @@
 #include <algorithm>
 #include <fstream>
 #include <map>
+#include <memory>
 #include <string>
 
 #include "dbArrayTable.h"
@@ -46,6 +47,7 @@
 #include "dbITerm.h"
 #include "dbJournal.h"
 #include "dbLib.h"
+#include "dbMappedFile.h"
 #include "dbNameCache.h"
 #include "dbNet.h"
 #include "dbProperty.h"
@@ -502,17 +504,32 @@ dbTech* dbDatabase::getTech()
       utl::ODB, 432, "getTech() is obsolete in a multi-tech db");
 }
 
-void dbDatabase::read(std::istream& file)
+void dbDatabase::read(std::istream& file, int num_threads)
 {
   _dbDatabase* db = (_dbDatabase*) this;
   dbIStream stream(db, file);
+  stream.setThreads(num_threads);
   stream >> *db;
 }
 
-void dbDatabase::write(std::ostream& file)
+void dbDatabase::readMapped(const char* filename, int num_threads)
+{
+  _dbDatabase* db = (_dbDatabase*) this;
+  auto file = std::make_shared<dbMappedFile>(filename);
+  dbMemoryBuf buffer(file->data(), file->size());
+  std::istream in(&buffer);
+  in.exceptions(std::ios::failbit | std::ios::badbit | std::ios::eofbit);
+  dbIStream stream(db, in);
+  stream.setStorage(file, file->data(), file->size());
+  stream.setThreads(num_threads);
+  stream >> *db;
+}
+
+void dbDatabase::write(std::ostream& file, int num_threads)
 {
   _dbDatabase* db = (_dbDatabase*) this;
   dbOStream stream(db, file);
+  stream.setThreads(num_threads);
   stream << *db;
   file.flush();
 }
@@ -70,7 +70,15 @@ namespace odb {
 const uint db_schema_major = 0;  // Not used...
 const uint db_schema_initial = 57;
 
-const uint db_schema_minor = 89;  // Current revision number
+const uint db_schema_minor = 91;  // Current revision number
+
+// Revision where table sections were compressed and checksummed and the
+// block netlist tables were written as sections
+const uint db_schema_section_checksums = 91;
+
+// Revision where the block wire, guide and parasitic tables were written as
+// length-prefixed sections that can be parsed on first access
+const uint db_schema_deferred_tables = 90;
 
 // Revision where blocked regions for IO pins were added to dbBlock
 const uint db_schema_dbblock_blocked_regions_for_pins = 89;
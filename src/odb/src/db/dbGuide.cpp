@@ -46,6 +46,7 @@
 // User Code End Includes
 namespace odb {
 template class dbTable<_dbGuide>;
+template class dbDeferredTable<_dbGuide>;
 
 bool _dbGuide::operator==(const _dbGuide& rhs) const
 {
@@ -40,12 +40,12 @@ namespace odb {
 class _dbGuide;
 
 template <class T>
-class dbTable;
+class dbDeferredTable;
 
 class dbGuideItr : public dbIterator
 {
  public:
-  dbGuideItr(dbTable<_dbGuide>* guide_tbl) { _guide_tbl = guide_tbl; }
+  dbGuideItr(dbDeferredTable<_dbGuide>* guide_tbl) { _guide_tbl = guide_tbl; }
 
   bool reversible() override;
   bool orderReversed() override;
@@ -58,7 +58,7 @@ class dbGuideItr : public dbIterator
   dbObject* getObject(uint id, ...) override;
 
  private:
-  dbTable<_dbGuide>* _guide_tbl;
+  dbDeferredTable<_dbGuide>* _guide_tbl;
 };
 
 }  // namespace odb
@@ -0,0 +1,118 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "dbMappedFile.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+#include "odb/ZException.h"
+
+namespace odb {
+
+dbMappedFile::dbMappedFile(const char* filename)
+{
+  const int fd = open(filename, O_RDONLY);
+  if (fd < 0) {
+    throw ZException("cannot open %s: %s", filename, strerror(errno));
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    const int err = errno;
+    close(fd);
+    throw ZException("cannot stat %s: %s", filename, strerror(err));
+  }
+
+  size_ = st.st_size;
+  if (size_ > 0) {
+    void* addr = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (addr == MAP_FAILED) {
+      const int err = errno;
+      close(fd);
+      throw ZException("cannot map %s: %s", filename, strerror(err));
+    }
+    data_ = static_cast<const char*>(addr);
+  }
+
+  // The mapping stays valid after the descriptor is closed.
+  close(fd);
+}
+
+dbMappedFile::~dbMappedFile()
+{
+  if (data_) {
+    munmap(const_cast<char*>(data_), size_);
+  }
+}
+
+dbMemoryBuf::dbMemoryBuf(const char* data, uint64_t size)
+{
+  char* begin = const_cast<char*>(data);
+  setg(begin, begin, begin + size);
+}
+
+dbMemoryBuf::pos_type dbMemoryBuf::seekoff(off_type off,
+                                           std::ios_base::seekdir dir,
+                                           std::ios_base::openmode which)
+{
+  if (!(which & std::ios_base::in)) {
+    return pos_type(off_type(-1));
+  }
+
+  off_type pos = off;
+  if (dir == std::ios_base::cur) {
+    pos += gptr() - eback();
+  } else if (dir == std::ios_base::end) {
+    pos += egptr() - eback();
+  }
+
+  if (pos < 0 || pos > egptr() - eback()) {
+    return pos_type(off_type(-1));
+  }
+
+  setg(eback(), eback() + pos, egptr());
+  return pos_type(pos);
+}
+
+dbMemoryBuf::pos_type dbMemoryBuf::seekpos(pos_type pos,
+                                           std::ios_base::openmode which)
+{
+  return seekoff(off_type(pos), std::ios_base::beg, which);
+}
+
+}  // namespace odb
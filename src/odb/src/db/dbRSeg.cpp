@@ -47,6 +47,7 @@
 namespace odb {
 
 template class dbTable<_dbRSeg>;
+template class dbDeferredTable<_dbRSeg>;
 
 bool _dbRSeg::operator==(const _dbRSeg& rhs) const
 {
@@ -39,14 +39,14 @@ namespace odb {
 
 class _dbRSeg;
 template <class T>
-class dbTable;
+class dbDeferredTable;
 
 class dbRSegItr : public dbIterator
 {
-  dbTable<_dbRSeg>* _seg_tbl;
+  dbDeferredTable<_dbRSeg>* _seg_tbl;
 
  public:
-  dbRSegItr(dbTable<_dbRSeg>* seg_tbl) { _seg_tbl = seg_tbl; }
+  dbRSegItr(dbDeferredTable<_dbRSeg>* seg_tbl) { _seg_tbl = seg_tbl; }
 
   bool reversible();
   bool orderReversed();
@@ -48,6 +48,7 @@
 namespace odb {
 
 template class dbTable<_dbSBox>;
+template class dbDeferredTable<_dbSBox>;
 
 bool _dbSBox::operator==(const _dbSBox& rhs) const
 {
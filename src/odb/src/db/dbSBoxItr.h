@@ -39,15 +39,15 @@ namespace odb {
 
 class _dbSBox;
 template <class T>
-class dbTable;
+class dbDeferredTable;
 
 class dbSBoxItr : public dbIterator
 {
  protected:
-  dbTable<_dbSBox>* _box_tbl;
+  dbDeferredTable<_dbSBox>* _box_tbl;
 
  public:
-  dbSBoxItr(dbTable<_dbSBox>* box_tbl) { _box_tbl = box_tbl; }
+  dbSBoxItr(dbDeferredTable<_dbSBox>* box_tbl) { _box_tbl = box_tbl; }
 
   bool reversible();
   bool orderReversed();
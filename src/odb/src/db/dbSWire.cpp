@@ -46,6 +46,7 @@
 namespace odb {
 
 template class dbTable<_dbSWire>;
+template class dbDeferredTable<_dbSWire>;
 
 bool _dbSWire::operator==(const _dbSWire& rhs) const
 {
@@ -39,14 +39,14 @@ namespace odb {
 
 class _dbSWire;
 template <class T>
-class dbTable;
+class dbDeferredTable;
 
 class dbSWireItr : public dbIterator
 {
-  dbTable<_dbSWire>* _swire_tbl;
+  dbDeferredTable<_dbSWire>* _swire_tbl;
 
  public:
-  dbSWireItr(dbTable<_dbSWire>* swire_tbl) { _swire_tbl = swire_tbl; }
+  dbSWireItr(dbDeferredTable<_dbSWire>* swire_tbl) { _swire_tbl = swire_tbl; }
 
   bool reversible();
   bool orderReversed();
@@ -32,8 +32,15 @@
 
 #include "odb/dbStream.h"
 
+#include <zlib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
 #include <iostream>
+#include <mutex>
 #include <sstream>
+#include <thread>
 
 #include "dbDatabase.h"
 #include "odb/db.h"
@@ -65,6 +72,237 @@ void dbOStream::popScope()
   _scopes.pop_back();
 }
 
+// Sections smaller than this are not worth compressing.
+static constexpr uint64_t kMinCompressSize = 4096;
+
+static dbStreamSection makeSection(
+    _dbDatabase* db,
+    const std::function<void(dbOStream&)>& write_section)
+{
+  std::ostringstream buffer(std::ios::binary);
+  dbOStream stream(db, buffer);
+  write_section(stream);
+  auto bytes = std::make_shared<std::string>(buffer.str());
+
+  dbStreamSection section;
+  section.raw_size = bytes->size();
+
+  if (bytes->size() >= kMinCompressSize) {
+    uLongf size = compressBound(bytes->size());
+    auto compressed = std::make_shared<std::string>(size, '\0');
+    const int status = compress2((Bytef*) compressed->data(),
+                                 &size,
+                                 (const Bytef*) bytes->data(),
+                                 bytes->size(),
+                                 Z_BEST_SPEED);
+    if (status == Z_OK && size < bytes->size()) {
+      compressed->resize(size);
+      bytes = std::move(compressed);
+      section.compressed = true;
+    }
+  }
+
+  section.data = bytes->data();
+  section.size = bytes->size();
+  section.checksum = crc32_z(0, (const Bytef*) section.data, section.size);
+  section.has_checksum = true;
+  section.owner = std::move(bytes);
+  return section;
+}
+
+void dbRunJobs(const std::vector<std::function<void()>>& jobs,
+               int num_threads)
+{
+  const int threads
+      = std::min(std::max(num_threads, 1), static_cast<int>(jobs.size()));
+  if (threads <= 1) {
+    for (const auto& job : jobs) {
+      job();
+    }
+    return;
+  }
+
+  std::atomic<size_t> next_job{0};
+  std::exception_ptr error;
+  std::mutex error_mutex;
+  auto worker = [&]() {
+    for (size_t i = next_job++; i < jobs.size(); i = next_job++) {
+      try {
+        jobs[i]();
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(error_mutex);
+        if (!error) {
+          error = std::current_exception();
+        }
+      }
+    }
+  };
+
+  std::vector<std::thread> workers;
+  workers.reserve(threads - 1);
+  for (int i = 1; i < threads; ++i) {
+    workers.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : workers) {
+    thread.join();
+  }
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+std::string dbGzipCompress(const char* data, size_t size)
+{
+  z_stream stream{};
+  // 16 added to the window bits selects the gzip wrapper
+  if (deflateInit2(&stream,
+                   Z_BEST_SPEED,
+                   Z_DEFLATED,
+                   MAX_WBITS + 16,
+                   8,
+                   Z_DEFAULT_STRATEGY)
+      != Z_OK) {
+    throw ZException("Unable to initialize gzip compression");
+  }
+
+  constexpr size_t kChunk = 1 << 20;
+  std::string result;
+  result.reserve(size / 4 + 64);
+  int flush;
+  do {
+    const size_t in = std::min<size_t>(size, kChunk);
+    stream.next_in = (Bytef*) data;
+    stream.avail_in = in;
+    data += in;
+    size -= in;
+    flush = size == 0 ? Z_FINISH : Z_NO_FLUSH;
+    do {
+      const size_t used = result.size();
+      result.resize(used + kChunk);
+      stream.next_out = (Bytef*) result.data() + used;
+      stream.avail_out = kChunk;
+      deflate(&stream, flush);
+      result.resize(used + kChunk - stream.avail_out);
+    } while (stream.avail_out == 0);
+  } while (flush != Z_FINISH);
+
+  deflateEnd(&stream);
+  return result;
+}
+
+void dbOStream::prepareSections(const std::vector<SectionJob>& jobs)
+{
+  if (_threads <= 1) {
+    // Nothing to gain; build each section when it is written.
+    return;
+  }
+
+  std::vector<dbStreamSection> sections(jobs.size());
+  std::vector<std::function<void()>> tasks;
+  tasks.reserve(jobs.size());
+  for (size_t i = 0; i < jobs.size(); ++i) {
+    tasks.emplace_back(
+        [&, i]() { sections[i] = makeSection(_db, jobs[i].second); });
+  }
+  dbRunJobs(tasks, _threads);
+
+  for (size_t i = 0; i < jobs.size(); ++i) {
+    _prepared[jobs[i].first] = std::move(sections[i]);
+  }
+}
+
+void dbOStream::writeSection(
+    const void* key,
+    const std::function<void(dbOStream&)>& write_section)
+{
+  auto it = _prepared.find(key);
+  if (it != _prepared.end()) {
+    writeSection(it->second);
+    _prepared.erase(it);
+    return;
+  }
+
+  writeSection(makeSection(_db, write_section));
+}
+
+void dbOStream::writeSection(const dbStreamSection& section)
+{
+  *this << section.size;
+  *this << section.raw_size;
+  *this << section.checksum;
+  *this << section.compressed;
+  writeBytes(section.data, section.size);
+}
+
+void dbIStream::setStorage(std::shared_ptr<const void> owner,
+                           const char* data,
+                           uint64_t size)
+{
+  _storage_owner = std::move(owner);
+  _storage_data = data;
+  _storage_size = size;
+}
+
+bool dbIStream::canDeferSections() const
+{
+  return _storage_data != nullptr && !_db->isLessThanSchema(db_schema_minor);
+}
+
+dbStreamSection dbIStream::readSection()
+{
+  dbStreamSection section;
+  *this >> section.size;
+  if (_db->isSchema(db_schema_section_checksums)) {
+    *this >> section.raw_size;
+    *this >> section.checksum;
+    *this >> section.compressed;
+    section.has_checksum = true;
+  } else {
+    section.raw_size = section.size;
+  }
+
+  if (_storage_data) {
+    const uint64_t offset = _f.tellg();
+    if (offset + section.size > _storage_size) {
+      throw ZException("database section extends past the end of the file");
+    }
+    section.owner = _storage_owner;
+    section.data = _storage_data + offset;
+    _f.seekg(section.size, std::ios::cur);
+    return section;
+  }
+
+  auto bytes = std::make_shared<std::string>(section.size, '\0');
+  _f.read(bytes->data(), section.size);
+  section.data = bytes->data();
+  section.owner = std::move(bytes);
+  return section;
+}
+
+std::pair<const char*, uint64_t> dbStreamSection::decode(
+    std::string& buffer) const
+{
+  if (has_checksum && crc32_z(0, (const Bytef*) data, size) != checksum) {
+    throw ZException("database section checksum mismatch, the file is corrupt");
+  }
+
+  if (!compressed) {
+    return {data, size};
+  }
+
+  buffer.resize(raw_size);
+  uLongf length = raw_size;
+  const int status = uncompress(
+      (Bytef*) buffer.data(), &length, (const Bytef*) data, size);
+  if (status != Z_OK || length != raw_size) {
+    throw ZException("database section can't be uncompressed, the file is "
+                     "corrupt");
+  }
+  return {buffer.data(), raw_size};
+}
+
 dbOStream& operator<<(dbOStream& stream, const Rect& r)
 {
   stream << r.xlo_;
@@ -32,12 +32,15 @@
 
 #pragma once
 
+#include <atomic>
+#include <mutex>
 #include <vector>
 
 #include "dbCore.h"
 #include "dbVector.h"
 #include "odb/ZException.h"
 #include "odb/dbIterator.h"
+#include "odb/dbStream.h"
 #include "odb/odb.h"
 
 namespace odb {
@@ -68,6 +71,10 @@ class dbTable : public dbObjectTable, public dbIterator
   // NON-PERSISTANT-DATA
   dbTablePage** _pages;  // page-table
 
+  // Unparsed contents of a table read with readSection until loadSection
+  // builds the pages from it.
+  dbStreamSection _section;
+
   void resizePageTbl();
   void newPage();
   void pushQ(uint& Q, _dbFreeObject* e);
@@ -154,6 +161,17 @@ class dbTable : public dbObjectTable, public dbIterator
   void readPage(dbIStream& stream, dbTablePage* page);
   void writePage(dbOStream& stream, const dbTablePage* page) const;
 
+  // Read/write the table as a separate section (see dbOStream::writeSection).
+  // The section read is kept unparsed until loadSection is called, so that
+  // several tables can be parsed in parallel.
+  void readSection(dbIStream& stream);
+  void writeSection(dbOStream& stream) const;
+  void loadSection();
+
+  // Add a job to build this table's section in parallel with others
+  // (see dbOStream::prepareSections).
+  void addSectionJob(std::vector<dbOStream::SectionJob>& jobs) const;
+
   bool operator==(const dbTable<T>& rhs) const;
   bool operator!=(const dbTable<T>& table) const;
   void differences(dbDiff& diff, const dbTable<T>& rhs) const;
@@ -197,4 +215,98 @@ struct NamedTable
 template <class T>
 dbOStream& operator<<(dbOStream& stream, const NamedTable<T>& named_table);
 
+// A table that a mapped file leaves unparsed until it is first used
+// (wires, parasitics, ...).  Only the accessors declared here load the
+// table, so it must be used through this type rather than dbTable<T>.
+template <class T>
+class dbDeferredTable : public dbTable<T>
+{
+ public:
+  dbDeferredTable(_dbDatabase* db,
+                  dbObject* owner,
+                  dbObjectTable* (dbObject::*m)(dbObjectType),
+                  dbObjectType type,
+                  uint page_size = 128,
+                  uint page_shift = 7)
+      : dbTable<T>(db, owner, m, type, page_size, page_shift)
+  {
+  }
+
+  dbDeferredTable(_dbDatabase* db, dbObject* owner, const dbDeferredTable<T>& t)
+      : dbTable<T>(db, owner, t.loaded())
+  {
+  }
+
+  uint size() const { return loaded().dbTable<T>::size(); }
+  T* create() { return loaded().dbTable<T>::create(); }
+  T* duplicate(T* c) { return loaded().dbTable<T>::duplicate(c); }
+  void clear();
+  T* getPtr(dbId<T> id) const { return loaded().dbTable<T>::getPtr(id); }
+  bool validId(dbId<T> id) const
+  {
+    return loaded().dbTable<T>::validId(id);
+  }
+  void getObjects(std::vector<T*>& objects)
+  {
+    loaded().dbTable<T>::getObjects(objects);
+  }
+
+  // The section read is parsed on first access.  A table that was never
+  // accessed is written back unchanged.
+  void readSection(dbIStream& stream);
+  void writeSection(dbOStream& stream) const;
+  void addSectionJob(std::vector<dbOStream::SectionJob>& jobs) const;
+
+  // Parse the table if it is still deferred.  Safe to call from several
+  // threads.
+  void ensureLoaded() const
+  {
+    if (_is_deferred.load(std::memory_order_acquire)) {
+      loadDeferred();
+    }
+  }
+
+  // dbIterator interface methods
+  uint sequential() override { return loaded().dbTable<T>::sequential(); }
+  uint size(dbObject* parent) override
+  {
+    return loaded().dbTable<T>::size(parent);
+  }
+  uint begin(dbObject* parent) override
+  {
+    return loaded().dbTable<T>::begin(parent);
+  }
+  dbObject* getObject(uint id, ...) override
+  {
+    return loaded().dbTable<T>::getPtr(id);
+  }
+
+ private:
+  dbDeferredTable<T>& loaded() const
+  {
+    ensureLoaded();
+    return const_cast<dbDeferredTable<T>&>(*this);
+  }
+  void loadDeferred() const;
+  static std::mutex& deferredMutex();
+
+  std::atomic<bool> _is_deferred{false};
+};
+
+// Used for large tables so that they are written as separate compressed
+// sections that can be built and parsed in parallel.
+template <class Table>
+struct TableSection
+{
+  TableSection(const char* name, Table* table) : name(name), table(table) {}
+  const char* name;
+  Table* table;
+};
+
+template <class Table>
+dbOStream& operator<<(dbOStream& stream, const TableSection<Table>& section);
+
+template <class Table>
+dbIStream& operator>>(dbIStream& stream, const TableSection<Table>& section);
+
 }  // namespace odb
@@ -33,9 +33,12 @@
 #pragma once
 
 #include <cstring>
+#include <istream>
+#include <mutex>
 #include <new>
 
 #include "dbDatabase.h"
+#include "dbMappedFile.h"
 #include "dbTable.h"
 #include "odb/ZException.h"
 #include "odb/dbDiff.h"
@@ -101,6 +104,8 @@ inline void dbTable<T>::unlinkQ(uint& Q, _dbFreeObject* e)
 template <class T>
 void dbTable<T>::clear()
 {
+  _section = dbStreamSection();
+
   uint i;
   for (i = 0; i < _page_cnt; ++i) {
     dbTablePage* page = _pages[i];
@@ -149,17 +154,17 @@ dbTable<T>::dbTable(_dbDatabase* db,
 
 template <class T>
 dbTable<T>::dbTable(_dbDatabase* db, dbObject* owner, const dbTable<T>& t)
-    : dbObjectTable(db, owner, t._getObjectTable, t._type, sizeof(T)),
-      _page_mask(t._page_mask),
-      _page_shift(t._page_shift),
-      _top_idx(t._top_idx),
-      _bottom_idx(t._bottom_idx),
-      _page_cnt(t._page_cnt),
-      _page_tbl_size(t._page_tbl_size),
-      _alloc_cnt(t._alloc_cnt),
-      _free_list(t._free_list),
-      _pages(nullptr)
-{
+    : dbObjectTable(db, owner, t._getObjectTable, t._type, sizeof(T))
+{
+  _page_mask = t._page_mask;
+  _page_shift = t._page_shift;
+  _top_idx = t._top_idx;
+  _bottom_idx = t._bottom_idx;
+  _page_cnt = t._page_cnt;
+  _page_tbl_size = t._page_tbl_size;
+  _alloc_cnt = t._alloc_cnt;
+  _free_list = t._free_list;
+  _pages = nullptr;
   copy_pages(t);
 }
 
@@ -634,6 +639,116 @@ dbOStream& operator<<(dbOStream& stream, const NamedTable<T>& named_table)
   return stream;
 }
 
+template <class T>
+void dbTable<T>::readSection(dbIStream& stream)
+{
+  clear();
+  _section = stream.readSection();
+}
+
+template <class T>
+void dbTable<T>::writeSection(dbOStream& stream) const
+{
+  stream.writeSection(this, [this](dbOStream& out) { out << *this; });
+}
+
+template <class T>
+void dbTable<T>::loadSection()
+{
+  const dbStreamSection section = std::move(_section);
+  _section = dbStreamSection();
+  if (!section.data) {
+    return;
+  }
+
+  std::string uncompressed;
+  const auto [data, size] = section.decode(uncompressed);
+  dbMemoryBuf buffer(data, size);
+  std::istream in(&buffer);
+  in.exceptions(std::ios::failbit | std::ios::badbit | std::ios::eofbit);
+  dbIStream stream(_db, in);
+  stream >> *this;
+}
+
+template <class T>
+void dbTable<T>::addSectionJob(std::vector<dbOStream::SectionJob>& jobs) const
+{
+  jobs.emplace_back(this, [this](dbOStream& out) { out << *this; });
+}
+
+template <class T>
+void dbDeferredTable<T>::clear()
+{
+  _is_deferred.store(false, std::memory_order_release);
+  dbTable<T>::clear();
+}
+
+template <class T>
+void dbDeferredTable<T>::readSection(dbIStream& stream)
+{
+  dbTable<T>::readSection(stream);
+  _is_deferred.store(true, std::memory_order_release);
+}
+
+template <class T>
+void dbDeferredTable<T>::writeSection(dbOStream& stream) const
+{
+  {
+    std::lock_guard<std::mutex> lock(deferredMutex());
+    if (_is_deferred.load(std::memory_order_relaxed)
+        && this->_section.data) {
+      stream.writeSection(this->_section);
+      return;
+    }
+  }
+
+  dbTable<T>::writeSection(stream);
+}
+
+template <class T>
+void dbDeferredTable<T>::addSectionJob(
+    std::vector<dbOStream::SectionJob>& jobs) const
+{
+  if (!_is_deferred.load(std::memory_order_acquire)) {
+    dbTable<T>::addSectionJob(jobs);
+  }
+}
+
+template <class T>
+std::mutex& dbDeferredTable<T>::deferredMutex()
+{
+  static std::mutex mutex;
+  return mutex;
+}
+
+template <class T>
+void dbDeferredTable<T>::loadDeferred() const
+{
+  std::lock_guard<std::mutex> lock(deferredMutex());
+  if (!_is_deferred.load(std::memory_order_relaxed)) {
+    return;  // another thread got here first
+  }
+
+  dbDeferredTable<T>* table = const_cast<dbDeferredTable<T>*>(this);
+  table->loadSection();
+  table->_is_deferred.store(false, std::memory_order_release);
+}
+
+template <class Table>
+dbOStream& operator<<(dbOStream& stream, const TableSection<Table>& section)
+{
+  dbOStreamScope scope(stream, section.name);
+  section.table->writeSection(stream);
+  return stream;
+}
+
+template <class Table>
+dbIStream& operator>>(dbIStream& stream, const TableSection<Table>& section)
+{
+  section.table->readSection(stream);
+  return stream;
+}
+
 template <class T>
 dbOStream& operator<<(dbOStream& stream, const dbTable<T>& table)
 {
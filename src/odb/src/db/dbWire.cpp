@@ -48,6 +48,7 @@
 namespace odb {
 
 template class dbTable<_dbWire>;
+template class dbDeferredTable<_dbWire>;
 static void set_symmetric_diff(dbDiff& diff,
                                std::vector<dbShape*>& lhs,
                                std::vector<dbShape*>& rhs);
@@ -1147,6 +1147,41 @@ int defrRead(FILE* f, const char* fName, defiUserData uData, int case_sensitive)
   return status;
 }
 
+int defrReadWithContext(FILE* f,
+                        const char* fName,
+                        defiUserData uData,
+                        int case_sensitive,
+                        const defrCallbacks* callbacks,
+                        const defrSettings* settings,
+                        int firstLine)
+{
+  defrSession session;
+  defrData defData(callbacks, settings, &session);
+  defData.nlines = firstLine;
+
+  if (settings->reader_case_sensitive_set) {
+    defData.names_case_sensitive = session.reader_case_sensitive;
+  } else if (defData.VersionNum > 5.5) {
+    defData.names_case_sensitive = true;
+  }
+
+  session.FileName = (char*) fName;
+  defData.File = f;
+  session.UserData = uData;
+  session.reader_case_sensitive = case_sensitive;
+
+  defData.NeedPathData
+      = (((callbacks->NetCbk || callbacks->SNetCbk) && settings->AddPathToNet)
+         || callbacks->PathCbk)
+            ? 1
+            : 0;
+  if (defData.NeedPathData) {
+    defData.PathObj.Init();
+  }
+
+  return defyyparse(&defData);
+}
+
 void defrSetUserData(defiUserData ud)
 {
   DEF_INIT;
@@ -379,6 +379,22 @@ extern int defrRead(FILE* file,
                     defiUserData userData,
                     int case_sensitive);
 
+class defrCallbacks;
+class defrSettings;
+
+// Reentrant variant of defrRead.  The callbacks and settings are passed in
+// instead of being taken from the global reader, and the session is private
+// to the call, so several files can be read concurrently on different
+// threads provided the callbacks are thread safe.  Messages number the
+// first line of the file firstLine, for a file cut out of a larger one.
+extern int defrReadWithContext(FILE* file,
+                               const char* fileName,
+                               defiUserData userData,
+                               int case_sensitive,
+                               const defrCallbacks* callbacks,
+                               const defrSettings* settings,
+                               int firstLine = 1);
+
 // Set/get the client-provided user data.  defi doesn't look at
 // this data at all, it simply passes the opaque defiUserData pointer
 // back to the application with each callback.  The client can
@@ -82,6 +82,11 @@ void defin::continueOnErrors()
   _reader->continueOnErrors();
 }
 
+void defin::setThreads(int threads)
+{
+  _reader->setThreads(threads);
+}
+
 void defin::namesAreDBIDs()
 {
   _reader->namesAreDBIDs();
@@ -0,0 +1,151 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "definChunkParser.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <system_error>
+
+namespace odb {
+
+definChunkParser::definChunkParser(const definSectionIndex& index,
+                                   const char* file_name,
+                                   const defrCallbacks* callbacks,
+                                   const defrSettings* settings,
+                                   bool continue_on_errors,
+                                   int threads)
+    : index_(index),
+      file_name_(file_name),
+      callbacks_(callbacks),
+      settings_(settings),
+      continue_on_errors_(continue_on_errors),
+      window_(2 * std::max(threads, 1)),
+      results_(index.chunks().size())
+{
+  // The main thread is busy parsing the rest of the file and committing.
+  const int num_workers = std::max(threads - 1, 1);
+  workers_.reserve(num_workers);
+  for (int i = 0; i < num_workers; ++i) {
+    workers_.emplace_back(&definChunkParser::work, this);
+  }
+}
+
+definChunkParser::~definChunkParser()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  window_cv_.notify_all();
+  for (std::thread& worker : workers_) {
+    worker.join();
+  }
+}
+
+void definChunkParser::work()
+{
+  const size_t num_chunks = index_.chunks().size();
+  for (;;) {
+    size_t chunk_index;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      window_cv_.wait(lock, [&] {
+        return stop_ || next_chunk_ >= num_chunks
+               || next_chunk_ < committed_ + window_;
+      });
+      if (stop_ || next_chunk_ >= num_chunks) {
+        return;
+      }
+      chunk_index = next_chunk_++;
+    }
+
+    auto result = std::make_unique<Result>(continue_on_errors_);
+    try {
+      parse(chunk_index, *result);
+    } catch (...) {
+      result->exception = std::current_exception();
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      results_[chunk_index] = std::move(result);
+    }
+    ready_cv_.notify_all();
+  }
+}
+
+void definChunkParser::parse(size_t chunk_index, Result& result) const
+{
+  const definSectionIndex::Chunk& chunk = index_.chunks()[chunk_index];
+  std::string text = index_.chunkText(chunk);
+
+  FILE* file = fmemopen(text.data(), text.size(), "r");
+  if (file == nullptr) {
+    throw std::system_error(errno, std::generic_category(), "fmemopen");
+  }
+
+  result.status = defrReadWithContext(file,
+                                      file_name_.c_str(),
+                                      (defiUserData) &result,
+                                      /* case sensitive */ 1,
+                                      callbacks_,
+                                      settings_,
+                                      index_.firstLine(chunk));
+  fclose(file);
+}
+
+bool definChunkParser::commit(definSectionIndex::Section section,
+                              const CommitFn& commit)
+{
+  const std::vector<definSectionIndex::Chunk>& chunks = index_.chunks();
+  while (committed_ < chunks.size() && chunks[committed_].section == section) {
+    std::unique_ptr<Result> result;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      ready_cv_.wait(lock, [&] { return results_[committed_] != nullptr; });
+      result = std::move(results_[committed_]);
+      ++committed_;
+    }
+    window_cv_.notify_all();
+
+    if (result->exception) {
+      std::rethrow_exception(result->exception);
+    }
+    if (!commit(chunks[committed_ - 1], *result) || result->status != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace odb
@@ -0,0 +1,117 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "defrReader.hpp"
+#include "definRecorder.h"
+#include "definSectionIndex.h"
+
+namespace odb {
+
+// Parses the chunks of a definSectionIndex on worker threads while the main
+// thread parses the rest of the file.  The workers only run a bounded
+// window of chunks ahead of the next one to be committed so the memory held
+// in recordings stays proportional to the thread count.
+class definChunkParser
+{
+ public:
+  // Everything produced by parsing one chunk.  The parser callbacks get a
+  // pointer to it as their user data.
+  struct Result
+  {
+    explicit Result(bool continue_on_errors)
+        : components(continue_on_errors),
+          nets(continue_on_errors),
+          snets(continue_on_errors)
+    {
+    }
+
+    definComponentRecorder components;
+    definNetRecorder nets;
+    definSNetRecorder snets;
+    int items = 0;   // items parsed
+    int status = 0;  // return value of the parser
+    std::exception_ptr exception;
+  };
+
+  using CommitFn = std::function<bool(const definSectionIndex::Chunk& chunk,
+                                      const Result& result)>;
+
+  definChunkParser(const definSectionIndex& index,
+                   const char* file_name,
+                   const defrCallbacks* callbacks,
+                   const defrSettings* settings,
+                   bool continue_on_errors,
+                   int threads);
+  ~definChunkParser();
+
+  // Waits for each chunk of the section in file order and hands it to
+  // commit.  Returns false as soon as commit does or a chunk failed to
+  // parse.  Exceptions raised on the workers are rethrown here.
+  bool commit(definSectionIndex::Section section, const CommitFn& commit);
+
+  // True once every chunk has been committed.
+  bool done() const { return committed_ == index_.chunks().size(); }
+
+ private:
+  void work();
+  void parse(size_t chunk_index, Result& result) const;
+
+  const definSectionIndex& index_;
+  const std::string file_name_;
+  const defrCallbacks* callbacks_;
+  const defrSettings* settings_;
+  const bool continue_on_errors_;
+  const size_t window_;
+
+  std::mutex mutex_;
+  std::condition_variable window_cv_;  // signaled when committed_ moves
+  std::condition_variable ready_cv_;   // signaled when a result is stored
+  size_t next_chunk_ = 0;              // next chunk to hand to a worker
+  size_t committed_ = 0;               // chunks before this are committed
+  bool stop_ = false;
+  std::vector<std::unique_ptr<Result>> results_;
+  std::vector<std::thread> workers_;
+};
+
+}  // namespace odb
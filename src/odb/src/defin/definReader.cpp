@@ -32,13 +32,21 @@
 
 #include "definReader.h"
 
+#include <zlib.h>
+
 #include <cctype>
 #include <cstdio>
 #include <cstdlib>
+#include <filesystem>
 #include <iostream>
+#include <memory>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 
+#include "../db/dbMappedFile.h"
 #include "definBlockage.h"
+#include "definChunkParser.h"
 #include "definComponent.h"
 #include "definComponentMaskShift.h"
 #include "definFill.h"
@@ -54,6 +62,8 @@
 #include "definSNet.h"
 #include "definTracks.h"
 #include "definVia.h"
+#include "defrCallBacks.hpp"
+#include "defrSettings.hpp"
 #include "defzlib.hpp"
 #include "odb/db.h"
 #include "odb/dbShape.h"
@@ -61,7 +71,7 @@
 
 #define UNSUPPORTED(msg)              \
   reader->error((msg));               \
-  if (!reader->_continue_on_errors) { \
+  if (!reader->continuesOnErrors()) { \
     return PARSE_ERROR;               \
   }
 
@@ -169,6 +179,31 @@ void populateScanInst(definReader* reader,
   scan_inst->setBits(calculateBitsForCellInScandef(bits, inst));
 }
 
+// Reads a whole gzipped file into memory.
+bool readGzipFile(const char* file, std::string& text)
+{
+  std::error_code ec;
+  const auto size = std::filesystem::file_size(file, ec);
+  if (ec) {
+    return false;
+  }
+  gzFile f = gzopen(file, "rb");
+  if (f == nullptr) {
+    return false;
+  }
+  // The size of an uncompressed file, a lower bound for a compressed one.
+  text.reserve(size);
+  constexpr int buffer_size = 1 << 20;
+  gzbuffer(f, buffer_size);
+  std::vector<char> buffer(buffer_size);
+  int count;
+  while ((count = gzread(f, buffer.data(), buffer_size)) > 0) {
+    text.append(buffer.data(), count);
+  }
+  gzclose(f);
+  return count == 0;
+}
+
 }  // namespace
 
 definReader::definReader(dbDatabase* db, utl::Logger* logger, defin::MODE mode)
@@ -176,6 +211,8 @@ definReader::definReader(dbDatabase* db, utl::Logger* logger, defin::MODE mode)
   _db = db;
   parent_ = nullptr;
   _continue_on_errors = false;
+  _threads = 1;
+  _chunk_parser = nullptr;
   hier_delimeter_ = 0;
   left_bus_delimeter_ = 0;
   right_bus_delimeter_ = 0;
@@ -284,6 +321,11 @@ void definReader::continueOnErrors()
   _continue_on_errors = true;
 }
 
+void definReader::setThreads(int threads)
+{
+  _threads = threads;
+}
+
 void definReader::replaceWires()
 {
   _netR->replaceWires();
@@ -356,22 +398,425 @@ static void handle_props(DEF_TYPE* def_obj, CALLBACK* callback)
         break;
     }
   }
-}
+}
+
+static std::string renameBlock(dbBlock* parent, const char* old_name)
+{
+  int cnt = 1;
+
+  for (;; ++cnt) {
+    char n[16];
+    snprintf(n, 15, "_%d", cnt);
+    std::string name(old_name);
+    name += n;
+
+    if (!parent->findChild(name.c_str())) {
+      return name;
+    }
+  }
+}
+
+// The translations from the parser objects to the component, net and
+// special net interfaces are templates so that they can feed either the
+// database directly or a definRecorder on a worker thread.  READER only
+// needs error() and continuesOnErrors().
+template <typename READER, typename COMPONENT>
+static int translateComponent(READER* reader,
+                              defiComponent* comp,
+                              COMPONENT* componentR)
+{
+  if (comp->hasEEQ()) {
+    UNSUPPORTED("EEQMASTER on component is unsupported");
+  }
+
+  if (comp->maskShiftSize() > 0) {
+    UNSUPPORTED("MASKSHIFT on component is unsupported");
+  }
+
+  if (comp->hasRouteHalo() > 0) {
+    UNSUPPORTED("ROUTEHALO on component is unsupported");
+  }
+
+  componentR->begin(comp->id(), comp->name());
+  if (comp->hasSource()) {
+    componentR->source(dbSourceType(comp->source()));
+  }
+  if (comp->hasWeight()) {
+    componentR->weight(comp->weight());
+  }
+  if (comp->hasRegionName()) {
+    componentR->region(comp->regionName());
+  }
+  if (comp->hasHalo() > 0) {
+    int left, bottom, right, top;
+    comp->haloEdges(&left, &bottom, &right, &top);
+    componentR->halo(left, bottom, right, top);
+  }
+
+  componentR->placement(comp->placementStatus(),
+                        comp->placementX(),
+                        comp->placementY(),
+                        comp->placementOrient());
+
+  handle_props(comp, componentR);
+
+  componentR->end();
+
+  return PARSE_OK;
+}
+
+template <typename READER, typename NET>
+static int translateNet(READER* reader, defiNet* net, NET* netR)
+{
+  if (net->numShieldNets() > 0) {
+    UNSUPPORTED("SHIELDNET on net is unsupported");
+  }
+
+  if (net->numVpins() > 0) {
+    UNSUPPORTED("VPIN on net is unsupported");
+  }
+
+  if (net->hasSubnets()) {
+    UNSUPPORTED("SUBNET on net is unsupported");
+  }
+
+  if (net->hasXTalk()) {
+    UNSUPPORTED("XTALK on net is unsupported");
+  }
+
+  if (net->hasFrequency()) {
+    UNSUPPORTED("FREQUENCY on net is unsupported");
+  }
+
+  if (net->hasOriginal()) {
+    UNSUPPORTED("ORIGINAL on net is unsupported");
+  }
+
+  if (net->hasPattern()) {
+    UNSUPPORTED("PATTERN on net is unsupported");
+  }
+
+  if (net->hasCap()) {
+    UNSUPPORTED("ESTCAP on net is unsupported");
+  }
+
+  netR->begin(net->name());
+
+  if (net->hasUse()) {
+    netR->use(net->use());
+  }
+
+  if (net->hasSource()) {
+    netR->source(net->source());
+  }
+
+  if (net->hasFixedbump()) {
+    netR->fixedbump();
+  }
+
+  if (net->hasWeight()) {
+    netR->weight(net->weight());
+  }
+
+  if (net->hasNonDefaultRule()) {
+    netR->nonDefaultRule(net->nonDefaultRule());
+  }
+
+  for (int i = 0; i < net->numConnections(); ++i) {
+    if (net->pinIsSynthesized(i)) {
+      UNSUPPORTED("SYNTHESIZED on net's connection is unsupported");
+    }
+
+    if (net->pinIsMustJoin(i)) {
+      netR->beginMustjoin(net->instance(i), net->pin(i));
+    } else {
+      netR->connection(net->instance(i), net->pin(i));
+    }
+  }
+
+  for (int i = 0; i < net->numWires(); ++i) {
+    defiWire* wire = net->wire(i);
+    netR->wire(wire->wireType());
+
+    for (int j = 0; j < wire->numPaths(); ++j) {
+      defiPath* path = wire->path(j);
+
+      path->initTraverse();
+
+      int pathId;
+      while ((pathId = path->next()) != DEFIPATH_DONE) {
+        switch (pathId) {
+          case DEFIPATH_LAYER: {
+            // We need to peek ahead to see if there is a taper next
+            const char* layer = path->getLayer();
+            int nextId = path->next();
+            if (nextId == DEFIPATH_TAPER) {
+              netR->pathTaper(layer);
+            } else if (nextId == DEFIPATH_TAPERRULE) {
+              netR->pathTaperRule(layer, path->getTaperRule());
+            } else {
+              netR->path(layer);
+              path->prev();  // put back the token
+            }
+            break;
+          }
+
+          case DEFIPATH_VIA: {
+            // We need to peek ahead to see if there is a rotation next
+            const char* viaName = path->getVia();
+            int nextId = path->next();
+            if (nextId == DEFIPATH_VIAROTATION) {
+              netR->pathVia(viaName,
+                            definBase::translate_orientation(
+                                path->getViaRotation()));
+            } else {
+              netR->pathVia(viaName);
+              path->prev();  // put back the token
+            }
+            break;
+          }
+
+          case DEFIPATH_POINT: {
+            int x;
+            int y;
+            path->getPoint(&x, &y);
+            netR->pathPoint(x, y);
+            break;
+          }
+
+          case DEFIPATH_FLUSHPOINT: {
+            int x;
+            int y;
+            int ext;
+            path->getFlushPoint(&x, &y, &ext);
+            netR->pathPoint(x, y, ext);
+            break;
+          }
+
+          case DEFIPATH_STYLE:
+            UNSUPPORTED("styles are not supported on wires");
+            break;
+
+          case DEFIPATH_RECT: {
+            int deltaX1;
+            int deltaY1;
+            int deltaX2;
+            int deltaY2;
+            path->getViaRect(&deltaX1, &deltaY1, &deltaX2, &deltaY2);
+            netR->pathRect(deltaX1, deltaY1, deltaX2, deltaY2);
+            break;
+          }
+
+          case DEFIPATH_VIRTUALPOINT:
+            UNSUPPORTED("VIRTUAL in net's routing is unsupported");
+            break;
+
+          case DEFIPATH_MASK:
+            netR->pathColor(path->getMask());
+            break;
+
+          case DEFIPATH_VIAMASK:
+            netR->pathViaColor(path->getViaBottomMask(),
+                               path->getViaCutMask(),
+                               path->getViaTopMask());
+            break;
+
+          default:
+            UNSUPPORTED("Unknown construct in net's routing is unsupported");
+            break;
+        }
+      }
+      netR->pathEnd();
+    }
+
+    netR->wireEnd();
+  }
+
+  handle_props(net, netR);
+
+  netR->end();
+
+  return PARSE_OK;
+}
+
+template <typename READER, typename SNET>
+static int translateSNet(READER* reader, defiNet* net, SNET* snetR)
+{
+  if (net->hasCap()) {
+    UNSUPPORTED("ESTCAP on special net is unsupported");
+  }
+
+  if (net->hasPattern()) {
+    UNSUPPORTED("PATTERN on special net is unsupported");
+  }
+
+  if (net->hasOriginal()) {
+    UNSUPPORTED("ORIGINAL on special net is unsupported");
+  }
+
+  if (net->numShieldNets() > 0) {
+    UNSUPPORTED("SHIELDNET on special net is unsupported");
+  }
+
+  if (net->hasVoltage()) {
+    UNSUPPORTED("VOLTAGE on special net is unsupported");
+  }
+
+  if (net->numPolygons() > 0) {
+    // The db does support polygons but the callback code seems incorrect to me
+    // (ignores layers!).  Delaying support until I can fix it.
+    UNSUPPORTED("polygons in special nets are not supported");
+  }
+
+  if (net->numViaSpecs() > 0) {
+    UNSUPPORTED("VIA in special net is unsupported");
+  }
+
+  snetR->begin(net->name());
+
+  if (net->hasUse()) {
+    snetR->use(net->use());
+  }
+
+  if (net->hasSource()) {
+    snetR->source(net->source());
+  }
+
+  if (net->hasFixedbump()) {
+    snetR->fixedbump();
+  }
+
+  if (net->hasWeight()) {
+    snetR->weight(net->weight());
+  }
+
+  for (int i = 0; i < net->numConnections(); ++i) {
+    snetR->connection(net->instance(i), net->pin(i), net->pinIsSynthesized(i));
+  }
+
+  if (net->numRectangles()) {
+    for (int i = 0; i < net->numRectangles(); i++) {
+      snetR->wire(net->rectRouteStatus(i), net->rectRouteStatusShieldName(i));
+      snetR->rect(net->rectName(i),
+                  net->xl(i),
+                  net->yl(i),
+                  net->xh(i),
+                  net->yh(i),
+                  net->rectShapeType(i),
+                  net->rectMask(i));
+      snetR->wireEnd();
+    }
+  }
+
+  for (int i = 0; i < net->numWires(); ++i) {
+    defiWire* wire = net->wire(i);
+    snetR->wire(wire->wireType(), wire->wireShieldNetName());
+
+    for (int j = 0; j < wire->numPaths(); ++j) {
+      defiPath* path = wire->path(j);
+
+      path->initTraverse();
+
+      std::string layerName;
+
+      int pathId;
+      uint next_mask = 0;
+      uint next_via_bottom_mask = 0;
+      uint next_via_cut_mask = 0;
+      uint next_via_top_mask = 0;
+      while ((pathId = path->next()) != DEFIPATH_DONE) {
+        switch (pathId) {
+          case DEFIPATH_LAYER:
+            layerName = path->getLayer();
+            break;
+
+          case DEFIPATH_VIA: {
+            // We need to peek ahead to see if there is a rotation next
+            const char* viaName = path->getVia();
+            int nextId = path->next();
+            if (nextId == DEFIPATH_VIAROTATION) {
+              UNSUPPORTED("Rotated via in special net is unsupported");
+              // TODO: Make this take and store rotation
+              // snetR->pathVia(viaName,
+              //                translate_orientation(path->getViaRotation()));
+            } else if (nextId == DEFIPATH_VIADATA) {
+              int numX, numY, stepX, stepY;
+              path->getViaData(&numX, &numY, &stepX, &stepY);
+              snetR->pathViaArray(viaName, numX, numY, stepX, stepY);
+            } else {
+              snetR->pathVia(viaName,
+                             next_via_bottom_mask,
+                             next_via_cut_mask,
+                             next_via_top_mask);
+              path->prev();  // put back the token
+            }
+            break;
+          }
+
+          case DEFIPATH_WIDTH:
+            assert(!layerName.empty());  // always "layerName routeWidth"
+            snetR->path(layerName.c_str(), path->getWidth());
+            break;
+
+          case DEFIPATH_POINT: {
+            int x;
+            int y;
+            path->getPoint(&x, &y);
+            snetR->pathPoint(x, y, next_mask);
+            break;
+          }
+
+          case DEFIPATH_FLUSHPOINT: {
+            int x;
+            int y;
+            int ext;
+            path->getFlushPoint(&x, &y, &ext);
+            snetR->pathPoint(x, y, ext, next_mask);
+            break;
+          }
+
+          case DEFIPATH_SHAPE:
+            snetR->pathShape(path->getShape());
+            break;
+
+          case DEFIPATH_STYLE:
+            UNSUPPORTED("styles are not supported on wires");
+            break;
+
+          case DEFIPATH_MASK:
+            next_mask = path->getMask();
+            break;
+
+          case DEFIPATH_VIAMASK:
+            next_via_bottom_mask = path->getViaBottomMask();
+            next_via_cut_mask = path->getViaCutMask();
+            next_via_top_mask = path->getViaTopMask();
+            break;
+
+          default:
+            UNSUPPORTED(
+                "Unknown construct in special net's routing is unsupported");
+        }
+        if (pathId != DEFIPATH_MASK) {
+          next_mask = 0;
+        }
+        if (pathId != DEFIPATH_VIAMASK) {
+          next_via_bottom_mask = 0;
+          next_via_cut_mask = 0;
+          next_via_top_mask = 0;
+        }
+      }
+      snetR->pathEnd();
+    }
+
+    snetR->wireEnd();
+  }
 
-static std::string renameBlock(dbBlock* parent, const char* old_name)
-{
-  int cnt = 1;
+  handle_props(net, snetR);
 
-  for (;; ++cnt) {
-    char n[16];
-    snprintf(n, 15, "_%d", cnt);
-    std::string name(old_name);
-    name += n;
+  snetR->end();
 
-    if (!parent->findChild(name.c_str())) {
-      return name;
-    }
-  }
+  return PARSE_OK;
 }
 
 int definReader::versionCallback(defrCallbackType_e /* unused: type */,
@@ -569,44 +1014,7 @@ int definReader::componentsCallback(defrCallbackType_e /* unused: type */,
     return PARSE_OK;
   }
 
-  if (comp->hasEEQ()) {
-    UNSUPPORTED("EEQMASTER on component is unsupported");
-  }
-
-  if (comp->maskShiftSize() > 0) {
-    UNSUPPORTED("MASKSHIFT on component is unsupported");
-  }
-
-  if (comp->hasRouteHalo() > 0) {
-    UNSUPPORTED("ROUTEHALO on component is unsupported");
-  }
-
-  componentR->begin(comp->id(), comp->name());
-  if (comp->hasSource()) {
-    componentR->source(dbSourceType(comp->source()));
-  }
-  if (comp->hasWeight()) {
-    componentR->weight(comp->weight());
-  }
-  if (comp->hasRegionName()) {
-    componentR->region(comp->regionName());
-  }
-  if (comp->hasHalo() > 0) {
-    int left, bottom, right, top;
-    comp->haloEdges(&left, &bottom, &right, &top);
-    componentR->halo(left, bottom, right, top);
-  }
-
-  componentR->placement(comp->placementStatus(),
-                        comp->placementX(),
-                        comp->placementY(),
-                        comp->placementOrient());
-
-  handle_props(comp, componentR);
-
-  componentR->end();
-
-  return PARSE_OK;
+  return translateComponent(reader, comp, componentR);
 }
 
 int definReader::componentMaskShiftCallback(
@@ -796,190 +1204,23 @@ int definReader::historyCallback(defrCallbackType_e /* unused: type */,
   return PARSE_OK;
 }
 
-int definReader::netCallback(defrCallbackType_e /* unused: type */,
-                             defiNet* net,
-                             defiUserData data)
-{
-  definReader* reader = (definReader*) data;
-  CHECKBLOCK
-  definNet* netR = reader->_netR;
-  if (reader->_mode == defin::FLOORPLAN
-      && reader->_block->findNet(net->name()) == nullptr) {
-    reader->_logger->warn(
-        utl::ODB,
-        275,
-        "skipping undefined net {} encountered in FLOORPLAN DEF",
-        net->name());
-    return PARSE_OK;
-  }
-  if (net->numShieldNets() > 0) {
-    UNSUPPORTED("SHIELDNET on net is unsupported");
-  }
-
-  if (net->numVpins() > 0) {
-    UNSUPPORTED("VPIN on net is unsupported");
-  }
-
-  if (net->hasSubnets()) {
-    UNSUPPORTED("SUBNET on net is unsupported");
-  }
-
-  if (net->hasXTalk()) {
-    UNSUPPORTED("XTALK on net is unsupported");
-  }
-
-  if (net->hasFrequency()) {
-    UNSUPPORTED("FREQUENCY on net is unsupported");
-  }
-
-  if (net->hasOriginal()) {
-    UNSUPPORTED("ORIGINAL on net is unsupported");
-  }
-
-  if (net->hasPattern()) {
-    UNSUPPORTED("PATTERN on net is unsupported");
-  }
-
-  if (net->hasCap()) {
-    UNSUPPORTED("ESTCAP on net is unsupported");
-  }
-
-  netR->begin(net->name());
-
-  if (net->hasUse()) {
-    netR->use(net->use());
-  }
-
-  if (net->hasSource()) {
-    netR->source(net->source());
-  }
-
-  if (net->hasFixedbump()) {
-    netR->fixedbump();
-  }
-
-  if (net->hasWeight()) {
-    netR->weight(net->weight());
-  }
-
-  if (net->hasNonDefaultRule()) {
-    netR->nonDefaultRule(net->nonDefaultRule());
-  }
-
-  for (int i = 0; i < net->numConnections(); ++i) {
-    if (net->pinIsSynthesized(i)) {
-      UNSUPPORTED("SYNTHESIZED on net's connection is unsupported");
-    }
-
-    if (net->pinIsMustJoin(i)) {
-      netR->beginMustjoin(net->instance(i), net->pin(i));
-    } else {
-      netR->connection(net->instance(i), net->pin(i));
-    }
-  }
-
-  for (int i = 0; i < net->numWires(); ++i) {
-    defiWire* wire = net->wire(i);
-    netR->wire(wire->wireType());
-
-    for (int j = 0; j < wire->numPaths(); ++j) {
-      defiPath* path = wire->path(j);
-
-      path->initTraverse();
-
-      int pathId;
-      while ((pathId = path->next()) != DEFIPATH_DONE) {
-        switch (pathId) {
-          case DEFIPATH_LAYER: {
-            // We need to peek ahead to see if there is a taper next
-            const char* layer = path->getLayer();
-            int nextId = path->next();
-            if (nextId == DEFIPATH_TAPER) {
-              netR->pathTaper(layer);
-            } else if (nextId == DEFIPATH_TAPERRULE) {
-              netR->pathTaperRule(layer, path->getTaperRule());
-            } else {
-              netR->path(layer);
-              path->prev();  // put back the token
-            }
-            break;
-          }
-
-          case DEFIPATH_VIA: {
-            // We need to peek ahead to see if there is a rotation next
-            const char* viaName = path->getVia();
-            int nextId = path->next();
-            if (nextId == DEFIPATH_VIAROTATION) {
-              netR->pathVia(viaName,
-                            translate_orientation(path->getViaRotation()));
-            } else {
-              netR->pathVia(viaName);
-              path->prev();  // put back the token
-            }
-            break;
-          }
-
-          case DEFIPATH_POINT: {
-            int x;
-            int y;
-            path->getPoint(&x, &y);
-            netR->pathPoint(x, y);
-            break;
-          }
-
-          case DEFIPATH_FLUSHPOINT: {
-            int x;
-            int y;
-            int ext;
-            path->getFlushPoint(&x, &y, &ext);
-            netR->pathPoint(x, y, ext);
-            break;
-          }
-
-          case DEFIPATH_STYLE:
-            UNSUPPORTED("styles are not supported on wires");
-            break;
-
-          case DEFIPATH_RECT: {
-            int deltaX1;
-            int deltaY1;
-            int deltaX2;
-            int deltaY2;
-            path->getViaRect(&deltaX1, &deltaY1, &deltaX2, &deltaY2);
-            netR->pathRect(deltaX1, deltaY1, deltaX2, deltaY2);
-            break;
-          }
-
-          case DEFIPATH_VIRTUALPOINT:
-            UNSUPPORTED("VIRTUAL in net's routing is unsupported");
-            break;
-
-          case DEFIPATH_MASK:
-            netR->pathColor(path->getMask());
-            break;
-
-          case DEFIPATH_VIAMASK:
-            netR->pathViaColor(path->getViaBottomMask(),
-                               path->getViaCutMask(),
-                               path->getViaTopMask());
-            break;
-
-          default:
-            UNSUPPORTED("Unknown construct in net's routing is unsupported");
-            break;
-        }
-      }
-      netR->pathEnd();
-    }
-
-    netR->wireEnd();
-  }
-
-  handle_props(net, netR);
-
-  netR->end();
-
-  return PARSE_OK;
+int definReader::netCallback(defrCallbackType_e /* unused: type */,
+                             defiNet* net,
+                             defiUserData data)
+{
+  definReader* reader = (definReader*) data;
+  CHECKBLOCK
+  definNet* netR = reader->_netR;
+  if (reader->_mode == defin::FLOORPLAN
+      && reader->_block->findNet(net->name()) == nullptr) {
+    reader->_logger->warn(
+        utl::ODB,
+        275,
+        "skipping undefined net {} encountered in FLOORPLAN DEF",
+        net->name());
+    return PARSE_OK;
+  }
+  return translateNet(reader, net, netR);
 }
 
 int definReader::nonDefaultRuleCallback(defrCallbackType_e /* unused: type */,
@@ -1668,6 +1909,87 @@ int definReader::viaCallback(defrCallbackType_e /* unused: type */,
   return PARSE_OK;
 }
 
+int definReader::componentsRecordCallback(defrCallbackType_e /* unused: type */,
+                                          defiComponent* comp,
+                                          defiUserData data)
+{
+  auto result = (definChunkParser::Result*) data;
+  ++result->items;
+  return translateComponent(&result->components, comp, &result->components);
+}
+
+int definReader::netRecordCallback(defrCallbackType_e /* unused: type */,
+                                   defiNet* net,
+                                   defiUserData data)
+{
+  auto result = (definChunkParser::Result*) data;
+  ++result->items;
+  return translateNet(&result->nets, net, &result->nets);
+}
+
+int definReader::specialNetRecordCallback(defrCallbackType_e /* unused: type */,
+                                          defiNet* net,
+                                          defiUserData data)
+{
+  auto result = (definChunkParser::Result*) data;
+  ++result->items;
+  return translateSNet(&result->snets, net, &result->snets);
+}
+
+int definReader::componentsEndCallback(defrCallbackType_e /* unused: type */,
+                                       void* /* unused: v */,
+                                       defiUserData data)
+{
+  definReader* reader = (definReader*) data;
+  CHECKBLOCK
+  return reader->commitChunks(definSectionIndex::COMPONENTS);
+}
+
+int definReader::netsEndCallback(defrCallbackType_e /* unused: type */,
+                                 void* /* unused: v */,
+                                 defiUserData data)
+{
+  definReader* reader = (definReader*) data;
+  CHECKBLOCK
+  return reader->commitChunks(definSectionIndex::NETS);
+}
+
+int definReader::specialNetsEndCallback(defrCallbackType_e /* unused: type */,
+                                        void* /* unused: v */,
+                                        defiUserData data)
+{
+  definReader* reader = (definReader*) data;
+  CHECKBLOCK
+  return reader->commitChunks(definSectionIndex::SPECIALNETS);
+}
+
+int definReader::commitChunks(definSectionIndex::Section section)
+{
+  auto replay = [this, section](const definSectionIndex::Chunk& chunk,
+                                const definChunkParser::Result& result) {
+    // Every item cut by the index must have been parsed, or the chunk
+    // boundaries were wrong.
+    if (result.status == 0 && result.items != chunk.count) {
+      error(fmt::format("{} at line {}: {} items were parsed out of {}",
+                        definSectionIndex::sectionName(section),
+                        chunk.line,
+                        result.items,
+                        chunk.count));
+      return false;
+    }
+    switch (section) {
+      case definSectionIndex::COMPONENTS:
+        return result.components.replay(_componentR, this);
+      case definSectionIndex::NETS:
+        return result.nets.replay(_netR, this);
+      case definSectionIndex::SPECIALNETS:
+        return result.snets.replay(_snetR, this);
+    }
+    return false;
+  };
+  return _chunk_parser->commit(section, replay) ? PARSE_OK : PARSE_ERROR;
+}
+
 int definReader::specialNetCallback(defrCallbackType_e /* unused: type */,
                                     defiNet* net,
                                     defiUserData data)
@@ -1684,181 +2006,7 @@ int definReader::specialNetCallback(defrCallbackType_e /* unused: type */,
         net->name());
     return PARSE_OK;
   }
-  if (net->hasCap()) {
-    UNSUPPORTED("ESTCAP on special net is unsupported");
-  }
-
-  if (net->hasPattern()) {
-    UNSUPPORTED("PATTERN on special net is unsupported");
-  }
-
-  if (net->hasOriginal()) {
-    UNSUPPORTED("ORIGINAL on special net is unsupported");
-  }
-
-  if (net->numShieldNets() > 0) {
-    UNSUPPORTED("SHIELDNET on special net is unsupported");
-  }
-
-  if (net->hasVoltage()) {
-    UNSUPPORTED("VOLTAGE on special net is unsupported");
-  }
-
-  if (net->numPolygons() > 0) {
-    // The db does support polygons but the callback code seems incorrect to me
-    // (ignores layers!).  Delaying support until I can fix it.
-    UNSUPPORTED("polygons in special nets are not supported");
-  }
-
-  if (net->numViaSpecs() > 0) {
-    UNSUPPORTED("VIA in special net is unsupported");
-  }
-
-  snetR->begin(net->name());
-
-  if (net->hasUse()) {
-    snetR->use(net->use());
-  }
-
-  if (net->hasSource()) {
-    snetR->source(net->source());
-  }
-
-  if (net->hasFixedbump()) {
-    snetR->fixedbump();
-  }
-
-  if (net->hasWeight()) {
-    snetR->weight(net->weight());
-  }
-
-  for (int i = 0; i < net->numConnections(); ++i) {
-    snetR->connection(net->instance(i), net->pin(i), net->pinIsSynthesized(i));
-  }
-
-  if (net->numRectangles()) {
-    for (int i = 0; i < net->numRectangles(); i++) {
-      snetR->wire(net->rectRouteStatus(i), net->rectRouteStatusShieldName(i));
-      snetR->rect(net->rectName(i),
-                  net->xl(i),
-                  net->yl(i),
-                  net->xh(i),
-                  net->yh(i),
-                  net->rectShapeType(i),
-                  net->rectMask(i));
-      snetR->wireEnd();
-    }
-  }
-
-  for (int i = 0; i < net->numWires(); ++i) {
-    defiWire* wire = net->wire(i);
-    snetR->wire(wire->wireType(), wire->wireShieldNetName());
-
-    for (int j = 0; j < wire->numPaths(); ++j) {
-      defiPath* path = wire->path(j);
-
-      path->initTraverse();
-
-      std::string layerName;
-
-      int pathId;
-      uint next_mask = 0;
-      uint next_via_bottom_mask = 0;
-      uint next_via_cut_mask = 0;
-      uint next_via_top_mask = 0;
-      while ((pathId = path->next()) != DEFIPATH_DONE) {
-        switch (pathId) {
-          case DEFIPATH_LAYER:
-            layerName = path->getLayer();
-            break;
-
-          case DEFIPATH_VIA: {
-            // We need to peek ahead to see if there is a rotation next
-            const char* viaName = path->getVia();
-            int nextId = path->next();
-            if (nextId == DEFIPATH_VIAROTATION) {
-              UNSUPPORTED("Rotated via in special net is unsupported");
-              // TODO: Make this take and store rotation
-              // snetR->pathVia(viaName,
-              //                translate_orientation(path->getViaRotation()));
-            } else if (nextId == DEFIPATH_VIADATA) {
-              int numX, numY, stepX, stepY;
-              path->getViaData(&numX, &numY, &stepX, &stepY);
-              snetR->pathViaArray(viaName, numX, numY, stepX, stepY);
-            } else {
-              snetR->pathVia(viaName,
-                             next_via_bottom_mask,
-                             next_via_cut_mask,
-                             next_via_top_mask);
-              path->prev();  // put back the token
-            }
-            break;
-          }
-
-          case DEFIPATH_WIDTH:
-            assert(!layerName.empty());  // always "layerName routeWidth"
-            snetR->path(layerName.c_str(), path->getWidth());
-            break;
-
-          case DEFIPATH_POINT: {
-            int x;
-            int y;
-            path->getPoint(&x, &y);
-            snetR->pathPoint(x, y, next_mask);
-            break;
-          }
-
-          case DEFIPATH_FLUSHPOINT: {
-            int x;
-            int y;
-            int ext;
-            path->getFlushPoint(&x, &y, &ext);
-            snetR->pathPoint(x, y, ext, next_mask);
-            break;
-          }
-
-          case DEFIPATH_SHAPE:
-            snetR->pathShape(path->getShape());
-            break;
-
-          case DEFIPATH_STYLE:
-            UNSUPPORTED("styles are not supported on wires");
-            break;
-
-          case DEFIPATH_MASK:
-            next_mask = path->getMask();
-            break;
-
-          case DEFIPATH_VIAMASK:
-            next_via_bottom_mask = path->getViaBottomMask();
-            next_via_cut_mask = path->getViaCutMask();
-            next_via_top_mask = path->getViaTopMask();
-            break;
-
-          default:
-            UNSUPPORTED(
-                "Unknown construct in special net's routing is unsupported");
-        }
-        if (pathId != DEFIPATH_MASK) {
-          next_mask = 0;
-        }
-        if (pathId != DEFIPATH_VIAMASK) {
-          next_via_bottom_mask = 0;
-          next_via_cut_mask = 0;
-          next_via_top_mask = 0;
-        }
-      }
-      snetR->pathEnd();
-    }
-
-    snetR->wireEnd();
-  }
-
-  handle_props(net, snetR);
-
-  snetR->end();
-
-  return PARSE_OK;
+  return translateSNet(reader, net, snetR);
 }
 
 void definReader::line(int line_num)
@@ -2097,24 +2245,26 @@ bool definReader::createBlock(const char* file)
 
   bool isZipped = hasSuffix(file, ".gz");
   int res;
-  if (!isZipped) {
-    FILE* f = fopen(file, "r");
-    if (f == nullptr) {
-      _logger->warn(utl::ODB, 148, "error: Cannot open DEF file {}", file);
-      return false;
-    }
-    res = defrRead(f, file, (defiUserData) this, /* case sensitive */ 1);
-    fclose(f);
-  } else {
-    defrSetGZipReadFunction();
-    defGZFile f = defrGZipOpen(file, "r");
-    if (f == nullptr) {
-      _logger->warn(
-          utl::ODB, 271, "error: Cannot open zipped DEF file {}", file);
-      return false;
+  if (!readParallel(file, isZipped, res)) {
+    if (!isZipped) {
+      FILE* f = fopen(file, "r");
+      if (f == nullptr) {
+        _logger->warn(utl::ODB, 148, "error: Cannot open DEF file {}", file);
+        return false;
+      }
+      res = defrRead(f, file, (defiUserData) this, /* case sensitive */ 1);
+      fclose(f);
+    } else {
+      defrSetGZipReadFunction();
+      defGZFile f = defrGZipOpen(file, "r");
+      if (f == nullptr) {
+        _logger->warn(
+            utl::ODB, 271, "error: Cannot open zipped DEF file {}", file);
+        return false;
+      }
+      res = defrReadGZip(f, file, (defiUserData) this);
+      defGZipClose(f);
     }
-    res = defrReadGZip(f, file, (defiUserData) this);
-    defGZipClose(f);
   }
 
   if (res != 0 || errors() != 0) {
@@ -2131,6 +2281,69 @@ bool definReader::createBlock(const char* file)
   // 1220 return errors() == 0;
 }
 
+// The COMPONENTS, NETS and SPECIALNETS items are parsed in chunks on worker
+// threads while the rest of the file is parsed here.  The chunks of a
+// section are committed in file order when the main parse reaches its END
+// statement, so the database is built exactly as by the serial reader.
+// Returns false if the file has to be read serially.
+bool definReader::readParallel(const char* file, bool zipped, int& res)
+{
+  if (_threads <= 1 || _mode != defin::DEFAULT) {
+    return false;
+  }
+
+  // A plain file is mapped rather than copied into memory.
+  std::unique_ptr<dbMappedFile> mapped;
+  std::string unzipped;
+  std::string_view text;
+  if (zipped) {
+    if (!readGzipFile(file, unzipped)) {
+      return false;
+    }
+    text = unzipped;
+  } else {
+    try {
+      mapped = std::make_unique<dbMappedFile>(file);
+    } catch (const std::runtime_error&) {
+      return false;
+    }
+    text = std::string_view(mapped->data(), mapped->size());
+  }
+
+  definSectionIndex index;
+  if (!index.build(text, _threads) || index.chunks().empty()) {
+    return false;
+  }
+
+  defrSettings settings;
+  settings.AddPathToNet = 1;
+  defrCallbacks callbacks;
+  callbacks.ComponentCbk = componentsRecordCallback;
+  callbacks.NetCbk = netRecordCallback;
+  callbacks.SNetCbk = specialNetRecordCallback;
+
+  defrSetComponentEndCbk(componentsEndCallback);
+  defrSetNetEndCbk(netsEndCallback);
+  defrSetSNetEndCbk(specialNetsEndCallback);
+
+  definChunkParser chunk_parser(
+      index, file, &callbacks, &settings, _continue_on_errors, _threads);
+  _chunk_parser = &chunk_parser;
+
+  definSectionIndex::Remainder remainder(index);
+  defrSetReadFunction(definSectionIndex::Remainder::read);
+  res = defrRead(
+      (FILE*) &remainder, file, (defiUserData) this, /* case sensitive */ 1);
+  defrUnsetReadFunction();
+  _chunk_parser = nullptr;
+
+  // A section the main parse never finished leaves chunks behind.
+  if (res == 0 && !chunk_parser.done()) {
+    res = PARSE_ERROR;
+  }
+  return true;
+}
+
 bool definReader::replaceWires(const char* file)
 {
   FILE* f = fopen(file, "r");
@@ -33,6 +33,7 @@
 #pragma once
 
 #include "definBase.h"
+#include "definSectionIndex.h"
 #include "defrReader.hpp"
 #include "odb/odb.h"
 
@@ -43,6 +44,7 @@ class Logger;
 namespace odb {
 
 class definBlockage;
+class definChunkParser;
 class definComponentMaskShift;
 class definComponent;
 class definFill;
@@ -82,6 +84,8 @@ class definReader : public definBase
   std::vector<definBase*> _interfaces;
   bool _update;
   bool _continue_on_errors;
+  int _threads;
+  definChunkParser* _chunk_parser;  // only while reading in parallel
   std::string _block_name;
   std::string version_;
   char hier_delimeter_;
@@ -98,6 +102,8 @@ class definReader : public definBase
   void setLogger(utl::Logger* logger);
 
   bool createBlock(const char* file);
+  bool readParallel(const char* file, bool zipped, int& res);
+  int commitChunks(definSectionIndex::Section section);
   bool replaceWires(const char* file);
   void replaceWires();
   int errors();
@@ -245,6 +251,34 @@ class definReader : public definBase
                          defiVia* via,
                          defiUserData data);
 
+  // Callbacks for reading COMPONENTS, NETS and SPECIALNETS in parallel.
+  // The record callbacks run on worker threads and only see the
+  // definChunkParser::Result of their chunk; the end callbacks commit the
+  // chunks of the section to the database on the main thread.
+  static int componentsRecordCallback(defrCallbackType_e type,
+                                      defiComponent* comp,
+                                      defiUserData data);
+
+  static int netRecordCallback(defrCallbackType_e type,
+                               defiNet* net,
+                               defiUserData data);
+
+  static int specialNetRecordCallback(defrCallbackType_e type,
+                                      defiNet* net,
+                                      defiUserData data);
+
+  static int componentsEndCallback(defrCallbackType_e type,
+                                   void* v,
+                                   defiUserData data);
+
+  static int netsEndCallback(defrCallbackType_e type,
+                             void* v,
+                             defiUserData data);
+
+  static int specialNetsEndCallback(defrCallbackType_e type,
+                                    void* v,
+                                    defiUserData data);
+
  public:
   definReader(dbDatabase* db,
               utl::Logger* logger,
@@ -258,6 +292,9 @@ class definReader : public definBase
   void skipBlockWires();
   void skipFillWires();
   void continueOnErrors();
+  bool continuesOnErrors() const { return _continue_on_errors; }
+  // Read COMPONENTS, NETS and SPECIALNETS with this many threads
+  void setThreads(int threads);
   void useBlockName(const char* name);
   void namesAreDBIDs();
   void setAssemblyMode();
@@ -0,0 +1,632 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "definRecorder.h"
+
+#include "definComponent.h"
+#include "definNet.h"
+#include "definReader.h"
+#include "definSNet.h"
+
+namespace odb {
+
+void definRecorder::error(std::string_view msg)
+{
+  add(error_op, std::string(msg).c_str());
+}
+
+definRecorder::Op& definRecorder::add(int kind, const char* s0, const char* s1)
+{
+  ops_.push_back({kind, {}, {addString(s0), addString(s1)}, 0.0});
+  return ops_.back();
+}
+
+size_t definRecorder::addString(const char* s)
+{
+  if (s == nullptr) {
+    return no_string;
+  }
+  const size_t offset = strings_.size();
+  strings_.append(s);
+  strings_ += '\0';
+  return offset;
+}
+
+const char* definRecorder::string(size_t offset) const
+{
+  return offset == no_string ? nullptr : strings_.data() + offset;
+}
+
+bool definRecorder::replayError(const char* msg, definReader* reader)
+{
+  reader->error(msg);
+  return reader->continuesOnErrors();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void definComponentRecorder::begin(const char* name, const char* cell)
+{
+  add(BEGIN, name, cell);
+}
+
+void definComponentRecorder::placement(int status, int x, int y, int orient)
+{
+  Op& op = add(PLACEMENT);
+  op.ints[0] = status;
+  op.ints[1] = x;
+  op.ints[2] = y;
+  op.ints[3] = orient;
+}
+
+void definComponentRecorder::region(const char* region)
+{
+  add(REGION, region);
+}
+
+void definComponentRecorder::halo(int left, int bottom, int right, int top)
+{
+  Op& op = add(HALO);
+  op.ints[0] = left;
+  op.ints[1] = bottom;
+  op.ints[2] = right;
+  op.ints[3] = top;
+}
+
+void definComponentRecorder::source(dbSourceType source)
+{
+  add(SOURCE).ints[0] = source.getValue();
+}
+
+void definComponentRecorder::weight(int weight)
+{
+  add(WEIGHT).ints[0] = weight;
+}
+
+void definComponentRecorder::property(const char* name, const char* value)
+{
+  add(STRING_PROPERTY, name, value);
+}
+
+void definComponentRecorder::property(const char* name, int value)
+{
+  add(INT_PROPERTY, name).ints[0] = value;
+}
+
+void definComponentRecorder::property(const char* name, double value)
+{
+  add(DOUBLE_PROPERTY, name).number = value;
+}
+
+void definComponentRecorder::end()
+{
+  add(END);
+}
+
+bool definComponentRecorder::replay(definComponent* componentR,
+                                    definReader* reader) const
+{
+  for (const Op& op : ops_) {
+    const int* i = op.ints;
+    const char* s0 = string(op.strings[0]);
+    const char* s1 = string(op.strings[1]);
+    switch (op.kind) {
+      case error_op:
+        if (!replayError(s0, reader)) {
+          return false;
+        }
+        break;
+      case BEGIN:
+        componentR->begin(s0, s1);
+        break;
+      case PLACEMENT:
+        componentR->placement(i[0], i[1], i[2], i[3]);
+        break;
+      case REGION:
+        componentR->region(s0);
+        break;
+      case HALO:
+        componentR->halo(i[0], i[1], i[2], i[3]);
+        break;
+      case SOURCE:
+        componentR->source(dbSourceType((dbSourceType::Value) i[0]));
+        break;
+      case WEIGHT:
+        componentR->weight(i[0]);
+        break;
+      case STRING_PROPERTY:
+        componentR->property(s0, s1);
+        break;
+      case INT_PROPERTY:
+        componentR->property(s0, i[0]);
+        break;
+      case DOUBLE_PROPERTY:
+        componentR->property(s0, op.number);
+        break;
+      case END:
+        componentR->end();
+        break;
+    }
+  }
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void definNetRecorder::begin(const char* name)
+{
+  add(BEGIN, name);
+}
+
+void definNetRecorder::beginMustjoin(const char* iname, const char* pname)
+{
+  add(BEGIN_MUSTJOIN, iname, pname);
+}
+
+void definNetRecorder::connection(const char* iname, const char* pname)
+{
+  add(CONNECTION, iname, pname);
+}
+
+void definNetRecorder::nonDefaultRule(const char* rule)
+{
+  add(NON_DEFAULT_RULE, rule);
+}
+
+void definNetRecorder::use(dbSigType type)
+{
+  add(USE).ints[0] = type.getValue();
+}
+
+void definNetRecorder::wire(dbWireType type)
+{
+  add(WIRE).ints[0] = type.getValue();
+}
+
+void definNetRecorder::path(const char* layer)
+{
+  add(PATH, layer);
+}
+
+void definNetRecorder::pathTaper(const char* layer)
+{
+  add(PATH_TAPER, layer);
+}
+
+void definNetRecorder::pathTaperRule(const char* layer, const char* rule)
+{
+  add(PATH_TAPER_RULE, layer, rule);
+}
+
+void definNetRecorder::pathPoint(int x, int y)
+{
+  Op& op = add(PATH_POINT);
+  op.ints[0] = x;
+  op.ints[1] = y;
+}
+
+void definNetRecorder::pathPoint(int x, int y, int ext)
+{
+  Op& op = add(PATH_POINT_EXT);
+  op.ints[0] = x;
+  op.ints[1] = y;
+  op.ints[2] = ext;
+}
+
+void definNetRecorder::pathVia(const char* via)
+{
+  add(PATH_VIA, via);
+}
+
+void definNetRecorder::pathVia(const char* via, dbOrientType orient)
+{
+  add(PATH_VIA_ORIENT, via).ints[0] = orient.getValue();
+}
+
+void definNetRecorder::pathRect(int deltaX1,
+                                int deltaY1,
+                                int deltaX2,
+                                int deltaY2)
+{
+  Op& op = add(PATH_RECT);
+  op.ints[0] = deltaX1;
+  op.ints[1] = deltaY1;
+  op.ints[2] = deltaX2;
+  op.ints[3] = deltaY2;
+}
+
+void definNetRecorder::pathColor(int color)
+{
+  add(PATH_COLOR).ints[0] = color;
+}
+
+void definNetRecorder::pathViaColor(int bottom_color,
+                                    int cut_color,
+                                    int top_color)
+{
+  Op& op = add(PATH_VIA_COLOR);
+  op.ints[0] = bottom_color;
+  op.ints[1] = cut_color;
+  op.ints[2] = top_color;
+}
+
+void definNetRecorder::pathEnd()
+{
+  add(PATH_END);
+}
+
+void definNetRecorder::wireEnd()
+{
+  add(WIRE_END);
+}
+
+void definNetRecorder::source(dbSourceType source)
+{
+  add(SOURCE).ints[0] = source.getValue();
+}
+
+void definNetRecorder::weight(int weight)
+{
+  add(WEIGHT).ints[0] = weight;
+}
+
+void definNetRecorder::fixedbump()
+{
+  add(FIXEDBUMP);
+}
+
+void definNetRecorder::property(const char* name, const char* value)
+{
+  add(STRING_PROPERTY, name, value);
+}
+
+void definNetRecorder::property(const char* name, int value)
+{
+  add(INT_PROPERTY, name).ints[0] = value;
+}
+
+void definNetRecorder::property(const char* name, double value)
+{
+  add(DOUBLE_PROPERTY, name).number = value;
+}
+
+void definNetRecorder::end()
+{
+  add(END);
+}
+
+bool definNetRecorder::replay(definNet* netR, definReader* reader) const
+{
+  for (const Op& op : ops_) {
+    const int* i = op.ints;
+    const char* s0 = string(op.strings[0]);
+    const char* s1 = string(op.strings[1]);
+    switch (op.kind) {
+      case error_op:
+        if (!replayError(s0, reader)) {
+          return false;
+        }
+        break;
+      case BEGIN:
+        netR->begin(s0);
+        break;
+      case BEGIN_MUSTJOIN:
+        netR->beginMustjoin(s0, s1);
+        break;
+      case CONNECTION:
+        netR->connection(s0, s1);
+        break;
+      case NON_DEFAULT_RULE:
+        netR->nonDefaultRule(s0);
+        break;
+      case USE:
+        netR->use(dbSigType((dbSigType::Value) i[0]));
+        break;
+      case WIRE:
+        netR->wire(dbWireType((dbWireType::Value) i[0]));
+        break;
+      case PATH:
+        netR->path(s0);
+        break;
+      case PATH_TAPER:
+        netR->pathTaper(s0);
+        break;
+      case PATH_TAPER_RULE:
+        netR->pathTaperRule(s0, s1);
+        break;
+      case PATH_POINT:
+        netR->pathPoint(i[0], i[1]);
+        break;
+      case PATH_POINT_EXT:
+        netR->pathPoint(i[0], i[1], i[2]);
+        break;
+      case PATH_VIA:
+        netR->pathVia(s0);
+        break;
+      case PATH_VIA_ORIENT:
+        netR->pathVia(s0, dbOrientType((dbOrientType::Value) i[0]));
+        break;
+      case PATH_RECT:
+        netR->pathRect(i[0], i[1], i[2], i[3]);
+        break;
+      case PATH_COLOR:
+        netR->pathColor(i[0]);
+        break;
+      case PATH_VIA_COLOR:
+        netR->pathViaColor(i[0], i[1], i[2]);
+        break;
+      case PATH_END:
+        netR->pathEnd();
+        break;
+      case WIRE_END:
+        netR->wireEnd();
+        break;
+      case SOURCE:
+        netR->source(dbSourceType((dbSourceType::Value) i[0]));
+        break;
+      case WEIGHT:
+        netR->weight(i[0]);
+        break;
+      case FIXEDBUMP:
+        netR->fixedbump();
+        break;
+      case STRING_PROPERTY:
+        netR->property(s0, s1);
+        break;
+      case INT_PROPERTY:
+        netR->property(s0, i[0]);
+        break;
+      case DOUBLE_PROPERTY:
+        netR->property(s0, op.number);
+        break;
+      case END:
+        netR->end();
+        break;
+    }
+  }
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void definSNetRecorder::begin(const char* name)
+{
+  add(BEGIN, name);
+}
+
+void definSNetRecorder::connection(const char* iname,
+                                   const char* pname,
+                                   bool synthesized)
+{
+  add(CONNECTION, iname, pname).ints[0] = synthesized;
+}
+
+void definSNetRecorder::use(dbSigType type)
+{
+  add(USE).ints[0] = type.getValue();
+}
+
+void definSNetRecorder::rect(const char* layer,
+                             int x1,
+                             int y1,
+                             int x2,
+                             int y2,
+                             const char* type,
+                             uint mask)
+{
+  Op& op = add(RECT, layer, type);
+  op.ints[0] = x1;
+  op.ints[1] = y1;
+  op.ints[2] = x2;
+  op.ints[3] = y2;
+  op.ints[4] = mask;
+}
+
+void definSNetRecorder::wire(dbWireType type, const char* shield)
+{
+  add(WIRE, shield).ints[0] = type.getValue();
+}
+
+void definSNetRecorder::path(const char* layer, int width)
+{
+  add(PATH, layer).ints[0] = width;
+}
+
+void definSNetRecorder::pathShape(const char* type)
+{
+  add(PATH_SHAPE, type);
+}
+
+void definSNetRecorder::pathPoint(int x, int y, uint mask)
+{
+  Op& op = add(PATH_POINT);
+  op.ints[0] = x;
+  op.ints[1] = y;
+  op.ints[2] = mask;
+}
+
+void definSNetRecorder::pathPoint(int x, int y, int ext, uint mask)
+{
+  Op& op = add(PATH_POINT_EXT);
+  op.ints[0] = x;
+  op.ints[1] = y;
+  op.ints[2] = ext;
+  op.ints[3] = mask;
+}
+
+void definSNetRecorder::pathVia(const char* via,
+                                uint bottom_mask,
+                                uint cut_mask,
+                                uint top_mask)
+{
+  Op& op = add(PATH_VIA, via);
+  op.ints[0] = bottom_mask;
+  op.ints[1] = cut_mask;
+  op.ints[2] = top_mask;
+}
+
+void definSNetRecorder::pathViaArray(const char* via,
+                                     int numX,
+                                     int numY,
+                                     int stepX,
+                                     int stepY)
+{
+  Op& op = add(PATH_VIA_ARRAY, via);
+  op.ints[0] = numX;
+  op.ints[1] = numY;
+  op.ints[2] = stepX;
+  op.ints[3] = stepY;
+}
+
+void definSNetRecorder::pathEnd()
+{
+  add(PATH_END);
+}
+
+void definSNetRecorder::wireEnd()
+{
+  add(WIRE_END);
+}
+
+void definSNetRecorder::source(dbSourceType source)
+{
+  add(SOURCE).ints[0] = source.getValue();
+}
+
+void definSNetRecorder::weight(int weight)
+{
+  add(WEIGHT).ints[0] = weight;
+}
+
+void definSNetRecorder::fixedbump()
+{
+  add(FIXEDBUMP);
+}
+
+void definSNetRecorder::property(const char* name, const char* value)
+{
+  add(STRING_PROPERTY, name, value);
+}
+
+void definSNetRecorder::property(const char* name, int value)
+{
+  add(INT_PROPERTY, name).ints[0] = value;
+}
+
+void definSNetRecorder::property(const char* name, double value)
+{
+  add(DOUBLE_PROPERTY, name).number = value;
+}
+
+void definSNetRecorder::end()
+{
+  add(END);
+}
+
+bool definSNetRecorder::replay(definSNet* snetR, definReader* reader) const
+{
+  for (const Op& op : ops_) {
+    const int* i = op.ints;
+    const char* s0 = string(op.strings[0]);
+    const char* s1 = string(op.strings[1]);
+    switch (op.kind) {
+      case error_op:
+        if (!replayError(s0, reader)) {
+          return false;
+        }
+        break;
+      case BEGIN:
+        snetR->begin(s0);
+        break;
+      case CONNECTION:
+        snetR->connection(s0, s1, i[0]);
+        break;
+      case USE:
+        snetR->use(dbSigType((dbSigType::Value) i[0]));
+        break;
+      case RECT:
+        snetR->rect(s0, i[0], i[1], i[2], i[3], s1, i[4]);
+        break;
+      case WIRE:
+        snetR->wire(dbWireType((dbWireType::Value) i[0]), s0);
+        break;
+      case PATH:
+        snetR->path(s0, i[0]);
+        break;
+      case PATH_SHAPE:
+        snetR->pathShape(s0);
+        break;
+      case PATH_POINT:
+        snetR->pathPoint(i[0], i[1], (uint) i[2]);
+        break;
+      case PATH_POINT_EXT:
+        snetR->pathPoint(i[0], i[1], i[2], (uint) i[3]);
+        break;
+      case PATH_VIA:
+        snetR->pathVia(s0, i[0], i[1], i[2]);
+        break;
+      case PATH_VIA_ARRAY:
+        snetR->pathViaArray(s0, i[0], i[1], i[2], i[3]);
+        break;
+      case PATH_END:
+        snetR->pathEnd();
+        break;
+      case WIRE_END:
+        snetR->wireEnd();
+        break;
+      case SOURCE:
+        snetR->source(dbSourceType((dbSourceType::Value) i[0]));
+        break;
+      case WEIGHT:
+        snetR->weight(i[0]);
+        break;
+      case FIXEDBUMP:
+        snetR->fixedbump();
+        break;
+      case STRING_PROPERTY:
+        snetR->property(s0, s1);
+        break;
+      case INT_PROPERTY:
+        snetR->property(s0, i[0]);
+        break;
+      case DOUBLE_PROPERTY:
+        snetR->property(s0, op.number);
+        break;
+      case END:
+        snetR->end();
+        break;
+    }
+  }
+  return true;
+}
+
+}  // namespace odb
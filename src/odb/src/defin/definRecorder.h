@@ -0,0 +1,255 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "odb/dbTypes.h"
+#include "odb/odb.h"
+
+namespace odb {
+
+class definComponent;
+class definNet;
+class definReader;
+class definSNet;
+
+// Records the calls made on the component, net and special net interfaces
+// while a chunk of a DEF file is parsed on a worker thread so they can be
+// replayed into the database on the main thread, in file order.
+//
+// Each recorder has the methods of the interface it stands in for plus
+// error() and continuesOnErrors() from definReader, so the translation code
+// in definReader.cpp works unchanged on either.
+class definRecorder
+{
+ public:
+  explicit definRecorder(bool continue_on_errors)
+      : continue_on_errors_(continue_on_errors)
+  {
+  }
+
+  void error(std::string_view msg);
+  bool continuesOnErrors() const { return continue_on_errors_; }
+
+ protected:
+  static constexpr size_t no_string = std::numeric_limits<size_t>::max();
+  static constexpr int error_op = 0;
+
+  struct Op
+  {
+    int kind;
+    int ints[5];
+    size_t strings[2];
+    double number;
+  };
+
+  Op& add(int kind, const char* s0 = nullptr, const char* s1 = nullptr);
+  const char* string(size_t offset) const;
+  // Passes a recorded error on; returns false if the read must stop.
+  static bool replayError(const char* msg, definReader* reader);
+
+  std::vector<Op> ops_;
+
+ private:
+  size_t addString(const char* s);
+
+  std::string strings_;
+  bool continue_on_errors_;
+};
+
+class definComponentRecorder : public definRecorder
+{
+ public:
+  using definRecorder::definRecorder;
+
+  void begin(const char* name, const char* cell);
+  void placement(int status, int x, int y, int orient);
+  void region(const char* region);
+  void halo(int left, int bottom, int right, int top);
+  void source(dbSourceType source);
+  void weight(int weight);
+  void property(const char* name, const char* value);
+  void property(const char* name, int value);
+  void property(const char* name, double value);
+  void end();
+
+  // Returns false if an error stopped the replay.
+  bool replay(definComponent* componentR, definReader* reader) const;
+
+ private:
+  enum Kind
+  {
+    BEGIN = error_op + 1,
+    PLACEMENT,
+    REGION,
+    HALO,
+    SOURCE,
+    WEIGHT,
+    STRING_PROPERTY,
+    INT_PROPERTY,
+    DOUBLE_PROPERTY,
+    END
+  };
+};
+
+class definNetRecorder : public definRecorder
+{
+ public:
+  using definRecorder::definRecorder;
+
+  void begin(const char* name);
+  void beginMustjoin(const char* iname, const char* pname);
+  void connection(const char* iname, const char* pname);
+  void nonDefaultRule(const char* rule);
+  void use(dbSigType type);
+  void wire(dbWireType type);
+  void path(const char* layer);
+  void pathTaper(const char* layer);
+  void pathTaperRule(const char* layer, const char* rule);
+  void pathPoint(int x, int y);
+  void pathPoint(int x, int y, int ext);
+  void pathVia(const char* via);
+  void pathVia(const char* via, dbOrientType orient);
+  void pathRect(int deltaX1, int deltaY1, int deltaX2, int deltaY2);
+  void pathColor(int color);
+  void pathViaColor(int bottom_color, int cut_color, int top_color);
+  void pathEnd();
+  void wireEnd();
+  void source(dbSourceType source);
+  void weight(int weight);
+  void fixedbump();
+  void property(const char* name, const char* value);
+  void property(const char* name, int value);
+  void property(const char* name, double value);
+  void end();
+
+  // Returns false if an error stopped the replay.
+  bool replay(definNet* netR, definReader* reader) const;
+
+ private:
+  enum Kind
+  {
+    BEGIN = error_op + 1,
+    BEGIN_MUSTJOIN,
+    CONNECTION,
+    NON_DEFAULT_RULE,
+    USE,
+    WIRE,
+    PATH,
+    PATH_TAPER,
+    PATH_TAPER_RULE,
+    PATH_POINT,
+    PATH_POINT_EXT,
+    PATH_VIA,
+    PATH_VIA_ORIENT,
+    PATH_RECT,
+    PATH_COLOR,
+    PATH_VIA_COLOR,
+    PATH_END,
+    WIRE_END,
+    SOURCE,
+    WEIGHT,
+    FIXEDBUMP,
+    STRING_PROPERTY,
+    INT_PROPERTY,
+    DOUBLE_PROPERTY,
+    END
+  };
+};
+
+class definSNetRecorder : public definRecorder
+{
+ public:
+  using definRecorder::definRecorder;
+
+  void begin(const char* name);
+  void connection(const char* iname, const char* pname, bool synthesized);
+  void use(dbSigType type);
+  void rect(const char* layer,
+            int x1,
+            int y1,
+            int x2,
+            int y2,
+            const char* type,
+            uint mask);
+  void wire(dbWireType type, const char* shield);
+  void path(const char* layer, int width);
+  void pathShape(const char* type);
+  void pathPoint(int x, int y, uint mask);
+  void pathPoint(int x, int y, int ext, uint mask);
+  void pathVia(const char* via, uint bottom_mask, uint cut_mask, uint top_mask);
+  void pathViaArray(const char* via, int numX, int numY, int stepX, int stepY);
+  void pathEnd();
+  void wireEnd();
+  void source(dbSourceType source);
+  void weight(int weight);
+  void fixedbump();
+  void property(const char* name, const char* value);
+  void property(const char* name, int value);
+  void property(const char* name, double value);
+  void end();
+
+  // Returns false if an error stopped the replay.
+  bool replay(definSNet* snetR, definReader* reader) const;
+
+ private:
+  enum Kind
+  {
+    BEGIN = error_op + 1,
+    CONNECTION,
+    USE,
+    RECT,
+    WIRE,
+    PATH,
+    PATH_SHAPE,
+    PATH_POINT,
+    PATH_POINT_EXT,
+    PATH_VIA,
+    PATH_VIA_ARRAY,
+    PATH_END,
+    WIRE_END,
+    SOURCE,
+    WEIGHT,
+    FIXEDBUMP,
+    STRING_PROPERTY,
+    INT_PROPERTY,
+    DOUBLE_PROPERTY,
+    END
+  };
+};
+
+}  // namespace odb
@@ -0,0 +1,383 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "definSectionIndex.h"
+
+#include <algorithm>
+#include <cctype>
+
+namespace odb {
+
+namespace {
+
+// Splits DEF text into tokens the way defrData::DefGetToken does.
+class Scanner
+{
+ public:
+  explicit Scanner(std::string_view text) : text_(text) {}
+
+  // Returns false at the end of the text.  Comments are skipped.
+  bool next(std::string_view& token)
+  {
+    for (;;) {
+      while (pos_ < text_.size() && isBlank(text_[pos_])) {
+        if (text_[pos_] == '\n') {
+          ++line_;
+        }
+        ++pos_;
+      }
+      if (pos_ >= text_.size()) {
+        return false;
+      }
+
+      start_ = pos_;
+      if (text_[pos_] == '"') {
+        for (++pos_; pos_ < text_.size() && text_[pos_] != '"'; ++pos_) {
+          if (text_[pos_] == '\\') {
+            ++pos_;
+          } else if (text_[pos_] == '\n') {
+            ++line_;
+          }
+        }
+        pos_ = std::min(pos_ + 1, text_.size());
+      } else {
+        while (pos_ < text_.size() && !isBlank(text_[pos_])) {
+          ++pos_;
+        }
+      }
+
+      token = text_.substr(start_, pos_ - start_);
+      if (token[0] != '#') {
+        return true;
+      }
+      const size_t eol = text_.find('\n', pos_);
+      pos_ = eol == std::string_view::npos ? text_.size() : eol;
+    }
+  }
+
+  // Skips to the end of the current statement.
+  bool skipStatement(std::string_view token)
+  {
+    while (token != ";") {
+      if (!next(token)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // HISTORY text is taken raw up to a ';' following white space.
+  bool skipHistory()
+  {
+    char prev = ' ';
+    for (; pos_ < text_.size(); ++pos_) {
+      const char c = text_[pos_];
+      if (c == ';' && isBlank(prev)) {
+        ++pos_;
+        return true;
+      }
+      if (c == '\n') {
+        ++line_;
+      }
+      prev = c;
+    }
+    return false;
+  }
+
+  size_t start() const { return start_; }
+  size_t pos() const { return pos_; }
+  int line() const { return line_; }
+
+ private:
+  static bool isBlank(char c) { return c == ' ' || c == '\t' || c == '\n'; }
+
+  std::string_view text_;
+  size_t start_ = 0;
+  size_t pos_ = 0;
+  int line_ = 1;
+};
+
+// Keywords are case insensitive
+bool isKeyword(std::string_view token, std::string_view keyword)
+{
+  return std::equal(token.begin(),
+                    token.end(),
+                    keyword.begin(),
+                    keyword.end(),
+                    [](char a, char b) {
+                      return std::toupper(static_cast<unsigned char>(a)) == b;
+                    });
+}
+
+bool isHeaderStatement(std::string_view token)
+{
+  for (const char* keyword : {"VERSION",
+                              "NAMESCASESENSITIVE",
+                              "DIVIDERCHAR",
+                              "BUSBITCHARS",
+                              "DESIGN",
+                              "UNITS"}) {
+    if (isKeyword(token, keyword)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool findSection(std::string_view token, definSectionIndex::Section& section)
+{
+  for (auto candidate : {definSectionIndex::COMPONENTS,
+                         definSectionIndex::NETS,
+                         definSectionIndex::SPECIALNETS}) {
+    if (isKeyword(token, definSectionIndex::sectionName(candidate))) {
+      section = candidate;
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
+const char* definSectionIndex::sectionName(Section section)
+{
+  switch (section) {
+    case COMPONENTS:
+      return "COMPONENTS";
+    case NETS:
+      return "NETS";
+    case SPECIALNETS:
+      return "SPECIALNETS";
+  }
+  return "";
+}
+
+bool definSectionIndex::build(std::string_view text, int threads)
+{
+  text_ = text;
+  header_.clear();
+  gaps_.clear();
+  chunks_.clear();
+
+  const size_t chunk_size
+      = std::clamp(text.size() / (std::max(threads, 1) * 8),
+                   min_chunk_size_,
+                   max_chunk_size_);
+
+  Scanner scanner(text);
+  int seen_sections = 0;
+  std::string_view token;
+  while (scanner.next(token)) {
+    const size_t start = scanner.start();
+
+    if (token[0] == '&' || isKeyword(token, "BEGINEXT")) {
+      return false;
+    }
+
+    if (isKeyword(token, "HISTORY")) {
+      if (!scanner.skipHistory()) {
+        return false;
+      }
+      continue;
+    }
+
+    if (isKeyword(token, "END")) {
+      if (!scanner.next(token)) {
+        return false;
+      }
+      if (isKeyword(token, "DESIGN")) {
+        break;
+      }
+      continue;
+    }
+
+    if (isHeaderStatement(token)) {
+      if (!scanner.skipStatement(token)) {
+        return false;
+      }
+      header_.append(text.substr(start, scanner.pos() - start));
+      header_ += '\n';
+      continue;
+    }
+
+    if (isKeyword(token, "PROPERTYDEFINITIONS")) {
+      for (;;) {
+        if (!scanner.next(token)) {
+          return false;
+        }
+        if (isKeyword(token, "END")) {
+          if (!scanner.next(token)) {
+            return false;
+          }
+          break;
+        }
+        if (!scanner.skipStatement(token)) {
+          return false;
+        }
+      }
+      header_.append(text.substr(start, scanner.pos() - start));
+      header_ += '\n';
+      continue;
+    }
+
+    Section section;
+    if (!findSection(token, section)) {
+      if (!scanner.skipStatement(token)) {
+        return false;
+      }
+      continue;
+    }
+
+    // Each section must appear once so its chunks are contiguous.
+    if (seen_sections & (1 << section)) {
+      return false;
+    }
+    seen_sections |= 1 << section;
+
+    // "COMPONENTS <count> ;"
+    if (!scanner.next(token) || !scanner.next(token) || token != ";") {
+      return false;
+    }
+
+    const size_t items_start = scanner.pos();
+    const size_t first_chunk = chunks_.size();
+    Chunk chunk{section, {}, 0, 0};
+    size_t chunk_start = 0;
+    size_t body_end;
+    for (;;) {
+      if (!scanner.next(token)) {
+        return false;
+      }
+      if (token == "-") {
+        if (chunk.count == 0) {
+          chunk_start = scanner.start();
+          chunk.line = scanner.line();
+        }
+        if (!scanner.skipStatement(token)) {
+          return false;
+        }
+        ++chunk.count;
+        if (scanner.pos() - chunk_start >= chunk_size) {
+          chunk.items = text.substr(chunk_start, scanner.pos() - chunk_start);
+          chunks_.push_back(chunk);
+          chunk.count = 0;
+        }
+        continue;
+      }
+      if (isKeyword(token, "END")) {
+        body_end = scanner.start();
+        if (!scanner.next(token) || !isKeyword(token, sectionName(section))) {
+          return false;
+        }
+        break;
+      }
+      return false;
+    }
+
+    if (chunk.count > 0) {
+      chunk.items = text.substr(chunk_start, body_end - chunk_start);
+      chunks_.push_back(chunk);
+    }
+    if (chunks_.size() == first_chunk) {
+      continue;
+    }
+
+    const size_t newlines = std::count(
+        text.begin() + items_start, text.begin() + body_end, '\n');
+    gaps_.push_back({items_start, body_end, newlines});
+  }
+
+  header_lines_ = std::count(header_.begin(), header_.end(), '\n');
+  return true;
+}
+
+std::string definSectionIndex::chunkText(const Chunk& chunk) const
+{
+  const char* name = sectionName(chunk.section);
+
+  std::string text = header_;
+  text.reserve(text.size() + chunk.items.size() + 64);
+  text += name;
+  text += ' ';
+  text += std::to_string(chunk.count);
+  text += " ;\n";
+  text.append(chunk.items);
+  text += "\nEND ";
+  text += name;
+  text += "\nEND DESIGN\n";
+  return text;
+}
+
+int definSectionIndex::firstLine(const Chunk& chunk) const
+{
+  // The header and the section statement come before the items.  A header
+  // written on fewer lines in the file can't be numbered exactly.
+  return std::max(chunk.line - header_lines_ - 1, 1);
+}
+
+size_t definSectionIndex::Remainder::read(FILE* file,
+                                          char* buffer,
+                                          size_t size)
+{
+  return reinterpret_cast<Remainder*>(file)->fill(buffer, size);
+}
+
+size_t definSectionIndex::Remainder::fill(char* buffer, size_t size)
+{
+  const std::string_view text = index_.text_;
+  const std::vector<Gap>& gaps = index_.gaps_;
+  size_t filled = 0;
+  while (filled < size) {
+    if (newlines_ > 0) {
+      const size_t count = std::min(newlines_, size - filled);
+      std::fill_n(buffer + filled, count, '\n');
+      filled += count;
+      newlines_ -= count;
+    } else if (gap_ < gaps.size() && pos_ == gaps[gap_].begin) {
+      newlines_ = gaps[gap_].newlines;
+      pos_ = gaps[gap_].end;
+      ++gap_;
+    } else {
+      const size_t end = gap_ < gaps.size() ? gaps[gap_].begin : text.size();
+      if (pos_ == end) {
+        break;
+      }
+      const size_t count = std::min(end - pos_, size - filled);
+      text.copy(buffer + filled, count, pos_);
+      filled += count;
+      pos_ += count;
+    }
+  }
+  return filled;
+}
+
+}  // namespace odb
@@ -0,0 +1,126 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace odb {
+
+// Finds the COMPONENTS, NETS and SPECIALNETS sections of a DEF file held in
+// memory and cuts their items into chunks that can be parsed on their own.
+//
+// Only statement boundaries are looked for: tokens are split on white space
+// the way the DEF lexer does it, honoring quoted strings and '#' comments.
+// All of the syntax checking is still left to the parser.
+class definSectionIndex
+{
+ public:
+  enum Section
+  {
+    COMPONENTS,
+    NETS,
+    SPECIALNETS
+  };
+
+  struct Chunk
+  {
+    Section section;
+    std::string_view items;  // whole "- ... ;" statements
+    int count;               // number of items
+    int line;                // line number of the first item
+  };
+
+  // Streams the file with the items of the chunked sections left out, for
+  // the main parse.  The "COMPONENTS <count> ;" statements are kept as they
+  // are and the items are replaced by as many empty lines, so line numbers
+  // in messages still match.  read() is a DEF parser read function taking
+  // a Remainder in place of the FILE.
+  class Remainder
+  {
+   public:
+    explicit Remainder(const definSectionIndex& index) : index_(index) {}
+
+    static size_t read(FILE* file, char* buffer, size_t size);
+
+   private:
+    size_t fill(char* buffer, size_t size);
+
+    const definSectionIndex& index_;
+    size_t pos_ = 0;       // next byte of the text to copy
+    size_t gap_ = 0;       // next gap to skip
+    size_t newlines_ = 0;  // newlines left to emit for the last gap
+  };
+
+  // Returns false if the file uses something the index can't split safely
+  // (&ALIAS, BEGINEXT, unbalanced sections); it must then be parsed in one
+  // piece.  The text must outlive the index.
+  bool build(std::string_view text, int threads);
+
+  const std::vector<Chunk>& chunks() const { return chunks_; }
+
+  // The chunk as a complete DEF file: the header statements of the design
+  // (VERSION, DIVIDERCHAR, BUSBITCHARS, DESIGN, UNITS, PROPERTYDEFINITIONS)
+  // followed by a section holding only the items of the chunk.
+  std::string chunkText(const Chunk& chunk) const;
+
+  // The line number to give the first line of chunkText so that the items
+  // keep their line numbers in the file.
+  int firstLine(const Chunk& chunk) const;
+
+  static const char* sectionName(Section section);
+
+ private:
+  // The items of a chunked section
+  struct Gap
+  {
+    size_t begin;
+    size_t end;
+    size_t newlines;
+  };
+
+  // Bytes of items per chunk; enough chunks to balance the threads without
+  // paying for a parser start up on tiny pieces.
+  static constexpr size_t min_chunk_size_ = 64 * 1024;
+  static constexpr size_t max_chunk_size_ = 4 * 1024 * 1024;
+
+  std::string_view text_;
+  std::string header_;
+  int header_lines_ = 0;
+  std::vector<Gap> gaps_;
+  std::vector<Chunk> chunks_;
+};
+
+}  // namespace odb
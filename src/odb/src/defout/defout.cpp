@@ -75,6 +75,11 @@ void defout::setVersion(Version v)
   _writer->setVersion(v);
 }
 
+void defout::setThreads(int threads)
+{
+  _writer->setThreads(threads);
+}
+
 bool defout::writeBlock(dbBlock* block, const char* def_file)
 {
   return _writer->writeBlock(block, def_file);
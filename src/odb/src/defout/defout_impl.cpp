@@ -35,14 +35,18 @@
 #include <stdio.h>
 #include <sys/stat.h>
 
+#include <algorithm>
 #include <cstdint>
+#include <cstdlib>
 #include <limits>
 #include <optional>
 #include <set>
+#include <stdexcept>
 #include <string>
 
 #include "odb/db.h"
 #include "odb/dbMap.h"
+#include "odb/dbStream.h"
 #include "odb/dbWireCodec.h"
 #include "utl/Logger.h"
 #include "utl/ScopedTemporaryFile.h"
@@ -114,6 +118,66 @@ const char* defIoType(const dbIoType& type)
 
 }  // namespace
 
+// A FILE* whose output is collected in memory.
+class MemoryStream
+{
+ public:
+  MemoryStream() { open(); }
+  ~MemoryStream()
+  {
+    fclose(_file);
+    free(_data);
+  }
+  MemoryStream(const MemoryStream&) = delete;
+  MemoryStream& operator=(const MemoryStream&) = delete;
+
+  FILE* file() const { return _file; }
+
+  // Returns the text written so far and starts over with a new file().
+  std::string take()
+  {
+    fclose(_file);
+    std::string text(_data, _size);
+    free(_data);
+    open();
+    return text;
+  }
+
+ private:
+  void open()
+  {
+    _data = nullptr;
+    _size = 0;
+    _file = open_memstream(&_data, &_size);
+    if (!_file) {
+      throw std::runtime_error("Cannot allocate DEF output buffer");
+    }
+  }
+
+  char* _data;
+  size_t _size;
+  FILE* _file;
+};
+
+defout_impl::defout_impl(const defout_impl& parent, FILE* out)
+    : _dist_factor(parent._dist_factor),
+      _out(out),
+      _use_net_inst_ids(parent._use_net_inst_ids),
+      _use_master_ids(parent._use_master_ids),
+      _use_alias(parent._use_alias),
+      _select_net_map(parent._select_net_map),
+      _select_inst_map(parent._select_inst_map),
+      _non_default_rule(nullptr),
+      _version(parent._version),
+      _logger(parent._logger),
+      _threads(1),
+      _file(nullptr),
+      _text(nullptr)
+{
+  std::copy(
+      std::begin(parent._prop_defs), std::end(parent._prop_defs), _prop_defs);
+}
+
 void defout_impl::selectNet(dbNet* net)
 {
   if (!net) {
@@ -167,10 +231,13 @@ bool defout_impl::writeBlock(dbBlock* block, const char* def_file)
 
   _dist_factor
       = (double) block->getDefUnits() / (double) block->getDbUnitsPerMicron();
-  utl::FileHandler fileHandler(def_file);
-  _out = fileHandler.getFile();
+  const std::string file_name(def_file);
+  const bool gzip = file_name.size() > 3
+                    && file_name.compare(file_name.size() - 3, 3, ".gz") == 0;
+  utl::FileHandler fileHandler(def_file, gzip);
+  _file = fileHandler.getFile();
 
-  if (_out == nullptr) {
+  if (_file == nullptr) {
     _logger->warn(
         utl::ODB, 172, "Cannot open DEF file ({}) for writing", def_file);
     return false;
@@ -184,8 +251,19 @@ bool defout_impl::writeBlock(dbBlock* block, const char* def_file)
   //
   // The following lines enable IO buffering based on disk block size.
   struct stat stats;
-  fstat(fileno(_out), &stats);
-  setvbuf(_out, nullptr, _IOFBF, stats.st_blksize);
+  fstat(fileno(_file), &stats);
+  setvbuf(_file, nullptr, _IOFBF, stats.st_blksize);
+
+  // gzip output is compressed in independent members so that the large
+  // sections can be compressed in parallel by writeParallel.
+  std::optional<MemoryStream> text;
+  if (gzip) {
+    text.emplace();
+    _text = &*text;
+    _out = text->file();
+  } else {
+    _out = _file;
+  }
 
   if (_version == defout::DEF_5_3) {
     fprintf(_out, "VERSION 5.3 ;\n");
@@ -258,6 +336,9 @@ bool defout_impl::writeBlock(dbBlock* block, const char* def_file)
   writeScanChains(block);
 
   fprintf(_out, "END DESIGN\n");
+  flushOutput();
+  _text = nullptr;
+  _out = nullptr;
   {
     delete _select_net_map;
   }
@@ -531,13 +612,18 @@ void defout_impl::writeInsts(dbBlock* block)
   fprintf(_out, "COMPONENTS %u ;\n", insts.size());
 
   // Sort the components for consistent output
+  std::vector<dbInst*> selected;
   for (dbInst* inst : sortedSet(insts)) {
     if (_select_inst_map && !(*_select_inst_map)[inst]) {
       continue;
     }
-    writeInst(inst);
+    selected.push_back(inst);
   }
 
+  writeParallel(selected.size(), [&](defout_impl& writer, size_t i) {
+    writer.writeInst(selected[i]);
+  });
+
   fprintf(_out, "END COMPONENTS\n");
 }
 
@@ -1411,15 +1497,10 @@ void defout_impl::writeNets(dbBlock* block)
 {
   dbSet<dbNet> nets = block->getNets();
 
-  int net_cnt = 0;
-  int snet_cnt = 0;
+  std::vector<dbNet*> regular_nets;
+  std::vector<dbNet*> special_nets;
 
-  dbSet<dbNet>::iterator itr;
-  dbMap<dbNet, char> regular_net(nets);
-
-  auto sorted_nets = sortedSet(nets);
-
-  for (dbNet* net : sorted_nets) {
+  for (dbNet* net : sortedSet(nets)) {
     if (_select_net_map) {
       if (!(*_select_net_map)[net]) {
         continue;
@@ -1427,51 +1508,105 @@ void defout_impl::writeNets(dbBlock* block)
     }
 
     if (!net->isSpecial()) {
-      regular_net[net] = 1;
-      net_cnt++;
+      regular_nets.push_back(net);
     } else {
-      regular_net[net] = 0;
-      snet_cnt++;
+      special_nets.push_back(net);
 
       // Check for non-special iterms.
       for (dbITerm* iterm : net->getITerms()) {
         if (!iterm->isSpecial()) {
-          regular_net[net] = 1;
-          net_cnt++;
+          regular_nets.push_back(net);
           break;
         }
       }
     }
   }
 
-  if (snet_cnt > 0) {
-    fprintf(_out, "SPECIALNETS %d ;\n", snet_cnt);
+  if (!special_nets.empty()) {
+    fprintf(_out, "SPECIALNETS %d ;\n", (int) special_nets.size());
 
-    for (dbNet* net : sorted_nets) {
-      if (_select_net_map && !(*_select_net_map)[net]) {
-        continue;
-      }
-      if (net->isSpecial()) {
-        writeSNet(net);
-      }
-    }
+    writeParallel(special_nets.size(), [&](defout_impl& writer, size_t i) {
+      writer.writeSNet(special_nets[i]);
+    });
 
     fprintf(_out, "END SPECIALNETS\n");
   }
 
-  fprintf(_out, "NETS %d ;\n", net_cnt);
+  fprintf(_out, "NETS %d ;\n", (int) regular_nets.size());
 
-  for (dbNet* net : sorted_nets) {
-    if (_select_net_map && !(*_select_net_map)[net]) {
-      continue;
+  writeParallel(regular_nets.size(), [&](defout_impl& writer, size_t i) {
+    writer.writeNet(regular_nets[i]);
+  });
+
+  fprintf(_out, "END NETS\n");
+}
+
+// Writes count objects with write, which is called with a worker that has
+// its own output and non default rule state.  The objects are formatted on
+// _threads threads in batches and the text is written in order.
+void defout_impl::writeParallel(
+    size_t count,
+    const std::function<void(defout_impl& writer, size_t index)>& write)
+{
+  if (_threads <= 1 && _text == nullptr) {
+    for (size_t i = 0; i < count; ++i) {
+      write(*this, i);
     }
+    return;
+  }
 
-    if (regular_net[net] == 1) {
-      writeNet(net);
+  flushOutput();
+
+  const int threads = std::max(_threads, 1);
+  const size_t batch_size
+      = std::clamp<size_t>(count / (threads * 16), 64, 4096);
+  // Bounds the memory held by formatted batches that are not written yet.
+  const size_t window = batch_size * threads * 4;
+
+  for (size_t start = 0; start < count; start += window) {
+    const size_t end = std::min(start + window, count);
+    std::vector<std::string> buffers((end - start + batch_size - 1)
+                                     / batch_size);
+    std::vector<std::function<void()>> jobs;
+    jobs.reserve(buffers.size());
+    for (size_t b = 0; b < buffers.size(); ++b) {
+      jobs.emplace_back([&, b]() {
+        MemoryStream stream;
+        defout_impl writer(*this, stream.file());
+        const size_t first = start + b * batch_size;
+        const size_t last = std::min(first + batch_size, end);
+        for (size_t i = first; i < last; ++i) {
+          write(writer, i);
+        }
+        std::string text = stream.take();
+        if (_text) {
+          buffers[b] = dbGzipCompress(text.data(), text.size());
+        } else {
+          buffers[b] = std::move(text);
+        }
+      });
+    }
+    dbRunJobs(jobs, threads);
+
+    for (const std::string& buffer : buffers) {
+      fwrite(buffer.data(), 1, buffer.size(), _file);
     }
   }
+}
 
-  fprintf(_out, "END NETS\n");
+// Compresses the text collected for gzip output so far.  Nothing to do
+// for plain output as _out is the file itself.
+void defout_impl::flushOutput()
+{
+  if (_text == nullptr) {
+    return;
+  }
+  const std::string text = _text->take();
+  _out = _text->file();
+  if (!text.empty()) {
+    const std::string compressed = dbGzipCompress(text.data(), text.size());
+    fwrite(compressed.data(), 1, compressed.size(), _file);
+  }
 }
 
 void defout_impl::writeSNet(dbNet* net)
@@ -32,6 +32,8 @@
 
 #pragma once
 
+#include <cstddef>
+#include <functional>
 #include <list>
 #include <map>
 #include <string>
@@ -51,6 +53,7 @@ class dbBTerm;
 class dbInst;
 class dbTechNonDefaultRule;
 class dbTechLayerRule;
+class MemoryStream;
 
 class defout_impl
 {
@@ -80,6 +83,15 @@ class defout_impl
   int _version;
   std::map<std::string, bool> _prop_defs[9];
   utl::Logger* _logger;
+  int _threads;
+  // The output file.  _out is the same file unless the output is gzip
+  // compressed, in which case _out collects text in _text until it is
+  // compressed by flushOutput().
+  FILE* _file;
+  MemoryStream* _text;
+
+  // Worker formatting objects for parent into out
+  defout_impl(const defout_impl& parent, FILE* out);
 
   int defdist(int value) { return (int) (((double) value) * _dist_factor); }
 
@@ -106,6 +118,10 @@ class defout_impl
   void writeBlockages(dbBlock* block);
   void writeFills(dbBlock* block);
   void writeNets(dbBlock* block);
+  void writeParallel(
+      size_t count,
+      const std::function<void(defout_impl& writer, size_t index)>& write);
+  void flushOutput();
   void writeNet(dbNet* net);
   void writeSNet(dbNet* net);
   void writeWire(dbWire* wire);
@@ -129,6 +145,9 @@ class defout_impl
     _non_default_rule = nullptr;
     _version = defout::DEF_5_8;
     _logger = logger;
+    _threads = 1;
+    _file = nullptr;
+    _text = nullptr;
   }
 
   ~defout_impl() = default;
@@ -143,6 +162,7 @@ class defout_impl
 
   void selectInst(dbInst* inst);
   void setVersion(int v) { _version = v; }
+  void setThreads(int threads) { _threads = threads; }
 
   bool writeBlock(dbBlock* block, const char* def_file);
 };
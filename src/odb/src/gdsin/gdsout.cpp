@@ -32,6 +32,9 @@
 
 #include "odb/gdsout.h"
 
+#include <algorithm>
+#include <ctime>
+#include <functional>
 #include <iostream>
 
 #include "../db/dbGDSBoundary.h"
@@ -43,11 +46,12 @@
 #include "../db/dbGDSSRef.h"
 #include "../db/dbGDSStructure.h"
 #include "../db/dbGDSText.h"
+#include "odb/dbStream.h"
 
 namespace odb {
 namespace gds {
 
-GDSWriter::GDSWriter() : _lib(nullptr)
+GDSWriter::GDSWriter() : _gzip(false), _lib(nullptr)
 {
 }
 
@@ -58,20 +62,45 @@ GDSWriter::~GDSWriter()
   }
 }
 
-void GDSWriter::write_gds(dbGDSLib* lib, const std::string& filename)
+void GDSWriter::write_gds(dbGDSLib* lib,
+                          const std::string& filename,
+                          int num_threads)
 {
   _lib = lib;
+  _gzip = filename.size() > 3
+          && filename.compare(filename.size() - 3, 3, ".gz") == 0;
   _file.open(filename, std::ios::binary);
   if (!_file) {
     throw std::runtime_error("Could not open file");
   }
-  writeLib();
+
+  std::time_t now = std::time(nullptr);
+  std::tm lt;
+  localtime_r(&now, &lt);
+  _timestamp = {(int16_t) lt.tm_year,
+                (int16_t) lt.tm_mon,
+                (int16_t) lt.tm_mday,
+                (int16_t) lt.tm_hour,
+                (int16_t) lt.tm_min,
+                (int16_t) lt.tm_sec};
+  _timestamp.insert(_timestamp.end(), _timestamp.begin(), _timestamp.end());
+
+  writeLib(num_threads);
   if (_file.is_open()) {
     _file.close();
   }
   _lib = nullptr;
 }
 
+void GDSWriter::flushBuffer()
+{
+  if (_gzip) {
+    _buffer = dbGzipCompress(_buffer.data(), _buffer.size());
+  }
+  _file.write(_buffer.data(), _buffer.size());
+  _buffer.clear();
+}
+
 void GDSWriter::calcRecSize(record_t& r)
 {
   r.length = 4;
@@ -93,24 +122,24 @@ void GDSWriter::calcRecSize(record_t& r)
 void GDSWriter::writeReal8(double real)
 {
   uint64_t value = htobe64(double_to_real8(real));
-  _file.write(reinterpret_cast<char*>(&value), sizeof(uint64_t));
+  _buffer.append(reinterpret_cast<char*>(&value), sizeof(uint64_t));
 }
 
 void GDSWriter::writeInt32(int32_t i)
 {
   int32_t value = htobe32(i);
-  _file.write(reinterpret_cast<char*>(&value), sizeof(int32_t));
+  _buffer.append(reinterpret_cast<char*>(&value), sizeof(int32_t));
 }
 
 void GDSWriter::writeInt16(int16_t i)
 {
   int16_t value = htobe16(i);
-  _file.write(reinterpret_cast<char*>(&value), sizeof(int16_t));
+  _buffer.append(reinterpret_cast<char*>(&value), sizeof(int16_t));
 }
 
 void GDSWriter::writeInt8(int8_t i)
 {
-  _file.write(reinterpret_cast<char*>(&i), sizeof(int8_t));
+  _buffer.push_back(static_cast<char>(i));
 }
 
 void GDSWriter::writeRecord(record_t& r)
@@ -134,11 +163,20 @@ void GDSWriter::writeRecord(record_t& r)
     }
   } else if (r.dataType == DataType::ASCII_STRING
              || r.dataType == DataType::BIT_ARRAY) {
-    _file.write(r.data8.c_str(), r.data8.size());
+    _buffer.append(r.data8);
   }
 }
 
-void GDSWriter::writeLib()
+void GDSWriter::writeTimestamp(RecordType type)
+{
+  record_t r;
+  r.type = type;
+  r.dataType = DataType::INT_2;
+  r.data16 = _timestamp;
+  writeRecord(r);
+}
+
+void GDSWriter::writeLib(int num_threads)
 {
   record_t rh;
   rh.type = RecordType::HEADER;
@@ -146,25 +184,7 @@ void GDSWriter::writeLib()
   rh.data16 = {600};
   writeRecord(rh);
 
-  record_t r;
-  r.type = RecordType::BGNLIB;
-  r.dataType = DataType::INT_2;
-
-  std::time_t now = std::time(nullptr);
-  std::tm* lt = std::localtime(&now);
-  r.data16 = {(int16_t) lt->tm_year,
-              (int16_t) lt->tm_mon,
-              (int16_t) lt->tm_mday,
-              (int16_t) lt->tm_hour,
-              (int16_t) lt->tm_min,
-              (int16_t) lt->tm_sec,
-              (int16_t) lt->tm_year,
-              (int16_t) lt->tm_mon,
-              (int16_t) lt->tm_mday,
-              (int16_t) lt->tm_hour,
-              (int16_t) lt->tm_min,
-              (int16_t) lt->tm_sec};
-  writeRecord(r);
+  writeTimestamp(RecordType::BGNLIB);
 
   record_t r2;
   r2.type = RecordType::LIBNAME;
@@ -180,38 +200,65 @@ void GDSWriter::writeLib()
   r3.data64 = {units.first, units.second};
   writeRecord(r3);
 
-  auto structures = _lib->getGDSStructures();
-  for (auto s : structures) {
-    writeStruct(s);
-  }
+  flushBuffer();
+  writeStructs(num_threads);
 
   record_t r4;
   r4.type = RecordType::ENDLIB;
   r4.dataType = DataType::NO_DATA;
   writeRecord(r4);
+  flushBuffer();
 }
 
-void GDSWriter::writeStruct(dbGDSStructure* str)
+void GDSWriter::writeStructs(int num_threads)
 {
-  record_t r;
-  r.type = RecordType::BGNSTR;
-  r.dataType = DataType::INT_2;
+  std::vector<dbGDSStructure*> strs;
+  for (auto s : _lib->getGDSStructures()) {
+    strs.push_back(s);
+  }
 
-  std::time_t now = std::time(nullptr);
-  std::tm* lt = std::localtime(&now);
-  r.data16 = {(int16_t) lt->tm_year,
-              (int16_t) lt->tm_mon,
-              (int16_t) lt->tm_mday,
-              (int16_t) lt->tm_hour,
-              (int16_t) lt->tm_min,
-              (int16_t) lt->tm_sec,
-              (int16_t) lt->tm_year,
-              (int16_t) lt->tm_mon,
-              (int16_t) lt->tm_mday,
-              (int16_t) lt->tm_hour,
-              (int16_t) lt->tm_min,
-              (int16_t) lt->tm_sec};
-  writeRecord(r);
+  // Structures are formatted in batches, a window of batches at a time to
+  // bound the memory held by the buffers, and written in order.
+  const int threads = std::max(num_threads, 1);
+  const size_t batch_size
+      = std::clamp<size_t>(strs.size() / (threads * 16), 1, 256);
+  const size_t window = batch_size * threads * 4;
+
+  for (size_t start = 0; start < strs.size(); start += window) {
+    const size_t end = std::min(start + window, strs.size());
+    std::vector<std::string> buffers((end - start + batch_size - 1)
+                                     / batch_size);
+    std::vector<std::function<void()>> jobs;
+    jobs.reserve(buffers.size());
+    for (size_t i = 0; i < buffers.size(); ++i) {
+      jobs.emplace_back([&, i]() {
+        GDSWriter worker;
+        worker._lib = _lib;
+        worker._timestamp = _timestamp;
+        const size_t first = start + i * batch_size;
+        const size_t last = std::min(first + batch_size, end);
+        for (size_t j = first; j < last; ++j) {
+          worker.writeStruct(strs[j]);
+        }
+        if (_gzip) {
+          buffers[i] = dbGzipCompress(worker._buffer.data(),
+                                      worker._buffer.size());
+        } else {
+          buffers[i] = std::move(worker._buffer);
+        }
+      });
+    }
+    dbRunJobs(jobs, threads);
+
+    for (const std::string& buffer : buffers) {
+      _file.write(buffer.data(), buffer.size());
+    }
+  }
+}
+
+void GDSWriter::writeStruct(dbGDSStructure* str)
+{
+  writeTimestamp(RecordType::BGNSTR);
 
   record_t r2;
   r2.type = RecordType::STRNAME;
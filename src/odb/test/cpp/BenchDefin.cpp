@@ -0,0 +1,97 @@
+// Throughput of the DEF reader on generated designs, serial against
+// parallel.  Usage: BenchDefin [threads [num_insts...]]
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "env.h"
+#include "helper.h"
+#include "odb/db.h"
+#include "odb/defin.h"
+#include "odb/lefin.h"
+#include "utl/Logger.h"
+
+namespace {
+
+utl::Logger logger;
+
+// Seconds taken to read the DEF
+double readDef(const std::string& def_path, int threads)
+{
+  odb::dbDatabase* db = odb::dbDatabase::create();
+  db->setLogger(&logger);
+  odb::lefin lef_reader(db, &logger, false);
+  const std::string lef_path = odb::testTmpPath("Nangate45", "Nangate45.lef");
+  odb::dbLib* lib = lef_reader.createTechAndLib(
+      "Nangate45", "Nangate45", lef_path.c_str());
+
+  odb::defin def_reader(db, &logger);
+  def_reader.setThreads(threads);
+  std::vector<odb::dbLib*> libs{lib};
+  const auto start = std::chrono::steady_clock::now();
+  def_reader.createChip(libs, def_path.c_str(), lib->getTech());
+  const std::chrono::duration<double> elapsed
+      = std::chrono::steady_clock::now() - start;
+
+  odb::dbDatabase::destroy(db);
+  return elapsed.count();
+}
+
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+  const int threads
+      = argc > 1 ? std::stoi(argv[1]) : std::thread::hardware_concurrency();
+  std::vector<int> sizes;
+  for (int i = 2; i < argc; ++i) {
+    sizes.push_back(std::stoi(argv[i]));
+  }
+  if (sizes.empty()) {
+    sizes = {100000, 1000000};
+  }
+
+  struct Row
+  {
+    int num_insts;
+    double mbytes;
+    double serial;
+    double parallel;
+  };
+  std::vector<Row> rows;
+  for (int num_insts : sizes) {
+    const std::string path
+        = (std::filesystem::temp_directory_path() / "BenchDefin.def").string();
+    const std::string def = odb::createSyntheticDef(num_insts);
+    std::ofstream(path) << def;
+
+    const double mbytes = def.size() / 1e6;
+    const double serial = readDef(path, 1);
+    const double parallel = readDef(path, threads);
+    rows.push_back({num_insts, mbytes, serial, parallel});
+    std::filesystem::remove(path);
+  }
+
+  printf("%10s %10s %10s %10s %10s %8s\n",
+         "insts",
+         "MB",
+         "serial s",
+         "MB/s",
+         "parallel s",
+         "MB/s");
+  for (const Row& row : rows) {
+    printf("%10d %10.1f %10.2f %10.1f %10.2f %8.1f\n",
+           row.num_insts,
+           row.mbytes,
+           row.serial,
+           row.mbytes / row.serial,
+           row.parallel,
+           row.mbytes / row.parallel);
+  }
+  printf("threads: %d\n", threads);
+  return 0;
+}
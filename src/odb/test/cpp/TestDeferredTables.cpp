@@ -0,0 +1,165 @@
+#define BOOST_TEST_MODULE TestDeferredTables
+#include <boost/test/included/unit_test.hpp>
+#include <fstream>
+#include <sstream>
+
+#include "env.h"
+#include "helper.h"
+#include "odb/db.h"
+#include "odb/dbStream.h"
+#include "odb/dbWireCodec.h"
+#include "utl/Logger.h"
+
+namespace odb {
+namespace {
+
+utl::Logger logger;
+
+void writeDb(dbDatabase* db, const std::string& path, int num_threads = 1)
+{
+  std::ofstream write;
+  write.exceptions(std::ifstream::failbit | std::ifstream::badbit
+                   | std::ios::eofbit);
+  write.open(path, std::ios::binary);
+  db->write(write, num_threads);
+}
+
+dbDatabase* createRoutedDB()
+{
+  dbDatabase* db = createSimpleDB();
+  db->setLogger(&logger);
+  auto block = db->getChip()->getBlock();
+  auto layer = db->getTech()->findLayer("L1");
+
+  auto net = dbNet::create(block, "n1");
+  dbGuide::create(net, layer, {0, 0, 100, 100});
+  dbGuide::create(net, layer, {0, 100, 100, 200});
+
+  dbWire* wire = dbWire::create(net);
+  dbWireEncoder encoder;
+  encoder.begin(wire);
+  encoder.newPath(layer, dbWireType::ROUTED);
+  encoder.addPoint(50, 50);
+  encoder.addPoint(100, 50);
+  encoder.end();
+
+  auto vdd = dbNet::create(block, "vdd");
+  vdd->setSpecial();
+  dbSWire* swire = dbSWire::create(vdd, dbWireType::ROUTED);
+  dbSBox::create(swire,
+                 layer,
+                 0,
+                 0,
+                 1000,
+                 20,
+                 dbWireShapeType::STRIPE,
+                 dbSBox::HORIZONTAL);
+  return db;
+}
+
+void checkRoutedDB(dbDatabase* db)
+{
+  auto block = db->getChip()->getBlock();
+
+  auto net = block->findNet("n1");
+  BOOST_TEST(net->getGuides().size() == 2);
+  BOOST_TEST(net->getWire() != nullptr);
+  auto bbox = net->getWire()->getBBox();
+  BOOST_TEST(bbox.has_value());
+  BOOST_TEST(bbox->xMax() >= 100);
+
+  auto vdd = block->findNet("vdd");
+  BOOST_TEST(vdd->getSWires().size() == 1);
+  dbSWire* swire = *vdd->getSWires().begin();
+  BOOST_TEST(swire->getWires().size() == 1);
+  BOOST_TEST((*swire->getWires().begin())->getBox() == Rect(0, 0, 1000, 20));
+}
+
+BOOST_AUTO_TEST_SUITE(test_suite)
+
+BOOST_AUTO_TEST_CASE(test_read_mapped)
+{
+  dbDatabase* db = createRoutedDB();
+  std::string path = testTmpPath("results", "TestDeferredTablesDbRW");
+  writeDb(db, path);
+  dbDatabase::destroy(db);
+
+  dbDatabase* db2 = dbDatabase::create();
+  db2->setLogger(&logger);
+  db2->readMapped(path.c_str());
+  BOOST_TEST(db2->getChip()->getBlock()->getNets().size() == 2);
+  checkRoutedDB(db2);
+  dbDatabase::destroy(db2);
+}
+
+BOOST_AUTO_TEST_CASE(test_write_unloaded)
+{
+  // Tables that were never accessed are copied through unchanged.
+  dbDatabase* db = createRoutedDB();
+  std::string path = testTmpPath("results", "TestDeferredTablesDbRW1");
+  writeDb(db, path);
+  dbDatabase::destroy(db);
+
+  dbDatabase* db2 = dbDatabase::create();
+  db2->setLogger(&logger);
+  db2->readMapped(path.c_str());
+  std::string path2 = testTmpPath("results", "TestDeferredTablesDbRW2");
+  writeDb(db2, path2);
+  dbDatabase::destroy(db2);
+
+  dbDatabase* db3 = dbDatabase::create();
+  std::ifstream read;
+  read.exceptions(std::ifstream::failbit | std::ifstream::badbit
+                  | std::ios::eofbit);
+  read.open(path2.c_str(), std::ios::binary);
+  db3->read(read);
+  checkRoutedDB(db3);
+  dbDatabase::destroy(db3);
+}
+
+BOOST_AUTO_TEST_CASE(test_parallel)
+{
+  dbDatabase* db = createRoutedDB();
+  std::string path = testTmpPath("results", "TestDeferredTablesDbRW3");
+  writeDb(db, path, 4);
+  dbDatabase::destroy(db);
+
+  dbDatabase* db2 = dbDatabase::create();
+  std::ifstream read;
+  read.exceptions(std::ifstream::failbit | std::ifstream::badbit
+                  | std::ios::eofbit);
+  read.open(path.c_str(), std::ios::binary);
+  db2->read(read, 4);
+  checkRoutedDB(db2);
+  dbDatabase::destroy(db2);
+}
+
+BOOST_AUTO_TEST_CASE(test_corrupt_section)
+{
+  dbDatabase* db = createRoutedDB();
+  auto db_impl = reinterpret_cast<_dbDatabase*>(db);
+  const std::string payload(100000, 'x');
+
+  std::stringstream buffer;
+  dbOStream out(db_impl, buffer);
+  out.writeSection(nullptr, [&](dbOStream& s) { s << payload; });
+
+  dbIStream in(db_impl, buffer);
+  dbStreamSection section = in.readSection();
+  BOOST_TEST(section.compressed);
+  BOOST_TEST(section.size < payload.size());
+
+  std::string scratch;
+  auto [data, size] = section.decode(scratch);
+  BOOST_TEST(data != nullptr);
+  BOOST_TEST(size == section.raw_size);
+
+  const_cast<char*>(section.data)[section.size / 2] ^= 0xff;
+  BOOST_CHECK_THROW(section.decode(scratch), std::runtime_error);
+  dbDatabase::destroy(db);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace
+}  // namespace odb
@@ -0,0 +1,190 @@
+#define BOOST_TEST_MODULE TestDefinParallel
+#include <unistd.h>
+
+#include <algorithm>
+#include <boost/test/included/unit_test.hpp>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "env.h"
+#include "helper.h"
+#include "odb/db.h"
+#include "odb/defin.h"
+#include "odb/defout.h"
+#include "odb/lefin.h"
+#include "utl/Logger.h"
+
+namespace odb {
+namespace {
+
+utl::Logger logger;
+
+constexpr int num_insts = 20000;
+
+void writeFile(const std::string& path, const std::string& text)
+{
+  std::ofstream out(path);
+  out << text;
+}
+
+std::string readFile(const std::string& path)
+{
+  std::ifstream in(path);
+  std::stringstream text;
+  text << in.rdbuf();
+  return text.str();
+}
+
+// Runs read and returns what the DEF parser printed to stderr.
+std::string captureStderr(const std::string& name,
+                          const std::function<void()>& read)
+{
+  const std::string path = testTmpPath("results", name);
+  std::fflush(stderr);
+  const int saved = dup(STDERR_FILENO);
+  FILE* file = std::fopen(path.c_str(), "w");
+  dup2(fileno(file), STDERR_FILENO);
+  try {
+    read();
+  } catch (const std::exception&) {
+  }
+  std::fflush(stderr);
+  dup2(saved, STDERR_FILENO);
+  close(saved);
+  std::fclose(file);
+  return readFile(path);
+}
+
+dbDatabase* readDef(const std::string& def_path, int threads)
+{
+  dbDatabase* db = dbDatabase::create();
+  db->setLogger(&logger);
+  lefin lef_reader(db, &logger, false);
+  const std::string lef_path = testTmpPath("Nangate45", "Nangate45.lef");
+  dbLib* lib = lef_reader.createTechAndLib(
+      "Nangate45", "Nangate45", lef_path.c_str());
+
+  defin def_reader(db, &logger);
+  def_reader.setThreads(threads);
+  std::vector<dbLib*> libs{lib};
+  def_reader.createChip(libs, def_path.c_str(), lib->getTech());
+  return db;
+}
+
+std::string writeDef(dbDatabase* db, const std::string& name, int threads = 1)
+{
+  const std::string path = testTmpPath("results", name);
+  defout writer(&logger);
+  writer.setThreads(threads);
+  writer.writeBlock(db->getChip()->getBlock(), path.c_str());
+  return readFile(path);
+}
+
+BOOST_AUTO_TEST_SUITE(test_suite)
+
+BOOST_AUTO_TEST_CASE(test_matches_serial)
+{
+  const std::string path = testTmpPath("results", "TestDefinParallel.def");
+  writeFile(path, createSyntheticDef(num_insts));
+
+  dbDatabase* serial = readDef(path, 1);
+  dbDatabase* parallel = readDef(path, 4);
+  dbBlock* serial_block = serial->getChip()->getBlock();
+  dbBlock* parallel_block = parallel->getChip()->getBlock();
+
+  BOOST_TEST(parallel_block->getInsts().size() == num_insts);
+  // n_in, the chain and the two supplies
+  BOOST_TEST(parallel_block->getNets().size() == num_insts + 2);
+
+  // Objects are created in file order whatever the thread count
+  for (dbInst* inst : serial_block->getInsts()) {
+    dbInst* other = parallel_block->findInst(inst->getName().c_str());
+    BOOST_REQUIRE(other != nullptr);
+    BOOST_TEST(other->getId() == inst->getId());
+  }
+  for (dbNet* net : serial_block->getNets()) {
+    dbNet* other = parallel_block->findNet(net->getName().c_str());
+    BOOST_REQUIRE(other != nullptr);
+    BOOST_TEST(other->getId() == net->getId());
+  }
+
+  BOOST_TEST(writeDef(serial, "TestDefinParallelSerial.def")
+             == writeDef(parallel, "TestDefinParallelParallel.def"));
+
+  dbDatabase::destroy(serial);
+  dbDatabase::destroy(parallel);
+}
+
+BOOST_AUTO_TEST_CASE(test_errors_in_chunks)
+{
+  const std::string def = createSyntheticDef(num_insts);
+
+  // A semantic error found while committing a chunk
+  std::string unknown_master = def;
+  const size_t master = unknown_master.find("- u12345 BUF_X1");
+  BOOST_REQUIRE(master != std::string::npos);
+  unknown_master.replace(master, 15, "- u12345 NOPE_X1");
+  const std::string master_path
+      = testTmpPath("results", "TestDefinParallelMaster.def");
+  writeFile(master_path, unknown_master);
+  BOOST_CHECK_THROW(readDef(master_path, 4), std::exception);
+
+  // A syntax error found by a worker
+  std::string bad_syntax = def;
+  const size_t net = bad_syntax.find("- n15000 ( u15000 Z )");
+  BOOST_REQUIRE(net != std::string::npos);
+  bad_syntax.replace(net, 21, "- n15000 ( u15000 Z ");
+  const std::string syntax_path
+      = testTmpPath("results", "TestDefinParallelSyntax.def");
+  writeFile(syntax_path, bad_syntax);
+  BOOST_CHECK_THROW(readDef(syntax_path, 4), std::exception);
+}
+
+BOOST_AUTO_TEST_CASE(test_error_line_numbers)
+{
+  std::string def = createSyntheticDef(num_insts);
+  const size_t net = def.find("- n15000 ( u15000 Z )");
+  BOOST_REQUIRE(net != std::string::npos);
+  def.replace(net, 21, "- n15000 ( u15000 Z ");
+  const std::string path
+      = testTmpPath("results", "TestDefinParallelLines.def");
+  writeFile(path, def);
+
+  // Messages from a chunk give the line in the file, as the serial reader
+  const int line = std::count(def.begin(), def.begin() + net, '\n') + 1;
+  const std::string message = fmt::format("file {} at line {},", path, line);
+  const std::string serial = captureStderr("TestDefinSerialLines.log",
+                                           [&]() { readDef(path, 1); });
+  const std::string parallel = captureStderr("TestDefinParallelLines.log",
+                                             [&]() { readDef(path, 4); });
+  BOOST_TEST(serial.find(message) != std::string::npos);
+  BOOST_TEST(parallel.find(message) != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(test_writer_matches_serial)
+{
+  const std::string path = testTmpPath("results", "TestDefoutParallel.def");
+  writeFile(path, createSyntheticDef(num_insts));
+  dbDatabase* db = readDef(path, 1);
+
+  const std::string serial = writeDef(db, "TestDefoutSerial.def");
+  BOOST_TEST(writeDef(db, "TestDefoutThreads.def", 4) == serial);
+
+  // Compressed in independent gzip members
+  writeDef(db, "TestDefoutThreads.def.gz", 4);
+  dbDatabase* gzip_db
+      = readDef(testTmpPath("results", "TestDefoutThreads.def.gz"), 1);
+  BOOST_TEST(writeDef(gzip_db, "TestDefoutGzip.def") == serial);
+
+  dbDatabase::destroy(db);
+  dbDatabase::destroy(gzip_db);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace
+}  // namespace odb
@@ -103,6 +103,44 @@ BOOST_AUTO_TEST_CASE(writer)
   BOOST_TEST(text->getTransform()._angle == 90);
 }
 
+BOOST_AUTO_TEST_CASE(parallel_writer)
+{
+  dbDatabase* db = dbDatabase::create();
+  dbGDSLib* lib = createEmptyGDSLib(db, "parallel_lib");
+
+  constexpr int num_structures = 1000;
+  for (int i = 0; i < num_structures; ++i) {
+    dbGDSStructure* str
+        = createEmptyGDSStructure(lib, "str" + std::to_string(i));
+    dbGDSBox* box = createEmptyGDSBox(db);
+    box->setLayer(i % 100);
+    box->setDatatype(0);
+    box->getXY().emplace_back(0, 0);
+    box->getXY().emplace_back(i, i);
+    str->addElement(box);
+  }
+  stampGDSLib(lib);
+
+  std::string outpath = testTmpPath("results", "parallel_test_out.gds");
+  GDSWriter writer;
+  writer.write_gds(lib, outpath, 4);
+
+  GDSReader reader;
+  dbGDSLib* lib2 = reader.read_gds(outpath, db);
+
+  // Structures are written in order whatever the thread count
+  BOOST_TEST(lib2->getGDSStructures().size() == num_structures);
+  int i = 0;
+  for (dbGDSStructure* str : lib2->getGDSStructures()) {
+    BOOST_TEST(str->getName() == "str" + std::to_string(i));
+    BOOST_REQUIRE(str->getNumElements() == 1);
+    dbGDSElement* el = str->getElement(0);
+    BOOST_TEST(el->getLayer() == i % 100);
+    BOOST_TEST(el->getXY()[1].x() == i);
+    ++i;
+  }
+}
+
 BOOST_AUTO_TEST_CASE(edit)
 {
   dbDatabase* db = dbDatabase::create();
@@ -32,6 +32,9 @@
 
 #include "helper.h"
 
+#include <algorithm>
+#include <cmath>
+
 #include "odb/db.h"
 #include "utl/Logger.h"
 
@@ -117,4 +120,88 @@ dbDatabase* create2LevetDbWithBTerms()
   return db;
 }
 
+std::string createSyntheticDef(int num_insts)
+{
+  constexpr int cell_pitch = 2280;  // BUF_X1 is 1140 dbu wide
+  constexpr int row_height = 2800;
+  const int cols = std::max(1, (int) std::sqrt(num_insts));
+  const int rows = (num_insts + cols - 1) / cols;
+  const int width = cols * cell_pitch;
+  const int height = rows * row_height;
+
+  std::string def;
+  def += "VERSION 5.8 ;\n";
+  def += "DIVIDERCHAR \"/\" ;\n";
+  def += "BUSBITCHARS \"[]\" ;\n";
+  def += "DESIGN synthetic ;\n";
+  def += "UNITS DISTANCE MICRONS 2000 ;\n";
+  def += "PROPERTYDEFINITIONS\n";
+  def += "  COMPONENT weight INTEGER ;\n";
+  def += "END PROPERTYDEFINITIONS\n";
+  def += fmt::format("DIEAREA ( 0 0 ) ( {} {} ) ;\n", width, height);
+
+  auto x = [&](int i) { return (i % cols) * cell_pitch; };
+  auto y = [&](int i) { return (i / cols) * row_height; };
+
+  def += fmt::format("COMPONENTS {} ;\n", num_insts);
+  for (int i = 0; i < num_insts; ++i) {
+    def += fmt::format("- u{} BUF_X1 + PLACED ( {} {} ) {}",
+                       i,
+                       x(i),
+                       y(i),
+                       (i / cols) % 2 ? "FS" : "N");
+    if (i % 10 == 0) {
+      def += fmt::format(" + PROPERTY weight {}", i);
+    }
+    def += " ;\n";
+  }
+  def += "END COMPONENTS\n";
+
+  def += "PINS 1 ;\n";
+  def += "- in + NET n_in + DIRECTION INPUT + USE SIGNAL ;\n";
+  def += "END PINS\n";
+
+  def += "SPECIALNETS 2 ;\n";
+  const char* supplies[2][2] = {{"VDD", "POWER"}, {"VSS", "GROUND"}};
+  for (int s = 0; s < 2; ++s) {
+    def += fmt::format(
+        "- {0} ( * {0} ) + USE {1}\n", supplies[s][0], supplies[s][1]);
+    for (int row = s; row <= rows; row += 2) {
+      def += fmt::format(
+          "  {} metal1 340 + SHAPE FOLLOWPIN ( 0 {} ) ( {} * )\n",
+          row == s ? "+ ROUTED" : "NEW",
+          row * row_height,
+          width);
+    }
+    def += "  ;\n";
+  }
+  def += "END SPECIALNETS\n";
+
+  def += fmt::format("NETS {} ;\n", num_insts);
+  def += "- n_in ( PIN in ) ( u0 A ) + USE SIGNAL ;\n";
+  for (int i = 0; i + 1 < num_insts; ++i) {
+    const int j = i + 1;
+    const int x1 = x(i) + 700;
+    const int y1 = y(i) + 1400;
+    const int x2 = x(j) + 300;
+    const int y2 = y(j) + 1400;
+    def += fmt::format(
+        "- n{0} ( u{0} Z ) ( u{1} A ) + USE SIGNAL\n"
+        "  + ROUTED metal1 ( {2} {3} ) ( {4} * )",
+        i,
+        j,
+        x1,
+        y1,
+        x2);
+    if (y1 != y2) {
+      def += fmt::format(
+          " via1_4\n  NEW metal2 ( {} {} ) ( * {} )", x2, y1, y2);
+    }
+    def += " ;\n";
+  }
+  def += "END NETS\n";
+  def += "END DESIGN\n";
+  return def;
+}
+
 }  // namespace odb
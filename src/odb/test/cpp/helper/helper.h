@@ -30,6 +30,8 @@
 // ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
 // POSSIBILITY OF SUCH DAMAGE.
 
+#include <string>
+
 #include "odb/db.h"
 
 namespace odb {
@@ -59,4 +61,8 @@ odb::dbDatabase* create2LevetDbNoBTerms();
 
 odb::dbDatabase* create2LevetDbWithBTerms();
 
+// Text of a placed and routed DEF with num_insts Nangate45 BUF_X1 cells in
+// rows, each driving the next one, and power rails on every row.
+std::string createSyntheticDef(int num_insts);
+
 }  // namespace odb
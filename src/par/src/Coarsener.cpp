@@ -40,9 +40,12 @@
 
 #include "Coarsener.h"
 
+#include <algorithm>
+#include <atomic>
 #include <numeric>
 #include <random>
 #include <set>
+#include <unordered_map>
 
 #include "Evaluator.h"
 #include "Hypergraph.h"
@@ -239,12 +242,21 @@ HGraphPtr Coarsener::Aggregate(const HGraphPtr& hgraph) const
   Matrix<float> placement_attr_c;
 
   // find the vertex matching scheme
-  VertexMatching(hgraph,
-                 vertex_cluster_id_vec,
-                 vertex_weights_c,
-                 community_attr_c,
-                 fixed_attr_c,
-                 placement_attr_c);
+  if (thread_pool_ != nullptr && thread_pool_->GetNumThreads() > 1) {
+    ParallelVertexMatching(hgraph,
+                           vertex_cluster_id_vec,
+                           vertex_weights_c,
+                           community_attr_c,
+                           fixed_attr_c,
+                           placement_attr_c);
+  } else {
+    VertexMatching(hgraph,
+                   vertex_cluster_id_vec,
+                   vertex_weights_c,
+                   community_attr_c,
+                   fixed_attr_c,
+                   placement_attr_c);
+  }
 
   // coarsen the input hypergraph based on vertex matching map
   auto clustered_hgraph = Contraction(hgraph,
@@ -542,6 +554,271 @@ void Coarsener::VertexMatching(
   }
 }
 
+// Parallel version of VertexMatching
+// Each round has three steps:
+// (1) every unclustered vertex v finds its best neighbor u (parallel)
+// (2) v claims itself, and u if u is unclustered, with an atomic minimum
+//     of rank[v] (parallel)
+// (3) the proposals holding all of their claims are applied in rank order,
+//     until the early-stop condition is reached (serial).  v joins the
+//     cluster of u if u is clustered, otherwise v and u form a new cluster.
+void Coarsener::ParallelVertexMatching(
+    const HGraphPtr& hgraph,
+    std::vector<int>&
+        vertex_cluster_id_vec,  // map current vertex_id to cluster_id
+    // the remaining arguments are related to clusters
+    Matrix<float>& vertex_weights_c,
+    std::vector<int>& community_attr_c,
+    std::vector<int>& fixed_attr_c,
+    Matrix<float>& placement_attr_c) const
+{
+  const int num_vertices = hgraph->GetNumVertices();
+  vertex_cluster_id_vec.clear();
+  vertex_cluster_id_vec.resize(num_vertices);
+  std::fill(vertex_cluster_id_vec.begin(), vertex_cluster_id_vec.end(), -1);
+  vertex_weights_c.clear();
+  community_attr_c.clear();
+  fixed_attr_c.clear();
+  placement_attr_c.clear();
+
+  // add v to the cluster of root, a new cluster is created for the root
+  int cluster_id = 0;
+  auto add_to_cluster = [&](const int v, const int root) {
+    if (vertex_cluster_id_vec[root] == -1) {
+      vertex_cluster_id_vec[root] = cluster_id++;
+      vertex_weights_c.push_back(hgraph->GetVertexWeights(root));
+      if (hgraph->HasPlacement()) {
+        placement_attr_c.push_back(hgraph->GetPlacement(root));
+      }
+      if (hgraph->HasCommunity()) {
+        community_attr_c.push_back(hgraph->GetCommunity(root));
+      }
+      if (hgraph->HasFixedVertices()) {
+        fixed_attr_c.push_back(hgraph->GetFixedAttr(root));
+      }
+    }
+    if (v == root) {
+      return;
+    }
+    const int id = vertex_cluster_id_vec[root];
+    vertex_cluster_id_vec[v] = id;
+    if (hgraph->HasPlacement()) {
+      placement_attr_c[id]
+          = evaluator_->GetAvgPlacementLoc(vertex_weights_c[id],
+                                           hgraph->GetVertexWeights(v),
+                                           placement_attr_c[id],
+                                           hgraph->GetPlacement(v));
+    }
+    vertex_weights_c[id] = vertex_weights_c[id] + hgraph->GetVertexWeights(v);
+  };
+
+  // fixed vertices are single-vertex clusters
+  std::vector<int> unvisited;
+  unvisited.reserve(num_vertices);
+  for (int v = 0; v < num_vertices; ++v) {
+    if (hgraph->HasFixedVertices() && hgraph->GetFixedAttr(v) > -1) {
+      add_to_cluster(v, v);
+    } else {
+      unvisited.push_back(v);
+    }
+  }
+  OrderVertices(hgraph, unvisited);
+
+  // the rank of a vertex is its position in the ordered vertices
+  // fixed vertices keep the rank num_vertices and are never merged
+  std::vector<int> rank(num_vertices, num_vertices);
+  for (int i = 0; i < static_cast<int>(unvisited.size()); i++) {
+    rank[unvisited[i]] = i;
+  }
+
+  // stop when the number of clusters reaches this threshold
+  const int num_early_stop_clusters
+      = static_cast<int>(unvisited.size()) / coarsening_ratio_;
+  int num_clusters = num_vertices;
+
+  // root[v] is the first vertex of the cluster holding v, -1 if v is not
+  // clustered yet.  root_weight is the weight of the cluster of a root.
+  std::vector<int> root(num_vertices, -1);
+  Matrix<float> root_weight(num_vertices);
+  std::vector<int> best_nbr(num_vertices, -1);
+  std::vector<std::atomic<int>> claim(num_vertices);
+  for (auto& c : claim) {
+    c.store(num_vertices, std::memory_order_relaxed);
+  }
+  std::vector<int> candidates = unvisited;
+  const int num_tasks = thread_pool_->GetNumThreads();
+  // per task scratch space for the neighbor scores
+  std::vector<std::vector<float>> task_scores(num_tasks);
+  std::vector<std::vector<int>> task_stamps(num_tasks);
+
+  // find the best neighbor of v with the score of VertexMatching
+  auto find_best_neighbor = [&](const int v,
+                                std::vector<float>& score,
+                                std::vector<int>& stamp,
+                                std::vector<int>& nbrs) {
+    nbrs.clear();
+    for (const int he : hgraph->Edges(v)) {
+      const auto edge_range = hgraph->Vertices(he);
+      const int he_size = edge_range.size();
+      if (he_size <= 1 || he_size > thr_coarsen_hyperedge_size_skip_) {
+        continue;
+      }
+      const float he_score = evaluator_->GetNormEdgeScore(he, hgraph);
+      for (const int nbr_v : edge_range) {
+        if (nbr_v == v || rank[nbr_v] == num_vertices) {
+          continue;  // ignore v itself and fixed vertices
+        }
+        if (stamp[nbr_v] == v) {
+          score[nbr_v] += he_score;
+          continue;
+        }
+        // the same merging conditions as VertexMatching
+        const std::vector<float>& nbr_v_weight
+            = root[nbr_v] > -1 ? root_weight[root[nbr_v]]
+                               : hgraph->GetVertexWeights(nbr_v);
+        if ((hgraph->HasCommunity()
+             && hgraph->GetCommunity(v) != hgraph->GetCommunity(nbr_v))
+            || hgraph->GetVertexWeights(v) + nbr_v_weight
+                   > thr_cluster_weight_) {
+          continue;
+        }
+        stamp[nbr_v] = v;
+        score[nbr_v] = he_score;
+        nbrs.push_back(nbr_v);
+      }
+    }
+    if (nbrs.empty()) {
+      return -1;
+    }
+    // only the direct neighbors on critical timing paths are considered
+    if (hgraph->HasTiming() && hgraph->GetNumTimingPaths() > 0) {
+      for (const int p : hgraph->TimingPathsThrough(v)) {
+        const float path_timing_score
+            = evaluator_->GetPathTimingScore(p, hgraph);
+        auto path_range = hgraph->PathVertices(p);
+        for (auto iter = path_range.begin(); iter != path_range.end(); ++iter) {
+          if (*iter != v) {
+            continue;
+          }
+          if (iter != path_range.begin() && stamp[*(iter - 1)] == v) {
+            score[*(iter - 1)] += path_timing_score;
+          }
+          if (iter + 1 != path_range.end() && stamp[*(iter + 1)] == v) {
+            score[*(iter + 1)] += path_timing_score;
+          }
+        }
+      }
+    }
+    // ties prefer unclustered neighbors, then the smaller vertex id
+    float best_score = -std::numeric_limits<float>::max();
+    int best_vertex = -1;
+    for (const int u : nbrs) {
+      stamp[u] = -1;  // v may be visited again in a later round
+      float u_score = score[u];
+      if (hgraph->HasPlacement()) {
+        u_score += evaluator_->GetPlacementScore(v, u, hgraph);
+      }
+      if (best_vertex == -1 || u_score > best_score
+          || (u_score == best_score
+              && std::make_pair(root[u] > -1, u)
+                     < std::make_pair(root[best_vertex] > -1, best_vertex))) {
+        best_vertex = u;
+        best_score = u_score;
+      }
+    }
+    return best_vertex;
+  };
+
+  // like the serial matching, keep matching until every vertex that has a
+  // feasible neighbor is clustered
+  while (!candidates.empty() && num_clusters > num_early_stop_clusters) {
+    const int num_candidates = candidates.size();
+    // (1) find the best neighbor of each candidate
+    thread_pool_->ParallelFor(num_tasks, [&](const int task) {
+      std::vector<float>& score = task_scores[task];
+      std::vector<int>& stamp = task_stamps[task];
+      if (stamp.empty()) {
+        score.resize(num_vertices, 0.0);
+        stamp.resize(num_vertices, -1);
+      }
+      std::vector<int> nbrs;
+      for (int i = task; i < num_candidates; i += num_tasks) {
+        const int v = candidates[i];
+        best_nbr[v] = find_best_neighbor(v, score, stamp, nbrs);
+        claim[v].store(num_vertices, std::memory_order_relaxed);
+      }
+    });
+    // (2) claim the proposals.  A vertex keeps the smallest rank claiming it
+    auto claim_vertex = [&](const int w, const int value) {
+      int cur = claim[w].load(std::memory_order_relaxed);
+      while (value < cur
+             && !claim[w].compare_exchange_weak(
+                 cur, value, std::memory_order_relaxed)) {
+      }
+    };
+    thread_pool_->ParallelFor(num_tasks, [&](const int task) {
+      for (int i = task; i < num_candidates; i += num_tasks) {
+        const int v = candidates[i];
+        const int u = best_nbr[v];
+        if (u == -1) {
+          continue;
+        }
+        claim_vertex(v, rank[v]);
+        if (root[u] == -1) {
+          claim_vertex(u, rank[v]);
+        }
+      }
+    });
+    // (3) apply the proposals holding all of their claims in rank order
+    // (candidates are sorted by rank)
+    int num_merged = 0;
+    for (const int v : candidates) {
+      const int u = best_nbr[v];
+      if (u == -1 || claim[v].load(std::memory_order_relaxed) != rank[v]) {
+        continue;
+      }
+      if (root[u] > -1) {
+        // the cluster of u may have grown in this round
+        if (hgraph->GetVertexWeights(v) + root_weight[root[u]]
+            > thr_cluster_weight_) {
+          continue;
+        }
+        root[v] = root[u];
+        root_weight[root[u]]
+            = root_weight[root[u]] + hgraph->GetVertexWeights(v);
+      } else if (claim[u].load(std::memory_order_relaxed) == rank[v]) {
+        root[v] = v;
+        root[u] = v;
+        root_weight[v]
+            = hgraph->GetVertexWeights(v) + hgraph->GetVertexWeights(u);
+      } else {
+        continue;
+      }
+      num_merged++;
+      if (--num_clusters <= num_early_stop_clusters) {
+        break;
+      }
+    }
+    if (num_merged == 0) {
+      break;  // no progress
+    }
+    // the remaining candidates for the next round
+    std::vector<int> remaining;
+    remaining.reserve(candidates.size());
+    for (const int v : candidates) {
+      if (root[v] == -1 && best_nbr[v] != -1) {
+        remaining.push_back(v);
+      }
+    }
+    candidates = std::move(remaining);
+  }
+
+  // create the clusters following the order of vertices
+  for (const int v : unvisited) {
+    add_to_cluster(v, root[v] > -1 ? root[v] : v);
+  }
+}
+
 // handle group information
 // group fixed vertices based on each block
 // group vertices based on group_attr and hgraph->fixed_attr_
@@ -757,28 +1034,47 @@ HGraphPtr Coarsener::Contraction(
   std::vector<std::set<int>>
       hyperedge_arc_set_c;  // map current hyperedge into arcs in timing graph.
                             // We need this for propagation
-  std::map<size_t, int>
+  // The clusters spanned by each hyperedge are computed in parallel.
+  // Parallel hyperedges are merged serially in hyperedge order below,
+  // so the contracted hypergraph does not depend on the number of threads.
+  const int num_hyperedges = hgraph->GetNumHyperedges();
+  Matrix<int> hyperedge_clusters(num_hyperedges);
+  std::vector<size_t> hyperedge_hash(num_hyperedges, 0);
+  const int num_tasks
+      = thread_pool_ != nullptr ? thread_pool_->GetNumThreads() : 1;
+  ParallelFor(thread_pool_, num_tasks, [&](const int task) {
+    for (int e = task; e < num_hyperedges; e += num_tasks) {
+      const auto range = hgraph->Vertices(e);
+      const int he_size = range.size();
+      if (he_size <= 1 || he_size > thr_coarsen_hyperedge_size_skip_) {
+        continue;  // ignore the single-vertex hyperedge and large hyperedge
+      }
+      std::vector<int>& hyperedge_c = hyperedge_clusters[e];
+      hyperedge_c.reserve(he_size);
+      for (const int vertex_id : range) {
+        hyperedge_c.push_back(vertex_cluster_id_vec[vertex_id]);
+      }
+      std::sort(hyperedge_c.begin(), hyperedge_c.end());
+      hyperedge_c.erase(std::unique(hyperedge_c.begin(), hyperedge_c.end()),
+                        hyperedge_c.end());
+      hyperedge_hash[e] = std::inner_product(hyperedge_c.begin(),
+                                             hyperedge_c.end(),
+                                             hyperedge_c.begin(),
+                                             static_cast<size_t>(0));
+    }
+  });
+
+  std::unordered_map<size_t, int>
       hash_map;  // store the hash value of each contracted hyperedge
-  std::map<size_t, std::vector<int>>
+  std::unordered_map<size_t, std::vector<int>>
       parallel_hash_map;  // store the hyperedges_c with the same hash_value
                           // (candidate)
-  for (int e = 0; e < hgraph->GetNumHyperedges(); e++) {
-    const auto range = hgraph->Vertices(e);
-    const int he_size = range.size();
-    if (he_size <= 1 || he_size > thr_coarsen_hyperedge_size_skip_) {
-      continue;  // ignore the single-vertex hyperedge and large hyperedge
-    }
-    std::set<int> hyperedge_c;
-    for (const int vertex_id : range) {
-      hyperedge_c.insert(vertex_cluster_id_vec[vertex_id]);  // get cluster id
-    }
-    if (hyperedge_c.size() <= 1) {
+  for (int e = 0; e < num_hyperedges; e++) {
+    std::vector<int>& hyperedge_vec = hyperedge_clusters[e];
+    if (hyperedge_vec.size() <= 1) {
       continue;  // ignore the single-vertex hyperedge
     }
-    size_t hash_value = std::inner_product(hyperedge_c.begin(),
-                                           hyperedge_c.end(),
-                                           hyperedge_c.begin(),
-                                           static_cast<size_t>(0));
+    const size_t hash_value = hyperedge_hash[e];
     // check if the hash value has been used
     // for detecting parallel hyperedge
     // hyperedge_slack_c[e] = min_slack(hyperedge_arc_set_c[e])
@@ -786,8 +1082,7 @@ HGraphPtr Coarsener::Contraction(
       const int hyperedge_c_id = static_cast<int>(hyperedges_c.size());
       hyperedge_cluster_id_vec[e] = hyperedge_c_id;
       hash_map[hash_value] = hyperedge_c_id;
-      hyperedges_c.push_back(
-          std::vector<int>(hyperedge_c.begin(), hyperedge_c.end()));
+      hyperedges_c.push_back(std::move(hyperedge_vec));
       hyperedges_weights_c.push_back(hgraph->GetHyperedgeWeights(e));
       if (hgraph->HasTiming()) {
         hyperedge_slack_c.push_back(
@@ -801,7 +1096,6 @@ HGraphPtr Coarsener::Contraction(
     // there may be parallel hyperedges
     const int hash_hyperedge_c_id
         = hash_map[hash_value];  // the hyperedge_c has been found
-    std::vector<int> hyperedge_vec(hyperedge_c.begin(), hyperedge_c.end());
     // check the representative hyperedge_c
     int parallel_hyperedge_c_id
         = -1;  // the hyperedge_c_id of parallel hyperedge
@@ -824,7 +1118,7 @@ HGraphPtr Coarsener::Contraction(
       const int hyperedge_c_id = static_cast<int>(hyperedges_c.size());
       hyperedge_cluster_id_vec[e] = hyperedge_c_id;
       parallel_hash_map[hash_value].push_back(hyperedge_c_id);
-      hyperedges_c.push_back(hyperedge_vec);
+      hyperedges_c.push_back(std::move(hyperedge_vec));
       hyperedges_weights_c.push_back(hgraph->GetHyperedgeWeights(e));
       if (hgraph->HasTiming()) {
         hyperedge_slack_c.push_back(
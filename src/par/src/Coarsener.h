@@ -42,6 +42,7 @@
 
 #include "Evaluator.h"
 #include "Hypergraph.h"
+#include "ThreadPool.h"
 #include "utl/Logger.h"
 
 namespace par {
@@ -124,6 +125,13 @@ class Coarsener
 
   void IncreaseRandomSeed() { random_seed_++; }
 
+  // With a pool of more than one thread, vertices are matched in parallel
+  // and hyperedges are contracted in parallel.
+  void SetThreadPool(ThreadPoolPtr thread_pool)
+  {
+    thread_pool_ = std::move(thread_pool);
+  }
+
  private:
   // private functions (utilities)
 
@@ -148,6 +156,22 @@ class Coarsener
       std::vector<int>& fixed_attr_c,
       Matrix<float>& placement_attr_c) const;
 
+  // Parallel version of VertexMatching.  Each round, every unmatched vertex
+  // picks its best neighbor using the same score as VertexMatching, then
+  // claims itself, and the neighbor if it is unclustered, with a lock-free
+  // atomic minimum of its rank.  A vertex holding its own claim joins the
+  // cluster of a clustered neighbor while it stays under the weight
+  // threshold, so clusters may grow past two vertices; with an unclustered
+  // neighbor it forms a new pair only if it holds both claims.  Proposals
+  // are applied in rank order, so the result does not depend on the number
+  // of threads, though it may differ from VertexMatching.
+  void ParallelVertexMatching(const HGraphPtr& hgraph,
+                              std::vector<int>& vertex_cluster_id_vec,
+                              Matrix<float>& vertex_weights_c,
+                              std::vector<int>& community_attr_c,
+                              std::vector<int>& fixed_attr_c,
+                              Matrix<float>& placement_attr_c) const;
+
   // order the vertices based on user-specified parameters
   void OrderVertices(const HGraphPtr& hgraph, std::vector<int>& vertices) const;
 
@@ -211,6 +235,7 @@ class Coarsener
   int random_seed_ = 0;
   CoarsenOrder vertex_order_choice_ = CoarsenOrder::RANDOM;
   EvaluatorPtr evaluator_ = nullptr;
+  ThreadPoolPtr thread_pool_ = nullptr;
   utl::Logger* logger_ = nullptr;
 };
 
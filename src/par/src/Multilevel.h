@@ -42,6 +42,7 @@
 #include "KWayFMRefine.h"
 #include "KWayPMRefine.h"
 #include "Partitioner.h"
+#include "ThreadPool.h"
 #include "Utilities.h"
 #include "utl/Logger.h"
 
@@ -73,6 +74,12 @@ class MultilevelPartitioner
                         EvaluatorPtr evaluator,
                         utl::Logger* logger);
 
+  // The solutions in RefinePartition are refined in parallel on this pool
+  void SetThreadPool(ThreadPoolPtr thread_pool)
+  {
+    thread_pool_ = std::move(thread_pool);
+  }
+
   // Main function
   // here the hgraph should not be const
   // Because our slack-rebudgeting algorithm will change hgraph
@@ -156,6 +163,7 @@ class MultilevelPartitioner
   GreedyRefinerPtr greedy_refiner_ = nullptr;
   IlpRefinerPtr ilp_refiner_ = nullptr;
   EvaluatorPtr evaluator_ = nullptr;
+  ThreadPoolPtr thread_pool_ = nullptr;
   utl::Logger* logger_ = nullptr;
 };
 
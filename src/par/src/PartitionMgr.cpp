@@ -155,6 +155,7 @@ void PartitionMgr::tritonPartHypergraph(
   triton_part->SetNetWeight(e_wt_factors);
   triton_part->SetVertexWeight(v_wt_factors);
   triton_part->SetPlacementWeight(placement_wt_factors);
+  triton_part->SetNumThreads(num_threads_);
   triton_part->SetFineTuneParams(  // coarsening related parameters
       thr_coarsen_hyperedge_size_skip,
       thr_coarsen_vertices,
@@ -296,6 +297,7 @@ void PartitionMgr::tritonPartDesign(
   triton_part->SetNetWeight(e_wt_factors);
   triton_part->SetVertexWeight(v_wt_factors);
   triton_part->SetPlacementWeight(placement_wt_factors);
+  triton_part->SetNumThreads(num_threads_);
   triton_part->SetTimingParams(net_timing_factor,
                                path_timing_factor,
                                path_snaking_factor,
@@ -388,6 +390,7 @@ void PartitionMgr::evaluatePartDesignSolution(
   triton_part->SetVertexWeight(v_wt_factors);
   std::vector<float> placement_wt_factors;
   triton_part->SetPlacementWeight(placement_wt_factors);
+  triton_part->SetNumThreads(num_threads_);
   triton_part->SetTimingParams(net_timing_factor,
                                path_timing_factor,
                                path_snaking_factor,
@@ -88,6 +88,11 @@ Refiner::Refiner(
   logger_ = logger;
 }
 
+void Refiner::SetThreadPool(ThreadPoolPtr thread_pool)
+{
+  thread_pool_ = std::move(thread_pool);
+}
+
 void Refiner::SetMaxMove(const int max_move)
 {
   debugPrint(logger_, PAR, "refinement", 1, "Set the max_move to {}", max_move);
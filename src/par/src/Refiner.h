@@ -39,6 +39,7 @@
 #include "Evaluator.h"
 #include "Hypergraph.h"
 #include "PriorityQueue.h"
+#include "ThreadPool.h"
 #include "Utilities.h"
 #include "utl/Logger.h"
 
@@ -126,6 +127,10 @@ class Refiner
   void SetMaxMove(int max_move);
   void SetRefineIters(int refiner_iters);
 
+  // Gain bucket updates are distributed over this pool.
+  // Without a pool they run serially.
+  void SetThreadPool(ThreadPoolPtr thread_pool);
+
   void RestoreDefaultParameters();
 
  protected:
@@ -282,6 +287,7 @@ class Refiner
 
   utl::Logger* logger_ = nullptr;
   EvaluatorPtr evaluator_ = nullptr;
+  ThreadPoolPtr thread_pool_ = nullptr;
 };
 
 }  // namespace par
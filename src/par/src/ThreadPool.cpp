@@ -0,0 +1,175 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+///////////////////////////////////////////////////////////////////////////////
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
+namespace par {
+
+struct ThreadPool::Batch
+{
+  Batch(int num_tasks, const std::function<void(int)>& task)
+      : num_tasks(num_tasks), task(task)
+  {
+  }
+
+  const int num_tasks;
+  const std::function<void(int)>& task;
+  std::atomic<int> next{0};
+  std::atomic<int> finished{0};
+  std::exception_ptr error;
+  std::mutex mutex;
+  std::condition_variable done;
+};
+
+ThreadPool::ThreadPool(int num_threads)
+{
+  workers_.reserve(std::max(num_threads - 1, 0));
+  for (int i = 1; i < num_threads; i++) {
+    workers_.emplace_back(&ThreadPool::WorkerLoop, this);
+  }
+}
+
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+void ThreadPool::RunTasks(Batch& batch)
+{
+  int finished = 0;
+  for (int i = batch.next++; i < batch.num_tasks; i = batch.next++) {
+    try {
+      batch.task(i);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(batch.mutex);
+      if (!batch.error) {
+        batch.error = std::current_exception();
+      }
+    }
+    finished++;
+  }
+  if (finished > 0
+      && batch.finished.fetch_add(finished) + finished == batch.num_tasks) {
+    std::lock_guard<std::mutex> lock(batch.mutex);
+    batch.done.notify_all();
+  }
+}
+
+void ThreadPool::WorkerLoop()
+{
+  while (true) {
+    std::shared_ptr<Batch> batch;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [this] { return stop_ || !batches_.empty(); });
+      if (stop_) {
+        return;
+      }
+      batch = batches_.front();
+      // every task of the batch has been claimed
+      if (batch->next >= batch->num_tasks) {
+        batches_.pop_front();
+        continue;
+      }
+    }
+    RunTasks(*batch);
+  }
+}
+
+void ThreadPool::ParallelFor(const int num_tasks,
+                             const std::function<void(int)>& task)
+{
+  if (num_tasks <= 0) {
+    return;
+  }
+  if (workers_.empty() || num_tasks == 1) {
+    for (int i = 0; i < num_tasks; i++) {
+      task(i);
+    }
+    return;
+  }
+
+  auto batch = std::make_shared<Batch>(num_tasks, task);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    batches_.push_back(batch);
+  }
+  cv_.notify_all();
+
+  RunTasks(*batch);
+  {
+    std::unique_lock<std::mutex> lock(batch->mutex);
+    batch->done.wait(lock,
+                     [&batch] { return batch->finished == batch->num_tasks; });
+  }
+  {
+    // drop the batch if no worker has done so yet
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto it = batches_.begin(); it != batches_.end(); ++it) {
+      if (*it == batch) {
+        batches_.erase(it);
+        break;
+      }
+    }
+  }
+  if (batch->error) {
+    std::rethrow_exception(batch->error);
+  }
+}
+
+void ParallelFor(const ThreadPoolPtr& pool,
+                 const int num_tasks,
+                 const std::function<void(int)>& task)
+{
+  if (pool) {
+    pool->ParallelFor(num_tasks, task);
+    return;
+  }
+  for (int i = 0; i < num_tasks; i++) {
+    task(i);
+  }
+}
+
+}  // namespace par
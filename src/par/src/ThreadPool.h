@@ -0,0 +1,91 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace par {
+
+// A persistent pool of worker threads shared by the coarsener, the
+// refiners and the multilevel partitioner.  Workers are created once per
+// partitioning run instead of being spawned for every gain update.
+//
+// The thread calling ParallelFor also executes tasks of its own batch, so
+// ParallelFor may be called concurrently from several threads and from
+// within a running task without deadlocking.
+class ThreadPool
+{
+ public:
+  // num_threads counts the calling thread, so num_threads - 1 workers
+  // are created.  A pool with a single thread runs everything inline.
+  explicit ThreadPool(int num_threads);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  int GetNumThreads() const { return static_cast<int>(workers_.size()) + 1; }
+
+  // Run task(0) ... task(num_tasks - 1) and wait for all of them to finish.
+  // The first exception thrown by a task is rethrown here.
+  void ParallelFor(int num_tasks, const std::function<void(int)>& task);
+
+ private:
+  struct Batch;
+
+  void WorkerLoop();
+  static void RunTasks(Batch& batch);
+
+  std::vector<std::thread> workers_;
+  std::deque<std::shared_ptr<Batch>> batches_;
+  bool stop_ = false;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+};
+
+using ThreadPoolPtr = std::shared_ptr<ThreadPool>;
+
+// Run the tasks on the pool, or serially in index order if there is none.
+void ParallelFor(const ThreadPoolPtr& pool,
+                 int num_tasks,
+                 const std::function<void(int)>& task);
+
+}  // namespace par
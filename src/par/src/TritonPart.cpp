@@ -49,6 +49,7 @@
 #include "Multilevel.h"
 #include "Partitioner.h"
 #include "Refiner.h"
+#include "ThreadPool.h"
 #include "Utilities.h"
 #include "odb/db.h"
 #include "sta/ArcDelayCalc.hh"
@@ -1980,6 +1981,22 @@ void TritonPart::MultiLevelPartition()
                                                 tritonpart_evaluator,
                                                 logger_);
 
+  // One pool of worker threads is shared by all the steps.  The refiners
+  // update the gain buckets of all the blocks at once, so the pool never
+  // has fewer threads than blocks.  Coarsening only runs in parallel when
+  // more than one thread is requested, otherwise the results are the same
+  // as the serial flow.
+  auto thread_pool
+      = std::make_shared<ThreadPool>(std::max(num_threads_, num_parts_));
+  if (num_threads_ > 1) {
+    tritonpart_coarsener->SetThreadPool(thread_pool);
+  }
+  greedy_refiner->SetThreadPool(thread_pool);
+  ilp_refiner->SetThreadPool(thread_pool);
+  k_way_fm_refiner->SetThreadPool(thread_pool);
+  k_way_pm_refiner->SetThreadPool(thread_pool);
+  tritonpart_mlevel_partitioner->SetThreadPool(thread_pool);
+
   if (timing_aware_flag_ == true) {
     // Initialize the timing on original_hypergraph_
     tritonpart_evaluator->InitializeTiming(original_hypergraph_);
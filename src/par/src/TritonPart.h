@@ -211,6 +211,10 @@ class TritonPart
     placement_wt_factors_ = placement_wt_factors;
   }
 
+  // Number of threads used for coarsening.  The refiners always update
+  // the gain buckets of different blocks in parallel.
+  void SetNumThreads(int num_threads) { num_threads_ = num_threads; }
+
   // Set detailed parameters
   // There parameters only used by users who want to exploit the performance
   // limits of TritonPart
@@ -284,6 +288,8 @@ class TritonPart
   // random seed
   int seed_ = 0;
 
+  int num_threads_ = 1;
+
   // ---- support for partitioning design with placed information
   // ---- for example, pin-3D flow
   bool placement_flag_
@@ -40,6 +40,7 @@
 #include <regex>
 #include <vector>
 
+#include "ord/OpenRoad.hh"
 #include "par/PartitionMgr.h"
 
 namespace ord {
@@ -109,6 +110,8 @@ void triton_part_hypergraph(unsigned int num_parts,
                             int num_vertices_threshold_ilp,
                             int global_net_threshold)
 {
+  getPartitionMgr()->setNumThreads(
+      ord::OpenRoad::openRoad()->getThreadCount());
   getPartitionMgr()->tritonPartHypergraph(
       num_parts,
       balance_constraint,
@@ -229,6 +232,8 @@ void triton_part_design(unsigned int num_parts_arg,
                         int num_vertices_threshold_ilp,
                         int global_net_threshold)
 {
+  getPartitionMgr()->setNumThreads(
+      ord::OpenRoad::openRoad()->getThreadCount());
   getPartitionMgr()->tritonPartDesign(
       num_parts_arg,
       balance_constraint_arg,
@@ -0,0 +1,31 @@
+# triton_part_design with threads is independent of the thread count
+source "helpers.tcl"
+source flow_helpers.tcl
+
+read_liberty "Nangate45/Nangate45_typ.lib"
+read_lef Nangate45/Nangate45.lef
+read_verilog gcd.v
+link_design gcd
+
+read_sdc gcd_nangate45.sdc
+
+proc read_solution { file_name } {
+  set stream [open $file_name r]
+  set solution [read $stream]
+  close $stream
+  return $solution
+}
+
+set part_file2 [make_result_file partition_gcd_threads2.part]
+set part_file4 [make_result_file partition_gcd_threads4.part]
+
+set_thread_count 2
+triton_part_design -solution_file $part_file2
+set_thread_count 4
+triton_part_design -solution_file $part_file4
+
+check "same partition with 2 and 4 threads" {
+  expr { [read_solution $part_file2] == [read_solution $part_file4] }
+} 1
+
+exit_summary
@@ -4,3 +4,6 @@ record_tests {
   #par_man_tcl_check
   #par_readme_msgs_check
 }
+record_pass_fail_tests {
+  partition_gcd_threads
+}
@@ -164,7 +164,9 @@ class IOPlacer
   void setAnnealingConfig(float temperature,
                           int max_iterations,
                           int perturb_per_iter,
-                          float alpha);
+                          float alpha,
+                          int num_chains);
+  void setNumThreads(int threads);
   void checkPinPlacement();
 
   void setRenderer(std::unique_ptr<AbstractIOPlacerRenderer> ioplacer_renderer);
@@ -325,6 +327,8 @@ class IOPlacer
   int max_iterations_ = 0;
   int perturb_per_iter_ = 0;
   float alpha_ = 0;
+  int num_chains_ = 0;
+  int num_threads_ = 1;
 
   // simulated annealing debugger variables
   bool annealing_debug_mode_ = false;
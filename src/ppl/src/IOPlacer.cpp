@@ -2152,12 +2152,19 @@ void IOPlacer::run(bool random_mode)
 void IOPlacer::setAnnealingConfig(float temperature,
                                   int max_iterations,
                                   int perturb_per_iter,
-                                  float alpha)
+                                  float alpha,
+                                  int num_chains)
 {
   init_temperature_ = temperature;
   max_iterations_ = max_iterations;
   perturb_per_iter_ = perturb_per_iter;
   alpha_ = alpha;
+  num_chains_ = num_chains;
+}
+
+void IOPlacer::setNumThreads(const int threads)
+{
+  num_threads_ = threads;
 }
 
 void IOPlacer::setRenderer(
@@ -2210,11 +2217,16 @@ void IOPlacer::runAnnealing(bool random)
   if (isAnnealingDebugOn()) {
     annealing.setDebugOn(std::move(ioplacer_renderer_));
   }
+  annealing.setNumThreads(num_threads_);
 
   printConfig(true);
 
-  annealing.run(
-      init_temperature_, max_iterations_, perturb_per_iter_, alpha_, random);
+  annealing.run(init_temperature_,
+                max_iterations_,
+                perturb_per_iter_,
+                alpha_,
+                num_chains_,
+                random);
   annealing.getAssignment(assignment_);
 
   for (auto& pin : assignment_) {
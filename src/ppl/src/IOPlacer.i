@@ -327,9 +327,10 @@ void
 set_simulated_annealing(float temperature,
                         int max_iterations,
                         int perturb_per_iter,
-                        float alpha)
+                        float alpha,
+                        int num_chains)
 {
-  getIOPlacer()->setAnnealingConfig(temperature, max_iterations, perturb_per_iter, alpha);
+  getIOPlacer()->setAnnealingConfig(temperature, max_iterations, perturb_per_iter, alpha, num_chains);
 }
 
 void
@@ -353,6 +354,7 @@ simulated_annealing_debug(int iters_between_paintings,
 void
 run_annealing(bool random)
 {
+  getIOPlacer()->setNumThreads(ord::OpenRoad::openRoad()->getThreadCount());
   getIOPlacer()->runAnnealing(random);
 }
 
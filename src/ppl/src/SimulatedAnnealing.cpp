@@ -35,6 +35,14 @@
 
 #include "SimulatedAnnealing.h"
 
+#include <cmath>
+#include <condition_variable>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <tuple>
+
 #include "ppl/AbstractIOPlacerRenderer.h"
 #include "utl/Logger.h"
 #include "utl/algorithms.h"
@@ -50,6 +58,7 @@ SimulatedAnnealing::SimulatedAnnealing(
     odb::dbDatabase* db)
     : netlist_(netlist),
       core_(core),
+      io_slots_(slots),
       slots_(slots),
       pin_groups_(netlist->getIOGroups()),
       constraints_(constraints),
@@ -68,92 +77,300 @@ void SimulatedAnnealing::run(float init_temperature,
                              int max_iterations,
                              int perturb_per_iter,
                              float alpha,
+                             int num_chains,
                              bool random)
 {
   init(init_temperature, max_iterations, perturb_per_iter, alpha);
   randomAssignment();
-  if (!random) {
-    int64 pre_cost = 0;
-    pre_cost = getAssignmentCost();
-    float temperature = init_temperature_;
-    odb::dbBlock* block = db_->getChip()->getBlock();
+  if (random) {
+    return;
+  }
 
-    boost::random::uniform_real_distribution<float> distribution;
-    for (int iter = 0; iter < max_iterations_; iter++) {
-      for (int perturb = 0; perturb < perturb_per_iter_; perturb++) {
-        int prev_cost;
-        perturbAssignment(prev_cost);
-
-        const int64 cost = pre_cost + getDeltaCost(prev_cost);
-        const int delta_cost = cost - pre_cost;
-        debugPrint(
-            logger_,
-            utl::PPL,
-            "annealing",
-            2,
-            "iteration: {}; temperature: {}; assignment cost: {}um; delta "
-            "cost: {}um",
-            iter,
-            temperature,
-            block->dbuToMicrons(cost),
-            block->dbuToMicrons(delta_cost));
-
-        const float rand_float = distribution(generator_);
-        const float accept_prob = std::exp((-1) * delta_cost / temperature);
-        if (delta_cost <= 0 || accept_prob > rand_float) {
-          // accept new solution, update cost and slots
-          pre_cost = cost;
-          if (!prev_slots_.empty() && !new_slots_.empty()) {
-            for (int prev_slot : prev_slots_) {
-              slots_[prev_slot].used = false;
-            }
-            for (int new_slot : new_slots_) {
-              slots_[new_slot].used = true;
-            }
-          }
-        } else {
-          for (int i = 0; i < prev_slots_.size(); i++) {
-            slots_[prev_slots_[i]].used = true;
-          }
-          restorePreviousAssignment();
+  if (num_chains > 1) {
+    runParallelTempering(num_chains);
+    return;
+  }
+
+  int64 cost = getAssignmentCost();
+  float temperature = init_temperature_;
+  for (int iter = 0; iter < max_iterations_; iter++) {
+    annealIteration(iter, temperature, cost);
+
+    temperature *= alpha_;
+
+    if (debug_->isOn()) {
+      visualizeAssignment(*this, iter);
+    }
+  }
+}
+
+void SimulatedAnnealing::setNumThreads(const int threads)
+{
+  num_threads_ = threads;
+}
+
+void SimulatedAnnealing::annealIteration(const int iter,
+                                         const float temperature,
+                                         int64& pre_cost)
+{
+  odb::dbBlock* block = db_->getChip()->getBlock();
+
+  boost::random::uniform_real_distribution<float> distribution;
+  for (int perturb = 0; perturb < perturb_per_iter_; perturb++) {
+    int prev_cost;
+    perturbAssignment(prev_cost);
+
+    const int64 cost = pre_cost + getDeltaCost(prev_cost);
+    const int delta_cost = cost - pre_cost;
+    debugPrint(logger_,
+               utl::PPL,
+               "annealing",
+               2,
+               "iteration: {}; temperature: {}; assignment cost: {}um; delta "
+               "cost: {}um",
+               iter,
+               temperature,
+               block->dbuToMicrons(cost),
+               block->dbuToMicrons(delta_cost));
+
+    const float rand_float = distribution(generator_);
+    const float accept_prob = std::exp((-1) * delta_cost / temperature);
+    if (delta_cost <= 0 || accept_prob > rand_float) {
+      // accept new solution, update cost and slots
+      pre_cost = cost;
+      if (!prev_slots_.empty() && !new_slots_.empty()) {
+        for (int prev_slot : prev_slots_) {
+          slots_[prev_slot].used = false;
         }
-        prev_slots_.clear();
-        new_slots_.clear();
-        pins_.clear();
+        for (int new_slot : new_slots_) {
+          slots_[new_slot].used = true;
+        }
+      }
+    } else {
+      for (int i = 0; i < prev_slots_.size(); i++) {
+        slots_[prev_slots_[i]].used = true;
       }
+      restorePreviousAssignment();
+    }
+    prev_slots_.clear();
+    new_slots_.clear();
+    pins_.clear();
+  }
+}
 
-      temperature *= alpha_;
+namespace {
+
+// Blocks each of count threads in wait() until all of them got there
+class Barrier
+{
+ public:
+  explicit Barrier(const int count) : count_(count) {}
+
+  void wait()
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    const int generation = generation_;
+    if (++waiting_ == count_) {
+      waiting_ = 0;
+      generation_++;
+      released_.notify_all();
+    } else {
+      released_.wait(lock, [&] { return generation != generation_; });
+    }
+  }
 
-      if (debug_->isOn()) {
-        std::vector<ppl::IOPin> pins;
-        getAssignment(pins);
+ private:
+  const int count_;
+  int waiting_ = 0;
+  int generation_ = 0;
+  std::mutex mutex_;
+  std::condition_variable released_;
+};
+
+}  // namespace
+
+// Parallel tempering: the chains start from the same assignment and each
+// runs at a level of a geometric temperature ladder, all levels decaying
+// by alpha as in the single chain annealing.  Every exchange_interval_
+// iterations neighbouring levels swap their chains with the Metropolis
+// probability of the exchange, so good assignments found by the hot
+// chains move down to the cold ones.  Each chain has its own seed and the
+// exchanges are decided on this thread, so the result is reproducible
+// and does not depend on the number of threads.
+//
+// The levels are shared out to at most num_threads_ workers that live
+// for the whole run, each taking every thread_count-th level.  They meet
+// at a barrier before and after each interval, and the exchanges happen
+// on this thread while the others wait.
+void SimulatedAnnealing::runParallelTempering(const int num_chains)
+{
+  std::vector<std::unique_ptr<SimulatedAnnealing>> other_chains;
+  std::vector<SimulatedAnnealing*> chains{this};
+  for (int i = 1; i < num_chains; i++) {
+    auto chain = std::make_unique<SimulatedAnnealing>(
+        netlist_, core_, io_slots_, constraints_, logger_, db_);
+    chain->copyStateFrom(*this);
+    chain->init(
+        init_temperature_, max_iterations_, perturb_per_iter_, alpha_);
+    chain->generator_.seed(seed_ + i);
+    chains.push_back(chain.get());
+    other_chains.push_back(std::move(chain));
+  }
 
-        std::vector<std::vector<ppl::InstancePin>> all_sinks;
+  std::vector<int64> costs(num_chains, getAssignmentCost());
+  std::vector<float> temperatures(num_chains);
+  // [level] -> chain, level 0 being the coldest
+  std::vector<int> level_chains(num_chains);
+  for (int level = 0; level < num_chains; level++) {
+    temperatures[level]
+        = init_temperature_
+          * std::pow(max_temperature_ratio_,
+                     static_cast<float>(level) / (num_chains - 1));
+    level_chains[level] = level;
+  }
 
-        for (int pin_idx = 0; pin_idx < pins.size(); pin_idx++) {
-          std::vector<ppl::InstancePin> pin_sinks;
-          netlist_->getSinksOfIO(pin_idx, pin_sinks);
-          all_sinks.push_back(pin_sinks);
+  // Set by this thread between the two waits of the barrier
+  int iter = 0;
+  int iterations = 0;
+  bool done = false;
+
+  std::exception_ptr exception;
+  std::mutex exception_mutex;
+  const int thread_count = std::clamp(num_threads_, 1, num_chains);
+  auto run_levels = [&](const int worker) {
+    try {
+      for (int level = worker; level < num_chains; level += thread_count) {
+        const int chain = level_chains[level];
+        for (int i = 0; i < iterations; i++) {
+          chains[chain]->annealIteration(
+              iter + i, temperatures[level], costs[chain]);
+          temperatures[level] *= alpha_;
+        }
+      }
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(exception_mutex);
+      if (!exception) {
+        exception = std::current_exception();
+      }
+    }
+  };
+
+  Barrier barrier(thread_count);
+  std::vector<std::thread> threads;
+  threads.reserve(thread_count - 1);
+  for (int worker = 1; worker < thread_count; worker++) {
+    threads.emplace_back([&, worker] {
+      while (true) {
+        barrier.wait();
+        if (done) {
+          return;
         }
+        run_levels(worker);
+        barrier.wait();
+      }
+    });
+  }
+
+  boost::random::mt19937 exchange_generator(seed_);
+  boost::random::uniform_real_distribution<float> distribution;
+  for (; iter < max_iterations_; iter += exchange_interval_) {
+    iterations = std::min(exchange_interval_, max_iterations_ - iter);
+    barrier.wait();
+    run_levels(0);
+    barrier.wait();
+    if (exception) {
+      break;
+    }
 
-        annealingStateVisualization(pins, all_sinks, iter);
+    // Alternate between exchanging the even and the odd level pairs
+    for (int level = (iter / exchange_interval_) % 2; level + 1 < num_chains;
+         level += 2) {
+      const int cold = level_chains[level];
+      const int hot = level_chains[level + 1];
+      const double exponent
+          = static_cast<double>(costs[cold] - costs[hot])
+            * (1.0 / temperatures[level] - 1.0 / temperatures[level + 1]);
+      if (exponent >= 0
+          || distribution(exchange_generator) < std::exp(exponent)) {
+        std::swap(level_chains[level], level_chains[level + 1]);
       }
     }
+
+    debugPrint(logger_,
+               utl::PPL,
+               "annealing",
+               1,
+               "iteration: {}; coldest chain cost: {}",
+               iter + iterations,
+               costs[level_chains[0]]);
+
+    if (debug_->isOn()) {
+      visualizeAssignment(*chains[level_chains[0]], iter + iterations - 1);
+    }
+  }
+
+  done = true;
+  barrier.wait();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  if (exception) {
+    std::rethrow_exception(exception);
+  }
+
+  const int best
+      = std::min_element(costs.begin(), costs.end()) - costs.begin();
+  if (best != 0) {
+    copyStateFrom(*chains[best]);
+  }
+}
+
+void SimulatedAnnealing::copyStateFrom(const SimulatedAnnealing& other)
+{
+  pin_assignment_ = other.pin_assignment_;
+  slots_ = other.slots_;
+  pin_groups_ = other.pin_groups_;
+  sinks_bounds_ = other.sinks_bounds_;
+  mirrored_slots_ = other.mirrored_slots_;
+}
+
+void SimulatedAnnealing::visualizeAssignment(SimulatedAnnealing& chain,
+                                             const int iter)
+{
+  std::vector<ppl::IOPin> pins;
+  chain.getPins(pins);
+
+  std::vector<std::vector<ppl::InstancePin>> all_sinks;
+
+  for (int pin_idx = 0; pin_idx < pins.size(); pin_idx++) {
+    std::vector<ppl::InstancePin> pin_sinks;
+    netlist_->getSinksOfIO(pin_idx, pin_sinks);
+    all_sinks.push_back(pin_sinks);
   }
+
+  annealingStateVisualization(pins, all_sinks, iter);
 }
 
 void SimulatedAnnealing::getAssignment(std::vector<IOPin>& assignment)
+{
+  netlist_->setIOGroups(pin_groups_);
+  getPins(assignment);
+  for (const int slot_idx : pin_assignment_) {
+    io_slots_[slot_idx].used = true;
+  }
+}
+
+void SimulatedAnnealing::getPins(std::vector<IOPin>& pins)
 {
   for (int i = 0; i < pin_assignment_.size(); i++) {
     IOPin& io_pin = netlist_->getIoPin(i);
-    Slot& slot = slots_[pin_assignment_[i]];
+    const Slot& slot = slots_[pin_assignment_[i]];
 
     io_pin.setPos(slot.pos);
     io_pin.setLayer(slot.layer);
     io_pin.setPlaced();
     io_pin.setEdge(slot.edge);
-    assignment.push_back(io_pin);
-    slot.used = true;
+    pins.push_back(io_pin);
   }
 }
 
@@ -210,6 +427,41 @@ void SimulatedAnnealing::init(float init_temperature,
              alpha_);
 
   generator_.seed(seed_);
+
+  if (sinks_bounds_.empty()) {
+    initCostTables();
+  }
+}
+
+void SimulatedAnnealing::initCostTables()
+{
+  sinks_bounds_.resize(num_pins_);
+  for (int pin_idx = 0; pin_idx < num_pins_; pin_idx++) {
+    odb::Rect& bounds = sinks_bounds_[pin_idx];
+    bounds.mergeInit();
+    std::vector<InstancePin> sinks;
+    netlist_->getSinksOfIO(pin_idx, sinks);
+    for (const InstancePin& sink : sinks) {
+      bounds.merge(odb::Rect(sink.getPos(), sink.getPos()));
+    }
+  }
+
+  // Keep the first slot at each position and layer, as a linear search
+  // over the slots would find
+  std::map<std::tuple<int, int, int>, int> slot_by_position;
+  for (int i = 0; i < num_slots_; i++) {
+    const Slot& slot = slots_[i];
+    slot_by_position.emplace(
+        std::make_tuple(slot.pos.getX(), slot.pos.getY(), slot.layer), i);
+  }
+  mirrored_slots_.resize(num_slots_);
+  for (int i = 0; i < num_slots_; i++) {
+    const Slot& slot = slots_[i];
+    const odb::Point mirrored_pos = core_->getMirroredPosition(slot.pos);
+    auto it = slot_by_position.find(std::make_tuple(
+        mirrored_pos.getX(), mirrored_pos.getY(), slot.layer));
+    mirrored_slots_[i] = it != slot_by_position.end() ? it->second : -1;
+  }
 }
 
 void SimulatedAnnealing::randomAssignment()
@@ -354,20 +606,30 @@ int SimulatedAnnealing::getDeltaCost(const int prev_cost)
   return new_cost - prev_cost;
 }
 
+// Same as Netlist::computeIONetHPWL but from the precomputed bounds of
+// the sinks.
 int SimulatedAnnealing::getPinCost(int pin_idx)
 {
   int slot_idx = pin_assignment_[pin_idx];
   const odb::Point& position = slots_[slot_idx].pos;
-  return netlist_->computeIONetHPWL(pin_idx, position);
+  const odb::Rect& sinks = sinks_bounds_[pin_idx];
+  if (sinks.isInverted()) {
+    return 0;
+  }
+
+  const int x = std::max(sinks.xMax(), position.getX())
+                - std::min(sinks.xMin(), position.getX());
+  const int y = std::max(sinks.yMax(), position.getY())
+                - std::min(sinks.yMin(), position.getY());
+
+  return (x + y);
 }
 
 int64 SimulatedAnnealing::getGroupCost(int group_idx)
 {
   int64 cost = 0;
   for (int pin_idx : pin_groups_[group_idx].pin_indices) {
-    int slot_idx = pin_assignment_[pin_idx];
-    const odb::Point& position = slots_[slot_idx].pos;
-    cost += netlist_->computeIONetHPWL(pin_idx, position);
+    cost += getPinCost(pin_idx);
   }
 
   return cost;
@@ -565,7 +827,7 @@ int SimulatedAnnealing::moveGroupToFreeSlots(const int group_idx)
   }
 
   if (free_slot && same_edge_slot) {
-    netlist_->sortPinsFromGroup(group_idx, slots_[new_slot].edge);
+    sortPinsFromGroup(group_idx, slots_[new_slot].edge);
     updateGroupSlots(group.pin_indices, new_slot);
   } else {
     prev_slots_.clear();
@@ -700,7 +962,7 @@ int SimulatedAnnealing::rearrangeConstrainedGroups(int constraint_idx)
     for (int idx : aux_indices) {
       int group_idx = group_indices[idx];
       const PinGroupByIndex& group = pin_groups_[group_idx];
-      netlist_->sortPinsFromGroup(group_idx, slots_[new_slot].edge);
+      sortPinsFromGroup(group_idx, slots_[new_slot].edge);
       updateGroupSlots(group.pin_indices, new_slot);
       cnt++;
       if (cnt < group_limits_list.size()) {
@@ -812,20 +1074,6 @@ void SimulatedAnnealing::getSlotsRange(const IOPin& io_pin,
   }
 }
 
-int SimulatedAnnealing::getSlotIdxByPosition(const odb::Point& position,
-                                             int layer) const
-{
-  int slot_idx = -1;
-  for (int i = 0; i < slots_.size(); i++) {
-    if (slots_[i].pos == position && slots_[i].layer == layer) {
-      slot_idx = i;
-      break;
-    }
-  }
-
-  return slot_idx;
-}
-
 bool SimulatedAnnealing::isFreeForMirrored(const int slot_idx,
                                            int& mirrored_idx) const
 {
@@ -838,14 +1086,12 @@ bool SimulatedAnnealing::isFreeForMirrored(const int slot_idx,
 
 int SimulatedAnnealing::getMirroredSlotIdx(int slot_idx) const
 {
-  const Slot& slot = slots_[slot_idx];
-  const int layer = slot.layer;
-  const odb::Point& position = slot.pos;
-  odb::Point mirrored_pos = core_->getMirroredPosition(position);
-
-  int mirrored_idx = getSlotIdxByPosition(mirrored_pos, layer);
+  const int mirrored_idx = mirrored_slots_[slot_idx];
 
   if (mirrored_idx < 0) {
+    const Slot& slot = slots_[slot_idx];
+    const int layer = slot.layer;
+    const odb::Point mirrored_pos = core_->getMirroredPosition(slot.pos);
     odb::dbTechLayer* tech_layer = db_->getTech()->findRoutingLayer(layer);
     logger_->error(utl::PPL,
                    112,
@@ -902,6 +1148,16 @@ void SimulatedAnnealing::updateGroupSlots(const std::vector<int>& pin_indices,
   }
 }
 
+// Same as Netlist::sortPinsFromGroup on this chain's copy of the groups
+void SimulatedAnnealing::sortPinsFromGroup(int group_idx, Edge edge)
+{
+  PinGroupByIndex& group = pin_groups_[group_idx];
+  std::vector<int>& pin_indices = group.pin_indices;
+  if (group.order && (edge == Edge::top || edge == Edge::left)) {
+    std::reverse(pin_indices.begin(), pin_indices.end());
+  }
+}
+
 void SimulatedAnnealing::countLonePins()
 {
   int pins_in_groups = 0;
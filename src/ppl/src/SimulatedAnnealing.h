@@ -38,7 +38,9 @@
 #include <algorithm>
 #include <boost/random/mersenne_twister.hpp>
 #include <boost/random/uniform_int_distribution.hpp>
+#include <memory>
 #include <random>
+#include <vector>
 
 #include "Core.h"
 #include "Netlist.h"
@@ -75,12 +77,18 @@ class SimulatedAnnealing
                      Logger* logger,
                      odb::dbDatabase* db);
   ~SimulatedAnnealing() = default;
+  // With num_chains > 1 the annealing runs as parallel tempering: the
+  // chains run on up to setNumThreads() threads at different temperatures
+  // and exchange temperatures periodically.  The result only depends on
+  // the seed and the parameters, not on the threads.
   void run(float init_temperature,
            int max_iterations,
            int perturb_per_iter,
            float alpha,
+           int num_chains,
            bool random);
   void getAssignment(std::vector<IOPin>& assignment);
+  void setNumThreads(int threads);
 
   // debug functions
   void setDebugOn(std::unique_ptr<AbstractIOPlacerRenderer> renderer);
@@ -97,6 +105,12 @@ class SimulatedAnnealing
             int max_iterations,
             int perturb_per_iter,
             float alpha);
+  void initCostTables();
+  void copyStateFrom(const SimulatedAnnealing& other);
+  void annealIteration(int iter, float temperature, int64& cost);
+  void runParallelTempering(int num_chains);
+  void visualizeAssignment(SimulatedAnnealing& chain, int iter);
+  void getPins(std::vector<IOPin>& pins);
   void randomAssignment();
   int randomAssignmentForGroups(std::set<int>& placed_pins,
                                 const std::vector<int>& slot_indices);
@@ -118,12 +132,12 @@ class SimulatedAnnealing
   void restorePreviousAssignment();
   bool isFreeForGroup(int& slot_idx, int group_size, int last_slot);
   void getSlotsRange(const IOPin& io_pin, int& first_slot, int& last_slot);
-  int getSlotIdxByPosition(const odb::Point& position, int layer) const;
   bool isFreeForMirrored(int slot_idx, int& mirrored_idx) const;
   int getMirroredSlotIdx(int slot_idx) const;
   void updateSlotsFromGroup(const std::vector<int>& prev_slots_, bool block);
   int computeGroupPrevCost(int group_idx);
   void updateGroupSlots(const std::vector<int>& pin_indices, int& new_slot);
+  void sortPinsFromGroup(int group_idx, Edge edge);
   void countLonePins();
 
   // [pin] -> slot
@@ -131,9 +145,18 @@ class SimulatedAnnealing
   std::vector<int> slot_indices_;
   Netlist* netlist_;
   Core* core_;
-  std::vector<Slot>& slots_;
-  const std::vector<PinGroupByIndex>& pin_groups_;
+  // The caller's slots, marked as used by getAssignment
+  std::vector<Slot>& io_slots_;
+  // Each chain works on its own copy of the slots and of the pin groups,
+  // whose order changes as they move between edges.
+  std::vector<Slot> slots_;
+  std::vector<PinGroupByIndex> pin_groups_;
   const std::vector<Constraint>& constraints_;
+  // [pin] -> bounding box of the instance pins on its net, so that the
+  // cost of a pin in any slot is found without visiting its sinks
+  std::vector<odb::Rect> sinks_bounds_;
+  // [slot] -> mirrored slot, or -1 if there is none
+  std::vector<int> mirrored_slots_;
   int num_slots_;
   int num_pins_;
   int num_groups_;
@@ -157,6 +180,12 @@ class SimulatedAnnealing
   const float group_to_free_slots_ = 0.7;
   const float pins_per_slot_limit_ = 0.5;
 
+  // parallel tempering variables
+  // ratio between the hottest and the coldest chain temperatures
+  const float max_temperature_ratio_ = 100.0;
+  const int exchange_interval_ = 10;  // iterations
+  int num_threads_ = 1;
+
   Logger* logger_ = nullptr;
   odb::dbDatabase* db_;
   const int fail_cost_ = std::numeric_limits<int>::max();
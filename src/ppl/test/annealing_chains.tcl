@@ -0,0 +1,24 @@
+# parallel tempering gives the same pins for any number of threads
+source "helpers.tcl"
+read_lef Nangate45/Nangate45.lef
+read_def gcd.def
+
+set_simulated_annealing -chains 4
+
+proc place_with_threads { threads } {
+  set_thread_count $threads
+  place_pins -hor_layers metal3 -ver_layers metal4 -annealing
+  set def_file [make_result_file annealing_chains_$threads.def]
+  write_def $def_file
+  return $def_file
+}
+
+set serial_def [place_with_threads 1]
+# fewer threads than chains, then more
+set shared_def [place_with_threads 2]
+set capped_def [place_with_threads 8]
+
+check "same pins with 2 threads" { diff_files $serial_def $shared_def } 0
+check "same pins with 8 threads" { diff_files $serial_def $capped_def } 0
+
+exit_summary
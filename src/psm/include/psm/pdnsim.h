@@ -87,6 +87,16 @@ class PDNSim : public odb::dbBlockCallBackObj
     int strap_track_pitch = 10;
   };
 
+  struct SolverSettings
+  {
+    // Use preconditioned conjugate gradient instead of sparse Cholesky
+    bool iterative = false;
+    // Relative residual to stop the iterative solver
+    double tolerance = 1e-10;
+
+    int threads = 1;
+  };
+
   using IRDropByPoint = std::map<odb::Point, double>;
   using IRDropByLayer = std::map<odb::dbTechLayer*, IRDropByPoint>;
 
@@ -125,6 +135,9 @@ class PDNSim : public odb::dbBlockCallBackObj
   void clearSolvers();
 
   void setGeneratedSourceSettings(const GeneratedSourceSettings& settings);
+  void setSolverSettings(const SolverSettings& settings);
+  SolverSettings getSolverSettings() const { return solver_settings_; }
+  void setSolverThreads(int threads);
 
   // from dbBlockCallBackObj
   void inDbPostMoveInst(odb::dbInst*) override;
@@ -162,6 +175,7 @@ class PDNSim : public odb::dbBlockCallBackObj
   bool debug_gui_enabled_ = false;
 
   GeneratedSourceSettings generated_source_settings_;
+  SolverSettings solver_settings_;
 
   std::map<odb::dbNet*, std::unique_ptr<IRSolver>> solvers_;
   std::map<odb::dbNet*, std::map<sta::Corner*, double>> user_voltages_;
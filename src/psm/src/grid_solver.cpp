@@ -0,0 +1,175 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "grid_solver.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace psm {
+
+void GridSolver::setThreads(int threads)
+{
+  threads_ = std::max(1, threads);
+}
+
+std::uint64_t GridSolver::hashMatrix(const Matrix& G)
+{
+  // FNV-1a over 64 bit words
+  std::uint64_t hash = 14695981039346656037ULL;
+  auto add = [&hash](const std::uint64_t word) {
+    hash = (hash ^ word) * 1099511628211ULL;
+  };
+
+  add(G.rows());
+  add(G.cols());
+  add(G.nonZeros());
+  const auto outer = G.outerIndexPtr();
+  for (Matrix::Index i = 0; i <= G.outerSize(); i++) {
+    add(outer[i]);
+  }
+  const auto inner = G.innerIndexPtr();
+  const auto values = G.valuePtr();
+  for (Matrix::Index i = 0; i < G.nonZeros(); i++) {
+    std::uint64_t bits;
+    std::memcpy(&bits, &values[i], sizeof(bits));
+    add(inner[i]);
+    add(bits);
+  }
+  return hash;
+}
+
+bool GridSolver::isFactorized(const Matrix& G) const
+{
+  return factorized_ && factorized_type_ == type_ && G.isCompressed()
+         && hashMatrix(G) == factorized_hash_;
+}
+
+bool GridSolver::factorize(const Matrix& G)
+{
+  if (isFactorized(G)) {
+    return true;
+  }
+
+  clear();
+  Matrix compressed;
+  const Matrix* A = &G;
+  if (!G.isCompressed()) {
+    compressed = G;
+    compressed.makeCompressed();
+    A = &compressed;
+  }
+
+  bool success;
+  if (type_ == Type::DIRECT) {
+    direct_ = std::make_unique<Eigen::SimplicialLDLT<Matrix>>(*A);
+    success = direct_->info() == Eigen::Success;
+  } else {
+    // The solver refers to the matrix it was computed with
+    row_G_ = *A;
+    iterative_ = std::make_unique<IterativeSolver>();
+    iterative_->setTolerance(tolerance_);
+    iterative_->compute(row_G_);
+    success = iterative_->info() == Eigen::Success;
+  }
+
+  if (!success) {
+    clear();
+    return false;
+  }
+
+  factorized_ = true;
+  factorized_type_ = type_;
+  factorized_hash_ = hashMatrix(*A);
+  return true;
+}
+
+bool GridSolver::solve(const Vector& J, Vector& V)
+{
+  if (!factorized_) {
+    return false;
+  }
+
+  if (factorized_type_ == Type::DIRECT) {
+    V = direct_->solve(J);
+    iterations_ = 0;
+    error_ = 0.0;
+    return direct_->info() == Eigen::Success;
+  }
+
+  const int prev_threads = Eigen::nbThreads();
+  Eigen::setNbThreads(threads_);
+  iterative_->setTolerance(tolerance_);
+  if (last_V_.size() == J.size()) {
+    V = iterative_->solveWithGuess(J, last_V_);
+  } else {
+    V = iterative_->solve(J);
+  }
+  Eigen::setNbThreads(prev_threads);
+
+  iterations_ = iterative_->iterations();
+  error_ = iterative_->error();
+  if (iterative_->info() != Eigen::Success) {
+    return false;
+  }
+  last_V_ = V;
+  return true;
+}
+
+void GridSolver::clear()
+{
+  factorized_ = false;
+  factorized_hash_ = 0;
+  row_G_ = RowMatrix();
+  direct_ = nullptr;
+  iterative_ = nullptr;
+  last_V_ = Vector();
+  iterations_ = 0;
+  error_ = 0.0;
+}
+
+std::size_t GridSolver::getMemoryUsage() const
+{
+  constexpr std::size_t entry_size = sizeof(double) + sizeof(int);
+
+  std::size_t nnz = row_G_.nonZeros();
+  if (factorized_) {
+    if (factorized_type_ == Type::DIRECT) {
+      nnz += direct_->matrixL().nestedExpression().nonZeros();
+    } else {
+      nnz += iterative_->preconditioner().matrixL().nonZeros();
+    }
+  }
+  return nnz * entry_size + last_V_.size() * sizeof(double);
+}
+
+}  // namespace psm
@@ -0,0 +1,116 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <Eigen/IterativeLinearSolvers>
+#include <Eigen/Sparse>
+#include <Eigen/SparseCholesky>
+#include <cstdint>
+#include <memory>
+
+namespace psm {
+
+// Solves G * V = J where G is the symmetric positive definite conductance
+// matrix of a power grid. The factorization (or the preconditioner for the
+// iterative solver) is kept and reused as long as G does not change, so
+// solving for another corner or current distribution with the same
+// conductances only costs the substitution.
+class GridSolver
+{
+ public:
+  using Matrix = Eigen::SparseMatrix<double>;
+  using Vector = Eigen::VectorXd;
+
+  enum class Type
+  {
+    DIRECT,    // sparse Cholesky (LDLT)
+    ITERATIVE  // conjugate gradient with incomplete Cholesky preconditioner
+  };
+
+  void setType(Type type) { type_ = type; }
+  Type getType() const { return type_; }
+  // Threads used by the sparse matrix-vector products of the iterative
+  // solver.
+  void setThreads(int threads);
+  // Relative residual at which the iterative solver stops.
+  void setTolerance(double tolerance) { tolerance_ = tolerance; }
+
+  // Returns true if G is the matrix that is currently factorized.
+  bool isFactorized(const Matrix& G) const;
+  // Factorizes G unless it is already factorized. Returns false if G is not
+  // positive definite.
+  bool factorize(const Matrix& G);
+  // Solves with the last factorized matrix. Returns false if the iterative
+  // solver did not converge.
+  bool solve(const Vector& J, Vector& V);
+
+  void clear();
+
+  // Bytes held by the factorization and, for the iterative solver, the row
+  // major copy of G it iterates on.
+  std::size_t getMemoryUsage() const;
+  int getIterations() const { return iterations_; }
+  double getError() const { return error_; }
+
+ private:
+  using RowMatrix = Eigen::SparseMatrix<double, Eigen::RowMajor>;
+  // Using both triangles of a row major matrix lets Eigen run the sparse
+  // matrix-vector products of the conjugate gradient in parallel.
+  using IterativeSolver
+      = Eigen::ConjugateGradient<RowMatrix,
+                                 Eigen::Lower | Eigen::Upper,
+                                 Eigen::IncompleteCholesky<double>>;
+
+  // Hash of the dimensions and of the structure and values of the nonzeros
+  // of a compressed matrix, which identifies the factorized matrix without
+  // keeping a copy of it.
+  static std::uint64_t hashMatrix(const Matrix& G);
+
+  Type type_ = Type::DIRECT;
+  int threads_ = 1;
+  double tolerance_ = 1e-10;
+
+  bool factorized_ = false;
+  Type factorized_type_ = Type::DIRECT;
+  std::uint64_t factorized_hash_ = 0;
+  RowMatrix row_G_;
+  std::unique_ptr<Eigen::SimplicialLDLT<Matrix>> direct_;
+  std::unique_ptr<IterativeSolver> iterative_;
+  // Last solution, used as initial guess by the iterative solver
+  Vector last_V_;
+
+  int iterations_ = 0;
+  double error_ = 0.0;
+};
+
+}  // namespace psm
@@ -32,7 +32,6 @@
 
 #include "ir_solver.h"
 
-#include <Eigen/SparseLU>
 #include <fstream>
 #include <list>
 #include <queue>
@@ -59,7 +58,8 @@ IRSolver::IRSolver(
     rsz::Resizer* resizer,
     utl::Logger* logger,
     const std::map<odb::dbNet*, std::map<sta::Corner*, Voltage>>& user_voltages,
-    const PDNSim::GeneratedSourceSettings& generated_source_settings)
+    const PDNSim::GeneratedSourceSettings& generated_source_settings,
+    const PDNSim::SolverSettings& solver_settings)
     : net_(net),
       logger_(logger),
       resizer_(resizer),
@@ -67,7 +67,8 @@ IRSolver::IRSolver(
       network_(new IRNetwork(net_, logger_, floorplanning)),
       gui_(nullptr),
       user_voltages_(user_voltages),
-      generated_source_settings_(generated_source_settings)
+      generated_source_settings_(generated_source_settings),
+      solver_settings_(solver_settings)
 {
 }
 
@@ -761,25 +762,16 @@ std::map<Node*, std::size_t> IRSolver::assignNodeIDs(const Node::NodeSet& nodes,
   return node_index;
 }
 
-std::map<Node*, std::size_t> IRSolver::assignNodeIDs(
-    const std::vector<std::unique_ptr<SourceNode>>& nodes,
-    std::size_t start) const
-{
-  Node::NodeSet node_set;
-  for (const auto& node : nodes) {
-    node_set.insert(node.get());
-  }
-  return assignNodeIDs(node_set, start);
-}
-
 void IRSolver::buildCondMatrixAndVoltages(
     bool is_ground,
+    Voltage src_voltage,
+    const Node::NodeSet& source_nodes,
     const std::map<Node*, Connection::ConnectionSet>& node_connections,
     const ValueNodeMap<Current>& currents,
     const std::map<psm::Connection*, Connection::Conductance>& conductance,
     const std::map<Node*, std::size_t>& node_index,
-    Eigen::SparseMatrix<Connection::Conductance>& G,
-    Eigen::VectorXd& J) const
+    GridSolver::Matrix& G,
+    GridSolver::Vector& J) const
 {
   const utl::DebugScopedTimer timer(
       logger_, utl::PSM, "timer", 1, "Build G and J: {}");
@@ -788,24 +780,31 @@ void IRSolver::buildCondMatrixAndVoltages(
   std::size_t count = 0;
   std::vector<Eigen::Triplet<Connection::Conductance>> cond_values;
   for (const auto& [node, connections] : node_connections) {
+    if (source_nodes.find(node) != source_nodes.end()) {
+      continue;
+    }
     const std::size_t node_idx = node_index.at(node);
 
+    Current node_current = 0;
     auto find_node = currents.find(node);
-    if (find_node == currents.end()) {
-      J[node_idx] = 0;
-    } else {
-      J[node_idx] = find_node->second;
+    if (find_node != currents.end()) {
+      node_current = find_node->second;
     }
+    J[node_idx] = is_ground ? node_current : -node_current;
 
     Connection::Conductance node_cond = 0.0;
     for (auto* conn : connections) {
       Node* other = conn->getOtherNode(node);
-      const std::size_t other_idx = node_index.at(other);
 
       const Connection::Conductance cond = conductance.at(conn);
       node_cond += cond;
 
-      cond_values.emplace_back(node_idx, other_idx, -cond);
+      if (source_nodes.find(other) != source_nodes.end()) {
+        // The source voltage is known, so it moves to the right hand side
+        J[node_idx] += cond * src_voltage;
+      } else {
+        cond_values.emplace_back(node_idx, node_index.at(other), -cond);
+      }
     }
     cond_values.emplace_back(node_idx, node_idx, node_cond);
     if (print_progress && count % 1000 == 0) {
@@ -815,47 +814,9 @@ void IRSolver::buildCondMatrixAndVoltages(
     count++;
   }
   G.setFromTriplets(cond_values.begin(), cond_values.end());
-  if (!is_ground) {
-    for (auto& j : J) {
-      j = -j;
-    }
-  }
   cond_values.clear();
 }
 
-void IRSolver::addSourcesToMatrixAndVoltages(
-    Voltage src_voltage,
-    const std::vector<std::unique_ptr<psm::SourceNode>>& sources,
-    const std::map<Node*, std::size_t>& node_index,
-    Eigen::SparseMatrix<Connection::Conductance>& G,
-    Eigen::VectorXd& J) const
-{
-  // Attach sources as current sources through a 1 ohm resistor
-  constexpr Connection::Resistance src_res = 1.0;
-  const Connection::Conductance src_cond = 1.0 / src_res;
-
-  for (const auto& src_node : sources) {
-    const std::size_t idx = node_index.at(src_node.get());
-
-    J[idx] = src_voltage / src_res;
-
-    Node* real_node = src_node->getSource();
-
-    const std::size_t real_node_idx = node_index.at(real_node);
-
-    debugPrint(logger_,
-               utl::PSM,
-               "solve",
-               2,
-               "Adding source node {} to {}",
-               idx,
-               real_node_idx);
-
-    G.insert(idx, real_node_idx) = src_cond;
-    G.insert(real_node_idx, idx) = src_cond;
-  }
-}
-
 void IRSolver::solve(sta::Corner* corner,
                      GeneratedSourceType source_type,
                      const std::string& source_file)
@@ -899,13 +860,22 @@ void IRSolver::solve(sta::Corner* corner,
   Voltage src_voltage
       = generateSourceNodes(source_type, source_file, corner, src_nodes);
 
+  // Nodes connected to a source are held at the source voltage and are not
+  // part of the system, which keeps G symmetric positive definite.
+  Node::NodeSet source_nodes;
+  for (const auto& src_node : src_nodes) {
+    source_nodes.insert(src_node->getSource());
+  }
+  Node::NodeSet free_nodes;
+  for (auto* node : all_nodes) {
+    if (source_nodes.find(node) == source_nodes.end()) {
+      free_nodes.insert(node);
+    }
+  }
+
   // Solve
   // create vector of nodes
-  std::map<Node*, std::size_t> node_index = assignNodeIDs(all_nodes);
-  const std::map<Node*, std::size_t> real_node_index = node_index;
-  for (const auto& [node, id] : assignNodeIDs(src_nodes, node_index.size())) {
-    node_index[node] = id;
-  }
+  const std::map<Node*, std::size_t> node_index = assignNodeIDs(free_nodes);
 
   const std::size_t num_nodes = node_index.size();
 
@@ -915,42 +885,54 @@ void IRSolver::solve(sta::Corner* corner,
              1,
              "Nodes in all nodes: {}",
              all_nodes.size());
+  debugPrint(
+      logger_, utl::PSM, "stats", 1, "Source nodes: {}", source_nodes.size());
   debugPrint(logger_, utl::PSM, "stats", 1, "Nodes in matrix: {}", num_nodes);
 
   // create sparse matrix and vector
-  Eigen::SparseMatrix<Connection::Conductance> G(num_nodes, num_nodes);
-  Eigen::VectorXd J(num_nodes);
+  GridSolver::Matrix G(num_nodes, num_nodes);
+  GridSolver::Vector J(num_nodes);
 
   // Build G and J
   buildCondMatrixAndVoltages(src_voltage == 0.0,
+                             src_voltage,
+                             source_nodes,
                              node_connections,
                              currents,
                              conductance,
                              node_index,
                              G,
                              J);
-  addSourcesToMatrixAndVoltages(src_voltage, src_nodes, node_index, G, J);
 
-  Eigen::SparseLU<Eigen::SparseMatrix<Connection::Conductance>> eigen_solver;
+  grid_solver_.setType(solver_settings_.iterative
+                           ? GridSolver::Type::ITERATIVE
+                           : GridSolver::Type::DIRECT);
+  grid_solver_.setThreads(solver_settings_.threads);
+  grid_solver_.setTolerance(solver_settings_.tolerance);
 
-  debugPrint(logger_, utl::PSM, "solve", 1, "Factorizing the G matrix");
-  eigen_solver.compute(G);
-  if (eigen_solver.info() != Eigen::ComputationInfo::Success) {
-    // decomposition failed
-    if (logger_->debugCheck(utl::PSM, "dump", 1)) {
-      network_->dumpNodes(node_index);
-      dumpMatrix(G, "G");
+  if (grid_solver_.isFactorized(G)) {
+    debugPrint(
+        logger_, utl::PSM, "solve", 1, "Reusing the G matrix factorization");
+  } else {
+    const utl::DebugScopedTimer factor_timer(
+        logger_, utl::PSM, "timer", 1, "Factorize G: {}");
+    debugPrint(logger_, utl::PSM, "solve", 1, "Factorizing the G matrix");
+    if (!grid_solver_.factorize(G)) {
+      // decomposition failed
+      if (logger_->debugCheck(utl::PSM, "dump", 1)) {
+        network_->dumpNodes(node_index);
+        dumpMatrix(G, "G");
+      }
+      logger_->error(utl::PSM,
+                     10,
+                     "Factorization of the G Matrix failed, the matrix is not "
+                     "positive definite.");
     }
-    logger_->error(
-        utl::PSM,
-        10,
-        "LU factorization of the G Matrix failed. SparseLU solver message: {}.",
-        eigen_solver.lastErrorMessage());
   }
 
   debugPrint(logger_, utl::PSM, "solve", 1, "Solving system of equations GV=J");
-  const Eigen::VectorXd V = eigen_solver.solve(J);
-  if (eigen_solver.info() != Eigen::ComputationInfo::Success) {
+  GridSolver::Vector V;
+  if (!grid_solver_.solve(J, V)) {
     // solving failed
     if (logger_->debugCheck(utl::PSM, "dump", 1)) {
       network_->dumpNodes(node_index);
@@ -963,7 +945,11 @@ void IRSolver::solve(sta::Corner* corner,
              utl::PSM,
              "solve",
              1,
-             "Solving system of equations GV=J complete");
+             "Solving system of equations GV=J complete ({} iterations, error "
+             "{:.3e}, {} bytes)",
+             grid_solver_.getIterations(),
+             grid_solver_.getError(),
+             grid_solver_.getMemoryUsage());
 
   if (logger_->debugCheck(utl::PSM, "dump", 2)) {
     network_->dumpNodes(node_index);
@@ -971,9 +957,12 @@ void IRSolver::solve(sta::Corner* corner,
     dumpVector(J, "J");
     dumpVector(V, "V");
   }
-  for (const auto& [node, node_idx] : real_node_index) {
+  for (const auto& [node, node_idx] : node_index) {
     voltages[node] = V[node_idx];
   }
+  for (auto* node : source_nodes) {
+    voltages[node] = src_voltage;
+  }
   solution_voltages_[corner] = src_voltage;
 }
 
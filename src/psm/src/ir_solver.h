@@ -41,6 +41,7 @@
 #include <vector>
 
 #include "debug_gui.h"
+#include "grid_solver.h"
 #include "ir_network.h"
 #include "node.h"
 #include "odb/db.h"
@@ -94,7 +95,8 @@ class IRSolver
            utl::Logger* logger,
            const std::map<odb::dbNet*, std::map<sta::Corner*, Voltage>>&
                user_voltages,
-           const PDNSim::GeneratedSourceSettings& generated_source_settings);
+           const PDNSim::GeneratedSourceSettings& generated_source_settings,
+           const PDNSim::SolverSettings& solver_settings);
 
   odb::dbNet* getNet() const { return net_; };
 
@@ -194,23 +196,16 @@ class IRSolver
                            ValueNodeMap<Current>& currents) const;
   std::map<Node*, std::size_t> assignNodeIDs(const Node::NodeSet& nodes,
                                              std::size_t start = 0) const;
-  std::map<Node*, std::size_t> assignNodeIDs(
-      const std::vector<std::unique_ptr<SourceNode>>& nodes,
-      std::size_t start = 0) const;
   void buildCondMatrixAndVoltages(
       bool is_ground,
+      Voltage src_voltage,
+      const Node::NodeSet& source_nodes,
       const std::map<Node*, Connection::ConnectionSet>& node_connections,
       const ValueNodeMap<Current>& currents,
       const std::map<psm::Connection*, Connection::Conductance>& conductance,
       const std::map<Node*, std::size_t>& node_index,
-      Eigen::SparseMatrix<Connection::Conductance>& G,
-      Eigen::VectorXd& J) const;
-  void addSourcesToMatrixAndVoltages(
-      Voltage src_voltage,
-      const std::vector<std::unique_ptr<psm::SourceNode>>& sources,
-      const std::map<Node*, std::size_t>& node_index,
-      Eigen::SparseMatrix<Connection::Conductance>& G,
-      Eigen::VectorXd& J) const;
+      GridSolver::Matrix& G,
+      GridSolver::Vector& J) const;
 
   std::string getMetricKey(const std::string& key, sta::Corner* corner) const;
 
@@ -235,6 +230,10 @@ class IRSolver
   std::map<sta::Corner*, Voltage> solution_voltages_;
 
   const PDNSim::GeneratedSourceSettings& generated_source_settings_;
+  const PDNSim::SolverSettings& solver_settings_;
+
+  // Keeps the factorization of G between corners and current changes
+  GridSolver grid_solver_;
 
   // Holds nodes that were visited during the open net check
   std::set<const Node*> visited_;
@@ -171,7 +171,8 @@ psm::IRSolver* PDNSim::getIRSolver(odb::dbNet* net, bool floorplanning)
                                         resizer_,
                                         logger_,
                                         user_voltages_,
-                                        generated_source_settings_);
+                                        generated_source_settings_,
+                                        solver_settings_);
     addOwner(net->getBlock());
   }
 
@@ -220,6 +221,19 @@ void PDNSim::setGeneratedSourceSettings(const GeneratedSourceSettings& settings)
   }
 }
 
+void PDNSim::setSolverSettings(const SolverSettings& settings)
+{
+  solver_settings_.iterative = settings.iterative;
+  if (settings.tolerance > 0) {
+    solver_settings_.tolerance = settings.tolerance;
+  }
+}
+
+void PDNSim::setSolverThreads(int threads)
+{
+  solver_settings_.threads = threads;
+}
+
 void PDNSim::clearSolvers()
 {
   solvers_.clear();
@@ -81,6 +81,7 @@ void
 analyze_power_grid_cmd(odb::dbNet* net, Corner* corner, psm::GeneratedSourceType type, const char* error_file, bool enable_em, const char* em_file, const char* voltage_file, const char* voltage_source_file)
 {
   PDNSim* pdnsim = getPDNSim();
+  pdnsim->setSolverThreads(ord::OpenRoad::openRoad()->getThreadCount());
   pdnsim->analyzePowerGrid(net, corner, type, voltage_file, enable_em, em_file, error_file, voltage_source_file);
 }
 
@@ -137,5 +138,30 @@ void set_source_settings(int bump_dx, int bump_dy, int bump_size, int bump_inter
   pdnsim->setGeneratedSourceSettings(settings);
 }
 
+void set_solver_settings(const char* solver, double tolerance)
+{
+  PDNSim* pdnsim = getPDNSim();
+  // An empty solver keeps the current one
+  PDNSim::SolverSettings settings = pdnsim->getSolverSettings();
+  if (strlen(solver) > 0) {
+    settings.iterative = strcmp(solver, "iterative") == 0;
+  }
+  settings.tolerance = tolerance;
+
+  pdnsim->setSolverSettings(settings);
+}
+
+const char* get_solver_type()
+{
+  PDNSim* pdnsim = getPDNSim();
+  return pdnsim->getSolverSettings().iterative ? "iterative" : "direct";
+}
+
+double get_solver_tolerance()
+{
+  PDNSim* pdnsim = getPDNSim();
+  return pdnsim->getSolverSettings().tolerance;
+}
+
 %} // inline
 
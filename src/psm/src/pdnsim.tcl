@@ -262,6 +262,31 @@ proc set_pdnsim_source_settings { args } {
   psm::set_source_settings $dx $dy $size $interval $track_pitch
 }
 
+sta::define_cmd_args "set_pdnsim_solver_settings" {
+  [-solver direct|iterative]
+  [-tolerance tolerance]}
+
+proc set_pdnsim_solver_settings { args } {
+  sta::parse_key_args "set_pdnsim_solver_settings" args \
+    keys {-solver -tolerance} flags {}
+
+  set solver ""
+  if { [info exists keys(-solver)] } {
+    set solver $keys(-solver)
+    if { $solver != "direct" && $solver != "iterative" } {
+      utl::error PSM 63 "-solver must be direct or iterative."
+    }
+  }
+
+  set tolerance 0
+  if { [info exists keys(-tolerance)] } {
+    set tolerance $keys(-tolerance)
+    sta::check_positive_float "-tolerance" $tolerance
+  }
+
+  psm::set_solver_settings $solver $tolerance
+}
+
 namespace eval psm {
 
 proc find_net {net_name} {
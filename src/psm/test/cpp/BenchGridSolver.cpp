@@ -0,0 +1,194 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Reports the time and memory of the power grid solver on synthetic meshes.
+//
+// Usage: BenchGridSolver [mesh_size ...]
+//
+// Each mesh is an n x n grid of unit conductances with a voltage source
+// every 16 nodes. For each solver type the factorization is timed, then two
+// solves with different currents, the second one reusing the factorization.
+
+#include <sys/resource.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "grid_solver.h"
+
+namespace {
+
+using psm::GridSolver;
+
+double elapsed(const std::chrono::steady_clock::time_point& start)
+{
+  return std::chrono::duration<double>(std::chrono::steady_clock::now()
+                                       - start)
+      .count();
+}
+
+long peakRSSKb()
+{
+  rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+}
+
+// Conductance matrix of the mesh with the source nodes eliminated.
+GridSolver::Matrix buildMesh(int n, GridSolver::Vector& J)
+{
+  constexpr int source_pitch = 16;
+  auto is_source = [](int x, int y) {
+    return x % source_pitch == 0 && y % source_pitch == 0;
+  };
+
+  std::vector<int> index(n * n, -1);
+  int nodes = 0;
+  for (int y = 0; y < n; y++) {
+    for (int x = 0; x < n; x++) {
+      if (!is_source(x, y)) {
+        index[y * n + x] = nodes++;
+      }
+    }
+  }
+
+  std::vector<Eigen::Triplet<double>> triplets;
+  triplets.reserve(5 * nodes);
+  J = GridSolver::Vector::Zero(nodes);
+  for (int y = 0; y < n; y++) {
+    for (int x = 0; x < n; x++) {
+      const int idx = index[y * n + x];
+      if (idx < 0) {
+        continue;
+      }
+      double diag = 0;
+      const int nbrs[4][2] = {{x - 1, y}, {x + 1, y}, {x, y - 1}, {x, y + 1}};
+      for (const auto& [nx, ny] : nbrs) {
+        if (nx < 0 || ny < 0 || nx >= n || ny >= n) {
+          continue;
+        }
+        diag += 1.0;
+        const int other = index[ny * n + nx];
+        if (other < 0) {
+          J[idx] += 1.0;  // 1V source
+        } else {
+          triplets.emplace_back(idx, other, -1.0);
+        }
+      }
+      triplets.emplace_back(idx, idx, diag);
+    }
+  }
+
+  GridSolver::Matrix G(nodes, nodes);
+  G.setFromTriplets(triplets.begin(), triplets.end());
+  return G;
+}
+
+void run(int n, GridSolver::Type type, int threads)
+{
+  GridSolver::Vector J;
+  const GridSolver::Matrix G = buildMesh(n, J);
+
+  GridSolver solver;
+  solver.setType(type);
+  solver.setThreads(threads);
+
+  auto start = std::chrono::steady_clock::now();
+  if (!solver.factorize(G)) {
+    std::printf("%10d  factorization failed\n", static_cast<int>(G.rows()));
+    return;
+  }
+  const double factor_time = elapsed(start);
+
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<double> current(0.0, 1e-4);
+  GridSolver::Vector J1 = J;
+  GridSolver::Vector J2 = J;
+  for (int i = 0; i < J.size(); i++) {
+    J1[i] -= current(rng);
+    J2[i] -= current(rng);
+  }
+
+  GridSolver::Vector V;
+  start = std::chrono::steady_clock::now();
+  const bool solved = solver.solve(J1, V);
+  const double solve_time = elapsed(start);
+
+  // Same conductances, new currents: the factorization is reused.
+  start = std::chrono::steady_clock::now();
+  const bool reused = solver.factorize(G) && solver.solve(J2, V);
+  const double resolve_time = elapsed(start);
+
+  std::printf("%10d %10s %12.3f %12.3f %12.3f %12.1f %10ld %6d %s\n",
+              static_cast<int>(G.rows()),
+              type == GridSolver::Type::DIRECT ? "direct" : "iterative",
+              factor_time,
+              solve_time,
+              resolve_time,
+              static_cast<double>(solver.getMemoryUsage()) / G.rows(),
+              peakRSSKb(),
+              solver.getIterations(),
+              solved && reused ? "" : "(failed)");
+}
+
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+  std::vector<int> sizes;
+  for (int i = 1; i < argc; i++) {
+    sizes.push_back(std::atoi(argv[i]));
+  }
+  if (sizes.empty()) {
+    sizes = {100, 300, 1000};
+  }
+  const char* threads_env = std::getenv("OMP_NUM_THREADS");
+  const int threads = threads_env != nullptr ? std::atoi(threads_env) : 1;
+
+  std::printf("%10s %10s %12s %12s %12s %12s %10s %6s\n",
+              "nodes",
+              "solver",
+              "factor(s)",
+              "solve(s)",
+              "resolve(s)",
+              "bytes/node",
+              "rss(KB)",
+              "iters");
+  for (const int n : sizes) {
+    run(n, GridSolver::Type::DIRECT, threads);
+    run(n, GridSolver::Type::ITERATIVE, threads);
+  }
+  return 0;
+}
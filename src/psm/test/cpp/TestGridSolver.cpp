@@ -0,0 +1,146 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <vector>
+
+#include "grid_solver.h"
+#include "gtest/gtest.h"
+
+namespace psm {
+namespace {
+
+// Chain of unit resistors between two 1V sources, with the end nodes
+// eliminated: node i is connected to i - 1 and i + 1.
+GridSolver::Matrix chain(int nodes, GridSolver::Vector& J)
+{
+  std::vector<Eigen::Triplet<double>> triplets;
+  J = GridSolver::Vector::Zero(nodes);
+  for (int i = 0; i < nodes; i++) {
+    triplets.emplace_back(i, i, 2.0);
+    if (i > 0) {
+      triplets.emplace_back(i, i - 1, -1.0);
+    }
+    if (i < nodes - 1) {
+      triplets.emplace_back(i, i + 1, -1.0);
+    }
+  }
+  J[0] = 1.0;
+  J[nodes - 1] = 1.0;
+  GridSolver::Matrix G(nodes, nodes);
+  G.setFromTriplets(triplets.begin(), triplets.end());
+  return G;
+}
+
+TEST(GridSolver, NoCurrentGivesSourceVoltage)
+{
+  for (const auto type : {GridSolver::Type::DIRECT,
+                          GridSolver::Type::ITERATIVE}) {
+    GridSolver::Vector J;
+    const GridSolver::Matrix G = chain(50, J);
+
+    GridSolver solver;
+    solver.setType(type);
+    ASSERT_TRUE(solver.factorize(G));
+
+    GridSolver::Vector V;
+    ASSERT_TRUE(solver.solve(J, V));
+    for (int i = 0; i < V.size(); i++) {
+      EXPECT_NEAR(V[i], 1.0, 1e-8);
+    }
+  }
+}
+
+TEST(GridSolver, IterativeMatchesDirect)
+{
+  GridSolver::Vector J;
+  const GridSolver::Matrix G = chain(200, J);
+  for (int i = 0; i < J.size(); i++) {
+    J[i] -= 1e-4 * (i % 7);
+  }
+
+  GridSolver direct;
+  GridSolver::Vector V_direct;
+  ASSERT_TRUE(direct.factorize(G));
+  ASSERT_TRUE(direct.solve(J, V_direct));
+
+  GridSolver iterative;
+  iterative.setType(GridSolver::Type::ITERATIVE);
+  iterative.setThreads(2);
+  GridSolver::Vector V_iterative;
+  ASSERT_TRUE(iterative.factorize(G));
+  ASSERT_TRUE(iterative.solve(J, V_iterative));
+
+  EXPECT_LT((V_direct - V_iterative).lpNorm<Eigen::Infinity>(), 1e-8);
+}
+
+TEST(GridSolver, FactorizationIsReused)
+{
+  GridSolver::Vector J;
+  GridSolver::Matrix G = chain(20, J);
+
+  GridSolver solver;
+  EXPECT_FALSE(solver.isFactorized(G));
+  ASSERT_TRUE(solver.factorize(G));
+  EXPECT_TRUE(solver.isFactorized(G));
+
+  // A different solver type needs a new factorization
+  solver.setType(GridSolver::Type::ITERATIVE);
+  EXPECT_FALSE(solver.isFactorized(G));
+  solver.setType(GridSolver::Type::DIRECT);
+  EXPECT_TRUE(solver.isFactorized(G));
+
+  // The matrix built again for the next solve is recognized
+  GridSolver::Vector J_again;
+  EXPECT_TRUE(solver.isFactorized(chain(20, J_again)));
+  EXPECT_FALSE(solver.isFactorized(chain(21, J_again)));
+
+  // A change in conductance needs a new factorization too
+  G.coeffRef(3, 3) = 3.0;
+  EXPECT_FALSE(solver.isFactorized(G));
+}
+
+TEST(GridSolver, SingularMatrixFails)
+{
+  // Floating node: no path to a source
+  GridSolver::Matrix G(2, 2);
+  G.insert(0, 0) = 1.0;
+  G.insert(0, 1) = -1.0;
+  G.insert(1, 0) = -1.0;
+  G.insert(1, 1) = 1.0;
+  G.makeCompressed();
+
+  GridSolver solver;
+  EXPECT_FALSE(solver.factorize(G));
+}
+
+}  // namespace
+}  // namespace psm
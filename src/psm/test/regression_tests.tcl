@@ -30,3 +30,6 @@ record_tests {
   #psm_man_tcl_check
   #psm_readme_msgs_check
 }
+record_pass_fail_tests {
+  solver_settings
+}
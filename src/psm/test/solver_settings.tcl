@@ -0,0 +1,24 @@
+# check that set_pdnsim_solver_settings only changes the given settings
+source "helpers.tcl"
+
+read_lef Nangate45/Nangate45.lef
+read_def Nangate45_data/gcd.def
+
+check "default solver" { psm::get_solver_type } direct
+
+set_pdnsim_solver_settings -solver iterative
+check "set solver" { psm::get_solver_type } iterative
+check "default tolerance" { psm::get_solver_tolerance } 1e-10
+
+set_pdnsim_solver_settings -tolerance 1e-8
+check "-tolerance keeps the solver" { psm::get_solver_type } iterative
+check "set tolerance" { psm::get_solver_tolerance } 1e-8
+
+set_pdnsim_solver_settings -solver direct
+check "set solver back" { psm::get_solver_type } direct
+check "-solver keeps the tolerance" { psm::get_solver_tolerance } 1e-8
+
+catch { set_pdnsim_solver_settings -solver lu } error
+check "unknown solver is rejected" { psm::get_solver_type } direct
+
+exit_summary
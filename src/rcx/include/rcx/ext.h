@@ -118,6 +118,8 @@ class Ext
     int context_depth = 5;
     int cc_model = 10;
     bool lef_res = false;
+    int threads = 1;
+    bool incremental = false;
   };
 
   void extract(ExtractOptions options);
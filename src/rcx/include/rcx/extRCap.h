@@ -33,10 +33,13 @@
 #pragma once
 
 #include <map>
+#include <set>
+#include <vector>
 
 #include "ext2dBox.h"
 #include "extprocess.h"
 #include "odb/db.h"
+#include "odb/dbBlockCallBackObj.h"
 #include "odb/dbExtControl.h"
 #include "odb/dbShape.h"
 #include "odb/odb.h"
@@ -137,7 +140,7 @@ class extDistRCTable
   extDistRC* getComputeRC(uint dist);
   extDistRC* getRC(uint s, bool compute);
   extDistRC* getComputeRC_res(uint dist1, uint dist2);
-  extDistRC* findIndexed_res(uint dist1, uint dist2);
+  extDistRC* findIndexed_res(uint index_dist, uint dist1, uint dist2);
   int getComputeRC_maxDist();
   uint writeRules(FILE* fp,
                   Ath__array1D<extDistRC*>* table,
@@ -863,8 +866,8 @@ class extMeasure
                    uint trackn,
                    Ath__array1D<SEQ*>* residueSeq);
 
-  odb::dbCCSeg* makeCcap(odb::dbRSeg* rseg1, odb::dbRSeg* rseg2, double ccCap);
-  void addCCcap(odb::dbCCSeg* ccap, double v, uint model);
+  bool makeCcap(odb::dbRSeg* rseg1, odb::dbRSeg* rseg2, double ccCap);
+  void addCCcap(odb::dbRSeg* rseg1, odb::dbRSeg* rseg2, double v, uint model);
   void addFringe(odb::dbRSeg* rseg1,
                  odb::dbRSeg* rseg2,
                  double frCap,
@@ -1230,6 +1233,92 @@ class extCorner
   extCorner* _extCornerPtr;
 };
 
+// A range [lo, hi) of track coordinates in one direction that the tiled
+// coupling flow extracts as a unit; the last tile runs to the block edge.
+struct extTile
+{
+  uint dir;
+  int lo;
+  int hi;
+  bool last;
+};
+
+// Records the signal nets whose routing or connectivity changed since the
+// last extraction of a block, for extract_parasitics -incremental.
+class extNetTracker : public odb::dbBlockCallBackObj
+{
+ public:
+  // Start tracking block with no net changed
+  void track(odb::dbBlock* block);
+  bool isTracking(odb::dbBlock* block) const
+  {
+    return hasOwner() && _block == block;
+  }
+  void clear()
+  {
+    _netIds.clear();
+    _removedShapes.clear();
+  }
+  const std::set<uint>& getChangedNets() const { return _netIds; }
+  // Shapes of the wires removed since the last extraction, with the
+  // pitch of their layer
+  const std::vector<std::pair<odb::Rect, int>>& getRemovedShapes() const
+  {
+    return _removedShapes;
+  }
+
+  void inDbNetDestroy(odb::dbNet* net) override;
+  void inDbITermPostConnect(odb::dbITerm* iterm) override;
+  void inDbITermPreDisconnect(odb::dbITerm* iterm) override;
+  void inDbBTermPostConnect(odb::dbBTerm* bterm) override;
+  void inDbBTermPreDisconnect(odb::dbBTerm* bterm) override;
+  void inDbWireCreate(odb::dbWire* wire) override;
+  void inDbWireDestroy(odb::dbWire* wire) override;
+  void inDbWirePostModify(odb::dbWire* wire) override;
+  void inDbWirePostAttach(odb::dbWire* wire) override;
+  void inDbWirePreDetach(odb::dbWire* wire) override;
+
+ private:
+  void addNet(odb::dbNet* net);
+  void addRemovedWire(odb::dbWire* wire);
+
+  odb::dbBlock* _block = nullptr;
+  std::set<uint> _netIds;
+  std::vector<std::pair<odb::Rect, int>> _removedShapes;
+};
+
+// RC updates made while extracting one tile of a parallel coupling flow.
+// They are recorded by id and applied to the block tile by tile once the
+// batch of tiles extracted with it is done, so that no tile reads the block
+// while it changes and the result does not depend on the thread count.
+class extRCUpdates
+{
+ public:
+  void addCap(uint rsegId, int dbIndex, double cap);
+  void addRes(uint rsegId, int dbIndex, double res);
+  void addCoupling(uint capNodeId1, uint capNodeId2, int dbIndex, double cap);
+  void apply(odb::dbBlock* block) const;
+  uint getCnt() const { return _updates.size(); }
+
+ private:
+  enum Kind : char
+  {
+    CAP,
+    RES,
+    COUPLING
+  };
+  struct Update
+  {
+    Kind kind;
+    int dbIndex;
+    uint id1;
+    uint id2;
+    double value;
+  };
+
+  std::vector<Update> _updates;
+};
+
 class extMain
 {
  public:
@@ -1351,6 +1440,27 @@ class extMain
                     uint ccFlag,
                     extMeasure* m,
                     CoupleAndCompute coupleAndCompute);
+  void getBandTiles(odb::Rect& extRect,
+                    uint ccFlag,
+                    uint maxPitch,
+                    std::vector<extTile>& tiles);
+  void getIncrementalTiles(odb::Rect& extRect,
+                           uint ccFlag,
+                           uint maxPitch,
+                           std::vector<extTile>& tiles);
+  void couplingFlowTiles(odb::Rect& extRect,
+                         uint ccFlag,
+                         const std::vector<extTile>& tiles,
+                         CoupleAndCompute coupleAndCompute);
+  void initTileWorker(extMain* parent);
+  uint couplingTile(odb::Rect& extRect,
+                    uint ccFlag,
+                    uint dir,
+                    int lo,
+                    int hi,
+                    bool lastTile,
+                    CoupleAndCompute coupleAndCompute);
+  void initCouplingMeasure(extMeasure* m);
   uint initPlanes(uint dir,
                   int* wLL,
                   int* wUR,
@@ -1417,9 +1527,20 @@ class extMain
   double getFringe(uint met, uint width, uint modelIndex, double& areaCap);
   void printNet(odb::dbNet* net, uint netId);
   double calcFringe(extDistRC* rc, double deltaFr, bool includeCoupling);
-  double updateTotalCap(odb::dbRSeg* rseg, double cap, uint modelIndex);
+  void updateTotalCap(odb::dbRSeg* rseg, double cap, uint modelIndex);
   bool updateCoupCap(odb::dbRSeg* rseg1, odb::dbRSeg* rseg2, int jj, double v);
-  double updateRes(odb::dbRSeg* rseg, double res, uint model);
+  void updateRes(odb::dbRSeg* rseg, double res, uint model);
+
+  // All RC values of the coupling flow are stored through these, so that
+  // they can be recorded while extracting a tile in parallel.
+  void addRsegCap(odb::dbRSeg* rseg, double cap, int dbIndex);
+  void addRsegRes(odb::dbRSeg* rseg, double res, int dbIndex);
+  void addCCSegCap(odb::dbRSeg* rseg1,
+                   odb::dbRSeg* rseg2,
+                   double cap,
+                   int dbIndex);
+
+  void setBandThreads(int threads) { _bandThreads = threads; }
 
   uint getExtBbox(int* x1, int* y1, int* x2, int* y2);
 
@@ -1465,7 +1586,9 @@ class extMain
                        bool mergeViaRes,
                        double ccThres,
                        int contextDepth,
-                       const char* extRules);
+                       const char* extRules,
+                       bool incremental = false);
+  void getIncrementalNets(std::vector<odb::dbNet*>& nets);
 
   uint getShortSrcJid(uint jid);
   void make1stRSeg(odb::dbNet* net,
@@ -1575,6 +1698,7 @@ class extMain
 
   double getTotalNetCap(uint netId, uint cornerNum);
   void initContextArray();
+  void removeContextArray();
   void initDgContextArray();
   void removeDgContextArray();
 
@@ -2214,6 +2338,15 @@ class extMain
   uint _debug_net_id = 0;
   float _previous_percent_extracted = 0;
 
+  // Threads for the tiled coupling flow, see couplingFlowTiles
+  int _bandThreads = 1;
+  // Set while extracting a tile; RC values are recorded here
+  extRCUpdates* _rcUpdates = nullptr;
+  // Nets changed since the last extraction of _block
+  extNetTracker* _netTracker = nullptr;
+  // Only the marked nets are re-extracted, the RC of the other nets is kept
+  bool _incrementalExt = false;
+
   double _minCapTable[64][64];
   double _maxCapTable[64][64];
   double _minResTable[64][64];
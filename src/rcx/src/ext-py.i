@@ -55,7 +55,9 @@ void extract(const char* ext_model_file,
              int context_depth,
              const char* debug_net_id,
              bool lef_res,
-             bool no_merge_via_res);
+             bool no_merge_via_res,
+             bool parallel,
+             bool incremental);
 
 void write_spef(const char* file, const char* nets, int net_id,
                 bool write_coordinates);
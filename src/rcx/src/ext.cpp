@@ -239,6 +239,7 @@ void Ext::extract(ExtractOptions options)
 
   _ext->set_debug_nets(options.debug_net);
   _ext->_lef_res = options.lef_res;
+  _ext->setBandThreads(options.threads);
 
   _ext->makeBlockRCsegs(options.net,
                         options.cc_up,
@@ -247,7 +248,8 @@ void Ext::extract(ExtractOptions options)
                         !options.no_merge_via_res,
                         options.coupling_threshold,
                         options.context_depth,
-                        options.ext_model_file);
+                        options.ext_model_file,
+                        options.incremental);
 }
 
 void Ext::adjust_rc(float res_factor, float cc_factor, float gndc_factor)
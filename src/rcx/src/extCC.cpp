@@ -41,7 +41,7 @@ CoupleOptions coupleOptionsNull{};
 
 namespace rcx {
 
-static uint ttttGetDgOverlap;
+static thread_local uint ttttGetDgOverlap;
 
 uint Ath__track::trackContextOn(int orig,
                                 int end,
@@ -694,9 +694,10 @@ void Ath__track::buildDgContext(Ath__array1D<SEQ*>* dgContext,
 
 void Ath__grid::buildDgContext(int gridn, int base)
 {
-  static Ath__wire** allCtxwire = nullptr;
-  static int awcnt;
-  static int awsize;
+  // per thread scratch as bands can be extracted concurrently
+  static thread_local Ath__wire** allCtxwire = nullptr;
+  static thread_local int awcnt;
+  static thread_local int awsize;
   if (allCtxwire == nullptr) {
     allCtxwire = (Ath__wire**) calloc(sizeof(Ath__wire*), 4096);
     awsize = 4096;
@@ -838,9 +839,10 @@ int Ath__grid::couplingCaps(int hiXY,
   limitArray[2] = _currentTrack;
   limitArray[3] = _base + _currentTrack * _pitch;
 
+  const int hiEnd = std::min(hiXY - (int) (ccThreshold + _pitch),
+                             _gridtable->extractLimit());
   for (uint ii = _currentTrack; ii <= _searchHiTrack; ii++) {
     int baseXY = _base + _pitch * ii;  // TO_VERIFY for continuation of track
-    int hiEnd = hiXY - (ccThreshold + _pitch);
     if (baseXY >= hiEnd) {
       _currentTrack = ii;
 
@@ -1084,7 +1086,13 @@ int Ath__grid::initCouplingCapLoops(uint couplingDist,
   if (startSearchTrack) {
     _currentTrack = _searchLowTrack;
   } else {
-    _currentTrack = (startXY - _base) / _pitch;
+    // first track at or above startXY, so that adjacent bands
+    // extract disjoint sets of tracks
+    _currentTrack = _searchLowTrack;
+    if (startXY > _base) {
+      _currentTrack = std::max(
+          _currentTrack, (uint) ((startXY - _base + _pitch - 1) / _pitch));
+    }
   }
   _lastFreeTrack = 0;
 
@@ -0,0 +1,273 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <algorithm>
+#include <set>
+#include <vector>
+
+#include "rcx/extRCap.h"
+#include "utl/Logger.h"
+
+namespace rcx {
+
+using odb::dbBlock;
+using odb::dbBTerm;
+using odb::dbCapNode;
+using odb::dbCCSeg;
+using odb::dbITerm;
+using odb::dbNet;
+using odb::dbShape;
+using odb::dbWire;
+using odb::dbWireShapeItr;
+using odb::Rect;
+using utl::RCX;
+
+void extNetTracker::track(dbBlock* block)
+{
+  if (!isTracking(block)) {
+    removeOwner();
+    addOwner(block);
+    _block = block;
+  }
+  _netIds.clear();
+  _removedShapes.clear();
+}
+
+void extNetTracker::addNet(dbNet* net)
+{
+  if (net == nullptr || net->getSigType().isSupply()) {
+    return;
+  }
+  _netIds.insert(net->getId());
+}
+
+void extNetTracker::inDbNetDestroy(dbNet* net)
+{
+  // The nets coupled to the destroyed net lose that coupling.  The net
+  // is still valid here, odb destroys it once the callbacks return.
+  for (dbCapNode* node : net->getCapNodes()) {
+    for (dbCCSeg* cc : node->getCCSegs()) {
+      dbCapNode* other = cc->getSourceCapNode() == node
+                             ? cc->getTargetCapNode()
+                             : cc->getSourceCapNode();
+      addNet(other->getNet());
+    }
+  }
+  net->destroyParasitics();
+  _netIds.erase(net->getId());
+}
+
+void extNetTracker::addRemovedWire(dbWire* wire)
+{
+  // The nets near the removed shapes with only grounded or lumped
+  // coupling to them have no CC seg to find them by.
+  dbWireShapeItr shapes;
+  dbShape s;
+  for (shapes.begin(wire); shapes.next(s);) {
+    if (!s.isVia()) {
+      _removedShapes.emplace_back(s.getBox(), s.getTechLayer()->getPitch());
+    }
+  }
+}
+
+void extNetTracker::inDbITermPostConnect(dbITerm* iterm)
+{
+  addNet(iterm->getNet());
+}
+
+void extNetTracker::inDbITermPreDisconnect(dbITerm* iterm)
+{
+  addNet(iterm->getNet());
+}
+
+void extNetTracker::inDbBTermPostConnect(dbBTerm* bterm)
+{
+  addNet(bterm->getNet());
+}
+
+void extNetTracker::inDbBTermPreDisconnect(dbBTerm* bterm)
+{
+  addNet(bterm->getNet());
+}
+
+void extNetTracker::inDbWireCreate(dbWire* wire)
+{
+  addNet(wire->getNet());
+}
+
+void extNetTracker::inDbWireDestroy(dbWire* wire)
+{
+  addNet(wire->getNet());
+  addRemovedWire(wire);
+}
+
+void extNetTracker::inDbWirePostModify(dbWire* wire)
+{
+  addNet(wire->getNet());
+}
+
+void extNetTracker::inDbWirePostAttach(dbWire* wire)
+{
+  addNet(wire->getNet());
+}
+
+void extNetTracker::inDbWirePreDetach(dbWire* wire)
+{
+  addNet(wire->getNet());
+  addRemovedWire(wire);
+}
+
+// Collects the nets to re-extract after a routing ECO: the nets changed
+// since the last extraction, the nets they were coupled to and the nets
+// with wires within coupling distance of their new or removed wires on
+// any layer.
+void extMain::getIncrementalNets(std::vector<dbNet*>& nets)
+{
+  std::set<uint> changedIds = _netTracker->getChangedNets();
+  // also take the nets of DEF ECOs
+  for (dbNet* net : _block->getNets()) {
+    if (net->isWireAltered() && !net->getSigType().isSupply()) {
+      changedIds.insert(net->getId());
+    }
+  }
+  const std::vector<std::pair<Rect, int>>& removedShapes
+      = _netTracker->getRemovedShapes();
+  if (changedIds.empty() && removedShapes.empty()) {
+    return;
+  }
+
+  std::vector<dbNet*> changed;
+  for (uint netId : changedIds) {
+    changed.push_back(dbNet::getNet(_block, netId));
+  }
+  std::vector<dbNet*> coupled;
+  _block->getCcHaloNets(changed, coupled);
+
+  nets = changed;
+  nets.insert(nets.end(), coupled.begin(), coupled.end());
+  for (dbNet* net : nets) {
+    net->setMark(true);
+  }
+
+  // Bin the new wires of the changed nets, bloated by the coupling
+  // distance of their layer
+  const Rect die = _block->getDieArea();
+  const int binSize = std::max(die.dx(), die.dy()) / 256 + 1;
+  const int xBins = die.dx() / binSize + 1;
+  const int yBins = die.dy() / binSize + 1;
+  auto binRange = [&](const Rect& r, int& x1, int& y1, int& x2, int& y2) {
+    x1 = std::clamp((r.xMin() - die.xMin()) / binSize, 0, xBins - 1);
+    y1 = std::clamp((r.yMin() - die.yMin()) / binSize, 0, yBins - 1);
+    x2 = std::clamp((r.xMax() - die.xMin()) / binSize, 0, xBins - 1);
+    y2 = std::clamp((r.yMax() - die.yMin()) / binSize, 0, yBins - 1);
+  };
+
+  std::vector<Rect> regions;
+  std::vector<std::vector<int>> bins(xBins * yBins);
+  auto addRegion = [&](const Rect& box, int pitch) {
+    Rect region;
+    box.bloat(_couplingFlag * pitch, region);
+    int x1, y1, x2, y2;
+    binRange(region, x1, y1, x2, y2);
+    for (int x = x1; x <= x2; x++) {
+      for (int y = y1; y <= y2; y++) {
+        bins[x * yBins + y].push_back(regions.size());
+      }
+    }
+    regions.push_back(region);
+  };
+  for (dbNet* net : changed) {
+    dbWire* wire = net->getWire();
+    if (wire == nullptr) {
+      continue;
+    }
+    dbWireShapeItr shapes;
+    dbShape s;
+    for (shapes.begin(wire); shapes.next(s);) {
+      if (!s.isVia()) {
+        addRegion(s.getBox(), s.getTechLayer()->getPitch());
+      }
+    }
+  }
+  for (const auto& [box, pitch] : removedShapes) {
+    addRegion(box, pitch);
+  }
+
+  uint nearCnt = 0;
+  for (dbNet* net : _block->getNets()) {
+    if (net->isMarked() || net->getSigType().isSupply()) {
+      continue;
+    }
+    dbWire* wire = net->getWire();
+    if (wire == nullptr) {
+      continue;
+    }
+    bool near = false;
+    dbWireShapeItr shapes;
+    dbShape s;
+    for (shapes.begin(wire); !near && shapes.next(s);) {
+      if (s.isVia()) {
+        continue;
+      }
+      const Rect r = s.getBox();
+      int x1, y1, x2, y2;
+      binRange(r, x1, y1, x2, y2);
+      for (int x = x1; !near && x <= x2; x++) {
+        for (int y = y1; !near && y <= y2; y++) {
+          for (int ii : bins[x * yBins + y]) {
+            if (regions[ii].intersects(r)) {
+              near = true;
+              break;
+            }
+          }
+        }
+      }
+    }
+    if (near) {
+      net->setMark(true);
+      nets.push_back(net);
+      nearCnt++;
+    }
+  }
+
+  for (dbNet* net : nets) {
+    net->setMark(false);
+  }
+
+  logger_->info(RCX,
+                500,
+                "Re-extracting {} changed nets and {} nets coupled to them.",
+                changed.size(),
+                coupled.size() + nearCnt);
+}
+
+}  // namespace rcx
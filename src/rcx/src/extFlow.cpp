@@ -30,16 +30,24 @@
 // ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
 // POSSIBILITY OF SUCH DAMAGE.
 
+#include <algorithm>
+#include <cstring>
+#include <exception>
 #include <map>
+#include <mutex>
 #include <vector>
 
 #include "rcx/dbUtil.h"
 #include "rcx/extRCap.h"
 #include "utl/Logger.h"
+#include "utl/timer.h"
 #include "wire.h"
 
 namespace rcx {
 
+using odb::dbBlock;
+using odb::dbCapNode;
+using odb::dbCCSeg;
 using odb::dbInst;
 using odb::dbNet;
 using odb::dbRSeg;
@@ -1241,6 +1249,17 @@ uint extMain::couplingFlow(Rect& extRect,
     step_nm[1] = ur[1] - ll[1];
     step_nm[0] = ur[0] - ll[0];
   }
+  if ((_incrementalExt || (_bandThreads > 1 && _allNet)) && !_getBandWire
+      && maxWidth <= ccDist * maxPitch) {
+    std::vector<extTile> tiles;
+    if (_incrementalExt) {
+      getIncrementalTiles(extRect, ccFlag, maxPitch, tiles);
+    } else {
+      getBandTiles(extRect, ccFlag, maxPitch, tiles);
+    }
+    couplingFlowTiles(extRect, ccFlag, tiles, coupleAndCompute);
+    return 0;
+  }
   // _use_signal_tables
   Ath__array1D<uint> sdbPowerTable;
   Ath__array1D<uint> tmpNetIdTable(64000);
@@ -1374,6 +1393,433 @@ uint extMain::couplingFlow(Rect& extRect,
   return 0;
 }
 
+void extRCUpdates::addCap(uint rsegId, int dbIndex, double cap)
+{
+  _updates.push_back({CAP, dbIndex, rsegId, 0, cap});
+}
+
+void extRCUpdates::addRes(uint rsegId, int dbIndex, double res)
+{
+  _updates.push_back({RES, dbIndex, rsegId, 0, res});
+}
+
+void extRCUpdates::addCoupling(uint capNodeId1,
+                               uint capNodeId2,
+                               int dbIndex,
+                               double cap)
+{
+  _updates.push_back({COUPLING, dbIndex, capNodeId1, capNodeId2, cap});
+}
+
+void extRCUpdates::apply(dbBlock* block) const
+{
+  for (const Update& update : _updates) {
+    switch (update.kind) {
+      case CAP: {
+        dbRSeg* rseg = dbRSeg::getRSeg(block, update.id1);
+        const double cap = rseg->getCapacitance(update.dbIndex);
+        rseg->setCapacitance(cap + update.value, update.dbIndex);
+        break;
+      }
+      case RES: {
+        dbRSeg* rseg = dbRSeg::getRSeg(block, update.id1);
+        const double res = rseg->getResistance(update.dbIndex);
+        rseg->setResistance(res + update.value, update.dbIndex);
+        break;
+      }
+      case COUPLING: {
+        dbCCSeg* ccap
+            = dbCCSeg::create(dbCapNode::getCapNode(block, update.id1),
+                              dbCapNode::getCapNode(block, update.id2),
+                              true);
+        ccap->addCapacitance(update.value, update.dbIndex);
+        break;
+      }
+    }
+  }
+}
+
+void extMain::initTileWorker(extMain* parent)
+{
+  logger_ = parent->logger_;
+  _db = parent->_db;
+  _tech = parent->_tech;
+  _block = parent->_block;
+  _blockId = parent->_blockId;
+
+  _batchScaleExt = parent->_batchScaleExt;
+  _processCornerTable = parent->_processCornerTable;
+  _scaledCornerTable = parent->_scaledCornerTable;
+  _cornerCnt = parent->_cornerCnt;
+  _extDbCnt = parent->_extDbCnt;
+
+  for (int ii = 0; ii < parent->_modelMap.getCnt(); ii++) {
+    _modelMap.add(parent->_modelMap.get(ii));
+  }
+  _minModelIndex = parent->_minModelIndex;
+  _typModelIndex = parent->_typModelIndex;
+  _maxModelIndex = parent->_maxModelIndex;
+  memcpy(_resistanceTable,
+         parent->_resistanceTable,
+         sizeof(_resistanceTable));
+  memcpy(_capacitanceTable,
+         parent->_capacitanceTable,
+         sizeof(_capacitanceTable));
+  memcpy(_minWidthTable, parent->_minWidthTable, sizeof(_minWidthTable));
+  memcpy(_minDistTable, parent->_minDistTable, sizeof(_minDistTable));
+
+  _currentModel = parent->_currentModel;
+  _lef_res = parent->_lef_res;
+  _diagFlow = parent->_diagFlow;
+  _usingMetalPlanes = parent->_usingMetalPlanes;
+  _couplingFlag = parent->_couplingFlag;
+  _ccUp = parent->_ccUp;
+  _ccContextDepth = parent->_ccContextDepth;
+  _coupleThreshold = parent->_coupleThreshold;
+  _allNet = parent->_allNet;
+  _useDbSdb = parent->_useDbSdb;
+  _CCnoPowerSource = parent->_CCnoPowerSource;
+  _CCnoPowerTarget = parent->_CCnoPowerTarget;
+
+  _resFactor = parent->_resFactor;
+  _resModify = parent->_resModify;
+  _ccFactor = parent->_ccFactor;
+  _ccModify = parent->_ccModify;
+  _gndcFactor = parent->_gndcFactor;
+  _gndcModify = parent->_gndcModify;
+
+  _debug_net_id = parent->_debug_net_id;
+  _incrementalExt = parent->_incrementalExt;
+}
+
+// Extracts the tracks of one direction with base coordinate in [lo, hi),
+// or from lo to the end of the block for the last tile. Wires within the
+// coupling distance on either side are loaded as context only.
+uint extMain::couplingTile(Rect& extRect,
+                           uint ccFlag,
+                           uint dir,
+                           int lo,
+                           int hi,
+                           bool lastTile,
+                           CoupleAndCompute coupleAndCompute)
+{
+  uint ccDist = ccFlag;
+
+  uint sigtype = 9;
+  uint pwrtype = 11;
+
+  extMeasure m(logger_);
+  if (_ccContextDepth) {
+    initContextArray();
+  }
+  initDgContextArray();
+  initCouplingMeasure(&m);
+  m._debugFP = nullptr;
+  m._netId = 0;
+
+  uint pitchTable[32];
+  uint widthTable[32];
+  for (uint ii = 0; ii < 32; ii++) {
+    pitchTable[ii] = 0;
+    widthTable[ii] = 0;
+  }
+  uint dirTable[16];
+  int baseX[32];
+  int baseY[32];
+  uint layerCnt = initSearchForNets(
+      baseX, baseY, pitchTable, widthTable, dirTable, extRect, false);
+
+  uint maxPitch = pitchTable[layerCnt - 1];
+
+  layerCnt = (int) layerCnt > _currentModel->getLayerCnt()
+                 ? layerCnt
+                 : _currentModel->getLayerCnt();
+  int ll[2];
+  int ur[2];
+  ll[0] = extRect.xMin();
+  ll[1] = extRect.yMin();
+  ur[0] = extRect.xMax();
+  ur[1] = extRect.yMax();
+
+  int lo_gs[2];
+  int hi_gs[2];
+  int lo_sdb[2];
+  int hi_sdb[2];
+
+  Ath__overlapAdjust overlapAdj = Z_noAdjust;
+  _search->setExtControl(_block,
+                         _useDbSdb,
+                         (uint) overlapAdj,
+                         _CCnoPowerSource,
+                         _CCnoPowerTarget,
+                         _ccUp,
+                         _allNet,
+                         _ccContextDepth,
+                         _ccContextArray,
+                         _dgContextArray,
+                         &_dgContextDepth,
+                         &_dgContextPlanes,
+                         &_dgContextTracks,
+                         &_dgContextBaseLvl,
+                         &_dgContextLowLvl,
+                         &_dgContextHiLvl,
+                         _dgContextBaseTrack,
+                         _dgContextLowTrack,
+                         _dgContextHiTrack,
+                         _dgContextTrackBase,
+                         m._seqPool);
+
+  _seqPool = m._seqPool;
+  _search->setExtractLimit(lastTile ? MAX_INT : hi);
+
+  const int step = 1000 * pitchTable[1];
+  const int halo = (ccDist + 2) * maxPitch;
+  const bool firstTile = lo <= ll[dir];
+  const int end = lastTile ? ur[dir] + 5 * ccDist * maxPitch
+                           : hi + (2 * ccDist + 2) * maxPitch;
+
+  int** limitArray;
+  limitArray = new int*[layerCnt];
+  for (uint jj = 0; jj < layerCnt; jj++) {
+    limitArray[jj] = new int[10];
+  }
+
+  if (dir == 0) {
+    enableRotatedFlag();
+  }
+
+  lo_gs[!dir] = ll[!dir];
+  hi_gs[!dir] = ur[!dir];
+  lo_sdb[!dir] = ll[!dir];
+  hi_sdb[!dir] = ur[!dir];
+
+  int gs_limit = std::max(ll[dir], lo - halo);
+
+  if (firstTile) {
+    _search->initCouplingCapLoops(dir, ccFlag, coupleAndCompute, &m);
+    lo_sdb[dir] = ll[dir] - step;
+  } else {
+    // wires starting up to the max coupled width below lo are context
+    std::vector<int> startXY(layerCnt, lo);
+    _search->initCouplingCapLoops(
+        dir, ccFlag, coupleAndCompute, &m, startXY.data());
+    lo_sdb[dir] = lo - halo - ccDist * maxPitch;
+  }
+
+  int hiXY = lo + step;
+  for (;; hiXY += step) {
+    if (end - hiXY <= step) {
+      hiXY = end;
+    }
+
+    lo_gs[dir] = gs_limit;
+    hi_gs[dir] = hiXY;
+
+    fill_gs4(
+        dir, ll, ur, lo_gs, hi_gs, layerCnt, dirTable, pitchTable, widthTable);
+
+    m._rotatedGs = getRotatedFlag();
+    m._pixelTable = _geomSeq;
+
+    hi_sdb[dir] = hiXY;
+
+    addPowerNets(dir, lo_sdb, hi_sdb, pwrtype);
+    addSignalNets(dir, lo_sdb, hi_sdb, sigtype);
+
+    uint extractedWireCnt = 0;
+    int extractLimit = hiXY - ccDist * maxPitch;
+    const int minExtracted = _search->couplingCaps(extractLimit,
+                                                   ccFlag,
+                                                   dir,
+                                                   extractedWireCnt,
+                                                   coupleAndCompute,
+                                                   &m,
+                                                   false,
+                                                   limitArray);
+
+    _search->dealloc(dir, minExtracted - (ccDist + 1) * maxPitch);
+
+    lo_sdb[dir] = hiXY;
+    gs_limit = minExtracted - (ccDist + 2) * maxPitch;
+
+    if (hiXY >= end) {
+      break;
+    }
+  }
+
+  for (uint jj = 0; jj < layerCnt; jj++) {
+    delete[] limitArray[jj];
+  }
+  delete[] limitArray;
+
+  delete _geomSeq;
+  _geomSeq = nullptr;
+  delete _search;
+  _search = nullptr;
+  removeDgContextArray();
+  removeContextArray();
+
+  return 0;
+}
+
+// Splits the tracks of each direction into tiles that depend only on the
+// size of the block.
+void extMain::getBandTiles(Rect& extRect,
+                           uint ccFlag,
+                           uint maxPitch,
+                           std::vector<extTile>& tiles)
+{
+  const int ll[2] = {extRect.xMin(), extRect.yMin()};
+  const int ur[2] = {extRect.xMax(), extRect.yMax()};
+  const int64_t minTileSpan = 16 * (int64_t) (ccFlag + 2) * maxPitch;
+
+  for (int dir = 1; dir >= 0; dir--) {
+    const int64_t span = (int64_t) ur[dir] - ll[dir];
+    const int tileCnt = std::clamp<int64_t>(span / minTileSpan, 1, 64);
+    for (int ii = 0; ii < tileCnt; ii++) {
+      const int lo = ll[dir] + span * ii / tileCnt;
+      const int hi = ll[dir] + span * (ii + 1) / tileCnt;
+      tiles.push_back({(uint) dir, lo, hi, ii == tileCnt - 1});
+    }
+  }
+}
+
+// Covers the tracks of the marked nets' wires and of the wires within
+// coupling distance of them, merging tiles that are close together.
+void extMain::getIncrementalTiles(Rect& extRect,
+                                  uint ccFlag,
+                                  uint maxPitch,
+                                  std::vector<extTile>& tiles)
+{
+  const int ll[2] = {extRect.xMin(), extRect.yMin()};
+  const int ur[2] = {extRect.xMax(), extRect.yMax()};
+  const int halo = (ccFlag + 2) * maxPitch;
+  const int minTileSpan = 16 * halo;
+
+  std::vector<std::pair<int, int>> ranges[2];
+  for (dbNet* net : _block->getNets()) {
+    if (!net->isMarked() || net->getSigType().isSupply()) {
+      continue;
+    }
+    dbWire* wire = net->getWire();
+    if (wire == nullptr) {
+      continue;
+    }
+    dbWireShapeItr shapes;
+    dbShape s;
+    for (shapes.begin(wire); shapes.next(s);) {
+      if (s.isVia()) {
+        continue;
+      }
+      Rect r = s.getBox();
+      const uint dir = matchDir(1, r) ? 1 : 0;
+      const int lo[2] = {r.xMin(), r.yMin()};
+      const int hi[2] = {r.xMax(), r.yMax()};
+      ranges[dir].emplace_back(lo[dir] - halo, hi[dir] + halo);
+    }
+  }
+
+  for (int dir = 1; dir >= 0; dir--) {
+    std::sort(ranges[dir].begin(), ranges[dir].end());
+    std::vector<extTile> dirTiles;
+    for (auto [lo, hi] : ranges[dir]) {
+      lo = std::max(lo, ll[dir]);
+      hi = std::min(hi, ur[dir]);
+      if (!dirTiles.empty() && lo <= dirTiles.back().hi + minTileSpan) {
+        dirTiles.back().hi = std::max(dirTiles.back().hi, hi);
+      } else {
+        dirTiles.push_back({(uint) dir, lo, hi, false});
+      }
+    }
+    if (!dirTiles.empty() && dirTiles.back().hi >= ur[dir]) {
+      dirTiles.back().last = true;
+    }
+    tiles.insert(tiles.end(), dirTiles.begin(), dirTiles.end());
+  }
+}
+
+// Extracts coupling capacitance of the tiles on _bandThreads threads, a
+// batch of kTileBatchSize tiles at a time. The tiles of a batch only read
+// the block; their RC updates are applied in tile order once the batch is
+// extracted, which bounds the memory they take and keeps the result
+// independent of the thread count.
+void extMain::couplingFlowTiles(Rect& extRect,
+                                uint ccFlag,
+                                const std::vector<extTile>& tiles,
+                                CoupleAndCompute coupleAndCompute)
+{
+  constexpr int kTileBatchSize = 64;
+
+  utl::Timer timer;
+  const int tileCnt = tiles.size();
+  std::vector<extRCUpdates> updates(std::min(tileCnt, kTileBatchSize));
+  int doneCnt = 0;
+  uint mergedCnt = 0;
+  std::mutex progressMutex;
+  std::exception_ptr exception;
+
+  for (int batchStart = 0; batchStart < tileCnt;
+       batchStart += kTileBatchSize) {
+    const int batchEnd = std::min(tileCnt, batchStart + kTileBatchSize);
+
+#pragma omp parallel for schedule(dynamic, 1) num_threads(_bandThreads)
+    for (int ii = batchStart; ii < batchEnd; ii++) {
+      try {
+        const extTile& tile = tiles[ii];
+        extMain worker;
+        worker.initTileWorker(this);
+        worker._rcUpdates = &updates[ii - batchStart];
+        worker.couplingTile(extRect,
+                            ccFlag,
+                            tile.dir,
+                            tile.lo,
+                            tile.hi,
+                            tile.last,
+                            coupleAndCompute);
+
+        std::lock_guard<std::mutex> lock(progressMutex);
+        doneCnt++;
+        const float percent_extracted = lround(100.0 * doneCnt / tileCnt);
+        if (percent_extracted - _previous_percent_extracted >= 5.0
+            || (doneCnt == tileCnt
+                && percent_extracted > _previous_percent_extracted)) {
+          logger_->info(RCX,
+                        499,
+                        "{:d}% of {:d} tiles extracted",
+                        (int) percent_extracted,
+                        tileCnt);
+          _previous_percent_extracted = percent_extracted;
+        }
+      } catch (...) {
+#pragma omp critical
+        if (!exception) {
+          exception = std::current_exception();
+        }
+      }
+    }
+
+    if (exception) {
+      std::rethrow_exception(exception);
+    }
+
+    for (int ii = batchStart; ii < batchEnd; ii++) {
+      extRCUpdates& tileUpdates = updates[ii - batchStart];
+      tileUpdates.apply(_block);
+      mergedCnt += tileUpdates.getCnt();
+      tileUpdates = extRCUpdates();
+    }
+  }
+
+  logger_->info(RCX,
+                498,
+                "Extracted {} tiles on {} threads in {:.2f} seconds, {} RC "
+                "updates merged.",
+                tileCnt,
+                _bandThreads,
+                timer.elapsed(),
+                mergedCnt);
+}
+
 dbRSeg* extMain::getRseg(dbNet* net, uint shapeId, Logger* logger)
 {
   int rsegId2 = 0;
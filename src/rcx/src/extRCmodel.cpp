@@ -663,17 +663,20 @@ extDistRC* extDistRCTable::getComputeRC(uint dist)
       if (dist <= 2 * lastDist) {  // send Inf dist
 
         uint cnt = _measureTable->getCnt();
-        extDistRC* rc31 = _measureTable->geti(31);
         extDistRC* rc2 = _measureTable->get(cnt - 2);
         extDistRC* rc3 = _measureTable->get(cnt - 3);
 
-        rc31->_sep = dist;
-        rc31->interpolate(dist, rc3, rc2);
+        // interpolate into a per thread copy of the spare entry; the
+        // tables are shared by concurrent band extraction
+        static thread_local extDistRC rc31;
+        rc31 = *_measureTable->geti(31);
+        rc31._sep = dist;
+        rc31.interpolate(dist, rc3, rc2);
 
-        rc31->_coupling
+        rc31._coupling
             = (before_lastRC->_coupling / dist) * before_lastRC->_sep;
-        rc31->_fringe = before_lastRC->_fringe;
-        return rc31;
+        rc31._fringe = before_lastRC->_fringe;
+        return &rc31;
       }
       if (dist > lastDist) {  // send Inf dist
         return _measureTable->getLast();
@@ -1814,13 +1817,15 @@ extDistRC* extDistWidthRCTable::getRC_99(uint mou, uint w, uint dw, uint ds)
     return rc2;
   }
 
-  _rc31->_sep = ds;
+  static thread_local extDistRC rc31;
+  rc31 = *_rc31;
+  rc31._sep = ds;
 
   uint lastDist = _lastDiagDist->geti(mou);
   if (ds > lastDist) {  // extrapolate
-    _rc31->_fringe = (rc2->_fringe / ds) * lastDist;
+    rc31._fringe = (rc2->_fringe / ds) * lastDist;
 
-    return _rc31;
+    return &rc31;
   }
   // interpolate;
   uint s1 = _diagDistTable[mou]->get(dsIndex - 1);
@@ -1832,9 +1837,9 @@ extDistRC* extDistWidthRCTable::getRC_99(uint mou, uint w, uint dw, uint ds)
   extDistRC* rc1
       = _rcDiagDistTable[mou][wIndex][dwIndex][dsIndex - 1]->getRC_99();
 
-  _rc31->_fringe = lineSegment(ds, s1, s2, rc1->_fringe, rc2->_fringe);
+  rc31._fringe = lineSegment(ds, s1, s2, rc1->_fringe, rc2->_fringe);
 
-  return _rc31;
+  return &rc31;
 }
 
 double extRCModel::getFringeOver(uint met, uint mUnder, uint w, uint s)
@@ -138,6 +138,7 @@ extMain::extMain()
 extMain::~extMain()
 {
   delete _modelTable;
+  delete _netTracker;
 }
 
 void extMain::initDgContextArray()
@@ -202,6 +203,22 @@ void extMain::initContextArray()
   }
 }
 
+void extMain::removeContextArray()
+{
+  if (!_ccContextArray) {
+    return;
+  }
+  uint layerCnt = getExtLayerCnt(_tech);
+  for (uint ii = 1; ii <= layerCnt; ii++) {
+    delete _ccContextArray[ii];
+    delete _ccMergedContextArray[ii];
+  }
+  delete[] _ccContextArray;
+  delete[] _ccMergedContextArray;
+  _ccContextArray = nullptr;
+  _ccMergedContextArray = nullptr;
+}
+
 uint extMain::getExtLayerCnt(dbTech* tech)
 {
   dbSet<dbTechLayer> layers = tech->getLayers();
@@ -449,10 +466,7 @@ void extMain::updateTotalCap(dbRSeg* rseg,
 {
   double cap = frCap + ccCap - deltaFr;
 
-  double tot = rseg->getCapacitance(modelIndex);
-  tot += cap;
-
-  rseg->setCapacitance(tot, modelIndex);
+  addRsegCap(rseg, cap, modelIndex);
 }
 
 void extMain::updateTotalRes(dbRSeg* rseg1,
@@ -470,16 +484,10 @@ void extMain::updateTotalRes(dbRSeg* rseg1,
     }
 
     if (rseg1 != nullptr) {
-      double tot = rseg1->getResistance(modelIndex);
-      tot += res;
-
-      rseg1->setResistance(tot, modelIndex);
+      addRsegRes(rseg1, res, modelIndex);
     }
     if (rseg2 != nullptr) {
-      double tot = rseg2->getResistance(modelIndex);
-      tot += res;
-
-      rseg2->setResistance(tot, modelIndex);
+      addRsegRes(rseg2, res, modelIndex);
     }
   }
 }
@@ -491,7 +499,7 @@ void extMain::updateTotalCap(dbRSeg* rseg,
                              bool includeCoupling,
                              bool includeDiag)
 {
-  double tot, cap;
+  double cap;
   int extDbIndex, sci, scDbIdx;
   for (uint modelIndex = 0; modelIndex < modelCnt; modelIndex++) {
     extDistRC* rc = m->_rc[modelIndex];
@@ -514,18 +522,13 @@ void extMain::updateTotalCap(dbRSeg* rseg,
     }
 
     extDbIndex = getProcessCornerDbIndex(modelIndex);
-    tot = rseg->getCapacitance(extDbIndex);
-    tot += cap;
-
-    rseg->setCapacitance(tot, extDbIndex);
+    addRsegCap(rseg, cap, extDbIndex);
     getScaledCornerDbIndex(modelIndex, sci, scDbIdx);
     if (sci == -1) {
       continue;
     }
     getScaledGndC(sci, cap);
-    tot = rseg->getCapacitance(scDbIdx);
-    tot += cap;
-    rseg->setCapacitance(tot, scDbIdx);
+    addRsegCap(rseg, cap, scDbIdx);
   }
 }
 
@@ -703,20 +706,15 @@ void extMain::measureRC(CoupleOptions& options)
       }
       _totBigCCcnt++;
 
-      dbCCSeg* ccap = dbCCSeg::create(
-          dbCapNode::getCapNode(_block, rseg1->getTargetNode()),
-          dbCapNode::getCapNode(_block, rseg2->getTargetNode()),
-          true);
-
       int extDbIndex, sci, scDbIdx;
       for (uint jj = 0; jj < m._metRCTable.getCnt(); jj++) {
         extDbIndex = getProcessCornerDbIndex(jj);
-        ccap->addCapacitance(m._rc[jj]->_coupling, extDbIndex);
+        addCCSegCap(rseg1, rseg2, m._rc[jj]->_coupling, extDbIndex);
         getScaledCornerDbIndex(jj, sci, scDbIdx);
         if (sci != -1) {
           double cap = m._rc[jj]->_coupling;
           getScaledGndC(sci, cap);
-          ccap->addCapacitance(cap, scDbIdx);
+          addCCSegCap(rseg1, rseg2, cap, scDbIdx);
         }
       }
       updateTotalCap(rseg1, &m, deltaFr, m._metRCTable.getCnt(), false);
@@ -261,14 +261,20 @@ extDistRC* extDistRCTable::getComputeRC_res(uint dist1, uint dist2)
     return nullptr;
   }
 
+  // The result is returned in a per thread copy, with _diag holding the
+  // interpolated resistance, as the tables are shared by concurrent band
+  // extraction
+  static thread_local extDistRC result;
+
   extDistRC* rc1 = _measureTableR[0]->geti(0);
-  rc1->_diag = 0.0;
   if (rc1 == nullptr) {
     return nullptr;
   }
 
   if (dist1 + dist2 == 0) {  // ASSUMPTION: 0 dist exists as first
-    return rc1;
+    result = *rc1;
+    result._diag = 0.0;
+    return &result;
   }
   if (dist1 >= _maxDist && dist2 >= _maxDist) {
     return nullptr;
@@ -321,40 +327,41 @@ extDistRC* extDistRCTable::getComputeRC_res(uint dist1, uint dist2)
     }
   }
   if (found) {
-    _measureTable = _measureTableR[index_dist];
-    _computeTable = _computeTableR[index_dist];
-    extDistRC* res = findIndexed_res(dist1, dist2);
-    res->_diag = 0;
+    extDistRC* res = findIndexed_res(index_dist, dist1, dist2);
     if (rc != nullptr && dist1 < rc->_sep) {
-      _measureTable = _measureTableR[index_dist - 1];
-      _computeTable = _computeTableR[index_dist - 1];
-      extDistRC* res1 = findIndexed_res(dist1, dist2);
+      extDistRC* res1 = findIndexed_res(index_dist - 1, dist1, dist2);
       double R1 = res->interpolate_res(dist1, res1);
-      res1->_diag = R1;
-      return res1;
+      result = *res1;
+      result._diag = R1;
+      return &result;
     }
-    return res;
+    result = *res;
+    result._diag = 0.0;
+    return &result;
   }
   return nullptr;
 }
 
-extDistRC* extDistRCTable::findIndexed_res(uint dist1, uint dist2)
+extDistRC* extDistRCTable::findIndexed_res(uint index_dist,
+                                           uint dist1,
+                                           uint dist2)
 {
-  extDistRC* firstRC = _measureTable->get(0);
+  Ath__array1D<extDistRC*>* measureTable = _measureTableR[index_dist];
+  extDistRC* firstRC = measureTable->get(0);
   uint firstDist = firstRC->_sep;
   if (dist2 <= firstDist) {
     return firstRC;
   }
-  if (_measureTable->getCnt() == 1) {
+  if (measureTable->getCnt() == 1) {
     return firstRC;
   }
-  extDistRC* resLast = _measureTable->getLast();
+  extDistRC* resLast = measureTable->getLast();
   if (dist2 >= resLast->_sep) {
     return resLast;
   }
 
   uint n = dist2 / _unit;
-  extDistRC* res = _computeTable->geti(n);
+  extDistRC* res = _computeTableR[index_dist]->geti(n);
   return res;
 }
 
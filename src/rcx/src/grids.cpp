@@ -2467,6 +2467,7 @@ Ath__gridTable::Ath__gridTable(Ath__box* bb,
   _powerMultiTrackWire = 0;
   _signalMultiTrackWire = 0;
   _bandWire = nullptr;
+  _extractLimit = odb::MAX_INT;
 
   _gridTable = new Ath__grid**[_rowCnt];
   int y1 = bb->_ylo;
@@ -2515,6 +2516,7 @@ Ath__gridTable::Ath__gridTable(dbBox* bb,
   _powerMultiTrackWire = 0;
   _signalMultiTrackWire = 0;
   _bandWire = nullptr;
+  _extractLimit = odb::MAX_INT;
 
   uint maxCellNumPerMarker = 16;
   uint markerCnt = (bb->getDX() / minWidth) / maxCellNumPerMarker;
@@ -2661,6 +2663,7 @@ Ath__gridTable::Ath__gridTable(Rect* bb,
   _powerMultiTrackWire = 0;
   _signalMultiTrackWire = 0;
   _bandWire = nullptr;
+  _extractLimit = odb::MAX_INT;
 
   uint markerLen = 500000;  // EXT-DEFAULT
 
@@ -2715,6 +2718,7 @@ Ath__gridTable::Ath__gridTable(Rect* bb,
   _powerMultiTrackWire = 0;
   _signalMultiTrackWire = 0;
   _bandWire = nullptr;
+  _extractLimit = odb::MAX_INT;
 
   uint maxCellNumPerMarker = 16;
   uint markerCnt = (bb->dx() / minWidth) / maxCellNumPerMarker;
@@ -2740,7 +2744,7 @@ Ath__gridTable::~Ath__gridTable()
   delete _wirePool;
 
   for (uint ii = 0; ii < _rowCnt; ii++) {
-    for (uint jj = 0; jj < _rowCnt; jj++) {
+    for (uint jj = 0; jj < _colCnt; jj++) {
       delete _gridTable[ii][jj];
     }
     delete[] _gridTable[ii];
@@ -1708,6 +1708,53 @@ void extMain::getPrevControl()
   _usingMetalPlanes = _prevControl->_usingMetalPlanes;
 }
 
+void extMain::initCouplingMeasure(extMeasure* m)
+{
+  m->_extMain = this;
+  m->_block = _block;
+  m->_diagFlow = _diagFlow;
+
+  m->_resFactor = _resFactor;
+  m->_resModify = _resModify;
+  m->_ccFactor = _ccFactor;
+  m->_ccModify = _ccModify;
+  m->_gndcFactor = _gndcFactor;
+  m->_gndcModify = _gndcModify;
+
+  m->_dgContextArray = _dgContextArray;
+  m->_dgContextDepth = &_dgContextDepth;
+  m->_dgContextPlanes = &_dgContextPlanes;
+  m->_dgContextTracks = &_dgContextTracks;
+  m->_dgContextBaseLvl = &_dgContextBaseLvl;
+  m->_dgContextLowLvl = &_dgContextLowLvl;
+  m->_dgContextHiLvl = &_dgContextHiLvl;
+  m->_dgContextBaseTrack = _dgContextBaseTrack;
+  m->_dgContextLowTrack = _dgContextLowTrack;
+  m->_dgContextHiTrack = _dgContextHiTrack;
+  m->_dgContextTrackBase = _dgContextTrackBase;
+  m->_dgContextCnt = 0;
+
+  m->_ccContextArray = _ccContextArray;
+
+  m->_pixelTable = _geomSeq;
+  m->_minModelIndex = 0;  // couplimg threshold will be appled to this cap
+  m->_maxModelIndex = 0;
+  m->_currentModel = _currentModel;
+  m->_diagModel = _currentModel[0].getDiagModel();
+  for (uint ii = 0; ii < _modelMap.getCnt(); ii++) {
+    uint jj = _modelMap.get(ii);
+    m->_metRCTable.add(_currentModel->getMetRCTable(jj));
+  }
+  const uint techLayerCnt = getExtLayerCnt(_tech) + 1;
+  const uint modelLayerCnt = _currentModel->getLayerCnt();
+  m->_layerCnt = techLayerCnt < modelLayerCnt ? techLayerCnt : modelLayerCnt;
+  if (techLayerCnt == 5 && modelLayerCnt == 8) {
+    m->_layerCnt = modelLayerCnt;
+  }
+  m->getMinWidth(_tech);
+  m->allocOUpool();
+}
+
 void extMain::makeBlockRCsegs(const char* netNames,
                               uint cc_up,
                               uint ccFlag,
@@ -1715,7 +1762,8 @@ void extMain::makeBlockRCsegs(const char* netNames,
                               bool mergeViaRes,
                               double ccThres,
                               int contextDepth,
-                              const char* extRules)
+                              const char* extRules,
+                              bool incremental)
 {
   uint debugNetId = 0;
 
@@ -1757,6 +1805,26 @@ void extMain::makeBlockRCsegs(const char* netNames,
 
   _allNet = !((dbBlock*) _block)->findSomeNet(netNames, inets);
 
+  _incrementalExt = false;
+  if (incremental && _allNet) {
+    if (_netTracker == nullptr || !_netTracker->isTracking(_block)) {
+      logger_->warn(RCX,
+                    501,
+                    "Block {} was not extracted before, extracting all nets.",
+                    _block->getName());
+    } else {
+      getIncrementalNets(inets);
+      if (inets.empty()) {
+        logger_->info(
+            RCX, 502, "No nets changed since the last extraction.");
+        return;
+      }
+      removeExt(inets);
+      _allNet = false;
+      _incrementalExt = true;
+    }
+  }
+
   if (_ccContextDepth) {
     initContextArray();
   }
@@ -1834,52 +1902,10 @@ void extMain::makeBlockRCsegs(const char* netNames,
                   _coupleThreshold,
                   _coupleThreshold);
 
-    m._extMain = this;
-    m._block = _block;
-    m._diagFlow = _diagFlow;
-
-    m._resFactor = _resFactor;
-    m._resModify = _resModify;
-    m._ccFactor = _ccFactor;
-    m._ccModify = _ccModify;
-    m._gndcFactor = _gndcFactor;
-    m._gndcModify = _gndcModify;
-
-    m._dgContextArray = _dgContextArray;
-    m._dgContextDepth = &_dgContextDepth;
-    m._dgContextPlanes = &_dgContextPlanes;
-    m._dgContextTracks = &_dgContextTracks;
-    m._dgContextBaseLvl = &_dgContextBaseLvl;
-    m._dgContextLowLvl = &_dgContextLowLvl;
-    m._dgContextHiLvl = &_dgContextHiLvl;
-    m._dgContextBaseTrack = _dgContextBaseTrack;
-    m._dgContextLowTrack = _dgContextLowTrack;
-    m._dgContextHiTrack = _dgContextHiTrack;
-    m._dgContextTrackBase = _dgContextTrackBase;
+    initCouplingMeasure(&m);
     if (ttttPrintDgContext) {
       m._dgContextFile = fopen("dgCtxtFile", "w");
     }
-    m._dgContextCnt = 0;
-
-    m._ccContextArray = _ccContextArray;
-
-    m._pixelTable = _geomSeq;
-    m._minModelIndex = 0;  // couplimg threshold will be appled to this cap
-    m._maxModelIndex = 0;
-    m._currentModel = _currentModel;
-    m._diagModel = _currentModel[0].getDiagModel();
-    for (uint ii = 0; ii < _modelMap.getCnt(); ii++) {
-      uint jj = _modelMap.get(ii);
-      m._metRCTable.add(_currentModel->getMetRCTable(jj));
-    }
-    const uint techLayerCnt = getExtLayerCnt(_tech) + 1;
-    const uint modelLayerCnt = _currentModel->getLayerCnt();
-    m._layerCnt = techLayerCnt < modelLayerCnt ? techLayerCnt : modelLayerCnt;
-    if (techLayerCnt == 5 && modelLayerCnt == 8) {
-      m._layerCnt = modelLayerCnt;
-    }
-    m.getMinWidth(_tech);
-    m.allocOUpool();
 
     m._debugFP = nullptr;
     m._netId = 0;
@@ -1942,6 +1968,17 @@ void extMain::makeBlockRCsegs(const char* netNames,
     }
   }
 
+  // Only keep tracking the changes of a fully extracted block
+  if (_allNet || _incrementalExt) {
+    if (_netTracker == nullptr) {
+      _netTracker = new extNetTracker();
+    }
+    _netTracker->track(_block);
+  } else if (_netTracker != nullptr) {
+    _netTracker->removeOwner();
+  }
+  _incrementalExt = false;
+
   _modelTable->resetCnt(0);
   if (_batchScaleExt) {
     genScaledExt();
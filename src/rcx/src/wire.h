@@ -582,6 +582,9 @@ class Ath__gridTable
 
   Ath__array1D<Ath__wire*>* _bandWire;
 
+  // Tracks at or above this coordinate are left to another band worker
+  int _extractLimit;
+
  public:
   Ath__gridTable(Ath__box* bb,
                  uint rowSize,
@@ -719,6 +722,8 @@ class Ath__gridTable
   uint noPowerTarget() { return _noPowerTarget; };
   void setNoPowerTarget(uint npt) { _noPowerTarget = npt; };
   void incrCCshorts() { _CCshorts++; };
+  int extractLimit() { return _extractLimit; };
+  void setExtractLimit(int limit) { _extractLimit = limit; };
   void setExtControl(dbBlock* block,
                      bool useDbSdb,
                      uint adj,
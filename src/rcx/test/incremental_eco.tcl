@@ -0,0 +1,59 @@
+# extract_parasitics -incremental after a routing ECO matches a full
+# extraction of the changed design
+source helpers.tcl
+source spef_helpers.tcl
+
+read_lef sky130hs/sky130hs.tlef
+read_lef sky130hs/sky130hs_std_cell.lef
+read_liberty sky130hs/sky130hs_tt.lib
+read_def gcd.def
+source sky130hs/sky130hs.rc
+define_process_corner -ext_model_index 0 X
+extract_parasitics -ext_model_file ext_pattern.rules \
+  -max_res 0 -coupling_threshold 0.1
+
+# Unroute one net and destroy another one with its RC network
+set block [ord::get_db_block]
+odb::dbWire_destroy [[$block findNet _001_] getWire]
+odb::dbNet_destroy [$block findNet _002_]
+
+extract_parasitics -ext_model_file ext_pattern.rules \
+  -max_res 0 -coupling_threshold 0.1 -incremental
+
+# The RC networks of the destroyed net leave the block with it
+proc net_cap_node_count { block } {
+  set count 0
+  foreach net [$block getNets] {
+    incr count [llength [$net getCapNodes]]
+  }
+  return $count
+}
+check "no cap nodes without a net" {
+  expr { [llength [$block getCapNodes]] == [net_cap_node_count $block] }
+} 1
+
+set incremental_spef [make_result_file incremental_eco.spef]
+write_spef $incremental_spef
+
+set def_file [make_result_file incremental_eco.def]
+write_def $def_file
+set full_spef [make_result_file incremental_eco_full.spef]
+run_in_new_process incremental_eco_full "
+  read_lef sky130hs/sky130hs.tlef
+  read_lef sky130hs/sky130hs_std_cell.lef
+  read_liberty sky130hs/sky130hs_tt.lib
+  read_def $def_file
+  source sky130hs/sky130hs.rc
+  define_process_corner -ext_model_index 0 X
+  extract_parasitics -ext_model_file ext_pattern.rules \\
+    -max_res 0 -coupling_threshold 0.1
+  write_spef $full_spef
+"
+
+# The re-extracted nets sum their capacitances in another order than
+# in a full extraction.
+check "incremental SPEF within 0.1%" {
+  compare_spef $full_spef $incremental_spef 1e-3
+} 1
+
+exit_summary
@@ -0,0 +1,38 @@
+# extract_parasitics -parallel matches the serial extraction
+source helpers.tcl
+source spef_helpers.tcl
+
+# Extracts gcd in a new process and returns the SPEF file
+proc extract_gcd { name threads options } {
+  set spef_file [make_result_file $name.spef]
+  run_in_new_process $name "
+    read_lef sky130hs/sky130hs.tlef
+    read_lef sky130hs/sky130hs_std_cell.lef
+    read_liberty sky130hs/sky130hs_tt.lib
+    read_def gcd.def
+    source sky130hs/sky130hs.rc
+    set_thread_count $threads
+    define_process_corner -ext_model_index 0 X
+    extract_parasitics -ext_model_file ext_pattern.rules \\
+      -max_res 0 -coupling_threshold 0.1 $options
+    write_spef $spef_file
+  "
+  return $spef_file
+}
+
+set serial_spef [extract_gcd parallel_coupling_serial 1 ""]
+set tiles1_spef [extract_gcd parallel_coupling_1 1 -parallel]
+set tiles4_spef [extract_gcd parallel_coupling_4 4 -parallel]
+
+# The tiles depend only on the design, so the thread count does not
+# change the result at all.
+check "same SPEF on 1 and 4 threads" {
+  diff_files $tiles1_spef $tiles4_spef "^\\*(DATE|VERSION)"
+} 0
+# The tiles sum the capacitances in another order than the serial flow
+# and write the coupling capacitors in another order.
+check "serial SPEF within 0.1%" {
+  compare_spef $serial_spef $tiles4_spef 1e-3
+} 1
+
+exit_summary
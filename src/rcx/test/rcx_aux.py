@@ -19,7 +19,9 @@ def extract_parasitics(
     lef_res=False,
     cc_model=10,
     context_depth=5,
-    no_merge_via_res=False
+    no_merge_via_res=False,
+    parallel=False,
+    incremental=False
 ):
     # NOTE: This is position dependent
     rcx.extract(
@@ -32,6 +34,8 @@ def extract_parasitics(
         debug_net_id,
         lef_res,
         no_merge_via_res,
+        parallel,
+        incremental,
     )
 
 
@@ -10,4 +10,6 @@ record_tests {
 }
 record_pass_fail_tests {
   rcx_unit_test
+  parallel_coupling
+  incremental_eco
 }
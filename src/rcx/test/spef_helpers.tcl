@@ -0,0 +1,97 @@
+# Helpers for the tests that compare two extractions of the same design.
+
+# Runs the commands in a new openroad process, so that an extraction can
+# be compared against one from a freshly read design.
+proc run_in_new_process { name commands } {
+  set script [make_result_file $name.tcl]
+  set stream [open $script w]
+  puts $stream $commands
+  close $stream
+  exec [info nameofexecutable] -no_init -no_splash -exit $script
+}
+
+proc is_spef_number { token } {
+  return [regexp {^-?[0-9]*\.?[0-9]+([eE][-+]?[0-9]+)?$} $token]
+}
+
+# Reads the nets of a SPEF file as a dict of net -> sorted entries, each
+# entry being the text of a line with its values replaced by # followed
+# by the values.  The running indices of the *CAP and *RES lines are
+# dropped, as the coupling capacitors may be written in another order.
+proc read_spef_nets { spef_file } {
+  set stream [open $spef_file r]
+  set nets [dict create]
+  set net ""
+  set entries {}
+  foreach line [split [read $stream] "\n"] {
+    set tokens [regexp -all -inline {\S+} $line]
+    if { $tokens == {} } {
+      continue
+    }
+    set first [lindex $tokens 0]
+    if { $first == "*D_NET" } {
+      set net [lindex $tokens 1]
+      set tokens [lreplace $tokens 1 1]
+    } elseif { $first == "*END" && $net != "" } {
+      dict set nets $net [lsort $entries]
+      set net ""
+      set entries {}
+      continue
+    }
+    if { $net == "" } {
+      continue
+    }
+    if { [string is integer -strict $first] } {
+      set tokens [lrange $tokens 1 end]
+    }
+    set text {}
+    set values {}
+    foreach token $tokens {
+      if { [is_spef_number $token] } {
+        lappend text "#"
+        lappend values $token
+      } else {
+        lappend text $token
+      }
+    }
+    lappend entries [list [join $text] $values]
+  }
+  close $stream
+  return $nets
+}
+
+# Returns 1 if the two SPEF files have the same nets and RC networks with
+# values within the relative tolerance (or 1e-9 absolute), otherwise
+# reports the first difference and returns 0.
+proc compare_spef { spef_file1 spef_file2 tolerance } {
+  set nets1 [read_spef_nets $spef_file1]
+  set nets2 [read_spef_nets $spef_file2]
+  if { [lsort [dict keys $nets1]] != [lsort [dict keys $nets2]] } {
+    puts "Differences found: the nets differ."
+    return 0
+  }
+  dict for {net entries1} $nets1 {
+    set entries2 [dict get $nets2 $net]
+    if { [llength $entries1] != [llength $entries2] } {
+      puts "Differences found in net $net: number of entries."
+      return 0
+    }
+    foreach entry1 $entries1 entry2 $entries2 {
+      lassign $entry1 text1 values1
+      lassign $entry2 text2 values2
+      if { $text1 != $text2 } {
+        puts "Differences found in net $net: $text1 vs $text2."
+        return 0
+      }
+      foreach value1 $values1 value2 $values2 {
+        set diff [expr { abs($value1 - $value2) }]
+        set limit [expr { max($tolerance * abs($value1), 1e-9) }]
+        if { $diff > $limit } {
+          puts "Differences found in net $net: $text1 $values1 vs $values2."
+          return 0
+        }
+      }
+    }
+  }
+  return 1
+}